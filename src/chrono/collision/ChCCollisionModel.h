@@ -165,6 +165,22 @@ class ChApi ChCollisionModel {
         double sphereswept_thickness = 0.0                  ///< outward sphere-swept layer (when supported)
         ) = 0;
 
+    /// Add a height field to this model: a regular grid of nx x ny nodes spanning sizeX x sizeY in the XY plane,
+    /// centered at pos, with heights along Z. The height of node (i,j) is heights[j * nx + i], with i running
+    /// along X and j along Y (both starting at the negative edge). The height data is shared, not copied.
+    /// Each grid cell is split in two triangles by the diagonal between nodes (i,j) and (i+1,j+1).
+    /// Return false if height fields are not supported by this collision model.
+    virtual bool AddHeightField(std::shared_ptr<std::vector<double>> heights,  ///< grid heights (nx*ny values)
+                                int nx,                                        ///< number of nodes along X
+                                int ny,                                        ///< number of nodes along Y
+                                double sizeX,                                  ///< grid length along X
+                                double sizeY,                                  ///< grid length along Y
+                                const ChVector<>& pos = ChVector<>(),          ///< center of the grid
+                                const ChMatrix33<>& rot = ChMatrix33<>(1)      ///< rotation of the grid
+    ) {
+        return false;
+    }
+
     /// Add a barrel-like shape to this model (main axis on Y direction), for collision purposes.
     /// The barrel shape is made by lathing an arc of an ellipse around the vertical Y axis.
     /// The center of the ellipse is on Y=0 level, and it is offsetted by R_offset from
@@ -0,0 +1,33 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/collision/ChCCollisionModel.h"
+#include "chrono/collision/ChCCollisionSystem.h"
+
+namespace chrono {
+namespace collision {
+
+void ChCollisionSystem::RayHitBatch(int num_rays,
+                                    const ChVector<>* from,
+                                    const ChVector<>* to,
+                                    ChRayhitResult* results,
+                                    const short int* family_masks) const {
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < num_rays; i++) {
+        RayHit(from[i], to[i], results[i]);
+        if (family_masks && results[i].hit && !(results[i].hitModel->GetFamilyGroup() & family_masks[i]))
+            results[i].hit = false;
+    }
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -37,6 +37,8 @@ class ChApi ChCollisionSystem {
     ChCollisionSystem(unsigned int max_objects = 16000, double scene_size = 500) {
         narrow_callback = 0;
         broad_callback = 0;
+        speculative_contacts = false;
+        speculative_dt = 0;
     };
 
     virtual ~ChCollisionSystem(){};
@@ -153,6 +155,20 @@ class ChApi ChCollisionSystem {
                         ChCollisionModel* model,
                         ChRayhitResult& mresult) const = 0;
 
+    /// Perform a batch of ray-hit tests with all collision models.
+    /// The i-th ray goes from from[i] to to[i] and its result is written in results[i]; all arrays have (at least)
+    /// num_rays elements and are allocated by the caller. If family_masks is provided, the i-th ray only hits models
+    /// whose family group is set in family_masks[i] (bit k for family k); otherwise rays are filtered as in RayHit().
+    /// The rays are processed concurrently, so the queries are most efficient if neighboring rays are spatially
+    /// coherent (e.g. ordered by scanline or by grid vertex).
+    /// The default implementation calls RayHit() for each ray and discards hits on excluded families (which then
+    /// still occlude the ray); derived classes may provide a more efficient traversal.
+    virtual void RayHitBatch(int num_rays,
+                             const ChVector<>* from,
+                             const ChVector<>* to,
+                             ChRayhitResult* results,
+                             const short int* family_masks = nullptr) const;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) {
         // version number
@@ -165,9 +181,28 @@ class ChApi ChCollisionSystem {
         int version = marchive.VersionRead<ChCollisionSystem>();
     }
 
+    /// Enable/disable speculative contacts (default: false).
+    /// When enabled, the bounding box of each collision model is swept by its motion over the time step,
+    /// and contacts are generated up to a positive separation that covers the relative motion of the two
+    /// models. With NSC, a contact at positive separation d gets the bias d/h, so it only produces a
+    /// reaction if the bodies would close the gap within the step: fast bodies do not tunnel through thin
+    /// objects, without tuning the envelopes or reducing the step size.
+    /// Currently supported by ChCollisionSystemPrimitive only; the Bullet collision system warns and ignores it.
+    virtual void SetSpeculativeContacts(bool val) { speculative_contacts = val; }
+
+    /// Tell if speculative contacts are enabled.
+    bool GetSpeculativeContacts() const { return speculative_contacts; }
+
+    /// Set the time interval over which the motion of the collision models is anticipated,
+    /// for speculative contacts. ChSystem sets this to the current step size before each Run().
+    void SetSpeculativeTimeStep(double dt) { speculative_dt = dt; }
+
   protected:
     BroadphaseCallback* broad_callback;    ///< user callback for each near-enough pair of shapes
     NarrowphaseCallback* narrow_callback;  ///< user callback for each collision pair
+
+    bool speculative_contacts;  ///< generate contacts for the motion over the next step
+    double speculative_dt;      ///< time interval for speculative contacts
 };
 
 }  // end namespace collision
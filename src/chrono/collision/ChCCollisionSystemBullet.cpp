@@ -12,6 +12,8 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/collision/gimpact/GIMPACT/Bullet/btGImpactCollisionAlgorithm.h"
@@ -1163,15 +1165,191 @@ private:
 
 
 
+////////////////////////////////////
+////////////////////////////////////
+
+// Check if queries against the given shape (narrowphase with another shape, ray tests) only read shared data,
+// so that they can run concurrently with other queries on the same shape. Convex shapes, BVH triangle meshes,
+// heightfields and compounds of such shapes qualify. GImpact meshes do not (queries lock the child shapes,
+// modifying a counter in the shape), and other concave shapes are conservatively assumed not to. Compounds are
+// checked recursively, since ChModelBullet wraps non-centered and multiple shapes in a btCompoundShape.
+static bool IsQueryConcurrent(const btCollisionShape* shape) {
+    if (shape->isCompound()) {
+        const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+        for (int i = 0; i < compound->getNumChildShapes(); i++) {
+            if (!IsQueryConcurrent(compound->getChildShape(i)))
+                return false;
+        }
+        return true;
+    }
+    switch (shape->getShapeType()) {
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE:
+        case SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE:
+        case TERRAIN_SHAPE_PROXYTYPE:
+            return true;
+        default:
+            return !shape->isConcave();
+    }
+}
+
+// Collision dispatcher that can run the narrowphase of the overlapping pairs in parallel.
+// Collision algorithms are created serially; the pairs are then processed concurrently, with the
+// shared allocators (manifolds, algorithms) protected by a critical section. Pairs involving shapes that
+// are not safe for concurrent queries (see IsQueryConcurrent), also as compound children, are handled
+// serially afterwards.
+// At the end, the manifolds are sorted by a key that does not depend on the processing order, so that
+// contacts are reported in the same order regardless of the number of threads.
+class btCollisionDispatcherMT : public btCollisionDispatcher {
+  public:
+    btCollisionDispatcherMT(btCollisionConfiguration* config) : btCollisionDispatcher(config), m_num_threads(1) {}
+
+    void SetNumThreads(int nthreads) { m_num_threads = nthreads; }
+    int GetNumThreads() const { return m_num_threads; }
+
+    virtual btPersistentManifold* getNewManifold(void* b0, void* b1) override {
+        btPersistentManifold* manifold;
+#pragma omp critical(bt_dispatcher)
+        manifold = btCollisionDispatcher::getNewManifold(b0, b1);
+        return manifold;
+    }
+
+    virtual void releaseManifold(btPersistentManifold* manifold) override {
+#pragma omp critical(bt_dispatcher)
+        btCollisionDispatcher::releaseManifold(manifold);
+    }
+
+    // The Bullet activation state of the collision objects only selects the AABBs updated by the collision world
+    // (see ChCollisionSystemBullet::SetIncrementalAabbUpdate), since the persistent contacts of a pair keep changing
+    // for a few passes after its models stop moving. Pairs of contactables that are both inactive (sleeping or
+    // fixed bodies) are skipped instead, as their contacts are discarded by the contact containers.
+    virtual bool needsCollision(btCollisionObject* body0, btCollisionObject* body1) override {
+        if (!body0->checkCollideWith(body1) || !body1->checkCollideWith(body0))
+            return false;
+        ChContactable* contactable0 = ((ChCollisionModel*)body0->getUserPointer())->GetContactable();
+        ChContactable* contactable1 = ((ChCollisionModel*)body1->getUserPointer())->GetContactable();
+        if (contactable0 && contactable1 && !contactable0->IsContactActive() && !contactable1->IsContactActive())
+            return false;
+        return true;
+    }
+
+    virtual void* allocateCollisionAlgorithm(int size) override {
+        void* mem;
+#pragma omp critical(bt_dispatcher)
+        mem = btCollisionDispatcher::allocateCollisionAlgorithm(size);
+        return mem;
+    }
+
+    virtual void freeCollisionAlgorithm(void* ptr) override {
+#pragma omp critical(bt_dispatcher)
+        btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+    }
+
+    virtual void dispatchAllCollisionPairs(btOverlappingPairCache* pairCache,
+                                           const btDispatcherInfo& dispatchInfo,
+                                           btDispatcher* dispatcher) override {
+        if (m_num_threads <= 1) {
+            btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+            return;
+        }
+
+        btBroadphasePairArray& pairs = pairCache->getOverlappingPairArray();
+        int npairs = pairs.size();
+
+        // Create missing algorithms and split the pairs in thread-safe and serial ones
+        m_parallel_pairs.resize(0);
+        m_serial_pairs.resize(0);
+        for (int i = 0; i < npairs; i++) {
+            btBroadphasePair& pair = pairs[i];
+            btCollisionObject* obj0 = (btCollisionObject*)pair.m_pProxy0->m_clientObject;
+            btCollisionObject* obj1 = (btCollisionObject*)pair.m_pProxy1->m_clientObject;
+            if (!needsCollision(obj0, obj1))
+                continue;
+            if (!pair.m_algorithm)
+                pair.m_algorithm = findAlgorithm(obj0, obj1);
+            if (IsQueryConcurrent(obj0->getCollisionShape()) && IsQueryConcurrent(obj1->getCollisionShape()))
+                m_parallel_pairs.push_back(&pair);
+            else
+                m_serial_pairs.push_back(&pair);
+        }
+
+        btNearCallback callback = getNearCallback();
+
+        int nparallel = m_parallel_pairs.size();
+#pragma omp parallel for num_threads(m_num_threads) schedule(dynamic, 16)
+        for (int i = 0; i < nparallel; i++) {
+            callback(*m_parallel_pairs[i], *this, dispatchInfo);
+        }
+
+        for (int i = 0; i < m_serial_pairs.size(); i++) {
+            callback(*m_serial_pairs[i], *this, dispatchInfo);
+        }
+
+        SortManifolds();
+    }
+
+  private:
+    // Order manifolds by the unique ids of the two broadphase proxies, then by the shape identifiers and
+    // local position of their first contact point (to separate the manifolds of compound children or
+    // mesh triangles of the same pair).
+    static bool ManifoldLess(const btPersistentManifold* a, const btPersistentManifold* b) {
+        const btCollisionObject* a0 = (const btCollisionObject*)a->getBody0();
+        const btCollisionObject* a1 = (const btCollisionObject*)a->getBody1();
+        const btCollisionObject* b0 = (const btCollisionObject*)b->getBody0();
+        const btCollisionObject* b1 = (const btCollisionObject*)b->getBody1();
+        int ida0 = a0->getBroadphaseHandle() ? a0->getBroadphaseHandle()->m_uniqueId : -1;
+        int ida1 = a1->getBroadphaseHandle() ? a1->getBroadphaseHandle()->m_uniqueId : -1;
+        int idb0 = b0->getBroadphaseHandle() ? b0->getBroadphaseHandle()->m_uniqueId : -1;
+        int idb1 = b1->getBroadphaseHandle() ? b1->getBroadphaseHandle()->m_uniqueId : -1;
+        if (ida0 != idb0)
+            return ida0 < idb0;
+        if (ida1 != idb1)
+            return ida1 < idb1;
+        int na = a->getNumContacts();
+        int nb = b->getNumContacts();
+        if (na == 0 || nb == 0)
+            return na < nb;
+        const btManifoldPoint& pa = a->getContactPoint(0);
+        const btManifoldPoint& pb = b->getContactPoint(0);
+        if (pa.m_partId0 != pb.m_partId0)
+            return pa.m_partId0 < pb.m_partId0;
+        if (pa.m_index0 != pb.m_index0)
+            return pa.m_index0 < pb.m_index0;
+        if (pa.m_partId1 != pb.m_partId1)
+            return pa.m_partId1 < pb.m_partId1;
+        if (pa.m_index1 != pb.m_index1)
+            return pa.m_index1 < pb.m_index1;
+        for (int k = 0; k < 3; k++) {
+            if (pa.m_localPointA[k] != pb.m_localPointA[k])
+                return pa.m_localPointA[k] < pb.m_localPointA[k];
+        }
+        return false;
+    }
+
+    void SortManifolds() {
+        int nmanifolds = getNumManifolds();
+        if (nmanifolds == 0)
+            return;
+        btPersistentManifold** manifolds = getInternalManifoldPointer();
+        std::sort(manifolds, manifolds + nmanifolds, ManifoldLess);
+        for (int i = 0; i < nmanifolds; i++)
+            manifolds[i]->m_index1a = i;
+    }
+
+    int m_num_threads;
+    btAlignedObjectArray<btBroadphasePair*> m_parallel_pairs;
+    btAlignedObjectArray<btBroadphasePair*> m_serial_pairs;
+};
+
 ////////////////////////////////////
 ////////////////////////////////////
 
 
-ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, double scene_size) {
+ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, double scene_size)
+    : m_incremental_aabb(false) {
     // btDefaultCollisionConstructionInfo conf_info(...); ***TODO***
     bt_collision_configuration = new btDefaultCollisionConfiguration();
 
-    bt_dispatcher = new btCollisionDispatcher(bt_collision_configuration);
+    bt_dispatcher = new btCollisionDispatcherMT(bt_collision_configuration);
     //((btDefaultCollisionConfiguration*)bt_collision_configuration)->setConvexConvexMultipointIterations(4,4);
 
     //***OLD***
@@ -1185,6 +1363,7 @@ ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, doubl
     bt_broadphase = new btDbvtBroadphase();
 
     bt_collision_world = new btCollisionWorld(bt_dispatcher, bt_broadphase, bt_collision_configuration);
+    bt_collision_world->setForceUpdateAllAabbs(!m_incremental_aabb);
 
     // custom collision for sphere-sphere case ***OBSOLETE*** // already registered by btDefaultCollisionConfiguration
     // bt_dispatcher->registerCollisionCreateFunc(SPHERE_SHAPE_PROXYTYPE,SPHERE_SHAPE_PROXYTYPE,new
@@ -1254,6 +1433,8 @@ void ChCollisionSystemBullet::Add(ChCollisionModel* model) {
         bt_collision_world->addCollisionObject(((ChModelBullet*)model)->GetBulletModel(),
                                                ((ChModelBullet*)model)->GetFamilyGroup(),
                                                ((ChModelBullet*)model)->GetFamilyMask());
+        // new models must go through the narrowphase, even if they do not move
+        ((ChModelBullet*)model)->GetBulletModel()->forceActivationState(ACTIVE_TAG);
     }
 }
 
@@ -1263,10 +1444,69 @@ void ChCollisionSystemBullet::Remove(ChCollisionModel* model) {
     }
 }
 
+void ChCollisionSystemBullet::UpdateAabbs(const std::vector<ChModelBullet*>& models, const std::vector<char>& update) {
+    int nmodels = static_cast<int>(models.size());
+    m_aabbs.resize(2 * nmodels);
+
+    // Compute AABBs in parallel (shape queries only, no modification of the broadphase)
+#pragma omp parallel for
+    for (int i = 0; i < nmodels; i++) {
+        if (!update[i])
+            continue;
+        btCollisionObject* obj = models[i]->GetBulletModel();
+        obj->getCollisionShape()->getAabb(obj->getWorldTransform(), m_aabbs[2 * i], m_aabbs[2 * i + 1]);
+    }
+
+    // Update the broadphase serially
+    btBroadphaseInterface* broadphase = bt_collision_world->getBroadphase();
+    for (int i = 0; i < nmodels; i++) {
+        if (!update[i])
+            continue;
+        btCollisionObject* obj = models[i]->GetBulletModel();
+        if (obj->getBroadphaseHandle())
+            broadphase->setAabb(obj->getBroadphaseHandle(), m_aabbs[2 * i], m_aabbs[2 * i + 1], bt_dispatcher);
+    }
+}
+
+void ChCollisionSystemBullet::SetNumThreadsNarrowphase(int nthreads) {
+    static_cast<btCollisionDispatcherMT*>(bt_dispatcher)->SetNumThreads(nthreads);
+}
+
+int ChCollisionSystemBullet::GetNumThreadsNarrowphase() const {
+    return static_cast<btCollisionDispatcherMT*>(bt_dispatcher)->GetNumThreads();
+}
+
+void ChCollisionSystemBullet::SetIncrementalAabbUpdate(bool val) {
+    m_incremental_aabb = val;
+    bt_collision_world->setForceUpdateAllAabbs(!val);
+
+    // all models are active when the incremental update is disabled
+    btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++)
+        objects[i]->forceActivationState(ACTIVE_TAG);
+}
+
+void ChCollisionSystemBullet::SetSpeculativeContacts(bool val) {
+    if (val)
+        GetLog() << "Warning: speculative contacts are not supported by the Bullet collision system (ignored)\n";
+    speculative_contacts = false;
+}
+
 void ChCollisionSystemBullet::Run() {
     if (bt_collision_world) {
         bt_collision_world->performDiscreteCollisionDetection();
     }
+
+    if (!m_incremental_aabb)
+        return;
+
+    // Clear the 'moved' flags: models are activated again by ChModelBullet::SyncPosition if they move.
+    // Models with external AABB update are always kept active, since their shapes deform in place.
+    btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++) {
+        if (!(objects[i]->getCollisionFlags() & btCollisionObject::CF_EXTERNAL_AABB_UPDATE))
+            objects[i]->forceActivationState(ISLAND_SLEEPING);
+    }
 }
 
 void ChCollisionSystemBullet::ResetTimers() {
@@ -1283,75 +1523,114 @@ double ChCollisionSystemBullet::GetTimerCollisionNarrow() const {
 }
 
 void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontainer) {
-    // This should remove all old contacts (or at least rewind the index)
-    mcontactcontainer->BeginAddContact();
-
     // NOTE: Bullet does not provide information on radius of curvature at a contact point.
-    // As such, for all Bullet-identified contacts, the default value will be used (SMC only). 
-    ChCollisionInfo icontact;
+    // As such, for all Bullet-identified contacts, the default value will be used (SMC only).
+
+    btDispatcher* dispatcher = bt_collision_world->getDispatcher();
+    int numManifolds = dispatcher->getNumManifolds();
+
+    // Execute custom broadphase callback, if any (serially, user callbacks need not be thread safe)
+    m_report_manifold.assign(numManifolds, 1);
+    if (this->broad_callback) {
+        for (int i = 0; i < numManifolds; i++) {
+            btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+            btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
+            btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
+            m_report_manifold[i] = this->broad_callback->OnBroadphase((ChCollisionModel*)obA->getUserPointer(),
+                                                                      (ChCollisionModel*)obB->getUserPointer());
+        }
+    }
 
-    int numManifolds = bt_collision_world->getDispatcher()->getNumManifolds();
+    // Refresh the manifolds and count the contact points to be reported from each of them
+    m_report_offsets.resize(numManifolds + 1);
+#pragma omp parallel for schedule(dynamic, 64)
     for (int i = 0; i < numManifolds; i++) {
-        btPersistentManifold* contactManifold = bt_collision_world->getDispatcher()->getManifoldByIndexInternal(i);
+        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
         btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
         btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
         contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
 
-        icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
-        icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
+        int count = 0;
+        if (m_report_manifold[i]) {
+            double margin = ((ChCollisionModel*)obA->getUserPointer())->GetSafeMargin() +
+                            ((ChCollisionModel*)obB->getUserPointer())->GetSafeMargin();
+            // Discard "too far" constraints (the Bullet engine also has its threshold)
+            for (int j = 0; j < contactManifold->getNumContacts(); j++) {
+                if (contactManifold->getContactPoint(j).getDistance() < margin)
+                    count++;
+            }
+        }
+        m_report_offsets[i + 1] = count;
+    }
 
-        double envelopeA = icontact.modelA->GetEnvelope();
-        double envelopeB = icontact.modelB->GetEnvelope();
+    // Prefix sum over the manifold counts gives the position of each manifold's contacts in the batch
+    m_report_offsets[0] = 0;
+    for (int i = 0; i < numManifolds; i++)
+        m_report_offsets[i + 1] += m_report_offsets[i];
+    m_report_contacts.resize(m_report_offsets[numManifolds]);
 
-        double marginA = icontact.modelA->GetSafeMargin();
-        double marginB = icontact.modelB->GetSafeMargin();
+    // Fill the batch of collision info
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < numManifolds; i++) {
+        if (m_report_offsets[i + 1] == m_report_offsets[i])
+            continue;
 
-        // Execute custom broadphase callback, if any
-        bool do_narrow_contactgeneration = true;
-        if (this->broad_callback)
-            do_narrow_contactgeneration = this->broad_callback->OnBroadphase(icontact.modelA, icontact.modelB);
+        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+        btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
+        btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
+        ChCollisionModel* modelA = (ChCollisionModel*)obA->getUserPointer();
+        ChCollisionModel* modelB = (ChCollisionModel*)obB->getUserPointer();
 
-        if (do_narrow_contactgeneration) {
-            int numContacts = contactManifold->getNumContacts();
-            //GetLog() << "numContacts=" << numContacts << "\n";
-            for (int j = 0; j < numContacts; j++) {
-                btManifoldPoint& pt = contactManifold->getContactPoint(j);
+        double envelopeA = modelA->GetEnvelope();
+        double envelopeB = modelB->GetEnvelope();
+        double margin = modelA->GetSafeMargin() + modelB->GetSafeMargin();
 
-                // Discard "too far" constraints (the Bullet engine also has its threshold)
-                if (pt.getDistance() < marginA + marginB) {
-                    btVector3 ptA = pt.getPositionWorldOnA();
-                    btVector3 ptB = pt.getPositionWorldOnB();
+        int k = m_report_offsets[i];
+        for (int j = 0; j < contactManifold->getNumContacts(); j++) {
+            btManifoldPoint& pt = contactManifold->getContactPoint(j);
+            if (pt.getDistance() >= margin)
+                continue;
 
-                    icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
-                    icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
+            ChCollisionInfo& icontact = m_report_contacts[k++];
+            icontact.modelA = modelA;
+            icontact.modelB = modelB;
 
-                    icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(),
-                                    -pt.m_normalWorldOnB.getZ());
-                    icontact.vN.Normalize();
+            btVector3 ptA = pt.getPositionWorldOnA();
+            btVector3 ptB = pt.getPositionWorldOnB();
 
-                    double ptdist = pt.getDistance();
+            icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
+            icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
 
-                    icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
-                    icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
-                    icontact.distance = ptdist + envelopeA + envelopeB;
+            icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(), -pt.m_normalWorldOnB.getZ());
+            icontact.vN.Normalize();
 
-                    icontact.reaction_cache = pt.reactions_cache;
+            double ptdist = pt.getDistance();
 
-                    // Execute some user custom callback, if any
-                    bool add_contact = true;
-                    if (this->narrow_callback)
-                        add_contact = this->narrow_callback->OnNarrowphase(icontact);
+            icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
+            icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
+            icontact.distance = ptdist + envelopeA + envelopeB;
 
-                    // Add to contact container
-                    if (add_contact)
-                        mcontactcontainer->AddContact(icontact);
-                }
-            }
+            icontact.reaction_cache = pt.reactions_cache;
         }
+    }
 
-        // you can un-comment out this line, and then all points are removed
-        // contactManifold->clearManifold();
+    // Execute some user custom callback, if any, discarding the contacts it rejects
+    if (this->narrow_callback) {
+        size_t nkept = 0;
+        for (size_t k = 0; k < m_report_contacts.size(); k++) {
+            if (this->narrow_callback->OnNarrowphase(m_report_contacts[k])) {
+                if (nkept != k)
+                    m_report_contacts[nkept] = m_report_contacts[k];
+                nkept++;
+            }
+        }
+        m_report_contacts.resize(nkept);
     }
+
+    // Add the whole batch to the contact container
+    // (BeginAddContact should remove all old contacts, or at least rewind the index)
+    mcontactcontainer->BeginAddContact();
+    mcontactcontainer->AddContacts(m_report_contacts);
     mcontactcontainer->EndAddContact();
 }
 
@@ -1476,9 +1755,169 @@ bool ChCollisionSystemBullet::RayHit(const ChVector<>& from,
     return true;
 }
 
+// Number of rays traversing the broadphase tree together in RayHitBatch().
+static const int RAY_PACKET_SIZE = 16;
+
+// Closest-hit ray callback which can be stored in arrays (ray end points are set later).
+struct PacketRayResultCallback : public btCollisionWorld::ClosestRayResultCallback {
+    PacketRayResultCallback() : btCollisionWorld::ClosestRayResultCallback(btVector3(0, 0, 0), btVector3(0, 0, 0)) {}
+};
+
+// Store the closest hit of a ray callback in a ray hit result.
+static void StoreRayHit(const btCollisionWorld::ClosestRayResultCallback& cb,
+                        ChCollisionSystem::ChRayhitResult& mresult) {
+    mresult.hit = false;
+    if (!cb.hasHit())
+        return;
+    mresult.hitModel = (ChCollisionModel*)(cb.m_collisionObject->getUserPointer());
+    if (!mresult.hitModel)
+        return;
+    mresult.hit = true;
+    mresult.abs_hitPoint.Set(cb.m_hitPointWorld.x(), cb.m_hitPointWorld.y(), cb.m_hitPointWorld.z());
+    mresult.abs_hitNormal.Set(cb.m_hitNormalWorld.x(), cb.m_hitNormalWorld.y(), cb.m_hitNormalWorld.z());
+    mresult.abs_hitNormal.Normalize();
+    mresult.dist_factor = cb.m_closestHitFraction;
+    mresult.abs_hitPoint = mresult.abs_hitPoint - mresult.abs_hitNormal * mresult.hitModel->GetEnvelope();
+}
+
+void ChCollisionSystemBullet::RayHitBatch(int num_rays,
+                                          const ChVector<>* from,
+                                          const ChVector<>* to,
+                                          ChRayhitResult* results,
+                                          const short int* family_masks) const {
+    btDbvtBroadphase* broadphase = static_cast<btDbvtBroadphase*>(bt_broadphase);
+    int num_packets = (num_rays + RAY_PACKET_SIZE - 1) / RAY_PACKET_SIZE;
+
+    // Ray-object pairs whose test cannot run concurrently (see IsQueryConcurrent), processed after
+    // the parallel traversal.
+    std::vector<std::pair<int, btCollisionObject*>> deferred;
+
+#pragma omp parallel
+    {
+        std::vector<std::pair<int, btCollisionObject*>> deferred_local;
+
+        // Traversal stack: tree node and mask of the packet rays whose segment overlaps the node volume
+        std::vector<std::pair<const btDbvtNode*, unsigned int>> stack;
+        stack.reserve(128);
+
+        PacketRayResultCallback callbacks[RAY_PACKET_SIZE];
+        btTransform from_trans[RAY_PACKET_SIZE];
+        btTransform to_trans[RAY_PACKET_SIZE];
+        btVector3 inv_dir[RAY_PACKET_SIZE];
+        unsigned int signs[RAY_PACKET_SIZE][3];
+
+#pragma omp for schedule(dynamic, 4)
+        for (int ip = 0; ip < num_packets; ip++) {
+            int first = ip * RAY_PACKET_SIZE;
+            int count = std::min(RAY_PACKET_SIZE, num_rays - first);
+
+            for (int j = 0; j < count; j++) {
+                int i = first + j;
+                btVector3 btfrom((btScalar)from[i].x(), (btScalar)from[i].y(), (btScalar)from[i].z());
+                btVector3 btto((btScalar)to[i].x(), (btScalar)to[i].y(), (btScalar)to[i].z());
+                btVector3 dir = btto - btfrom;
+                for (int k = 0; k < 3; k++) {
+                    inv_dir[j][k] = dir[k] == btScalar(0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1) / dir[k];
+                    signs[j][k] = inv_dir[j][k] < 0;
+                }
+                from_trans[j].setIdentity();
+                from_trans[j].setOrigin(btfrom);
+                to_trans[j].setIdentity();
+                to_trans[j].setOrigin(btto);
+
+                PacketRayResultCallback& cb = callbacks[j];
+                cb.m_rayFromWorld = btfrom;
+                cb.m_rayToWorld = btto;
+                cb.m_closestHitFraction = 1;
+                cb.m_collisionObject = 0;
+                cb.m_collisionFilterGroup = family_masks ? (short int)btBroadphaseProxy::AllFilter
+                                                         : (short int)btBroadphaseProxy::DefaultFilter;
+                cb.m_collisionFilterMask = family_masks ? family_masks[i] : (short int)btBroadphaseProxy::AllFilter;
+            }
+
+            // Traverse both broadphase trees once for the whole packet. The segment of each ray is clipped
+            // at its closest hit so far, which culls the subtrees behind it.
+            for (int set = 0; set < 2; set++) {
+                if (!broadphase->m_sets[set].m_root)
+                    continue;
+                stack.clear();
+                stack.push_back(std::make_pair(broadphase->m_sets[set].m_root, (1u << count) - 1));
+                while (!stack.empty()) {
+                    const btDbvtNode* node = stack.back().first;
+                    unsigned int active = stack.back().second;
+                    stack.pop_back();
+
+                    btVector3 bounds[2] = {node->volume.Mins(), node->volume.Maxs()};
+                    unsigned int mask = 0;
+                    for (int j = 0; j < count; j++) {
+                        btScalar tmin;
+                        if ((active & (1u << j)) && btRayAabb2(callbacks[j].m_rayFromWorld, inv_dir[j], signs[j], bounds,
+                                                               tmin, 0, callbacks[j].m_closestHitFraction))
+                            mask |= 1u << j;
+                    }
+                    if (!mask)
+                        continue;
+
+                    if (node->isinternal()) {
+                        stack.push_back(std::make_pair(node->childs[0], mask));
+                        stack.push_back(std::make_pair(node->childs[1], mask));
+                        continue;
+                    }
+
+                    btBroadphaseProxy* proxy = static_cast<btBroadphaseProxy*>(node->data);
+                    btCollisionObject* object = static_cast<btCollisionObject*>(proxy->m_clientObject);
+                    bool concurrent = IsQueryConcurrent(object->getCollisionShape());
+                    for (int j = 0; j < count; j++) {
+                        if (!(mask & (1u << j)) || !callbacks[j].needsCollision(object->getBroadphaseHandle()))
+                            continue;
+                        if (!concurrent) {
+                            deferred_local.push_back(std::make_pair(first + j, object));
+                            continue;
+                        }
+                        btCollisionWorld::rayTestSingle(from_trans[j], to_trans[j], object,
+                                                        object->getCollisionShape(), object->getWorldTransform(),
+                                                        callbacks[j]);
+                    }
+                }
+            }
+
+            for (int j = 0; j < count; j++)
+                StoreRayHit(callbacks[j], results[first + j]);
+        }
+
+#pragma omp critical
+        deferred.insert(deferred.end(), deferred_local.begin(), deferred_local.end());
+    }
+
+    // Sequential tests of the deferred pairs, keeping a hit only if closer than the one already found.
+    for (const auto& pair : deferred) {
+        int i = pair.first;
+        btCollisionObject* object = pair.second;
+        btVector3 btfrom((btScalar)from[i].x(), (btScalar)from[i].y(), (btScalar)from[i].z());
+        btVector3 btto((btScalar)to[i].x(), (btScalar)to[i].y(), (btScalar)to[i].z());
+        btTransform from_trans;
+        from_trans.setIdentity();
+        from_trans.setOrigin(btfrom);
+        btTransform to_trans;
+        to_trans.setIdentity();
+        to_trans.setOrigin(btto);
+
+        btCollisionWorld::ClosestRayResultCallback cb(btfrom, btto);
+        cb.m_closestHitFraction = results[i].hit ? (btScalar)results[i].dist_factor : btScalar(1);
+        btCollisionWorld::rayTestSingle(from_trans, to_trans, object, object->getCollisionShape(),
+                                        object->getWorldTransform(), cb);
+        if (cb.hasHit() && cb.m_collisionObject->getUserPointer())
+            StoreRayHit(cb, results[i]);
+    }
+}
+
 void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (btScalar)threshold;
 }
 
+size_t ChCollisionSystemBullet::GetScalarSize() {
+    return sizeof(btScalar);
+}
+
 }  // end namespace collision
 }  // end namespace chrono
@@ -15,6 +15,8 @@
 #ifndef CHC_COLLISIONSYSTEMBULLET_H
 #define CHC_COLLISIONSYSTEMBULLET_H
 
+#include <vector>
+
 #include "chrono/collision/ChCCollisionSystem.h"
 #include "chrono/collision/bullet/btBulletCollisionCommon.h"
 #include "chrono/core/ChApiCE.h"
@@ -22,6 +24,8 @@
 namespace chrono {
 namespace collision {
 
+class ChModelBullet;
+
 ///
 /// Class for collision engine based on the 'Bullet' library.
 /// Contains either the broadphase and the narrow phase Bullet
@@ -49,6 +53,34 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// engine (custom data may be deallocated).
     // virtual void RemoveAll();
 
+    /// Set the number of OpenMP threads used for the narrowphase (default: 1, i.e. serial dispatch).
+    /// With more than one thread, the overlapping pairs are processed concurrently and the contact manifolds
+    /// are then sorted, so that contacts are reported in an order which does not depend on the number of
+    /// threads (although it may differ from the order obtained with serial dispatch).
+    /// The time spent in the narrowphase is still reported by GetTimerCollisionNarrow().
+    void SetNumThreadsNarrowphase(int nthreads);
+
+    /// Get the number of threads used for the narrowphase.
+    int GetNumThreadsNarrowphase() const;
+
+    /// Enable/disable incremental AABB updates (default: disabled).
+    /// If enabled, only the models that moved since the previous Run() (see ChModelBullet::SyncPosition) have
+    /// their AABB recomputed and reinserted in the broadphase. The narrowphase skips the pairs of inactive
+    /// (sleeping or fixed) bodies, whatever this setting, and processes all other overlapping pairs, since the
+    /// persistent contacts of a pair keep changing for a few passes after its models stop moving.
+    /// Models left untouched for a few steps are migrated by the Dbvt broadphase to its static tree, which is not
+    /// tested against itself. Do not enable this if collision shapes are modified in place without moving
+    /// the model or rebuilding it (ClearModel/BuildModel).
+    void SetIncrementalAabbUpdate(bool val);
+
+    /// Tell if incremental AABB updates are enabled.
+    bool GetIncrementalAabbUpdate() const { return m_incremental_aabb; }
+
+    /// Speculative contacts are not supported by the Bullet collision system: enabling them only issues a
+    /// warning, and GetSpeculativeContacts() keeps returning false. Use ChCollisionSystemPrimitive, or larger
+    /// collision envelopes, to prevent tunneling of fast bodies.
+    virtual void SetSpeculativeContacts(bool val) override;
+
     /// Run the algorithm and finds all the contacts.
     /// (Contacts will be managed by the Bullet persistent contact cache).
     virtual void Run() override;
@@ -69,6 +101,9 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// The basic behavior of the implementation is the following: collision system
     /// will call in sequence the functions BeginAddContact(), AddContact() (x n times),
     /// EndAddContact() of the contact container.
+    /// This implementation collects the contacts from all Bullet manifolds in parallel into a single batch, then
+    /// passes it to the contact container with AddContacts(). Custom broadphase and narrowphase callbacks, if any,
+    /// are still invoked for each manifold and each contact, respectively (serially).
     virtual void ReportContacts(ChContactContainer* mcontactcontainer) override;
 
     /// After the Run() has completed, you can call this function to
@@ -106,6 +141,23 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
                 short int filter_group,
                 short int filter_mask) const;
 
+    /// Perform a batch of ray-hit tests with all collision models.
+    /// Rays are grouped in packets of consecutive rays, each packet traversing the broadphase trees once; packets are
+    /// processed in parallel. If provided, the family masks select the collision families that each ray can hit.
+    /// Ray tests against shapes which are not safe for concurrent queries (e.g. GImpact meshes) are deferred and
+    /// performed sequentially after the parallel traversal.
+    virtual void RayHitBatch(int num_rays,
+                             const ChVector<>* from,
+                             const ChVector<>* to,
+                             ChRayhitResult* results,
+                             const short int* family_masks = nullptr) const override;
+
+    /// Recompute the AABBs of the given models and update the broadphase.
+    /// Only models with nonzero flag in 'update' are processed. The AABBs are computed in parallel and then
+    /// inserted in the broadphase serially. This is meant for models with external AABB update (see
+    /// ChModelBullet::SetExternalAabbUpdate), to be called before Run().
+    void UpdateAabbs(const std::vector<ChModelBullet*>& models, const std::vector<char>& update);
+
     // For Bullet related stuff
     btCollisionWorld* GetBulletCollisionWorld() { return bt_collision_world; }
 
@@ -114,6 +166,10 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     // Call it only once, before running the simulation.
     static void SetContactBreakingThreshold(double threshold);
 
+    // Size in bytes of the Bullet floating point type (4 in single precision,
+    // 8 if Chrono was configured with USE_BULLET_DOUBLE).
+    static size_t GetScalarSize();
+
   private:
     btCollisionConfiguration* bt_collision_configuration;
     btCollisionDispatcher* bt_dispatcher;
@@ -126,6 +182,13 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     btCollisionAlgorithmCreateFunc* m_collision_cetri_cetri;
     void* m_tmp_mem;
     btCollisionAlgorithmCreateFunc* m_emptyCreateFunc;
+
+    btAlignedObjectArray<btVector3> m_aabbs;  ///< scratch space for UpdateAabbs
+    bool m_incremental_aabb;                  ///< update only the AABBs of models that moved
+
+    std::vector<char> m_report_manifold;             ///< manifolds accepted by the broadphase callback
+    std::vector<int> m_report_offsets;               ///< offsets of each manifold's contacts in the batch
+    std::vector<ChCollisionInfo> m_report_contacts;  ///< batch of contacts passed to the contact container
 };
 
 }  // end namespace collision
@@ -0,0 +1,352 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/collision/ChCCollisionSystemPrimitive.h"
+#include "chrono/core/ChLog.h"
+#include "chrono/physics/ChContactContainer.h"
+#include "chrono/physics/ChProximityContainer.h"
+
+namespace chrono {
+namespace collision {
+
+ChCollisionSystemPrimitive::ChCollisionSystemPrimitive() {
+    m_timer_broad.reset();
+    m_timer_narrow.reset();
+}
+
+void ChCollisionSystemPrimitive::Clear(void) {
+    m_pairs.clear();
+    m_contacts.clear();
+}
+
+void ChCollisionSystemPrimitive::Add(ChCollisionModel* model) {
+    auto pmodel = dynamic_cast<ChModelPrimitive*>(model);
+    if (!pmodel) {
+        GetLog() << "ChCollisionSystemPrimitive: collision model is not a ChModelPrimitive, ignored.\n";
+        return;
+    }
+    if (std::find(m_models.begin(), m_models.end(), pmodel) == m_models.end())
+        m_models.push_back(pmodel);
+}
+
+void ChCollisionSystemPrimitive::Remove(ChCollisionModel* model) {
+    auto pos = std::find(m_models.begin(), m_models.end(), model);
+    if (pos != m_models.end())
+        m_models.erase(pos);
+}
+
+void ChCollisionSystemPrimitive::ResetTimers() {
+    m_timer_broad.reset();
+    m_timer_narrow.reset();
+}
+
+void ChCollisionSystemPrimitive::Run() {
+    m_timer_broad.start();
+    RunBroadphase();
+    m_timer_broad.stop();
+
+    m_timer_narrow.start();
+    RunNarrowphase();
+    m_timer_narrow.stop();
+}
+
+void ChCollisionSystemPrimitive::RunBroadphase() {
+    int num_models = (int)m_models.size();
+
+    // Gather all shapes, with their AABBs inflated by the model envelope
+    // (and, for speculative contacts, swept by the model motion over the time step)
+    bool speculative = speculative_contacts && speculative_dt > 0;
+    m_shape_offsets.resize(num_models + 1);
+    m_shape_offsets[0] = 0;
+    for (int i = 0; i < num_models; i++)
+        m_shape_offsets[i + 1] = m_shape_offsets[i] + (int)m_models[i]->GetAbsoluteShapes().size();
+    int num_shapes = m_shape_offsets[num_models];
+    m_shapes.resize(num_shapes);
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < num_models; i++) {
+        ChModelPrimitive* model = m_models[i];
+        const std::vector<ChPrimitiveShape>& shapes = model->GetAbsoluteShapes();
+        if (shapes.empty())
+            continue;
+        ChVector<> envelope(model->GetEnvelope());
+
+        // Displacement bounds over the step. The velocity field of the model is affine in the position,
+        // so its extremes over the model box are found at the box corners.
+        ChVector<> sweep_min(0);
+        ChVector<> sweep_max(0);
+        double sweep = 0;
+        if (speculative && model->GetContactable()->IsContactActive()) {
+            ChVector<> bbmin;
+            ChVector<> bbmax;
+            model->GetAABB(bbmin, bbmax);
+            for (int corner = 0; corner < 8; corner++) {
+                ChVector<> p((corner & 1) ? bbmax.x() : bbmin.x(), (corner & 2) ? bbmax.y() : bbmin.y(),
+                             (corner & 4) ? bbmax.z() : bbmin.z());
+                ChVector<> d = model->GetContactable()->GetContactPointSpeed(p) * speculative_dt;
+                for (int k = 0; k < 3; k++) {
+                    sweep_min[k] = std::min(sweep_min[k], d[k]);
+                    sweep_max[k] = std::max(sweep_max[k], d[k]);
+                }
+                sweep = std::max(sweep, d.Length());
+            }
+        }
+
+        for (int j = 0; j < (int)shapes.size(); j++) {
+            ShapeRef& ref = m_shapes[m_shape_offsets[i] + j];
+            ref.model = model;
+            ref.shape = j;
+            ref.sweep = sweep;
+            ChModelPrimitive::ComputeAABB(shapes[j], ref.bbmin, ref.bbmax);
+            ref.bbmin += sweep_min - envelope;
+            ref.bbmax += sweep_max + envelope;
+        }
+    }
+
+    // Sweep along the axis with largest variance of the AABB centers
+    ChVector<> sum(0);
+    ChVector<> sum2(0);
+    for (int i = 0; i < num_shapes; i++) {
+        ChVector<> c = (m_shapes[i].bbmin + m_shapes[i].bbmax) * 0.5;
+        sum += c;
+        sum2 += ChVector<>(c.x() * c.x(), c.y() * c.y(), c.z() * c.z());
+    }
+    int axis = 0;
+    double var_max = -1;
+    for (int k = 0; k < 3; k++) {
+        double var = num_shapes > 0 ? sum2[k] / num_shapes - (sum[k] / num_shapes) * (sum[k] / num_shapes) : 0;
+        if (var > var_max) {
+            var_max = var;
+            axis = k;
+        }
+    }
+
+    m_sorted.resize(num_shapes);
+    for (int i = 0; i < num_shapes; i++)
+        m_sorted[i] = i;
+    std::sort(m_sorted.begin(), m_sorted.end(), [this, axis](int a, int b) {
+        double ma = m_shapes[a].bbmin[axis];
+        double mb = m_shapes[b].bbmin[axis];
+        return ma < mb || (ma == mb && a < b);
+    });
+
+    // Test if the two shapes must be passed to the narrowphase
+    auto check_pair = [this](const ShapeRef& A, const ShapeRef& B) -> bool {
+        if (A.model == B.model)
+            return false;
+        for (int k = 0; k < 3; k++) {
+            if (A.bbmin[k] > B.bbmax[k] || B.bbmin[k] > A.bbmax[k])
+                return false;
+        }
+        if (!(A.model->GetFamilyGroup() & B.model->GetFamilyMask()) ||
+            !(B.model->GetFamilyGroup() & A.model->GetFamilyMask()))
+            return false;
+        if (!A.model->GetContactable()->IsContactActive() && !B.model->GetContactable()->IsContactActive())
+            return false;
+        return true;
+    };
+
+    // Count the pairs of each shape, then fill them, so that the result does not depend on the number of threads
+    m_pair_offsets.resize(num_shapes + 1);
+#pragma omp parallel for schedule(dynamic, 256)
+    for (int i = 0; i < num_shapes; i++) {
+        const ShapeRef& A = m_shapes[m_sorted[i]];
+        int count = 0;
+        for (int j = i + 1; j < num_shapes; j++) {
+            const ShapeRef& B = m_shapes[m_sorted[j]];
+            if (B.bbmin[axis] > A.bbmax[axis])
+                break;
+            if (check_pair(A, B))
+                count++;
+        }
+        m_pair_offsets[i + 1] = count;
+    }
+
+    m_pair_offsets[0] = 0;
+    for (int i = 0; i < num_shapes; i++)
+        m_pair_offsets[i + 1] += m_pair_offsets[i];
+    m_pairs.resize(m_pair_offsets[num_shapes]);
+
+#pragma omp parallel for schedule(dynamic, 256)
+    for (int i = 0; i < num_shapes; i++) {
+        const ShapeRef& A = m_shapes[m_sorted[i]];
+        int k = m_pair_offsets[i];
+        for (int j = i + 1; k < m_pair_offsets[i + 1]; j++) {
+            const ShapeRef& B = m_shapes[m_sorted[j]];
+            if (check_pair(A, B)) {
+                m_pairs[k].a = m_sorted[i];
+                m_pairs[k].b = m_sorted[j];
+                k++;
+            }
+        }
+    }
+
+    // Execute custom broadphase callback, if any (serially, user callbacks need not be thread safe)
+    if (this->broad_callback) {
+        size_t nkept = 0;
+        for (size_t k = 0; k < m_pairs.size(); k++) {
+            if (this->broad_callback->OnBroadphase(m_shapes[m_pairs[k].a].model, m_shapes[m_pairs[k].b].model))
+                m_pairs[nkept++] = m_pairs[k];
+        }
+        m_pairs.resize(nkept);
+    }
+}
+
+void ChCollisionSystemPrimitive::RunNarrowphase() {
+    const int max_contacts = ChNarrowphasePrimitive::MAX_CONTACTS;
+    int num_pairs = (int)m_pairs.size();
+
+    m_pair_contacts.resize(num_pairs * max_contacts);
+    m_contact_offsets.resize(num_pairs + 1);
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < num_pairs; i++) {
+        const ShapeRef& A = m_shapes[m_pairs[i].a];
+        const ShapeRef& B = m_shapes[m_pairs[i].b];
+        // For speculative contacts, also accept pairs that may come into contact within the step
+        double separation = A.model->GetEnvelope() + B.model->GetEnvelope() + A.sweep + B.sweep;
+        m_contact_offsets[i + 1] =
+            ChNarrowphasePrimitive::Collide(A.model->GetAbsoluteShapes()[A.shape], B.model->GetAbsoluteShapes()[B.shape],
+                                            separation, &m_pair_contacts[i * max_contacts]);
+    }
+
+    m_contact_offsets[0] = 0;
+    for (int i = 0; i < num_pairs; i++)
+        m_contact_offsets[i + 1] += m_contact_offsets[i];
+    m_contacts.resize(m_contact_offsets[num_pairs]);
+
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < num_pairs; i++) {
+        ChCollisionModel* modelA = m_shapes[m_pairs[i].a].model;
+        ChCollisionModel* modelB = m_shapes[m_pairs[i].b].model;
+        int n = m_contact_offsets[i + 1] - m_contact_offsets[i];
+        for (int j = 0; j < n; j++) {
+            const ChNarrowphasePrimitive::Contact& c = m_pair_contacts[i * max_contacts + j];
+            ChCollisionInfo& icontact = m_contacts[m_contact_offsets[i] + j];
+            icontact.modelA = modelA;
+            icontact.modelB = modelB;
+            icontact.vpA = c.pA;
+            icontact.vpB = c.pB;
+            icontact.vN = c.normal;
+            icontact.distance = c.distance;
+            icontact.eff_radius = c.eff_radius;
+            icontact.reaction_cache = nullptr;
+        }
+    }
+}
+
+void ChCollisionSystemPrimitive::ReportContacts(ChContactContainer* mcontactcontainer) {
+    // Execute some user custom callback, if any, discarding the contacts it rejects
+    if (this->narrow_callback) {
+        size_t nkept = 0;
+        for (size_t k = 0; k < m_contacts.size(); k++) {
+            if (this->narrow_callback->OnNarrowphase(m_contacts[k])) {
+                if (nkept != k)
+                    m_contacts[nkept] = m_contacts[k];
+                nkept++;
+            }
+        }
+        m_contacts.resize(nkept);
+    }
+
+    mcontactcontainer->BeginAddContact();
+    mcontactcontainer->AddContacts(m_contacts);
+    mcontactcontainer->EndAddContact();
+}
+
+void ChCollisionSystemPrimitive::ReportProximities(ChProximityContainer* mproximitycontainer) {
+    mproximitycontainer->BeginAddProximities();
+    mproximitycontainer->EndAddProximities();
+}
+
+bool ChCollisionSystemPrimitive::RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& mresult) const {
+    mresult.hit = false;
+    mresult.dist_factor = 2;
+    for (auto model : m_models) {
+        ChRayhitResult result;
+        if (RayHit(from, to, model, result) && result.dist_factor < mresult.dist_factor)
+            mresult = result;
+    }
+    return mresult.hit;
+}
+
+void ChCollisionSystemPrimitive::RayHitBatch(int num_rays,
+                                             const ChVector<>* from,
+                                             const ChVector<>* to,
+                                             ChRayhitResult* results,
+                                             const short int* family_masks) const {
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < num_rays; i++) {
+        ChRayhitResult& mresult = results[i];
+        mresult.hit = false;
+        for (auto model : m_models) {
+            if (family_masks && !(model->GetFamilyGroup() & family_masks[i]))
+                continue;
+            ChRayhitResult result;
+            if (RayHit(from[i], to[i], model, result) && (!mresult.hit || result.dist_factor < mresult.dist_factor))
+                mresult = result;
+        }
+    }
+}
+
+bool ChCollisionSystemPrimitive::RayHit(const ChVector<>& from,
+                                        const ChVector<>& to,
+                                        ChCollisionModel* model,
+                                        ChRayhitResult& mresult) const {
+    mresult.hit = false;
+    auto pmodel = dynamic_cast<ChModelPrimitive*>(model);
+    if (!pmodel)
+        return false;
+
+    // Quick rejection against the model AABB (slab test)
+    ChVector<> bbmin;
+    ChVector<> bbmax;
+    pmodel->GetAABB(bbmin, bbmax);
+    ChVector<> d = to - from;
+    double tmin = 0;
+    double tmax = 1;
+    for (int k = 0; k < 3; k++) {
+        if (std::abs(d[k]) < 1e-12) {
+            if (from[k] < bbmin[k] || from[k] > bbmax[k])
+                return false;
+            continue;
+        }
+        double t1 = (bbmin[k] - from[k]) / d[k];
+        double t2 = (bbmax[k] - from[k]) / d[k];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+        if (tmin > tmax)
+            return false;
+    }
+
+    for (const auto& shape : pmodel->GetAbsoluteShapes()) {
+        double fraction;
+        ChVector<> normal;
+        if (ChNarrowphasePrimitive::RayHit(shape, from, to, fraction, normal) &&
+            (!mresult.hit || fraction < mresult.dist_factor)) {
+            mresult.hit = true;
+            mresult.dist_factor = fraction;
+            mresult.abs_hitNormal = normal;
+        }
+    }
+
+    if (mresult.hit) {
+        mresult.hitModel = model;
+        mresult.abs_hitPoint = from + d * mresult.dist_factor;
+    }
+    return mresult.hit;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
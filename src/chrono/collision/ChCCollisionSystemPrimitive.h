@@ -0,0 +1,134 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHC_COLLISIONSYSTEMPRIMITIVE_H
+#define CHC_COLLISIONSYSTEMPRIMITIVE_H
+
+#include <vector>
+
+#include "chrono/collision/ChCCollisionSystem.h"
+#include "chrono/collision/ChCModelPrimitive.h"
+#include "chrono/collision/ChCNarrowphasePrimitive.h"
+#include "chrono/core/ChTimer.h"
+
+namespace chrono {
+namespace collision {
+
+///
+/// Class for a collision engine specialized for primitive shapes (spheres, boxes, capsules and
+/// cylinders), to be used with ChModelPrimitive collision models.
+/// A sort-and-sweep broadphase on the shape AABBs is followed by analytic (or MPR-based) narrowphase
+/// tests, with both stages executed in parallel (OpenMP). Contacts are regenerated at each Run(), there
+/// is no persistent contact cache. The contacts are reported in an order which does not depend on the
+/// number of threads.
+///
+/// Speculative contacts (see ChCollisionSystem::SetSpeculativeContacts) are supported: the shape boxes
+/// are swept by the motion of their model over the step, and contacts are generated up to the maximum
+/// distance the two models can travel in the step.
+///
+/// The collision system must be set with ChSystem::SetCollisionSystem() before any body is added, and
+/// the bodies must use ChModelPrimitive collision models (e.g. passed to the ChBodyEasy... constructors).
+///
+
+class ChApi ChCollisionSystemPrimitive : public ChCollisionSystem {
+  public:
+    ChCollisionSystemPrimitive();
+    virtual ~ChCollisionSystemPrimitive() {}
+
+    /// Clears all data instanced by this algorithm.
+    virtual void Clear(void) override;
+
+    /// Adds a collision model to the collision engine.
+    /// The model must be a ChModelPrimitive.
+    virtual void Add(ChCollisionModel* model) override;
+
+    /// Removes a collision model from the collision engine.
+    virtual void Remove(ChCollisionModel* model) override;
+
+    /// Run the broadphase and narrowphase and find all the contacts.
+    virtual void Run() override;
+
+    /// Reset timers for collision detection.
+    virtual void ResetTimers() override;
+
+    /// Return the time (in seconds) for broadphase collision detection.
+    virtual double GetTimerCollisionBroad() const override { return m_timer_broad(); }
+
+    /// Return the time (in seconds) for narrowphase collision detection.
+    virtual double GetTimerCollisionNarrow() const override { return m_timer_narrow(); }
+
+    /// Fill the contact container with the contacts found by the last Run().
+    /// The contacts are passed in a single batch with AddContacts(). The narrowphase callback, if any,
+    /// is invoked serially for each contact.
+    virtual void ReportContacts(ChContactContainer* mcontactcontainer) override;
+
+    /// Proximities are not reported by this collision system.
+    virtual void ReportProximities(ChProximityContainer* mproximitycontainer) override;
+
+    /// Perform a ray-hit test with all collision models.
+    virtual bool RayHit(const ChVector<>& from, const ChVector<>& to, ChRayhitResult& mresult) const override;
+
+    /// Perform a ray-hit test with the specified collision model.
+    virtual bool RayHit(const ChVector<>& from,
+                        const ChVector<>& to,
+                        ChCollisionModel* model,
+                        ChRayhitResult& mresult) const override;
+
+    /// Perform a batch of ray-hit tests with all collision models (in parallel over the rays).
+    /// If provided, the family masks select the collision families that each ray can hit.
+    virtual void RayHitBatch(int num_rays,
+                             const ChVector<>* from,
+                             const ChVector<>* to,
+                             ChRayhitResult* results,
+                             const short int* family_masks = nullptr) const override;
+
+    /// Return the number of shape pairs found by the last broadphase.
+    size_t GetNumBroadphasePairs() const { return m_pairs.size(); }
+
+  private:
+    /// Shape entry used in the broadphase.
+    struct ShapeRef {
+        ChModelPrimitive* model;
+        int shape;
+        ChVector<> bbmin;
+        ChVector<> bbmax;
+        double sweep;  ///< max displacement of the model over the step (speculative contacts)
+    };
+
+    /// Shape pair found by the broadphase (indices in m_shapes).
+    struct ShapePair {
+        int a;
+        int b;
+    };
+
+    void RunBroadphase();
+    void RunNarrowphase();
+
+    std::vector<ChModelPrimitive*> m_models;  ///< collision models in the system
+
+    std::vector<ShapeRef> m_shapes;          ///< all shapes, with AABBs inflated by the model envelope
+    std::vector<int> m_shape_offsets;        ///< offset of each model's shapes in m_shapes
+    std::vector<int> m_sorted;               ///< shape indices sorted along the sweep axis
+    std::vector<int> m_pair_offsets;         ///< offset of the pairs of each sorted shape
+    std::vector<ShapePair> m_pairs;          ///< broadphase pairs
+    std::vector<int> m_contact_offsets;      ///< offset of the contacts of each pair
+    std::vector<ChNarrowphasePrimitive::Contact> m_pair_contacts;  ///< narrowphase scratch space
+    std::vector<ChCollisionInfo> m_contacts;                       ///< contacts found by the last Run()
+
+    ChTimer<double> m_timer_broad;
+    ChTimer<double> m_timer_narrow;
+};
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
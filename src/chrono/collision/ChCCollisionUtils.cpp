@@ -176,11 +176,28 @@ bool DegenerateTriangle(Vector Dx, Vector Dy) {
     return false;
 }
 
-ChConvexHullLibraryWrapper::ChConvexHullLibraryWrapper() {
+ChConvexHullLibraryWrapper::ChConvexHullLibraryWrapper() : m_cache(ChConvexHullCache::GetDefaultCache()) {
 }
 
 void ChConvexHullLibraryWrapper::ComputeHull(const std::vector<ChVector<> >& points,
                                              geometry::ChTriangleMeshConnected& vshape) {
+    // Look up the hull of the same points
+    uint64_t key = 0;
+    if (m_cache) {
+        ChConvexHullCache::Hasher hasher;
+        hasher.Add(std::string("HULL"));
+        for (const auto& p : points)
+            hasher.Add(p);
+        key = hasher.GetHash();
+        std::vector<ChConvexHullCache::Hull> hulls;
+        if (m_cache->Load(key, hulls) && hulls.size() == 1) {
+            vshape.Clear();
+            vshape.getCoordsVertices() = hulls[0].points;
+            vshape.getIndicesVertexes() = hulls[0].triangles;
+            return;
+        }
+    }
+
     HullLibrary hl;
     HullResult hresult;
     HullDesc desc;
@@ -212,6 +229,13 @@ void ChConvexHullLibraryWrapper::ComputeHull(const std::vector<ChVector<> >& poi
             vshape.getCoordsVertices()[iv] = ChVector<>(
                 hresult.m_OutputVertices[iv].x(), hresult.m_OutputVertices[iv].y(), hresult.m_OutputVertices[iv].z());
         }
+
+        if (m_cache) {
+            std::vector<ChConvexHullCache::Hull> hulls(1);
+            hulls[0].points = vshape.getCoordsVertices();
+            hulls[0].triangles = vshape.getIndicesVertexes();
+            m_cache->Store(key, hulls);
+        }
     }
 
     delete[] btpoints;
@@ -13,6 +13,7 @@
 #ifndef CHCOLLISIONUTILS_H
 #define CHCOLLISIONUTILS_H
 
+#include "chrono/collision/ChCConvexHullCache.h"
 #include "chrono/collision/bullet/LinearMath/btConvexHull.h"
 #include "chrono/geometry/ChTriangleMeshConnected.h"
 #include "chrono/physics/ChBody.h"
@@ -63,6 +64,13 @@ class ChApi ChConvexHullLibraryWrapper {
     ChConvexHullLibraryWrapper();
 
     void ComputeHull(const std::vector<ChVector<> >& points, geometry::ChTriangleMeshConnected& vshape);
+
+    /// Set an on-disk cache for the computed hulls, keyed by the input points.
+    /// By default, the cache is ChConvexHullCache::GetDefaultCache().
+    void SetCache(std::shared_ptr<ChConvexHullCache> cache) { m_cache = cache; }
+
+  private:
+    std::shared_ptr<ChConvexHullCache> m_cache;
 };
 
 }  // end namespace collision
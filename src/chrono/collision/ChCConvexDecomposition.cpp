@@ -57,7 +57,7 @@ void FuseMesh(std::vector<ChVector<double> >& vertexIN,
 ////////////////////////////////////////////////////////////////////////////
 
 /// Basic constructor
-ChConvexDecomposition::ChConvexDecomposition() {
+ChConvexDecomposition::ChConvexDecomposition() : m_cache(ChConvexHullCache::GetDefaultCache()), m_from_cache(false) {
 }
 
 /// Destructor
@@ -94,6 +94,25 @@ bool ChConvexDecomposition::WriteConvexHullsAsChullsFile(ChStreamOutAscii& mstre
     return true;
 }
 
+void ChConvexDecomposition::WriteCachedHullsAsWavefrontObj(ChStreamOutAscii& mstream) {
+    mstream << "# Convex hulls obtained with Chrono::Engine \n# convex decomposition \n\n";
+    unsigned int vcount_base = 1;
+    char buffer[200];
+    for (unsigned int hullIndex = 0; hullIndex < m_cached_hulls.size(); hullIndex++) {
+        const ChConvexHullCache::Hull& hull = m_cached_hulls[hullIndex];
+        mstream << "g hull_" << hullIndex << "\n";
+        for (const auto& p : hull.points) {
+            sprintf(buffer, "v %0.9f %0.9f %0.9f\r\n", p.x(), p.y(), p.z());
+            mstream << buffer;
+        }
+        for (const auto& t : hull.triangles) {
+            sprintf(buffer, "f %d %d %d\r\n", t.x() + vcount_base, t.y() + vcount_base, t.z() + vcount_base);
+            mstream << buffer;
+        }
+        vcount_base += (unsigned int)hull.points.size();
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -104,6 +123,7 @@ bool ChConvexDecomposition::WriteConvexHullsAsChullsFile(ChStreamOutAscii& mstre
 /// Basic constructor
 ChConvexDecompositionHACD::ChConvexDecompositionHACD() {
     myHACD = HACD::CreateHACD();
+    m_params_hash = ChConvexHullCache::Hasher().GetHash();
 }
 
 /// Destructor
@@ -120,6 +140,10 @@ void ChConvexDecompositionHACD::Reset(void) {
     myHACD = HACD::CreateHACD();
     this->points.clear();
     this->triangles.clear();
+    m_params_hash = ChConvexHullCache::Hasher().GetHash();
+    m_input_hash = ChConvexHullCache::Hasher();
+    m_cached_hulls.clear();
+    m_from_cache = false;
 }
 
 bool ChConvexDecompositionHACD::AddTriangle(const ChVector<>& v1, const ChVector<>& v2, const ChVector<>& v3) {
@@ -132,6 +156,9 @@ bool ChConvexDecompositionHACD::AddTriangle(const ChVector<>& v1, const ChVector
     this->points.push_back(vertex3);
     HACD::Vec3<long> newtri(lastpoint, lastpoint + 1, lastpoint + 2);
     this->triangles.push_back(newtri);
+    m_input_hash.Add(v1);
+    m_input_hash.Add(v2);
+    m_input_hash.Add(v3);
     return true;
 }
 
@@ -163,9 +190,38 @@ void ChConvexDecompositionHACD::SetParameters(unsigned int nClusters,
     myHACD->SetVolumeWeight(volumeWeight);
     myHACD->SetCompacityWeight(compacityAlpha);
     myHACD->SetNVerticesPerCH(nVerticesPerCH);
+
+    ChConvexHullCache::Hasher hasher;
+    hasher.Add(nClusters);
+    hasher.Add(targetDecimation);
+    hasher.Add(smallClusterThreshold);
+    hasher.Add(addFacesPoints);
+    hasher.Add(addExtraDistPoints);
+    hasher.Add(concavity);
+    hasher.Add(ccConnectDist);
+    hasher.Add(volumeWeight);
+    hasher.Add(compacityAlpha);
+    hasher.Add(nVerticesPerCH);
+    m_params_hash = hasher.GetHash();
 }
 
 int ChConvexDecompositionHACD::ComputeConvexDecomposition() {
+    m_from_cache = false;
+    m_cached_hulls.clear();
+
+    // Look up the results for the same input triangles and parameters
+    uint64_t key = 0;
+    if (m_cache) {
+        ChConvexHullCache::Hasher hasher = m_input_hash;
+        hasher.Add(std::string("HACD"));
+        hasher.Add(&m_params_hash, sizeof(m_params_hash));
+        key = hasher.GetHash();
+        if (m_cache->Load(key, m_cached_hulls)) {
+            m_from_cache = true;
+            return (int)m_cached_hulls.size();
+        }
+    }
+
     myHACD->SetPoints(&this->points[0]);
     myHACD->SetNPoints(points.size());
     myHACD->SetTriangles(&this->triangles[0]);
@@ -173,16 +229,41 @@ int ChConvexDecompositionHACD::ComputeConvexDecomposition() {
 
     myHACD->Compute();
 
+    if (m_cache) {
+        std::vector<ChConvexHullCache::Hull> hulls(myHACD->GetNClusters());
+        for (unsigned int ih = 0; ih < hulls.size(); ih++) {
+            size_t nPoints = myHACD->GetNPointsCH(ih);
+            size_t nTriangles = myHACD->GetNTrianglesCH(ih);
+            std::vector<HACD::Vec3<HACD::Real> > pointsCH(nPoints);
+            std::vector<HACD::Vec3<long> > trianglesCH(nTriangles);
+            myHACD->GetCH(ih, pointsCH.data(), trianglesCH.data());
+            for (const auto& p : pointsCH)
+                hulls[ih].points.push_back(ChVector<>(p.X(), p.Y(), p.Z()));
+            for (const auto& t : trianglesCH)
+                hulls[ih].triangles.push_back(ChVector<int>((int)t.X(), (int)t.Y(), (int)t.Z()));
+        }
+        m_cache->Store(key, hulls);
+    }
+
     return (int)myHACD->GetNClusters();
 }
 
 /// Get the number of computed hulls after the convex decomposition
 unsigned int ChConvexDecompositionHACD::GetHullCount() {
+    if (m_from_cache)
+        return (unsigned int)m_cached_hulls.size();
     return (unsigned int)this->myHACD->GetNClusters();
 }
 
 bool ChConvexDecompositionHACD::GetConvexHullResult(unsigned int hullIndex,
                                                     std::vector<ChVector<double> >& convexhull) {
+    if (m_from_cache) {
+        if (hullIndex >= m_cached_hulls.size())
+            return false;
+        convexhull = m_cached_hulls[hullIndex].points;
+        return true;
+    }
+
     if (hullIndex > myHACD->GetNClusters())
         return false;
 
@@ -212,6 +293,15 @@ bool ChConvexDecompositionHACD::GetConvexHullResult(unsigned int hullIndex,
 /// Get the n-th computed convex hull, by filling a ChTriangleMesh object
 /// that is passed as a parameter.
 bool ChConvexDecompositionHACD::GetConvexHullResult(unsigned int hullIndex, geometry::ChTriangleMesh& convextrimesh) {
+    if (m_from_cache) {
+        if (hullIndex >= m_cached_hulls.size())
+            return false;
+        const ChConvexHullCache::Hull& hull = m_cached_hulls[hullIndex];
+        for (const auto& t : hull.triangles)
+            convextrimesh.addTriangle(hull.points[t.x()], hull.points[t.y()], hull.points[t.z()]);
+        return true;
+    }
+
     if (hullIndex > myHACD->GetNClusters())
         return false;
 
@@ -245,6 +335,11 @@ bool ChConvexDecompositionHACD::GetConvexHullResult(unsigned int hullIndex, geom
 //
 
 void ChConvexDecompositionHACD::WriteConvexHullsAsWavefrontObj(ChStreamOutAscii& mstream) {
+    if (m_from_cache) {
+        WriteCachedHullsAsWavefrontObj(mstream);
+        return;
+    }
+
     mstream << "# Convex hulls obtained with Chrono::Engine \n# convex decomposition \n\n";
     NxU32 vcount_base = 1;
     NxU32 vcount_total = 0;
@@ -311,6 +406,9 @@ ChConvexDecompositionJR::~ChConvexDecompositionJR() {
 
 void ChConvexDecompositionJR::Reset(void) {
     this->mydecomposition->reset();
+    m_input_hash = ChConvexHullCache::Hasher();
+    m_cached_hulls.clear();
+    m_from_cache = false;
 }
 
 bool ChConvexDecompositionJR::AddTriangle(const ChVector<>& v1, const ChVector<>& v2, const ChVector<>& v3) {
@@ -326,6 +424,9 @@ bool ChConvexDecompositionJR::AddTriangle(const ChVector<>& v1, const ChVector<>
     p3[0] = (float)v3.x();
     p3[1] = (float)v3.y();
     p3[2] = (float)v3.z();
+    m_input_hash.Add(v1);
+    m_input_hash.Add(v2);
+    m_input_hash.Add(v3);
     return this->mydecomposition->addTriangle(p1, p2, p3);
 }
 
@@ -359,19 +460,76 @@ void ChConvexDecompositionJR::SetParameters(
 }
 
 int ChConvexDecompositionJR::ComputeConvexDecomposition() {
-    return this->mydecomposition->computeConvexDecomposition(
+    m_from_cache = false;
+    m_cached_hulls.clear();
+
+    // Look up the results for the same input triangles and parameters
+    uint64_t key = 0;
+    if (m_cache) {
+        ChConvexHullCache::Hasher hasher = m_input_hash;
+        hasher.Add(std::string("JR"));
+        hasher.Add(skinWidth);
+        hasher.Add(decompositionDepth);
+        hasher.Add(maxHullVertices);
+        hasher.Add(concavityThresholdPercent);
+        hasher.Add(mergeThresholdPercent);
+        hasher.Add(volumeSplitThresholdPercent);
+        hasher.Add(useInitialIslandGeneration);
+        hasher.Add(useIslandGeneration);
+        key = hasher.GetHash();
+        if (m_cache->Load(key, m_cached_hulls)) {
+            m_from_cache = true;
+            return (int)m_cached_hulls.size();
+        }
+    }
+
+    int nhulls = this->mydecomposition->computeConvexDecomposition(
         skinWidth, decompositionDepth, maxHullVertices, concavityThresholdPercent, mergeThresholdPercent,
         volumeSplitThresholdPercent, useInitialIslandGeneration, useIslandGeneration, false);
+
+    if (m_cache) {
+        // The entry is stored only if all hulls are available; an incomplete entry would later be loaded as a hit
+        std::vector<ChConvexHullCache::Hull> hulls(this->mydecomposition->getHullCount());
+        bool complete = true;
+        for (unsigned int ih = 0; ih < hulls.size(); ih++) {
+            CONVEX_DECOMPOSITION::ConvexHullResult result;
+            if (!this->mydecomposition->getConvexHullResult(ih, result) || result.mVcount == 0) {
+                complete = false;
+                break;
+            }
+            for (unsigned int i = 0; i < result.mVcount; i++)
+                hulls[ih].points.push_back(
+                    ChVector<>(result.mVertices[i * 3 + 0], result.mVertices[i * 3 + 1], result.mVertices[i * 3 + 2]));
+            for (unsigned int i = 0; i < result.mTcount; i++)
+                hulls[ih].triangles.push_back(ChVector<int>(
+                    result.mIndices[i * 3 + 0], result.mIndices[i * 3 + 1], result.mIndices[i * 3 + 2]));
+        }
+        if (complete)
+            m_cache->Store(key, hulls);
+    }
+
+    return nhulls;
 }
 
 /// Get the number of computed hulls after the convex decomposition
 unsigned int ChConvexDecompositionJR::GetHullCount() {
+    if (m_from_cache)
+        return (unsigned int)m_cached_hulls.size();
     return this->mydecomposition->getHullCount();
 }
 
 /// Get the n-th computed convex hull, by filling a ChTriangleMesh object
 /// that is passed as a parameter.
 bool ChConvexDecompositionJR::GetConvexHullResult(unsigned int hullIndex, geometry::ChTriangleMesh& convextrimesh) {
+    if (m_from_cache) {
+        if (hullIndex >= m_cached_hulls.size())
+            return false;
+        const ChConvexHullCache::Hull& hull = m_cached_hulls[hullIndex];
+        for (const auto& t : hull.triangles)
+            convextrimesh.addTriangle(hull.points[t.x()], hull.points[t.y()], hull.points[t.z()]);
+        return true;
+    }
+
     CONVEX_DECOMPOSITION::ConvexHullResult result;
     if (!this->mydecomposition->getConvexHullResult(hullIndex, result))
         return false;
@@ -389,6 +547,13 @@ bool ChConvexDecompositionJR::GetConvexHullResult(unsigned int hullIndex, geomet
 }
 
 bool ChConvexDecompositionJR::GetConvexHullResult(unsigned int hullIndex, std::vector<ChVector<double> >& convexhull) {
+    if (m_from_cache) {
+        if (hullIndex >= m_cached_hulls.size())
+            return false;
+        convexhull = m_cached_hulls[hullIndex].points;
+        return true;
+    }
+
     CONVEX_DECOMPOSITION::ConvexHullResult result;
     if (!this->mydecomposition->getConvexHullResult(hullIndex, result))
         return false;
@@ -411,6 +576,11 @@ bool ChConvexDecompositionJR::GetConvexHullResult(unsigned int hullIndex, std::v
 /// '.obj' fileformat, with each hull as a separate group.
 /// May throw exceptions if file locked etc.
 void ChConvexDecompositionJR::WriteConvexHullsAsWavefrontObj(ChStreamOutAscii& mstream) {
+    if (m_from_cache) {
+        WriteCachedHullsAsWavefrontObj(mstream);
+        return;
+    }
+
     mstream << "# Convex hulls obtained with Chrono::Engine \n# convex decomposition \n\n";
     NxU32 vcount_base = 1;
     NxU32 vcount_total = 0;
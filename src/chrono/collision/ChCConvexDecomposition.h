@@ -15,6 +15,9 @@
 #ifndef CHC_CONVEXDECOMPOSITION_H
 #define CHC_CONVEXDECOMPOSITION_H
 
+#include <memory>
+
+#include "chrono/collision/ChCConvexHullCache.h"
 #include "chrono/collision/convexdecomposition/HACD/hacdHACD.h"
 #include "chrono/collision/convexdecomposition/HACDv2/HACD.h"
 #include "chrono/collision/convexdecomposition/JR/NvConvexDecomposition.h"
@@ -71,6 +74,18 @@ class ChApi ChConvexDecomposition {
     /// that is passed as a parameter.
     virtual bool GetConvexHullResult(unsigned int hullIndex, std::vector<ChVector<double> >& convexhull) = 0;
 
+    /// Set an on-disk cache for the results of the decomposition.
+    /// If set, ComputeConvexDecomposition() looks up the hulls computed earlier for the same input
+    /// triangles and parameters, and stores new results in the cache. Supported by the HACD and
+    /// JR decompositions. By default, the cache is ChConvexHullCache::GetDefaultCache().
+    void SetCache(std::shared_ptr<ChConvexHullCache> cache) { m_cache = cache; }
+
+    /// Get the on-disk cache for the results of the decomposition, if any.
+    std::shared_ptr<ChConvexHullCache> GetCache() const { return m_cache; }
+
+    /// Tell if the hulls of the last ComputeConvexDecomposition() were loaded from the cache.
+    bool IsFromCache() const { return m_from_cache; }
+
     //
     // SERIALIZATION
     //
@@ -88,7 +103,14 @@ class ChApi ChConvexDecomposition {
     // DATA
     //
 
-  private:
+  protected:
+    /// Write the hulls loaded from the cache as a Wavefront file.
+    void WriteCachedHullsAsWavefrontObj(ChStreamOutAscii& mstream);
+
+    std::shared_ptr<ChConvexHullCache> m_cache;           ///< optional on-disk cache of the results
+    ChConvexHullCache::Hasher m_input_hash;               ///< hash of the input triangles
+    std::vector<ChConvexHullCache::Hull> m_cached_hulls;  ///< hulls loaded from the cache
+    bool m_from_cache;                                    ///< true if the current hulls come from the cache
 };
 
 ///
@@ -177,6 +199,7 @@ class ChApi ChConvexDecompositionHACD : public ChConvexDecomposition {
     HACD::HACD* myHACD;
     std::vector<HACD::Vec3<HACD::Real> > points;
     std::vector<HACD::Vec3<long> > triangles;
+    uint64_t m_params_hash;  ///< hash of the parameters, for the cache key
 };
 
 ///
@@ -0,0 +1,179 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+#ifdef _WIN32
+#include <process.h>
+#define CH_GETPID _getpid
+#else
+#include <unistd.h>
+#define CH_GETPID getpid
+#endif
+
+#include "chrono/collision/ChCConvexHullCache.h"
+#include "chrono/core/ChLog.h"
+#include "chrono/core/ChStream.h"
+#include "chrono_thirdparty/filesystem/path.h"
+
+namespace chrono {
+namespace collision {
+
+// Cache file layout (all values through ChStreamOutBinary, i.e. with portable byte ordering):
+//   magic, version, key, number of hulls,
+//   for each hull: number of points, number of triangles, point coordinates, triangle indices,
+//   magic (end marker, to detect truncated files).
+static const unsigned int CACHE_MAGIC = 0x43484342;  // "CHCB"
+static const unsigned int CACHE_VERSION = 1;
+static const unsigned int CACHE_MAX_COUNT = 1u << 26;
+
+static std::shared_ptr<ChConvexHullCache> default_cache;
+
+// Counter of the temporary files written by this process.
+static std::atomic<unsigned int> tmp_counter(0);
+
+ChConvexHullCache::Hasher::Hasher() : m_hash(14695981039346656037ULL) {}
+
+void ChConvexHullCache::Hasher::Add(const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        m_hash ^= bytes[i];
+        m_hash *= 1099511628211ULL;
+    }
+}
+
+void ChConvexHullCache::Hasher::Add(const ChVector<double>& v) {
+    Add(v.x());
+    Add(v.y());
+    Add(v.z());
+}
+
+void ChConvexHullCache::Hasher::Add(const ChVector<int>& v) {
+    Add(v.x());
+    Add(v.y());
+    Add(v.z());
+}
+
+void ChConvexHullCache::Hasher::Add(const std::string& str) {
+    Add((unsigned int)str.size());
+    Add(str.data(), str.size());
+}
+
+// -----------------------------------------------------------------------------
+
+ChConvexHullCache::ChConvexHullCache(const std::string& directory) : m_directory(directory) {}
+
+std::string ChConvexHullCache::GetFilename(uint64_t key) const {
+    char name[32];
+    sprintf(name, "%016llx.chullsb", (unsigned long long)key);
+    return m_directory + "/" + name;
+}
+
+bool ChConvexHullCache::Load(uint64_t key, std::vector<Hull>& hulls) const {
+    std::string filename = GetFilename(key);
+    if (!filesystem::path(filename).exists())
+        return false;
+
+    try {
+        ChStreamInBinaryFile mstream(filename.c_str());
+
+        unsigned int magic;
+        unsigned int version;
+        unsigned long long file_key;
+        unsigned int num_hulls;
+        mstream >> magic >> version >> file_key >> num_hulls;
+        if (magic != CACHE_MAGIC || version != CACHE_VERSION || file_key != key || num_hulls > CACHE_MAX_COUNT)
+            return false;
+
+        std::vector<Hull> loaded(num_hulls);
+        for (auto& hull : loaded) {
+            unsigned int num_points;
+            unsigned int num_triangles;
+            mstream >> num_points >> num_triangles;
+            if (num_points == 0 || num_points > CACHE_MAX_COUNT || num_triangles > CACHE_MAX_COUNT)
+                return false;
+            hull.points.resize(num_points);
+            for (auto& p : hull.points)
+                mstream >> p.x() >> p.y() >> p.z();
+            hull.triangles.resize(num_triangles);
+            for (auto& t : hull.triangles)
+                mstream >> t.x() >> t.y() >> t.z();
+        }
+
+        mstream >> magic;
+        if (magic != CACHE_MAGIC)
+            return false;
+
+        hulls.swap(loaded);
+    } catch (ChException&) {
+        return false;
+    }
+
+    return true;
+}
+
+bool ChConvexHullCache::Store(uint64_t key, const std::vector<Hull>& hulls) const {
+    filesystem::create_directory(filesystem::path(m_directory));
+
+    // Write to a temporary file, then rename it, so that other processes sharing the
+    // cache directory never see a partially written entry. The temporary name is unique to
+    // this process, thread and call, so that concurrent writers of the same entry do not
+    // write to the same file.
+    std::string filename = GetFilename(key);
+    char suffix[64];
+    sprintf(suffix, ".%d.%llx.%u.tmp", (int)CH_GETPID(),
+            (unsigned long long)std::hash<std::thread::id>()(std::this_thread::get_id()), tmp_counter++);
+    std::string tmp_filename = filename + suffix;
+
+    try {
+        ChStreamOutBinaryFile mstream(tmp_filename.c_str());
+
+        mstream << CACHE_MAGIC << CACHE_VERSION << (unsigned long long)key << (unsigned int)hulls.size();
+        for (const auto& hull : hulls) {
+            mstream << (unsigned int)hull.points.size() << (unsigned int)hull.triangles.size();
+            for (const auto& p : hull.points)
+                mstream << p.x() << p.y() << p.z();
+            for (const auto& t : hull.triangles)
+                mstream << t.x() << t.y() << t.z();
+        }
+        mstream << CACHE_MAGIC;
+    } catch (ChException&) {
+        GetLog() << "Warning: cannot write convex hull cache file " << tmp_filename.c_str() << "\n";
+        std::remove(tmp_filename.c_str());
+        return false;
+    }
+
+    if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+        // rename does not replace an existing file on all platforms
+        std::remove(filename.c_str());
+        if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+            std::remove(tmp_filename.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ChConvexHullCache::SetDefaultCache(std::shared_ptr<ChConvexHullCache> cache) {
+    default_cache = cache;
+}
+
+std::shared_ptr<ChConvexHullCache> ChConvexHullCache::GetDefaultCache() {
+    return default_cache;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
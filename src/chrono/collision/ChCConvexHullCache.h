@@ -0,0 +1,101 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHC_CONVEXHULLCACHE_H
+#define CHC_CONVEXHULLCACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChVector.h"
+
+namespace chrono {
+namespace collision {
+
+///
+/// On-disk, content-addressed cache of convex hulls.
+/// Each entry is a set of convex hulls (e.g. the result of a convex decomposition, or a single
+/// convex hull) stored in a compact binary file named after a 64-bit key, in a cache directory.
+/// The key is a hash of all the inputs of the computation (mesh vertices and triangles, algorithm
+/// parameters), built with ChConvexHullCache::Hasher, so that a modified mesh or a different set of
+/// parameters never hits a stale entry.
+///
+
+class ChApi ChConvexHullCache {
+  public:
+    /// Convex hull stored in the cache: vertices and (optionally) triangles.
+    struct Hull {
+        std::vector<ChVector<double>> points;
+        std::vector<ChVector<int>> triangles;
+    };
+
+    /// Incremental 64-bit FNV-1a hash, used to build cache keys.
+    class ChApi Hasher {
+      public:
+        Hasher();
+
+        /// Add raw bytes to the hash.
+        void Add(const void* data, size_t size);
+
+        void Add(int val) { Add(&val, sizeof(val)); }
+        void Add(unsigned int val) { Add(&val, sizeof(val)); }
+        void Add(bool val) { Add((int)val); }
+        void Add(float val) { Add(&val, sizeof(val)); }
+        void Add(double val) { Add(&val, sizeof(val)); }
+        void Add(const ChVector<double>& v);
+        void Add(const ChVector<int>& v);
+        void Add(const std::string& str);
+
+        /// Get the current hash value.
+        uint64_t GetHash() const { return m_hash; }
+
+      private:
+        uint64_t m_hash;
+    };
+
+    /// Create a cache in the specified directory. The directory is created, if needed, at the first Store().
+    ChConvexHullCache(const std::string& directory);
+
+    /// Get the cache directory.
+    const std::string& GetDirectory() const { return m_directory; }
+
+    /// Get the name of the cache file for the given key.
+    std::string GetFilename(uint64_t key) const;
+
+    /// Load the hulls stored for the given key.
+    /// Return false if there is no entry for this key, or if the entry is not valid (including entries with an
+    /// empty hull).
+    bool Load(uint64_t key, std::vector<Hull>& hulls) const;
+
+    /// Store the hulls for the given key, replacing any previous entry.
+    /// Return false if the cache file could not be written.
+    bool Store(uint64_t key, const std::vector<Hull>& hulls) const;
+
+    /// Set the default cache, used by convex decompositions and convex hull computations
+    /// created afterwards (e.g. when collision models are built from triangle meshes).
+    /// Pass an empty pointer to disable caching (default).
+    static void SetDefaultCache(std::shared_ptr<ChConvexHullCache> cache);
+
+    /// Get the default cache (may be empty).
+    static std::shared_ptr<ChConvexHullCache> GetDefaultCache();
+
+  private:
+    std::string m_directory;
+};
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
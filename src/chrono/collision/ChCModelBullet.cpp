@@ -12,6 +12,7 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
 #include <memory>
 #include <array>
 
@@ -21,7 +22,9 @@
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/bt2DShape.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/btBarrelShape.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionShapes/btCEdeformableMeshShape.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/btCEtriangleShape.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h"
 #include "chrono/collision/bullet/BulletWorldImporter/btBulletWorldImporter.h"
 #include "chrono/collision/bullet/btBulletCollisionCommon.h"
 #include "chrono/collision/gimpact/GIMPACT/Bullet/btGImpactCollisionAlgorithm.h"
@@ -678,6 +681,75 @@ bool ChModelBullet::AddTriangleMeshConcave(std::shared_ptr<geometry::ChTriangleM
     return true;
 }
 
+bool ChModelBullet::AddTriangleMeshDeformable(std::shared_ptr<geometry::ChTriangleMesh> trimesh,
+                                              const ChVector<>& pos,
+                                              const ChMatrix33<>& rot,
+                                              double rebuild_threshold) {
+    if (!trimesh->getNumTriangles())
+        return false;
+
+    m_trimeshes.push_back(trimesh);  // cache pointer to triangle mesh
+
+    btCEdeformableMeshShape* pShape = new btCEdeformableMeshShape(trimesh);
+    pShape->getBVH().SetRebuildThreshold(rebuild_threshold);
+    pShape->setMargin((btScalar) this->GetEnvelope());
+    this->SetSafeMargin(0);
+
+    _injectShape(pos, rot, pShape);
+
+    return true;
+}
+
+// Bullet height field shape that also keeps alive the height data it references.
+// The data is read as btScalar values: the shared heights are used directly if Bullet is in double
+// precision, otherwise a single precision copy is kept.
+class btHeightfieldTerrainShape_handledata : public btHeightfieldTerrainShape {
+    std::shared_ptr<std::vector<double>> mheights;
+    std::vector<btScalar> mdata;
+
+  public:
+    btHeightfieldTerrainShape_handledata(std::shared_ptr<std::vector<double>> heights,
+                                         int nx,
+                                         int ny,
+                                         double hmin,
+                                         double hmax)
+        : btHeightfieldTerrainShape(nx, ny, heights->data(), 1, (btScalar)hmin, (btScalar)hmax, 2, PHY_FLOAT, true),
+          mheights(heights) {
+        if (sizeof(btScalar) != sizeof(double)) {
+            mdata.assign(heights->begin(), heights->begin() + nx * ny);
+            m_heightfieldDataFloat = mdata.data();
+            mheights.reset();
+        }
+    }
+};
+
+bool ChModelBullet::AddHeightField(std::shared_ptr<std::vector<double>> heights,
+                                   int nx,
+                                   int ny,
+                                   double sizeX,
+                                   double sizeY,
+                                   const ChVector<>& pos,
+                                   const ChMatrix33<>& rot) {
+    if (nx < 2 || ny < 2 || (int)heights->size() < nx * ny)
+        return false;
+
+    auto range = std::minmax_element(heights->begin(), heights->begin() + nx * ny);
+    double hmin = *range.first;
+    double hmax = *range.second;
+
+    // The Bullet shape is centered at the middle of the height range, with unit spacing of the grid nodes
+    btHeightfieldTerrainShape* pShape = new btHeightfieldTerrainShape_handledata(heights, nx, ny, hmin, hmax);
+    pShape->setLocalScaling(btVector3((btScalar)(sizeX / (nx - 1)), (btScalar)(sizeY / (ny - 1)), 1));
+
+    // As for concave triangle meshes, the surface is not shrunk and the margin is the envelope
+    // (contact distances are corrected by the envelopes in ReportContacts)
+    pShape->setMargin((btScalar)this->GetEnvelope());
+
+    _injectShape(pos + rot * ChVector<>(0, 0, (hmin + hmax) / 2), rot, pShape);
+
+    return true;
+}
+
 bool ChModelBullet::AddTriangleMeshConcaveDecomposed(std::shared_ptr<ChConvexDecomposition> mydecomposition,
                                                      const ChVector<>& pos,
                                                      const ChMatrix33<>& rot) {
@@ -763,6 +835,7 @@ void ChModelBullet::onFamilyChange() {
 
     auto mcs = std::static_pointer_cast<ChCollisionSystemBullet>(mcosys);
     mcs->GetBulletCollisionWorld()->addCollisionObject(bt_collision_object, family_group, family_mask);
+    bt_collision_object->forceActivationState(ACTIVE_TAG);
 }
 
 void ChModelBullet::GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const {
@@ -794,16 +867,56 @@ void ChModelBullet::SyncPosition()
 {
     ChCoordsys<> mcsys = this->mcontactable->GetCsysForCollisionModel();
 
-    bt_collision_object->getWorldTransform().setOrigin(btVector3(
-        (btScalar)mcsys.pos.x(), (btScalar)mcsys.pos.y(), (btScalar)mcsys.pos.z()));
     const ChMatrix33<>& rA(mcsys.rot);
     btMatrix3x3 basisA((btScalar)rA(0, 0), (btScalar)rA(0, 1), (btScalar)rA(0, 2), (btScalar)rA(1, 0),
                        (btScalar)rA(1, 1), (btScalar)rA(1, 2), (btScalar)rA(2, 0), (btScalar)rA(2, 1),
                        (btScalar)rA(2, 2));
-    bt_collision_object->getWorldTransform().setBasis(basisA);
+    btVector3 originA((btScalar)mcsys.pos.x(), (btScalar)mcsys.pos.y(), (btScalar)mcsys.pos.z());
+    btTransform transform(basisA, originA);
+
+    // Flag the model as moved (see ChCollisionSystemBullet::SetIncrementalAabbUpdate); models of sleeping or
+    // fixed bodies keep their transform, so their AABBs are not updated.
+    bool moved = !(transform == bt_collision_object->getWorldTransform());
+    bt_collision_object->setWorldTransform(transform);
+
+    // Refit the BVH of deformable meshes to the current mesh vertices
+    btCollisionShape* shape = bt_collision_object->getCollisionShape();
+    if (shape) {
+        if (shape->getShapeType() == CUSTOM_CONCAVE_SHAPE_TYPE) {
+            ((btCEdeformableMeshShape*)shape)->updateMesh();
+            moved = true;
+        } else if (shape->getShapeType() == COMPOUND_SHAPE_PROXYTYPE) {
+            btCompoundShape* compound = (btCompoundShape*)shape;
+            for (int i = 0; i < compound->getNumChildShapes(); i++) {
+                btCollisionShape* child = compound->getChildShape(i);
+                if (child->getShapeType() != CUSTOM_CONCAVE_SHAPE_TYPE)
+                    continue;
+                ((btCEdeformableMeshShape*)child)->updateMesh();
+                // update the child box in the compound tree, and the compound box
+                compound->updateChildTransform(i, compound->getChildTransform(i));
+                moved = true;
+            }
+        }
+    }
+
+    if (moved)
+        bt_collision_object->forceActivationState(ACTIVE_TAG);
 }
 
 
+void ChModelBullet::SetExternalAabbUpdate(bool val) {
+    int flags = bt_collision_object->getCollisionFlags();
+    if (val)
+        flags |= btCollisionObject::CF_EXTERNAL_AABB_UPDATE;
+    else
+        flags &= ~btCollisionObject::CF_EXTERNAL_AABB_UPDATE;
+    bt_collision_object->setCollisionFlags(flags);
+}
+
+bool ChModelBullet::GetExternalAabbUpdate() const {
+    return (bt_collision_object->getCollisionFlags() & btCollisionObject::CF_EXTERNAL_AABB_UPDATE) != 0;
+}
+
 bool ChModelBullet::SetSphereRadius(double coll_radius, double out_envelope) {
     if (this->shapes.size() != 1)
         return false;
@@ -812,6 +925,7 @@ bool ChModelBullet::SetSphereRadius(double coll_radius, double out_envelope) {
         this->SetEnvelope(out_envelope);
         mshape->setUnscaledRadius((btScalar)(coll_radius + out_envelope));
         // mshape->setMargin((btScalar) (coll_radius+out_envelope));
+        bt_collision_object->forceActivationState(ACTIVE_TAG);
     } else
         return false;
     return true;
@@ -155,6 +155,18 @@ class ChApi ChModelBullet : public ChCollisionModel {
         double sphereswept_thickness = 0.0                  ///< outward sphere-swept layer (when supported)
         ) override;
 
+    /// Add a height field to this model (see ChCollisionModel::AddHeightField).
+    /// A Bullet height field shape is used: it reads the grid heights directly (copied only if Bullet is built in
+    /// single precision), without building triangles or a bounding volume hierarchy. It collides with convex
+    /// shapes only.
+    virtual bool AddHeightField(std::shared_ptr<std::vector<double>> heights,
+                                int nx,
+                                int ny,
+                                double sizeX,
+                                double sizeY,
+                                const ChVector<>& pos = ChVector<>(),
+                                const ChMatrix33<>& rot = ChMatrix33<>(1)) override;
+
     /// CUSTOM for this class only: add a concave triangle mesh that will be managed
     /// by GImpact mesh-mesh algorithm. Note that, despite this can work with
     /// arbitrary meshes, there could be issues of robustness and precision, so
@@ -164,6 +176,17 @@ class ChApi ChModelBullet : public ChCollisionModel {
                                         const ChVector<>& pos = ChVector<>(),
                                         const ChMatrix33<>& rot = ChMatrix33<>(1));
 
+    /// CUSTOM for this class only: add a concave triangle mesh whose vertices can move (e.g. a mesh
+    /// attached to FEA nodes, or a morphing terrain surface). The mesh is referenced, not copied: at
+    /// each SyncPosition() its current vertices are read and the bounding volume hierarchy is refitted,
+    /// with a full rebuild only when the surface area heuristic cost of the refitted tree exceeds
+    /// 'rebuild_threshold' times the cost after the last build.
+    /// The mesh collides with convex shapes only (not with other concave meshes).
+    virtual bool AddTriangleMeshDeformable(std::shared_ptr<geometry::ChTriangleMesh> trimesh,
+                                           const ChVector<>& pos = ChVector<>(),
+                                           const ChMatrix33<>& rot = ChMatrix33<>(1),
+                                           double rebuild_threshold = 1.5);
+
     /// CUSTOM for this class only: add a concave triangle mesh that will be decomposed
     /// into a compound of convex shapes. Decomposition could be more efficient than
     /// AddTriangleMeshConcave(), but preprocessing decomposition might take a while, and
@@ -259,7 +282,8 @@ class ChApi ChModelBullet : public ChCollisionModel {
     virtual void GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const override;
 
     /// Sets the position and orientation of the collision
-    /// model as the current position of the corresponding ChContactable
+    /// model as the current position of the corresponding ChContactable.
+    /// If the model moved (or contains deformable meshes), it is flagged for the next AABB update.
     virtual void SyncPosition() override;
 
     /// If the collision shape is a sphere, resize it and return true (if no
@@ -276,6 +300,14 @@ class ChApi ChModelBullet : public ChCollisionModel {
     /// Return the pointer to the Bullet model
     btCollisionObject* GetBulletModel() { return this->bt_collision_object; }
 
+    /// Enable/disable external update of the AABB of this model.
+    /// If enabled, the collision system does not recompute the AABB of this model at each collision detection;
+    /// the owner is responsible for keeping it up to date (see ChCollisionSystemBullet::UpdateAabbs).
+    void SetExternalAabbUpdate(bool val);
+
+    /// Tell if the AABB of this model is updated externally.
+    bool GetExternalAabbUpdate() const;
+
   private:
     void _injectShape(const ChVector<>& pos, const ChMatrix33<>& rot, btCollisionShape* mshape);
 
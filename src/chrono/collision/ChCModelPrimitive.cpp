@@ -0,0 +1,143 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/collision/ChCModelPrimitive.h"
+#include "chrono/physics/ChContactable.h"
+
+namespace chrono {
+namespace collision {
+
+ChModelPrimitive::ChModelPrimitive() : m_aabb_min(VNULL), m_aabb_max(VNULL) {}
+
+int ChModelPrimitive::ClearModel() {
+    m_shapes.clear();
+    m_abs_shapes.clear();
+    return 1;
+}
+
+int ChModelPrimitive::BuildModel() {
+    m_abs_shapes = m_shapes;
+    if (GetContactable())
+        SyncPosition();
+    return 1;
+}
+
+void ChModelPrimitive::AddShape(ChPrimitiveShape::Type type,
+                                const ChVector<>& dims,
+                                const ChVector<>& pos,
+                                const ChMatrix33<>& rot) {
+    ChPrimitiveShape shape;
+    shape.type = type;
+    shape.dims = dims;
+    shape.pos = pos;
+    shape.rot = rot;
+    m_shapes.push_back(shape);
+}
+
+bool ChModelPrimitive::AddSphere(double radius, const ChVector<>& pos) {
+    AddShape(ChPrimitiveShape::SPHERE, ChVector<>(radius, 0, 0), pos, ChMatrix33<>(1));
+    return true;
+}
+
+bool ChModelPrimitive::AddBox(double hx, double hy, double hz, const ChVector<>& pos, const ChMatrix33<>& rot) {
+    AddShape(ChPrimitiveShape::BOX, ChVector<>(hx, hy, hz), pos, rot);
+    return true;
+}
+
+bool ChModelPrimitive::AddCylinder(double rx, double rz, double hy, const ChVector<>& pos, const ChMatrix33<>& rot) {
+    AddShape(ChPrimitiveShape::CYLINDER, ChVector<>(std::max(rx, rz), hy, 0), pos, rot);
+    return true;
+}
+
+bool ChModelPrimitive::AddCapsule(double radius, double hlen, const ChVector<>& pos, const ChMatrix33<>& rot) {
+    AddShape(ChPrimitiveShape::CAPSULE, ChVector<>(radius, hlen, 0), pos, rot);
+    return true;
+}
+
+bool ChModelPrimitive::AddCopyOfAnotherModel(ChCollisionModel* another) {
+    auto other = dynamic_cast<ChModelPrimitive*>(another);
+    if (!other)
+        return false;
+    m_shapes.insert(m_shapes.end(), other->m_shapes.begin(), other->m_shapes.end());
+    return true;
+}
+
+void ChModelPrimitive::SyncPosition() {
+    ChCoordsys<> csys = GetContactable()->GetCsysForCollisionModel();
+    ChMatrix33<> R(csys.rot);
+
+    m_abs_shapes.resize(m_shapes.size());
+
+    // A model without shapes has a degenerate AABB at its reference point
+    if (m_shapes.empty()) {
+        m_aabb_min = csys.pos;
+        m_aabb_max = csys.pos;
+        return;
+    }
+
+    m_aabb_min = ChVector<>(+1e30);
+    m_aabb_max = ChVector<>(-1e30);
+
+    for (size_t i = 0; i < m_shapes.size(); i++) {
+        ChPrimitiveShape& abs_shape = m_abs_shapes[i];
+        abs_shape.type = m_shapes[i].type;
+        abs_shape.dims = m_shapes[i].dims;
+        abs_shape.pos = csys.pos + R * m_shapes[i].pos;
+        abs_shape.rot = R * m_shapes[i].rot;
+
+        ChVector<> bbmin;
+        ChVector<> bbmax;
+        ComputeAABB(abs_shape, bbmin, bbmax);
+        for (int j = 0; j < 3; j++) {
+            m_aabb_min[j] = std::min(m_aabb_min[j], bbmin[j]);
+            m_aabb_max[j] = std::max(m_aabb_max[j], bbmax[j]);
+        }
+    }
+}
+
+void ChModelPrimitive::GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const {
+    bbmin = m_aabb_min;
+    bbmax = m_aabb_max;
+}
+
+void ChModelPrimitive::ComputeAABB(const ChPrimitiveShape& shape, ChVector<>& bbmin, ChVector<>& bbmax) {
+    ChVector<> ext;
+    switch (shape.type) {
+        case ChPrimitiveShape::SPHERE:
+            ext = ChVector<>(shape.dims.x());
+            break;
+        case ChPrimitiveShape::BOX:
+            for (int i = 0; i < 3; i++) {
+                ext[i] = std::abs(shape.rot(i, 0)) * shape.dims.x() + std::abs(shape.rot(i, 1)) * shape.dims.y() +
+                         std::abs(shape.rot(i, 2)) * shape.dims.z();
+            }
+            break;
+        case ChPrimitiveShape::CAPSULE:
+            for (int i = 0; i < 3; i++)
+                ext[i] = std::abs(shape.rot(i, 1)) * shape.dims.y() + shape.dims.x();
+            break;
+        case ChPrimitiveShape::CYLINDER:
+            for (int i = 0; i < 3; i++) {
+                double a = shape.rot(i, 1);
+                ext[i] = std::abs(a) * shape.dims.y() + shape.dims.x() * std::sqrt(std::max(0.0, 1 - a * a));
+            }
+            break;
+    }
+    bbmin = shape.pos - ext;
+    bbmax = shape.pos + ext;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,181 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHC_MODELPRIMITIVE_H
+#define CHC_MODELPRIMITIVE_H
+
+#include <vector>
+
+#include "chrono/collision/ChCCollisionModel.h"
+#include "chrono/core/ChMatrix33.h"
+
+namespace chrono {
+namespace collision {
+
+/// Primitive shape used by ChModelPrimitive and by the ChCollisionSystemPrimitive narrowphase.
+struct ChPrimitiveShape {
+    enum Type { SPHERE = 0, BOX = 1, CAPSULE = 2, CYLINDER = 3 };
+
+    Type type;
+    ChVector<> dims;   ///< sphere: (radius,0,0), box: half-lengths, capsule and cylinder: (radius, half-length, 0)
+    ChVector<> pos;    ///< position of the shape center
+    ChMatrix33<> rot;  ///< orientation of the shape (capsule and cylinder axes are along Y)
+};
+
+/// Collision model made only of primitive shapes (spheres, boxes, capsules and cylinders).
+/// To be used with ChCollisionSystemPrimitive, which implements analytic collision tests for these shapes.
+/// Other shape types are not supported: the corresponding Add...() functions return false.
+class ChApi ChModelPrimitive : public ChCollisionModel {
+  public:
+    ChModelPrimitive();
+    virtual ~ChModelPrimitive() {}
+
+    /// Delete all inserted geometries.
+    virtual int ClearModel() override;
+
+    /// Complete the construction of the collision model.
+    virtual int BuildModel() override;
+
+    /// Add a sphere shape to this model, for collision purposes.
+    virtual bool AddSphere(double radius, const ChVector<>& pos = ChVector<>()) override;
+
+    /// Ellipsoids are not supported.
+    virtual bool AddEllipsoid(double rx,
+                              double ry,
+                              double rz,
+                              const ChVector<>& pos = ChVector<>(),
+                              const ChMatrix33<>& rot = ChMatrix33<>(1)) override {
+        return false;
+    }
+
+    /// Add a box shape to this model, for collision purposes.
+    virtual bool AddBox(double hx,
+                        double hy,
+                        double hz,
+                        const ChVector<>& pos = ChVector<>(),
+                        const ChMatrix33<>& rot = ChMatrix33<>(1)) override;
+
+    /// Add a cylinder to this model (default axis on Y direction), for collision purposes.
+    /// Only circular cylinders are supported; the radius is taken as the largest of rx and rz.
+    virtual bool AddCylinder(double rx,
+                             double rz,
+                             double hy,
+                             const ChVector<>& pos = ChVector<>(),
+                             const ChMatrix33<>& rot = ChMatrix33<>(1)) override;
+
+    /// Cones are not supported.
+    virtual bool AddCone(double rx,
+                         double rz,
+                         double hy,
+                         const ChVector<>& pos = ChVector<>(),
+                         const ChMatrix33<>& rot = ChMatrix33<>(1)) override {
+        return false;
+    }
+
+    /// Add a capsule to this model (default axis in Y direction), for collision purposes.
+    virtual bool AddCapsule(double radius,
+                            double hlen,
+                            const ChVector<>& pos = ChVector<>(),
+                            const ChMatrix33<>& rot = ChMatrix33<>(1)) override;
+
+    /// Rounded boxes are not supported.
+    virtual bool AddRoundedBox(double hx,
+                               double hy,
+                               double hz,
+                               double sphere_r,
+                               const ChVector<>& pos = ChVector<>(),
+                               const ChMatrix33<>& rot = ChMatrix33<>(1)) override {
+        return false;
+    }
+
+    /// Rounded cylinders are not supported.
+    virtual bool AddRoundedCylinder(double rx,
+                                    double rz,
+                                    double hy,
+                                    double sphere_r,
+                                    const ChVector<>& pos = ChVector<>(),
+                                    const ChMatrix33<>& rot = ChMatrix33<>(1)) override {
+        return false;
+    }
+
+    /// Rounded cones are not supported.
+    virtual bool AddRoundedCone(double rx,
+                                double rz,
+                                double hy,
+                                double sphere_r,
+                                const ChVector<>& pos = ChVector<>(),
+                                const ChMatrix33<>& rot = ChMatrix33<>(1)) override {
+        return false;
+    }
+
+    /// Convex hulls are not supported.
+    virtual bool AddConvexHull(const std::vector<ChVector<double> >& pointlist,
+                               const ChVector<>& pos = ChVector<>(),
+                               const ChMatrix33<>& rot = ChMatrix33<>(1)) override {
+        return false;
+    }
+
+    /// Triangle meshes are not supported.
+    virtual bool AddTriangleMesh(std::shared_ptr<geometry::ChTriangleMesh> trimesh,
+                                 bool is_static,
+                                 bool is_convex,
+                                 const ChVector<>& pos = ChVector<>(),
+                                 const ChMatrix33<>& rot = ChMatrix33<>(1),
+                                 double sphereswept_thickness = 0.0) override {
+        return false;
+    }
+
+    /// Barrels are not supported.
+    virtual bool AddBarrel(double Y_low,
+                           double Y_high,
+                           double R_vert,
+                           double R_hor,
+                           double R_offset,
+                           const ChVector<>& pos = ChVector<>(),
+                           const ChMatrix33<>& rot = ChMatrix33<>(1)) override {
+        return false;
+    }
+
+    /// Add all shapes already contained in another model.
+    /// The other model must also be a ChModelPrimitive.
+    virtual bool AddCopyOfAnotherModel(ChCollisionModel* another) override;
+
+    /// Set the position and orientation of the collision model as the rigid body current position,
+    /// updating the absolute shapes and the AABB.
+    virtual void SyncPosition() override;
+
+    /// Return the axis aligned bounding box of the collision model (not including the envelope).
+    /// For a model without shapes, this is a degenerate box at the model reference point.
+    virtual void GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const override;
+
+    /// Return the shapes of this model, expressed in the model frame.
+    const std::vector<ChPrimitiveShape>& GetShapes() const { return m_shapes; }
+
+    /// Return the shapes of this model, expressed in the absolute frame (as of the last SyncPosition).
+    const std::vector<ChPrimitiveShape>& GetAbsoluteShapes() const { return m_abs_shapes; }
+
+    /// Compute the axis aligned bounding box of a shape.
+    static void ComputeAABB(const ChPrimitiveShape& shape, ChVector<>& bbmin, ChVector<>& bbmax);
+
+  private:
+    void AddShape(ChPrimitiveShape::Type type, const ChVector<>& dims, const ChVector<>& pos, const ChMatrix33<>& rot);
+
+    std::vector<ChPrimitiveShape> m_shapes;      ///< shapes in model frame
+    std::vector<ChPrimitiveShape> m_abs_shapes;  ///< shapes in absolute frame
+    ChVector<> m_aabb_min;
+    ChVector<> m_aabb_max;
+};
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,1011 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/collision/ChCCollisionInfo.h"
+#include "chrono/collision/ChCNarrowphasePrimitive.h"
+
+namespace chrono {
+namespace collision {
+
+typedef ChNarrowphasePrimitive::Contact Contact;
+
+namespace {
+
+const double kEps = 1e-10;
+
+const double kMPRTolerance = 1e-9;
+const int kMPRMaxIterations = 100;
+const int kMPRMaxPortalIterations = 1000;
+
+// -----------------------------------------------------------------------------
+// Utilities
+// -----------------------------------------------------------------------------
+
+inline double Sign(double x) {
+    return x < 0 ? -1.0 : 1.0;
+}
+
+inline double Clamp(double x, double lo, double hi) {
+    return std::max(lo, std::min(x, hi));
+}
+
+inline double DefaultRadius() {
+    return ChCollisionInfo::GetDefaultEffectiveCurvatureRadius();
+}
+
+// Axis k of the shape frame, expressed in absolute frame.
+inline ChVector<> Axis(const ChPrimitiveShape& s, int k) {
+    return ChVector<>(s.rot(0, k), s.rot(1, k), s.rot(2, k));
+}
+
+// Express an absolute direction in the shape frame.
+inline ChVector<> DirToLocal(const ChPrimitiveShape& s, const ChVector<>& v) {
+    return ChVector<>(Axis(s, 0).Dot(v), Axis(s, 1).Dot(v), Axis(s, 2).Dot(v));
+}
+
+// Express an absolute point in the shape frame.
+inline ChVector<> ToLocal(const ChPrimitiveShape& s, const ChVector<>& p) {
+    return DirToLocal(s, p - s.pos);
+}
+
+// Express a direction in the shape frame in absolute frame.
+inline ChVector<> DirToAbs(const ChPrimitiveShape& s, const ChVector<>& v) {
+    return Axis(s, 0) * v.x() + Axis(s, 1) * v.y() + Axis(s, 2) * v.z();
+}
+
+// Express a point in the shape frame in absolute frame.
+inline ChVector<> ToAbs(const ChPrimitiveShape& s, const ChVector<>& p) {
+    return s.pos + DirToAbs(s, p);
+}
+
+// Unit vector perpendicular to the given unit vector.
+ChVector<> AnyPerpendicular(const ChVector<>& n) {
+    ChVector<> t = std::abs(n.x()) < 0.57 ? ChVector<>(1, 0, 0) : ChVector<>(0, 1, 0);
+    return n.Cross(t).GetNormalized();
+}
+
+// Swap the roles of the two shapes in a contact.
+inline void Flip(Contact& c) {
+    std::swap(c.pA, c.pB);
+    c.normal = -c.normal;
+}
+
+// Closest point to p on segment [a,b]; t is the segment parameter (0...1).
+ChVector<> ClosestOnSegment(const ChVector<>& a, const ChVector<>& b, const ChVector<>& p, double& t) {
+    ChVector<> ab = b - a;
+    double len2 = ab.Length2();
+    t = len2 > kEps ? Clamp((p - a).Dot(ab) / len2, 0, 1) : 0;
+    return a + ab * t;
+}
+
+// Closest points c1 and c2 between segments [p1,q1] and [p2,q2].
+void ClosestSegmentSegment(const ChVector<>& p1,
+                           const ChVector<>& q1,
+                           const ChVector<>& p2,
+                           const ChVector<>& q2,
+                           ChVector<>& c1,
+                           ChVector<>& c2) {
+    ChVector<> d1 = q1 - p1;
+    ChVector<> d2 = q2 - p2;
+    ChVector<> r = p1 - p2;
+    double a = d1.Length2();
+    double e = d2.Length2();
+    double f = d2.Dot(r);
+    double s = 0;
+    double t = 0;
+
+    if (a <= kEps && e <= kEps) {
+        s = t = 0;
+    } else if (a <= kEps) {
+        s = 0;
+        t = Clamp(f / e, 0, 1);
+    } else {
+        double c = d1.Dot(r);
+        if (e <= kEps) {
+            t = 0;
+            s = Clamp(-c / a, 0, 1);
+        } else {
+            double b = d1.Dot(d2);
+            double denom = a * e - b * b;
+            s = denom > kEps ? Clamp((b * f - c * e) / denom, 0, 1) : 0;
+            t = (b * s + f) / e;
+            if (t < 0) {
+                t = 0;
+                s = Clamp(-c / a, 0, 1);
+            } else if (t > 1) {
+                t = 1;
+                s = Clamp((b - c) / a, 0, 1);
+            }
+        }
+    }
+
+    c1 = p1 + d1 * s;
+    c2 = p2 + d2 * t;
+}
+
+// -----------------------------------------------------------------------------
+// Point queries against solid boxes and cylinders
+// -----------------------------------------------------------------------------
+
+// Signed distance from p to the surface of a box (negative inside).
+// Also return the closest surface point and the outward normal there.
+double PointBox(const ChPrimitiveShape& box, const ChVector<>& p, ChVector<>& surf, ChVector<>& normal) {
+    const ChVector<>& h = box.dims;
+    ChVector<> l = ToLocal(box, p);
+    ChVector<> q(Clamp(l.x(), -h.x(), h.x()), Clamp(l.y(), -h.y(), h.y()), Clamp(l.z(), -h.z(), h.z()));
+    ChVector<> d = l - q;
+    double dist = d.Length();
+
+    if (dist > kEps) {
+        surf = ToAbs(box, q);
+        normal = DirToAbs(box, d / dist);
+        return dist;
+    }
+
+    // Point inside the box: use the closest face.
+    int k = 0;
+    double depth = h.x() - std::abs(l.x());
+    for (int i = 1; i < 3; i++) {
+        double di = h[i] - std::abs(l[i]);
+        if (di < depth) {
+            depth = di;
+            k = i;
+        }
+    }
+    ChVector<> n(0);
+    n[k] = Sign(l[k]);
+    q = l;
+    q[k] = Sign(l[k]) * h[k];
+    surf = ToAbs(box, q);
+    normal = DirToAbs(box, n);
+    return -depth;
+}
+
+// Signed distance from p to the surface of a cylinder (negative inside).
+// Also return the closest surface point and the outward normal there.
+double PointCylinder(const ChPrimitiveShape& cyl, const ChVector<>& p, ChVector<>& surf, ChVector<>& normal) {
+    double r = cyl.dims.x();
+    double h = cyl.dims.y();
+    ChVector<> l = ToLocal(cyl, p);
+    ChVector<> rad(l.x(), 0, l.z());
+    double rr = rad.Length();
+    ChVector<> u = rr > kEps ? rad / rr : ChVector<>(1, 0, 0);
+
+    if (rr <= r && std::abs(l.y()) <= h) {
+        // Point inside the cylinder: use the closest of side and caps.
+        double depth_side = r - rr;
+        double depth_cap = h - std::abs(l.y());
+        if (depth_cap < depth_side) {
+            surf = ToAbs(cyl, ChVector<>(l.x(), Sign(l.y()) * h, l.z()));
+            normal = Axis(cyl, 1) * Sign(l.y());
+            return -depth_cap;
+        }
+        surf = ToAbs(cyl, u * r + ChVector<>(0, l.y(), 0));
+        normal = DirToAbs(cyl, u);
+        return -depth_side;
+    }
+
+    ChVector<> q = (rr > r ? u * r : rad) + ChVector<>(0, Clamp(l.y(), -h, h), 0);
+    ChVector<> d = l - q;
+    double dist = d.Length();
+    surf = ToAbs(cyl, q);
+    normal = DirToAbs(cyl, d / dist);
+    return dist;
+}
+
+// Signed distance from p to the surface of a box or cylinder.
+double PointConvex(const ChPrimitiveShape& s, const ChVector<>& p, ChVector<>& surf, ChVector<>& normal) {
+    if (s.type == ChPrimitiveShape::BOX)
+        return PointBox(s, p, surf, normal);
+    return PointCylinder(s, p, surf, normal);
+}
+
+// Closest point to p in a solid box or cylinder (p itself if inside).
+ChVector<> ProjectOnConvex(const ChPrimitiveShape& s, const ChVector<>& p) {
+    ChVector<> l = ToLocal(s, p);
+    ChVector<> q;
+    if (s.type == ChPrimitiveShape::BOX) {
+        const ChVector<>& h = s.dims;
+        q = ChVector<>(Clamp(l.x(), -h.x(), h.x()), Clamp(l.y(), -h.y(), h.y()), Clamp(l.z(), -h.z(), h.z()));
+    } else {
+        double r = s.dims.x();
+        ChVector<> rad(l.x(), 0, l.z());
+        double rr = rad.Length();
+        if (rr > r)
+            rad *= r / rr;
+        q = rad + ChVector<>(0, Clamp(l.y(), -s.dims.y(), s.dims.y()), 0);
+    }
+    return ToAbs(s, q);
+}
+
+// -----------------------------------------------------------------------------
+// Analytic tests
+// -----------------------------------------------------------------------------
+
+int SphereSphere(const ChVector<>& ca, double ra, const ChVector<>& cb, double rb, double separation, Contact* ct) {
+    ChVector<> d = cb - ca;
+    double dist = d.Length();
+    if (dist - ra - rb > separation)
+        return 0;
+
+    ChVector<> n = dist > kEps ? d / dist : ChVector<>(1, 0, 0);
+    ct->normal = n;
+    ct->pA = ca + n * ra;
+    ct->pB = cb - n * rb;
+    ct->distance = dist - ra - rb;
+    ct->eff_radius = ra * rb / (ra + rb);
+    return 1;
+}
+
+// Sphere (first shape) against a box or cylinder.
+int SphereConvex(const ChVector<>& c, double r, const ChPrimitiveShape& s, double separation, Contact* ct) {
+    ChVector<> surf;
+    ChVector<> nout;
+    double sd = PointConvex(s, c, surf, nout);
+    if (sd - r > separation)
+        return 0;
+
+    ct->normal = -nout;
+    ct->pA = c - nout * r;
+    ct->pB = surf;
+    ct->distance = sd - r;
+    ct->eff_radius = r;
+    return 1;
+}
+
+// Capsule (first shape) against a box or cylinder.
+// The capsule end spheres are tested individually, which gives two contacts for a capsule lying
+// on a face; an additional contact is added at the segment point closest to the other shape
+// when deeper than the end contacts (e.g. capsule crossing an edge).
+int CapsuleConvex(const ChPrimitiveShape& cap, const ChPrimitiveShape& s, double separation, Contact* ct) {
+    double r = cap.dims.x();
+    ChVector<> a = Axis(cap, 1) * cap.dims.y();
+    ChVector<> e0 = cap.pos + a;
+    ChVector<> e1 = cap.pos - a;
+
+    int n = 0;
+    n += SphereConvex(e0, r, s, separation, ct + n);
+    n += SphereConvex(e1, r, s, separation, ct + n);
+
+    // Closest segment point to the shape, through alternating projections.
+    double t;
+    ChVector<> p = ClosestOnSegment(e0, e1, s.pos, t);
+    for (int it = 0; it < 8; it++)
+        p = ClosestOnSegment(e0, e1, ProjectOnConvex(s, p), t);
+
+    if (t > 0.01 && t < 0.99) {
+        Contact mid;
+        if (SphereConvex(p, r, s, separation, &mid)) {
+            double dmin = 1e30;
+            for (int i = 0; i < n; i++)
+                dmin = std::min(dmin, ct[i].distance);
+            if (mid.distance < dmin - 1e-3 * r)
+                ct[n++] = mid;
+        }
+    }
+
+    return n;
+}
+
+int CapsuleCapsule(const ChPrimitiveShape& A, const ChPrimitiveShape& B, double separation, Contact* ct) {
+    double rA = A.dims.x();
+    double rB = B.dims.x();
+    double hA = A.dims.y();
+    ChVector<> uA = Axis(A, 1);
+    ChVector<> uB = Axis(B, 1);
+    ChVector<> a0 = A.pos + uA * hA;
+    ChVector<> a1 = A.pos - uA * hA;
+    ChVector<> b0 = B.pos + uB * B.dims.y();
+    ChVector<> b1 = B.pos - uB * B.dims.y();
+
+    if (std::abs(uA.Dot(uB)) > 1 - 1e-6) {
+        // Parallel capsules: contacts at the two ends of the overlap interval.
+        double t0 = (b0 - A.pos).Dot(uA);
+        double t1 = (b1 - A.pos).Dot(uA);
+        double lo = std::max(-hA, std::min(t0, t1));
+        double hi = std::min(hA, std::max(t0, t1));
+        if (hi > lo + kEps) {
+            double t;
+            int n = 0;
+            ChVector<> p = A.pos + uA * lo;
+            n += SphereSphere(p, rA, ClosestOnSegment(b0, b1, p, t), rB, separation, ct + n);
+            p = A.pos + uA * hi;
+            n += SphereSphere(p, rA, ClosestOnSegment(b0, b1, p, t), rB, separation, ct + n);
+            return n;
+        }
+    }
+
+    ChVector<> cA;
+    ChVector<> cB;
+    ClosestSegmentSegment(a0, a1, b0, b1, cA, cB);
+    return SphereSphere(cA, rA, cB, rB, separation, ct);
+}
+
+// Clip a convex polygon against the half-space dot(p, n) <= offset (Sutherland-Hodgman).
+int ClipPolygon(const ChVector<>* in, int num_in, const ChVector<>& n, double offset, ChVector<>* out) {
+    int num_out = 0;
+    for (int i = 0; i < num_in; i++) {
+        const ChVector<>& p = in[i];
+        const ChVector<>& q = in[(i + 1) % num_in];
+        double dp = p.Dot(n) - offset;
+        double dq = q.Dot(n) - offset;
+        if (dp <= 0)
+            out[num_out++] = p;
+        if ((dp < 0 && dq > 0) || (dp > 0 && dq < 0))
+            out[num_out++] = p + (q - p) * (dp / (dp - dq));
+    }
+    return num_out;
+}
+
+// Box-box test using the separating axis theorem.
+// If the axis of minimum penetration is a face normal, the incident face is clipped against the
+// reference face (up to 8 contacts); otherwise a single edge-edge contact is generated.
+int BoxBox(const ChPrimitiveShape& A, const ChPrimitiveShape& B, double separation, Contact* ct) {
+    ChVector<> uA[3] = {Axis(A, 0), Axis(A, 1), Axis(A, 2)};
+    ChVector<> uB[3] = {Axis(B, 0), Axis(B, 1), Axis(B, 2)};
+    const ChVector<>& hA = A.dims;
+    const ChVector<>& hB = B.dims;
+    ChVector<> d = B.pos - A.pos;
+
+    double best = 1e30;
+    int best_axis = -1;
+    ChVector<> best_n;
+
+    // Test the given axis; return false if it separates the boxes by more than 'separation'.
+    auto test_axis = [&](ChVector<> L, int id) -> bool {
+        double len = L.Length();
+        if (len < 1e-6)
+            return true;  // degenerate edge-edge axis (parallel edges)
+        L /= len;
+        double rA = hA.x() * std::abs(uA[0].Dot(L)) + hA.y() * std::abs(uA[1].Dot(L)) + hA.z() * std::abs(uA[2].Dot(L));
+        double rB = hB.x() * std::abs(uB[0].Dot(L)) + hB.y() * std::abs(uB[1].Dot(L)) + hB.z() * std::abs(uB[2].Dot(L));
+        double s = d.Dot(L);
+        double overlap = rA + rB - std::abs(s);
+        if (-overlap > separation)
+            return false;
+        // Favor face axes over edge axes, for more stable contact manifolds.
+        double bias = id < 6 ? 0 : 0.05 * std::abs(best) + 1e-9;
+        if (overlap < best - bias) {
+            best = overlap;
+            best_axis = id;
+            best_n = L * Sign(s);
+        }
+        return true;
+    };
+
+    for (int i = 0; i < 3; i++) {
+        if (!test_axis(uA[i], i))
+            return 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        if (!test_axis(uB[i], 3 + i))
+            return 0;
+    }
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            if (!test_axis(uA[i].Cross(uB[j]), 6 + 3 * i + j))
+                return 0;
+        }
+    }
+
+    if (best_axis < 0)
+        return 0;
+
+    if (best_axis >= 6) {
+        // Edge-edge contact.
+        int i = (best_axis - 6) / 3;
+        int j = (best_axis - 6) % 3;
+        ChVector<> pa = A.pos;
+        ChVector<> pb = B.pos;
+        for (int k = 0; k < 3; k++) {
+            if (k != i)
+                pa += uA[k] * (Sign(uA[k].Dot(best_n)) * hA[k]);
+            if (k != j)
+                pb -= uB[k] * (Sign(uB[k].Dot(best_n)) * hB[k]);
+        }
+        ChVector<> cA;
+        ChVector<> cB;
+        ClosestSegmentSegment(pa - uA[i] * hA[i], pa + uA[i] * hA[i], pb - uB[j] * hB[j], pb + uB[j] * hB[j], cA, cB);
+        double dist = (cB - cA).Dot(best_n);
+        if (dist > separation)
+            return 0;
+        ct->pA = cA;
+        ct->pB = cB;
+        ct->normal = best_n;
+        ct->distance = dist;
+        ct->eff_radius = DefaultRadius();
+        return 1;
+    }
+
+    // Face contact: reference face on box 'ref', normal pointing towards the incident box.
+    bool refA = best_axis < 3;
+    const ChPrimitiveShape& ref = refA ? A : B;
+    const ChPrimitiveShape& inc = refA ? B : A;
+    const ChVector<>* ur = refA ? uA : uB;
+    const ChVector<>* ui = refA ? uB : uA;
+    ChVector<> nref = refA ? best_n : -best_n;
+    int k = best_axis % 3;
+    int ku = (k + 1) % 3;
+    int kv = (k + 2) % 3;
+    ChVector<> cref = ref.pos + nref * ref.dims[k];
+
+    // Incident face: the face of the incident box most anti-parallel to the reference normal.
+    int j = 0;
+    double dmax = std::abs(ui[0].Dot(nref));
+    for (int i = 1; i < 3; i++) {
+        double di = std::abs(ui[i].Dot(nref));
+        if (di > dmax) {
+            dmax = di;
+            j = i;
+        }
+    }
+    ChVector<> cinc = inc.pos - ui[j] * (Sign(ui[j].Dot(nref)) * inc.dims[j]);
+    ChVector<> ea = ui[(j + 1) % 3] * inc.dims[(j + 1) % 3];
+    ChVector<> eb = ui[(j + 2) % 3] * inc.dims[(j + 2) % 3];
+
+    ChVector<> poly[12] = {cinc + ea + eb, cinc - ea + eb, cinc - ea - eb, cinc + ea - eb};
+    ChVector<> tmp[12];
+    int np = 4;
+    np = ClipPolygon(poly, np, ur[ku], ur[ku].Dot(cref) + ref.dims[ku], tmp);
+    np = ClipPolygon(tmp, np, -ur[ku], -ur[ku].Dot(cref) + ref.dims[ku], poly);
+    np = ClipPolygon(poly, np, ur[kv], ur[kv].Dot(cref) + ref.dims[kv], tmp);
+    np = ClipPolygon(tmp, np, -ur[kv], -ur[kv].Dot(cref) + ref.dims[kv], poly);
+
+    int n = 0;
+    for (int i = 0; i < np && n < ChNarrowphasePrimitive::MAX_CONTACTS; i++) {
+        double dist = (poly[i] - cref).Dot(nref);
+        if (dist > separation)
+            continue;
+        ChVector<> q = poly[i] - nref * dist;
+        Contact& c = ct[n++];
+        c.pA = refA ? q : poly[i];
+        c.pB = refA ? poly[i] : q;
+        c.normal = best_n;
+        c.distance = dist;
+        c.eff_radius = DefaultRadius();
+    }
+
+    return n;
+}
+
+// -----------------------------------------------------------------------------
+// Minkowski Portal Refinement (adapted from the XenoCollide algorithm, as in Chrono::Parallel)
+// -----------------------------------------------------------------------------
+
+struct MPRSupport {
+    ChVector<> v1;  // support point on first shape
+    ChVector<> v2;  // support point on second shape
+    ChVector<> v;   // support point on Minkowski difference (v2 - v1)
+};
+
+struct MPRSimplex {
+    MPRSupport s0;
+    MPRSupport s1;
+    MPRSupport s2;
+    MPRSupport s3;
+    MPRSupport s4;
+};
+
+inline bool IsZero(const ChVector<>& v) {
+    return v.Length2() < kEps * kEps;
+}
+
+inline ChVector<> Normalize(const ChVector<>& v) {
+    double len = v.Length();
+    return len > kEps ? v / len : ChVector<>(1, 0, 0);
+}
+
+// Support point of a shape (inflated by 'envelope') in the given direction.
+ChVector<> SupportPoint(const ChPrimitiveShape& s, const ChVector<>& dir, double envelope) {
+    ChVector<> n = Normalize(dir);
+    ChVector<> l = DirToLocal(s, n);
+    ChVector<> p;
+    switch (s.type) {
+        case ChPrimitiveShape::SPHERE:
+            p = l * s.dims.x();
+            break;
+        case ChPrimitiveShape::BOX:
+            p = ChVector<>(Sign(l.x()) * s.dims.x(), Sign(l.y()) * s.dims.y(), Sign(l.z()) * s.dims.z());
+            break;
+        case ChPrimitiveShape::CAPSULE:
+            p = ChVector<>(0, Sign(l.y()) * s.dims.y(), 0) + l * s.dims.x();
+            break;
+        case ChPrimitiveShape::CYLINDER: {
+            ChVector<> rad(l.x(), 0, l.z());
+            double rr = rad.Length();
+            p = ChVector<>(0, Sign(l.y()) * s.dims.y(), 0);
+            if (rr > kEps)
+                p += rad * (s.dims.x() / rr);
+            break;
+        }
+    }
+    return ToAbs(s, p) + n * envelope;
+}
+
+void MPRSupportAB(const ChPrimitiveShape& A,
+                  const ChPrimitiveShape& B,
+                  const ChVector<>& n,
+                  double envelope,
+                  MPRSupport& s) {
+    s.v1 = SupportPoint(A, -n, envelope);
+    s.v2 = SupportPoint(B, n, envelope);
+    s.v = s.v2 - s.v1;
+}
+
+void MPRExpandPortal(MPRSimplex& portal) {
+    if (portal.s4.v.Cross(portal.s1.v).Dot(portal.s0.v) < 0) {
+        if (portal.s4.v.Cross(portal.s2.v).Dot(portal.s0.v) < 0)
+            portal.s1 = portal.s4;
+        else
+            portal.s3 = portal.s4;
+    } else {
+        if (portal.s4.v.Cross(portal.s3.v).Dot(portal.s0.v) < 0)
+            portal.s2 = portal.s4;
+        else
+            portal.s1 = portal.s4;
+    }
+}
+
+ChVector<> MPRPortalDir(const MPRSimplex& portal) {
+    return Normalize((portal.s2.v - portal.s1.v).Cross(portal.s3.v - portal.s1.v));
+}
+
+bool MPRPortalReachTolerance(const MPRSimplex& portal, const ChVector<>& n) {
+    double dv4 = portal.s4.v.Dot(n);
+    double dot1 = std::min(dv4 - portal.s1.v.Dot(n), std::min(dv4 - portal.s2.v.Dot(n), dv4 - portal.s3.v.Dot(n)));
+    return dot1 <= kMPRTolerance;
+}
+
+// Return 0 if a portal was found, 1 or 2 for degenerate touching/segment configurations, -1 if no contact.
+int MPRDiscoverPortal(const ChPrimitiveShape& A, const ChPrimitiveShape& B, double envelope, MPRSimplex& portal) {
+    portal.s0.v1 = A.pos;
+    portal.s0.v2 = B.pos;
+    portal.s0.v = B.pos - A.pos;
+    if (IsZero(portal.s0.v))
+        portal.s0.v = ChVector<>(1e-6, 0, 0);
+
+    ChVector<> n = Normalize(-portal.s0.v);
+    MPRSupportAB(A, B, n, envelope, portal.s1);
+    if (portal.s1.v.Dot(n) < 0)
+        return -1;
+
+    n = portal.s0.v.Cross(portal.s1.v);
+    if (IsZero(n))
+        return IsZero(portal.s1.v) ? 1 : 2;
+    n = Normalize(n);
+
+    MPRSupportAB(A, B, n, envelope, portal.s2);
+    if (portal.s2.v.Dot(n) <= 0)
+        return -1;
+
+    n = Normalize((portal.s1.v - portal.s0.v).Cross(portal.s2.v - portal.s0.v));
+    if (n.Dot(portal.s0.v) > 0) {
+        std::swap(portal.s1, portal.s2);
+        n = -n;
+    }
+
+    for (int i = 0; i < kMPRMaxPortalIterations; i++) {
+        MPRSupportAB(A, B, n, envelope, portal.s3);
+        if (portal.s3.v.Dot(n) <= 0)
+            return -1;
+        if (portal.s1.v.Cross(portal.s3.v).Dot(portal.s0.v) < 0) {
+            portal.s2 = portal.s3;
+            n = Normalize((portal.s1.v - portal.s0.v).Cross(portal.s3.v - portal.s0.v));
+            continue;
+        }
+        if (portal.s3.v.Cross(portal.s2.v).Dot(portal.s0.v) < 0) {
+            portal.s1 = portal.s3;
+            n = Normalize((portal.s3.v - portal.s0.v).Cross(portal.s2.v - portal.s0.v));
+            continue;
+        }
+        break;
+    }
+    return 0;
+}
+
+bool MPRRefinePortal(const ChPrimitiveShape& A, const ChPrimitiveShape& B, double envelope, MPRSimplex& portal) {
+    for (int i = 0; i < kMPRMaxIterations; i++) {
+        ChVector<> n = MPRPortalDir(portal);
+        if (n.Dot(portal.s1.v) >= 0)
+            return true;
+        MPRSupportAB(A, B, n, envelope, portal.s4);
+        if (MPRPortalReachTolerance(portal, n) || portal.s4.v.Dot(n) < 0)
+            return n.Dot(portal.s1.v) >= 0;
+        MPRExpandPortal(portal);
+    }
+    return false;
+}
+
+// Collide two convex shapes with MPR. The normal is from A to B.
+bool MPRCollide(const ChPrimitiveShape& A,
+                const ChPrimitiveShape& B,
+                double separation,
+                ChVector<>& normal,
+                ChVector<>& pA,
+                ChVector<>& pB,
+                double& distance) {
+    double envelope = separation / 2;
+    MPRSimplex portal;
+    ChVector<> p0;
+
+    int result = MPRDiscoverPortal(A, B, envelope, portal);
+    if (result == 0) {
+        if (!MPRRefinePortal(A, B, envelope, portal))
+            return false;
+        ChVector<> dir;
+        for (int i = 0; i < kMPRMaxIterations; i++) {
+            dir = MPRPortalDir(portal);
+            MPRSupportAB(A, B, dir, envelope, portal.s4);
+            if (MPRPortalReachTolerance(portal, dir) || i == kMPRMaxIterations - 1)
+                break;
+            MPRExpandPortal(portal);
+        }
+        // Reference point: barycentric projection of the origin on the portal.
+        double b1 = portal.s2.v.Cross(portal.s3.v).Dot(dir);
+        double b2 = portal.s3.v.Cross(portal.s1.v).Dot(dir);
+        double b3 = portal.s1.v.Cross(portal.s2.v).Dot(dir);
+        double sum = b1 + b2 + b3;
+        if (std::abs(sum) < kEps) {
+            b1 = b2 = b3 = 1;
+            sum = 3;
+        }
+        p0 = ((portal.s1.v1 + portal.s1.v2) * b1 + (portal.s2.v1 + portal.s2.v2) * b2 +
+              (portal.s3.v1 + portal.s3.v2) * b3) *
+             (0.5 / sum);
+        normal = dir;
+    } else if (result == 1) {
+        p0 = (portal.s1.v1 + portal.s1.v2) * 0.5;
+        normal = Normalize(portal.s1.v - portal.s0.v);
+    } else if (result == 2) {
+        p0 = (portal.s1.v1 + portal.s1.v2) * 0.5;
+        normal = Normalize(portal.s1.v);
+    } else {
+        return false;
+    }
+
+    // Contact points: supports projected on the line through p0, then deflated.
+    pA = p0 + normal * (SupportPoint(A, -normal, envelope) - p0).Dot(normal);
+    pB = p0 + normal * (SupportPoint(B, normal, envelope) - p0).Dot(normal);
+    normal = -normal;
+    pA -= normal * envelope;
+    pB += normal * envelope;
+    distance = normal.Dot(pB - pA);
+    return true;
+}
+
+int MPRSingle(const ChPrimitiveShape& A, const ChPrimitiveShape& B, double separation, Contact* ct) {
+    if (!MPRCollide(A, B, separation, ct->normal, ct->pA, ct->pB, ct->distance))
+        return 0;
+    if (ct->distance > separation)
+        return 0;
+    ct->eff_radius = DefaultRadius();
+    return 1;
+}
+
+// Restrict [lo,hi] to the parameters t such that |dot(o + a*t, axis)| <= half.
+void ClipInterval(const ChVector<>& o, const ChVector<>& a, const ChVector<>& axis, double half, double& lo, double& hi) {
+    double oa = o.Dot(axis);
+    double s = a.Dot(axis);
+    if (std::abs(s) < kEps) {
+        if (std::abs(oa) > half) {
+            lo = 1;
+            hi = -1;
+        }
+        return;
+    }
+    double t1 = (-half - oa) / s;
+    double t2 = (half - oa) / s;
+    lo = std::max(lo, std::min(t1, t2));
+    hi = std::min(hi, std::max(t1, t2));
+}
+
+// Box-cylinder test. MPR provides the contact normal; if it is aligned with a box face and the
+// cylinder rests on that face with its cap or its side, a contact manifold is built on the face.
+int BoxCylinder(const ChPrimitiveShape& box, const ChPrimitiveShape& cyl, double separation, Contact* ct) {
+    ChVector<> normal;
+    ChVector<> pA;
+    ChVector<> pB;
+    double dist;
+    if (!MPRCollide(box, cyl, separation, normal, pA, pB, dist) || dist > separation)
+        return 0;
+
+    int k = -1;
+    for (int i = 0; i < 3; i++) {
+        if (std::abs(Axis(box, i).Dot(normal)) > 0.99)
+            k = i;
+    }
+
+    if (k >= 0) {
+        ChVector<> nf = Axis(box, k) * Sign(Axis(box, k).Dot(normal));
+        ChVector<> cf = box.pos + nf * box.dims[k];
+        ChVector<> uu = Axis(box, (k + 1) % 3);
+        ChVector<> vv = Axis(box, (k + 2) % 3);
+        double hu = box.dims[(k + 1) % 3];
+        double hv = box.dims[(k + 2) % 3];
+        double tol = 1e-6 * (hu + hv);
+        ChVector<> a = Axis(cyl, 1);
+        double r = cyl.dims.x();
+        double h = cyl.dims.y();
+        double an = a.Dot(nf);
+        int n = 0;
+
+        // Add a contact for point p on the cylinder, if it projects inside the box face.
+        auto add_on_face = [&](const ChVector<>& p) {
+            ChVector<> q = p - cf;
+            if (std::abs(q.Dot(uu)) > hu + tol || std::abs(q.Dot(vv)) > hv + tol)
+                return;
+            double d = q.Dot(nf);
+            if (d > separation || n >= ChNarrowphasePrimitive::MAX_CONTACTS)
+                return;
+            Contact& c = ct[n++];
+            c.pA = p - nf * d;
+            c.pB = p;
+            c.normal = nf;
+            c.distance = d;
+            c.eff_radius = DefaultRadius();
+        };
+
+        if (std::abs(an) > 0.99) {
+            // Cap on the face: rim samples, plus face corners covered by the cap.
+            ChVector<> cc = cyl.pos - a * (Sign(an) * h);
+            ChVector<> e1 = uu - a * uu.Dot(a);
+            e1 = e1.Length2() > kEps ? e1.GetNormalized() : AnyPerpendicular(a);
+            ChVector<> e2 = a.Cross(e1);
+            add_on_face(cc + e1 * r);
+            add_on_face(cc + e2 * r);
+            add_on_face(cc - e1 * r);
+            add_on_face(cc - e2 * r);
+            for (int i = 0; i < 4 && n < ChNarrowphasePrimitive::MAX_CONTACTS; i++) {
+                ChVector<> v = cf + uu * ((i & 1 ? 1 : -1) * hu) + vv * ((i & 2 ? 1 : -1) * hv);
+                ChVector<> w = v - cc;
+                if ((w - a * w.Dot(a)).Length() > r)
+                    continue;
+                double d = (cc - v).Dot(nf);
+                if (d > separation)
+                    continue;
+                Contact& c = ct[n++];
+                c.pA = v;
+                c.pB = v + nf * d;
+                c.normal = nf;
+                c.distance = d;
+                c.eff_radius = DefaultRadius();
+            }
+        } else if (std::abs(an) < 0.01) {
+            // Side on the face: generator line closest to the box, clipped to the face.
+            ChVector<> g = cyl.pos - (nf - a * an).GetNormalized() * r;
+            double lo = -h;
+            double hi = h;
+            ClipInterval(g - cf, a, uu, hu, lo, hi);
+            ClipInterval(g - cf, a, vv, hv, lo, hi);
+            if (lo <= hi) {
+                add_on_face(g + a * lo);
+                if (hi - lo > 1e-6 * h)
+                    add_on_face(g + a * hi);
+            }
+        }
+
+        if (n > 0)
+            return n;
+    }
+
+    ct->pA = pA;
+    ct->pB = pB;
+    ct->normal = normal;
+    ct->distance = dist;
+    ct->eff_radius = DefaultRadius();
+    return 1;
+}
+
+// -----------------------------------------------------------------------------
+// Ray tests (in shape frame, segment o + t*d with t in [0,1])
+// -----------------------------------------------------------------------------
+
+bool RaySphere(const ChVector<>& o, const ChVector<>& d, const ChVector<>& c, double r, double& t, ChVector<>& n) {
+    ChVector<> m = o - c;
+    double a = d.Length2();
+    double b = m.Dot(d);
+    double cc = m.Length2() - r * r;
+    if (a < kEps)
+        return false;
+    double disc = b * b - a * cc;
+    if (disc < 0)
+        return false;
+    double t0 = (-b - std::sqrt(disc)) / a;
+    if (t0 < 0 || t0 > 1)
+        return false;
+    t = t0;
+    n = (m + d * t0) / r;
+    return true;
+}
+
+// Lateral surface of a cylinder of radius r along Y, restricted to |y| <= h.
+bool RayCylinderSide(const ChVector<>& o, const ChVector<>& d, double r, double h, double& t, ChVector<>& n) {
+    double a = d.x() * d.x() + d.z() * d.z();
+    double b = o.x() * d.x() + o.z() * d.z();
+    double c = o.x() * o.x() + o.z() * o.z() - r * r;
+    if (a < kEps)
+        return false;
+    double disc = b * b - a * c;
+    if (disc < 0)
+        return false;
+    double t0 = (-b - std::sqrt(disc)) / a;
+    if (t0 < 0 || t0 > 1)
+        return false;
+    ChVector<> p = o + d * t0;
+    if (std::abs(p.y()) > h)
+        return false;
+    t = t0;
+    n = ChVector<>(p.x(), 0, p.z()) / r;
+    return true;
+}
+
+// Keep the hit (t1, n1) if closer than the current one.
+inline void KeepNearest(bool hit1, double t1, const ChVector<>& n1, bool& hit, double& t, ChVector<>& n) {
+    if (hit1 && (!hit || t1 < t)) {
+        hit = true;
+        t = t1;
+        n = n1;
+    }
+}
+
+}  // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+
+int ChNarrowphasePrimitive::Collide(const ChPrimitiveShape& shapeA,
+                                    const ChPrimitiveShape& shapeB,
+                                    double separation,
+                                    Contact* contacts) {
+    // Dispatch on ordered shape types.
+    if (shapeA.type > shapeB.type) {
+        int n = Collide(shapeB, shapeA, separation, contacts);
+        for (int i = 0; i < n; i++)
+            Flip(contacts[i]);
+        return n;
+    }
+
+    switch (shapeA.type) {
+        case ChPrimitiveShape::SPHERE:
+            switch (shapeB.type) {
+                case ChPrimitiveShape::SPHERE:
+                    return SphereSphere(shapeA.pos, shapeA.dims.x(), shapeB.pos, shapeB.dims.x(), separation,
+                                        contacts);
+                case ChPrimitiveShape::CAPSULE: {
+                    double t;
+                    ChVector<> a = Axis(shapeB, 1) * shapeB.dims.y();
+                    ChVector<> p = ClosestOnSegment(shapeB.pos + a, shapeB.pos - a, shapeA.pos, t);
+                    return SphereSphere(shapeA.pos, shapeA.dims.x(), p, shapeB.dims.x(), separation, contacts);
+                }
+                default:
+                    return SphereConvex(shapeA.pos, shapeA.dims.x(), shapeB, separation, contacts);
+            }
+        case ChPrimitiveShape::BOX:
+            switch (shapeB.type) {
+                case ChPrimitiveShape::BOX:
+                    return BoxBox(shapeA, shapeB, separation, contacts);
+                case ChPrimitiveShape::CAPSULE: {
+                    int n = CapsuleConvex(shapeB, shapeA, separation, contacts);
+                    for (int i = 0; i < n; i++)
+                        Flip(contacts[i]);
+                    return n;
+                }
+                default:
+                    return BoxCylinder(shapeA, shapeB, separation, contacts);
+            }
+        case ChPrimitiveShape::CAPSULE:
+            if (shapeB.type == ChPrimitiveShape::CAPSULE)
+                return CapsuleCapsule(shapeA, shapeB, separation, contacts);
+            return CapsuleConvex(shapeA, shapeB, separation, contacts);
+        case ChPrimitiveShape::CYLINDER:
+            return MPRSingle(shapeA, shapeB, separation, contacts);
+    }
+
+    return 0;
+}
+
+bool ChNarrowphasePrimitive::RayHit(const ChPrimitiveShape& shape,
+                                    const ChVector<>& from,
+                                    const ChVector<>& to,
+                                    double& fraction,
+                                    ChVector<>& normal) {
+    ChVector<> o = ToLocal(shape, from);
+    ChVector<> d = DirToLocal(shape, to - from);
+    bool hit = false;
+    double t = 1;
+    ChVector<> n;
+
+    switch (shape.type) {
+        case ChPrimitiveShape::SPHERE:
+            hit = RaySphere(o, d, VNULL, shape.dims.x(), t, n);
+            break;
+        case ChPrimitiveShape::BOX: {
+            // Slab test; a segment starting inside the box does not hit it.
+            double tmin = 0;
+            double tmax = 1;
+            int axis = -1;
+            double side = 1;
+            for (int i = 0; i < 3; i++) {
+                double h = shape.dims[i];
+                if (std::abs(d[i]) < kEps) {
+                    if (std::abs(o[i]) > h)
+                        return false;
+                    continue;
+                }
+                double t1 = (-h - o[i]) / d[i];
+                double t2 = (h - o[i]) / d[i];
+                double s = -1;
+                if (t1 > t2) {
+                    std::swap(t1, t2);
+                    s = 1;
+                }
+                if (t1 > tmin) {
+                    tmin = t1;
+                    axis = i;
+                    side = s;
+                }
+                tmax = std::min(tmax, t2);
+                if (tmin > tmax)
+                    return false;
+            }
+            if (axis < 0)
+                return false;
+            hit = true;
+            t = tmin;
+            n = VNULL;
+            n[axis] = side;
+            break;
+        }
+        case ChPrimitiveShape::CAPSULE: {
+            double r = shape.dims.x();
+            double h = shape.dims.y();
+            double t1;
+            ChVector<> n1;
+            bool hit1 = RayCylinderSide(o, d, r, h, t1, n1);
+            KeepNearest(hit1, t1, n1, hit, t, n);
+            hit1 = RaySphere(o, d, ChVector<>(0, h, 0), r, t1, n1);
+            KeepNearest(hit1, t1, n1, hit, t, n);
+            hit1 = RaySphere(o, d, ChVector<>(0, -h, 0), r, t1, n1);
+            KeepNearest(hit1, t1, n1, hit, t, n);
+            break;
+        }
+        case ChPrimitiveShape::CYLINDER: {
+            double r = shape.dims.x();
+            double h = shape.dims.y();
+            double t1;
+            ChVector<> n1;
+            bool hit1 = RayCylinderSide(o, d, r, h, t1, n1);
+            KeepNearest(hit1, t1, n1, hit, t, n);
+            for (double s = -1; s <= 1; s += 2) {
+                if (d.y() * s >= 0)
+                    continue;
+                t1 = (s * h - o.y()) / d.y();
+                ChVector<> p = o + d * t1;
+                bool cap_hit = t1 >= 0 && t1 <= 1 && p.x() * p.x() + p.z() * p.z() <= r * r;
+                KeepNearest(cap_hit, t1, ChVector<>(0, s, 0), hit, t, n);
+            }
+            break;
+        }
+    }
+
+    if (!hit)
+        return false;
+
+    fraction = t;
+    normal = DirToAbs(shape, n);
+    return true;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,66 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHC_NARROWPHASEPRIMITIVE_H
+#define CHC_NARROWPHASEPRIMITIVE_H
+
+#include "chrono/collision/ChCModelPrimitive.h"
+
+namespace chrono {
+namespace collision {
+
+///
+/// Class with narrowphase collision tests between primitive shapes,
+/// as static functions.
+///
+/// Sphere, box and capsule pairs, as well as sphere-cylinder and capsule-cylinder, use analytic
+/// tests. Box-box uses the separating axis test with face clipping (up to 8 contacts).
+/// Box-cylinder and cylinder-cylinder use Minkowski Portal Refinement; box-cylinder additionally
+/// generates multiple contacts when the cylinder cap or side rests on a box face.
+///
+
+class ChApi ChNarrowphasePrimitive {
+  public:
+    /// Maximum number of contacts generated for a pair of shapes.
+    static const int MAX_CONTACTS = 8;
+
+    /// Contact between two shapes.
+    struct Contact {
+        ChVector<> pA;      ///< contact point on first shape
+        ChVector<> pB;      ///< contact point on second shape
+        ChVector<> normal;  ///< contact normal, from first to second shape
+        double distance;    ///< signed distance along the normal (negative for penetration)
+        double eff_radius;  ///< effective radius of curvature at the contact
+    };
+
+    /// Compute the contacts between the two shapes (in absolute frame), including pairs separated by
+    /// at most 'separation'. Contacts are stored in the provided array (of at least MAX_CONTACTS entries).
+    /// Return the number of contacts found.
+    static int Collide(const ChPrimitiveShape& shapeA,
+                       const ChPrimitiveShape& shapeB,
+                       double separation,
+                       Contact* contacts);
+
+    /// Intersect the segment [from, to] with the given shape (in absolute frame).
+    /// Return true if there is an intersection, in which case 'fraction' is the position of the
+    /// first hit point along the segment (0...1) and 'normal' the outward surface normal there.
+    static bool RayHit(const ChPrimitiveShape& shape,
+                       const ChVector<>& from,
+                       const ChVector<>& to,
+                       double& fraction,
+                       ChVector<>& normal);
+};
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
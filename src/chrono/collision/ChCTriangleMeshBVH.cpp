@@ -0,0 +1,278 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cassert>
+
+#include "chrono/collision/ChCTriangleMeshBVH.h"
+
+namespace chrono {
+namespace collision {
+
+// Relative costs of a node traversal and of a triangle test, for the surface area heuristic.
+static const double SAH_COST_TRAVERSAL = 1.2;
+static const double SAH_COST_TRIANGLE = 1.0;
+
+// Spread the lower 10 bits of v so that there are two zero bits between each of them.
+static uint32_t ExpandBits(uint32_t v) {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+// 30-bit Morton code of a point with coordinates in [0,1].
+static uint32_t MortonCode(double x, double y, double z) {
+    uint32_t ix = (uint32_t)std::min(std::max(x * 1024.0, 0.0), 1023.0);
+    uint32_t iy = (uint32_t)std::min(std::max(y * 1024.0, 0.0), 1023.0);
+    uint32_t iz = (uint32_t)std::min(std::max(z * 1024.0, 0.0), 1023.0);
+    return (ExpandBits(ix) << 2) | (ExpandBits(iy) << 1) | ExpandBits(iz);
+}
+
+// Number of leading zero bits in a 64-bit value.
+static int CountLeadingZeros(uint64_t v) {
+    int n = 0;
+    for (int shift = 32; shift > 0; shift >>= 1) {
+        if ((v >> (64 - shift)) == 0) {
+            n += shift;
+            v <<= shift;
+        }
+    }
+    return v == 0 ? n + 1 : n;
+}
+
+static double HalfArea(const ChVector<>& bbmin, const ChVector<>& bbmax) {
+    ChVector<> d = bbmax - bbmin;
+    return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+}
+
+// -----------------------------------------------------------------------------
+
+ChTriangleMeshBVH::ChTriangleMeshBVH()
+    : m_num_triangles(0),
+      m_cost(0),
+      m_build_cost(0),
+      m_rebuild_threshold(1.5),
+      m_num_builds(0),
+      m_num_refits(0) {}
+
+bool ChTriangleMeshBVH::Update(const std::vector<ChVector<>>& vertices) {
+    if (m_num_builds == 0 || (int)vertices.size() != 3 * m_num_triangles) {
+        Build(vertices);
+        return true;
+    }
+
+    Refit(vertices);
+    if (m_cost > m_rebuild_threshold * m_build_cost) {
+        Build(vertices);
+        return true;
+    }
+
+    return false;
+}
+
+void ChTriangleMeshBVH::Build(const std::vector<ChVector<>>& vertices) {
+    int n = (int)vertices.size() / 3;
+    m_num_triangles = n;
+    m_num_builds++;
+
+    m_nodes.resize(n > 0 ? 2 * n - 1 : 0);
+    m_keys.resize(n);
+    m_levels.clear();
+    m_level_offsets.clear();
+
+    if (n == 0) {
+        m_cost = m_build_cost = 0;
+        return;
+    }
+
+    // Bounds of the triangle centroids, used to quantize the Morton codes
+    ChVector<> cmin(+1e30);
+    ChVector<> cmax(-1e30);
+    for (int i = 0; i < n; i++) {
+        ChVector<> c = (vertices[3 * i] + vertices[3 * i + 1] + vertices[3 * i + 2]) * (1.0 / 3.0);
+        for (int j = 0; j < 3; j++) {
+            cmin[j] = std::min(cmin[j], c[j]);
+            cmax[j] = std::max(cmax[j], c[j]);
+        }
+    }
+    ChVector<> scale;
+    for (int j = 0; j < 3; j++)
+        scale[j] = (cmax[j] > cmin[j]) ? 1.0 / (cmax[j] - cmin[j]) : 0.0;
+
+    // Sort keys: Morton code in the upper bits, triangle index in the lower bits (this makes all keys distinct)
+#pragma omp parallel for
+    for (int i = 0; i < n; i++) {
+        ChVector<> c = (vertices[3 * i] + vertices[3 * i + 1] + vertices[3 * i + 2]) * (1.0 / 3.0);
+        uint32_t code = MortonCode((c.x() - cmin.x()) * scale.x(), (c.y() - cmin.y()) * scale.y(),
+                                   (c.z() - cmin.z()) * scale.z());
+        m_keys[i] = ((uint64_t)code << 32) | (uint64_t)i;
+    }
+    std::sort(m_keys.begin(), m_keys.end());
+
+    // Leaves, in Morton order, after the n-1 internal nodes
+#pragma omp parallel for
+    for (int i = 0; i < n; i++) {
+        Node& leaf = m_nodes[n - 1 + i];
+        leaf.child[0] = -1;
+        leaf.child[1] = (int)(m_keys[i] & 0xFFFFFFFFu);
+    }
+
+    // Internal nodes (Karras, "Maximizing parallelism in the construction of BVHs, octrees, and k-d trees").
+    // Node i covers a range of sorted keys starting or ending at i; its children are split at the highest
+    // differing bit in that range.
+    const uint64_t* keys = m_keys.data();
+    auto delta = [keys, n](int i, int j) -> int {
+        if (j < 0 || j >= n)
+            return -1;
+        return CountLeadingZeros(keys[i] ^ keys[j]);
+    };
+
+#pragma omp parallel for
+    for (int i = 0; i < n - 1; i++) {
+        // Direction of the range
+        int d = (delta(i, i + 1) - delta(i, i - 1)) >= 0 ? 1 : -1;
+
+        // Upper bound of the range length, then exact length by binary search
+        int delta_min = delta(i, i - d);
+        int lmax = 2;
+        while (delta(i, i + lmax * d) > delta_min)
+            lmax *= 2;
+        int l = 0;
+        for (int t = lmax / 2; t >= 1; t /= 2) {
+            if (delta(i, i + (l + t) * d) > delta_min)
+                l += t;
+        }
+        int j = i + l * d;
+
+        // Split position, by binary search
+        int delta_node = delta(i, j);
+        int s = 0;
+        int t = l;
+        do {
+            t = (t + 1) / 2;
+            if (delta(i, i + (s + t) * d) > delta_node)
+                s += t;
+        } while (t > 1);
+        int gamma = i + s * d + std::min(d, 0);
+
+        Node& node = m_nodes[i];
+        node.child[0] = (std::min(i, j) == gamma) ? n - 1 + gamma : gamma;
+        node.child[1] = (std::max(i, j) == gamma + 1) ? n + gamma : gamma + 1;
+    }
+
+    // Group the internal nodes by depth (breadth-first order), for the level-by-level refit
+    m_levels.reserve(n - 1);
+    if (n > 1) {
+        m_levels.push_back(0);
+        size_t begin = 0;
+        while (begin < m_levels.size()) {
+            size_t end = m_levels.size();
+            m_level_offsets.push_back((int)begin);
+            for (size_t k = begin; k < end; k++) {
+                const Node& node = m_nodes[m_levels[k]];
+                for (int c = 0; c < 2; c++) {
+                    if (node.child[c] < n - 1)
+                        m_levels.push_back(node.child[c]);
+                }
+            }
+            begin = end;
+        }
+    }
+    m_level_offsets.push_back((int)m_levels.size());
+
+    RefitLeaves(vertices);
+    RefitInternalNodes();
+    ComputeCost();
+    m_build_cost = m_cost;
+}
+
+void ChTriangleMeshBVH::Refit(const std::vector<ChVector<>>& vertices) {
+    assert((int)vertices.size() == 3 * m_num_triangles);
+    m_num_refits++;
+
+    RefitLeaves(vertices);
+    RefitInternalNodes();
+    ComputeCost();
+}
+
+void ChTriangleMeshBVH::RefitLeaves(const std::vector<ChVector<>>& vertices) {
+    int n = m_num_triangles;
+
+#pragma omp parallel for
+    for (int i = 0; i < n; i++) {
+        Node& leaf = m_nodes[n - 1 + i];
+        int t = leaf.child[1];
+        const ChVector<>& v0 = vertices[3 * t];
+        const ChVector<>& v1 = vertices[3 * t + 1];
+        const ChVector<>& v2 = vertices[3 * t + 2];
+        for (int j = 0; j < 3; j++) {
+            leaf.bbmin[j] = std::min(v0[j], std::min(v1[j], v2[j]));
+            leaf.bbmax[j] = std::max(v0[j], std::max(v1[j], v2[j]));
+        }
+    }
+}
+
+void ChTriangleMeshBVH::RefitInternalNodes() {
+    // From the deepest level up to the root; the nodes of a level are independent
+    for (int level = (int)m_level_offsets.size() - 2; level >= 0; level--) {
+        int begin = m_level_offsets[level];
+        int end = m_level_offsets[level + 1];
+#pragma omp parallel for
+        for (int k = begin; k < end; k++) {
+            Node& node = m_nodes[m_levels[k]];
+            const Node& c0 = m_nodes[node.child[0]];
+            const Node& c1 = m_nodes[node.child[1]];
+            for (int j = 0; j < 3; j++) {
+                node.bbmin[j] = std::min(c0.bbmin[j], c1.bbmin[j]);
+                node.bbmax[j] = std::max(c0.bbmax[j], c1.bbmax[j]);
+            }
+        }
+    }
+}
+
+void ChTriangleMeshBVH::ComputeCost() {
+    int n = m_num_triangles;
+    int num_nodes = (int)m_nodes.size();
+
+    double area_internal = 0;
+    double area_leaves = 0;
+#pragma omp parallel for reduction(+ : area_internal, area_leaves)
+    for (int i = 0; i < num_nodes; i++) {
+        double a = HalfArea(m_nodes[i].bbmin, m_nodes[i].bbmax);
+        if (i < n - 1)
+            area_internal += a;
+        else
+            area_leaves += a;
+    }
+
+    double area_root = HalfArea(m_nodes[0].bbmin, m_nodes[0].bbmax);
+    if (area_root <= 0) {
+        m_cost = SAH_COST_TRIANGLE * n;
+        return;
+    }
+    m_cost = (SAH_COST_TRAVERSAL * area_internal + SAH_COST_TRIANGLE * area_leaves) / area_root;
+}
+
+void ChTriangleMeshBVH::GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const {
+    if (m_num_triangles == 0) {
+        bbmin = VNULL;
+        bbmax = VNULL;
+        return;
+    }
+    bbmin = m_nodes[0].bbmin;
+    bbmax = m_nodes[0].bbmax;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,134 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHC_TRIANGLEMESHBVH_H
+#define CHC_TRIANGLEMESHBVH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChVector.h"
+
+namespace chrono {
+namespace collision {
+
+///
+/// Bounding volume hierarchy (AABB tree) for triangle meshes whose vertices move, as in
+/// meshes attached to FEA nodes or morphing terrain.
+/// The tree is a linear BVH: triangles are sorted along a Morton (Z-order) curve of their
+/// centroids and the hierarchy is emitted in parallel (OpenMP), one internal node per thread.
+/// When the vertices move, the topology of the tree is kept and the boxes are refitted
+/// bottom-up, level by level. The tree is rebuilt only when its quality degrades, i.e. when
+/// its surface area heuristic (SAH) cost grows beyond a given ratio of the cost at build time.
+///
+
+class ChApi ChTriangleMeshBVH {
+  public:
+    ChTriangleMeshBVH();
+
+    /// Set the SAH cost ratio (current cost / cost after last build) above which Update()
+    /// rebuilds the tree instead of refitting it. Default: 1.5
+    void SetRebuildThreshold(double ratio) { m_rebuild_threshold = ratio; }
+    double GetRebuildThreshold() const { return m_rebuild_threshold; }
+
+    /// Update the tree for the given triangle vertices (three consecutive vertices per triangle).
+    /// The tree is built at the first call or if the number of triangles changed, otherwise it
+    /// is refitted, and rebuilt only if the SAH cost exceeds the rebuild threshold.
+    /// Return true if the tree was rebuilt.
+    bool Update(const std::vector<ChVector<>>& vertices);
+
+    /// Build the tree from scratch for the given triangle vertices.
+    void Build(const std::vector<ChVector<>>& vertices);
+
+    /// Refit the boxes of the current tree to the given triangle vertices.
+    /// The number of triangles must be the same as in the last Build().
+    void Refit(const std::vector<ChVector<>>& vertices);
+
+    /// Get the number of triangles in the tree.
+    int GetNumTriangles() const { return m_num_triangles; }
+
+    /// Get the SAH cost of the tree, as computed by the last Build() or Refit().
+    double GetSAHCost() const { return m_cost; }
+
+    /// Get the SAH cost of the tree right after the last Build().
+    double GetSAHCostAtBuild() const { return m_build_cost; }
+
+    /// Get the number of builds performed so far.
+    unsigned int GetNumBuilds() const { return m_num_builds; }
+
+    /// Get the number of refits performed so far.
+    unsigned int GetNumRefits() const { return m_num_refits; }
+
+    /// Get the bounding box of the whole mesh.
+    void GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const;
+
+    /// Invoke callback(triangle_index) for all triangles whose box overlaps the given box.
+    template <class Callback>
+    void QueryAABB(const ChVector<>& bbmin, const ChVector<>& bbmax, Callback&& callback) const {
+        if (m_num_triangles == 0)
+            return;
+        int stack[2 * MAX_DEPTH];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = m_nodes[stack[--top]];
+            if (!Overlap(node, bbmin, bbmax))
+                continue;
+            if (node.child[0] < 0) {
+                callback(node.child[1]);
+                continue;
+            }
+            stack[top++] = node.child[0];
+            stack[top++] = node.child[1];
+        }
+    }
+
+  private:
+    /// Maximum depth of the tree (the hierarchy splits on the bits of 64-bit sort keys).
+    static const int MAX_DEPTH = 66;
+
+    /// Tree node. Internal nodes are stored first (the root is node 0), followed by the leaves.
+    /// For a leaf, child[0] is -1 and child[1] is the triangle index.
+    struct Node {
+        ChVector<> bbmin;
+        ChVector<> bbmax;
+        int child[2];
+    };
+
+    static bool Overlap(const Node& node, const ChVector<>& bbmin, const ChVector<>& bbmax) {
+        return node.bbmin.x() <= bbmax.x() && node.bbmax.x() >= bbmin.x() &&  //
+               node.bbmin.y() <= bbmax.y() && node.bbmax.y() >= bbmin.y() &&  //
+               node.bbmin.z() <= bbmax.z() && node.bbmax.z() >= bbmin.z();
+    }
+
+    void RefitLeaves(const std::vector<ChVector<>>& vertices);
+    void RefitInternalNodes();
+    void ComputeCost();
+
+    std::vector<Node> m_nodes;               ///< internal nodes followed by leaves
+    std::vector<uint64_t> m_keys;            ///< sorted keys (Morton code and triangle index)
+    std::vector<int> m_levels;               ///< internal nodes, sorted by depth
+    std::vector<int> m_level_offsets;        ///< offset of each depth level in m_levels
+    int m_num_triangles;
+
+    double m_cost;
+    double m_build_cost;
+    double m_rebuild_threshold;
+    unsigned int m_num_builds;
+    unsigned int m_num_refits;
+};
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
@@ -99,7 +99,10 @@ bool SphereTriangleDetector::collide(const btVector3& sphereCenter,btVector3 &po
 
 	const btVector3* vertices = &m_triangle->getVertexPtr(0);
 	const btVector3& c = sphereCenter;
-	btScalar r = m_sphere->getRadius();
+	//***CHRONO*** the triangle is inflated by its margin (the margin of the concave shape, see ChModelBullet), as
+	// in the GJK algorithm used for the other convex shapes
+	btScalar triangleMargin = m_triangle->getMargin();
+	btScalar r = m_sphere->getRadius() + triangleMargin;
 
 	btVector3 delta (0,0,0);
 
@@ -161,7 +164,7 @@ bool SphereTriangleDetector::collide(const btVector3& sphereCenter,btVector3 &po
 			btScalar distance = btSqrt(distanceSqr);
 			resultNormal = contactToCentre;
 			resultNormal.normalize();
-			point = contactPoint;
+			point = contactPoint + resultNormal * triangleMargin;
 			depth = -(r-distance);
 			return true;
 		}
@@ -122,7 +122,8 @@ public:
 		CF_CUSTOM_MATERIAL_CALLBACK = 8,//this allows per-triangle material (friction/restitution)
 		CF_CHARACTER_OBJECT = 16,
 		CF_DISABLE_VISUALIZE_OBJECT = 32, //disable debug drawing
-		CF_DISABLE_SPU_COLLISION_PROCESSING = 64//disable parallel/SPU processing
+		CF_DISABLE_SPU_COLLISION_PROCESSING = 64,//disable parallel/SPU processing
+		CF_EXTERNAL_AABB_UPDATE = 128 //***CHRONO*** AABB set by the owner, skipped in btCollisionWorld::updateAabbs
 	};
 
 	enum	CollisionObjectTypes
@@ -187,7 +187,9 @@ void	btCollisionWorld::updateAabbs()
 		btCollisionObject* colObj = m_collisionObjects[i];
 
 		//only update aabb of active objects
-		if (m_forceUpdateAllAabbs || colObj->isActive())
+		//***CHRONO*** skip objects whose aabb is updated externally
+		if ((m_forceUpdateAllAabbs || colObj->isActive()) &&
+			!(colObj->getCollisionFlags() & btCollisionObject::CF_EXTERNAL_AABB_UPDATE))
 		{
 			updateSingleAabb(colObj);
 		}
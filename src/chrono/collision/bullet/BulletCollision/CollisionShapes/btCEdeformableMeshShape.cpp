@@ -0,0 +1,87 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  http://continuousphysics.com/Bullet/
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "btCEdeformableMeshShape.h"
+#include "LinearMath/btAabbUtil2.h"
+
+using namespace chrono;
+
+btCEdeformableMeshShape::btCEdeformableMeshShape(std::shared_ptr<geometry::ChTriangleMesh> mesh)
+    : m_mesh(mesh), m_localScaling(btScalar(1.), btScalar(1.), btScalar(1.))
+{
+    m_shapeType = CUSTOM_CONCAVE_SHAPE_TYPE;
+    updateMesh();
+}
+
+bool btCEdeformableMeshShape::updateMesh()
+{
+    int ntri = m_mesh->getNumTriangles();
+    m_vertices.resize(3 * ntri);
+
+    ChVector<> scaling(m_localScaling.x(), m_localScaling.y(), m_localScaling.z());
+
+#pragma omp parallel for
+    for (int i = 0; i < ntri; i++) {
+        geometry::ChTriangle tri = m_mesh->getTriangle(i);
+        m_vertices[3 * i + 0] = tri.p1 * scaling;
+        m_vertices[3 * i + 1] = tri.p2 * scaling;
+        m_vertices[3 * i + 2] = tri.p3 * scaling;
+    }
+
+    return m_bvh.Update(m_vertices);
+}
+
+void btCEdeformableMeshShape::getAabb(const btTransform& t, btVector3& aabbMin, btVector3& aabbMax) const
+{
+    ChVector<> bbmin;
+    ChVector<> bbmax;
+    m_bvh.GetAABB(bbmin, bbmax);
+
+    btVector3 localMin((btScalar)bbmin.x(), (btScalar)bbmin.y(), (btScalar)bbmin.z());
+    btVector3 localMax((btScalar)bbmax.x(), (btScalar)bbmax.y(), (btScalar)bbmax.z());
+    btTransformAabb(localMin, localMax, getMargin(), t, aabbMin, aabbMax);
+}
+
+void btCEdeformableMeshShape::processAllTriangles(btTriangleCallback* callback,
+                                                  const btVector3& aabbMin,
+                                                  const btVector3& aabbMax) const
+{
+    // The triangles are inflated by the collision margin
+    btScalar margin = getMargin();
+    ChVector<> bbmin(aabbMin.x() - margin, aabbMin.y() - margin, aabbMin.z() - margin);
+    ChVector<> bbmax(aabbMax.x() + margin, aabbMax.y() + margin, aabbMax.z() + margin);
+
+    m_bvh.QueryAABB(bbmin, bbmax, [this, callback](int t) {
+        btVector3 triangle[3];
+        for (int k = 0; k < 3; k++) {
+            const ChVector<>& v = m_vertices[3 * t + k];
+            triangle[k].setValue((btScalar)v.x(), (btScalar)v.y(), (btScalar)v.z());
+        }
+        callback->processTriangle(triangle, 0, t);
+    });
+}
+
+void btCEdeformableMeshShape::calculateLocalInertia(btScalar mass, btVector3& inertia) const
+{
+    // moving concave objects not supported, as in btTriangleMeshShape
+    (void)mass;
+    inertia.setValue(btScalar(0.), btScalar(0.), btScalar(0.));
+}
+
+void btCEdeformableMeshShape::setLocalScaling(const btVector3& scaling)
+{
+    m_localScaling = scaling;
+    updateMesh();
+}
@@ -0,0 +1,64 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  http://continuousphysics.com/Bullet/
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_CE_DEFORMABLE_MESH_SHAPE_H
+#define BT_CE_DEFORMABLE_MESH_SHAPE_H
+
+#include <memory>
+#include <vector>
+
+#include "btConcaveShape.h"
+#include "chrono/collision/ChCTriangleMeshBVH.h"
+#include "chrono/geometry/ChTriangleMesh.h"
+
+/// btCEdeformableMeshShape is a concave triangle mesh shape whose vertices can move, as in meshes
+/// attached to FEA nodes or morphing terrain. It references a Chrono triangle mesh; at each
+/// updateMesh() the vertices are read again and the linear BVH over the triangles is refitted
+/// (rebuilt only when the tree quality degrades, see chrono::collision::ChTriangleMeshBVH).
+/// The shape is handled by the Bullet convex-concave algorithm, so it collides with convex shapes
+/// and compounds of convex shapes, but not with other concave shapes.
+
+class btCEdeformableMeshShape : public btConcaveShape
+{
+public:
+    btCEdeformableMeshShape(std::shared_ptr<chrono::geometry::ChTriangleMesh> mesh);
+
+    /// Read the current vertices of the mesh and refit (or rebuild) the BVH.
+    /// Return true if the BVH was rebuilt.
+    bool updateMesh();
+
+    virtual void getAabb(const btTransform& t, btVector3& aabbMin, btVector3& aabbMax) const;
+
+    virtual void processAllTriangles(btTriangleCallback* callback, const btVector3& aabbMin, const btVector3& aabbMax) const;
+
+    virtual void calculateLocalInertia(btScalar mass, btVector3& inertia) const;
+
+    virtual void setLocalScaling(const btVector3& scaling);
+    virtual const btVector3& getLocalScaling() const { return m_localScaling; }
+
+    virtual const char* getName() const { return "CEDEFORMABLEMESH"; }
+
+    std::shared_ptr<chrono::geometry::ChTriangleMesh> getMesh() const { return m_mesh; }
+    const chrono::collision::ChTriangleMeshBVH& getBVH() const { return m_bvh; }
+    chrono::collision::ChTriangleMeshBVH& getBVH() { return m_bvh; }
+
+private:
+    std::shared_ptr<chrono::geometry::ChTriangleMesh> m_mesh;
+    std::vector<chrono::ChVector<>> m_vertices;  // three vertices per triangle, scaled
+    chrono::collision::ChTriangleMeshBVH m_bvh;
+    btVector3 m_localScaling;
+};
+
+#endif
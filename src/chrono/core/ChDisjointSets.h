@@ -0,0 +1,74 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHDISJOINTSETS_H
+#define CHDISJOINTSETS_H
+
+#include <utility>
+#include <vector>
+
+namespace chrono {
+
+/// Union-find structure over the integers 0..n-1, with path compression and union by size.
+/// Used, for instance, to partition a system into independent islands of coupled items.
+class ChDisjointSets {
+  public:
+    ChDisjointSets(int n = 0) { Reset(n); }
+
+    /// Reset to n singleton sets.
+    void Reset(int n) {
+        parent.resize(n);
+        size.assign(n, 1);
+        for (int i = 0; i < n; i++)
+            parent[i] = i;
+    }
+
+    /// Number of elements.
+    int GetNumElements() const { return (int)parent.size(); }
+
+    /// Return the representative of the set containing i.
+    int Find(int i) {
+        int root = i;
+        while (parent[root] != root)
+            root = parent[root];
+        while (parent[i] != root) {
+            int next = parent[i];
+            parent[i] = root;
+            i = next;
+        }
+        return root;
+    }
+
+    /// Merge the sets containing i and j. Return the representative of the merged set.
+    int Union(int i, int j) {
+        int ri = Find(i);
+        int rj = Find(j);
+        if (ri == rj)
+            return ri;
+        if (size[ri] < size[rj])
+            std::swap(ri, rj);
+        parent[rj] = ri;
+        size[ri] += size[rj];
+        return ri;
+    }
+
+    /// Number of elements in the set containing i.
+    int GetSetSize(int i) { return size[Find(i)]; }
+
+  private:
+    std::vector<int> parent;
+    std::vector<int> size;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -38,6 +38,7 @@ class ChApi ChContactSurface {
         // default non-smooth contact material
         matsurface = chrono_types::make_shared<ChMaterialSurfaceNSC>();
         mmesh = parentmesh;
+        aabb_tolerance = 0;
     }
 
     virtual ~ChContactSurface() {}
@@ -58,6 +59,16 @@ class ChApi ChContactSurface {
     /// Set the material surface for 'boundary contact'
     std::shared_ptr<ChMaterialSurface>& GetMaterialSurface() { return matsurface; }
 
+    /// Set the tolerance for skipping updates of the collision AABBs, as a fraction of the collision envelope.
+    /// The AABB of a contact item (triangle or node) is recomputed only if one of its nodes moved more than
+    /// tolerance*envelope since the last AABB update. The default value of 0 updates the AABB of every item
+    /// that moved. Larger values reduce the cost of collision synchronization for slowly deforming meshes, at the
+    /// price of a reduced effective envelope (contacts are still detected, but possibly later).
+    void SetAabbUpdateTolerance(double tol) { aabb_tolerance = tol; }
+
+    /// Get the tolerance for skipping updates of the collision AABBs.
+    double GetAabbUpdateTolerance() const { return aabb_tolerance; }
+
     /// Functions to interface this with ChPhysicsItem container
     virtual void SurfaceSyncCollisionModels() = 0;
     virtual void SurfaceAddCollisionModelsToSystem(ChSystem* msys) = 0;
@@ -67,6 +78,8 @@ class ChApi ChContactSurface {
     std::shared_ptr<ChMaterialSurface> matsurface;  ///< material for contacts
 
     ChMesh* mmesh;
+
+    double aabb_tolerance;  ///< tolerance for skipping AABB updates (fraction of envelope)
 };
 
 /// @} fea_contact
@@ -12,6 +12,7 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChSystem.h"
@@ -904,13 +905,126 @@ unsigned int ChContactSurfaceMesh::GetNumVertices() const {
     return (unsigned int)(count + count_rot);
 }
 
+void ChContactSurfaceMesh::UpdateSyncData() {
+    sync_models.clear();
+    sync_vertices.clear();
+    sync_indices.clear();
+    sync_threshold2.clear();
+
+    std::unordered_map<const ChVector<>*, int> vertex_map;
+    auto add_vertex = [&](const ChVector<>* v) {
+        auto it = vertex_map.find(v);
+        if (it != vertex_map.end()) {
+            sync_indices.push_back(it->second);
+            return;
+        }
+        vertex_map.insert({v, (int)sync_vertices.size()});
+        sync_indices.push_back((int)sync_vertices.size());
+        sync_vertices.push_back(v);
+    };
+    auto add_model = [&](collision::ChCollisionModel* model) {
+        auto bt_model = (collision::ChModelBullet*)model;
+        bt_model->SetExternalAabbUpdate(true);
+        double threshold = aabb_tolerance * bt_model->GetEnvelope();
+        sync_models.push_back(bt_model);
+        sync_threshold2.push_back(threshold * threshold);
+    };
+
+    for (auto& face : vfaces) {
+        add_model(face->GetCollisionModel());
+        add_vertex(&face->GetNode1()->pos);
+        add_vertex(&face->GetNode2()->pos);
+        add_vertex(&face->GetNode3()->pos);
+    }
+    for (auto& face : vfaces_rot) {
+        add_model(face->GetCollisionModel());
+        add_vertex(&face->GetNode1()->coord.pos);
+        add_vertex(&face->GetNode2()->coord.pos);
+        add_vertex(&face->GetNode3()->coord.pos);
+    }
+
+    // Force an update of all AABBs at next synchronization
+    sync_pos.resize(sync_vertices.size());
+    sync_ref.assign(sync_indices.size(), ChVector<>(1e30));
+    sync_update.resize(sync_models.size());
+    sync_tolerance = aabb_tolerance;
+}
+
+bool ChContactSurfaceMesh::IsSyncDataValid() const {
+    if (sync_tolerance != aabb_tolerance || sync_models.size() != vfaces.size() + vfaces_rot.size())
+        return false;
+
+    // The triangle lists can be edited in place, so also check that the cached models and vertices are still those
+    // of the current triangles.
+    size_t j = 0;
+    for (auto& face : vfaces) {
+        if (sync_models[j] != face->GetCollisionModel() ||
+            sync_vertices[sync_indices[3 * j + 0]] != &face->GetNode1()->pos ||
+            sync_vertices[sync_indices[3 * j + 1]] != &face->GetNode2()->pos ||
+            sync_vertices[sync_indices[3 * j + 2]] != &face->GetNode3()->pos)
+            return false;
+        j++;
+    }
+    for (auto& face : vfaces_rot) {
+        if (sync_models[j] != face->GetCollisionModel() ||
+            sync_vertices[sync_indices[3 * j + 0]] != &face->GetNode1()->coord.pos ||
+            sync_vertices[sync_indices[3 * j + 1]] != &face->GetNode2()->coord.pos ||
+            sync_vertices[sync_indices[3 * j + 2]] != &face->GetNode3()->coord.pos)
+            return false;
+        j++;
+    }
+    return true;
+}
+
 void ChContactSurfaceMesh::SurfaceSyncCollisionModels() {
-    for (unsigned int j = 0; j < vfaces.size(); j++) {
+    int nfaces = (int)vfaces.size();
+    int nfaces_rot = (int)vfaces_rot.size();
+
+#pragma omp parallel for
+    for (int j = 0; j < nfaces; j++) {
         this->vfaces[j]->GetCollisionModel()->SyncPosition();
     }
-    for (unsigned int j = 0; j < vfaces_rot.size(); j++) {
+#pragma omp parallel for
+    for (int j = 0; j < nfaces_rot; j++) {
         this->vfaces_rot[j]->GetCollisionModel()->SyncPosition();
     }
+
+    // With the Bullet collision system, the triangle AABBs are updated here (in parallel) rather than by the
+    // collision system, and only for triangles with a vertex that moved more than the tolerance.
+    if (!GetMesh() || !GetMesh()->GetSystem())
+        return;
+    auto coll_sys =
+        std::dynamic_pointer_cast<collision::ChCollisionSystemBullet>(GetMesh()->GetSystem()->GetCollisionSystem());
+    if (!coll_sys)
+        return;
+
+    if (!IsSyncDataValid())
+        UpdateSyncData();
+
+    int nvertices = (int)sync_vertices.size();
+#pragma omp parallel for
+    for (int i = 0; i < nvertices; i++) {
+        sync_pos[i] = *sync_vertices[i];
+    }
+
+    int ntriangles = (int)sync_models.size();
+#pragma omp parallel for
+    for (int j = 0; j < ntriangles; j++) {
+        bool update = false;
+        for (int k = 0; k < 3; k++) {
+            if ((sync_pos[sync_indices[3 * j + k]] - sync_ref[3 * j + k]).Length2() > sync_threshold2[j]) {
+                update = true;
+                break;
+            }
+        }
+        if (update) {
+            for (int k = 0; k < 3; k++)
+                sync_ref[3 * j + k] = sync_pos[sync_indices[3 * j + k]];
+        }
+        sync_update[j] = update;
+    }
+
+    coll_sys->UpdateAabbs(sync_models, sync_update);
 }
 
 void ChContactSurfaceMesh::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
@@ -19,6 +19,7 @@
 #include "chrono/fea/ChNodeFEAxyz.h"
 #include "chrono/fea/ChNodeFEAxyzrot.h"
 #include "chrono/collision/ChCCollisionModel.h"
+#include "chrono/collision/ChCModelBullet.h"
 #include "chrono/collision/ChCCollisionUtils.h"
 #include "chrono/physics/ChLoaderUV.h"
 
@@ -684,7 +685,7 @@ class ChApi ChContactTriangleXYZROT : public ChContactable_3vars<6, 6, 6>, publi
 class ChApi ChContactSurfaceMesh : public ChContactSurface {
 
   public:
-    ChContactSurfaceMesh(ChMesh* parentmesh = 0) : ChContactSurface(parentmesh) {}
+    ChContactSurfaceMesh(ChMesh* parentmesh = 0) : ChContactSurface(parentmesh), sync_tolerance(-1) {}
 
     virtual ~ChContactSurfaceMesh() {}
 
@@ -733,9 +734,25 @@ class ChApi ChContactSurfaceMesh : public ChContactSurface {
     virtual void SurfaceRemoveCollisionModelsFromSystem(ChSystem* msys);
 
   private:
+    /// Check if the flat arrays used for synchronizing the collision models match the current triangles.
+    bool IsSyncDataValid() const;
+
+    /// Rebuild the flat arrays used for synchronizing the collision models.
+    void UpdateSyncData();
+
     std::vector<std::shared_ptr<ChContactTriangleXYZ> > vfaces;  //  faces that collide
     std::vector<std::shared_ptr<ChContactTriangleXYZROT> >
         vfaces_rot;  //  faces that collide (for nodes with rotation too)
+
+    // Flat data for the parallel synchronization of the collision models
+    std::vector<collision::ChModelBullet*> sync_models;  //  collision models of all triangles
+    std::vector<const ChVector<>*> sync_vertices;        //  positions of the unique triangle vertices
+    std::vector<int> sync_indices;                       //  vertex indices, 3 per triangle
+    std::vector<double> sync_threshold2;                 //  squared displacement threshold, per triangle
+    std::vector<ChVector<> > sync_pos;                   //  current vertex positions
+    std::vector<ChVector<> > sync_ref;                   //  vertex positions at last AABB update, 3 per triangle
+    std::vector<char> sync_update;                       //  AABB update flags, per triangle
+    double sync_tolerance;                               //  tolerance used to compute the thresholds
 };
 
 /// @} fea_contact
@@ -12,6 +12,7 @@
 // Authors: Andrea Favali, Alessandro Tasora
 // =============================================================================
 
+#include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/fea/ChContactSurfaceNodeCloud.h"
@@ -156,13 +157,90 @@ void ChContactSurfaceNodeCloud::AddFacesFromNodeSet(std::vector<std::shared_ptr<
             this->AddNode(mnodeFEArot, point_radius);
 }
 
+void ChContactSurfaceNodeCloud::UpdateSyncData() {
+    sync_models.clear();
+    sync_vertices.clear();
+    sync_threshold2.clear();
+
+    auto add_model = [&](collision::ChCollisionModel* model) {
+        auto bt_model = (collision::ChModelBullet*)model;
+        bt_model->SetExternalAabbUpdate(true);
+        double threshold = aabb_tolerance * bt_model->GetEnvelope();
+        sync_models.push_back(bt_model);
+        sync_threshold2.push_back(threshold * threshold);
+    };
+
+    for (auto& node : vnodes) {
+        add_model(node->GetCollisionModel());
+        sync_vertices.push_back(&node->GetNode()->pos);
+    }
+    for (auto& node : vnodes_rot) {
+        add_model(node->GetCollisionModel());
+        sync_vertices.push_back(&node->GetNode()->coord.pos);
+    }
+
+    // Force an update of all AABBs at next synchronization
+    sync_ref.assign(sync_vertices.size(), ChVector<>(1e30));
+    sync_update.resize(sync_models.size());
+    sync_tolerance = aabb_tolerance;
+}
+
+bool ChContactSurfaceNodeCloud::IsSyncDataValid() const {
+    if (sync_tolerance != aabb_tolerance || sync_models.size() != vnodes.size() + vnodes_rot.size())
+        return false;
+
+    // The node lists can be edited in place, so also check that the cached models and positions are still those
+    // of the current nodes.
+    size_t j = 0;
+    for (auto& node : vnodes) {
+        if (sync_models[j] != node->GetCollisionModel() || sync_vertices[j] != &node->GetNode()->pos)
+            return false;
+        j++;
+    }
+    for (auto& node : vnodes_rot) {
+        if (sync_models[j] != node->GetCollisionModel() || sync_vertices[j] != &node->GetNode()->coord.pos)
+            return false;
+        j++;
+    }
+    return true;
+}
+
 void ChContactSurfaceNodeCloud::SurfaceSyncCollisionModels() {
-    for (unsigned int j = 0; j < vnodes.size(); j++) {
+    int nnodes = (int)vnodes.size();
+    int nnodes_rot = (int)vnodes_rot.size();
+
+#pragma omp parallel for
+    for (int j = 0; j < nnodes; j++) {
         this->vnodes[j]->GetCollisionModel()->SyncPosition();
     }
-    for (unsigned int j = 0; j < vnodes_rot.size(); j++) {
+#pragma omp parallel for
+    for (int j = 0; j < nnodes_rot; j++) {
         this->vnodes_rot[j]->GetCollisionModel()->SyncPosition();
     }
+
+    // With the Bullet collision system, the node AABBs are updated here (in parallel) rather than by the
+    // collision system, and only for nodes that moved more than the tolerance.
+    if (!GetMesh() || !GetMesh()->GetSystem())
+        return;
+    auto coll_sys =
+        std::dynamic_pointer_cast<collision::ChCollisionSystemBullet>(GetMesh()->GetSystem()->GetCollisionSystem());
+    if (!coll_sys)
+        return;
+
+    if (!IsSyncDataValid())
+        UpdateSyncData();
+
+    int nmodels = (int)sync_models.size();
+#pragma omp parallel for
+    for (int j = 0; j < nmodels; j++) {
+        const ChVector<>& pos = *sync_vertices[j];
+        bool update = (pos - sync_ref[j]).Length2() > sync_threshold2[j];
+        if (update)
+            sync_ref[j] = pos;
+        sync_update[j] = update;
+    }
+
+    coll_sys->UpdateAabbs(sync_models, sync_update);
 }
 
 void ChContactSurfaceNodeCloud::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
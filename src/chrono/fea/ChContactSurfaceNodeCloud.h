@@ -16,6 +16,7 @@
 #define CHCONTACTSURFACENODECLOUD_H
 
 #include "chrono/collision/ChCCollisionModel.h"
+#include "chrono/collision/ChCModelBullet.h"
 #include "chrono/fea/ChContactSurface.h"
 #include "chrono/fea/ChNodeFEAxyz.h"
 #include "chrono/fea/ChNodeFEAxyzrot.h"
@@ -309,7 +310,7 @@ class ChApi ChContactNodeXYZROTsphere : public ChContactNodeXYZROT {
 class ChApi ChContactSurfaceNodeCloud : public ChContactSurface {
 
   public:
-    ChContactSurfaceNodeCloud(ChMesh* parentmesh = 0) : ChContactSurface(parentmesh){};
+    ChContactSurfaceNodeCloud(ChMesh* parentmesh = 0) : ChContactSurface(parentmesh), sync_tolerance(-1){};
 
     virtual ~ChContactSurfaceNodeCloud(){};
 
@@ -344,8 +345,22 @@ class ChApi ChContactSurfaceNodeCloud : public ChContactSurface {
     virtual void SurfaceRemoveCollisionModelsFromSystem(ChSystem* msys);
 
   private:
+    /// Check if the flat arrays used for synchronizing the collision models match the current nodes.
+    bool IsSyncDataValid() const;
+
+    /// Rebuild the flat arrays used for synchronizing the collision models.
+    void UpdateSyncData();
+
     std::vector<std::shared_ptr<ChContactNodeXYZsphere> > vnodes;         //  nodes
     std::vector<std::shared_ptr<ChContactNodeXYZROTsphere> > vnodes_rot;  //  nodes with rotations
+
+    // Flat data for the parallel synchronization of the collision models
+    std::vector<collision::ChModelBullet*> sync_models;  //  collision models of all nodes
+    std::vector<const ChVector<>*> sync_vertices;        //  node positions
+    std::vector<double> sync_threshold2;                 //  squared displacement threshold, per node
+    std::vector<ChVector<> > sync_ref;                   //  node positions at last AABB update
+    std::vector<char> sync_update;                       //  AABB update flags, per node
+    double sync_tolerance;                               //  tolerance used to compute the thresholds
 };
 
 /// @} fea_contact
@@ -103,6 +103,30 @@ void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     }
 }
 
+void ChMesh::AddNodes(const std::vector<std::shared_ptr<ChNodeFEAbase>>& m_nodes) {
+    vnodes.reserve(vnodes.size() + m_nodes.size());
+    for (const auto& node : m_nodes) {
+        node->SetIndex(static_cast<unsigned int>(vnodes.size()) + 1);
+        vnodes.push_back(node);
+    }
+
+    // If the mesh is already added to a system, mark the system uninitialized and out-of-date
+    if (system) {
+        system->is_initialized = false;
+        system->is_updated = false;
+    }
+}
+
+void ChMesh::AddElements(const std::vector<std::shared_ptr<ChElementBase>>& m_elems) {
+    velements.insert(velements.end(), m_elems.begin(), m_elems.end());
+
+    // If the mesh is already added to a system, mark the system uninitialized and out-of-date
+    if (system) {
+        system->is_initialized = false;
+        system->is_updated = false;
+    }
+}
+
 void ChMesh::ClearElements() {
     velements.clear();
     vcontactsurfaces.clear();
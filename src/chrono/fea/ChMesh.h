@@ -72,6 +72,12 @@ class ChApi ChMesh : public ChIndexedNodes {
 
     void AddNode(std::shared_ptr<ChNodeFEAbase> m_node);
     void AddElement(std::shared_ptr<ChElementBase> m_elem);
+
+    /// Append a batch of nodes, reserving storage once (faster than repeated AddNode for large meshes).
+    void AddNodes(const std::vector<std::shared_ptr<ChNodeFEAbase>>& m_nodes);
+    /// Append a batch of elements, reserving storage once (faster than repeated AddElement for large meshes).
+    void AddElements(const std::vector<std::shared_ptr<ChElementBase>>& m_elems);
+
     void ClearNodes();
     void ClearElements();
 
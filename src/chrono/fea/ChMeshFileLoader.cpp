@@ -15,12 +15,22 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <clocale>
+#include <climits>
 #include <sstream>
 #include <string>
-#include <cctype>
+#include <unordered_map>
+#include <sys/stat.h>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
 
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChSystem.h"
@@ -39,173 +49,423 @@ using namespace std;
 namespace chrono {
 namespace fea {
 
-void ChMeshFileLoader::FromTetGenFile(std::shared_ptr<ChMesh> mesh,
-                                      const char* filename_node,
-                                      const char* filename_ele,
-                                      std::shared_ptr<ChContinuumMaterial> my_material,
-                                      ChVector<> pos_transform,
-                                      ChMatrix33<> rot_transform) {
-    int totnodes = 0;
-    int nodes_offset = mesh->GetNnodes();
-    int added_nodes = 0;
-
-    // Load .node TetGen file
-    {
-        bool parse_header = true;
-        bool parse_nodes = false;
+// -----------------------------------------------------------------------------
+// Helpers for fast import of large TetGen and Abaqus meshes.
+// A file is read with a single block read and split into lines in place. Data
+// lines are then tokenized directly on the buffer, with a locale-independent
+// number conversion, which allows parsing them in parallel. Parsed data is
+// kept in flat arrays that can also be saved to (and restored from) a binary
+// cache file, bypassing the text parsing on subsequent loads.
+// -----------------------------------------------------------------------------
+
+namespace {
+
+// A trimmed, non-empty line of text, as a [begin, end) range in the file buffer.
+struct LineRange {
+    const char* begin;
+    const char* end;
+    std::string str() const { return std::string(begin, end); }
+};
+
+// Read the whole file in the buffer (null-terminated). Return false if the file cannot be read.
+bool ReadFileBuffer(const char* filename, std::vector<char>& buffer) {
+    ifstream fin(filename, std::ios::binary | std::ios::ate);
+    if (!fin.good())
+        return false;
+    std::streamoff size = fin.tellg();
+    fin.seekg(0, std::ios::beg);
+    buffer.resize(static_cast<size_t>(size) + 1);
+    if (size > 0 && !fin.read(buffer.data(), size))
+        return false;
+    buffer[static_cast<size_t>(size)] = 0;
+    return true;
+}
 
-        ifstream fin(filename_node);
-        if (!fin.good())
-            throw ChException("ERROR opening TetGen .node file: " + std::string(filename_node) + "\n");
-
-        int nnodes = 0;
-        int ndims = 0;
-        int nattrs = 0;
-        int nboundarymark = 0;
-
-        string line;
-        while (getline(fin, line)) {
-            // trims white space from the beginning of the string
-            line.erase(line.begin(),
-                       std::find_if(line.begin(), line.end(), [](unsigned char c) { return !std::isspace(c); }));
-
-            if (line[0] == '#')
-                continue;  // skip comment
-            if (line[0] == 0)
-                continue;  // skip empty lines
-
-            if (parse_header) {
-                stringstream(line) >> nnodes >> ndims >> nattrs >> nboundarymark;
-                if (ndims != 3)
-                    throw ChException("ERROR in TetGen .node file. Only 3 dimensional nodes supported: \n" + line);
-                if (nattrs != 0)
-                    throw ChException("ERROR in TetGen .node file. Only nodes with 0 attrs supported: \n" + line);
-                if (nboundarymark != 0)
-                    throw ChException("ERROR in TetGen .node file. Only nodes with 0 markers supported: \n" + line);
-                parse_header = false;
-                parse_nodes = true;
-                totnodes = nnodes;
-                continue;
-            }
+// Split the buffer in trimmed lines, skipping empty lines and lines starting with the 'comment' character.
+void SplitLines(const std::vector<char>& buffer, char comment, std::vector<LineRange>& lines) {
+    const char* p = buffer.data();
+    const char* last = p + buffer.size() - 1;
+    lines.clear();
+    lines.reserve(std::count(p, last, '\n') + 1);
+    while (p < last) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', last - p));
+        if (!eol)
+            eol = last;
+        const char* b = p;
+        while (b < eol && std::isspace(static_cast<unsigned char>(*b)))
+            ++b;
+        const char* e = eol;
+        while (e > b && std::isspace(static_cast<unsigned char>(e[-1])))
+            --e;
+        if (b < e && *b != comment)
+            lines.push_back({b, e});
+        p = eol + 1;
+    }
+}
 
-            int idnode = 0;
-            double x = -10e30;
-            double y = -10e30;
-            double z = -10e30;
+// Conversion of a floating point token with the "C" locale (plain strtod honors the global locale, e.g. comma as
+// decimal separator). The token is converted in place: it is followed in the buffer by a separator, a line break
+// or the terminating null character, where the conversion stops.
+#if defined(_WIN32)
+double StrtodClassic(const char* str, char** stop) {
+    static const _locale_t loc = _create_locale(LC_ALL, "C");
+    return _strtod_l(str, stop, loc);
+}
+#else
+double StrtodClassic(const char* str, char** stop) {
+    static const locale_t loc = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+    return strtod_l(str, stop, loc);
+}
+#endif
+
+bool ParseValue(const char* begin, const char* end, double& val) {
+    // only decimal numbers (no inf, nan or hexadecimal values)
+    char c = (*begin == '-' || *begin == '+') ? begin[1] : *begin;
+    if (!std::isdigit(static_cast<unsigned char>(c)) && c != '.')
+        return false;
+    char* stop;
+    val = StrtodClassic(begin, &stop);
+    return stop == end;
+}
 
-            if (parse_nodes) {
-                stringstream(line) >> idnode >> x >> y >> z;
-                ++added_nodes;
-                if (idnode <= 0 || idnode > nnodes)
-                    throw ChException("ERROR in TetGen .node file. Node ID not in range: \n" + line + "\n");
-                if (idnode != added_nodes)
-                    throw ChException("ERROR in TetGen .node file. Nodes IDs must be sequential (1 2 3 ..): \n" + line +
-                                      "\n");
-                if (x == -10e30 || y == -10e30 || z == -10e30)
-                    throw ChException("ERROR in TetGen .node file, in parsing x,y,z coordinates of node: \n" + line +
-                                      "\n");
+// Conversion of an integer token (node and element IDs).
+bool ParseValue(const char* begin, const char* end, long long& val) {
+    const char* p = begin;
+    bool negative = (*p == '-');
+    if (*p == '-' || *p == '+')
+        ++p;
+    if (p == end)
+        return false;
+    long long v = 0;
+    for (; p < end; ++p) {
+        unsigned int digit = static_cast<unsigned int>(*p - '0');
+        if (digit > 9 || v > (LLONG_MAX - digit) / 10)
+            return false;
+        v = 10 * v + digit;
+    }
+    val = negative ? -v : v;
+    return true;
+}
 
-                ChVector<> node_position(x, y, z);
-                node_position = rot_transform * node_position;  // rotate/scale, if needed
-                node_position = pos_transform + node_position;  // move, if needed
+bool ParseValue(const char* begin, const char* end, int& val) {
+    long long v;
+    if (!ParseValue(begin, end, v) || v < INT_MIN || v > INT_MAX)
+        return false;
+    val = static_cast<int>(v);
+    return true;
+}
 
-                if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                    auto mnode = chrono_types::make_shared<ChNodeFEAxyz>(node_position);
-                    mesh->AddNode(mnode);
-                } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                    auto mnode = chrono_types::make_shared<ChNodeFEAxyzP>(node_position);
-                    mesh->AddNode(mnode);
-                } else
-                    throw ChException("ERROR in TetGen generation. Material type not supported. \n");
-            }
+bool ParseValue(const char* begin, const char* end, unsigned int& val) {
+    long long v;
+    if (!ParseValue(begin, end, v) || v < 0 || v > UINT_MAX)
+        return false;
+    val = static_cast<unsigned int>(v);
+    return true;
+}
 
-        }  // end while
+// Tokens of a line, separated by blanks and/or commas.
+struct LineTokens {
+    LineTokens(const LineRange& line) : p(line.begin), end(line.end) {}
+    bool Next(const char*& begin, const char*& stop) {
+        while (p < end && (*p == ',' || std::isspace(static_cast<unsigned char>(*p))))
+            ++p;
+        if (p >= end)
+            return false;
+        begin = p;
+        while (p < end && *p != ',' && !std::isspace(static_cast<unsigned char>(*p)))
+            ++p;
+        stop = p;
+        return true;
+    }
+    const char* p;
+    const char* end;
+};
+
+// Parse up to 'max' numbers of type T from the next tokens.
+// Return the number of parsed values (parsing stops at the first token that is not a number of type T).
+template <typename T>
+int ParseNumbers(LineTokens& tokens, T* vals, int max) {
+    int n = 0;
+    const char* begin;
+    const char* stop;
+    while (n < max) {
+        const char* p = tokens.p;
+        if (!tokens.Next(begin, stop))
+            break;
+        if (!ParseValue(begin, stop, vals[n])) {
+            tokens.p = p;
+            break;
+        }
+        ++n;
+    }
+    return n;
+}
 
-    }  // end .node file
+template <typename T>
+int ParseNumbers(const LineRange& line, T* vals, int max) {
+    LineTokens tokens(line);
+    return ParseNumbers(tokens, vals, max);
+}
 
-    // Load .ele TetGen file
+// Record the first (lowest index) failing line of a parallel loop.
+void RecordError(int line, int code, int& err_line, int& err_code) {
+#pragma omp critical(ChMeshFileLoader_error)
     {
-        bool parse_header = true;
-        bool parse_tet = false;
+        if (line < err_line) {
+            err_line = line;
+            err_code = code;
+        }
+    }
+}
 
-        ifstream fin(filename_ele);
+// Size and last modification time of a source file, used to validate binary caches.
+struct SourceStamp {
+    int64_t size;
+    int64_t mtime;
+};
+
+bool GetSourceStamp(const char* filename, SourceStamp& stamp) {
+    struct stat sb;
+    if (stat(filename, &sb) != 0)
+        return false;
+    stamp.size = static_cast<int64_t>(sb.st_size);
+    stamp.mtime = static_cast<int64_t>(sb.st_mtime);
+    return true;
+}
+
+const char cache_magic[8] = {'C', 'H', 'M', 'E', 'S', 'H', 'C', '1'};
+
+// Binary cache writer: header with source file stamps, followed by flat arrays.
+class CacheWriter {
+  public:
+    CacheWriter(const std::string& filename, const std::vector<SourceStamp>& stamps)
+        : fout(filename, std::ios::binary) {
+        fout.write(cache_magic, sizeof(cache_magic));
+        WriteArray(stamps);
+    }
+    template <typename T>
+    void WriteArray(const std::vector<T>& v) {
+        uint64_t n = v.size();
+        fout.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        if (n)
+            fout.write(reinterpret_cast<const char*>(v.data()), n * sizeof(T));
+    }
+    bool good() const { return fout.good(); }
+
+  private:
+    ofstream fout;
+};
+
+// Binary cache reader. The cache is rejected if any of the source files changed since it was written.
+class CacheReader {
+  public:
+    CacheReader(const std::string& filename, const std::vector<SourceStamp>& stamps)
+        : fin(filename, std::ios::binary | std::ios::ate), valid(false) {
         if (!fin.good())
-            throw ChException("ERROR opening TetGen .node file: " + std::string(filename_node) + "\n");
-
-        int ntets, nnodespertet, nattrs = 0;
-
-        string line;
-        while (getline(fin, line)) {
-            // trims white space from the beginning of the string
-            line.erase(line.begin(),
-                       std::find_if(line.begin(), line.end(), [](unsigned char c) { return !std::isspace(c); }));
-
-            if (line[0] == '#')
-                continue;  // skip comment
-            if (line[0] == 0)
-                continue;  // skip empty lines
-
-            if (parse_header) {
-                stringstream(line) >> ntets >> nnodespertet >> nattrs;
-                if (nnodespertet != 4)
-                    throw ChException("ERROR in TetGen .ele file. Only 4 -nodes per tes supported: \n" + line + "\n");
-                if (nattrs != 0)
-                    throw ChException("ERROR in TetGen .ele file. Only tets with 0 attrs supported: \n" + line + "\n");
-                parse_header = false;
-                parse_tet = true;
-                continue;
-            }
+            return;
+        remaining = static_cast<uint64_t>(fin.tellg());
+        fin.seekg(0, std::ios::beg);
+        char magic[sizeof(cache_magic)];
+        if (remaining < sizeof(magic) || !fin.read(magic, sizeof(magic)) ||
+            std::memcmp(magic, cache_magic, sizeof(magic)) != 0)
+            return;
+        remaining -= sizeof(magic);
+        std::vector<SourceStamp> cached;
+        if (!ReadArray(cached) || cached.size() != stamps.size())
+            return;
+        for (size_t i = 0; i < stamps.size(); i++) {
+            if (cached[i].size != stamps[i].size || cached[i].mtime != stamps[i].mtime)
+                return;
+        }
+        valid = true;
+    }
+    template <typename T>
+    bool ReadArray(std::vector<T>& v) {
+        uint64_t n;
+        if (remaining < sizeof(n) || !fin.read(reinterpret_cast<char*>(&n), sizeof(n)))
+            return false;
+        remaining -= sizeof(n);
+        if (n > remaining / sizeof(T))
+            return false;
+        v.resize(static_cast<size_t>(n));
+        if (n && !fin.read(reinterpret_cast<char*>(v.data()), n * sizeof(T)))
+            return false;
+        remaining -= n * sizeof(T);
+        return true;
+    }
+    bool IsValid() const { return valid; }
+
+  private:
+    ifstream fin;
+    uint64_t remaining;
+    bool valid;
+};
+
+// Raw data of a TetGen mesh: node coordinates (x,y,z per node) and 1-based node IDs (4 per tetrahedron).
+struct TetGenData {
+    std::vector<double> xyz;
+    std::vector<int> tets;
+
+    void Save(CacheWriter& cache) const {
+        cache.WriteArray(xyz);
+        cache.WriteArray(tets);
+    }
+    bool Load(CacheReader& cache) {
+        if (!cache.ReadArray(xyz) || !cache.ReadArray(tets) || xyz.size() % 3 != 0 || tets.size() % 4 != 0)
+            return false;
+        // node IDs are used as indices, so a corrupted cache must not get past this point
+        int nnodes = static_cast<int>(xyz.size() / 3);
+        for (int id : tets) {
+            if (id <= 0 || id > nnodes)
+                return false;
+        }
+        return true;
+    }
+};
+
+void ParseTetGenNodes(const char* filename, TetGenData& data) {
+    std::vector<char> buffer;
+    if (!ReadFileBuffer(filename, buffer))
+        throw ChException("ERROR opening TetGen .node file: " + std::string(filename) + "\n");
+    std::vector<LineRange> lines;
+    SplitLines(buffer, '#', lines);
+    if (lines.empty())
+        return;
+
+    int header[4] = {0, 0, 0, 0};
+    ParseNumbers(lines[0], header, 4);
+    int nnodes = header[0];
+    if (header[1] != 3)
+        throw ChException("ERROR in TetGen .node file. Only 3 dimensional nodes supported: \n" + lines[0].str());
+    if (header[2] != 0)
+        throw ChException("ERROR in TetGen .node file. Only nodes with 0 attrs supported: \n" + lines[0].str());
+    if (header[3] != 0)
+        throw ChException("ERROR in TetGen .node file. Only nodes with 0 markers supported: \n" + lines[0].str());
+
+    int nlines = static_cast<int>(lines.size()) - 1;
+    data.xyz.resize(3 * static_cast<size_t>(nlines));
+
+    int err_line = nlines;
+    int err_code = 0;
+#pragma omp parallel for
+    for (int i = 0; i < nlines; i++) {
+        LineTokens tokens(lines[i + 1]);
+        int idnode = 0;
+        double xyz[4];
+        if (ParseNumbers(tokens, &idnode, 1) != 1 || idnode <= 0 || idnode > nnodes)
+            RecordError(i, 1, err_line, err_code);
+        else if (idnode != i + 1)
+            RecordError(i, 2, err_line, err_code);
+        else if (ParseNumbers(tokens, xyz, 4) != 3)
+            RecordError(i, 3, err_line, err_code);
+        else {
+            data.xyz[3 * i + 0] = xyz[0];
+            data.xyz[3 * i + 1] = xyz[1];
+            data.xyz[3 * i + 2] = xyz[2];
+        }
+    }
 
-            int idtet = 0;
-            int n1, n2, n3, n4;
-
-            if (parse_tet) {
-                stringstream(line) >> idtet >> n1 >> n2 >> n3 >> n4;
-                if (idtet <= 0 || idtet > ntets)
-                    throw ChException("ERROR in TetGen .node file. Tetrahedron ID not in range: \n" + line + "\n");
-                if (n1 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 1st node is out of range: \n" + line + "\n");
-                if (n2 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 2nd node is out of range: \n" + line + "\n");
-                if (n3 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 3rd node is out of range: \n" + line + "\n");
-                if (n4 > totnodes)
-                    throw ChException("ERROR in TetGen .node file, ID of 4th node is out of range: \n" + line + "\n");
-                if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                    auto mel = chrono_types::make_shared<ChElementTetra_4>();
-                    mel->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n1 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n3 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n2 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(nodes_offset + n4 - 1)));
-                    mel->SetMaterial(std::static_pointer_cast<ChContinuumElastic>(my_material));
-                    mesh->AddElement(mel);
-                } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                    auto mel = chrono_types::make_shared<ChElementTetra_4_P>();
-                    mel->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n1 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n3 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n2 - 1)),
-                                  std::dynamic_pointer_cast<ChNodeFEAxyzP>(mesh->GetNode(nodes_offset + n4 - 1)));
-                    mel->SetMaterial(std::static_pointer_cast<ChContinuumPoisson3D>(my_material));
-                    mesh->AddElement(mel);
-                } else
-                    throw ChException("ERROR in TetGen generation. Material type not supported. \n");
-            }
+    if (err_line < nlines) {
+        std::string line = lines[err_line + 1].str();
+        switch (err_code) {
+            case 1:
+                throw ChException("ERROR in TetGen .node file. Node ID not in range: \n" + line + "\n");
+            case 2:
+                throw ChException("ERROR in TetGen .node file. Nodes IDs must be sequential (1 2 3 ..): \n" + line +
+                                  "\n");
+            default:
+                throw ChException("ERROR in TetGen .node file, in parsing x,y,z coordinates of node: \n" + line +
+                                  "\n");
+        }
+    }
+}
 
-        }  // end while
+void ParseTetGenElements(const char* filename, int totnodes, TetGenData& data) {
+    std::vector<char> buffer;
+    if (!ReadFileBuffer(filename, buffer))
+        throw ChException("ERROR opening TetGen .ele file: " + std::string(filename) + "\n");
+    std::vector<LineRange> lines;
+    SplitLines(buffer, '#', lines);
+    if (lines.empty())
+        return;
+
+    int header[3] = {0, 0, 0};
+    ParseNumbers(lines[0], header, 3);
+    int ntets = header[0];
+    if (header[1] != 4)
+        throw ChException("ERROR in TetGen .ele file. Only 4 -nodes per tes supported: \n" + lines[0].str() + "\n");
+    if (header[2] != 0)
+        throw ChException("ERROR in TetGen .ele file. Only tets with 0 attrs supported: \n" + lines[0].str() + "\n");
+
+    int nlines = static_cast<int>(lines.size()) - 1;
+    data.tets.resize(4 * static_cast<size_t>(nlines));
+
+    int err_line = nlines;
+    int err_code = 0;
+#pragma omp parallel for
+    for (int i = 0; i < nlines; i++) {
+        int vals[5];
+        int ntoken = ParseNumbers(lines[i + 1], vals, 5);
+        if (ntoken != 5 || vals[0] <= 0 || vals[0] > ntets) {
+            RecordError(i, 0, err_line, err_code);
+            continue;
+        }
+        for (int in = 0; in < 4; in++) {
+            if (vals[in + 1] <= 0 || vals[in + 1] > totnodes) {
+                RecordError(i, in + 1, err_line, err_code);
+                break;
+            }
+            data.tets[4 * i + in] = vals[in + 1];
+        }
+    }
 
-    }  // end .ele file
+    if (err_line < nlines) {
+        static const char* which[] = {"1st", "2nd", "3rd", "4th"};
+        std::string line = lines[err_line + 1].str();
+        if (err_code == 0)
+            throw ChException("ERROR in TetGen .ele file. Tetrahedron ID not in range: \n" + line + "\n");
+        throw ChException("ERROR in TetGen .ele file, ID of " + std::string(which[err_code - 1]) +
+                          " node is out of range: \n" + line + "\n");
+    }
 }
 
-void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
-                                      const char* filename,
-                                      std::shared_ptr<ChContinuumMaterial> my_material,
-                                      std::map<std::string, std::vector<std::shared_ptr<ChNodeFEAbase>>>& node_sets,
-                                      ChVector<> pos_transform,
-                                      ChMatrix33<> rot_transform,
-                                      bool discard_unused_nodes) {
-    std::map<unsigned int, std::pair<shared_ptr<ChNodeFEAbase>, bool>> parsed_nodes;
-    std::vector<std::shared_ptr<ChNodeFEAbase>>* current_nodeset_vector = nullptr;
+// Raw data of an Abaqus mesh: nodes in file order, 4 corner node IDs per tetrahedron, and node sets.
+struct AbaqusData {
+    std::vector<unsigned int> node_ids;
+    std::vector<double> node_xyz;
+    std::vector<unsigned int> tets;
+    std::vector<std::string> nodeset_names;
+    std::vector<std::vector<unsigned int>> nodeset_nodes;
+
+    void Save(CacheWriter& cache) const {
+        cache.WriteArray(node_ids);
+        cache.WriteArray(node_xyz);
+        cache.WriteArray(tets);
+        std::vector<uint64_t> nsets(1, nodeset_names.size());
+        cache.WriteArray(nsets);
+        for (size_t i = 0; i < nodeset_names.size(); i++) {
+            cache.WriteArray(std::vector<char>(nodeset_names[i].begin(), nodeset_names[i].end()));
+            cache.WriteArray(nodeset_nodes[i]);
+        }
+    }
+    bool Load(CacheReader& cache) {
+        std::vector<uint64_t> nsets;
+        if (!cache.ReadArray(node_ids) || !cache.ReadArray(node_xyz) || !cache.ReadArray(tets) ||
+            !cache.ReadArray(nsets) || nsets.size() != 1)
+            return false;
+        nodeset_names.resize(static_cast<size_t>(nsets[0]));
+        nodeset_nodes.resize(static_cast<size_t>(nsets[0]));
+        for (size_t i = 0; i < nodeset_names.size(); i++) {
+            std::vector<char> name;
+            if (!cache.ReadArray(name) || !cache.ReadArray(nodeset_nodes[i]))
+                return false;
+            nodeset_names[i].assign(name.begin(), name.end());
+        }
+        return true;
+    }
+};
 
+void ParseAbaqusFile(const char* filename, AbaqusData& data) {
     enum eChAbaqusParserSection {
         E_PARSE_UNKNOWN = 0,
         E_PARSE_NODES_XYZ,
@@ -214,32 +474,30 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
         E_PARSE_NODESET
     } e_parse_section = E_PARSE_UNKNOWN;
 
-    ifstream fin(filename);
-    if (fin.good())
+    std::vector<char> buffer;
+    if (ReadFileBuffer(filename, buffer))
         GetLog() << "Parsing Abaqus INP file: " << filename << "\n";
     else
         throw ChException("ERROR opening Abaqus .inp file: " + std::string(filename) + "\n");
 
-    string line;
-    while (getline(fin, line)) {
-        // trims white space from the beginning of the string
-        line.erase(line.begin(),
-                   std::find_if(line.begin(), line.end(), [](unsigned char c) { return !std::isspace(c); }));
-
-        // convert parsed line to uppercase (since string::find is case sensitive and Abaqus INP is not)
-        std::for_each(line.begin(), line.end(), [](char& c) { c = toupper(static_cast<unsigned char>(c)); });
-
-        // skip empty lines
-        if (line[0] == 0)
-            continue;
+    std::vector<LineRange> lines;
+    SplitLines(buffer, 0, lines);
+    int nlines = static_cast<int>(lines.size());
 
+    int iline = 0;
+    while (iline < nlines) {
         // check if the current line opens a new section
-        if (line[0] == '*') {
+        if (*lines[iline].begin == '*') {
+            // convert to uppercase (since string::find is case sensitive and Abaqus INP is not)
+            string line = lines[iline].str();
+            std::for_each(line.begin(), line.end(), [](char& c) { c = toupper(static_cast<unsigned char>(c)); });
+            ++iline;
+
             e_parse_section = E_PARSE_UNKNOWN;
 
             if (line.find("*NODE") == 0) {
                 string::size_type nse = line.find("NSET=");
-                if (nse > 0) {
+                if (nse != string::npos) {
                     string::size_type ncom = line.find(",", nse);
                     string s_node_set = line.substr(nse + 5, ncom - (nse + 5));
                     GetLog() << "| parsing nodes " << s_node_set << "\n";
@@ -249,10 +507,9 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
 
             if (line.find("*ELEMENT") == 0) {
                 string::size_type nty = line.find("TYPE=");
-                if (nty > 0) {
+                if (nty != string::npos) {
                     string::size_type ncom = line.find(",", nty);
                     string s_ele_type = line.substr(nty + 5, ncom - (nty + 5));
-                    e_parse_section = E_PARSE_UNKNOWN;
                     if (s_ele_type == "C3D10") {
                         e_parse_section = E_PARSE_TETS_10;
                     } else if (s_ele_type == "DC3D10") {
@@ -267,7 +524,7 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
                     }
                 }
                 string::size_type nse = line.find("ELSET=");
-                if (nse > 0) {
+                if (nse != string::npos) {
                     string::size_type ncom = line.find(",", nse);
                     string s_ele_set = line.substr(nse + 6, ncom - (nse + 6));
                     GetLog() << "| parsing element set: " << s_ele_set << "\n";
@@ -276,186 +533,297 @@ void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
 
             if (line.find("*NSET") == 0) {
                 string::size_type nse = line.find("NSET=", 5);
-                if (nse > 0) {
-                    string::size_type ncom = line.find(",", nse);
-                    string s_node_set = line.substr(nse + 5, ncom - (nse + 5));
-                    GetLog() << "| parsing nodeset: " << s_node_set << "\n";
-                    auto new_node =
-                        node_sets.insert(std::pair<std::string, std::vector<std::shared_ptr<ChNodeFEAbase>>>(
-                            s_node_set, std::vector<std::shared_ptr<ChNodeFEAbase>>()));
-                    if (new_node.second) {
-                        current_nodeset_vector = &new_node.first->second;
-                    } else
-                        throw ChException("ERROR in .inp file, multiple NSET with same name has been specified\n");
-                }
+                if (nse == string::npos)
+                    throw ChException("ERROR in .inp file, NSET without name: \n" + line + "\n");
+                string::size_type ncom = line.find(",", nse);
+                string s_node_set = line.substr(nse + 5, ncom - (nse + 5));
+                GetLog() << "| parsing nodeset: " << s_node_set << "\n";
+                data.nodeset_names.push_back(s_node_set);
+                data.nodeset_nodes.push_back(std::vector<unsigned int>());
                 e_parse_section = E_PARSE_NODESET;
             }
 
             continue;
         }
 
+        // find the block of data lines in the current section
+        int first = iline;
+        while (iline < nlines && *lines[iline].begin != '*')
+            ++iline;
+        int nblock = iline - first;
+
+        int err_line = nblock;
+        int err_code = 0;
+
         // node parsing
         if (e_parse_section == E_PARSE_NODES_XYZ) {
-            int idnode = 0;
-            double x = -10e30;
-            double y = -10e30;
-            double z = -10e30;
-            double tokenvals[20];
-            int ntoken = 0;
-
-            string token;
-            std::istringstream ss(line);
-            while (getline(ss, token, ',') && ntoken < 20) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
+            size_t offset = data.node_ids.size();
+            data.node_ids.resize(offset + nblock);
+            data.node_xyz.resize(3 * (offset + nblock));
+#pragma omp parallel for
+            for (int i = 0; i < nblock; i++) {
+                LineTokens tokens(lines[first + i]);
+                unsigned int idnode;
+                double xyz[4];
+                if (ParseNumbers(tokens, &idnode, 1) != 1 || ParseNumbers(tokens, xyz, 4) != 3) {
+                    RecordError(i, 0, err_line, err_code);
+                    continue;
+                }
+                data.node_ids[offset + i] = idnode;
+                data.node_xyz[3 * (offset + i) + 0] = xyz[0];
+                data.node_xyz[3 * (offset + i) + 1] = xyz[1];
+                data.node_xyz[3 * (offset + i) + 2] = xyz[2];
             }
-
-            if (ntoken != 4)
-                throw ChException("ERROR in .inp file, nodes require ID and three x y z coords, see line:\n" + line +
-                                  "\n");
-
-            x = tokenvals[1];
-            y = tokenvals[2];
-            z = tokenvals[3];
-            if (x == -10e30 || y == -10e30 || z == -10e30)
-                throw ChException("ERROR in .inp file, in parsing x,y,z coordinates of node: \n" + line + "\n");
-
-            // TODO: is it worth to keep a so specific routine inside this function?
-            // especially considering that is affecting only some types of elements...
-            ChVector<> node_position(x, y, z);
-            node_position = rot_transform * node_position;  // rotate/scale, if needed
-            node_position = pos_transform + node_position;  // move, if needed
-
-            idnode = static_cast<unsigned int>(tokenvals[0]);
-            if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                auto mnode = chrono_types::make_shared<ChNodeFEAxyz>(node_position);
-                mnode->SetIndex(idnode);
-                parsed_nodes[idnode] = std::make_pair(mnode, false);
-                if (!discard_unused_nodes)
-                    mesh->AddNode(mnode);
-            } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                auto mnode = chrono_types::make_shared<ChNodeFEAxyzP>(ChVector<>(x, y, z));
-                mnode->SetIndex(idnode);
-                parsed_nodes[idnode] = std::make_pair(mnode, false);
-                if (!discard_unused_nodes)
-                    mesh->AddNode(mnode);
-            } else
-                throw ChException("ERROR in .inp generation. Material type not supported. \n");
+            if (err_line < nblock)
+                throw ChException("ERROR in .inp file, nodes require ID and three x y z coords, see line:\n" +
+                                  lines[first + err_line].str() + "\n");
         }
 
-        // element parsing
+        // element parsing (only the 4 corner nodes are used, also for 10-node tetrahedrons)
         if (e_parse_section == E_PARSE_TETS_10 || e_parse_section == E_PARSE_TETS_4) {
-            int idelem = 0;
-            unsigned int tokenvals[20];
-            int ntoken = 0;
-
-            string token;
-            std::istringstream ss(line);
-            while (std::getline(ss, token, ',') && ntoken < 20) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
+            int nexpected = (e_parse_section == E_PARSE_TETS_10) ? 11 : 5;
+            size_t offset = data.tets.size();
+            data.tets.resize(offset + 4 * nblock);
+#pragma omp parallel for
+            for (int i = 0; i < nblock; i++) {
+                unsigned int ids[20];
+                int ntoken = ParseNumbers(lines[first + i], ids, 20);
+                if (ntoken != nexpected) {
+                    RecordError(i, 0, err_line, err_code);
+                    continue;
+                }
+                for (int in = 0; in < 4; ++in)
+                    data.tets[offset + 4 * i + in] = ids[in + 1];
             }
-
-            if (e_parse_section == E_PARSE_TETS_10) {
-                if (ntoken != 11)
+            if (err_line < nblock) {
+                if (e_parse_section == E_PARSE_TETS_10)
                     throw ChException("ERROR in .inp file, tetrahedrons require ID and 10 node IDs, see line:\n" +
-                                      line + "\n");
-                // TODO: 'idelem' might be stored in an index in ChElementBase in order to provide consistency with the
-                // INP file
-                idelem = (int)tokenvals[0];
-
-                for (int in = 0; in < 10; ++in)
-                    if (tokenvals[in + 1] == -10e30)
-                        throw ChException("ERROR in in .inp file, in parsing IDs of tetrahedron: \n" + line + "\n");
-            } else if (e_parse_section == E_PARSE_TETS_4) {
-                if (ntoken != 5)
-                    throw ChException("ERROR in .inp file, tetrahedrons require ID and 4 node IDs, see line:\n" + line +
-                                      "\n");
-
-                // TODO: 'idelem' might be stored in an index in ChElementBase in order to provide consistency with the
-                // INP file
-                idelem = (int)tokenvals[0];
+                                      lines[first + err_line].str() + "\n");
+                throw ChException("ERROR in .inp file, tetrahedrons require ID and 4 node IDs, see line:\n" +
+                                  lines[first + err_line].str() + "\n");
+            }
+        }
 
-                for (int in = 0; in < 4; ++in)
-                    if (tokenvals[in + 1] == -10e30)
-                        throw ChException("ERROR in in .inp file, in parsing IDs of tetrahedron: \n" + line + "\n");
+        // parsing nodesets
+        if (e_parse_section == E_PARSE_NODESET) {
+            std::vector<unsigned int>& nodeset = data.nodeset_nodes.back();
+            for (int i = first; i < iline; i++) {
+                int ids[20];  // strictly speaking, the maximum is 16 nodes for each line
+                int ntoken = ParseNumbers(lines[i], ids, 20);
+                for (int node_sel = 0; node_sel < ntoken; ++node_sel) {
+                    // Abaqus node IDs are positive; a zero or negative ID in a node set is an error (not skipped)
+                    if (ids[node_sel] <= 0)
+                        throw ChException("ERROR in .inp file, non-positive node ID in NSET: " +
+                                          std::to_string(ids[node_sel]));
+                    nodeset.push_back(static_cast<unsigned int>(ids[node_sel]));
+                }
             }
+        }
+    }
+}
 
-            if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material) ||
-                std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                std::array<std::shared_ptr<ChNodeFEAbase>, 4> element_nodes;
-                for (auto node_sel = 0; node_sel < 4; ++node_sel) {
-                    // check if the nodes required by the current element exist
-                    std::pair<shared_ptr<ChNodeFEAbase>, bool>& node_found =
-                        parsed_nodes.at(static_cast<unsigned int>(tokenvals[node_sel + 1]));
+}  // end anonymous namespace
 
-                    element_nodes[node_sel] = node_found.first;
-                    node_found.second = true;
-                }
+void ChMeshFileLoader::FromTetGenFile(std::shared_ptr<ChMesh> mesh,
+                                      const char* filename_node,
+                                      const char* filename_ele,
+                                      std::shared_ptr<ChContinuumMaterial> my_material,
+                                      ChVector<> pos_transform,
+                                      ChMatrix33<> rot_transform,
+                                      bool use_cache) {
+    bool elastic = std::dynamic_pointer_cast<ChContinuumElastic>(my_material) != nullptr;
+    bool poisson = std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material) != nullptr;
+    if (!elastic && !poisson)
+        throw ChException("ERROR in TetGen generation. Material type not supported. \n");
+
+    // Obtain the raw mesh data, from the binary cache if up to date, otherwise from the TetGen files
+    TetGenData data;
+    std::string cache_file = std::string(filename_ele) + ".chcache";
+    std::vector<SourceStamp> stamps(2);
+    bool cached = false;
+    if (use_cache && GetSourceStamp(filename_node, stamps[0]) && GetSourceStamp(filename_ele, stamps[1])) {
+        CacheReader cache(cache_file, stamps);
+        cached = cache.IsValid() && data.Load(cache);
+    }
+    if (!cached) {
+        ParseTetGenNodes(filename_node, data);
+        ParseTetGenElements(filename_ele, static_cast<int>(data.xyz.size() / 3), data);
+        if (use_cache) {
+            CacheWriter cache(cache_file, stamps);
+            data.Save(cache);
+            if (!cache.good())
+                GetLog() << "Warning: cannot write mesh cache file " << cache_file << "\n";
+        }
+    }
 
-                if (std::dynamic_pointer_cast<ChContinuumElastic>(my_material)) {
-                    auto mel = chrono_types::make_shared<ChElementTetra_4>();
-                    mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyz>(element_nodes[3]),
-                                  std::static_pointer_cast<ChNodeFEAxyz>(element_nodes[1]),
-                                  std::static_pointer_cast<ChNodeFEAxyz>(element_nodes[2]),
-                                  std::static_pointer_cast<ChNodeFEAxyz>(element_nodes[0]));
-                    mel->SetMaterial(std::static_pointer_cast<ChContinuumElastic>(my_material));
-                    mesh->AddElement(mel);
-
-                } else if (std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material)) {
-                    auto mel = chrono_types::make_shared<ChElementTetra_4_P>();
-                    mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyzP>(element_nodes[0]),
-                                  std::static_pointer_cast<ChNodeFEAxyzP>(element_nodes[1]),
-                                  std::static_pointer_cast<ChNodeFEAxyzP>(element_nodes[2]),
-                                  std::static_pointer_cast<ChNodeFEAxyzP>(element_nodes[3]));
-                    mel->SetMaterial(std::static_pointer_cast<ChContinuumPoisson3D>(my_material));
-                    mesh->AddElement(mel);
-                }
+    // Create all nodes
+    int nnodes = static_cast<int>(data.xyz.size() / 3);
+    std::vector<std::shared_ptr<ChNodeFEAbase>> nodes(nnodes);
+#pragma omp parallel for
+    for (int i = 0; i < nnodes; i++) {
+        ChVector<> node_position(data.xyz[3 * i + 0], data.xyz[3 * i + 1], data.xyz[3 * i + 2]);
+        node_position = rot_transform * node_position;  // rotate/scale, if needed
+        node_position = pos_transform + node_position;  // move, if needed
+        if (elastic)
+            nodes[i] = chrono_types::make_shared<ChNodeFEAxyz>(node_position);
+        else
+            nodes[i] = chrono_types::make_shared<ChNodeFEAxyzP>(node_position);
+    }
 
-            } else
-                throw ChException("ERROR in .inp generation. Material type not supported.\n");
+    // Create all tetrahedrons
+    int ntets = static_cast<int>(data.tets.size() / 4);
+    std::vector<std::shared_ptr<ChElementBase>> elements(ntets);
+#pragma omp parallel for
+    for (int i = 0; i < ntets; i++) {
+        const auto& n1 = nodes[data.tets[4 * i + 0] - 1];
+        const auto& n2 = nodes[data.tets[4 * i + 1] - 1];
+        const auto& n3 = nodes[data.tets[4 * i + 2] - 1];
+        const auto& n4 = nodes[data.tets[4 * i + 3] - 1];
+        if (elastic) {
+            auto mel = chrono_types::make_shared<ChElementTetra_4>();
+            mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyz>(n1), std::static_pointer_cast<ChNodeFEAxyz>(n3),
+                          std::static_pointer_cast<ChNodeFEAxyz>(n2), std::static_pointer_cast<ChNodeFEAxyz>(n4));
+            mel->SetMaterial(std::static_pointer_cast<ChContinuumElastic>(my_material));
+            elements[i] = mel;
+        } else {
+            auto mel = chrono_types::make_shared<ChElementTetra_4_P>();
+            mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyzP>(n1), std::static_pointer_cast<ChNodeFEAxyzP>(n3),
+                          std::static_pointer_cast<ChNodeFEAxyzP>(n2), std::static_pointer_cast<ChNodeFEAxyzP>(n4));
+            mel->SetMaterial(std::static_pointer_cast<ChContinuumPoisson3D>(my_material));
+            elements[i] = mel;
         }
+    }
 
-        // parsing nodesets
-        if (e_parse_section == E_PARSE_NODESET) {
-            unsigned int tokenvals[20];  // strictly speaking, the maximum is 16 nodes for each line
-            int ntoken = 0;
-
-            string token;
-            std::istringstream ss(line);
-            while (std::getline(ss, token, ',') && ntoken < 20) {
-                std::istringstream stoken(token);
-                stoken >> tokenvals[ntoken];
-                ++ntoken;
-            }
+    mesh->AddNodes(nodes);
+    mesh->AddElements(elements);
+}
 
-            for (auto node_sel = 0; node_sel < ntoken; ++node_sel) {
-                auto idnode = static_cast<int>(tokenvals[node_sel]);
-                if (idnode > 0) {
-                    // check if the nodeset is asking for an existing node
-                    std::pair<shared_ptr<ChNodeFEAbase>, bool>& node_found =
-                        parsed_nodes.at(static_cast<unsigned int>(tokenvals[node_sel]));
+void ChMeshFileLoader::FromAbaqusFile(std::shared_ptr<ChMesh> mesh,
+                                      const char* filename,
+                                      std::shared_ptr<ChContinuumMaterial> my_material,
+                                      std::map<std::string, std::vector<std::shared_ptr<ChNodeFEAbase>>>& node_sets,
+                                      ChVector<> pos_transform,
+                                      ChMatrix33<> rot_transform,
+                                      bool discard_unused_nodes,
+                                      bool use_cache) {
+    bool elastic = std::dynamic_pointer_cast<ChContinuumElastic>(my_material) != nullptr;
+    bool poisson = std::dynamic_pointer_cast<ChContinuumPoisson3D>(my_material) != nullptr;
+    if (!elastic && !poisson)
+        throw ChException("ERROR in .inp generation. Material type not supported. \n");
+
+    // Obtain the raw mesh data, from the binary cache if up to date, otherwise from the .inp file
+    AbaqusData data;
+    std::string cache_file = std::string(filename) + ".chcache";
+    std::vector<SourceStamp> stamps(1);
+    bool cached = false;
+    if (use_cache && GetSourceStamp(filename, stamps[0])) {
+        CacheReader cache(cache_file, stamps);
+        cached = cache.IsValid() && data.Load(cache);
+    }
+    if (!cached) {
+        ParseAbaqusFile(filename, data);
+        if (use_cache) {
+            CacheWriter cache(cache_file, stamps);
+            data.Save(cache);
+            if (!cache.good())
+                GetLog() << "Warning: cannot write mesh cache file " << cache_file << "\n";
+        }
+    }
+
+    // Map Abaqus node IDs to positions in the parsed node list (later definitions override earlier ones)
+    int nnodes = static_cast<int>(data.node_ids.size());
+    std::unordered_map<unsigned int, int> node_index;
+    node_index.reserve(nnodes);
+    for (int i = 0; i < nnodes; i++)
+        node_index[data.node_ids[i]] = i;
+
+    auto find_node = [&node_index](unsigned int id) -> int {
+        auto it = node_index.find(id);
+        if (it == node_index.end())
+            throw ChException("ERROR in .inp file, reference to undefined node ID: " + std::to_string(id) + "\n");
+        return it->second;
+    };
+
+    // Create all nodes
+    std::vector<std::shared_ptr<ChNodeFEAbase>> nodes(nnodes);
+#pragma omp parallel for
+    for (int i = 0; i < nnodes; i++) {
+        ChVector<> node_position(data.node_xyz[3 * i + 0], data.node_xyz[3 * i + 1], data.node_xyz[3 * i + 2]);
+        if (elastic) {
+            node_position = rot_transform * node_position;  // rotate/scale, if needed
+            node_position = pos_transform + node_position;  // move, if needed
+            nodes[i] = chrono_types::make_shared<ChNodeFEAxyz>(node_position);
+        } else {
+            nodes[i] = chrono_types::make_shared<ChNodeFEAxyzP>(node_position);
+        }
+    }
 
-                    current_nodeset_vector->push_back(node_found.first);
-                    // flag the node to be saved later into the mesh
-                    node_found.second = true;
+    // Resolve element connectivity and flag used nodes
+    int ntets = static_cast<int>(data.tets.size() / 4);
+    std::vector<int> tet_nodes(data.tets.size());
+    std::vector<char> used(nnodes, 0);
+    for (size_t i = 0; i < data.tets.size(); i++) {
+        tet_nodes[i] = find_node(data.tets[i]);
+        used[tet_nodes[i]] = 1;
+    }
 
-                } else
-                    throw ChException("ERROR in .inp file, negative node ID: " + std::to_string(tokenvals[node_sel]));
-            }
+    // Create all tetrahedrons
+    std::vector<std::shared_ptr<ChElementBase>> elements(ntets);
+#pragma omp parallel for
+    for (int i = 0; i < ntets; i++) {
+        const int* tn = &tet_nodes[4 * i];
+        if (elastic) {
+            auto mel = chrono_types::make_shared<ChElementTetra_4>();
+            mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyz>(nodes[tn[3]]),
+                          std::static_pointer_cast<ChNodeFEAxyz>(nodes[tn[1]]),
+                          std::static_pointer_cast<ChNodeFEAxyz>(nodes[tn[2]]),
+                          std::static_pointer_cast<ChNodeFEAxyz>(nodes[tn[0]]));
+            mel->SetMaterial(std::static_pointer_cast<ChContinuumElastic>(my_material));
+            elements[i] = mel;
+        } else {
+            auto mel = chrono_types::make_shared<ChElementTetra_4_P>();
+            mel->SetNodes(std::static_pointer_cast<ChNodeFEAxyzP>(nodes[tn[0]]),
+                          std::static_pointer_cast<ChNodeFEAxyzP>(nodes[tn[1]]),
+                          std::static_pointer_cast<ChNodeFEAxyzP>(nodes[tn[2]]),
+                          std::static_pointer_cast<ChNodeFEAxyzP>(nodes[tn[3]]));
+            mel->SetMaterial(std::static_pointer_cast<ChContinuumPoisson3D>(my_material));
+            elements[i] = mel;
         }
+    }
 
-    }  // end while
+    // Fill the node sets
+    for (size_t is = 0; is < data.nodeset_names.size(); is++) {
+        auto new_set = node_sets.insert(std::pair<std::string, std::vector<std::shared_ptr<ChNodeFEAbase>>>(
+            data.nodeset_names[is], std::vector<std::shared_ptr<ChNodeFEAbase>>()));
+        if (!new_set.second)
+            throw ChException("ERROR in .inp file, multiple NSET with same name has been specified\n");
+        auto& nodeset = new_set.first->second;
+        nodeset.reserve(data.nodeset_nodes[is].size());
+        for (auto id : data.nodeset_nodes[is]) {
+            int in = find_node(id);
+            nodeset.push_back(nodes[in]);
+            used[in] = 1;
+        }
+    }
 
-    // only used nodes have been saved in 'parsed_nodes_used' and are now inserted in the mesh node list
+    // If requested, only nodes used by elements or node sets are inserted in the mesh, sorted by ID
     if (discard_unused_nodes) {
-        for (auto node_it = parsed_nodes.begin(); node_it != parsed_nodes.end(); ++node_it) {
-            if (node_it->second.second)
-                mesh->AddNode(node_it->second.first);
+        std::vector<int> order;
+        order.reserve(nnodes);
+        for (int i = 0; i < nnodes; i++) {
+            if (used[i])
+                order.push_back(i);
         }
+        std::sort(order.begin(), order.end(),
+                  [&data](int a, int b) { return data.node_ids[a] < data.node_ids[b]; });
+        std::vector<std::shared_ptr<ChNodeFEAbase>> used_nodes(order.size());
+        for (size_t i = 0; i < order.size(); i++)
+            used_nodes[i] = nodes[order[i]];
+        mesh->AddNodes(used_nodes);
+    } else {
+        mesh->AddNodes(nodes);
     }
+    mesh->AddElements(elements);
 }
 
 void ChMeshFileLoader::ANCFShellFromGMFFile(std::shared_ptr<ChMesh> mesh,
@@ -46,16 +46,23 @@ class ChApi ChMeshFileLoader {
     /// elements.
     /// If you pass a material inherited by ChContinuumPoisson3D, nodes with scalar field are used (ex. thermal,
     /// electrostatics, etc)
+    /// If use_cache is true, the parsed data is saved in a binary file (filename_ele + ".chcache") and later loads
+    /// read it directly, as long as the .node and .ele files are unchanged (same size and modification time).
     static void FromTetGenFile(
         std::shared_ptr<ChMesh> mesh,                      ///< destination mesh
         const char* filename_node,                         ///< name of the .node file
         const char* filename_ele,                          ///< name of the .ele  file
         std::shared_ptr<ChContinuumMaterial> my_material,  ///< material for the created tetahedrons
         ChVector<> pos_transform = VNULL,                  ///< optional displacement of imported mesh
-        ChMatrix33<> rot_transform = ChMatrix33<>(1)       ///< optional rotation/scaling of imported mesh
+        ChMatrix33<> rot_transform = ChMatrix33<>(1),      ///< optional rotation/scaling of imported mesh
+        bool use_cache = false                             ///< if true, use (and create) a binary cache file
     );
 
     /// Load tetrahedrons, if any, saved in a .inp file for Abaqus.
+    /// Node IDs listed in *NSET sections must be positive and refer to nodes defined in *NODE sections; otherwise a
+    /// ChException is thrown (zero or negative IDs are rejected, not skipped).
+    /// If use_cache is true, the parsed data is saved in a binary file (filename + ".chcache") and later loads
+    /// read it directly, as long as the .inp file is unchanged (same size and modification time).
     static void FromAbaqusFile(
         std::shared_ptr<ChMesh> mesh,                      ///< destination mesh
         const char* filename,                              ///< input file name
@@ -65,7 +72,8 @@ class ChApi ChMeshFileLoader {
         ChVector<> pos_transform = VNULL,              ///< optional displacement of imported mesh
         ChMatrix33<> rot_transform = ChMatrix33<>(1),  ///< optional rotation/scaling of imported mesh
         bool discard_unused_nodes =
-            true  ///< if true, Abaqus nodes that are not used in elements or sets are not imported in C::E
+            true,  ///< if true, Abaqus nodes that are not used in elements or sets are not imported in C::E
+        bool use_cache = false  ///< if true, use (and create) a binary cache file
     );
 
     static void ANCFShellFromGMFFile(
@@ -0,0 +1,194 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Multirate integration of FEA meshes, subcycled with a smaller step than the
+// system they are coupled to.
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/fea/ChSubcycledMesh.h"
+#include "chrono/solver/ChConstraintThree.h"
+#include "chrono/solver/ChConstraintTwo.h"
+
+namespace chrono {
+namespace fea {
+
+ChSubcycledMesh::ChSubcycledMesh(std::shared_ptr<ChSystem> subsystem)
+    : subsystem(subsystem), substep(1e-4), num_substeps(0) {
+    // The proxies drive the mesh through the constraint violation, which must not be clamped
+    subsystem->SetMaxPenetrationRecoverySpeed(1e30);
+}
+
+ChSubcycledMesh::ChSubcycledMesh(const ChSubcycledMesh& other) : ChPhysicsItem(other) {
+    subsystem = other.subsystem;
+    interfaces = other.interfaces;
+    substep = other.substep;
+    num_substeps = other.num_substeps;
+}
+
+std::shared_ptr<ChBody> ChSubcycledMesh::AddInterfaceBody(std::shared_ptr<ChBody> body) {
+    auto proxy = std::shared_ptr<ChBody>(subsystem->NewBody());
+    proxy->SetBodyFixed(true);
+    proxy->SetCoord(body->GetCoord());
+    proxy->SetPos_dt(body->GetPos_dt());
+    proxy->SetWvel_loc(body->GetWvel_loc());
+    subsystem->AddBody(proxy);
+
+    Interface ifc;
+    ifc.body = body;
+    ifc.proxy = proxy;
+    ifc.state = {body->GetPos(), body->GetRot(), body->GetPos_dt(), body->GetWvel_loc()};
+    ifc.force = VNULL;
+    ifc.torque = VNULL;
+    interfaces.push_back(ifc);
+
+    if (system)
+        subsystem->SetChTime(system->GetChTime());
+
+    return proxy;
+}
+
+void ChSubcycledMesh::Synchronize() {
+    for (auto& ifc : interfaces) {
+        auto& body = ifc.body;
+        ifc.state = {body->GetPos(), body->GetRot(), body->GetPos_dt(), body->GetWvel_loc()};
+        ifc.proxy->SetCoord(body->GetCoord());
+        ifc.proxy->SetPos_dt(body->GetPos_dt());
+        ifc.proxy->SetWvel_loc(body->GetWvel_loc());
+        ifc.force = VNULL;
+        ifc.torque = VNULL;
+    }
+    if (system)
+        subsystem->SetChTime(system->GetChTime());
+}
+
+void ChSubcycledMesh::Advance(double dt) {
+    if (dt <= 0)
+        return;
+
+    timer_subcycle.start();
+
+    double H = dt;
+    num_substeps = std::max(1, static_cast<int>(std::ceil(H / substep - 1e-6)));
+    double h = H / num_substeps;
+
+    // Current states of the main bodies and relative rotations over the step
+    std::vector<BodyState> new_states(interfaces.size());
+    std::vector<ChVector<>> rotv(interfaces.size());
+    for (size_t i = 0; i < interfaces.size(); i++) {
+        auto& body = interfaces[i].body;
+        new_states[i] = {body->GetPos(), body->GetRot(), body->GetPos_dt(), body->GetWvel_loc()};
+        rotv[i] = (interfaces[i].state.rot.GetConjugate() * new_states[i].rot).Q_to_Rotv();
+        interfaces[i].force = VNULL;
+        interfaces[i].torque = VNULL;
+    }
+
+    for (int k = 0; k < num_substeps; k++) {
+        // Move the proxies to the main body configuration at the end of the subcycle (cubic Hermite interpolation of
+        // positions, spherical interpolation of rotations), so that the constraints on the mesh nodes are satisfied
+        // at the end of the subcycle.
+        double s = static_cast<double>(k + 1) / num_substeps;
+        double s2 = s * s;
+        double s3 = s2 * s;
+        for (size_t i = 0; i < interfaces.size(); i++) {
+            const BodyState& s0 = interfaces[i].state;
+            const BodyState& s1 = new_states[i];
+            ChVector<> pos = (2 * s3 - 3 * s2 + 1) * s0.pos + (s3 - 2 * s2 + s) * H * s0.pos_dt +
+                             (-2 * s3 + 3 * s2) * s1.pos + (s3 - s2) * H * s1.pos_dt;
+            ChVector<> pos_dt = ((6 * s2 - 6 * s) * s0.pos + (3 * s2 - 4 * s + 1) * H * s0.pos_dt +
+                                 (-6 * s2 + 6 * s) * s1.pos + (3 * s2 - 2 * s) * H * s1.pos_dt) *
+                                (1 / H);
+            ChQuaternion<> drot;
+            drot.Q_from_Rotv(rotv[i] * s);
+            auto& proxy = interfaces[i].proxy;
+            proxy->SetPos(pos);
+            proxy->SetRot(s0.rot * drot);
+            proxy->SetPos_dt(pos_dt);
+            proxy->SetWvel_loc((1 - s) * s0.wvel + s * s1.wvel);
+        }
+
+        subsystem->DoStepDynamics(h);
+
+        AccumulateReactions(1.0 / num_substeps);
+    }
+
+    for (size_t i = 0; i < interfaces.size(); i++)
+        interfaces[i].state = new_states[i];
+
+    if (system)
+        subsystem->SetChTime(system->GetChTime());
+
+    timer_subcycle.stop();
+}
+
+void ChSubcycledMesh::AccumulateReactions(double factor) {
+    // Load the reactions of the last step in the constraints of the descriptor
+    int nc = subsystem->GetNconstr();
+    int nv = subsystem->GetNcoords_w();
+    if (nc == 0)
+        return;
+    L.setZero(nc);
+    subsystem->IntStateGatherReactions(0, L);
+    ChStateDelta v;
+    v.setZero(nv, subsystem.get());
+    ChVectorDynamic<> R = ChVectorDynamic<>::Zero(nv);
+    ChVectorDynamic<> Qc = ChVectorDynamic<>::Zero(nc);
+    subsystem->IntToDescriptor(0, v, R, 0, L, Qc);
+
+    // The proxies are fixed, so their variables are not part of the system: the reactions Cq'*l acting on them are
+    // evaluated from the Jacobian blocks of the constraints that refer to their variables.
+    auto add_reaction = [this, factor](ChVariables* var, ChRowVectorRef Cq, double l) {
+        for (auto& ifc : interfaces) {
+            if (&ifc.proxy->Variables() == var) {
+                ifc.force += factor * l * ChVector<>(Cq(0), Cq(1), Cq(2));
+                ifc.torque += factor * l * ChVector<>(Cq(3), Cq(4), Cq(5));
+                return;
+            }
+        }
+    };
+
+    for (auto constr : subsystem->GetSystemDescriptor()->GetConstraintsList()) {
+        if (!constr->IsActive() || constr->Get_l_i() == 0)
+            continue;
+        double l = constr->Get_l_i();
+        if (auto c2 = dynamic_cast<ChConstraintTwo*>(constr)) {
+            add_reaction(c2->GetVariables_a(), c2->Get_Cq_a(), l);
+            add_reaction(c2->GetVariables_b(), c2->Get_Cq_b(), l);
+        } else if (auto c3 = dynamic_cast<ChConstraintThree*>(constr)) {
+            add_reaction(c3->GetVariables_a(), c3->Get_Cq_a(), l);
+            add_reaction(c3->GetVariables_b(), c3->Get_Cq_b(), l);
+            add_reaction(c3->GetVariables_c(), c3->Get_Cq_c(), l);
+        }
+    }
+}
+
+void ChSubcycledMesh::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
+    for (auto& ifc : interfaces) {
+        if (!ifc.body->Variables().IsActive())
+            continue;
+        R.segment(ifc.body->Variables().GetOffset() + 0, 3) += c * ifc.force.eigen();
+        R.segment(ifc.body->Variables().GetOffset() + 3, 3) += c * ifc.torque.eigen();
+    }
+}
+
+void ChSubcycledMesh::VariablesFbLoadForces(double factor) {
+    for (auto& ifc : interfaces) {
+        if (!ifc.body->Variables().IsActive())
+            continue;
+        ifc.body->Variables().Get_fb().segment(0, 3) += factor * ifc.force.eigen();
+        ifc.body->Variables().Get_fb().segment(3, 3) += factor * ifc.torque.eigen();
+    }
+}
+
+}  // end namespace fea
+}  // end namespace chrono
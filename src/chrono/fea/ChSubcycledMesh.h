@@ -0,0 +1,146 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Multirate integration of FEA meshes, subcycled with a smaller step than the
+// system they are coupled to.
+// =============================================================================
+
+#ifndef CHSUBCYCLEDMESH_H
+#define CHSUBCYCLEDMESH_H
+
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/fea/ChMesh.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup chrono_fea
+/// @{
+
+/// Physics item for multirate integration of stiff FEA meshes.
+/// The meshes are not added to the main ChSystem; instead they live in a separate subsystem (with its own
+/// timestepper and solver) that is advanced with a smaller step, several times per step of the main system.
+/// Coupling with the main system happens through interface bodies: for each body of the main system declared
+/// with AddInterfaceBody(), a proxy body is created in the subsystem and the mesh nodes are connected to the
+/// proxy (e.g. with ChLinkPointFrame). The proxies are fixed bodies of the subsystem whose motion is imposed: at each
+/// subcycle they are moved to the interpolated configuration of the main body (between its last two states), so they
+/// add neither mass nor gravity to the coupled system. The mesh follows the proxies through the position error of the
+/// constraints, so the maximum recovery speed of the subsystem (ChSystem::SetMaxPenetrationRecoverySpeed) limits the
+/// speed of the interface; it is therefore disabled (set to a very large value) when the item is created.
+/// The constraint reactions acting on the proxies, averaged over the subcycles, are applied to the main bodies during
+/// the following step (explicit, one-step lagged coupling). The coupling is accurate when the meshes are light with
+/// respect to the interface bodies.
+/// The subsystem must be advanced explicitly, by calling Advance() after each step of the main system:
+/// <pre>
+///   sys.DoStepDynamics(H);
+///   subcycled_mesh->Advance(H);
+/// </pre>
+class ChApi ChSubcycledMesh : public ChPhysicsItem {
+  public:
+    /// Create the multirate item. The provided system hosts the subcycled meshes.
+    /// The maximum recovery speed of the subsystem is set to a very large value (see class description).
+    ChSubcycledMesh(std::shared_ptr<ChSystem> subsystem);
+    ChSubcycledMesh(const ChSubcycledMesh& other);
+    ~ChSubcycledMesh() {}
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChSubcycledMesh* Clone() const override { return new ChSubcycledMesh(*this); }
+
+    /// Access the subsystem (e.g. to set its timestepper, solver, or to add further items).
+    ChSystem* GetSubsystem() const { return subsystem.get(); }
+
+    /// Add a mesh to the subsystem.
+    void AddMesh(std::shared_ptr<ChMesh> mesh) { subsystem->Add(mesh); }
+
+    /// Declare a body of the main system as interface with the subcycled meshes.
+    /// Return the proxy body created in the subsystem, to which mesh nodes are to be connected.
+    /// The proxy is a fixed body, placed at the current configuration of the main body and later driven by it.
+    std::shared_ptr<ChBody> AddInterfaceBody(std::shared_ptr<ChBody> body);
+
+    /// Set the (maximum) step size used for the subcycles.
+    /// The step of the main system is split in an integer number of equal subcycles not larger than this value.
+    void SetSubstep(double h) { substep = h; }
+
+    /// Get the (maximum) step size used for the subcycles.
+    double GetSubstep() const { return substep; }
+
+    /// Get the number of subcycles taken in the last call to Advance().
+    int GetNumSubstepsLast() const { return num_substeps; }
+
+    /// Get the force (absolute frame) applied to the N-th interface body of the main system.
+    const ChVector<>& GetInterfaceForce(unsigned int n) const { return interfaces[n].force; }
+
+    /// Get the torque (body local frame) applied to the N-th interface body of the main system.
+    const ChVector<>& GetInterfaceTorque(unsigned int n) const { return interfaces[n].torque; }
+
+    /// Get the cumulative time spent in subcycling.
+    double GetTimerSubcycle() const { return timer_subcycle(); }
+
+    /// Record the current state of the interface bodies as the starting point of the next call to Advance(), move the
+    /// proxies there, and set the time of the subsystem to the time of the main system.
+    /// This is done automatically when an interface body is added; call it again if the interface bodies or the main
+    /// system time are changed afterwards (e.g. after an assembly analysis).
+    void Synchronize();
+
+    /// Advance the subsystem by the step 'dt' just taken by the main system.
+    /// The proxies are driven from the previously recorded states of the interface bodies to their current states,
+    /// with an integer number of subcycles not larger than the substep. The averaged reactions on the proxies are then
+    /// applied to the main system in its next step.
+    void Advance(double dt);
+
+    /// Apply the averaged interface reactions to the interface bodies of the main system.
+    virtual void IntLoadResidual_F(const unsigned int off,  ///< offset in R residual
+                                   ChVectorDynamic<>& R,    ///< result: the R residual, R += c*F
+                                   const double c           ///< a scaling factor
+                                   ) override;
+
+    /// Same as IntLoadResidual_F, for the solver descriptor interface.
+    virtual void VariablesFbLoadForces(double factor = 1) override;
+
+  private:
+    /// Body state recorded at a step of the main system.
+    struct BodyState {
+        ChVector<> pos;
+        ChQuaternion<> rot;
+        ChVector<> pos_dt;
+        ChVector<> wvel;  ///< angular velocity, in local frame
+    };
+
+    /// Data for an interface body.
+    struct Interface {
+        std::shared_ptr<ChBody> body;   ///< body of the main system
+        std::shared_ptr<ChBody> proxy;  ///< proxy body in the subsystem
+        BodyState state;                ///< main body state at the last synchronization
+        ChVector<> force;               ///< averaged reaction force on the proxy (absolute frame)
+        ChVector<> torque;              ///< averaged reaction torque on the proxy (local frame)
+    };
+
+    /// Accumulate the reactions of the subsystem constraints acting on the proxies, scaled by 'factor'.
+    void AccumulateReactions(double factor);
+
+    std::shared_ptr<ChSystem> subsystem;
+    std::vector<Interface> interfaces;
+    double substep;
+    int num_substeps;
+    ChVectorDynamic<> L;
+    ChTimer<> timer_subcycle;
+};
+
+/// @} chrono_fea
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
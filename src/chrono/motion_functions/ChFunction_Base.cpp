@@ -39,6 +39,24 @@ double ChFunction::Get_y_dN(double x, int derivate) const {
     }
 }
 
+void ChFunction::Get_y_batch(const ChVectorDynamic<>& x, ChVectorDynamic<>& y, int derivate) const {
+    y.resize(x.size());
+    switch (derivate) {
+        case 1:
+            for (int i = 0; i < x.size(); i++)
+                y(i) = Get_y_dx(x(i));
+            break;
+        case 2:
+            for (int i = 0; i < x.size(); i++)
+                y(i) = Get_y_dxdx(x(i));
+            break;
+        default:
+            for (int i = 0; i < x.size(); i++)
+                y(i) = Get_y(x(i));
+            break;
+    }
+}
+
 void ChFunction::Estimate_y_range(double xmin, double xmax, double& ymin, double& ymax, int derivate) const {
     ymin = 10000;
     ymax = -10000;
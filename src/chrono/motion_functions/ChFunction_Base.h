@@ -66,7 +66,8 @@ class ChApi ChFunction {
         FUNCT_SEQUENCE,
         FUNCT_SIGMA,
         FUNCT_SINE,
-        FUNCT_LAMBDA
+        FUNCT_LAMBDA,
+        FUNCT_COMPILED
     };
 
   public:
@@ -119,6 +120,11 @@ class ChApi ChFunction {
     /// Note that only order = 0, 1, or 2 is supported.
     virtual double Get_y_dN(double x, int derivate) const;
 
+    /// Evaluate the function (derivate = 0) or its derivative of specified order (1 or 2) at all the values in x.
+    /// The vector y is resized as needed. Evaluating at increasing values of x is usually faster (e.g. for a
+    /// ChFunction_Recorder).
+    virtual void Get_y_batch(const ChVectorDynamic<>& x, ChVectorDynamic<>& y, int derivate = 0) const;
+
     /// Update could be implemented by children classes, ex. to launch callbacks
     virtual void Update(const double x) {}
 
@@ -0,0 +1,260 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/motion_functions/ChFunction_Compiled.h"
+#include "chrono/motion_functions/ChFunction_Const.h"
+#include "chrono/motion_functions/ChFunction_Ramp.h"
+#include "chrono/motion_functions/ChFunction_Sine.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChFunction_Compiled)
+
+ChFunction_Compiled::ChFunction_Compiled() {
+    Set_function(chrono_types::make_shared<ChFunction_Const>());
+}
+
+ChFunction_Compiled::ChFunction_Compiled(std::shared_ptr<ChFunction> fun) {
+    Set_function(fun);
+}
+
+ChFunction_Compiled::ChFunction_Compiled(const ChFunction_Compiled& other) {
+    Set_function(std::shared_ptr<ChFunction>(other.m_function->Clone()));
+}
+
+void ChFunction_Compiled::Set_function(std::shared_ptr<ChFunction> fun) {
+    m_function = fun;
+    Compile();
+}
+
+void ChFunction_Compiled::Compile() {
+    m_program.clear();
+    CompileNode(m_function);
+
+    // Size the work storage
+    int depth = 0;
+    int max_depth = 1;
+    int arg_depth = 1;
+    int max_arg_depth = 1;
+    for (const auto& instr : m_program) {
+        switch (instr.code) {
+            case OPERATION:
+                if (instr.op != ChFunction_Operation::ChOP_FABS)
+                    depth--;
+                break;
+            case BEGIN_ARG:
+                depth--;
+                arg_depth++;
+                break;
+            case END_ARG:
+                arg_depth--;
+                break;
+            default:
+                depth++;
+                break;
+        }
+        max_depth = ChMax(max_depth, depth);
+        max_arg_depth = ChMax(max_arg_depth, arg_depth);
+    }
+    m_stack.resize(3 * max_depth);
+    m_args.resize(3 * max_arg_depth);
+}
+
+void ChFunction_Compiled::CompileNode(const std::shared_ptr<ChFunction>& fun) {
+    Instruction instr;
+    instr.p[0] = instr.p[1] = instr.p[2] = 0;
+    instr.fun = fun.get();
+    instr.op = ChFunction_Operation::ChOP_ADD;
+
+    if (auto f_op = std::dynamic_pointer_cast<ChFunction_Operation>(fun)) {
+        instr.code = OPERATION;
+        instr.op = f_op->Get_optype();
+        switch (instr.op) {
+            case ChFunction_Operation::ChOP_FUNCT:
+                // evaluate the inner function, then the outer function with the inner function as argument
+                CompileNode(f_op->Get_fb());
+                instr.code = BEGIN_ARG;
+                m_program.push_back(instr);
+                CompileNode(f_op->Get_fa());
+                instr.code = END_ARG;
+                break;
+            case ChFunction_Operation::ChOP_FABS:
+                CompileNode(f_op->Get_fa());
+                break;
+            default:
+                CompileNode(f_op->Get_fa());
+                CompileNode(f_op->Get_fb());
+                break;
+        }
+    } else if (auto f_const = std::dynamic_pointer_cast<ChFunction_Const>(fun)) {
+        instr.code = PUSH_CONST;
+        instr.p[0] = f_const->Get_yconst();
+    } else if (auto f_ramp = std::dynamic_pointer_cast<ChFunction_Ramp>(fun)) {
+        instr.code = PUSH_RAMP;
+        instr.p[0] = f_ramp->Get_y0();
+        instr.p[1] = f_ramp->Get_ang();
+    } else if (auto f_sine = std::dynamic_pointer_cast<ChFunction_Sine>(fun)) {
+        instr.code = PUSH_SINE;
+        instr.p[0] = f_sine->Get_amp();
+        instr.p[1] = f_sine->Get_phase();
+        instr.p[2] = f_sine->Get_w();
+    } else {
+        instr.code = PUSH_LEAF;
+    }
+
+    m_program.push_back(instr);
+}
+
+void ChFunction_Compiled::Evaluate(double x, int order, double* y) const {
+    y[1] = y[2] = 0;
+    switch (order) {
+        case 0:
+            EvaluateN<0>(x, y);
+            break;
+        case 1:
+            EvaluateN<1>(x, y);
+            break;
+        default:
+            EvaluateN<2>(x, y);
+            break;
+    }
+}
+
+// Set the value f0 of a function at the current argument and its derivatives f1, f2 with respect to the argument,
+// converted to derivatives with respect to x
+template <int N>
+static inline void SetChain(double* y, const double* arg, double f0, double f1, double f2) {
+    y[0] = f0;
+    if (N > 0)
+        y[1] = f1 * arg[1];
+    if (N > 1)
+        y[2] = f2 * arg[1] * arg[1] + f1 * arg[2];
+}
+
+template <int N>
+void ChFunction_Compiled::EvaluateN(double x, double* y) const {
+    double* stack = m_stack.data();
+    double* arg = m_args.data();
+    double* top = stack - 3;
+    arg[0] = x;
+    arg[1] = 1;
+    arg[2] = 0;
+
+    for (const auto& instr : m_program) {
+        switch (instr.code) {
+            case PUSH_CONST:
+                top += 3;
+                top[0] = instr.p[0];
+                top[1] = top[2] = 0;
+                break;
+            case PUSH_RAMP:
+                top += 3;
+                SetChain<N>(top, arg, instr.p[0] + instr.p[1] * arg[0], instr.p[1], 0);
+                break;
+            case PUSH_SINE: {
+                double angle = instr.p[1] + instr.p[2] * arg[0];
+                double s = instr.p[0] * std::sin(angle);
+                double c = (N > 0) ? instr.p[0] * std::cos(angle) : 0;
+                top += 3;
+                SetChain<N>(top, arg, s, instr.p[2] * c, -instr.p[2] * instr.p[2] * s);
+                break;
+            }
+            case PUSH_LEAF: {
+                double f0 = instr.fun->Get_y(arg[0]);
+                double f1 = (N > 0) ? instr.fun->Get_y_dx(arg[0]) : 0;
+                double f2 = (N > 1) ? instr.fun->Get_y_dxdx(arg[0]) : 0;
+                top += 3;
+                SetChain<N>(top, arg, f0, f1, f2);
+                break;
+            }
+            case OPERATION: {
+                double res[3];
+                if (instr.op == ChFunction_Operation::ChOP_FABS) {
+                    ChFunction_Operation::Evaluate<N>(instr.op, top, top, res);
+                } else {
+                    top -= 3;
+                    ChFunction_Operation::Evaluate<N>(instr.op, top, top + 3, res);
+                }
+                for (int k = 0; k <= N; k++)
+                    top[k] = res[k];
+                break;
+            }
+            case BEGIN_ARG:
+                arg += 3;
+                for (int k = 0; k <= N; k++)
+                    arg[k] = top[k];
+                top -= 3;
+                break;
+            case END_ARG:
+                arg -= 3;
+                break;
+        }
+    }
+
+    for (int k = 0; k <= N; k++)
+        y[k] = stack[k];
+}
+
+double ChFunction_Compiled::Get_y(double x) const {
+    double y[3];
+    Evaluate(x, 0, y);
+    return y[0];
+}
+
+double ChFunction_Compiled::Get_y_dx(double x) const {
+    double y[3];
+    Evaluate(x, 1, y);
+    return y[1];
+}
+
+double ChFunction_Compiled::Get_y_dxdx(double x) const {
+    double y[3];
+    Evaluate(x, 2, y);
+    return y[2];
+}
+
+void ChFunction_Compiled::Get_y_batch(const ChVectorDynamic<>& x, ChVectorDynamic<>& y, int derivate) const {
+    if (derivate < 0 || derivate > 2)
+        derivate = 0;
+    y.resize(x.size());
+    double res[3];
+    for (int i = 0; i < x.size(); i++) {
+        Evaluate(x(i), derivate, res);
+        y(i) = res[derivate];
+    }
+}
+
+void ChFunction_Compiled::Estimate_x_range(double& xmin, double& xmax) const {
+    m_function->Estimate_x_range(xmin, xmax);
+}
+
+void ChFunction_Compiled::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChFunction_Compiled>();
+    // serialize parent class
+    ChFunction::ArchiveOUT(marchive);
+    // serialize all member data:
+    marchive << CHNVP(m_function, "function");
+}
+
+void ChFunction_Compiled::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChFunction_Compiled>();
+    // deserialize parent class
+    ChFunction::ArchiveIN(marchive);
+    // stream in all member data:
+    marchive >> CHNVP(m_function, "function");
+    Compile();
+}
+
+}  // end namespace chrono
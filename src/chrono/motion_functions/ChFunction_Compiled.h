@@ -0,0 +1,116 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHFUNCT_COMPILED_H
+#define CHFUNCT_COMPILED_H
+
+#include <vector>
+
+#include "chrono/motion_functions/ChFunction_Base.h"
+#include "chrono/motion_functions/ChFunction_Operation.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_functions
+/// @{
+
+/// Compiled function:
+///
+/// y = f(x), where f is a tree of functions (ChFunction_Operation nodes with
+/// their operands) flattened into a linear program.
+///
+/// Each instruction of the program pushes on a stack the value of a sub-function and its first and second
+/// derivatives with respect to x, or combines the topmost entries with one of the ChFunction_Operation operations.
+/// Derivatives are propagated analytically with the chain rule. Constant, ramp and sine functions are evaluated
+/// inline; any other function is a leaf of the program, evaluated through its own Get_y, Get_y_dx, Get_y_dxdx.
+/// The evaluation does not allocate memory and makes no virtual calls except for the leaves.\n
+/// The parameters of inlined functions are copied when compiling: call Compile() again if the tree is modified.
+/// The evaluation uses internal work storage, so the same object must not be evaluated concurrently.
+class ChApi ChFunction_Compiled : public ChFunction {
+  public:
+    ChFunction_Compiled();
+    ChFunction_Compiled(std::shared_ptr<ChFunction> fun);
+    ChFunction_Compiled(const ChFunction_Compiled& other);
+    ~ChFunction_Compiled() {}
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChFunction_Compiled* Clone() const override { return new ChFunction_Compiled(*this); }
+
+    virtual FunctionType Get_Type() const override { return FUNCT_COMPILED; }
+
+    virtual double Get_y(double x) const override;
+    virtual double Get_y_dx(double x) const override;
+    virtual double Get_y_dxdx(double x) const override;
+
+    virtual void Get_y_batch(const ChVectorDynamic<>& x, ChVectorDynamic<>& y, int derivate = 0) const override;
+
+    /// Set the function to be compiled, and compile it.
+    void Set_function(std::shared_ptr<ChFunction> fun);
+    std::shared_ptr<ChFunction> Get_function() const { return m_function; }
+
+    /// Compile the function tree.
+    /// This must be called whenever the tree, or the parameters of its constant, ramp or sine functions, are changed.
+    void Compile();
+
+    /// Return the number of instructions of the compiled program.
+    int GetNumInstructions() const { return (int)m_program.size(); }
+
+    /// Evaluate the function and its derivatives up to the specified order (0, 1 or 2): y = {f, df/dx, d2f/dx2}.
+    void Evaluate(double x, int order, double* y) const;
+
+    virtual void Estimate_x_range(double& xmin, double& xmax) const override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Instruction codes.
+    enum OpCode : char {
+        PUSH_CONST,  ///< push a constant
+        PUSH_RAMP,   ///< push y0 + ang * x
+        PUSH_SINE,   ///< push amp * sin(phase + w * x)
+        PUSH_LEAF,   ///< push a generic function
+        OPERATION,   ///< replace the two topmost entries (one, for ChOP_FABS) with the result of the operation
+        BEGIN_ARG,   ///< pop the topmost entry and use it as argument of the following instructions
+        END_ARG      ///< restore the previous argument
+    };
+
+    struct Instruction {
+        OpCode code;
+        ChFunction_Operation::eChOperation op;  ///< operation (for OPERATION)
+        double p[3];                            ///< parameters of inlined functions
+        ChFunction* fun;                        ///< function (for PUSH_LEAF)
+    };
+
+    /// Append the instructions of the given function to the program.
+    void CompileNode(const std::shared_ptr<ChFunction>& fun);
+
+    /// Run the program, computing the derivatives up to order N.
+    template <int N>
+    void EvaluateN(double x, double* y) const;
+
+    std::shared_ptr<ChFunction> m_function;  ///< the function tree
+    std::vector<Instruction> m_program;      ///< the compiled program
+    mutable std::vector<double> m_stack;     ///< stack of values and derivatives
+    mutable std::vector<double> m_args;      ///< stack of arguments and their derivatives
+};
+
+/// @} chrono_functions
+
+CH_CLASS_VERSION(ChFunction_Compiled, 0)
+
+}  // end namespace chrono
+
+#endif
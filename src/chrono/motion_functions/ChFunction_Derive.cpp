@@ -26,7 +26,11 @@ ChFunction_Derive::ChFunction_Derive(const ChFunction_Derive& other) {
 }
 
 double ChFunction_Derive::Get_y(double x) const {
-    return fa->Get_y_dx(x);
+    return (order == 2) ? fa->Get_y_dxdx(x) : fa->Get_y_dx(x);
+}
+
+double ChFunction_Derive::Get_y_dx(double x) const {
+    return (order == 2) ? ChFunction::Get_y_dx(x) : fa->Get_y_dxdx(x);
 }
 
 void ChFunction_Derive::Estimate_x_range(double& xmin, double& xmax) const {
@@ -25,8 +25,8 @@ namespace chrono {
 
 /// Derivative of a function: `y = df/dx`
 ///
-/// Uses a numerical differentiation method to compute the derivative
-/// of a generic function.
+/// Uses the derivatives of the operand function (analytical, if implemented
+/// by the operand, or numerical otherwise).
 class ChApi ChFunction_Derive : public ChFunction {
   private:
     std::shared_ptr<ChFunction> fa;
@@ -43,6 +43,7 @@ class ChApi ChFunction_Derive : public ChFunction {
     virtual FunctionType Get_Type() const override { return FUNCT_DERIVE; }
 
     virtual double Get_y(double x) const override;
+    virtual double Get_y_dx(double x) const override;
 
     void Set_order(int m_order) { order = m_order; }
     int Get_order() { return order; }
@@ -71,21 +71,41 @@ double ChFunction_Operation::Get_y(double x) const {
     }
     return res;
 }
-/*
-double ChFunction_Operation::Get_y_dx   (double x)
-{
-    double res = 0;
-    res = ChFunction::Get_y_dx(x); // default: numerical differentiation
-    return res;
+
+double ChFunction_Operation::Get_y_dx(double x) const {
+    double y[3];
+    EvaluateOrder(x, 1, y);
+    return y[1];
 }
 
-double ChFunction_Operation::Get_y_dxdx (double x)
-{
-    double res = 0;
-    res = ChFunction::Get_y_dxdx(x); // default: numerical differentiation
-    return res;
+double ChFunction_Operation::Get_y_dxdx(double x) const {
+    double y[3];
+    EvaluateOrder(x, 2, y);
+    return y[2];
+}
+
+void ChFunction_Operation::EvaluateOrder(double x, int order, double* y) const {
+    double a[3] = {0, 0, 0};
+    double b[3] = {0, 0, 0};
+
+    if (op_type != ChOP_FABS) {
+        b[0] = fb->Get_y(x);
+        if (order > 0)
+            b[1] = fb->Get_y_dx(x);
+        if (order > 1)
+            b[2] = fb->Get_y_dxdx(x);
+    }
+
+    double xa = (op_type == ChOP_FUNCT) ? b[0] : x;
+    a[0] = fa->Get_y(xa);
+    if (order > 0)
+        a[1] = fa->Get_y_dx(xa);
+    if (order > 1)
+        a[2] = fa->Get_y_dxdx(xa);
+
+    Evaluate<2>(op_type, a, b, y);
 }
-*/
+
 void ChFunction_Operation::Estimate_x_range(double& xmin, double& xmax) const {
     double amin, amax, bmin, bmax;
     fa->Estimate_x_range(amin, amax);
@@ -54,6 +54,103 @@ class ChApi ChFunction_Operation : public ChFunction {
     virtual FunctionType Get_Type() const override { return FUNCT_OPERATION; }
 
     virtual double Get_y(double x) const override;
+    virtual double Get_y_dx(double x) const override;
+    virtual double Get_y_dxdx(double x) const override;
+
+    /// Evaluate the operation and its derivatives up to order N (0, 1 or 2), given the values and the derivatives of
+    /// the operands: a = {fa, dfa/dx, d2fa/dx2}, b = {fb, dfb/dx, d2fb/dx2}, y = {f, df/dx, d2f/dx2}.
+    /// For ChOP_FUNCT, a must contain the value and the derivatives of fa at fb(x).
+    /// For ChOP_POW with a non-positive base (fa <= 0), the derivatives of the exponent fb are neglected, i.e. the
+    /// exponent is treated as a constant.
+    template <int N>
+    static void Evaluate(eChOperation op, const double* a, const double* b, double* y) {
+        switch (op) {
+            case ChOP_ADD:
+                y[0] = a[0] + b[0];
+                if (N > 0)
+                    y[1] = a[1] + b[1];
+                if (N > 1)
+                    y[2] = a[2] + b[2];
+                break;
+            case ChOP_SUB:
+                y[0] = a[0] - b[0];
+                if (N > 0)
+                    y[1] = a[1] - b[1];
+                if (N > 1)
+                    y[2] = a[2] - b[2];
+                break;
+            case ChOP_MUL:
+                y[0] = a[0] * b[0];
+                if (N > 0)
+                    y[1] = a[1] * b[0] + a[0] * b[1];
+                if (N > 1)
+                    y[2] = a[2] * b[0] + 2 * a[1] * b[1] + a[0] * b[2];
+                break;
+            case ChOP_DIV:
+                y[0] = a[0] / b[0];
+                if (N > 0)
+                    y[1] = (a[1] - y[0] * b[1]) / b[0];
+                if (N > 1)
+                    y[2] = (a[2] - 2 * y[1] * b[1] - y[0] * b[2]) / b[0];
+                break;
+            case ChOP_POW:
+                y[0] = pow(a[0], b[0]);
+                if (N > 0 && a[0] > 0) {
+                    // y = exp(u), with u = b*log(a)
+                    double log_a = log(a[0]);
+                    double u1 = b[1] * log_a + b[0] * a[1] / a[0];
+                    y[1] = y[0] * u1;
+                    if (N > 1) {
+                        double u2 = b[2] * log_a + 2 * b[1] * a[1] / a[0] +
+                                    b[0] * (a[2] * a[0] - a[1] * a[1]) / (a[0] * a[0]);
+                        y[2] = y[0] * (u2 + u1 * u1);
+                    }
+                } else if (N > 0) {
+                    // derivatives of the exponent are neglected
+                    double p1 = b[0] * pow(a[0], b[0] - 1);
+                    y[1] = p1 * a[1];
+                    if (N > 1)
+                        y[2] = b[0] * (b[0] - 1) * pow(a[0], b[0] - 2) * a[1] * a[1] + p1 * a[2];
+                }
+                break;
+            case ChOP_MAX:
+                for (int k = 0; k <= N; k++)
+                    y[k] = (a[0] >= b[0]) ? a[k] : b[k];
+                break;
+            case ChOP_MIN:
+                for (int k = 0; k <= N; k++)
+                    y[k] = (a[0] <= b[0]) ? a[k] : b[k];
+                break;
+            case ChOP_MODULO: {
+                double q = trunc(a[0] / b[0]);
+                y[0] = fmod(a[0], b[0]);
+                if (N > 0)
+                    y[1] = a[1] - q * b[1];
+                if (N > 1)
+                    y[2] = a[2] - q * b[2];
+                break;
+            }
+            case ChOP_FABS: {
+                double s = (a[0] < 0) ? -1 : 1;
+                y[0] = s * a[0];
+                if (N > 0)
+                    y[1] = s * a[1];
+                if (N > 1)
+                    y[2] = s * a[2];
+                break;
+            }
+            case ChOP_FUNCT:
+                y[0] = a[0];
+                if (N > 0)
+                    y[1] = a[1] * b[1];
+                if (N > 1)
+                    y[2] = a[2] * b[1] * b[1] + a[1] * b[2];
+                break;
+            default:
+                y[0] = y[1] = y[2] = 0;
+                break;
+        }
+    }
 
     void Set_optype(eChOperation m_op) { op_type = m_op; }
     eChOperation Get_optype() { return op_type; }
@@ -88,6 +185,9 @@ class ChApi ChFunction_Operation : public ChFunction {
     /// @endcond
 
   private:
+    /// Evaluate the function and its derivatives up to the specified order (analytically).
+    void EvaluateOrder(double x, int order, double* y) const;
+
     std::shared_ptr<ChFunction> fa;
     std::shared_ptr<ChFunction> fb;
     eChOperation op_type;
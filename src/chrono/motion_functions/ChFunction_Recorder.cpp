@@ -12,6 +12,7 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -24,7 +25,9 @@ CH_FACTORY_REGISTER(ChFunction_Recorder)
 
 ChFunction_Recorder::ChFunction_Recorder(const ChFunction_Recorder& other) {
     m_points = other.m_points;
-    m_last = m_points.end();
+    m_uniform = other.m_uniform;
+    m_dx = other.m_dx;
+    m_last = 0;
 }
 
 void ChFunction_Recorder::Estimate_x_range(double& xmin, double& xmax) const {
@@ -40,29 +43,88 @@ void ChFunction_Recorder::Estimate_x_range(double& xmin, double& xmax) const {
         xmax = xmin + 0.5;
 }
 
-void ChFunction_Recorder::AddPoint(double mx, double my, double mw) {
-    for (auto iter = m_points.rbegin(); iter != m_points.rend(); ++iter) {
-        double dist = mx - iter->x;
-        if (std::abs(dist) < std::numeric_limits<double>::epsilon()) {
-            // Overwrite current iterator
-            iter->x = mx;
-            iter->y = my;
-            iter->w = mw;
-            return;
-        } else if (dist > 0) {
-            // Insert before current iterator
-            ChRecPoint rec(mx, my, mw);
-            m_points.insert(iter.base(), rec);
+// Relative tolerance on the spacing of uniformly spaced points
+static const double UNIFORM_TOL = 1e-9;
+
+void ChFunction_Recorder::UpdateUniform() {
+    size_t n = m_points.size();
+    m_uniform = false;
+    if (n < 2)
+        return;
+
+    m_dx = (m_points.back().x - m_points.front().x) / (n - 1);
+    for (size_t i = 1; i < n; i++) {
+        if (std::abs(m_points[i].x - m_points[i - 1].x - m_dx) > UNIFORM_TOL * m_dx)
             return;
+    }
+    m_uniform = true;
+}
+
+void ChFunction_Recorder::AddPoint(double mx, double my, double mw) {
+    // Append at the end (most common case, e.g. recording or loading sorted data)
+    if (m_points.empty() || mx - m_points.back().x >= std::numeric_limits<double>::epsilon()) {
+        m_points.push_back(ChRecPoint(mx, my, mw));
+        size_t n = m_points.size();
+        if (n == 2) {
+            m_dx = m_points[1].x - m_points[0].x;
+            m_uniform = true;
+        } else if (n > 2 && m_uniform) {
+            m_uniform = std::abs(m_points[n - 1].x - m_points[n - 2].x - m_dx) <= UNIFORM_TOL * m_dx;
         }
+        return;
+    }
+
+    // Find the first point with x >= mx, and check whether this or the previous point has the same x
+    auto iter = std::lower_bound(m_points.begin(), m_points.end(), mx,
+                                 [](const ChRecPoint& p, double val) { return p.x < val; });
+    auto same = m_points.end();
+    if (iter != m_points.end() && std::abs(iter->x - mx) < std::numeric_limits<double>::epsilon())
+        same = iter;
+    else if (iter != m_points.begin() && std::abs((iter - 1)->x - mx) < std::numeric_limits<double>::epsilon())
+        same = iter - 1;
+    if (same != m_points.end()) {
+        // Overwrite current point
+        same->x = mx;
+        same->y = my;
+        same->w = mw;
+        return;
     }
 
-    // Insert in front of list
-    m_points.push_front(ChRecPoint(mx, my, mw));
+    // Insert before current point
+    m_points.insert(iter, ChRecPoint(mx, my, mw));
+    m_last = 0;
+    UpdateUniform();
 }
 
-double Interpolate_y(double x, const ChRecPoint& p1, const ChRecPoint& p2) {
-    return ((x - p1.x) * p2.y + (p2.x - x) * p1.y) / (p2.x - p1.x);
+size_t ChFunction_Recorder::FindInterval(double x) const {
+    size_t n = m_points.size();
+
+    if (m_uniform) {
+        // Direct lookup, corrected for round-off
+        size_t i = (size_t)((x - m_points.front().x) / m_dx);
+        if (i > n - 2)
+            i = n - 2;
+        while (i > 0 && x < m_points[i].x)
+            --i;
+        while (i < n - 2 && x >= m_points[i + 1].x)
+            ++i;
+        m_last = i;
+        return i;
+    }
+
+    // Try the last interval and the next one
+    if (m_last < n - 1 && x >= m_points[m_last].x) {
+        if (x < m_points[m_last + 1].x)
+            return m_last;
+        if (m_last + 2 < n && x < m_points[m_last + 2].x)
+            return ++m_last;
+    }
+
+    // Binary search
+    auto iter = std::upper_bound(m_points.begin(), m_points.end(), x,
+                                 [](double val, const ChRecPoint& p) { return val < p.x; });
+    m_last = (iter - m_points.begin()) - 1;
+    return m_last;
 }
 
 double ChFunction_Recorder::Get_y(double x) const {
@@ -79,41 +141,26 @@ double ChFunction_Recorder::Get_y(double x) const {
     }
 
     // At this point we are guaranteed that there are at least two records.
-
-    if (m_last == m_points.end()) {
-        m_last = m_points.begin();
-    }
-
-    if (x > m_last->x) {
-        // Search to the right
-        for (auto iter = m_last; iter != m_points.end(); ++iter) {
-            if (x <= iter->x) {
-                return Interpolate_y(x, *m_last, *iter);
-            }
-            m_last = iter;
-        }
-    } else {
-        // Search to the left
-        for (auto iter = m_last; iter != m_points.begin();) {
-            --iter;
-            if (x >= iter->x) {
-                return Interpolate_y(x, *iter, *m_last);
-            }
-            m_last = iter;
-        }
-    }
-
-    return 0;
+    size_t i = FindInterval(x);
+    const ChRecPoint& p1 = m_points[i];
+    const ChRecPoint& p2 = m_points[i + 1];
+    return ((x - p1.x) * p2.y + (p2.x - x) * p1.y) / (p2.x - p1.x);
 }
 
 double ChFunction_Recorder::Get_y_dx(double x) const {
-    //// TODO:  can we do better?
-    return ChFunction::Get_y_dx(x);
+    if (m_points.size() < 2 || x < m_points.front().x || x >= m_points.back().x) {
+        return 0;
+    }
+
+    size_t i = FindInterval(x);
+    const ChRecPoint& p1 = m_points[i];
+    const ChRecPoint& p2 = m_points[i + 1];
+    return (p2.y - p1.y) / (p2.x - p1.x);
 }
 
 double ChFunction_Recorder::Get_y_dxdx(double x) const {
-    //// TODO: can we do better?
-    return ChFunction::Get_y_dxdx(x);
+    // Piecewise-linear interpolation
+    return 0;
 }
 
 void ChFunction_Recorder::ArchiveOUT(ChArchiveOut& marchive) {
@@ -121,8 +168,8 @@ void ChFunction_Recorder::ArchiveOUT(ChArchiveOut& marchive) {
     marchive.VersionWrite<ChFunction_Recorder>();
     // serialize parent class
     ChFunction::ArchiveOUT(marchive);
-    // serialize all member data: copy to vector and store
-    std::vector<ChRecPoint> tmpvect{std::begin(m_points), std::end(m_points)};
+    // serialize all member data:
+    std::vector<ChRecPoint>& tmpvect = m_points;
     marchive << CHNVP(tmpvect);
 }
 
@@ -131,11 +178,11 @@ void ChFunction_Recorder::ArchiveIN(ChArchiveIn& marchive) {
     int version = marchive.VersionRead<ChFunction_Recorder>();
     // deserialize parent class
     ChFunction::ArchiveIN(marchive);
-    // stream in all member data: load vector of points and copy to list
-    std::vector<ChRecPoint> tmpvect;
+    // stream in all member data:
+    std::vector<ChRecPoint>& tmpvect = m_points;
     marchive >> CHNVP(tmpvect);
-    m_points.clear();
-    std::copy(tmpvect.begin(), tmpvect.end(), std::back_inserter(m_points));
+    m_last = 0;
+    UpdateUniform();
 }
 
 }  // end namespace chrono
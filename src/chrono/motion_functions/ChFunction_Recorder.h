@@ -15,8 +15,7 @@
 #ifndef CHFUNCT_RECORDER_H
 #define CHFUNCT_RECORDER_H
 
-#include <iterator>
-#include <list>
+#include <vector>
 
 #include "chrono/motion_functions/ChFunction_Base.h"
 
@@ -51,13 +50,28 @@ class ChApi ChRecPoint {
 ///
 /// y = interpolation of array of (x,y) data,
 ///     where (x,y) points can be inserted randomly.
+///
+/// The points are kept sorted in a contiguous array. The interval containing x is found in constant time if the
+/// points are equally spaced, or if x is in the same (or next) interval as the previous evaluation (as when sweeping
+/// time); otherwise with a binary search. The derivatives of the piecewise-linear interpolation are evaluated
+/// analytically: Get_y_dx returns the slope of the interval containing x (and 0 outside the range of the points),
+/// while Get_y_dxdx always returns 0 (the second derivative at the points, where the slope jumps, is neglected).
 class ChApi ChFunction_Recorder : public ChFunction {
   private:
-    std::list<ChRecPoint> m_points;  ///< the list of points
-    mutable std::list<ChRecPoint>::const_iterator m_last;
+    std::vector<ChRecPoint> m_points;  ///< the points, sorted by increasing x
+    bool m_uniform;                    ///< are the points equally spaced?
+    double m_dx;                       ///< spacing of the points (if uniform)
+    mutable size_t m_last;             ///< interval used in the last evaluation
+
+    /// Return the index i of the interval such that x_i <= x < x_(i+1).
+    /// Only valid if there are at least two points and x is strictly inside the range of the points.
+    size_t FindInterval(double x) const;
+
+    /// Check whether the points are equally spaced.
+    void UpdateUniform();
 
   public:
-    ChFunction_Recorder() : m_last(m_points.end()) {}
+    ChFunction_Recorder() : m_uniform(false), m_dx(0), m_last(0) {}
     ChFunction_Recorder(const ChFunction_Recorder& other);
     ~ChFunction_Recorder() {}
 
@@ -70,14 +84,21 @@ class ChApi ChFunction_Recorder : public ChFunction {
     virtual double Get_y_dx(double x) const override;
     virtual double Get_y_dxdx(double x) const override;
 
+    /// Insert a point (or overwrite the point with the same x).
+    /// Appending points in order of increasing x takes constant time.
     void AddPoint(double mx, double my, double mw = 1);
 
     void Reset() {
         m_points.clear();
-        m_last = m_points.end();
+        m_uniform = false;
+        m_last = 0;
     }
 
-    const std::list<ChRecPoint>& GetPoints() { return m_points; }
+    /// Access the points, sorted by increasing x.
+    const std::vector<ChRecPoint>& GetPoints() const { return m_points; }
+
+    /// Return true if the points are equally spaced (constant-time lookup).
+    bool IsUniform() const { return m_uniform; }
 
     virtual void Estimate_x_range(double& xmin, double& xmax) const override;
 
@@ -248,50 +248,42 @@ void ChFunction_Sequence::Setup() {
     }
 }
 
-double ChFunction_Sequence::Get_y(double x) const {
-    double res = 0;
-    double localtime;
+const ChFseqNode* ChFunction_Sequence::FindNode(double x) const {
+    // The time intervals of the nodes are disjoint (see Setup), so stop at the first match
     for (auto iter = functions.begin(); iter != functions.end(); ++iter) {
-        if ((x >= iter->t_start) && (x < iter->t_end)) {
-            localtime = x - iter->t_start;
-            res = iter->fx->Get_y(localtime) + iter->Iy + iter->Iydt * localtime + iter->Iydtdt * localtime * localtime;
-        }
+        if ((x >= iter->t_start) && (x < iter->t_end))
+            return &(*iter);
     }
-    return res;
+    return nullptr;
+}
+
+double ChFunction_Sequence::Get_y(double x) const {
+    const ChFseqNode* node = FindNode(x);
+    if (!node)
+        return 0;
+    double localtime = x - node->t_start;
+    return node->fx->Get_y(localtime) + node->Iy + node->Iydt * localtime + node->Iydtdt * localtime * localtime;
 }
 
 double ChFunction_Sequence::Get_y_dx(double x) const {
-    double res = 0;
-    double localtime;
-    for (auto iter = functions.begin(); iter != functions.end(); ++iter) {
-        if ((x >= iter->t_start) && (x < iter->t_end)) {
-            localtime = x - iter->t_start;
-            res = iter->fx->Get_y_dx(localtime) + iter->Iydt + iter->Iydtdt * localtime;
-        }
-    }
-    return res;
+    const ChFseqNode* node = FindNode(x);
+    if (!node)
+        return 0;
+    double localtime = x - node->t_start;
+    return node->fx->Get_y_dx(localtime) + node->Iydt + node->Iydtdt * localtime;
 }
 
 double ChFunction_Sequence::Get_y_dxdx(double x) const {
-    double res = 0;
-    double localtime;
-    for (auto iter = functions.begin(); iter != functions.end(); ++iter) {
-        if ((x >= iter->t_start) && (x < iter->t_end)) {
-            localtime = x - iter->t_start;
-            res = iter->fx->Get_y_dxdx(localtime) + iter->Iydtdt;
-        }
-    }
-    return res;
+    const ChFseqNode* node = FindNode(x);
+    if (!node)
+        return 0;
+    double localtime = x - node->t_start;
+    return node->fx->Get_y_dxdx(localtime) + node->Iydtdt;
 }
 
 double ChFunction_Sequence::Get_weight(double x) const {
-    double res = 1.0;
-    for (auto iter = functions.begin(); iter != functions.end(); ++iter) {
-        if ((x >= iter->t_start) && (x < iter->t_end)) {
-            res = iter->weight;
-        }
-    }
-    return res;
+    const ChFseqNode* node = FindNode(x);
+    return node ? node->weight : 1.0;
 }
 
 void ChFunction_Sequence::Estimate_x_range(double& xmin, double& xmax) const {
@@ -70,6 +70,9 @@ class ChApi ChFunction_Sequence : public ChFunction {
     std::list<ChFseqNode> functions;  ///< the list of sub functions
     double start;                     ///< start time for sequence
 
+    /// Return the node active at x (or null if none).
+    const ChFseqNode* FindNode(double x) const;
+
   public:
     ChFunction_Sequence() : start(0) {}
     ChFunction_Sequence(const ChFunction_Sequence& other);
@@ -12,7 +12,11 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <cassert>
+#include <typeinfo>
+
 #include "chrono/physics/ChContactContainer.h"
+#include "chrono/physics/ChSystem.h"
 
 namespace chrono {
 
@@ -22,6 +26,195 @@ namespace chrono {
 ChContactContainer::ChContactContainer(const ChContactContainer& other) : ChPhysicsItem(other) {
     add_contact_callback = other.add_contact_callback;
     report_contact_callback = other.report_contact_callback;
+    defer_resets = false;
+}
+
+void ChContactContainer::AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts) {
+    for (const auto& mcontact : mcontacts)
+        AddContact(mcontact);
+}
+
+void ChContactContainer::ProcessDeferredResets() {
+    int nresets = static_cast<int>(deferred_resets.size());
+
+    // A reset invokes the add-contact callback and the material composition strategy of the system. Neither is
+    // required to be thread safe, so the resets are run in parallel only with the default composition strategy
+    // and no callback.
+    bool custom_strategy = GetSystem() && typeid(GetSystem()->GetMaterialCompositionStrategy()) !=
+                                              typeid(ChMaterialCompositionStrategy<float>);
+
+    if (add_contact_callback || custom_strategy) {
+        for (int i = 0; i < nresets; i++) {
+            const DeferredReset& d = deferred_resets[i];
+            d.reset(d.contact, d.objA, d.objB, d.cinfo);
+        }
+    } else {
+#pragma omp parallel for schedule(dynamic, 64)
+        for (int i = 0; i < nresets; i++) {
+            const DeferredReset& d = deferred_resets[i];
+            d.reset(d.contact, d.objA, d.objB, d.cinfo);
+        }
+    }
+
+    deferred_resets.clear();
+}
+
+// -----------------------------------------------------------------------------
+// Bulk contact queries
+// -----------------------------------------------------------------------------
+
+void ChContactContainer::ContactFilter::AddObject(ChContactable* obj, int group) {
+    assert(group >= 0);
+    auto it = std::lower_bound(m_objects.begin(), m_objects.end(), std::make_pair(obj, -1));
+    if (it != m_objects.end() && it->first == obj)
+        it->second = group;
+    else
+        m_objects.insert(it, std::make_pair(obj, group));
+    m_num_groups = std::max(m_num_groups, group + 1);
+}
+
+void ChContactContainer::ContactFilter::AddFamily(const std::vector<std::shared_ptr<ChBody>>& bodies,
+                                                  int family,
+                                                  int group) {
+    for (const auto& body : bodies) {
+        if (body->GetCollide() && body->GetCollisionModel()->GetFamily() == family)
+            AddObject(body.get(), group);
+    }
+}
+
+void ChContactContainer::ContactFilter::Exclude(ChContactable* obj, ChContactable* other) {
+    auto pair = std::make_pair(obj, other);
+    auto it = std::lower_bound(m_excluded.begin(), m_excluded.end(), pair);
+    if (it == m_excluded.end() || *it != pair)
+        m_excluded.insert(it, pair);
+}
+
+void ChContactContainer::ContactFilter::Clear() {
+    m_objects.clear();
+    m_excluded.clear();
+    m_num_groups = 0;
+}
+
+void ChContactContainer::ContactData::Clear() {
+    groups.clear();
+    objects.clear();
+    others.clear();
+    points.clear();
+    planes.clear();
+    distances.clear();
+    forces.clear();
+    torques.clear();
+    offsets.clear();
+}
+
+void ChContactContainer::ContactData::Add(int group,
+                                          ChContactable* obj,
+                                          ChContactable* other,
+                                          const ChVector<>& point,
+                                          const ChMatrix33<>& plane,
+                                          double distance,
+                                          const ChVector<>& force,
+                                          const ChVector<>& torque) {
+    groups.push_back(group);
+    objects.push_back(obj);
+    others.push_back(other);
+    points.push_back(point);
+    planes.push_back(plane);
+    distances.push_back(distance);
+    forces.push_back(force);
+    torques.push_back(torque);
+}
+
+// Reorder the entries by group (stable counting sort) and set the group offsets.
+void ChContactContainer::ContactData::SortByGroup(int num_groups) {
+    size_t n = groups.size();
+
+    offsets.assign(num_groups + 1, 0);
+    for (size_t i = 0; i < n; i++)
+        offsets[groups[i] + 1]++;
+    for (int g = 0; g < num_groups; g++)
+        offsets[g + 1] += offsets[g];
+
+    bool sorted = true;
+    for (size_t i = 1; i < n && sorted; i++)
+        sorted = groups[i - 1] <= groups[i];
+    if (sorted)
+        return;
+
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    std::vector<size_t> perm(n);
+    for (size_t i = 0; i < n; i++)
+        perm[next[groups[i]]++] = i;
+
+    ContactData sorted_data;
+    sorted_data.groups.resize(n);
+    sorted_data.objects.resize(n);
+    sorted_data.others.resize(n);
+    sorted_data.points.resize(n);
+    sorted_data.planes.resize(n);
+    sorted_data.distances.resize(n);
+    sorted_data.forces.resize(n);
+    sorted_data.torques.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        size_t j = perm[i];
+        sorted_data.groups[i] = groups[j];
+        sorted_data.objects[i] = objects[j];
+        sorted_data.others[i] = others[j];
+        sorted_data.points[i] = points[j];
+        sorted_data.planes[i] = planes[j];
+        sorted_data.distances[i] = distances[j];
+        sorted_data.forces[i] = forces[j];
+        sorted_data.torques[i] = torques[j];
+    }
+
+    groups.swap(sorted_data.groups);
+    objects.swap(sorted_data.objects);
+    others.swap(sorted_data.others);
+    points.swap(sorted_data.points);
+    planes.swap(sorted_data.planes);
+    distances.swap(sorted_data.distances);
+    forces.swap(sorted_data.forces);
+    torques.swap(sorted_data.torques);
+}
+
+// Default implementation of bulk contact queries, through the contact reporting interface.
+class ChContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    ChContactCollector(const ChContactContainer::ContactFilter& filter, ChContactContainer::ContactData& data)
+        : m_filter(filter), m_data(data) {}
+
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* objA,
+                                 ChContactable* objB) override {
+        if (m_filter.IsActiveOnly() && (distance > 0 || react_forces.IsNull()))
+            return true;
+        int groupA = m_filter.GetGroup(objA);
+        if (groupA >= 0 && !m_filter.IsExcluded(objA, objB))
+            m_data.Add(groupA, objA, objB, pA, plane_coord, distance, react_forces, react_torques);
+        int groupB = m_filter.GetGroup(objB);
+        if (groupB >= 0 && !m_filter.IsExcluded(objB, objA))
+            m_data.Add(groupB, objB, objA, pB, plane_coord, distance, react_forces, react_torques);
+        return true;
+    }
+
+  private:
+    const ChContactContainer::ContactFilter& m_filter;
+    ChContactContainer::ContactData& m_data;
+};
+
+void ChContactContainer::CollectContacts(const ContactFilter& filter, ContactData& data) {
+    data.Clear();
+    if (filter.GetNumGroups() > 0) {
+        ChContactCollector collector(filter, data);
+        ReportAllContacts(&collector);
+    }
+    data.SortByGroup(filter.GetNumGroups());
 }
 
 void ChContactContainer::ArchiveOUT(ChArchiveOut& marchive) {
@@ -15,8 +15,10 @@
 #ifndef CH_CONTACT_CONTAINER_H
 #define CH_CONTACT_CONTAINER_H
 
+#include <algorithm>
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "chrono/collision/ChCCollisionInfo.h"
 #include "chrono/physics/ChBody.h"
@@ -28,7 +30,7 @@ namespace chrono {
 /// Class representing a container of many contacts.
 class ChApi ChContactContainer : public ChPhysicsItem {
   public:
-    ChContactContainer() : add_contact_callback(nullptr), report_contact_callback(nullptr) {}
+    ChContactContainer() : add_contact_callback(nullptr), report_contact_callback(nullptr), defer_resets(false) {}
     ChContactContainer(const ChContactContainer& other);
     virtual ~ChContactContainer() {}
 
@@ -46,6 +48,11 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// Add a contact between two models, storing it into this container.
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) = 0;
 
+    /// Add a batch of contacts, storing them into this container.
+    /// The default implementation calls AddContact() for each of them; derived classes may process the batch more
+    /// efficiently (for example, reinitializing the contacts in parallel).
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts);
+
     /// The collision system will call EndAddContact() after adding all contacts (for example with AddContact() or
     /// similar).
     virtual void EndAddContact() {}
@@ -101,6 +108,95 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// object.
     virtual void ReportAllContacts(ReportContactCallback* mcallback) {}
 
+    /// Selection of the contacts extracted by a bulk contact query (see CollectContacts).
+    /// A contact is selected if it involves at least one monitored object. Each monitored object is assigned a
+    /// (non-negative) group identifier, used to sort the query results.
+    class ChApi ContactFilter {
+      public:
+        ContactFilter() : m_active_only(true), m_num_groups(0) {}
+
+        /// Monitor the contacts on the specified object and report them in the given group.
+        void AddObject(ChContactable* obj, int group);
+
+        /// Monitor the contacts on all bodies in the list that belong to the specified collision family.
+        void AddFamily(const std::vector<std::shared_ptr<ChBody>>& bodies, int family, int group);
+
+        /// Do not report the contacts of the monitored object 'obj' with the object 'other'.
+        /// The same contact is still reported for 'other' if that object is also monitored.
+        void Exclude(ChContactable* obj, ChContactable* other);
+
+        /// Report only contacts with non-positive distance and non-zero force (default: true).
+        void SetActiveOnly(bool val) { m_active_only = val; }
+        bool IsActiveOnly() const { return m_active_only; }
+
+        /// Remove all monitored objects and exclusions.
+        void Clear();
+
+        /// Return the number of groups (one more than the largest group identifier).
+        int GetNumGroups() const { return m_num_groups; }
+
+        /// Return the group of the specified object or -1 if the object is not monitored.
+        int GetGroup(ChContactable* obj) const {
+            if (m_objects.empty() || obj < m_objects.front().first || obj > m_objects.back().first)
+                return -1;
+            auto it = std::lower_bound(m_objects.begin(), m_objects.end(), std::make_pair(obj, -1));
+            return (it != m_objects.end() && it->first == obj) ? it->second : -1;
+        }
+
+        /// Return true if the contacts of object 'obj' with object 'other' are excluded.
+        bool IsExcluded(ChContactable* obj, ChContactable* other) const {
+            return !m_excluded.empty() &&
+                   std::binary_search(m_excluded.begin(), m_excluded.end(), std::make_pair(obj, other));
+        }
+
+      private:
+        bool m_active_only;
+        int m_num_groups;
+        std::vector<std::pair<ChContactable*, int>> m_objects;                ///< monitored objects (sorted)
+        std::vector<std::pair<ChContactable*, ChContactable*>> m_excluded;  ///< excluded pairs (sorted)
+    };
+
+    /// Results of a bulk contact query, stored in contiguous arrays (see CollectContacts).
+    /// A selected contact is reported once for each monitored object it involves. All quantities are expressed in
+    /// the absolute frame, except for the force and torque which are expressed in the contact plane frame (as for
+    /// ReportContactCallback). Entries are sorted by group: the contacts of group g are at indices in the range
+    /// [offsets[g], offsets[g+1]).
+    struct ChApi ContactData {
+        std::vector<int> groups;              ///< group of the monitored object
+        std::vector<ChContactable*> objects;  ///< monitored object
+        std::vector<ChContactable*> others;   ///< other object in contact
+        std::vector<ChVector<>> points;       ///< contact point on the monitored object
+        std::vector<ChMatrix33<>> planes;     ///< contact plane coordsystem (X axis is the contact normal)
+        std::vector<double> distances;        ///< contact distance
+        std::vector<ChVector<>> forces;       ///< contact force
+        std::vector<ChVector<>> torques;      ///< contact torque (rolling friction only)
+        std::vector<size_t> offsets;          ///< start of each group (num_groups + 1 entries)
+
+        /// Return the total number of reported contacts.
+        size_t GetNumContacts() const { return groups.size(); }
+
+        /// Return the number of contacts reported in the specified group.
+        size_t GetNumContacts(int group) const {
+            return group + 1 < (int)offsets.size() ? offsets[group + 1] - offsets[group] : 0;
+        }
+
+        void Clear();
+        void Add(int group,
+                 ChContactable* obj,
+                 ChContactable* other,
+                 const ChVector<>& point,
+                 const ChMatrix33<>& plane,
+                 double distance,
+                 const ChVector<>& force,
+                 const ChVector<>& torque);
+        void SortByGroup(int num_groups);
+    };
+
+    /// Extract all contacts selected by the filter in the provided arrays (previous content is discarded).
+    /// Unlike ReportAllContacts, the contact lists are scanned without a virtual call per contact. The default
+    /// implementation relies on ReportAllContacts; derived classes override it with a direct traversal.
+    virtual void CollectContacts(const ContactFilter& filter, ContactData& data);
+
     /// Compute contact forces on all contactable objects in this container.
     virtual void ComputeContactForces() {}
 
@@ -116,6 +212,21 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// Method for de-serialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& marchive);
 
+    /// Reinitialization of a reused contact, postponed during a bulk insertion (see AddContacts).
+    /// This is used internally by derived containers.
+    struct DeferredReset {
+        void (*reset)(void* contact, void* objA, void* objB, const collision::ChCollisionInfo& cinfo);
+        void* contact;
+        void* objA;
+        void* objB;
+        collision::ChCollisionInfo cinfo;
+
+        template <class Tcont, class Ta, class Tb>
+        static void Reset(void* contact, void* objA, void* objB, const collision::ChCollisionInfo& cinfo) {
+            static_cast<Tcont*>(contact)->Reset(static_cast<Ta*>(objA), static_cast<Tb*>(objB), cinfo);
+        }
+    };
+
   protected:
     struct ForceTorque {
         ChVector<> force;
@@ -125,6 +236,60 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     AddContactCallback* add_contact_callback;
     ReportContactCallback* report_contact_callback;
 
+    bool defer_resets;                           ///< if true, reused contacts are queued instead of reset
+    std::vector<DeferredReset> deferred_resets;  ///< contacts queued during a bulk insertion
+
+    /// Reinitialize all queued contacts and clear the queue.
+    /// The contacts are processed in parallel, unless an AddContactCallback or a custom material composition
+    /// strategy is in use (user callbacks and strategies are not required to be thread safe).
+    void ProcessDeferredResets();
+
+    /// Utility function to extract the contacts selected by a filter from a specified list of contacts.
+    /// This function is templated by the contact type (assumed to be derived from ChContactTuple). Derived
+    /// ChContactContainer classes can use this utility (processing their various lists of contacts) to implement
+    /// CollectContacts. The contact torque is set to zero; see CollectContactListRolling for rolling contacts.
+    template <class Tcont>
+    void CollectContactList(std::list<Tcont*>& contactlist, const ContactFilter& filter, ContactData& data) {
+        for (auto contact : contactlist) {
+            int groupA = filter.GetGroup(contact->GetObjA());
+            int groupB = filter.GetGroup(contact->GetObjB());
+            if (groupA < 0 && groupB < 0)
+                continue;
+            CollectContact(contact, groupA, groupB, VNULL, filter, data);
+        }
+    }
+
+    /// Same as CollectContactList, for contacts with rolling friction.
+    template <class Tcont>
+    void CollectContactListRolling(std::list<Tcont*>& contactlist, const ContactFilter& filter, ContactData& data) {
+        for (auto contact : contactlist) {
+            int groupA = filter.GetGroup(contact->GetObjA());
+            int groupB = filter.GetGroup(contact->GetObjB());
+            if (groupA < 0 && groupB < 0)
+                continue;
+            CollectContact(contact, groupA, groupB, contact->GetContactTorque(), filter, data);
+        }
+    }
+
+    template <class Tcont>
+    static void CollectContact(Tcont* contact,
+                               int groupA,
+                               int groupB,
+                               const ChVector<>& torque,
+                               const ContactFilter& filter,
+                               ContactData& data) {
+        double distance = contact->GetContactDistance();
+        ChVector<> force = contact->GetContactForce();
+        if (filter.IsActiveOnly() && (distance > 0 || force.IsNull()))
+            return;
+        ChContactable* objA = contact->GetObjA();
+        ChContactable* objB = contact->GetObjB();
+        if (groupA >= 0 && !filter.IsExcluded(objA, objB))
+            data.Add(groupA, objA, objB, contact->GetContactP1(), contact->GetContactPlane(), distance, force, torque);
+        if (groupB >= 0 && !filter.IsExcluded(objB, objA))
+            data.Add(groupB, objB, objA, contact->GetContactP2(), contact->GetContactPlane(), distance, force, torque);
+    }
+
     /// Utility function to accumulate contact forces from a specified list of contacts.
     /// This function is templated by the contact type (assumed to be derived from ChContactTuple).
     /// Contact forces are accumulated in a map keyed by the contactable objects.
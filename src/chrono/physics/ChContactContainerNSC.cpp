@@ -172,17 +172,22 @@ void ChContactContainerNSC::EndAddContact() {
 }
 
 template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,          // contact list
-                           Titer& lastcontact,                      // last contact acquired
-                           int& n_added,                            // number of contact inserted
-                           ChContactContainer* mcontainer,          // contact container
-                           Ta* objA,                                // collidable object A
-                           Tb* objB,                                // collidable object B
-                           const collision::ChCollisionInfo& cinfo  // collision informations
+void _OptimalContactInsert(std::list<Tcont*>& contactlist,                           // contact list
+                           Titer& lastcontact,                                       // last contact acquired
+                           int& n_added,                                             // number of contact inserted
+                           ChContactContainer* mcontainer,                           // contact container
+                           Ta* objA,                                                 // collidable object A
+                           Tb* objB,                                                 // collidable object B
+                           const collision::ChCollisionInfo& cinfo,                  // collision informations
+                           std::vector<ChContactContainer::DeferredReset>* deferred  // queued resets (or null)
 ) {
     if (lastcontact != contactlist.end()) {
-        // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo);
+        // reuse old contacts (when adding a batch, the reset is done later for all contacts at once)
+        if (deferred)
+            deferred->push_back(
+                {&ChContactContainer::DeferredReset::Reset<Tcont, Ta, Tb>, *lastcontact, objA, objB, cinfo});
+        else
+            (*lastcontact)->Reset(objA, objB, cinfo);
         lastcontact++;
 
     } else {
@@ -216,6 +221,8 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
     auto mmatA = std::static_pointer_cast<ChMaterialSurfaceNSC>(contactableA->GetMaterialSurface());
     auto mmatB = std::static_pointer_cast<ChMaterialSurfaceNSC>(contactableB->GetMaterialSurface());
 
+    std::vector<DeferredReset>* deferred = defer_resets ? &deferred_resets : nullptr;
+
     // CREATE THE CONTACTS
     //
     // Switch among the various cases of contacts: i.e. between a 6-dof variable and another 6-dof variable,
@@ -233,22 +240,22 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 3_3
-                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 3_6 -> 6_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 3_333 -> 333_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA, swapped_contact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 3_666 -> 666_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboB, mmboA, swapped_contact, deferred);
             }
         } break;
 
@@ -257,26 +264,26 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 6_3
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 6_6    ***NOTE: for body-body one could have rolling friction: ***
                 if ((mmatA->rolling_friction && mmatB->rolling_friction) ||
                     (mmatA->spinning_friction && mmatB->spinning_friction)) {
-                    _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this, mmboA, mmboB, mcontact);
+                    _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this, mmboA, mmboB, mcontact, deferred);
                 } else {
-                    _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+                    _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact, deferred);
                 }
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 6_333 -> 333_6
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA, swapped_contact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 6_666 -> 666_6
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboB, mmboA, swapped_contact, deferred);
             }
         } break;
 
@@ -285,20 +292,20 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 333_3
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 333_6
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 333_333
-                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 333_666 -> 666_333
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboB, mmboA, swapped_contact, deferred);
             }
         } break;
 
@@ -307,19 +314,19 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 666_3
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 666_6
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 666_333
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 666_666
-                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, mmboA, mmboB, mcontact, deferred);
             }
         } break;
 
@@ -330,6 +337,18 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& mcontac
     }  // switch (contactableA->GetContactableType())
 }
 
+void ChContactContainerNSC::AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts) {
+    // Assign the contacts to the various lists, queuing the reinitialization of reused contact objects
+    deferred_resets.reserve(mcontacts.size());
+    defer_resets = true;
+    for (const auto& mcontact : mcontacts)
+        AddContact(mcontact);
+    defer_resets = false;
+
+    // Reinitialize the queued contacts (computing Jacobians and composite materials)
+    ProcessDeferredResets();
+}
+
 void ChContactContainerNSC::ComputeContactForces() {
     contact_forces.clear();
     SumAllContactForces(contactlist_3_3, contact_forces);
@@ -404,6 +423,24 @@ void ChContactContainerNSC::ReportAllContacts(ReportContactCallback* mcallback)
     _ReportAllContactsRolling(contactlist_6_6_rolling, mcallback);
 }
 
+void ChContactContainerNSC::CollectContacts(const ContactFilter& filter, ContactData& data) {
+    data.Clear();
+    if (filter.GetNumGroups() > 0) {
+        CollectContactList(contactlist_6_6, filter, data);
+        CollectContactList(contactlist_6_3, filter, data);
+        CollectContactList(contactlist_3_3, filter, data);
+        CollectContactList(contactlist_333_3, filter, data);
+        CollectContactList(contactlist_333_6, filter, data);
+        CollectContactList(contactlist_333_333, filter, data);
+        CollectContactList(contactlist_666_3, filter, data);
+        CollectContactList(contactlist_666_6, filter, data);
+        CollectContactList(contactlist_666_333, filter, data);
+        CollectContactList(contactlist_666_666, filter, data);
+        CollectContactListRolling(contactlist_6_6_rolling, filter, data);
+    }
+    data.SortByGroup(filter.GetNumGroups());
+}
+
 ////////// STATE INTERFACE ////
 
 template <class Tcont>
@@ -110,6 +110,10 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// Add a contact between two frames.
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) override;
 
+    /// Add a batch of contacts.
+    /// Contact objects reused from the previous step are reinitialized in parallel, after all contacts were assigned.
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts) override;
+
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
     /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
     virtual void EndAddContact() override;
@@ -118,6 +122,9 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// object.
     virtual void ReportAllContacts(ReportContactCallback* mcallback) override;
 
+    /// Extract all contacts selected by the filter in the provided arrays.
+    virtual void CollectContacts(const ContactFilter& filter, ContactData& data) override;
+
     /// Report the number of scalar unilateral constraints.
     /// Note: friction constraints aren't exactly unilaterals, but they are still counted.
     virtual int GetDOC_d() override {
@@ -175,10 +175,15 @@ void _OptimalContactInsert(std::list<Tcont*>& contactlist,
                            ChContactContainer* mcontainer,
                            Ta* objA,  // collidable object A
                            Tb* objB,  // collidable object B
-                           const collision::ChCollisionInfo& cinfo) {
+                           const collision::ChCollisionInfo& cinfo,
+                           std::vector<ChContactContainer::DeferredReset>* deferred) {
     if (lastcontact != contactlist.end()) {
-        // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo);
+        // reuse old contacts (when adding a batch, the reset is done later for all contacts at once)
+        if (deferred)
+            deferred->push_back(
+                {&ChContactContainer::DeferredReset::Reset<Tcont, Ta, Tb>, *lastcontact, objA, objB, cinfo});
+        else
+            (*lastcontact)->Reset(objA, objB, cinfo);
 
         lastcontact++;
 
@@ -218,6 +223,8 @@ void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& mcontac
     auto mmatA = std::static_pointer_cast<ChMaterialSurfaceSMC>(contactableA->GetMaterialSurface());
     auto mmatB = std::static_pointer_cast<ChMaterialSurfaceSMC>(contactableB->GetMaterialSurface());
 
+    std::vector<DeferredReset>* deferred = defer_resets ? &deferred_resets : nullptr;
+
     // CREATE THE CONTACTS
     //
     // Switch among the various cases of contacts: i.e. between a 6-dof variable and another 6-dof variable,
@@ -235,22 +242,22 @@ void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 3_3
-                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 3_6 -> 6_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboB, mmboA, swapped_contact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 3_333 -> 333_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboB, mmboA, swapped_contact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 3_666 -> 666_3
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboB, mmboA, swapped_contact, deferred);
             }
         } break;
 
@@ -259,21 +266,21 @@ void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 6_3
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 6_6
-                _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 6_333 -> 333_6
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboB, mmboA, swapped_contact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 6_666 -> 666_6
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboB, mmboA, swapped_contact, deferred);
             }
         } break;
 
@@ -282,20 +289,20 @@ void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 333_3
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 333_6
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 333_333
-                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 333_666 -> 666_333
                 collision::ChCollisionInfo swapped_contact(mcontact, true);
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboB, mmboA, swapped_contact);
+                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboB, mmboA, swapped_contact, deferred);
             }
         } break;
 
@@ -304,19 +311,19 @@ void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& mcontac
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto mmboB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 666_3
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto mmboB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 666_6
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto mmboB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 666_333
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, mmboA, mmboB, mcontact, deferred);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto mmboB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 666_666
-                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, mmboA, mmboB, mcontact);
+                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, mmboA, mmboB, mcontact, deferred);
             }
         } break;
 
@@ -327,6 +334,18 @@ void ChContactContainerSMC::AddContact(const collision::ChCollisionInfo& mcontac
     }  // switch(contactableA->GetContactableType())
 }
 
+void ChContactContainerSMC::AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts) {
+    // Assign the contacts to the various lists, queuing the reinitialization of reused contact objects
+    deferred_resets.reserve(mcontacts.size());
+    defer_resets = true;
+    for (const auto& mcontact : mcontacts)
+        AddContact(mcontact);
+    defer_resets = false;
+
+    // Reinitialize the queued contacts (computing Jacobians and composite materials)
+    ProcessDeferredResets();
+}
+
 void ChContactContainerSMC::ComputeContactForces() {
     contact_forces.clear();
     SumAllContactForces(contactlist_3_3, contact_forces);
@@ -385,6 +404,23 @@ void ChContactContainerSMC::ReportAllContacts(ReportContactCallback* mcallback)
     //***TODO*** rolling cont.
 }
 
+void ChContactContainerSMC::CollectContacts(const ContactFilter& filter, ContactData& data) {
+    data.Clear();
+    if (filter.GetNumGroups() > 0) {
+        CollectContactList(contactlist_3_3, filter, data);
+        CollectContactList(contactlist_6_3, filter, data);
+        CollectContactList(contactlist_6_6, filter, data);
+        CollectContactList(contactlist_333_3, filter, data);
+        CollectContactList(contactlist_333_6, filter, data);
+        CollectContactList(contactlist_333_333, filter, data);
+        CollectContactList(contactlist_666_3, filter, data);
+        CollectContactList(contactlist_666_6, filter, data);
+        CollectContactList(contactlist_666_333, filter, data);
+        CollectContactList(contactlist_666_666, filter, data);
+    }
+    data.SortByGroup(filter.GetNumGroups());
+}
+
 // STATE INTERFACE
 
 template <class Tcont>
@@ -102,6 +102,10 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     /// Add a contact between two frames.
     virtual void AddContact(const collision::ChCollisionInfo& mcontact) override;
 
+    /// Add a batch of contacts.
+    /// Contact objects reused from the previous step are reinitialized in parallel, after all contacts were assigned.
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts) override;
+
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
     /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
     virtual void EndAddContact() override;
@@ -110,6 +114,9 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     /// object.
     virtual void ReportAllContacts(ReportContactCallback* mcallback) override;
 
+    /// Extract all contacts selected by the filter in the provided arrays.
+    virtual void CollectContacts(const ContactFilter& filter, ContactData& data) override;
+
     /// Update state of this contact container: compute jacobians, violations, etc.
     /// and store results in inner structures of contacts.
     virtual void Update(double mtime, bool update_assets = true) override;
@@ -91,6 +91,11 @@ class ChContactNSC : public ChContactTuple<Ta, Tb> {
             std::static_pointer_cast<ChMaterialSurfaceNSC>(this->objA->GetMaterialSurface()),
             std::static_pointer_cast<ChMaterialSurfaceNSC>(this->objB->GetMaterialSurface()));
 
+        // Speculative contacts (separated by more than the collision envelopes) are frictionless. With the cone
+        // complementarity relaxation, a sliding velocity at such a contact would otherwise push the objects apart.
+        if (cinfo.distance > cinfo.modelA->GetEnvelope() + cinfo.modelB->GetEnvelope())
+            mat.static_friction = 0;
+
         // Check for a user-provided callback to modify the material
         if (this->container->GetAddContactCallback()) {
             this->container->GetAddContactCallback()->OnAddContact(cinfo, &mat);
@@ -13,18 +13,22 @@
 // =============================================================================
 
 #include <algorithm>
+#include <unordered_map>
 
 #include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/parallel/ChOpenMP.h"
 #include "chrono/physics/ChProximityContainer.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/solver/ChSolverADMM.h"
 #include "chrono/solver/ChSolverAPGD.h"
 #include "chrono/solver/ChSolverBB.h"
 #include "chrono/solver/ChSolverPJacobi.h"
 #include "chrono/solver/ChSolverPMINRES.h"
 #include "chrono/solver/ChSolverPSOR.h"
 #include "chrono/solver/ChSolverPSSOR.h"
+#include "chrono/solver/ChSolverIslands.h"
+#include "chrono/solver/ChSolverTree.h"
 #include "chrono/solver/ChIterativeSolverLS.h"
 #include "chrono/core/ChMatrix.h"
 #include "chrono/utils/ChProfiler.h"
@@ -122,34 +126,54 @@ void ChSystem::Clear() {
     RemoveAllProbes();
     RemoveAllControls();
 
+    sleep_islands.clear();
+
     // ResetTimers();
 }
 
+void ChSystem::RemoveBody(std::shared_ptr<ChBody> body) {
+    sleep_islands.erase(body.get());
+    ChAssembly::RemoveBody(body);
+}
+
 // -----------------------------------------------------------------------------
 // Set/Get routines
 // -----------------------------------------------------------------------------
 
+std::shared_ptr<ChIterativeSolver> ChSystem::GetIterativeSolver() const {
+    auto solver = this->solver;
+    while (true) {
+        if (auto tree = std::dynamic_pointer_cast<ChSolverTree>(solver))
+            solver = tree->GetSolver();
+        else if (auto islands = std::dynamic_pointer_cast<ChSolverIslands>(solver))
+            solver = islands->GetSolver();
+        else
+            break;
+    }
+    return std::dynamic_pointer_cast<ChIterativeSolver>(solver);
+}
+
 void ChSystem::SetSolverMaxIterations(int max_iters) {
-    if (auto iter_solver = std::dynamic_pointer_cast<ChIterativeSolver>(solver)) {
+    if (auto iter_solver = GetIterativeSolver()) {
         iter_solver->SetMaxIterations(max_iters);
     }
 }
 
 int ChSystem::GetSolverMaxIterations() const {
-    if (auto iter_solver = std::dynamic_pointer_cast<ChIterativeSolver>(solver)) {
+    if (auto iter_solver = GetIterativeSolver()) {
         return iter_solver->GetMaxIterations();
     }
     return 0;
 }
 
 void ChSystem::SetSolverTolerance(double tolerance) {
-    if (auto iter_solver = std::dynamic_pointer_cast<ChIterativeSolver>(solver)) {
+    if (auto iter_solver = GetIterativeSolver()) {
         iter_solver->SetTolerance(tolerance);
     }
 }
 
 double ChSystem::GetSolverTolerance() const {
-    if (auto iter_solver = std::dynamic_pointer_cast<ChIterativeSolver>(solver)) {
+    if (auto iter_solver = GetIterativeSolver()) {
         return iter_solver->GetTolerance();
     }
     return 0;
@@ -181,6 +205,9 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
         case ChSolver::Type::APGD:
             solver = chrono_types::make_shared<ChSolverAPGD>();
             break;
+        case ChSolver::Type::ADMM:
+            solver = chrono_types::make_shared<ChSolverADMM>();
+            break;
         case ChSolver::Type::GMRES:
             solver = chrono_types::make_shared<ChSolverGMRES>();
             break;
@@ -196,7 +223,7 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
 std::shared_ptr<ChSolver> ChSystem::GetSolver() {
     // In case the solver is iterative, and if the user specified a force-level tolerance,
     // overwrite the solver's tolerance threshold.
-    if (auto iter_solver = std::dynamic_pointer_cast<ChIterativeSolver>(solver)) {
+    if (auto iter_solver = GetIterativeSolver()) {
         if (tol_force > 0) {
             iter_solver->SetTolerance(tol_force * step);
         }
@@ -410,128 +437,102 @@ bool ChSystem::ManageSleepingBodies() {
     // STEP 1:
     // See if some body could change from no sleep-> sleep
 
+    std::unordered_map<ChPhysicsItem*, int> body_index;
+    body_index.reserve(bodylist.size());
     for (int ip = 0; ip < bodylist.size(); ++ip) {
         // mark as 'could sleep' candidate
         bodylist[ip]->TrySleeping();
+        if (!bodylist[ip]->GetBodyFixed())
+            body_index[bodylist[ip].get()] = ip;
     }
 
     // STEP 2:
-    // See if some sleeping or potential sleeping body is touching a non sleeping one,
-    // if so, set to no sleep.
-
-    // Make this class for iterating through contacts
+    // Partition the bodies into islands, i.e. groups of bodies coupled by links or contacts.
+    // Fixed bodies do not couple the bodies attached to them.
+
+    islands.Reset((int)bodylist.size());
+
+    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+        if (auto Lpointer = std::dynamic_pointer_cast<ChLink>(linklist[ip])) {
+            if (Lpointer->IsRequiringWaking()) {
+                auto i1 = body_index.find(dynamic_cast<ChBody*>(Lpointer->GetBody1()));
+                auto i2 = body_index.find(dynamic_cast<ChBody*>(Lpointer->GetBody2()));
+                if (i1 != body_index.end() && i2 != body_index.end())
+                    islands.Union(i1->second, i2->second);
+            }
+        }
+    }
 
-    class _wakeup_reporter_class : public ChContactContainer::ReportContactCallback {
+    class _island_reporter_class : public ChContactContainer::ReportContactCallback {
       public:
-        // Callback, used to report contact points already added to the container.
-        // If returns false, the contact scanning will be stopped.
-        virtual bool OnReportContact(
-            const ChVector<>& pA,             // get contact pA
-            const ChVector<>& pB,             // get contact pB
-            const ChMatrix33<>& plane_coord,  // get contact plane coordsystem (A column 'X' is contact normal)
-            const double& distance,           // get contact distance
-            const double& eff_radius,         // effective radius of curvature at contact
-            const ChVector<>& react_forces,   // get react.forces (if already computed). In coordsystem 'plane_coord'
-            const ChVector<>& react_torques,  // get react.torques, if rolling friction (if already computed).
-            ChContactable* contactobjA,  // get model A (note: some containers may not support it and could be zero!)
-            ChContactable* contactobjB   // get model B (note: some containers may not support it and could be zero!)
-            ) override {
+        _island_reporter_class(std::unordered_map<ChPhysicsItem*, int>& index, ChDisjointSets& sets)
+            : body_index(index), islands(sets) {}
+
+        virtual bool OnReportContact(const ChVector<>& pA,
+                                     const ChVector<>& pB,
+                                     const ChMatrix33<>& plane_coord,
+                                     const double& distance,
+                                     const double& eff_radius,
+                                     const ChVector<>& react_forces,
+                                     const ChVector<>& react_torques,
+                                     ChContactable* contactobjA,
+                                     ChContactable* contactobjB) override {
             if (!(contactobjA && contactobjB))
                 return true;
-            ChBody* b1 = dynamic_cast<ChBody*>(contactobjA);
-            ChBody* b2 = dynamic_cast<ChBody*>(contactobjB);
-            if (!(b1 && b2))
-                return true;
-            bool sleep1 = b1->GetSleeping();
-            bool sleep2 = b2->GetSleeping();
-            bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool ground1 = b1->GetBodyFixed();
-            bool ground2 = b2->GetBodyFixed();
-            if (sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (could_sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            if (could_sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            someone_sleeps = sleep1 | sleep2 | someone_sleeps;
-
+            auto i1 = body_index.find(contactobjA->GetPhysicsItem());
+            auto i2 = body_index.find(contactobjB->GetPhysicsItem());
+            if (i1 != body_index.end() && i2 != body_index.end())
+                islands.Union(i1->second, i2->second);
             return true;  // to continue scanning contacts
         }
 
-        // Data
-        bool someone_sleeps;
-        bool need_Setup_A;
+        std::unordered_map<ChPhysicsItem*, int>& body_index;
+        ChDisjointSets& islands;
     };
 
-    _wakeup_reporter_class my_waker;
-    my_waker.need_Setup_A = false;
-
-    bool need_Setup_L = false;
-
-    for (int i = 0; i < 1; i++)  //***TO DO*** reconfigurable number of wakeup cycles
-    {
-        my_waker.someone_sleeps = false;
-
-        // scan all links and wake connected bodies
-        for (unsigned int ip = 0; ip < linklist.size(); ++ip)  // ITERATE on links
-        {
-            if (auto Lpointer = std::dynamic_pointer_cast<ChLink>(linklist[ip])) {
-                if (Lpointer->IsRequiringWaking()) {
-                    ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
-                    ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
-                    if (b1 && b2) {
-                        bool sleep1 = b1->GetSleeping();
-                        bool sleep2 = b2->GetSleeping();
-                        bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                        bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                        if (sleep1 && !(sleep2 || could_sleep2)) {
-                            b1->SetSleeping(false);
-                            need_Setup_L = true;
-                        }
-                        if (sleep2 && !(sleep1 || could_sleep1)) {
-                            b2->SetSleeping(false);
-                            need_Setup_L = true;
-                        }
-                        if (could_sleep1 && !(sleep2 || could_sleep2)) {
-                            b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                        }
-                        if (could_sleep2 && !(sleep1 || could_sleep1)) {
-                            b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                        }
-                    }
-                }
-            }
-        }
+    _island_reporter_class my_reporter(body_index, islands);
+    contact_container->ReportAllContacts(&my_reporter);
+
+    // Contacts between sleeping bodies are not reported, so keep together the bodies that fell asleep together
+    std::unordered_map<int, int> first_of_island;
+    for (auto& entry : body_index) {
+        auto tag = sleep_islands.find(bodylist[entry.second].get());
+        if (tag == sleep_islands.end() || !tag->first->GetSleeping())
+            continue;
+        auto first = first_of_island.insert({tag->second, entry.second});
+        if (!first.second)
+            islands.Union(first.first->second, entry.second);
+    }
 
-        // scan all contacts and wake neighboring bodies
-        contact_container->ReportAllContacts(&my_waker);
+    // STEP 3:
+    // An island sleeps as a unit: it goes to sleep only if all its bodies are sleeping or could sleep,
+    // otherwise all its bodies are awakened.
 
-        // bailout wakeup cycle prematurely, if all bodies are not sleeping
-        if (!my_waker.someone_sleeps)
-            break;
+    std::vector<char> island_awake(bodylist.size(), 0);
+    for (auto& entry : body_index) {
+        ChBody* body = bodylist[entry.second].get();
+        if (!body->GetSleeping() && !body->BFlagGet(ChBody::BodyFlag::COULDSLEEP))
+            island_awake[islands.Find(entry.second)] = 1;
     }
 
-    /// If some body still must change from no sleep-> sleep, do it
-    int need_Setup_B = 0;
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
-        if (bodylist[ip]->BFlagGet(ChBody::BodyFlag::COULDSLEEP)) {
-            bodylist[ip]->SetSleeping(true);
-            ++need_Setup_B;
+    bool need_Setup = false;
+    sleep_islands.clear();
+    for (auto& entry : body_index) {
+        ChBody* body = bodylist[entry.second].get();
+        int island = islands.Find(entry.second);
+        bool sleep = !island_awake[island];
+        if (body->GetSleeping() != sleep) {
+            body->SetSleeping(sleep);
+            need_Setup = true;
         }
+        body->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
+        if (sleep)
+            sleep_islands[body] = island;
     }
 
     // if some body has been activated/deactivated because of sleep state changes,
     // the offsets and DOF counts must be updated:
-    if (my_waker.need_Setup_A || need_Setup_B || need_Setup_L) {
+    if (need_Setup) {
         Setup();
         return true;
     }
@@ -1185,6 +1186,7 @@ double ChSystem::ComputeCollisions() {
     SyncCollisionModels();
 
     // Perform the collision detection ( broadphase and narrowphase )
+    collision_system->SetSpeculativeTimeStep(step);
     collision_system->Run();
 
     // Report and store contacts and/or proximities, if there are some
@@ -22,8 +22,10 @@
 #include <cstring>
 #include <iostream>
 #include <list>
+#include <unordered_map>
 
 #include "chrono/collision/ChCCollisionSystem.h"
+#include "chrono/core/ChDisjointSets.h"
 #include "chrono/core/ChGlobal.h"
 #include "chrono/core/ChLog.h"
 #include "chrono/core/ChMath.h"
@@ -44,6 +46,8 @@
 
 namespace chrono {
 
+class ChIterativeSolver;
+
 /// Physical system.
 ///
 /// This class is used to represent a multibody physical system,
@@ -145,6 +149,8 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
 
     /// Change the default composition laws for contact surface materials
     /// (coefficient of friction, cohesion, compliance, etc.)
+    /// A custom strategy need not be thread safe: with a custom strategy, the contact containers reinitialize
+    /// the contacts reported by the collision system serially.
     void SetMaterialCompositionStrategy(std::unique_ptr<ChMaterialCompositionStrategy<float>>&& strategy);
 
     /// Accessor for the current composition laws for contact surface material.
@@ -173,6 +179,10 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Access the solver currently associated with this system.
     virtual std::shared_ptr<ChSolver> GetSolver();
 
+    /// Access the iterative solver used by this system, possibly wrapped in a ChSolverTree or ChSolverIslands.
+    /// Return an empty pointer if the solver is not iterative.
+    std::shared_ptr<ChIterativeSolver> GetIterativeSolver() const;
+
     /// Choose the solver type, to be used for the simultaneous solution of the constraints
     /// in dynamical simulations (as well as in kinematics, statics, etc.)
     ///   - Suggested solver for speed, but lower precision: PSOR
@@ -235,6 +245,10 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Removes all bodies/marker/forces/links/contacts, also resets timers and events.
     void Clear();
 
+    /// Remove a body from this system.
+    /// Its sleeping state is forgotten, so that a body added later is not grouped with the bodies it slept with.
+    virtual void RemoveBody(std::shared_ptr<ChBody> body) override;
+
     /// Return the contact method supported by this system.
     /// Bodies added to this system must be compatible.
     virtual ChMaterialSurface::ContactMethod GetContactMethod() const = 0;
@@ -578,13 +592,16 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// motion has almost come to a rest. This feature will allow faster simulation
     /// of large scenarios for real-time purposes, but it will affect the precision!
     /// This functionality can be turned off selectively for specific ChBodies.
+    /// Bodies coupled by links or contacts form islands, which go to sleep and wake up as a unit: an island sleeps
+    /// when all its bodies have come to rest, and it is awakened as soon as one of its bodies moves or is touched by
+    /// a moving body.
     void SetUseSleeping(bool ms) { use_sleeping = ms; }
 
     /// Tell if the system will put to sleep the bodies whose motion has almost come to a rest.
     bool GetUseSleeping() const { return use_sleeping; }
 
   private:
-    /// Put bodies to sleep if possible. Also awakens sleeping bodies, if needed.
+    /// Put islands of bodies to sleep if possible. Also awakens sleeping islands, if needed.
     /// Returns true if some body changed from sleep to no sleep or viceversa,
     /// returns false if nothing changed. In the former case, also performs Setup()
     /// because the sleeping policy changed the totalDOFs and offsets.
@@ -785,6 +802,9 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
 
     bool use_sleeping;  ///< if true, put to sleep objects that come to rest
 
+    ChDisjointSets islands;                          ///< islands of bodies coupled by links and contacts
+    std::unordered_map<ChBody*, int> sleep_islands;  ///< island of each sleeping body, at the last sleep update
+
     std::shared_ptr<ChSystemDescriptor> descriptor;  ///< system descriptor
     std::shared_ptr<ChSolver> solver;                ///< solver for DVI or DAE problem
 
@@ -15,12 +15,16 @@
 #ifndef CHCONSTRAINT_H
 #define CHCONSTRAINT_H
 
+#include <vector>
+
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChClassFactory.h"
 #include "chrono/core/ChMatrix.h"
 
 namespace chrono {
 
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -152,6 +156,11 @@ class ChApi ChConstraint {
     /// Tells if the constraint is linear (if non linear, returns false).
     virtual bool IsLinear() const { return true; }
 
+    /// Append to 'vars' the ChVariables objects referenced by this constraint (used, for instance, to
+    /// partition the system into independent islands).
+    /// Return false if the constraint does not provide this information (default implementation).
+    virtual bool AppendVariables(std::vector<ChVariables*>& vars) const { return false; }
+
     /// Gets the mode of the constraint: free / lock / complementary
     /// A typical constraint has 'lock = true' by default.
     eChConstraintMode GetMode() const { return mode; }
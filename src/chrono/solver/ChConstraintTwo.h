@@ -61,6 +61,12 @@ class ChApi ChConstraintTwo : public ChConstraint {
     /// Access the second variable object.
     ChVariables* GetVariables_b() { return variables_b; }
 
+    virtual bool AppendVariables(std::vector<ChVariables*>& vars) const override {
+        vars.push_back(variables_a);
+        vars.push_back(variables_b);
+        return true;
+    }
+
     /// Set references to the constrained objects, each of ChVariables type,
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(ChVariables* mvariables_a, ChVariables* mvariables_b) = 0;
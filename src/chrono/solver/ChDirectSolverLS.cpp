@@ -85,6 +85,12 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
 
     m_timer_setup_assembly.stop();
 
+    return SetupCurrent();
+}
+
+bool ChDirectSolverLS::SetupCurrent() {
+    m_dim = (int)m_mat.rows();
+
     // Let the concrete solver perform the facorization
     m_timer_setup_solvercall.start();
     bool result = FactorizeMatrix();
@@ -112,19 +118,26 @@ double ChDirectSolverLS::Solve(ChSystemDescriptor& sysd) {
     // Assemble the problem right-hand side vector
     m_timer_solve_assembly.start();
     sysd.ConvertToMatrixForm(nullptr, &m_rhs);
-    m_sol.resize(m_rhs.size());
     m_timer_solve_assembly.stop();
 
-    // Let the concrete solver compute the solution
-    m_timer_solve_solvercall.start();
-    bool result = SolveSystem();
-    m_timer_solve_solvercall.stop();
+    double result = SolveCurrent();
 
     // Scatter solution vector to the system descriptor
     m_timer_solve_assembly.start();
     sysd.FromVectorToUnknowns(m_sol);
     m_timer_solve_assembly.stop();
 
+    return result;
+}
+
+double ChDirectSolverLS::SolveCurrent() {
+    m_sol.resize(m_rhs.size());
+
+    // Let the concrete solver compute the solution
+    m_timer_solve_solvercall.start();
+    bool result = SolveSystem();
+    m_timer_solve_solvercall.stop();
+
     if (verbose) {
         double res_norm = (m_rhs - m_mat * m_sol).norm();
         GetLog() << " Solver solve [" << m_solve_call << "]  |residual| = " << res_norm << "\n\n";
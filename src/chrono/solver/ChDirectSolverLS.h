@@ -131,6 +131,12 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     /// Get a handle to the underlying matrix.
     ChSparseMatrix& GetMatrix() { return m_mat; }
 
+    /// Get a handle to the underlying right-hand side vector.
+    ChVectorDynamic<double>& GetRHS() { return m_rhs; }
+
+    /// Get the solution vector computed at the last call to Solve or SolveCurrent.
+    const ChVectorDynamic<double>& GetSolution() const { return m_sol; }
+
     /// Perform the solver setup operations.
     /// Here, sysd is the system description with constraints and variables.
     /// Returns true if successful and false otherwise.
@@ -140,6 +146,15 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     /// Here, sysd is the system description with constraints and variables.
     virtual double Solve(ChSystemDescriptor& sysd) override;
 
+    /// Factorize the matrix currently loaded in the solver (see GetMatrix), without assembling it from a system
+    /// descriptor. This allows other solvers to use a direct solver on a modified system matrix.
+    /// Returns true if successful and false otherwise.
+    bool SetupCurrent();
+
+    /// Solve the linear system with the current factorization and the right-hand side vector currently loaded in the
+    /// solver (see GetRHS). The solution is available through GetSolution and is not scattered to a system descriptor.
+    double SolveCurrent();
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) override;
 
@@ -25,6 +25,7 @@
 // =============================================================================
 
 #include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/core/ChSparsityPatternLearner.h"
 
 // =============================================================================
 
@@ -77,41 +78,47 @@ class ChMatrixSPMV : public Eigen::EigenBase<ChMatrixSPMV> {
     chrono::ChVectorDynamic<> m_vect;    // workspace for the result of the SPMV operation
 };
 
-/// Simple diagonal preconditioner
-class ChDiagonalPreconditioner {
+// Preconditioner with the interface expected by the Eigen iterative solvers.
+// Applies either the user-specified preconditioner or a simple diagonal preconditioner.
+class ChPreconditionerWrapper {
     typedef double Scalar;
 
   public:
     typedef int StorageIndex;
     enum { ColsAtCompileTime = Eigen::Dynamic, MaxColsAtCompileTime = Eigen::Dynamic };
 
-    ChDiagonalPreconditioner() : m_N(0), m_diag_precond(false), m_invdiag(nullptr) {}
+    ChPreconditionerWrapper() : m_N(0), m_diag_precond(false), m_invdiag(nullptr), m_precond(nullptr) {}
 
-    void Setup(Eigen::Index N, const ChVectorDynamic<>& invdiag) {
+    void Setup(Eigen::Index N, const ChVectorDynamic<>& invdiag, const ChPreconditioner* precond) {
         m_N = N;
         m_invdiag = &invdiag;
         m_diag_precond = (invdiag.size() > 0);
+        m_precond = precond;
     }
 
     Eigen::Index rows() const { return m_N; }
     Eigen::Index cols() const { return m_N; }
 
     template <typename MatType>
-    ChDiagonalPreconditioner& analyzePattern(const MatType&) {
+    ChPreconditionerWrapper& analyzePattern(const MatType&) {
         return *this;
     }
     template <typename MatType>
-    ChDiagonalPreconditioner& factorize(const MatType& mat) {
+    ChPreconditionerWrapper& factorize(const MatType& mat) {
         return *this;
     }
     template <typename MatType>
-    ChDiagonalPreconditioner& compute(const MatType& mat) {
+    ChPreconditionerWrapper& compute(const MatType& mat) {
         return *this;
     }
 
     template <typename Rhs, typename Dest>
     void _solve_impl(const Rhs& b, Dest& x) const {
-        if (m_diag_precond) {
+        if (m_precond) {
+            m_r = b;
+            m_precond->Apply(m_r, m_z);
+            x = m_z;
+        } else if (m_diag_precond) {
             x = m_invdiag->array() * b.array();
         } else {
             x = b;
@@ -119,8 +126,8 @@ class ChDiagonalPreconditioner {
     }
 
     template <typename Rhs>
-    inline const Eigen::Solve<ChDiagonalPreconditioner, Rhs> solve(const Eigen::MatrixBase<Rhs>& b) const {
-        return Eigen::Solve<ChDiagonalPreconditioner, Rhs>(*this, b.derived());
+    inline const Eigen::Solve<ChPreconditionerWrapper, Rhs> solve(const Eigen::MatrixBase<Rhs>& b) const {
+        return Eigen::Solve<ChPreconditionerWrapper, Rhs>(*this, b.derived());
     }
 
     Eigen::ComputationInfo info() { return Eigen::Success; }
@@ -128,7 +135,10 @@ class ChDiagonalPreconditioner {
   protected:
     Eigen::Index m_N;                    // problem dimension
     const ChVectorDynamic<>* m_invdiag;  // pointer to (invcerse) diagonal entries
-    bool m_diag_precond;                 // if false, no preconditioning
+    bool m_diag_precond;                 // if false, no diagonal preconditioning
+    const ChPreconditioner* m_precond;   // user-specified preconditioner (if any)
+    mutable ChVectorDynamic<> m_r;       // workspace: preconditioner input
+    mutable ChVectorDynamic<> m_z;       // workspace: preconditioner output
 };
 
 }  // namespace chrono
@@ -169,7 +179,17 @@ CH_FACTORY_REGISTER(ChSolverGMRES)
 CH_FACTORY_REGISTER(ChSolverBiCGSTAB)
 CH_FACTORY_REGISTER(ChSolverMINRES)
 
-ChIterativeSolverLS::ChIterativeSolverLS() : ChIterativeSolver(-1, -1.0, true, false) {
+ChIterativeSolverLS::ChIterativeSolverLS()
+    : ChIterativeSolver(-1, -1.0, true, false),
+      m_lock(false),
+      m_force_update(true),
+      m_refresh_interval(1),
+      m_refresh_growth(0),
+      m_precond_age(0),
+      m_precond_ok(false),
+      m_ref_iterations(-1),
+      m_last_iterations(0),
+      m_num_updates(0) {
     m_spmv = new ChMatrixSPMV();
 }
 
@@ -184,8 +204,13 @@ bool ChIterativeSolverLS::Setup(ChSystemDescriptor& sysd) {
     // Set up the SPMV wrapper
     m_spmv->Setup(dim, sysd);
 
-    // If needed, evaluate the inverse diagonal entries
-    if (m_use_precond) {
+    // If needed, update the preconditioner or evaluate the inverse diagonal entries.
+    // If the preconditioner cannot be built (e.g. an incomplete factorization breaking down on a zero pivot), fall
+    // back to diagonal preconditioning (if enabled) for this step.
+    m_precond_ok = m_precond && UpdatePreconditioner(sysd, dim);
+    if (m_precond_ok || !m_use_precond) {
+        m_invdiag.resize(0);
+    } else {
         m_invdiag.resize(dim);
         sysd.BuildDiagonalVector(m_invdiag);
         for (int i = 0; i < dim; i++) {
@@ -217,7 +242,14 @@ double ChIterativeSolverLS::Solve(ChSystemDescriptor& sysd) {
     sysd.ConvertToMatrixForm(nullptr, &m_rhs);
 
     // Let the concrete solver compute the solution (in m_sol)
+    m_timer_solve.start();
     bool result = SolveProblem();
+    m_timer_solve.stop();
+
+    // Record the number of iterations (used by the preconditioner refresh policy)
+    m_last_iterations = GetIterations();
+    if (m_ref_iterations < 0)
+        m_ref_iterations = m_last_iterations;
 
     if (verbose) {
         // Calculate exact residual and report its norm
@@ -237,10 +269,74 @@ double ChIterativeSolverLS::Solve(ChSystemDescriptor& sysd) {
     return result;
 }
 
+void ChIterativeSolverLS::SetPreconditioner(std::shared_ptr<ChPreconditioner> precond) {
+    if (precond && !SupportsPreconditioner(*precond)) {
+        GetLog() << "Warning: preconditioner not supported by the iterative solver; ignored\n";
+        return;
+    }
+    m_precond = precond;
+    m_force_update = true;
+}
+
+void ChIterativeSolverLS::SetPreconditionerRefresh(int interval, double growth) {
+    m_refresh_interval = std::max(interval, 1);
+    m_refresh_growth = growth;
+}
+
+void ChIterativeSolverLS::ResetTimers() {
+    m_timer_precond.reset();
+    m_timer_solve.reset();
+}
+
+bool ChIterativeSolverLS::UpdatePreconditioner(ChSystemDescriptor& sysd, int dim) {
+    // A new analysis of the sparsity pattern is needed if explicitly requested (by default this is true at the first
+    // call), if the sparsity pattern is not locked, or if the problem size changed.
+    bool analyze = m_force_update || !m_lock || m_mat.rows() != dim;
+
+    // Otherwise, the current preconditioner is reused, unless it is too old or no longer effective.
+    m_precond_age++;
+    bool refresh = analyze || m_precond_age >= m_refresh_interval ||
+                   (m_refresh_growth > 0 && m_last_iterations > m_refresh_growth * m_ref_iterations);
+    if (!refresh)
+        return true;
+
+    m_timer_precond.start();
+
+    if (analyze) {
+        ChSparsityPatternLearner sparsity_pattern(dim, dim);
+        sysd.ConvertToMatrixForm(&sparsity_pattern, nullptr);
+        sparsity_pattern.Apply(m_mat);
+    }
+    sysd.ConvertToMatrixForm(&m_mat, nullptr);
+    m_mat.makeCompressed();
+
+    bool result = (!analyze || m_precond->Analyze(m_mat)) && m_precond->Factorize(m_mat);
+
+    m_timer_precond.stop();
+
+    m_force_update = !result;
+    m_precond_age = 0;
+    m_ref_iterations = -1;
+    m_num_updates++;
+
+    if (verbose) {
+        GetLog() << " Preconditioner update [" << m_num_updates << "] n = " << dim << "  nnz(A) = "
+                 << (int)m_mat.nonZeros() << "  nnz(M) = " << (int)m_precond->GetNonZeros()
+                 << "  analyze: " << analyze << "\n";
+    }
+
+    if (!result) {
+        GetLog() << "Preconditioner setup failed; "
+                 << (m_use_precond ? "using diagonal preconditioning\n" : "using no preconditioning\n");
+    }
+
+    return result;
+}
+
 // ---------------------------------------------------------------------------
 
 ChSolverGMRES::ChSolverGMRES() {
-    m_engine = new Eigen::GMRES<ChMatrixSPMV, ChDiagonalPreconditioner>();
+    m_engine = new Eigen::GMRES<ChMatrixSPMV, ChPreconditionerWrapper>();
 }
 
 ChSolverGMRES::~ChSolverGMRES() {
@@ -248,7 +344,7 @@ ChSolverGMRES::~ChSolverGMRES() {
 }
 
 bool ChSolverGMRES::SetupProblem() {
-    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag);
+    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag, m_precond_ok ? m_precond.get() : nullptr);
     m_engine->compute(*m_spmv);
     return (m_engine->info() == Eigen::Success);
 }
@@ -285,7 +381,7 @@ double ChSolverGMRES::GetError() const {
 // ---------------------------------------------------------------------------
 
 ChSolverBiCGSTAB::ChSolverBiCGSTAB() {
-    m_engine = new Eigen::BiCGSTAB<ChMatrixSPMV, ChDiagonalPreconditioner>();
+    m_engine = new Eigen::BiCGSTAB<ChMatrixSPMV, ChPreconditionerWrapper>();
 }
 
 ChSolverBiCGSTAB::~ChSolverBiCGSTAB() {
@@ -293,7 +389,7 @@ ChSolverBiCGSTAB::~ChSolverBiCGSTAB() {
 }
 
 bool ChSolverBiCGSTAB::SetupProblem() {
-    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag);
+    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag, m_precond_ok ? m_precond.get() : nullptr);
     m_engine->compute(*m_spmv);
     return (m_engine->info() == Eigen::Success);
 }
@@ -331,15 +427,19 @@ double ChSolverBiCGSTAB::GetError() const {
 // ---------------------------------------------------------------------------
 
 ChSolverMINRES::ChSolverMINRES() {
-    m_engine = new Eigen::MINRES<ChMatrixSPMV, Eigen::Lower | Eigen::Upper, ChDiagonalPreconditioner>();
+    m_engine = new Eigen::MINRES<ChMatrixSPMV, Eigen::Lower | Eigen::Upper, ChPreconditionerWrapper>();
 }
 
 ChSolverMINRES::~ChSolverMINRES() {
     delete m_engine;
 }
 
+bool ChSolverMINRES::SupportsPreconditioner(const ChPreconditioner& precond) const {
+    return precond.IsSymmetric();
+}
+
 bool ChSolverMINRES::SetupProblem() {
-    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag);
+    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag, m_precond_ok ? m_precond.get() : nullptr);
     m_engine->compute(*m_spmv);
     return (m_engine->info() == Eigen::Success);
 }
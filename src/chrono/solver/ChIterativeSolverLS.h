@@ -15,7 +15,8 @@
 // Chrono solvers based on Eigen iterative linear solvers.
 // All iterative linear solvers are implemented in a matrix-free context and
 // rely on the system descriptor for the required SPMV operations.
-// They can optionally use a diagonal preconditioner.
+// They can optionally use a diagonal preconditioner or a preconditioner built
+// from the assembled system matrix (see ChPreconditioner).
 //
 // Available solvers:
 //   GMRES
@@ -27,8 +28,10 @@
 #ifndef CH_ITERATIVESOLVER_LS_H
 #define CH_ITERATIVESOLVER_LS_H
 
+#include "chrono/core/ChTimer.h"
 #include "chrono/solver/ChSolverLS.h"
 #include "chrono/solver/ChIterativeSolver.h"
+#include "chrono/solver/ChPreconditioner.h"
 
 #include <Eigen/IterativeLinearSolvers>
 #include <unsupported/Eigen/IterativeSolvers>
@@ -40,9 +43,9 @@ namespace chrono {
 
 // ---------------------------------------------------------------------------
 
-// Forward declarations of wrapper class for SPMV operations and custom preconditioner
+// Forward declarations of wrapper classes for SPMV operations and preconditioning
 class ChMatrixSPMV;
-class ChDiagonalPreconditioner;
+class ChPreconditionerWrapper;
 
 // ---------------------------------------------------------------------------
 
@@ -63,6 +66,13 @@ residual error: |Ax - b|/|b|. Default: machine precision.
 
 By default, these solvers use a diagonal preconditioner and no warm start. Recall that the warm start option should
 be used **only** in conjunction with the Euler implicit linearized integrator.
+
+A more effective preconditioner (ILU(k), ILUT, incomplete Cholesky, or algebraic multigrid; see ChPreconditioner) can
+be specified through #SetPreconditioner. Such preconditioners are built from the assembled system matrix, which is
+otherwise not needed by these solvers. As for the direct sparse solvers (see ChDirectSolverLS), the sparsity pattern of
+the matrix can be locked, in which case the symbolic analysis of the preconditioner is performed only once and the
+preconditioner can be reused over several calls to Setup (e.g., across Newton iterations and time steps).
+See #LockSparsityPattern and #SetPreconditionerRefresh.
 */
 class ChApi ChIterativeSolverLS : public ChSolverLS, public ChIterativeSolver {
   public:
@@ -77,9 +87,49 @@ class ChApi ChIterativeSolverLS : public ChSolverLS, public ChIterativeSolver {
     /// Return the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd) override;
 
+    /// Set a preconditioner built from the assembled system matrix.
+    /// If set, it is used instead of the diagonal preconditioner. Pass an empty pointer to revert to diagonal
+    /// preconditioning. If the preconditioner cannot be built at some call to Setup, diagonal preconditioning is used
+    /// instead (if enabled, see #EnableDiagonalPreconditioner) for the corresponding solve. A preconditioner not
+    /// supported by the solver (see ChSolverMINRES) is ignored, with a warning.
+    void SetPreconditioner(std::shared_ptr<ChPreconditioner> precond);
+
+    /// Get the current preconditioner (empty if using diagonal preconditioning).
+    std::shared_ptr<ChPreconditioner> GetPreconditioner() const { return m_precond; }
+
+    /// Enable/disable locking the sparsity pattern (default: false).\n
+    /// If enabled, the sparsity pattern of the problem matrix is assumed to be unchanged from call to call, so that the
+    /// symbolic analysis of the preconditioner is reused. Only relevant if a preconditioner was specified.
+    void LockSparsityPattern(bool val) { m_lock = val; }
+
+    /// Force an update of the sparsity pattern and a new symbolic analysis of the preconditioner at the next call to
+    /// Setup. Such a call may be needed if the sparsity pattern is locked, but the problem structure changed.
+    void ForceSparsityPatternUpdate() { m_force_update = true; }
+
+    /// Set the refresh policy for the preconditioner (only relevant if the sparsity pattern is locked).\n
+    /// The preconditioner is recomputed every 'interval' calls to Setup (default: 1, i.e. at each call). If 'growth'
+    /// is positive, it is also recomputed as soon as a solve requires more than 'growth' times the number of
+    /// iterations of the first solve with the current preconditioner.
+    void SetPreconditionerRefresh(int interval, double growth = 0);
+
+    /// Return the number of preconditioner updates.
+    int GetNumPreconditionerUpdates() const { return m_num_updates; }
+
+    /// Get cumulative time for preconditioner updates (matrix assembly, analysis, and factorization).
+    double GetTimePreconditioner() const { return m_timer_precond(); }
+
+    /// Get cumulative time for the iterative solution in Solve.
+    double GetTimeSolve() const { return m_timer_solve(); }
+
+    /// Reset timers for the preconditioner updates and the iterative solution.
+    void ResetTimers();
+
   protected:
     ChIterativeSolverLS();
 
+    /// Return true if the specified preconditioner can be used by this solver.
+    virtual bool SupportsPreconditioner(const ChPreconditioner& precond) const { return true; }
+
     /// Indicate whether or not the #Solve() phase requires an up-to-date problem matrix.
     virtual bool SolveRequiresMatrix() const override final { return true; }
 
@@ -90,11 +140,29 @@ class ChApi ChIterativeSolverLS : public ChSolverLS, public ChIterativeSolver {
     /// Load the solution vector (already of appropriate size) and return true if succesful.
     virtual bool SolveProblem() = 0;
 
+    /// Assemble the system matrix and update the preconditioner, as required by the refresh policy.
+    bool UpdatePreconditioner(ChSystemDescriptor& sysd, int dim);
+
     ChMatrixSPMV* m_spmv;                 ///< matrix-like wrapper for SPMV operations
     ChVectorDynamic<double> m_sol;        ///< solution vector
     ChVectorDynamic<double> m_rhs;        ///< right-hand side vector
     ChVectorDynamic<double> m_invdiag;    ///< inverse diagonal entries (for preconditioning)
     ChVectorDynamic<double> m_initguess;  ///< initial guess (for warm start)
+
+    std::shared_ptr<ChPreconditioner> m_precond;  ///< preconditioner (if empty, diagonal preconditioning)
+    ChSparseMatrix m_mat;                         ///< assembled system matrix (for preconditioner updates)
+    bool m_lock;                                  ///< is the matrix sparsity pattern locked?
+    bool m_force_update;                          ///< force a new analysis of the sparsity pattern?
+    int m_refresh_interval;                       ///< number of calls to Setup between preconditioner updates
+    double m_refresh_growth;                      ///< iteration growth factor triggering a preconditioner update
+    int m_precond_age;                            ///< calls to Setup since the last preconditioner update
+    bool m_precond_ok;                            ///< was the preconditioner successfully built?
+    int m_ref_iterations;                         ///< iterations of the first solve with the current preconditioner
+    int m_last_iterations;                        ///< iterations of the last solve
+    int m_num_updates;                            ///< number of preconditioner updates
+
+    ChTimer<> m_timer_precond;  ///< timer for preconditioner updates
+    ChTimer<> m_timer_solve;    ///< timer for the iterative solution
 };
 
 // ---------------------------------------------------------------------------
@@ -115,7 +183,7 @@ class ChApi ChSolverGMRES : public ChIterativeSolverLS {
     virtual bool SetupProblem() override;
     virtual bool SolveProblem() override;
 
-    Eigen::GMRES<ChMatrixSPMV, ChDiagonalPreconditioner>* m_engine;
+    Eigen::GMRES<ChMatrixSPMV, ChPreconditionerWrapper>* m_engine;
 };
 
 // ---------------------------------------------------------------------------
@@ -135,7 +203,7 @@ class ChApi ChSolverBiCGSTAB : public ChIterativeSolverLS {
     virtual bool SetupProblem() override;
     virtual bool SolveProblem() override;
 
-    Eigen::BiCGSTAB<ChMatrixSPMV, ChDiagonalPreconditioner>* m_engine;
+    Eigen::BiCGSTAB<ChMatrixSPMV, ChPreconditionerWrapper>* m_engine;
 };
 
 // ---------------------------------------------------------------------------
@@ -143,6 +211,8 @@ class ChApi ChSolverBiCGSTAB : public ChIterativeSolverLS {
 /// MINRES iterative solver.
 /// Solves Ax=b for symmetric sparse matrix A, using a conjugate-gradient type method based on Lanczos
 /// tridiagonalization.\n
+/// MINRES requires a symmetric positive definite preconditioner: only the diagonal, incomplete Cholesky
+/// (ChPreconditionerIC), and AMG (ChPreconditionerAMG) preconditioners can be used. ILU preconditioners are rejected.\n
 /// See ChIterativeSolverLS for supported solver settings and paramters.
 class ChApi ChSolverMINRES : public ChIterativeSolverLS {
   public:
@@ -153,10 +223,11 @@ class ChApi ChSolverMINRES : public ChIterativeSolverLS {
     virtual double GetError() const override;
 
   private:
+    virtual bool SupportsPreconditioner(const ChPreconditioner& precond) const override;
     virtual bool SetupProblem() override;
     virtual bool SolveProblem() override;
 
-    Eigen::MINRES<ChMatrixSPMV, Eigen::Lower | Eigen::Upper, ChDiagonalPreconditioner>* m_engine;
+    Eigen::MINRES<ChMatrixSPMV, Eigen::Lower | Eigen::Upper, ChPreconditionerWrapper>* m_engine;
 };
 
 /// @} chrono_solver
@@ -16,11 +16,24 @@
 
 namespace chrono {
 
+// Trick to avoid putting the following mapper macro inside the class definition in .h file:
+// enclose macros in local 'my_enum_mappers', just to avoid avoiding cluttering of the parent class.
+class my_enum_mappers : public ChIterativeSolverVI {
+  public:
+    CH_ENUM_MAPPER_BEGIN(Precision);
+    CH_ENUM_VAL(Precision::DOUBLE);
+    CH_ENUM_VAL(Precision::MIXED);
+    CH_ENUM_VAL(Precision::SINGLE);
+    CH_ENUM_MAPPER_END(Precision);
+};
+
 ChIterativeSolverVI::ChIterativeSolverVI()
     : ChIterativeSolver(50, 0.0, true, false),
       m_omega(1.0),
       m_shlambda(1.0),
       m_iterations(0),
+      m_precision(Precision::DOUBLE),
+      m_use_schur(false),
       record_violation_history(false) {}
 
 void ChIterativeSolverVI::SetOmega(double mval) {
@@ -48,6 +61,31 @@ void ChIterativeSolverVI::AtIterationEnd(double mmaxviolation, double mdeltalamb
     dlambda_history.push_back(mdeltalambda);
 }
 
+bool ChIterativeSolverVI::LoadSchurComplement(ChSystemDescriptor& sysd) {
+    m_use_schur = m_precision != Precision::DOUBLE;
+    if (m_use_schur && sysd.GetKblocksList().size() > 0)
+        throw ChException("ChIterativeSolverVI: reduced precision modes do not support stiffness matrices.");
+    if (m_use_schur)
+        m_schur.Load(sysd, m_precision == Precision::MIXED);
+    return m_use_schur;
+}
+
+void ChIterativeSolverVI::ShurComplementProduct(ChSystemDescriptor& sysd,
+                                                ChVectorDynamic<>& result,
+                                                const ChVectorDynamic<>& l) {
+    if (m_use_schur)
+        m_schur.ShurComplementProduct(result, l);
+    else
+        sysd.ShurComplementProduct(result, l);
+}
+
+void ChIterativeSolverVI::ConstraintsProject(ChSystemDescriptor& sysd, ChVectorDynamic<>& l) {
+    if (m_use_schur && m_schur.HasNativeProjection())
+        m_schur.ConstraintsProject(l);
+    else
+        sysd.ConstraintsProject(l);
+}
+
 void ChIterativeSolverVI::ArchiveOUT(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChIterativeSolverVI>();
@@ -59,6 +97,8 @@ void ChIterativeSolverVI::ArchiveOUT(ChArchiveOut& marchive) {
     marchive << CHNVP(m_tolerance);
     marchive << CHNVP(m_omega);
     marchive << CHNVP(m_shlambda);
+    my_enum_mappers::Precision_mapper precisionmapper;
+    marchive << CHNVP(precisionmapper(m_precision), "precision");
 }
 
 void ChIterativeSolverVI::ArchiveIN(ChArchiveIn& marchive) {
@@ -72,6 +112,13 @@ void ChIterativeSolverVI::ArchiveIN(ChArchiveIn& marchive) {
     marchive >> CHNVP(m_tolerance);
     marchive >> CHNVP(m_omega);
     marchive >> CHNVP(m_shlambda);
+    // the precision is not stored in archives written before version 1
+    if (version >= 1) {
+        my_enum_mappers::Precision_mapper precisionmapper;
+        marchive >> CHNVP(precisionmapper(m_precision), "precision");
+    } else {
+        m_precision = Precision::DOUBLE;
+    }
 }
 
 }  // end namespace chrono
@@ -17,6 +17,7 @@
 
 #include "chrono/solver/ChSolverVI.h"
 #include "chrono/solver/ChIterativeSolver.h"
+#include "chrono/solver/ChSchurComplementFloat.h"
 
 namespace chrono {
 
@@ -51,6 +52,9 @@ The 'tolerance' threshold value used in the stopping criteria may have different
 individual iterative VI solver for details.
 
 Diagonal preconditioning is enabled by default, but may not supported by all iterative VI solvers.
+
+The PSOR, APGD and BB solvers can also operate on a compact single-precision copy of the problem data (see
+SetPrecision), which reduces the memory traffic for large problems.
 */
 class ChApi ChIterativeSolverVI : public ChSolverVI, public ChIterativeSolver {
   public:
@@ -58,6 +62,28 @@ class ChApi ChIterativeSolverVI : public ChSolverVI, public ChIterativeSolver {
 
     virtual ~ChIterativeSolverVI() {}
 
+    /// Floating-point precision of the problem data used during the iterations.
+    enum class Precision {
+        DOUBLE,  ///< double-precision storage and arithmetic
+        MIXED,   ///< single-precision storage of Jacobians and inverse mass terms, double-precision iterates and sums
+        SINGLE   ///< single-precision storage and arithmetic (PSOR also keeps velocities and multipliers in single)
+    };
+
+    /// Set the floating-point precision (default: DOUBLE).
+    /// Reduced-precision modes are supported by the PSOR, APGD and BB solvers (other solvers always use double
+    /// precision). They are useful for large problems, such as granular NSC simulations, where the solver is bound by
+    /// memory bandwidth and the tolerance is well above the single-precision round-off. In both modes, the diagonal
+    /// terms g_i, the b_i and the cfm_i are kept in double precision, and the results (velocities and multipliers)
+    /// are always returned in double precision.\n
+    /// The compact copy of the problem is rebuilt at each solve, at a cost of a few PSOR iterations: on small problems
+    /// that fit in cache, PSOR is slower in reduced precision (see the solver section of the manual for measurements).
+    /// Stiffness blocks (ChKblock) are not supported: the solvers throw a ChException if the system descriptor
+    /// contains any.
+    void SetPrecision(Precision precision) { m_precision = precision; }
+
+    /// Return the floating-point precision.
+    Precision GetPrecision() const { return m_precision; }
+
     /// Set the overrelaxation factor (default: 1.0).
     /// This factor may be used by PSOR-like methods. A good value for Jacobi solver is 0.2; for other iterative solvers
     /// it can be up to 1.0
@@ -97,6 +123,22 @@ class ChApi ChIterativeSolverVI : public ChSolverVI, public ChIterativeSolver {
     /// Note: 'iternum' starts at 0 for the first iteration.
     void AtIterationEnd(double mmaxviolation, double mdeltalambda, unsigned int iternum);
 
+    /// Load the compact single-precision copy of the Schur complement, if a reduced precision is selected.
+    /// Return true if the compact Schur complement must be used in the current solve.
+    /// Throws a ChException if a reduced precision is selected and the descriptor contains stiffness blocks.
+    bool LoadSchurComplement(ChSystemDescriptor& sysd);
+
+    /// Compute result = [N]*l, using the compact Schur complement if loaded by LoadSchurComplement.
+    void ShurComplementProduct(ChSystemDescriptor& sysd, ChVectorDynamic<>& result, const ChVectorDynamic<>& l);
+
+    /// Project the multipliers onto the admissible set, using the compact Schur complement if loaded by
+    /// LoadSchurComplement (and if it can evaluate all projections).
+    void ConstraintsProject(ChSystemDescriptor& sysd, ChVectorDynamic<>& l);
+
+    /// Overwrite the statistics of the last solve (number of iterations and error).
+    /// Used by ChSolverIslands to report, on the wrapped solver, the statistics of the worst island.
+    virtual void SetSolveStatistics(int iterations, double error) { m_iterations = iterations; }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) override;
 
@@ -113,11 +155,20 @@ class ChApi ChIterativeSolverVI : public ChSolverVI, public ChIterativeSolver {
     double m_omega;     ///< over-relaxation factor
     double m_shlambda;  ///< sharpness factor
 
+    Precision m_precision;           ///< floating-point precision
+    bool m_use_schur;                ///< compact Schur complement used in the current solve?
+    ChSchurComplementFloat m_schur;  ///< compact single-precision Schur complement
+
     bool record_violation_history;
     std::vector<double> violation_history;
     std::vector<double> dlambda_history;
+
+    friend class ChSolverIslands;
 };
 
+// Version 1: precision
+CH_CLASS_VERSION(ChIterativeSolverVI, 1)
+
 /// @} chrono_solver
 
 }  // end namespace chrono
@@ -0,0 +1,418 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Preconditioners for the Chrono iterative linear solvers, built from the
+// assembled system matrix.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "chrono/solver/ChPreconditioner.h"
+
+namespace chrono {
+
+// =============================================================================
+// ILU(k)
+// =============================================================================
+
+// Symbolic factorization: compute the sparsity pattern of the factors, keeping the fill-in entries of level at most k.
+// The level of a fill-in entry (i,j) generated by the elimination of row k is lev(i,k) + lev(k,j) + 1.
+bool ChPreconditionerILUK::Analyze(const ChSparseMatrix& A) {
+    int n = (int)A.rows();
+
+    m_rowptr.assign(n + 1, 0);
+    m_colind.clear();
+    m_diagpos.assign(n, 0);
+
+    std::vector<int> levels;  // levels of the factor entries (needed for the rows of U)
+    std::map<int, int> row;   // pattern of the current row (column -> level)
+
+    for (int i = 0; i < n; i++) {
+        row.clear();
+        for (ChSparseMatrix::InnerIterator it(A, i); it; ++it)
+            row[(int)it.col()] = 0;
+        row[i] = 0;
+
+        // Eliminate with the previous rows, in increasing column order. Fill-in entries are generated on the right of
+        // the current column, so that they are processed in turn if they belong to L.
+        for (auto it = row.begin(); it != row.end() && it->first < i; ++it) {
+            int k = it->first;
+            int lik = it->second;
+            for (int q = m_diagpos[k] + 1; q < m_rowptr[k + 1]; q++) {
+                int lev = lik + levels[q] + 1;
+                if (lev > m_level)
+                    continue;
+                auto f = row.find(m_colind[q]);
+                if (f == row.end())
+                    row[m_colind[q]] = lev;
+                else
+                    f->second = std::min(f->second, lev);
+            }
+        }
+
+        for (const auto& entry : row) {
+            if (entry.first == i)
+                m_diagpos[i] = (int)m_colind.size();
+            m_colind.push_back(entry.first);
+            levels.push_back(entry.second);
+        }
+        m_rowptr[i + 1] = (int)m_colind.size();
+    }
+
+    m_vals.resize(m_colind.size());
+    return true;
+}
+
+// Numeric factorization (IKJ variant), on the pattern computed by Analyze.
+bool ChPreconditionerILUK::Factorize(const ChSparseMatrix& A) {
+    int n = (int)A.rows();
+    if (n + 1 != (int)m_rowptr.size())
+        return false;
+
+    std::vector<int> pos(n, -1);  // position of each column in the current row
+
+    for (int i = 0; i < n; i++) {
+        for (int p = m_rowptr[i]; p < m_rowptr[i + 1]; p++) {
+            pos[m_colind[p]] = p;
+            m_vals[p] = 0;
+        }
+
+        double row_norm = 0;
+        for (ChSparseMatrix::InnerIterator it(A, i); it; ++it) {
+            int p = pos[it.col()];
+            if (p >= 0)
+                m_vals[p] = it.value();
+            row_norm = std::max(row_norm, std::abs(it.value()));
+        }
+
+        for (int p = m_rowptr[i]; p < m_diagpos[i]; p++) {
+            int k = m_colind[p];
+            double lik = m_vals[p] / m_vals[m_diagpos[k]];
+            m_vals[p] = lik;
+            for (int q = m_diagpos[k] + 1; q < m_rowptr[k + 1]; q++) {
+                int j = pos[m_colind[q]];
+                if (j >= 0)
+                    m_vals[j] -= lik * m_vals[q];
+            }
+        }
+
+        // Replace a zero pivot with a small value
+        double& pivot = m_vals[m_diagpos[i]];
+        double tiny = 1e-8 * (row_norm > 0 ? row_norm : 1.0);
+        if (std::abs(pivot) < tiny)
+            pivot = (pivot < 0) ? -tiny : tiny;
+
+        for (int p = m_rowptr[i]; p < m_rowptr[i + 1]; p++)
+            pos[m_colind[p]] = -1;
+    }
+
+    return true;
+}
+
+void ChPreconditionerILUK::Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const {
+    int n = (int)r.size();
+    z.resize(n);
+
+    // Forward substitution with L (unit diagonal)
+    for (int i = 0; i < n; i++) {
+        double sum = r(i);
+        for (int p = m_rowptr[i]; p < m_diagpos[i]; p++)
+            sum -= m_vals[p] * z(m_colind[p]);
+        z(i) = sum;
+    }
+
+    // Backward substitution with U
+    for (int i = n - 1; i >= 0; i--) {
+        double sum = z(i);
+        for (int p = m_diagpos[i] + 1; p < m_rowptr[i + 1]; p++)
+            sum -= m_vals[p] * z(m_colind[p]);
+        z(i) = sum / m_vals[m_diagpos[i]];
+    }
+}
+
+// =============================================================================
+// ILUT
+// =============================================================================
+
+ChPreconditionerILUT::ChPreconditionerILUT(double drop_tolerance, int fill_factor) {
+    m_engine.setDroptol(drop_tolerance);
+    m_engine.setFillfactor(fill_factor);
+}
+
+bool ChPreconditionerILUT::Analyze(const ChSparseMatrix& A) {
+    m_engine.analyzePattern(A);
+    return m_engine.info() == Eigen::Success;
+}
+
+bool ChPreconditionerILUT::Factorize(const ChSparseMatrix& A) {
+    m_engine.factorize(A);
+    return m_engine.info() == Eigen::Success;
+}
+
+void ChPreconditionerILUT::Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const {
+    z = m_engine.solve(r);
+}
+
+// =============================================================================
+// Incomplete Cholesky
+// =============================================================================
+
+ChPreconditionerIC::ChPreconditionerIC(double initial_shift) : m_sign(1), m_nnz(0) {
+    m_engine.setInitialShift(initial_shift);
+}
+
+bool ChPreconditionerIC::Analyze(const ChSparseMatrix& A) {
+    m_mat = A;
+    m_engine.analyzePattern(m_mat);
+    return m_engine.info() == Eigen::Success;
+}
+
+bool ChPreconditionerIC::Factorize(const ChSparseMatrix& A) {
+    // Factorize -A if the matrix is negative definite
+    m_sign = (A.diagonal().sum() < 0) ? -1.0 : 1.0;
+    m_mat = m_sign * A;
+    m_engine.factorize(m_mat);
+    m_nnz = (size_t)m_engine.matrixL().nonZeros();
+    return m_engine.info() == Eigen::Success;
+}
+
+void ChPreconditionerIC::Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const {
+    z = m_sign * m_engine.solve(r);
+}
+
+// =============================================================================
+// Smoothed-aggregation AMG
+// =============================================================================
+
+ChPreconditionerAMG::ChPreconditionerAMG()
+    : m_theta(0.08), m_coarse_size(500), m_max_levels(10), m_sweeps(1), m_analyzed(false) {}
+
+bool ChPreconditionerAMG::Analyze(const ChSparseMatrix& A) {
+    m_analyzed = Build(A, true);
+    return m_analyzed;
+}
+
+bool ChPreconditionerAMG::Factorize(const ChSparseMatrix& A) {
+    // The hierarchy was already built for the current matrix values
+    if (m_analyzed) {
+        m_analyzed = false;
+        return true;
+    }
+    return Build(A, false);
+}
+
+size_t ChPreconditionerAMG::GetNonZeros() const {
+    size_t nnz = (size_t)m_coarse.nonZeros();
+    for (const auto& level : m_levels)
+        nnz += (size_t)(level.A.nonZeros() + level.P.nonZeros() + level.R.nonZeros());
+    return nnz;
+}
+
+// Build the multigrid hierarchy. If 'aggregate' is true, the aggregates (and hence the number of levels) are recomputed;
+// otherwise, only the numerical values of the existing hierarchy are updated.
+bool ChPreconditionerAMG::Build(const ChSparseMatrix& A, bool aggregate) {
+    if (aggregate)
+        m_levels.clear();
+
+    ChSparseMatrix Al = A;
+
+    for (size_t l = 0;; l++) {
+        bool coarsest;
+        if (aggregate) {
+            coarsest = Al.rows() <= m_coarse_size || (int)l + 1 >= m_max_levels;
+            if (!coarsest) {
+                m_levels.emplace_back();
+                m_levels[l].A = Al;
+                Aggregate(m_levels[l]);
+                // Stop if the coarsening stalls
+                if (m_levels[l].num_aggregates == 0 || m_levels[l].num_aggregates > 0.9 * Al.rows()) {
+                    m_levels.pop_back();
+                    coarsest = true;
+                }
+            }
+        } else {
+            coarsest = (l == m_levels.size());
+            if (!coarsest)
+                m_levels[l].A = Al;
+        }
+
+        if (coarsest) {
+            m_coarse = Al;
+            m_coarse.makeCompressed();
+            m_coarse_lu.compute(m_coarse);
+            return m_coarse_lu.info() == Eigen::Success;
+        }
+
+        Level& level = m_levels[l];
+        int n = (int)Al.rows();
+        int nc = level.num_aggregates;
+
+        // Inverse diagonal. A (relatively) zero diagonal entry cannot be smoothed and would leave the corresponding
+        // unknowns uncorrected, so the hierarchy cannot be built.
+        ChVectorDynamic<> diag = Al.diagonal();
+        double tol = 1e-12 * diag.cwiseAbs().maxCoeff();
+        ChVectorDynamic<> dinv(n);
+        for (int i = 0; i < n; i++) {
+            if (std::abs(diag(i)) <= tol)
+                return false;
+            dinv(i) = 1 / diag(i);
+        }
+        ChSparseMatrix DA = dinv.asDiagonal() * Al;
+
+        // Estimate the spectral radius of D^{-1}A (power iterations) and set the Jacobi damping factor
+        ChVectorDynamic<> v = ChVectorDynamic<>::Ones(n);
+        for (int i = 1; i < n; i += 2)
+            v(i) = 0.5;
+        double rho = 1;
+        for (int it = 0; it < 15; it++) {
+            ChVectorDynamic<> w = DA * v;
+            double norm = w.norm();
+            if (norm == 0)
+                break;
+            rho = norm / v.norm();
+            v = w / norm;
+        }
+        double omega = 4.0 / (3.0 * rho);
+        level.invdiag = omega * dinv;
+
+        // Tentative prolongation (normalized piecewise constant), smoothed with a damped Jacobi step
+        std::vector<int> agg_size(nc, 0);
+        for (int i = 0; i < n; i++)
+            agg_size[level.aggregates[i]]++;
+        ChSparseMatrix Pt(n, nc);
+        Pt.reserve(Eigen::VectorXi::Constant(n, 1));
+        for (int i = 0; i < n; i++)
+            Pt.insert(i, level.aggregates[i]) = 1 / std::sqrt((double)agg_size[level.aggregates[i]]);
+        Pt.makeCompressed();
+
+        ChSparseMatrix DAPt = DA * Pt;
+        level.P = Pt - omega * DAPt;
+        level.P.prune(0.0);
+        level.R = level.P.transpose();
+
+        // Galerkin coarse matrix
+        ChSparseMatrix AP = Al * level.P;
+        Al = level.R * AP;
+        Al.prune(0.0);
+
+        level.x.resize(n);
+        level.b.resize(n);
+        level.res.resize(n);
+    }
+}
+
+// Greedy aggregation of strongly connected unknowns.
+void ChPreconditionerAMG::Aggregate(Level& level) const {
+    const ChSparseMatrix& A = level.A;
+    int n = (int)A.rows();
+
+    ChVectorDynamic<> diag(n);
+    for (int i = 0; i < n; i++)
+        diag(i) = std::abs(A.coeff(i, i));
+
+    auto strong = [&](int i, int j, double a_ij) {
+        return i != j && a_ij != 0 && std::abs(a_ij) >= m_theta * std::sqrt(diag(i) * diag(j));
+    };
+
+    std::vector<int>& agg = level.aggregates;
+    agg.assign(n, -1);
+    int num_agg = 0;
+
+    // Pass 1: aggregates made of an unknown and all its strong neighbors, if none of them is already aggregated
+    for (int i = 0; i < n; i++) {
+        if (agg[i] >= 0)
+            continue;
+        bool free = true;
+        for (ChSparseMatrix::InnerIterator it(A, i); it && free; ++it) {
+            if (strong(i, (int)it.col(), it.value()) && agg[it.col()] >= 0)
+                free = false;
+        }
+        if (!free)
+            continue;
+        agg[i] = num_agg;
+        for (ChSparseMatrix::InnerIterator it(A, i); it; ++it) {
+            if (strong(i, (int)it.col(), it.value()))
+                agg[it.col()] = num_agg;
+        }
+        num_agg++;
+    }
+
+    // Pass 2: join the remaining unknowns to the aggregate of their strongest aggregated neighbor
+    std::vector<int> agg1 = agg;
+    for (int i = 0; i < n; i++) {
+        if (agg1[i] >= 0)
+            continue;
+        double max_val = 0;
+        for (ChSparseMatrix::InnerIterator it(A, i); it; ++it) {
+            int j = (int)it.col();
+            if (agg1[j] >= 0 && strong(i, j, it.value()) && std::abs(it.value()) > max_val) {
+                max_val = std::abs(it.value());
+                agg[i] = agg1[j];
+            }
+        }
+    }
+
+    // Pass 3: new aggregates for the unknowns still not aggregated
+    for (int i = 0; i < n; i++) {
+        if (agg[i] >= 0)
+            continue;
+        agg[i] = num_agg;
+        for (ChSparseMatrix::InnerIterator it(A, i); it; ++it) {
+            if (agg[it.col()] < 0 && strong(i, (int)it.col(), it.value()))
+                agg[it.col()] = num_agg;
+        }
+        num_agg++;
+    }
+
+    level.num_aggregates = num_agg;
+}
+
+// V-cycle on the specified level (right-hand side in level.b, solution in level.x).
+void ChPreconditionerAMG::Cycle(int l) const {
+    const Level& level = m_levels[l];
+
+    // Pre-smoothing (damped Jacobi, from a zero initial guess)
+    level.x = level.invdiag.cwiseProduct(level.b);
+    for (int s = 1; s < m_sweeps; s++)
+        level.x += level.invdiag.cwiseProduct(level.b - level.A * level.x);
+
+    // Coarse grid correction
+    level.res = level.b - level.A * level.x;
+    if (l + 1 == (int)m_levels.size()) {
+        m_coarse_b = level.R * level.res;
+        m_coarse_x = m_coarse_lu.solve(m_coarse_b);
+        level.x += level.P * m_coarse_x;
+    } else {
+        m_levels[l + 1].b = level.R * level.res;
+        Cycle(l + 1);
+        level.x += level.P * m_levels[l + 1].x;
+    }
+
+    // Post-smoothing
+    for (int s = 0; s < m_sweeps; s++)
+        level.x += level.invdiag.cwiseProduct(level.b - level.A * level.x);
+}
+
+void ChPreconditionerAMG::Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const {
+    if (m_levels.empty()) {
+        z = m_coarse_lu.solve(r);
+        return;
+    }
+    m_levels[0].b = r;
+    Cycle(0);
+    z = m_levels[0].x;
+}
+
+}  // end namespace chrono
@@ -0,0 +1,209 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Preconditioners for the Chrono iterative linear solvers, built from the
+// assembled system matrix.
+//
+// Available preconditioners:
+//   ILU(k)  incomplete LU with level-of-fill k
+//   ILUT    incomplete LU with threshold dropping
+//   IC      incomplete Cholesky
+//   AMG     smoothed-aggregation algebraic multigrid
+//
+// =============================================================================
+
+#ifndef CH_PRECONDITIONER_H
+#define CH_PRECONDITIONER_H
+
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChMatrix.h"
+
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseLU>
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Base class for preconditioners of the iterative linear solvers (see ChIterativeSolverLS).
+/// A preconditioner is built in two phases from the assembled system matrix A:
+/// - Analyze, which processes the sparsity pattern of A (and is skipped while the sparsity pattern is locked);
+/// - Factorize, which computes the preconditioner from the current values of A.
+///
+/// The preconditioner is then applied at each iteration, as z = M^{-1} r (with M an approximation of A).
+class ChApi ChPreconditioner {
+  public:
+    virtual ~ChPreconditioner() {}
+
+    /// Process the sparsity pattern of the matrix and return true if successful.
+    virtual bool Analyze(const ChSparseMatrix& A) { return true; }
+
+    /// Compute the preconditioner from the current values of the matrix and return true if successful.
+    /// The sparsity pattern of the matrix is the same as at the last call to Analyze.
+    virtual bool Factorize(const ChSparseMatrix& A) = 0;
+
+    /// Apply the preconditioner: z = M^{-1} r.
+    virtual void Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const = 0;
+
+    /// Return the number of nonzeros stored by the preconditioner (0 if not available).
+    virtual size_t GetNonZeros() const { return 0; }
+
+    /// Return true if the preconditioner is symmetric positive definite for a symmetric positive definite matrix.
+    /// Only such preconditioners can be used with MINRES (see ChSolverMINRES).
+    virtual bool IsSymmetric() const { return false; }
+};
+
+// ---------------------------------------------------------------------------
+
+/// Incomplete LU factorization with level-of-fill k, ILU(k).\n
+/// The factors keep all fill-in entries of level at most k (with ILU(0) having the sparsity pattern of A). The
+/// sparsity pattern of the factors is computed in the Analyze phase and reused by subsequent factorizations.
+/// Zero pivots are replaced by a small value. Not symmetric, hence not suitable for MINRES.
+class ChApi ChPreconditionerILUK : public ChPreconditioner {
+  public:
+    ChPreconditionerILUK(int level = 0) : m_level(level) {}
+
+    /// Set the level of fill (default: 0).
+    void SetLevel(int level) { m_level = level; }
+
+    virtual bool Analyze(const ChSparseMatrix& A) override;
+    virtual bool Factorize(const ChSparseMatrix& A) override;
+    virtual void Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const override;
+    virtual size_t GetNonZeros() const override { return m_colind.size(); }
+
+  private:
+    int m_level;
+    std::vector<int> m_rowptr;   ///< row pointers of the factors (L and U stored in the same CSR matrix)
+    std::vector<int> m_colind;   ///< column indices of the factors (sorted within each row)
+    std::vector<int> m_diagpos;  ///< position of the diagonal entry in each row
+    std::vector<double> m_vals;  ///< factor values (L has an implicit unit diagonal)
+};
+
+// ---------------------------------------------------------------------------
+
+/// Incomplete LU factorization with threshold dropping, ILUT.\n
+/// Interface to Eigen's IncompleteLUT: entries smaller than the drop tolerance (relative to the row norm) are
+/// dropped, and at most 'fill_factor' times the number of nonzeros of a row of A are kept in each row of the factors.
+/// Not symmetric, hence not suitable for MINRES.
+class ChApi ChPreconditionerILUT : public ChPreconditioner {
+  public:
+    ChPreconditionerILUT(double drop_tolerance = 1e-4, int fill_factor = 10);
+
+    virtual bool Analyze(const ChSparseMatrix& A) override;
+    virtual bool Factorize(const ChSparseMatrix& A) override;
+    virtual void Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const override;
+
+  private:
+    Eigen::IncompleteLUT<double, int> m_engine;
+};
+
+// ---------------------------------------------------------------------------
+
+/// Incomplete Cholesky factorization with limited fill-in.\n
+/// Interface to Eigen's IncompleteCholesky (natural ordering). Only meaningful for symmetric definite matrices, such
+/// as the matrices of FEA problems without constraints. If the matrix is negative definite (as assembled in some
+/// analyses), the factorization is computed for -A.
+class ChApi ChPreconditionerIC : public ChPreconditioner {
+  public:
+    ChPreconditionerIC(double initial_shift = 1e-3);
+
+    virtual bool Analyze(const ChSparseMatrix& A) override;
+    virtual bool Factorize(const ChSparseMatrix& A) override;
+    virtual void Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const override;
+    virtual size_t GetNonZeros() const override { return m_nnz; }
+    virtual bool IsSymmetric() const override { return true; }
+
+  private:
+    typedef Eigen::SparseMatrix<double, Eigen::ColMajor, int> ColMajorMatrix;
+
+    Eigen::IncompleteCholesky<double, Eigen::Lower, Eigen::NaturalOrdering<int>> m_engine;
+    ColMajorMatrix m_mat;
+    double m_sign;
+    size_t m_nnz;
+};
+
+// ---------------------------------------------------------------------------
+
+/// Smoothed-aggregation algebraic multigrid preconditioner (one V-cycle per application).\n
+/// Unknowns are grouped in aggregates of strongly connected unknowns; the tentative (piecewise constant) prolongation
+/// is smoothed with one damped Jacobi step. Coarse matrices are Galerkin products R*A*P, with R = P^T. Levels are
+/// added until the coarse problem is small enough, which is then solved with a sparse LU factorization. The V-cycle
+/// uses symmetric damped Jacobi smoothing, so the preconditioner is symmetric for symmetric matrices.\n
+/// The aggregates are computed in the Analyze phase and reused by subsequent factorizations. Intended for problems
+/// without constraints (e.g. FEA); saddle-point systems are better served by ILU(k) or ILUT. The Jacobi smoother
+/// requires nonzero diagonal entries: the factorization fails if a (relatively) zero diagonal entry is found on any
+/// level, as for the constraint rows of a saddle-point system, in which case the iterative solver falls back to
+/// diagonal preconditioning.
+class ChApi ChPreconditionerAMG : public ChPreconditioner {
+  public:
+    ChPreconditionerAMG();
+
+    /// Set the strength of connection threshold (default: 0.08).
+    /// Unknowns i and j are strongly connected if |a_ij| >= theta * sqrt(|a_ii * a_jj|).
+    void SetStrengthThreshold(double theta) { m_theta = theta; }
+
+    /// Set the maximum size of the coarsest problem (default: 500).
+    void SetCoarseSize(int size) { m_coarse_size = size; }
+
+    /// Set the maximum number of levels (default: 10).
+    void SetMaxLevels(int levels) { m_max_levels = levels; }
+
+    /// Set the number of pre- and post-smoothing sweeps (default: 1).
+    void SetSmoothingSweeps(int sweeps) { m_sweeps = sweeps; }
+
+    /// Return the number of levels in the hierarchy (including the coarsest level).
+    int GetNumLevels() const { return (int)m_levels.size() + 1; }
+
+    virtual bool Analyze(const ChSparseMatrix& A) override;
+    virtual bool Factorize(const ChSparseMatrix& A) override;
+    virtual void Apply(const ChVectorDynamic<>& r, ChVectorDynamic<>& z) const override;
+    virtual size_t GetNonZeros() const override;
+    virtual bool IsSymmetric() const override { return true; }
+
+  private:
+    struct Level {
+        ChSparseMatrix A;                 ///< level matrix
+        ChSparseMatrix P;                 ///< prolongation to this level from the next coarser level
+        ChSparseMatrix R;                 ///< restriction from this level to the next coarser level
+        ChVectorDynamic<> invdiag;        ///< damped inverse diagonal (Jacobi smoother)
+        std::vector<int> aggregates;      ///< aggregate of each unknown
+        int num_aggregates;               ///< number of aggregates (size of the next coarser level)
+        mutable ChVectorDynamic<> x;      ///< workspace: solution
+        mutable ChVectorDynamic<> b;      ///< workspace: right-hand side
+        mutable ChVectorDynamic<> res;    ///< workspace: residual
+    };
+
+    bool Build(const ChSparseMatrix& A, bool aggregate);
+    void Aggregate(Level& level) const;
+    void Cycle(int level) const;
+
+    double m_theta;
+    int m_coarse_size;
+    int m_max_levels;
+    int m_sweeps;
+
+    std::vector<Level> m_levels;                  ///< multigrid hierarchy (all but the coarsest level)
+    ChSparseMatrix m_coarse;                      ///< coarsest level matrix
+    Eigen::SparseLU<ChSparseMatrix> m_coarse_lu;  ///< coarsest level solver
+    mutable ChVectorDynamic<> m_coarse_x;         ///< workspace: coarsest level solution
+    mutable ChVectorDynamic<> m_coarse_b;         ///< workspace: coarsest level right-hand side
+    bool m_analyzed;                              ///< true if the hierarchy was just built by Analyze
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,260 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/solver/ChConstraintTwoGenericBoxed.h"
+#include "chrono/solver/ChConstraintTwoTuplesRollingN.h"
+#include "chrono/solver/ChSchurComplementFloat.h"
+
+namespace chrono {
+
+// Sparse matrix that only records the elements set in it (e.g. by ChConstraint::Build_Cq).
+class ChElementRecorder : public ChSparseMatrix {
+  public:
+    struct Element {
+        int col;
+        double val;
+        bool overwrite;
+    };
+
+    ChElementRecorder(int ncols) : ChSparseMatrix(1, ncols) {}
+
+    virtual void SetElement(int row, int col, double val, bool overwrite = true) override {
+        elements.push_back({col, val, overwrite});
+    }
+
+    std::vector<Element> elements;
+};
+
+ChSchurComplementFloat::ChSchurComplementFloat() : m_nq(0), m_double_acc(true), m_native(true) {}
+
+void ChSchurComplementFloat::Load(ChSystemDescriptor& sysd, bool double_accumulation) {
+    m_double_acc = double_accumulation;
+    m_nq = sysd.CountActiveVariables();
+    int nc = sysd.CountActiveConstraints();
+
+    // Variable object of each active unknown
+    std::vector<ChVariables*> col_var(m_nq, nullptr);
+    for (auto var : sysd.GetVariablesList()) {
+        if (var->IsActive()) {
+            for (int j = 0; j < var->Get_ndof(); j++)
+                col_var[var->GetOffset() + j] = var;
+        }
+    }
+
+    m_constraints.clear();
+    m_row_blk.assign(1, 0);
+    m_blk_col.clear();
+    m_blk_ptr.assign(1, 0);
+    m_D.clear();
+    m_Et.clear();
+    m_native = true;
+    m_type.resize(nc);
+    m_friction.assign(nc, 0.0);
+    m_cohesion.assign(nc, 0.0);
+    m_g.resize(nc);
+    m_b.resize(nc);
+    m_cfm.resize(nc);
+
+    ChElementRecorder recorder(m_nq);
+    ChVectorDynamic<> work = ChVectorDynamic<>::Zero(m_nq);
+    std::vector<ChVariables*> all_vars;
+    std::vector<ChVariables*> row_vars;
+    std::vector<int> row_start;
+    ChVectorDynamic<> Cq;
+    ChVectorDynamic<> Eq;
+
+    for (auto constr : sysd.GetConstraintsList()) {
+        if (!constr->IsActive())
+            continue;
+        int i = (int)m_constraints.size();
+        m_constraints.push_back(constr);
+        m_b(i) = constr->Get_b_i();
+        m_cfm(i) = constr->Get_cfm_i();
+
+        // Type of projection
+        switch (constr->GetMode()) {
+            case CONSTRAINT_UNILATERAL:
+                m_type[i] = UNILATERAL;
+                break;
+            case CONSTRAINT_FRIC:
+                m_type[i] = FRICTION;
+                if (auto contact = dynamic_cast<ChConstraintTwoTuplesContactNall*>(constr)) {
+                    m_type[i] = CONE;
+                    m_friction[i] = contact->GetFrictionCoefficient();
+                    m_cohesion[i] = contact->GetCohesion();
+                } else if (dynamic_cast<ChConstraintTwoTuplesRollingNall*>(constr)) {
+                    m_native = false;
+                }
+                break;
+            default:
+                m_type[i] = BILATERAL;
+                break;
+        }
+        if (dynamic_cast<ChConstraintTwoGenericBoxed*>(constr)) {
+            m_type[i] = CUSTOM;
+            m_native = false;
+        }
+
+        // Collect the Jacobian row, as one dense block per variable object
+        row_vars.clear();
+        row_start.clear();
+        int dim = 0;
+        auto add_var = [&](ChVariables* var) {
+            if (std::find(row_vars.begin(), row_vars.end(), var) == row_vars.end()) {
+                row_vars.push_back(var);
+                row_start.push_back(dim);
+                dim += var->Get_ndof();
+            }
+        };
+
+        all_vars.clear();
+        if (constr->AppendVariables(all_vars)) {
+            // Scatter [Cq_i]' in a work vector and gather the blocks of the active variables
+            for (auto var : all_vars) {
+                if (var->IsActive() && var->Get_ndof() > 0)
+                    add_var(var);
+            }
+            constr->MultiplyTandAdd(work, 1.0);
+            Cq.resize(dim);
+            for (size_t k = 0; k < row_vars.size(); k++) {
+                auto seg = work.segment(row_vars[k]->GetOffset(), row_vars[k]->Get_ndof());
+                Cq.segment(row_start[k], seg.size()) = seg;
+                seg.setZero();
+            }
+        } else {
+            // Record the elements of [Cq_i] as they are pasted in a sparse matrix
+            recorder.elements.clear();
+            constr->Build_Cq(recorder, 0);
+            for (const auto& e : recorder.elements)
+                add_var(col_var[e.col]);
+            Cq.setZero(dim);
+            for (const auto& e : recorder.elements) {
+                ChVariables* var = col_var[e.col];
+                auto k = std::find(row_vars.begin(), row_vars.end(), var) - row_vars.begin();
+                double& val = Cq(row_start[k] + e.col - var->GetOffset());
+                val = e.overwrite ? e.val : val + e.val;
+            }
+        }
+        Eq.resize(dim);
+
+        // Compute [Eq_i] = [invM]*[Cq_i]' and g_i = [Cq_i]*[Eq_i] + cfm_i in double precision
+        for (size_t k = 0; k < row_vars.size(); k++) {
+            int n = row_vars[k]->Get_ndof();
+            row_vars[k]->Compute_invMb_v(Eq.segment(row_start[k], n), Cq.segment(row_start[k], n));
+            m_blk_col.push_back(row_vars[k]->GetOffset());
+            m_blk_ptr.push_back(m_blk_ptr.back() + n);
+        }
+        m_g(i) = Cq.dot(Eq) + m_cfm(i);
+        m_row_blk.push_back((int)m_blk_col.size());
+
+        // Store in single precision
+        for (int j = 0; j < dim; j++) {
+            m_D.push_back((float)Cq(j));
+            m_Et.push_back((float)Eq(j));
+        }
+    }
+
+    // Average all g_i for the triplet of contact constraints n,u,v
+    for (int i = 0; i + 2 < nc; i++) {
+        if (m_constraints[i]->GetMode() == CONSTRAINT_FRIC) {
+            double average_g_i = (m_g(i) + m_g(i + 1) + m_g(i + 2)) / 3.0;
+            m_g.segment(i, 3).setConstant(average_g_i);
+            i += 2;
+        }
+    }
+}
+
+void ChSchurComplementFloat::ProjectCone(double friction,
+                                         double cohesion,
+                                         double& f_n,
+                                         double& f_u,
+                                         double& f_v) {
+    // Anitescu-Tasora projection on cone generator and polar cone
+    f_n += cohesion;
+
+    // no friction? project to axis of upper cone
+    if (friction == 0) {
+        f_u = 0;
+        f_v = 0;
+        f_n = f_n < 0 ? 0 : f_n - cohesion;
+        return;
+    }
+
+    double mu2 = friction * friction;
+    double f_n2 = f_n * f_n;
+    double f_t2 = f_u * f_u + f_v * f_v;
+
+    // inside lower cone or close to origin? reset normal, u, v to zero!
+    if ((f_n <= 0 && f_t2 < f_n2 / mu2) || (f_n < 1e-14 && f_n > -1e-14)) {
+        f_n = 0;
+        f_u = 0;
+        f_v = 0;
+        return;
+    }
+
+    // inside upper cone? keep untouched!
+    if (f_t2 < f_n2 * mu2) {
+        f_n -= cohesion;
+        return;
+    }
+
+    // project orthogonally to generator segment of upper cone
+    double f_t = std::sqrt(f_t2);
+    double f_n_proj = (f_t * friction + f_n) / (mu2 + 1);
+    double tproj_div_t = f_n_proj * friction / f_t;
+    f_n = f_n_proj - cohesion;
+    f_u *= tproj_div_t;
+    f_v *= tproj_div_t;
+}
+
+void ChSchurComplementFloat::ConstraintsProject(ChVectorDynamic<>& l) const {
+    for (int i = 0; i < GetNumConstraints(); i++)
+        Project(i, l.data());
+}
+
+template <typename Acc>
+void ChSchurComplementFloat::ShurComplementProduct(ChVectorDynamic<>& result,
+                                                   const ChVectorDynamic<>& l,
+                                                   std::vector<Acc>& tmp) const {
+    int nc = GetNumConstraints();
+
+    // tmp = [invM]*[Cq]'*l
+    tmp.assign(m_nq, Acc(0));
+    for (int i = 0; i < nc; i++) {
+        if (l(i) != 0)
+            Increment_q<Acc>(i, (Acc)l(i), tmp.data());
+    }
+
+    // result = [Cq]*tmp + [E]*l
+    result.resize(nc);
+    for (int i = 0; i < nc; i++)
+        result(i) = (double)(Compute_Cq_q<Acc>(i, tmp.data()) + (Acc)m_cfm(i) * (Acc)l(i));
+}
+
+void ChSchurComplementFloat::ShurComplementProduct(ChVectorDynamic<>& result, const ChVectorDynamic<>& l) {
+    if (m_double_acc)
+        ShurComplementProduct(result, l, m_tmp_d);
+    else
+        ShurComplementProduct(result, l, m_tmp_f);
+}
+
+void ChSchurComplementFloat::Compute_q(ChVectorDynamic<>& q, const ChVectorDynamic<>& l) const {
+    for (int i = 0; i < GetNumConstraints(); i++) {
+        if (l(i) != 0)
+            Increment_q<double>(i, l(i), q.data());
+    }
+}
+
+}  // end namespace chrono
@@ -0,0 +1,192 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Compact single-precision storage of the Schur complement of a system
+// descriptor, used by the iterative VI solvers in reduced-precision modes.
+//
+// =============================================================================
+
+#ifndef CH_SCHUR_COMPLEMENT_FLOAT_H
+#define CH_SCHUR_COMPLEMENT_FLOAT_H
+
+#include <vector>
+
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Compact, single-precision copy of the Schur complement N = [Cq]*[invM]*[Cq]' + [E] of a system descriptor.\n
+/// For each active constraint, the rows of the Jacobian [Cq_i] and of [Eq_i]' = ([invM]*[Cq_i]')' are stored in
+/// contiguous float arrays, as a sequence of dense blocks (one block per variable object acting on the constraint).
+/// This halves the memory traffic of the iterative VI solvers with respect to the data stored (in double precision)
+/// in the ChConstraint and ChVariables objects. The diagonal terms g_i, the terms b_i and the compliance cfm_i are
+/// kept in double precision.\n
+/// The products can accumulate either in double precision (mixed-precision mode) or in single precision.\n
+/// The projections of the multipliers (Coulomb friction cones of ChConstraintTwoTuplesContactN, unilateral constraints)
+/// are also evaluated on the compact data, unless the problem contains constraints with other projection operators
+/// (boxed constraints, rolling friction), in which case the projections must go through the ChConstraint objects (see
+/// HasNativeProjection).\n
+/// Stiffness blocks (ChKblock) are not supported.
+class ChApi ChSchurComplementFloat {
+  public:
+    ChSchurComplementFloat();
+
+    /// Load the Jacobians and the terms [invM]*[Cq]' of all active constraints of the descriptor.
+    /// This also computes the g_i terms (averaged over the three components of frictional contacts) and collects the
+    /// b_i and cfm_i terms. If 'double_accumulation' is false, the products in ShurComplementProduct accumulate in
+    /// single precision.
+    void Load(ChSystemDescriptor& sysd, bool double_accumulation = true);
+
+    /// Return the number of active constraints.
+    int GetNumConstraints() const { return (int)m_constraints.size(); }
+
+    /// Return the number of active unknowns q.
+    int GetNumVariables() const { return m_nq; }
+
+    /// Return the size (in bytes) of the single-precision storage.
+    size_t GetMemorySize() const { return 2 * m_D.size() * sizeof(float); }
+
+    /// Access the i-th active constraint.
+    ChConstraint* GetConstraint(int i) const { return m_constraints[i]; }
+
+    /// Access the vector of the diagonal terms g_i = [Cq_i]*[invM]*[Cq_i]' + cfm_i.
+    const ChVectorDynamic<>& Get_g() const { return m_g; }
+
+    /// Access the vector of the b_i terms.
+    const ChVectorDynamic<>& Get_b() const { return m_b; }
+
+    /// Access the vector of the cfm_i terms.
+    const ChVectorDynamic<>& Get_cfm() const { return m_cfm; }
+
+    /// Return true if all projections can be evaluated by this object, without accessing the ChConstraint objects.
+    bool HasNativeProjection() const { return m_native; }
+
+    /// Return true if the i-th constraint is a component of a frictional contact.
+    bool IsFriction(int i) const { return m_type[i] == FRICTION || m_type[i] == CONE; }
+
+    /// Return the constraint violation corresponding to the residual c_i of the i-th constraint (as in
+    /// ChConstraint::Violation). Only valid if HasNativeProjection is true.
+    double Violation(int i, double c_i) const {
+        switch (m_type[i]) {
+            case UNILATERAL:
+                return c_i > 0 ? 0 : c_i;
+            case FRICTION:
+            case CONE:
+                return 0;
+            default:
+                return c_i;
+        }
+    }
+
+    /// Project the multipliers of the i-th constraint onto the admissible set (as in ChConstraint::Project).
+    /// For the normal component of a frictional contact, this projects the triplet l[i], l[i+1], l[i+2] onto the
+    /// friction cone. Only valid if HasNativeProjection is true.
+    template <typename Real>
+    void Project(int i, Real* l) const {
+        if (m_type[i] == UNILATERAL) {
+            if (l[i] < 0)
+                l[i] = 0;
+        } else if (m_type[i] == CONE) {
+            double f_n = l[i];
+            double f_u = l[i + 1];
+            double f_v = l[i + 2];
+            ProjectCone(m_friction[i], m_cohesion[i], f_n, f_u, f_v);
+            l[i] = (Real)f_n;
+            l[i + 1] = (Real)f_u;
+            l[i + 2] = (Real)f_v;
+        }
+    }
+
+    /// Project all multipliers onto the admissible set (as in ChSystemDescriptor::ConstraintsProject).
+    /// Only valid if HasNativeProjection is true.
+    void ConstraintsProject(ChVectorDynamic<>& l) const;
+
+    /// Compute [Cq_i]*q, accumulating in the precision 'Acc'.
+    template <typename Acc, typename Real>
+    Acc Compute_Cq_q(int i, const Real* q) const {
+        Acc sum = 0;
+        for (int k = m_row_blk[i]; k < m_row_blk[i + 1]; k++) {
+            const Real* qk = q + m_blk_col[k];
+            const float* D = m_D.data() + m_blk_ptr[k];
+            int n = m_blk_ptr[k + 1] - m_blk_ptr[k];
+            for (int j = 0; j < n; j++)
+                sum += (Acc)D[j] * (Acc)qk[j];
+        }
+        return sum;
+    }
+
+    /// Compute q += [invM]*[Cq_i]'*deltal, with the products evaluated in the precision 'Acc'.
+    template <typename Acc, typename Real>
+    void Increment_q(int i, Acc deltal, Real* q) const {
+        for (int k = m_row_blk[i]; k < m_row_blk[i + 1]; k++) {
+            Real* qk = q + m_blk_col[k];
+            const float* Et = m_Et.data() + m_blk_ptr[k];
+            int n = m_blk_ptr[k + 1] - m_blk_ptr[k];
+            for (int j = 0; j < n; j++)
+                qk[j] += (Real)((Acc)Et[j] * deltal);
+        }
+    }
+
+    /// Compute result = [N]*l = [Cq]*[invM]*[Cq]'*l + [E]*l, in the same form as
+    /// ChSystemDescriptor::ShurComplementProduct.
+    void ShurComplementProduct(ChVectorDynamic<>& result, const ChVectorDynamic<>& l);
+
+    /// Compute q += [invM]*[Cq]'*l (accumulating in double precision), where q has the size of the active unknowns.
+    void Compute_q(ChVectorDynamic<>& q, const ChVectorDynamic<>& l) const;
+
+  private:
+    /// Type of projection of each constraint.
+    enum ProjectionType : char {
+        BILATERAL,   ///< no projection
+        UNILATERAL,  ///< projection onto the positive half-line
+        CONE,        ///< normal component of a contact, projection of the triplet onto the friction cone
+        FRICTION,    ///< tangential component of a contact, projected with the normal component
+        CUSTOM       ///< projection implemented by the ChConstraint object
+    };
+
+    /// Project the contact forces onto the friction cone (as in ChConstraintTwoTuplesContactN::Project).
+    static void ProjectCone(double friction, double cohesion, double& f_n, double& f_u, double& f_v);
+
+    template <typename Acc>
+    void ShurComplementProduct(ChVectorDynamic<>& result, const ChVectorDynamic<>& l, std::vector<Acc>& tmp) const;
+
+    int m_nq;                                  ///< number of active unknowns q
+    bool m_double_acc;                         ///< accumulate products in double precision?
+    std::vector<ChConstraint*> m_constraints;  ///< active constraints, in offset order
+
+    std::vector<int> m_row_blk;  ///< first block of each constraint row (size nc+1)
+    std::vector<int> m_blk_col;  ///< first column of each block
+    std::vector<int> m_blk_ptr;  ///< first value of each block (size nblocks+1)
+    std::vector<float> m_D;      ///< values of [Cq]
+    std::vector<float> m_Et;     ///< values of ([invM]*[Cq]')'
+
+    bool m_native;                       ///< all projections evaluated on the compact data?
+    std::vector<ProjectionType> m_type;  ///< type of projection of each constraint
+    std::vector<double> m_friction;      ///< friction coefficient of the normal components of contacts
+    std::vector<double> m_cohesion;      ///< cohesion of the normal components of contacts
+
+    ChVectorDynamic<> m_g;    ///< diagonal terms g_i
+    ChVectorDynamic<> m_b;    ///< b_i terms
+    ChVectorDynamic<> m_cfm;  ///< cfm_i terms
+
+    std::vector<double> m_tmp_d;  ///< work vector [invM]*[Cq]'*l (double accumulation)
+    std::vector<float> m_tmp_f;   ///< work vector [invM]*[Cq]'*l (single accumulation)
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -33,6 +33,8 @@ class my_enum_mappers : public ChSolver {
     CH_ENUM_VAL(Type::MINRES);
     CH_ENUM_VAL(Type::BICGSTAB);
     CH_ENUM_VAL(Type::CUSTOM);
+    CH_ENUM_VAL(Type::SPARSE_SCHUR);
+    CH_ENUM_VAL(Type::ADMM);
     CH_ENUM_MAPPER_END(Type);
 };
 
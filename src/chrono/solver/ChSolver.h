@@ -52,6 +52,9 @@ class ChApi ChSolver {
         BICGSTAB,  ///< Bi-conjugate gradient stabilized
         // Other
         CUSTOM,
+        // Solver types added later (appended, so that the values of the types above are unchanged)
+        SPARSE_SCHUR,  ///< Sparse LDL^T factorization of the reduced (Schur complement) system
+        ADMM,          ///< Alternating Direction Method of Multipliers (iterative VI solver)
     };
 
     virtual ~ChSolver() {}
@@ -59,6 +62,11 @@ class ChApi ChSolver {
     /// Return type of the solver.
     virtual Type GetType() const { return Type::CUSTOM; }
 
+    /// "Virtual" copy constructor.
+    /// Return nullptr if the solver cannot be copied (default). Copies of a solver can be run concurrently on
+    /// independent problems (see ChSolverIslands).
+    virtual ChSolver* Clone() const { return nullptr; }
+
     /// Indicate whether or not the Solve() phase requires an up-to-date problem matrix.
     /// Typically, direct solvers only need the matrix for the Setup() phase. However, iterative solvers likely require
     /// the matrix to perform the necessary matrix-vector operations.
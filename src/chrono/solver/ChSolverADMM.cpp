@@ -0,0 +1,187 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/core/ChSparsityPatternLearner.h"
+#include "chrono/solver/ChConstraintTwoGenericBoxed.h"
+#include "chrono/solver/ChSolverADMM.h"
+
+namespace chrono {
+
+ChSolverADMM::ChSolverADMM() : ChSolverADMM(chrono_types::make_shared<ChSolverSparseLU>()) {}
+
+ChSolverADMM::ChSolverADMM(std::shared_ptr<ChDirectSolverLS> solver)
+    : m_ls(solver),
+      m_rho(1.0),
+      m_alpha(1.6),
+      m_adaptive(true),
+      m_adapt_interval(10),
+      m_adapt_max(2),
+      m_nq(0),
+      m_nc(0),
+      m_scale(1.0),
+      m_residual(0.0),
+      m_num_factorizations(0) {}
+
+void ChSolverADMM::EnableRhoAdaptation(bool val, int interval, int max_updates) {
+    m_adaptive = val;
+    m_adapt_interval = interval;
+    m_adapt_max = max_updates;
+}
+
+bool ChSolverADMM::Setup(ChSystemDescriptor& sysd) {
+    m_nq = sysd.CountActiveVariables();
+    m_nc = sysd.CountActiveConstraints();
+    int n = m_nq + m_nc;
+
+    // Flag the constraints solved without penalty and estimate the scale of the Schur complement from the
+    // diagonal terms g_i = [Cq_i]*[invM_i]*[Cq_i]' of the other constraints.
+    m_exact.resize(m_nc);
+    m_cfm.resize(m_nc);
+    double sum_g = 0;
+    int num_g = 0;
+    for (auto constr : sysd.GetConstraintsList()) {
+        if (!constr->IsActive())
+            continue;
+        int i = constr->GetOffset();
+        m_cfm(i) = constr->Get_cfm_i();
+        m_exact[i] = constr->GetMode() == CONSTRAINT_LOCK && !dynamic_cast<ChConstraintTwoGenericBoxed*>(constr);
+        if (!m_exact[i]) {
+            constr->Update_auxiliary();
+            sum_g += constr->Get_g_i();
+            num_g++;
+        }
+    }
+    m_scale = (num_g > 0 && sum_g > 0) ? sum_g / num_g : 1.0;
+
+    // Assemble the system matrix (the sparsity pattern changes with the contacts, so it is always re-evaluated)
+    ChSparseMatrix& mat = m_ls->GetMatrix();
+    ChSparsityPatternLearner sparsity_pattern(n, n);
+    sysd.ConvertToMatrixForm(&sparsity_pattern, nullptr);
+    sparsity_pattern.Apply(mat);
+    sysd.ConvertToMatrixForm(&mat, nullptr);
+    mat.makeCompressed();
+
+    m_num_factorizations = 0;
+    return Factorize();
+}
+
+bool ChSolverADMM::Factorize() {
+    // The lower-right block of the assembled matrix always has a (possibly zero) entry for each constraint.
+    ChSparseMatrix& mat = m_ls->GetMatrix();
+    double rho = m_rho * m_scale;
+    for (int i = 0; i < m_nc; i++)
+        mat.coeffRef(m_nq + i, m_nq + i) = m_exact[i] ? -m_cfm(i) : -m_cfm(i) - rho;
+
+    m_num_factorizations++;
+    return m_ls->SetupCurrent();
+}
+
+double ChSolverADMM::Solve(ChSystemDescriptor& sysd) {
+    sysd.ConvertToMatrixForm(nullptr, &m_d);
+
+    // Initial multipliers
+    if (m_warm_start) {
+        sysd.FromConstraintsToVector(m_z);
+        sysd.ConstraintsProject(m_z);
+    } else {
+        m_z.setZero(m_nc);
+    }
+    m_u.setZero(m_nc);
+
+    ChVectorDynamic<double>& rhs = m_ls->GetRHS();
+    const ChVectorDynamic<double>& sol = m_ls->GetSolution();
+
+    int num_updates = 0;
+    m_residual = 0;
+    for (m_iterations = 0; m_iterations < m_max_iterations; m_iterations++) {
+        double rho = m_rho * m_scale;
+
+        // Linear solve, with the matrix factorized in Setup
+        rhs = m_d;
+        for (int i = 0; i < m_nc; i++) {
+            if (!m_exact[i])
+                rhs(m_nq + i) += rho * (m_z(i) - m_u(i));
+        }
+        m_ls->SolveCurrent();
+        m_l = -sol.tail(m_nc);
+
+        // Projection onto the admissible set (with over-relaxation) and update of the scaled dual variables
+        m_z_old = m_z;
+        for (int i = 0; i < m_nc; i++) {
+            if (m_exact[i]) {
+                m_z(i) = m_l(i);
+                m_u(i) = 0;
+            } else {
+                m_l(i) = m_alpha * m_l(i) + (1 - m_alpha) * m_z_old(i);
+                m_z(i) = m_l(i) + m_u(i);
+            }
+        }
+        sysd.ConstraintsProject(m_z);
+        m_u += m_l - m_z;
+
+        // Primal and dual residuals
+        double res_p = 0;
+        double res_d = 0;
+        for (int i = 0; i < m_nc; i++) {
+            if (m_exact[i])
+                continue;
+            res_p = std::max(res_p, std::abs(m_l(i) - m_z(i)));
+            res_d = std::max(res_d, std::abs(m_z(i) - m_z_old(i)));
+        }
+        m_residual = rho * std::max(res_p, res_d);
+
+        if (record_violation_history)
+            AtIterationEnd(rho * res_p, rho * res_d, m_iterations);
+
+        if (m_residual <= m_tolerance) {
+            m_iterations++;
+            break;
+        }
+
+        // Balance the relative primal and dual residuals by scaling the penalty (and the scaled dual variables).
+        // No update if one of the residuals vanishes (e.g. no active contact): the penalty is kept for the next
+        // solves, so it must not degenerate to zero or infinity.
+        double norm_u = m_u.lpNorm<Eigen::Infinity>();
+        if (m_adaptive && num_updates < m_adapt_max && (m_iterations + 1) % m_adapt_interval == 0 && res_p > 0 &&
+            res_d > 0 && norm_u > 0) {
+            double scale_p = std::max(m_l.lpNorm<Eigen::Infinity>(), m_z.lpNorm<Eigen::Infinity>());
+            double norm_p = res_p / scale_p;
+            double norm_d = res_d / norm_u;
+            double ratio = ChClamp(std::sqrt(norm_p / norm_d), 1e-6 / m_rho, 1e6 / m_rho);
+            if (ratio > 5 || ratio < 0.2) {
+                m_rho *= ratio;
+                m_u /= ratio;
+                num_updates++;
+                if (!Factorize())
+                    break;
+            }
+        }
+    }
+
+    if (verbose) {
+        GetLog() << " ADMM solve  iterations = " << m_iterations << "  residual = " << m_residual
+                 << "  rho = " << m_rho * m_scale << "  factorizations = " << m_num_factorizations << "\n";
+    }
+
+    // Velocities from the last linear solve, multipliers projected onto the admissible set
+    ChVectorDynamic<> x = sol;
+    x.tail(m_nc) = -m_z;
+    sysd.FromVectorToUnknowns(x);
+
+    return m_residual;
+}
+
+}  // end namespace chrono
@@ -0,0 +1,131 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ADMM (Alternating Direction Method of Multipliers) solver for complementarity
+// problems with stiffness blocks, using a direct sparse linear solver.
+//
+// =============================================================================
+
+#ifndef CH_SOLVER_ADMM_H
+#define CH_SOLVER_ADMM_H
+
+#include <vector>
+
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChIterativeSolverVI.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// An ADMM (Alternating Direction Method of Multipliers) solver for VI and cone complementarity problems.\n
+/// Differently from the other iterative VI solvers, this solver uses the full system matrix, including the stiffness
+/// and damping blocks (ChKblock) of FEA elements, so it can be used for NSC problems with both contacts and FEA.
+/// The multipliers are split into l and a copy z constrained to the admissible set (friction cones, positive orthant
+/// for unilateral constraints). Each iteration solves the linear system
+/// <pre>
+///  | H  Cq'        |*| q|=| f              |
+///  | Cq -(E + rho) | |-l| |-b + rho*(z - u)|
+/// </pre>
+/// then sets z = Proj(l + u) and u = u + l - z. The matrix does not change between iterations, so it is factorized
+/// once (in Setup) by the direct linear solver and each iteration only requires a back-substitution and a projection.
+/// The penalty rho is not applied to bilateral constraints, which are therefore satisfied exactly at each iteration.
+/// The penalty is expressed relative to the mean diagonal of the Schur complement of the constraints and is, by
+/// default, adapted to balance the primal and dual residuals (each adaptation requires a new factorization).\n
+/// Bilateral constraints without compliance must not be redundant, as in the case of direct solvers.\n
+/// The stopping criterion uses the maximum of the primal residual (scaled by rho) and the dual residual, both in
+/// velocity units.
+///
+/// See ChSystemDescriptor for more information about the problem formulation and the data structures passed to the
+/// solver.
+class ChApi ChSolverADMM : public ChIterativeSolverVI {
+  public:
+    /// Construct an ADMM solver using a ChSolverSparseLU linear solver.
+    ChSolverADMM();
+
+    /// Construct an ADMM solver using the specified direct linear solver.
+    ChSolverADMM(std::shared_ptr<ChDirectSolverLS> solver);
+
+    ~ChSolverADMM() {}
+
+    virtual Type GetType() const override { return Type::ADMM; }
+
+    /// Access the direct linear solver.
+    std::shared_ptr<ChDirectSolverLS> GetLinearSolver() const { return m_ls; }
+
+    /// Set the penalty rho, relative to the mean diagonal of the Schur complement (default: 1).
+    void SetRho(double rho) { m_rho = rho; }
+
+    /// Return the current (possibly adapted) relative penalty.
+    double GetRho() const { return m_rho; }
+
+    /// Set the over-relaxation factor, in [1, 2) (default: 1.6).
+    void SetAlpha(double alpha) { m_alpha = alpha; }
+
+    /// Enable/disable the adaptation of the penalty (default: true).
+    /// If enabled, rho is updated at most 'max_updates' times per solve, every 'interval' iterations.
+    /// The adapted rho is kept for the following solves, within [1e-6, 1e6].
+    void EnableRhoAdaptation(bool val, int interval = 10, int max_updates = 2);
+
+    /// Return the number of factorizations performed since the last call to Setup (included).
+    int GetNumFactorizations() const { return m_num_factorizations; }
+
+    /// Return the tolerance error reached during the last solve.
+    /// For the ADMM solver, this is the maximum of the scaled primal residual and the dual residual.
+    virtual double GetError() const override { return m_residual; }
+
+    /// Perform the solver setup operations: assemble the system matrix (with stiffness blocks) and factorize it.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+    /// Performs the solution of the problem.
+    virtual double Solve(ChSystemDescriptor& sysd) override;
+
+    /// The ADMM solver only requires the matrix in its Setup phase.
+    virtual bool SolveRequiresMatrix() const override { return false; }
+
+  private:
+    virtual void SetSolveStatistics(int iterations, double error) override {
+        m_iterations = iterations;
+        m_residual = error;
+    }
+
+    /// Load the penalty in the lower-right block of the system matrix and factorize it.
+    bool Factorize();
+
+    std::shared_ptr<ChDirectSolverLS> m_ls;  ///< direct linear solver
+    double m_rho;                            ///< relative penalty
+    double m_alpha;                          ///< over-relaxation factor
+    bool m_adaptive;                         ///< adapt the penalty?
+    int m_adapt_interval;                    ///< number of iterations between penalty updates
+    int m_adapt_max;                         ///< maximum number of penalty updates per solve
+
+    int m_nq;                   ///< number of active variables
+    int m_nc;                   ///< number of active constraints
+    double m_scale;             ///< mean diagonal of the Schur complement
+    double m_residual;          ///< residual at the last solve
+    int m_num_factorizations;   ///< factorizations since the last setup
+    std::vector<bool> m_exact;  ///< constraints solved without penalty (bilateral)
+    ChVectorDynamic<> m_cfm;    ///< constraint compliance
+
+    ChVectorDynamic<> m_d;      ///< right-hand side {f; -b}
+    ChVectorDynamic<> m_l;      ///< multipliers from the linear solve
+    ChVectorDynamic<> m_z;      ///< projected multipliers
+    ChVectorDynamic<> m_z_old;  ///< projected multipliers at the previous iteration
+    ChVectorDynamic<> m_u;      ///< scaled dual variables
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
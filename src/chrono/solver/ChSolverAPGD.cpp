@@ -47,12 +47,19 @@ void ChSolverAPGD::ShurBvectorCompute(ChSystemDescriptor& sysd) {
 
     // ...and now do  b_shur = - D'*q = - D'*(M^-1)*k ..
     r.setZero();
-    int s_i = 0;
-    for (unsigned int ic = 0; ic < sysd.GetConstraintsList().size(); ic++)
-        if (sysd.GetConstraintsList()[ic]->IsActive()) {
-            r(s_i, 0) = sysd.GetConstraintsList()[ic]->Compute_Cq_q();
-            ++s_i;
-        }
+    if (m_use_schur) {
+        ChVectorDynamic<> q;
+        sysd.FromVariablesToVector(q, true);
+        for (int ic = 0; ic < nc; ic++)
+            r(ic) = m_schur.Compute_Cq_q<double>(ic, q.data());
+    } else {
+        int s_i = 0;
+        for (unsigned int ic = 0; ic < sysd.GetConstraintsList().size(); ic++)
+            if (sysd.GetConstraintsList()[ic]->IsActive()) {
+                r(s_i, 0) = sysd.GetConstraintsList()[ic]->Compute_Cq_q();
+                ++s_i;
+            }
+    }
 
     // ..and finally do   b_shur = b_shur - c
     sysd.BuildBiVector(tmp);  // b_i   =   -c   = phi/h
@@ -63,10 +70,10 @@ double ChSolverAPGD::Res4(ChSystemDescriptor& sysd) {
     // Project the gradient (for rollback strategy)
     // g_proj = (l-project_orthogonal(l - gdiff*g, fric))/gdiff;
     double gdiff = 1.0 / (nc * nc);
-    sysd.ShurComplementProduct(tmp, gammaNew);  // tmp = N * gammaNew
-    tmp = gammaNew - gdiff * (tmp + r);         // Note: no aliasing issues here
-    sysd.ConstraintsProject(tmp);               // tmp = ProjectionOperator(gammaNew - gdiff * g)
-    tmp = (gammaNew - tmp) / gdiff;             // Note: no aliasing issues here
+    ShurComplementProduct(sysd, tmp, gammaNew);  // tmp = N * gammaNew
+    tmp = gammaNew - gdiff * (tmp + r);          // Note: no aliasing issues here
+    ConstraintsProject(sysd, tmp);               // tmp = ProjectionOperator(gammaNew - gdiff * g)
+    tmp = (gammaNew - tmp) / gdiff;              // Note: no aliasing issues here
 
     return tmp.norm();
 }
@@ -81,8 +88,11 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
 
     // Update auxiliary data in all constraints before starting,
     // that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-        mconstraints[ic]->Update_auxiliary();
+    // (or load the same data in single precision, in reduced-precision modes)
+    if (!LoadSchurComplement(sysd)) {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            mconstraints[ic]->Update_auxiliary();
+    }
 
     double L, t;
     double theta;
@@ -122,9 +132,11 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
 
     // (1) gamma_0 = zeros(nc,1)
     if (m_warm_start) {
-        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-            if (mconstraints[ic]->IsActive())
-                mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+        if (!m_use_schur) {
+            for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+                if (mconstraints[ic]->IsActive())
+                    mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+        }
     } else {
         for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
             mconstraints[ic]->Set_l_i(0.);
@@ -143,7 +155,7 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
     // (5) L_k = norm(N * (gamma_0 - gamma_hat_0)) / norm(gamma_0 - gamma_hat_0)
     tmp = gamma - gamma_hat;
     L = tmp.norm();
-    sysd.ShurComplementProduct(yNew, tmp, nullptr);  // yNew = N * tmp = N * (gamma - gamma_hat)
+    ShurComplementProduct(sysd, yNew, tmp);  // yNew = N * tmp = N * (gamma - gamma_hat)
     L = yNew.norm() / L;
     yNew.setZero();  //// RADU  is this really necessary here?
 
@@ -157,16 +169,16 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
     for (m_iterations = 0; m_iterations < m_max_iterations; m_iterations++) {
         // (8) g = N * y_k - r
         // (9) gamma_(k+1) = ProjectionOperator(y_k - t_k * g)
-        sysd.ShurComplementProduct(g, y);  // g = N * y
+        ShurComplementProduct(sysd, g, y);  // g = N * y
         gammaNew = y - t * (g + r);
-        sysd.ConstraintsProject(gammaNew);
+        ConstraintsProject(sysd, gammaNew);
 
         // (10) while 0.5 * gamma_(k+1)' * N * gamma_(k+1) - gamma_(k+1)' * r >=
         //            0.5 * y_k' * N * y_k - y_k' * r + g' * (gamma_(k+1) - y_k) + 0.5 * L_k * norm(gamma_(k+1) - y_k)^2
-        sysd.ShurComplementProduct(tmp, gammaNew);  // tmp = N * gammaNew;
+        ShurComplementProduct(sysd, tmp, gammaNew);  // tmp = N * gammaNew;
         obj1 = gammaNew.dot(0.5 * tmp + r);
 
-        sysd.ShurComplementProduct(tmp, y);  // tmp = N * y;
+        ShurComplementProduct(sysd, tmp, y);  // tmp = N * y;
         obj2 = y.dot(0.5 * tmp + r) + (gammaNew - y).dot(g + 0.5 * L * (gammaNew - y));
 
         while (obj1 >= obj2) {
@@ -178,13 +190,13 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
 
             // (13) gamma_(k+1) = ProjectionOperator(y_k - t_k * g)
             gammaNew = y - t * g;
-            sysd.ConstraintsProject(gammaNew);
+            ConstraintsProject(sysd, gammaNew);
 
             // Update obj1 and obj2
-            sysd.ShurComplementProduct(tmp, gammaNew);  // tmp = N * gammaNew;
+            ShurComplementProduct(sysd, tmp, gammaNew);  // tmp = N * gammaNew;
             obj1 = gammaNew.dot(0.5 * tmp + r);
 
-            sysd.ShurComplementProduct(tmp, y);  // tmp = N * y;
+            ShurComplementProduct(sysd, tmp, y);  // tmp = N * y;
             obj2 = y.dot(0.5 * tmp + r) + (gammaNew - y).dot(g + 0.5 * L * (gammaNew - y));
         }  // (14) endwhile
 
@@ -239,13 +251,19 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
 
     // Resulting PRIMAL variables:
     // compute the primal variables as   v = (M^-1)(k + D*l)
+    // (in reduced-precision modes, the term (M^-1)*D*l is added to the backup vector before rewinding)
+    if (m_use_schur)
+        m_schur.Compute_q(Minvk, gamma_hat);
+
     // v = (M^-1)*k  ...    (by rewinding to the backup vector computed at the beginning)
     sysd.FromVectorToVariables(Minvk);
 
     // ... + (M^-1)*D*l     (this increment and also stores 'qb' in the ChVariable items)
-    for (size_t ic = 0; ic < mconstraints.size(); ic++) {
-        if (mconstraints[ic]->IsActive())
-            mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+    if (!m_use_schur) {
+        for (size_t ic = 0; ic < mconstraints.size(); ic++) {
+            if (mconstraints[ic]->IsActive())
+                mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+        }
     }
 
     return residual;
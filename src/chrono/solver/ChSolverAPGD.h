@@ -34,6 +34,9 @@ class ChApi ChSolverAPGD : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::APGD; }
 
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChSolverAPGD* Clone() const override { return new ChSolverAPGD(*this); }
+
     /// Performs the solution of the problem.
     virtual double Solve(ChSystemDescriptor& sysd) override;
 
@@ -45,6 +48,11 @@ class ChApi ChSolverAPGD : public ChIterativeSolverVI {
     void Dump_Lambda(std::vector<double>& temp);
 
   private:
+    virtual void SetSolveStatistics(int iterations, double error) override {
+        m_iterations = iterations;
+        residual = error;
+    }
+
     void ShurBvectorCompute(ChSystemDescriptor& sysd);
     double Res4(ChSystemDescriptor& sysd);
 
@@ -68,34 +68,40 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
 
     // Update auxiliary data in all constraints before starting,
     // that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-        mconstraints[ic]->Update_auxiliary();
-
-    // Average all g_i for the triplet of contact constraints n,u,v.
-    //  Can be used for the fixed point phase and/or by preconditioner.
-    int j_friction_comp = 0;
-    double gi_values[3];
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
-        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
-            gi_values[j_friction_comp] = mconstraints[ic]->Get_g_i();
-            j_friction_comp++;
-            if (j_friction_comp == 3) {
-                double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
-                mconstraints[ic - 2]->Set_g_i(average_g_i);
-                mconstraints[ic - 1]->Set_g_i(average_g_i);
-                mconstraints[ic - 0]->Set_g_i(average_g_i);
-                j_friction_comp = 0;
+    // (or load the same data in single precision, in reduced-precision modes)
+    if (LoadSchurComplement(sysd)) {
+        // The vector with the diagonal of the N matrix (averaged for the triplets of contact constraints)
+        mD = m_schur.Get_g();
+    } else {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            mconstraints[ic]->Update_auxiliary();
+
+        // Average all g_i for the triplet of contact constraints n,u,v.
+        //  Can be used for the fixed point phase and/or by preconditioner.
+        int j_friction_comp = 0;
+        double gi_values[3];
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
+            if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+                gi_values[j_friction_comp] = mconstraints[ic]->Get_g_i();
+                j_friction_comp++;
+                if (j_friction_comp == 3) {
+                    double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
+                    mconstraints[ic - 2]->Set_g_i(average_g_i);
+                    mconstraints[ic - 1]->Set_g_i(average_g_i);
+                    mconstraints[ic - 0]->Set_g_i(average_g_i);
+                    j_friction_comp = 0;
+                }
             }
         }
+        // The vector with the diagonal of the N matrix
+        mD.setZero();
+        int d_i = 0;
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            if (mconstraints[ic]->IsActive()) {
+                mD(d_i, 0) = mconstraints[ic]->Get_g_i();
+                ++d_i;
+            }
     }
-    // The vector with the diagonal of the N matrix
-    mD.setZero();
-    int d_i = 0;
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-        if (mconstraints[ic]->IsActive()) {
-            mD(d_i, 0) = mconstraints[ic]->Get_g_i();
-            ++d_i;
-        }
 
     // ***TO DO*** move the following thirty lines in a short function ChSystemDescriptor::ShurBvectorCompute() ?
 
@@ -111,24 +117,29 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
         if (mvariables[iv]->IsActive())
             mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
 
+    // Optimization: backup the  q  sparse data computed above,
+    // because   (M^-1)*k   will be needed at the end when computing primals.
+    ChVectorDynamic<> mq;
+    sysd.FromVariablesToVector(mq, true);
+
     // ...and now do  b_shur = - D'*q = - D'*(M^-1)*k ..
     mb.setZero();
-    int s_i = 0;
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-        if (mconstraints[ic]->IsActive()) {
-            mb(s_i, 0) = -mconstraints[ic]->Compute_Cq_q();
-            ++s_i;
-        }
+    if (m_use_schur) {
+        for (int ic = 0; ic < nc; ic++)
+            mb(ic) = -m_schur.Compute_Cq_q<double>(ic, mq.data());
+    } else {
+        int s_i = 0;
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            if (mconstraints[ic]->IsActive()) {
+                mb(s_i, 0) = -mconstraints[ic]->Compute_Cq_q();
+                ++s_i;
+            }
+    }
 
     // ..and finally do   b_shur = b_shur - c
     sysd.BuildBiVector(mb_tmp);  // b_i   =   -c   = phi/h
     mb -= mb_tmp;
 
-    // Optimization: backup the  q  sparse data computed above,
-    // because   (M^-1)*k   will be needed at the end when computing primals.
-    ChVectorDynamic<> mq;
-    sysd.FromVariablesToVector(mq, true);
-
     // Initialize lambdas
     if (m_warm_start)
         sysd.FromConstraintsToVector(ml);
@@ -136,7 +147,7 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
         ml.setZero();
 
     // Initial projection of ml   ***TO DO***?
-    sysd.ConstraintsProject(ml);
+    ConstraintsProject(sysd, ml);
 
     // Fallback solution
     double lastgoodfval = 1e30;
@@ -145,8 +156,8 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
 
     // g = gradient of 0.5*l'*N*l-l'*b
     // g = N*l-b
-    sysd.ShurComplementProduct(mg, ml);  // 1)  g = N * l
-    mg -= mb;                            // 2)  g = N * l - b_shur
+    ShurComplementProduct(sysd, mg, ml);  // 1)  g = N * l
+    mg -= mb;                             // 2)  g = N * l - b_shur
 
     mg_p = mg;
 
@@ -165,9 +176,9 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
             mDg = mDg.array() / mD.array();
 
         // dir  = [P(l - alpha*Dg) - l]
-        mdir = ml - alpha * mDg;        // dir = l - alpha*Dg
-        sysd.ConstraintsProject(mdir);  // dir = P(l - alpha*Dg)
-        mdir -= ml;                     // dir = P(l - alpha*Dg) - l
+        mdir = ml - alpha * mDg;         // dir = l - alpha*Dg
+        ConstraintsProject(sysd, mdir);  // dir = P(l - alpha*Dg)
+        mdir -= ml;                      // dir = P(l - alpha*Dg) - l
 
         // dTg = dir'*g;
         double dTg = mdir.dot(mg);
@@ -175,9 +186,9 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
         // BB dir backward!? fallback to nonpreconditioned dir
         if (dTg > 1e-8) {
             // dir  = [P(l - alpha*g) - l]
-            mdir = ml - alpha * mg;         // dir = l - alpha*g
-            sysd.ConstraintsProject(mdir);  // dir = P(l - alpha*g) ...
-            mdir -= ml;                     // dir = P(l - alpha*g) - l
+            mdir = ml - alpha * mg;          // dir = l - alpha*g
+            ConstraintsProject(sysd, mdir);  // dir = P(l - alpha*g) ...
+            mdir -= ml;                      // dir = P(l - alpha*g) - l
             // dTg = d'*g;
             dTg = mdir.dot(mg);
         }
@@ -192,7 +203,7 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
             ml_p = ml + lambda * mdir;
 
             // m_tmp = Nl_p = N*l_p;
-            sysd.ShurComplementProduct(mb_tmp, ml_p);
+            ShurComplementProduct(sysd, mb_tmp, ml_p);
 
             // g_p = N * l_p - b  = Nl_p - b
             mg_p = mb_tmp - mb;
@@ -285,7 +296,7 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
         // Project the gradient (for rollback strategy)
         // g_proj = (l-project_orthogonal(l - gdiff*g, fric))/gdiff;
         mb_tmp = ml - gdiff * mg;
-        sysd.ConstraintsProject(mb_tmp);     // mb_tmp = ProjectionOperator(l - gdiff * g)
+        ConstraintsProject(sysd, mb_tmp);    // mb_tmp = ProjectionOperator(l - gdiff * g)
         mb_tmp = (ml - mb_tmp) / gdiff;      // mb_tmp = [l - ProjectionOperator(l - gdiff * g)] / gdiff
         double g_proj_norm = mb_tmp.norm();  // infinity norm is faster..
 
@@ -332,13 +343,19 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
     // Resulting PRIMAL variables:
     // compute the primal variables as   v = (M^-1)(k + D*l)
 
+    // (in reduced-precision modes, the term (M^-1)*D*l is added to the backup vector before rewinding)
+    if (m_use_schur)
+        m_schur.Compute_q(mq, ml);
+
     // v = (M^-1)*k  ...    (by rewinding to the backup vector computed ad the beginning)
     sysd.FromVectorToVariables(mq);
 
     // ... + (M^-1)*D*l     (this increment and also stores 'qb' in the ChVariable items)
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
-        if (mconstraints[ic]->IsActive())
-            mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+    if (!m_use_schur) {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
+            if (mconstraints[ic]->IsActive())
+                mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+        }
     }
 
     if (verbose)
@@ -36,6 +36,9 @@ class ChApi ChSolverBB : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::BARZILAIBORWEIN; }
 
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChSolverBB* Clone() const override { return new ChSolverBB(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -60,6 +63,11 @@ class ChApi ChSolverBB : public ChIterativeSolverVI {
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
 
   private:
+    virtual void SetSolveStatistics(int iterations, double error) override {
+        m_iterations = iterations;
+        lastgoodres = error;
+    }
+
     int n_armijo;
     int max_armijo_backtrace;
     double lastgoodres;
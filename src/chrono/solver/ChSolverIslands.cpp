@@ -0,0 +1,226 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/solver/ChIterativeSolverVI.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSolverIslands.h"
+
+namespace chrono {
+
+ChSolverIslands::ChSolverIslands(std::shared_ptr<ChSolver> solver)
+    : m_solver(solver), m_copies_valid(false), m_min_size(64), m_num_threads(0), m_num_islands(0), m_num_units(0) {}
+
+void ChSolverIslands::SetSolver(std::shared_ptr<ChSolver> solver) {
+    m_solver = solver;
+    m_copies_valid = false;
+}
+
+bool ChSolverIslands::UpdateCopies(int nthreads) {
+    if (!m_copies_valid || (int)m_copies.size() != nthreads) {
+        m_copies.resize(nthreads);
+        for (auto& s : m_copies)
+            s.reset(m_solver->Clone());
+        m_copies_valid = true;
+    }
+    if (!m_copies[0])
+        return false;
+
+    // Generic settings, which may have changed on the wrapped solver since the copies were made
+    if (auto vi_solver = std::dynamic_pointer_cast<ChIterativeSolverVI>(m_solver)) {
+        for (auto& s : m_copies) {
+            auto copy = static_cast<ChIterativeSolverVI*>(s.get());
+            copy->SetMaxIterations(vi_solver->GetMaxIterations());
+            copy->SetTolerance(vi_solver->GetTolerance());
+            copy->EnableDiagonalPreconditioner(vi_solver->m_use_precond);
+            copy->EnableWarmStart(vi_solver->m_warm_start);
+            copy->SetOmega(vi_solver->GetOmega());
+            copy->SetSharpnessLambda(vi_solver->GetSharpnessLambda());
+            copy->SetPrecision(vi_solver->GetPrecision());
+        }
+    }
+
+    return true;
+}
+
+bool ChSolverIslands::Partition(ChSystemDescriptor& sysd) {
+    std::vector<ChVariables*>& vvariables = sysd.GetVariablesList();
+    std::vector<ChConstraint*>& vconstraints = sysd.GetConstraintsList();
+    std::vector<ChKblock*>& vstiffness = sysd.GetKblocksList();
+
+    m_num_islands = 1;
+    m_num_units = 1;
+
+    // Index the active variables through their offsets in the system-level vectors
+    sysd.UpdateCountsAndOffsets();
+    int n_q = sysd.CountActiveVariables();
+    m_var_of_offset.assign(n_q, -1);
+    int nv = 0;
+    for (auto var : vvariables) {
+        if (var->IsActive())
+            m_var_of_offset[var->GetOffset()] = nv++;
+    }
+    auto index_of = [this](ChVariables* var) {
+        return (var && var->IsActive()) ? m_var_of_offset[var->GetOffset()] : -1;
+    };
+
+    // Union-find over the variables coupled by constraints and stiffness blocks.
+    // Each coupling item is associated to its first active variable (-1 if it has none). Active constraints without
+    // active variables (e.g. a joint between a fixed and a sleeping body) do not belong to any island: they cannot
+    // act on the system, and their multipliers are set to zero.
+    m_sets.Reset(nv);
+    auto join = [this, &index_of]() {
+        int first = -1;
+        for (auto var : m_tmp_vars) {
+            int k = index_of(var);
+            if (k < 0)
+                continue;
+            if (first < 0)
+                first = k;
+            else
+                m_sets.Union(first, k);
+        }
+        return first;
+    };
+
+    std::vector<int> constraint_var(vconstraints.size(), -1);
+    for (size_t ic = 0; ic < vconstraints.size(); ic++) {
+        if (!vconstraints[ic]->IsActive())
+            continue;
+        m_tmp_vars.clear();
+        if (!vconstraints[ic]->AppendVariables(m_tmp_vars))
+            return false;
+        constraint_var[ic] = join();
+    }
+
+    std::vector<int> kblock_var(vstiffness.size(), -1);
+    for (size_t ik = 0; ik < vstiffness.size(); ik++) {
+        auto kblock = dynamic_cast<ChKblockGeneric*>(vstiffness[ik]);
+        if (!kblock)
+            return false;
+        m_tmp_vars.clear();
+        for (unsigned int j = 0; j < kblock->GetNvars(); j++)
+            m_tmp_vars.push_back(kblock->GetVariableN(j));
+        kblock_var[ik] = join();
+    }
+
+    // Islands, with their number of unknowns
+    std::vector<int> island_of_var(nv);
+    std::vector<int> island_of_root(nv, -1);
+    std::vector<int> island_size;
+    int iv = 0;
+    for (auto var : vvariables) {
+        if (!var->IsActive())
+            continue;
+        int root = m_sets.Find(iv);
+        if (island_of_root[root] < 0) {
+            island_of_root[root] = (int)island_size.size();
+            island_size.push_back(0);
+        }
+        island_of_var[iv] = island_of_root[root];
+        island_size[island_of_var[iv]] += var->Get_ndof();
+        iv++;
+    }
+    for (size_t ic = 0; ic < vconstraints.size(); ic++) {
+        if (constraint_var[ic] >= 0)
+            island_size[island_of_var[constraint_var[ic]]]++;
+    }
+    m_num_islands = (int)island_size.size();
+
+    // Work units: largest islands first (for load balancing); small islands are packed together
+    std::vector<int> order(m_num_islands);
+    for (int i = 0; i < m_num_islands; i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&island_size](int a, int b) { return island_size[a] > island_size[b]; });
+
+    std::vector<int> unit_of_island(m_num_islands);
+    m_num_units = 0;
+    int unit_size = 0;
+    for (int i : order) {
+        if (m_num_units == 0 || unit_size >= m_min_size) {
+            m_num_units++;
+            unit_size = 0;
+        }
+        unit_of_island[i] = m_num_units - 1;
+        unit_size += island_size[i];
+    }
+
+    if (m_num_units <= 1)
+        return true;
+
+    // Fill the descriptors of the work units, keeping the order of the system-level lists
+    while ((int)m_units.size() < m_num_units)
+        m_units.push_back(std::unique_ptr<ChSystemDescriptor>(new ChSystemDescriptor));
+    for (int u = 0; u < m_num_units; u++) {
+        m_units[u]->BeginInsertion();
+        m_units[u]->SetMassFactor(sysd.GetMassFactor());
+    }
+
+    iv = 0;
+    for (auto var : vvariables) {
+        if (!var->IsActive())
+            continue;
+        m_units[unit_of_island[island_of_var[iv]]]->InsertVariables(var);
+        iv++;
+    }
+    for (size_t ic = 0; ic < vconstraints.size(); ic++) {
+        if (constraint_var[ic] >= 0)
+            m_units[unit_of_island[island_of_var[constraint_var[ic]]]]->InsertConstraint(vconstraints[ic]);
+        else if (vconstraints[ic]->IsActive())
+            vconstraints[ic]->Set_l_i(0);
+    }
+    for (size_t ik = 0; ik < vstiffness.size(); ik++) {
+        if (kblock_var[ik] >= 0)
+            m_units[unit_of_island[island_of_var[kblock_var[ik]]]]->InsertKblock(vstiffness[ik]);
+    }
+
+    return true;
+}
+
+double ChSolverIslands::Solve(ChSystemDescriptor& sysd) {
+    // One copy of the wrapped solver per thread
+    int nthreads = m_num_threads > 0 ? m_num_threads : CHOMPfunctions::GetMaxThreads();
+
+    if (!UpdateCopies(nthreads) || !Partition(sysd) || m_num_units <= 1) {
+        return m_solver->Solve(sysd);
+    }
+
+    // Solve the work units concurrently. The offsets of the variables and constraints are
+    // set relative to each work unit, then restored for the whole system.
+    std::vector<double> results(m_num_units);
+    std::vector<int> iterations(m_num_units, 0);
+    std::vector<double> errors(m_num_units, 0);
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+    for (int u = 0; u < m_num_units; u++) {
+        m_units[u]->EndInsertion();
+        ChSolver* solver = m_copies[CHOMPfunctions::GetThreadNum()].get();
+        results[u] = solver->Solve(*m_units[u]);
+        if (auto iter_solver = dynamic_cast<ChIterativeSolver*>(solver)) {
+            iterations[u] = iter_solver->GetIterations();
+            errors[u] = iter_solver->GetError();
+        }
+    }
+
+    sysd.UpdateCountsAndOffsets();
+
+    // Report the statistics of the worst work unit on the wrapped solver
+    if (auto vi_solver = std::dynamic_pointer_cast<ChIterativeSolverVI>(m_solver)) {
+        int worst = (int)(std::max_element(errors.begin(), errors.end()) - errors.begin());
+        vi_solver->SetSolveStatistics(iterations[worst], errors[worst]);
+    }
+
+    return *std::max_element(results.begin(), results.end());
+}
+
+}  // end namespace chrono
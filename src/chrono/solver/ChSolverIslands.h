@@ -0,0 +1,105 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSOLVER_ISLANDS_H
+#define CHSOLVER_ISLANDS_H
+
+#include <memory>
+#include <vector>
+
+#include "chrono/core/ChDisjointSets.h"
+#include "chrono/solver/ChSolver.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Solver that partitions the problem into independent islands and solves them in parallel.\n
+/// At each Solve(), the active variables are grouped with a union-find pass over the active constraints
+/// (joints, contacts) and the stiffness blocks: two variables are in the same island if they are coupled,
+/// directly or indirectly. Inactive variables (fixed or sleeping bodies) do not couple islands, and active
+/// constraints acting only on inactive variables get zero multipliers. Each island gets its own
+/// ChSystemDescriptor, holding the subset of variables and constraints, and it is solved with a copy of the
+/// wrapped solver (see ChSolver::Clone), islands being distributed over the OpenMP threads.\n
+/// This is meant for iterative VI solvers (PSOR, APGD, BB, etc.) in scenes made of many decoupled clusters of
+/// bodies. If the wrapped solver cannot be copied, or if some constraint does not report its variables (see
+/// ChConstraint::AppendVariables), the whole problem is passed to the wrapped solver.\n
+/// Settings such as the number of iterations and the tolerance must be set on the wrapped solver. The copies of the
+/// wrapped solver are created at the first Solve() and reused; they are recreated if the number of threads changes
+/// or after SetSolver(). The generic settings of iterative VI solvers (iterations, tolerance, preconditioning, warm
+/// start, omega, sharpness, precision) are copied to them at each Solve(); after changing other settings of the
+/// wrapped solver, call SetSolver() again to refresh the copies.\n
+/// After a partitioned solve, the number of iterations and the error of the wrapped iterative solver (see
+/// ChIterativeSolver::GetIterations and ChIterativeSolver::GetError) are those of the work unit with the largest error.
+
+class ChApi ChSolverIslands : public ChSolver {
+  public:
+    ChSolverIslands(std::shared_ptr<ChSolver> solver);
+
+    ~ChSolverIslands() {}
+
+    /// Access the wrapped solver.
+    std::shared_ptr<ChSolver> GetSolver() const { return m_solver; }
+
+    /// Set the wrapped solver. The copies used for the islands are recreated at the next Solve().
+    void SetSolver(std::shared_ptr<ChSolver> solver);
+
+    /// Set the minimum number of unknowns (degrees of freedom plus constraints) of a work unit (default: 64).
+    /// Smaller islands are packed together into work units of at least this size, to limit the overhead.
+    void SetMinIslandSize(int size) { m_min_size = size; }
+
+    /// Set the number of OpenMP threads (default: 0, i.e. the OpenMP default).
+    void SetNumThreads(int nthreads) { m_num_threads = nthreads; }
+
+    /// Return the number of islands found during the last solve.
+    int GetNumIslands() const { return m_num_islands; }
+
+    /// Return the number of work units (descriptors) solved during the last solve.
+    int GetNumWorkUnits() const { return m_num_units; }
+
+    virtual bool SolveRequiresMatrix() const override { return m_solver->SolveRequiresMatrix(); }
+
+    virtual bool Setup(ChSystemDescriptor& sysd) override { return m_solver->Setup(sysd); }
+
+    /// Performs the solution of the problem, island by island.
+    /// \return  the maximum of the values returned by the wrapped solver for the islands.
+    virtual double Solve(ChSystemDescriptor& sysd) override;
+
+  private:
+    /// Partition the active variables and constraints of the descriptor into work units.
+    /// Return false if the problem cannot be partitioned.
+    bool Partition(ChSystemDescriptor& sysd);
+
+    /// Create the copies of the wrapped solver (one per thread), if needed, and update their settings.
+    /// Return false if the wrapped solver cannot be copied.
+    bool UpdateCopies(int nthreads);
+
+    std::shared_ptr<ChSolver> m_solver;
+    std::vector<std::unique_ptr<ChSolver>> m_copies;  ///< copies of the wrapped solver, one per thread
+    bool m_copies_valid;                              ///< copies up to date with the wrapped solver?
+    int m_min_size;
+    int m_num_threads;
+    int m_num_islands;
+    int m_num_units;
+
+    ChDisjointSets m_sets;
+    std::vector<ChVariables*> m_tmp_vars;
+    std::vector<int> m_var_of_offset;
+    std::vector<std::unique_ptr<ChSystemDescriptor>> m_units;
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -35,6 +35,9 @@ class ChApi ChSolverPJacobi : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::PJACOBI; }
 
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChSolverPJacobi* Clone() const override { return new ChSolverPJacobi(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -45,6 +48,11 @@ class ChApi ChSolverPJacobi : public ChIterativeSolverVI {
     virtual double GetError() const override { return maxviolation; }
 
   private:
+    virtual void SetSolveStatistics(int iterations, double error) override {
+        m_iterations = iterations;
+        maxviolation = error;
+    }
+
     double maxviolation;
 };
 
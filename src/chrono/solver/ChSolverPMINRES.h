@@ -43,6 +43,9 @@ ChSolverPMINRES : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::PMINRES; }
 
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChSolverPMINRES* Clone() const override { return new ChSolverPMINRES(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -81,6 +84,11 @@ ChSolverPMINRES : public ChIterativeSolverVI {
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
 
   private:
+    virtual void SetSolveStatistics(int iterations, double error) override {
+        m_iterations = iterations;
+        r_proj_resid = error;
+    }
+
     double grad_diffstep;
     double rel_tolerance;
     double r_proj_resid;
@@ -23,6 +23,9 @@ CH_FACTORY_REGISTER(ChSolverPSOR)
 ChSolverPSOR::ChSolverPSOR() : maxviolation(0) {}
 
 double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
+    if (LoadSchurComplement(sysd))
+        return m_precision == Precision::MIXED ? SolveSchur<double>(sysd) : SolveSchur<float>(sysd);
+
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
@@ -187,4 +190,134 @@ double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
     return maxviolation;
 }
 
+template <typename Real>
+double ChSolverPSOR::SolveSchur(ChSystemDescriptor& sysd) {
+    const ChSchurComplementFloat& N = m_schur;
+    const ChVectorDynamic<>& g = N.Get_g();
+    const ChVectorDynamic<>& b = N.Get_b();
+    const ChVectorDynamic<>& cfm = N.Get_cfm();
+    int nc = N.GetNumConstraints();
+    bool native = N.HasNativeProjection();
+
+    m_iterations = 0;
+    maxviolation = 0;
+    double maxdeltalambda = 0.;
+    int i_friction_comp = 0;
+    Real old_lambda_friction[3];
+
+    // Initial guess for the unconstrained system q = [M]'*fb, kept in double precision for the final update
+    for (auto var : sysd.GetVariablesList()) {
+        if (var->IsActive())
+            var->Compute_invMb_v(var->Get_qb(), var->Get_fb());
+    }
+    ChVectorDynamic<> q0;
+    sysd.FromVariablesToVector(q0, true);
+
+    // Velocities and multipliers in the iteration precision (double in mixed-precision mode)
+    ChVectorDynamic<Real> q = q0.cast<Real>();
+    ChVectorDynamic<Real> l(nc);
+    if (m_warm_start) {
+        for (int ic = 0; ic < nc; ic++) {
+            l(ic) = (Real)N.GetConstraint(ic)->Get_l_i();
+            N.Increment_q<Real>(ic, l(ic), q.data());
+        }
+    } else {
+        l.setZero();
+    }
+
+    // Project the multipliers of the n constraints starting at i (with the ChConstraint objects, if needed)
+    auto project = [&](int i, int n) {
+        if (native) {
+            N.Project(i, l.data());
+            return;
+        }
+        for (int k = 0; k < n; k++)
+            N.GetConstraint(i + k)->Set_l_i(l(i + k));
+        N.GetConstraint(i)->Project();
+        for (int k = 0; k < n; k++)
+            l(i + k) = (Real)N.GetConstraint(i + k)->Get_l_i();
+    };
+
+    for (int iter = 0; iter < m_max_iterations; iter++) {
+        maxviolation = 0;
+        maxdeltalambda = 0;
+        i_friction_comp = 0;
+
+        for (int ic = 0; ic < nc; ic++) {
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+            double mresidual = (double)(N.Compute_Cq_q<Real>(ic, q.data()) + (Real)b(ic) + (Real)cfm(ic) * l(ic));
+
+            // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+            double deltal = (m_omega / g(ic)) * (-mresidual);
+
+            double candidate_violation = 0;
+
+            if (N.IsFriction(ic)) {
+                // update:   lambda += delta_lambda;
+                old_lambda_friction[i_friction_comp] = l(ic);
+                l(ic) = (Real)(l(ic) + deltal);
+                i_friction_comp++;
+
+                if (i_friction_comp == 1)
+                    candidate_violation = fabs(ChMin(0.0, mresidual));
+
+                if (i_friction_comp == 3) {
+                    project(ic - 2, 3);  // the N normal component will take care of N,U,V
+                    for (int k = 0; k < 3; k++) {
+                        Real& lambda = l(ic - 2 + k);
+                        // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+                        if (m_shlambda != 1.0)
+                            lambda = (Real)(m_shlambda * lambda + (1.0 - m_shlambda) * old_lambda_friction[k]);
+                        Real true_delta = lambda - old_lambda_friction[k];
+                        N.Increment_q<Real>(ic - 2 + k, true_delta, q.data());
+
+                        if (this->record_violation_history)
+                            maxdeltalambda = ChMax(maxdeltalambda, fabs((double)true_delta));
+                    }
+                    i_friction_comp = 0;
+                }
+            } else {
+                // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+                candidate_violation = native ? fabs(N.Violation(ic, mresidual))
+                                             : fabs(N.GetConstraint(ic)->Violation(mresidual));
+
+                // update:   lambda += delta_lambda;  and project onto the admissible set
+                Real old_lambda = l(ic);
+                l(ic) = (Real)(old_lambda + deltal);
+                project(ic, 1);
+
+                // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+                if (m_shlambda != 1.0)
+                    l(ic) = (Real)(m_shlambda * l(ic) + (1.0 - m_shlambda) * old_lambda);
+
+                Real true_delta = l(ic) - old_lambda;
+                N.Increment_q<Real>(ic, true_delta, q.data());
+
+                if (this->record_violation_history)
+                    maxdeltalambda = ChMax(maxdeltalambda, fabs((double)true_delta));
+            }
+
+            maxviolation = ChMax(maxviolation, candidate_violation);
+        }
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        m_iterations++;
+
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < m_tolerance)
+            break;
+    }
+
+    // Resulting multipliers and velocities q = [M]'*fb + [M]'*[Cq]'*l, in double precision
+    ChVectorDynamic<> ml = l.template cast<double>();
+    sysd.FromVectorToConstraints(ml);
+    N.Compute_q(q0, ml);
+    sysd.FromVectorToVariables(q0);
+
+    return maxviolation;
+}
+
 }  // end namespace chrono
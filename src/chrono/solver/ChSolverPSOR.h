@@ -35,6 +35,9 @@ class ChApi ChSolverPSOR : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::PSOR; }
 
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChSolverPSOR* Clone() const override { return new ChSolverPSOR(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -45,6 +48,16 @@ class ChApi ChSolverPSOR : public ChIterativeSolverVI {
     virtual double GetError() const override { return maxviolation; }
 
   private:
+    virtual void SetSolveStatistics(int iterations, double error) override {
+        m_iterations = iterations;
+        maxviolation = error;
+    }
+
+    /// Solve with the compact single-precision Schur complement, with the velocities and multipliers stored (and the
+    /// products accumulated) in the precision 'Real'.
+    template <typename Real>
+    double SolveSchur(ChSystemDescriptor& sysd);
+
     double maxviolation;
 };
 
@@ -40,6 +40,9 @@ ChSolverPSSOR : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::PSSOR; }
 
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChSolverPSSOR* Clone() const override { return new ChSolverPSSOR(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -50,6 +53,11 @@ ChSolverPSSOR : public ChIterativeSolverVI {
     virtual double GetError() const override { return maxviolation; }
 
   private:
+    virtual void SetSolveStatistics(int iterations, double error) override {
+        m_iterations = iterations;
+        maxviolation = error;
+    }
+
     double maxviolation;
 };
 
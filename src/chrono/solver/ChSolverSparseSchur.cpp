@@ -0,0 +1,381 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/solver/ChSolverSparseSchur.h"
+#include "chrono/core/ChSparsityPatternLearner.h"
+
+namespace chrono {
+
+// Compare the sparsity pattern of a compressed matrix with the given one and, if different, overwrite it.
+// Return true if the pattern changed.
+template <typename Matrix>
+static bool UpdatePattern(const Matrix& mat, std::vector<int>& pattern) {
+    size_t n_outer = mat.outerSize() + 1;
+    size_t nnz = mat.nonZeros();
+    const int* outer = mat.outerIndexPtr();
+    const int* inner = mat.innerIndexPtr();
+
+    if (pattern.size() == 2 + n_outer + nnz && pattern[0] == mat.rows() && pattern[1] == mat.cols() &&
+        std::equal(outer, outer + n_outer, pattern.begin() + 2) &&
+        std::equal(inner, inner + nnz, pattern.begin() + 2 + n_outer))
+        return false;
+
+    pattern.resize(2 + n_outer + nnz);
+    pattern[0] = (int)mat.rows();
+    pattern[1] = (int)mat.cols();
+    std::copy(outer, outer + n_outer, pattern.begin() + 2);
+    std::copy(inner, inner + nnz, pattern.begin() + 2 + n_outer);
+    return true;
+}
+
+// Find the root of a dof in the union-find forest (with path halving).
+static int FindRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// -----------------------------------------------------------------------------
+
+ChSolverSparseSchur::ChSolverSparseSchur()
+    : m_max_block_size(60), m_reduced(false), m_nq(0), m_nc(0), m_largest_block(0), m_analyze_call(0) {}
+
+void ChSolverSparseSchur::AssembleH(ChSystemDescriptor& sysd, ChSparseMatrix& storage) {
+    double c_a = sysd.GetMassFactor();
+    for (auto var : sysd.GetVariablesList()) {
+        if (var->IsActive())
+            var->Build_M(storage, var->GetOffset(), var->GetOffset(), c_a);
+    }
+    for (auto kblock : sysd.GetKblocksList()) {
+        kblock->Build_K(storage, true);
+    }
+}
+
+void ChSolverSparseSchur::AssembleCq(ChSystemDescriptor& sysd, ChSparseMatrix& storage, bool load_cfm) {
+    int s_c = 0;
+    for (auto constr : sysd.GetConstraintsList()) {
+        if (constr->IsActive()) {
+            constr->Build_Cq(storage, s_c);
+            if (load_cfm)
+                m_cfm(s_c) = constr->Get_cfm_i();
+            s_c++;
+        }
+    }
+}
+
+void ChSolverSparseSchur::FindBlocks() {
+    // Connected components of the sparsity graph of H
+    std::vector<int> parent(m_nq);
+    for (int i = 0; i < m_nq; i++)
+        parent[i] = i;
+    for (int i = 0; i < m_nq; i++) {
+        for (ChSparseMatrix::InnerIterator it(m_H, i); it; ++it) {
+            int ri = FindRoot(parent, i);
+            int rj = FindRoot(parent, (int)it.col());
+            if (ri != rj)
+                parent[std::max(ri, rj)] = std::min(ri, rj);
+        }
+    }
+
+    // Number the blocks in order of their first dof and count their sizes
+    std::vector<int> block(m_nq);
+    int num_blocks = 0;
+    m_blk_ptr.assign(1, 0);
+    for (int i = 0; i < m_nq; i++) {
+        int r = FindRoot(parent, i);
+        if (r == i) {
+            block[i] = num_blocks++;
+            m_blk_ptr.push_back(0);
+        } else {
+            block[i] = block[r];
+        }
+        m_blk_ptr[block[i] + 1]++;
+    }
+    m_largest_block = 0;
+    for (int b = 0; b < num_blocks; b++) {
+        m_largest_block = std::max(m_largest_block, m_blk_ptr[b + 1]);
+        m_blk_ptr[b + 1] += m_blk_ptr[b];
+    }
+
+    // List the dofs of each block (in increasing order)
+    std::vector<int> next(m_blk_ptr.begin(), m_blk_ptr.end() - 1);
+    m_blk_dofs.resize(m_nq);
+    m_blk_local.resize(m_nq);
+    for (int i = 0; i < m_nq; i++) {
+        int pos = next[block[i]]++;
+        m_blk_dofs[pos] = i;
+        m_blk_local[i] = pos - m_blk_ptr[block[i]];
+    }
+
+    if (m_largest_block > m_max_block_size)
+        return;
+
+    // Sparsity pattern of H^(-1): dense blocks
+    Eigen::VectorXi row_nnz(m_nq);
+    for (int i = 0; i < m_nq; i++)
+        row_nnz(i) = m_blk_ptr[block[i] + 1] - m_blk_ptr[block[i]];
+    m_Hinv.resize(m_nq, m_nq);
+    m_Hinv.reserve(row_nnz);
+    for (int i = 0; i < m_nq; i++) {
+        for (int k = m_blk_ptr[block[i]]; k < m_blk_ptr[block[i] + 1]; k++)
+            m_Hinv.insert(i, m_blk_dofs[k]) = 0;
+    }
+    m_Hinv.makeCompressed();
+}
+
+// Relative threshold below which a block of H is considered singular
+static const double SINGULAR_TOLERANCE = 1e-12;
+
+bool ChSolverSparseSchur::InvertBlocks() {
+    int num_blocks = GetNumBlocks();
+    int num_singular = 0;
+
+    // Scalar blocks are compared to the largest diagonal entry of H, dense blocks to their own largest pivot
+    double h_max = (m_nq > 0) ? m_H.diagonal().cwiseAbs().maxCoeff() : 0;
+    double h_tol = SINGULAR_TOLERANCE * h_max;
+
+#pragma omp parallel for schedule(dynamic, 64) reduction(+ : num_singular)
+    for (int b = 0; b < num_blocks; b++) {
+        int start = m_blk_ptr[b];
+        int size = m_blk_ptr[b + 1] - start;
+
+        // Scalar block
+        if (size == 1) {
+            int i = m_blk_dofs[start];
+            double h = m_H.coeff(i, i);
+            bool singular = std::abs(h) <= h_tol;
+            if (singular)
+                num_singular++;
+            m_Hinv.valuePtr()[m_Hinv.outerIndexPtr()[i]] = singular ? 0 : 1 / h;
+            continue;
+        }
+
+        // Dense block: gather, invert, and scatter to the rows of H^(-1) (same column order as the block dofs)
+        ChMatrixDynamic<> Hb(size, size);
+        Hb.setZero();
+        for (int k = 0; k < size; k++) {
+            int i = m_blk_dofs[start + k];
+            for (ChSparseMatrix::InnerIterator it(m_H, i); it; ++it)
+                Hb(k, m_blk_local[it.col()]) = it.value();
+        }
+
+        Eigen::LDLT<ChMatrixDynamic<>> ldlt(Hb);
+        auto pivots = ldlt.vectorD().cwiseAbs();
+        if (ldlt.info() != Eigen::Success || pivots.minCoeff() <= SINGULAR_TOLERANCE * pivots.maxCoeff()) {
+            num_singular++;
+            continue;
+        }
+        ChMatrixDynamic<> Hb_inv = ldlt.solve(ChMatrixDynamic<>::Identity(size, size));
+
+        for (int k = 0; k < size; k++) {
+            int i = m_blk_dofs[start + k];
+            double* row = m_Hinv.valuePtr() + m_Hinv.outerIndexPtr()[i];
+            for (int l = 0; l < size; l++)
+                row[l] = Hb_inv(k, l);
+        }
+    }
+
+    return num_singular == 0;
+}
+
+bool ChSolverSparseSchur::Setup(ChSystemDescriptor& sysd) {
+    m_timer_setup_assembly.start();
+
+    // Problem size.
+    // Note that ChSystemDescriptor::UpdateCountsAndOffsets was already called at the beginning of the step.
+    m_nq = sysd.CountActiveVariables();
+    m_nc = sysd.CountActiveConstraints();
+    m_dim = m_nq + m_nc;
+
+    // Same policies as in ChDirectSolverLS for the sparsity pattern learner and for reserving space for nonzeros.
+    bool call_learner = m_use_learner && (m_force_update || !m_lock);
+    bool call_reserve = !m_use_learner && (m_setup_call == 0 || !m_lock);
+
+    // Assemble H and detect its block structure (only if its sparsity pattern changed)
+    if (call_learner) {
+        ChSparsityPatternLearner sparsity_pattern(m_nq, m_nq);
+        AssembleH(sysd, sparsity_pattern);
+        sparsity_pattern.Apply(m_H);
+    } else if (call_reserve) {
+        m_H.resize(m_nq, m_nq);
+        m_H.reserve(Eigen::VectorXi::Constant(m_nq, 3));
+    }
+    m_H.conservativeResize(m_nq, m_nq);
+    m_H.setZeroValues();
+    AssembleH(sysd, m_H);
+    m_H.makeCompressed();
+
+    if (UpdatePattern(m_H, m_H_pattern))
+        FindBlocks();
+
+    // Fall back to the factorization of the full KKT matrix if H has large blocks
+    if (m_largest_block > m_max_block_size) {
+        m_timer_setup_assembly.stop();
+        if (verbose) {
+            GetLog() << "Solver setup: block of size " << m_largest_block << " exceeds maximum block size "
+                     << m_max_block_size << ". Using full KKT matrix.\n";
+        }
+        if (m_reduced || m_mat.rows() != m_dim)
+            m_force_update = true;
+        m_reduced = false;
+        return ChDirectSolverLS::Setup(sysd);
+    }
+    m_reduced = true;
+
+    if (!InvertBlocks()) {
+        m_timer_setup_assembly.stop();
+        m_setup_call++;
+        GetLog() << "Solver setup failed\n";
+        GetLog() << "singular block in the matrix H (masses and stiffness)\n";
+        return false;
+    }
+
+    // Assemble Cq and E
+    if (call_learner) {
+        ChSparsityPatternLearner sparsity_pattern(m_nc, m_nq);
+        AssembleCq(sysd, sparsity_pattern, false);
+        sparsity_pattern.Apply(m_Cq);
+        m_force_update = false;
+    } else if (call_reserve) {
+        m_Cq.resize(m_nc, m_nq);
+        m_Cq.reserve(Eigen::VectorXi::Constant(m_nc, 12));
+    }
+    m_Cq.conservativeResize(m_nc, m_nq);
+    m_Cq.setZeroValues();
+    m_cfm.resize(m_nc);
+    AssembleCq(sysd, m_Cq, true);
+    m_Cq.makeCompressed();
+
+    m_E.resize(m_nc, m_nc);
+    m_E.reserve(Eigen::VectorXi::Constant(m_nc, 1));
+    for (int i = 0; i < m_nc; i++)
+        m_E.insert(i, i) = m_cfm(i);
+
+    // Reduced matrix (all diagonal entries are structurally present, through E)
+    m_HinvCqT = m_Hinv * m_Cq.transpose();
+    ColMajorMatrix CqHinvCqT = m_Cq * m_HinvCqT;
+    m_S = CqHinvCqT - m_E;
+    m_S.makeCompressed();
+
+    m_timer_setup_assembly.stop();
+
+    // Symbolic analysis (only if the sparsity pattern of the reduced matrix changed) and numeric factorization
+    m_timer_setup_solvercall.start();
+    bool result = true;
+    if (m_nc > 0) {
+        if (UpdatePattern(m_S, m_S_pattern)) {
+            m_ldlt.analyzePattern(m_S);
+            m_analyze_call++;
+        }
+        m_ldlt.factorize(m_S);
+        result = (m_ldlt.info() == Eigen::Success);
+    }
+    m_timer_setup_solvercall.stop();
+
+    if (verbose) {
+        GetLog() << " Solver setup [" << m_setup_call << "] n = " << m_dim << "  blocks = " << GetNumBlocks()
+                 << "  largest block = " << m_largest_block << "  reduced n = " << m_nc
+                 << "  nnz = " << (int)m_S.nonZeros() << "\n";
+        GetLog() << "  assembly matrix:   " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s\n"
+                 << "  analyze+factorize: " << m_timer_setup_solvercall.GetTimeSecondsIntermediate() << "s\n";
+    }
+
+    m_setup_call++;
+
+    if (!result) {
+        GetLog() << "Solver setup failed\n";
+        PrintErrorMessage();
+    }
+
+    return result;
+}
+
+double ChSolverSparseSchur::Solve(ChSystemDescriptor& sysd) {
+    if (!m_reduced)
+        return ChDirectSolverLS::Solve(sysd);
+
+    // Assemble the right-hand side vector {f; -b}
+    m_timer_solve_assembly.start();
+    sysd.ConvertToMatrixForm(nullptr, &m_rhs);
+    m_sol.resize(m_rhs.size());
+    m_timer_solve_assembly.stop();
+
+    // Solve the reduced system for -l, then recover q = H^(-1)*(f - Cq'*(-l))
+    m_timer_solve_solvercall.start();
+    bool result = true;
+    m_tmp_q = m_Hinv * m_rhs.head(m_nq);
+    if (m_nc > 0) {
+        m_tmp_l = m_Cq * m_tmp_q;
+        m_tmp_l -= m_rhs.tail(m_nc);
+        m_sol.tail(m_nc) = m_ldlt.solve(m_tmp_l);
+        result = (m_ldlt.info() == Eigen::Success);
+        m_tmp_q -= m_HinvCqT * m_sol.tail(m_nc);
+    }
+    m_sol.head(m_nq) = m_tmp_q;
+    m_timer_solve_solvercall.stop();
+
+    // Scatter solution vector to the system descriptor
+    m_timer_solve_assembly.start();
+    sysd.FromVectorToUnknowns(m_sol);
+    m_timer_solve_assembly.stop();
+
+    if (verbose) {
+        double res_norm = (m_nc > 0) ? (m_tmp_l - m_S * m_sol.tail(m_nc)).norm() : 0;
+        GetLog() << " Solver solve [" << m_solve_call << "]  |residual| = " << res_norm << "\n\n";
+        GetLog() << "  assembly rhs+sol:  " << m_timer_solve_assembly.GetTimeSecondsIntermediate() << "s\n"
+                 << "  solve:             " << m_timer_solve_solvercall.GetTimeSecondsIntermediate() << "\n";
+    }
+
+    if (!result) {
+        GetLog() << "Solver solve failed\n";
+        PrintErrorMessage();
+    }
+
+    return result;
+}
+
+bool ChSolverSparseSchur::FactorizeMatrix() {
+    m_lu.compute(m_mat);
+    return (m_lu.info() == Eigen::Success);
+}
+
+bool ChSolverSparseSchur::SolveSystem() {
+    m_sol = m_lu.solve(m_rhs);
+    return (m_lu.info() == Eigen::Success);
+}
+
+void ChSolverSparseSchur::PrintErrorMessage() {
+    Eigen::ComputationInfo info = m_reduced ? m_ldlt.info() : m_lu.info();
+    switch (info) {
+        case Eigen::Success:
+            GetLog() << "computation was successful\n";
+            break;
+        case Eigen::NumericalIssue:
+            if (m_reduced)
+                GetLog() << "LDLT factorization of the reduced matrix failed (zero pivot, redundant constraints?)\n";
+            else
+                GetLog() << "LU factorization reported a problem, zero diagonal for instance\n";
+            break;
+        case Eigen::InvalidInput:
+            GetLog() << "inputs are invalid, or the algorithm has been improperly called\n";
+            break;
+        default:
+            break;
+    }
+}
+
+}  // end namespace chrono
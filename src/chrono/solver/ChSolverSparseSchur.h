@@ -0,0 +1,144 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Sparse direct solver based on the Schur complement of the block-diagonal
+// mass matrix (reduced system in the constraint multipliers).
+//
+// =============================================================================
+
+#ifndef CH_SOLVER_SPARSE_SCHUR_H
+#define CH_SOLVER_SPARSE_SCHUR_H
+
+#include <vector>
+
+#include "chrono/solver/ChDirectSolverLS.h"
+
+#include <Eigen/SparseCholesky>
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Sparse direct solver exploiting the block-diagonal structure of the mass matrix.\n
+/// For the KKT system
+/// <pre>
+///  | H  Cq'|*| q|=| f|
+///  | Cq  E | |-l| |-b|
+/// </pre>
+/// the solver inverts H block by block and factorizes the (much smaller) reduced system in the multipliers,
+/// <pre>
+///  [Cq*H^(-1)*Cq' - E]*(-l) = Cq*H^(-1)*f + b
+/// </pre>
+/// with a sparse LDL^T factorization (fill-reducing AMD ordering); the velocities q are then recovered by
+/// back-substitution. The blocks of H are the connected components of its sparsity graph: for rigid multibody systems
+/// these are the (3x3 and 1x1) blocks of the ChVariablesBody and ChVariablesShaft masses; ChKblock objects merge the
+/// blocks of the variables they couple. If the largest block exceeds a given size (see SetMaxBlockSize), for example
+/// if the system contains FEA meshes with stiffness matrices, the solver falls back to a sparse LU factorization of
+/// the full KKT matrix (as ChSolverSparseLU).\n
+/// The symbolic analysis of the reduced matrix is reused as long as its sparsity pattern does not change.\n
+/// Cannot handle VI and complementarity problems, so it cannot be used with NSC formulations with contacts.\n
+/// See ChDirectSolverLS for more details.
+class ChApi ChSolverSparseSchur : public ChDirectSolverLS {
+  public:
+    ChSolverSparseSchur();
+    ~ChSolverSparseSchur() {}
+
+    virtual Type GetType() const override { return Type::SPARSE_SCHUR; }
+
+    /// Set the maximum size of a block of H for which the reduced system is used (default: 60).
+    /// If a larger block is detected, the full KKT matrix is factorized instead.
+    void SetMaxBlockSize(int size) { m_max_block_size = size; }
+
+    /// Return true if the last call to Setup used the reduced (Schur complement) system.
+    bool IsReduced() const { return m_reduced; }
+
+    /// Return the number of blocks of H detected at the last call to Setup.
+    int GetNumBlocks() const { return (int)m_blk_ptr.size() - 1; }
+
+    /// Return the size of the largest block of H detected at the last call to Setup.
+    int GetLargestBlockSize() const { return m_largest_block; }
+
+    /// Return the number of symbolic analyses of the reduced matrix.
+    int GetNumAnalyzeCalls() const { return m_analyze_call; }
+
+    /// Get a handle to the reduced matrix, Cq*H^(-1)*Cq' - E (valid if IsReduced returns true).
+    const Eigen::SparseMatrix<double, Eigen::ColMajor, int>& GetReducedMatrix() const { return m_S; }
+
+    /// Perform the solver setup operations.
+    /// Here, sysd is the system description with constraints and variables.
+    /// Returns true if successful and false otherwise.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+    /// Solve linear system.
+    /// Here, sysd is the system description with constraints and variables.
+    virtual double Solve(ChSystemDescriptor& sysd) override;
+
+  private:
+    typedef Eigen::SparseMatrix<double, Eigen::ColMajor, int> ColMajorMatrix;
+
+    /// Assemble the matrix H (masses and stiffness blocks).
+    void AssembleH(ChSystemDescriptor& sysd, ChSparseMatrix& storage);
+
+    /// Assemble the constraint Jacobian Cq and the diagonal of the compliance matrix E.
+    void AssembleCq(ChSystemDescriptor& sysd, ChSparseMatrix& storage, bool load_cfm);
+
+    /// Find the blocks of H (connected components of its sparsity graph) and set the sparsity pattern of H^(-1).
+    void FindBlocks();
+
+    /// Invert the blocks of H and load them in H^(-1). Return false if a block is singular (up to a relative
+    /// tolerance: smallest LDL^T pivot of a block relative to its largest one, or scalar block relative to the largest
+    /// diagonal entry of H).
+    bool InvertBlocks();
+
+    /// Factorize the full KKT matrix (fallback).
+    virtual bool FactorizeMatrix() override;
+
+    /// Solve the full KKT system using the current factorization (fallback).
+    virtual bool SolveSystem() override;
+
+    /// Display an error message corresponding to the last failure.
+    virtual void PrintErrorMessage() override;
+
+    int m_max_block_size;  ///< maximum block size for the reduced system
+    bool m_reduced;        ///< was the reduced system used at the last setup?
+    int m_nq;              ///< number of active variables
+    int m_nc;              ///< number of active constraints
+
+    ChSparseMatrix m_H;                ///< mass + stiffness matrix
+    ChSparseMatrix m_Hinv;             ///< block inverse of H
+    ChSparseMatrix m_Cq;               ///< constraint Jacobian
+    ChSparseMatrix m_HinvCqT;          ///< H^(-1)*Cq'
+    ColMajorMatrix m_E;                ///< diagonal compliance matrix
+    ColMajorMatrix m_S;                ///< reduced matrix Cq*H^(-1)*Cq' - E
+    ChVectorDynamic<double> m_cfm;     ///< diagonal of the compliance matrix
+    ChVectorDynamic<double> m_tmp_q;   ///< workspace (size of q)
+    ChVectorDynamic<double> m_tmp_l;   ///< workspace (size of l)
+
+    std::vector<int> m_blk_ptr;    ///< start of each block in m_blk_dofs
+    std::vector<int> m_blk_dofs;   ///< dofs of each block (sorted)
+    std::vector<int> m_blk_local;  ///< local index of each dof in its block
+    int m_largest_block;           ///< size of the largest block
+
+    std::vector<int> m_H_pattern;  ///< sparsity pattern of H at the last block detection
+    std::vector<int> m_S_pattern;  ///< sparsity pattern of the reduced matrix at the last symbolic analysis
+    int m_analyze_call;            ///< counter for symbolic analyses of the reduced matrix
+
+    Eigen::SimplicialLDLT<ColMajorMatrix, Eigen::Lower, Eigen::AMDOrdering<int>> m_ldlt;  ///< reduced system solver
+    Eigen::SparseLU<ChSparseMatrix, Eigen::COLAMDOrdering<int>> m_lu;                     ///< full KKT solver
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,376 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/core/ChDisjointSets.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSolverTree.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+ChSolverTree::ChSolverTree(std::shared_ptr<ChSolver> solver)
+    : m_solver(solver),
+      m_threshold(1e-14),
+      m_tree(false),
+      m_forest(false),
+      m_new_pattern(true),
+      m_num_trees(0),
+      m_analyze_call(0),
+      m_nq(0),
+      m_nc(0) {}
+
+void ChSolverTree::ResetTimers() {
+    m_timer_setup.reset();
+    m_timer_solve.reset();
+}
+
+bool ChSolverTree::UpdateTopology(ChSystemDescriptor& sysd) {
+    // Sequence of integers identifying the topology: offsets and sizes of the active variable objects, then the
+    // offsets of the variables of each active constraint and stiffness block (-1 terminated). Constraints which
+    // cannot be handled are marked with -2.
+    std::vector<int>& topo = m_topology_new;
+    topo.clear();
+    topo.push_back(sysd.CountActiveVariables());
+    topo.push_back(sysd.CountActiveConstraints());
+
+    for (auto var : sysd.GetVariablesList()) {
+        if (var->IsActive() && var->Get_ndof() > 0) {
+            topo.push_back(var->GetOffset());
+            topo.push_back(var->Get_ndof());
+        }
+    }
+
+    std::vector<ChVariables*> vars;
+    for (auto constr : sysd.GetConstraintsList()) {
+        if (!constr->IsActive())
+            continue;
+        vars.clear();
+        if (constr->GetMode() != CONSTRAINT_LOCK || !constr->AppendVariables(vars))
+            topo.push_back(-2);
+        for (auto var : vars) {
+            if (var->IsActive() && var->Get_ndof() > 0)
+                topo.push_back(var->GetOffset());
+        }
+        topo.push_back(-1);
+    }
+
+    for (auto kb : sysd.GetKblocksList()) {
+        auto kblock = dynamic_cast<ChKblockGeneric*>(kb);
+        if (!kblock) {
+            topo.push_back(-2);
+            continue;
+        }
+        for (unsigned int j = 0; j < kblock->GetNvars(); j++) {
+            auto var = kblock->GetVariableN(j);
+            if (var->IsActive() && var->Get_ndof() > 0)
+                topo.push_back(var->GetOffset());
+        }
+        topo.push_back(-1);
+    }
+
+    if (topo == m_topology)
+        return false;
+    std::swap(m_topology, m_topology_new);
+    return true;
+}
+
+bool ChSolverTree::Analyze(ChSystemDescriptor& sysd) {
+    m_nq = sysd.CountActiveVariables();
+    m_nc = sysd.CountActiveConstraints();
+    int n = m_nq + m_nc;
+
+    m_index_node.assign(n, -1);
+    m_row_nnz.setZero(n);
+    int num_nodes = 0;
+
+    // Add a node to the graph (reusing the storage of existing nodes).
+    auto add_node = [this, &num_nodes](int start, int dim) {
+        if (num_nodes == (int)m_nodes.size())
+            m_nodes.emplace_back();
+        m_nodes[num_nodes].start = start;
+        m_nodes[num_nodes].dim = dim;
+        m_nodes[num_nodes].parent = -1;
+        return num_nodes++;
+    };
+
+    // Edges of the graph, as pairs of nodes (smaller index first)
+    std::vector<std::pair<int, int>> edges;
+    std::vector<ChVariables*> vars;
+    std::vector<int> cur;
+    std::vector<int> prev;
+
+    // Collect the nodes (active, non-empty) of a list of variables.
+    auto collect = [this, &vars, &cur]() {
+        cur.clear();
+        for (auto var : vars) {
+            if (var->IsActive() && var->Get_ndof() > 0)
+                cur.push_back(m_index_node[var->GetOffset()]);
+        }
+        std::sort(cur.begin(), cur.end());
+        cur.erase(std::unique(cur.begin(), cur.end()), cur.end());
+    };
+
+    // One node per variable object
+    for (auto var : sysd.GetVariablesList()) {
+        if (!var->IsActive() || var->Get_ndof() == 0)
+            continue;
+        int node = add_node(var->GetOffset(), var->Get_ndof());
+        for (int i = var->GetOffset(); i < var->GetOffset() + var->Get_ndof(); i++) {
+            m_index_node[i] = node;
+            m_row_nnz(i) = var->Get_ndof();
+        }
+    }
+
+    int num_var_nodes = num_nodes;
+
+    // One node per group of consecutive constraints acting on the same variables
+    int s_c = 0;
+    int cnode = -1;
+    for (auto constr : sysd.GetConstraintsList()) {
+        if (!constr->IsActive())
+            continue;
+        if (constr->GetMode() != CONSTRAINT_LOCK)
+            return false;
+        vars.clear();
+        if (!constr->AppendVariables(vars))
+            return false;
+        collect();
+
+        int row = m_nq + s_c;
+        if (cnode >= 0 && cur == prev) {
+            m_nodes[cnode].dim++;
+        } else {
+            cnode = add_node(row, 1);
+            for (auto node : cur)
+                edges.push_back(std::make_pair(node, cnode));
+            prev = cur;
+        }
+
+        m_index_node[row] = cnode;
+        m_row_nnz(row) = 1;
+        for (auto node : cur) {
+            const Node& nd = m_nodes[node];
+            m_row_nnz(row) += nd.dim;
+            m_row_nnz.segment(nd.start, nd.dim).array() += 1;
+        }
+        s_c++;
+    }
+
+    // Coupling between variable objects through stiffness blocks
+    for (auto kb : sysd.GetKblocksList()) {
+        auto kblock = dynamic_cast<ChKblockGeneric*>(kb);
+        if (!kblock)
+            return false;
+        vars.clear();
+        for (unsigned int j = 0; j < kblock->GetNvars(); j++)
+            vars.push_back(kblock->GetVariableN(j));
+        collect();
+        int dim = 0;
+        for (auto node : cur)
+            dim += m_nodes[node].dim;
+        for (size_t j = 0; j < cur.size(); j++) {
+            const Node& nd = m_nodes[cur[j]];
+            m_row_nnz.segment(nd.start, nd.dim).array() += dim - nd.dim;
+            for (size_t k = j + 1; k < cur.size(); k++)
+                edges.push_back(std::make_pair(cur[j], cur[k]));
+        }
+    }
+
+    m_nodes.resize(num_nodes);
+
+    // The graph must be a forest
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    ChDisjointSets sets(num_nodes);
+    for (const auto& edge : edges) {
+        if (sets.Find(edge.first) == sets.Find(edge.second))
+            return false;
+        sets.Union(edge.first, edge.second);
+    }
+    m_num_trees = num_nodes - (int)edges.size();
+
+    // Adjacency lists
+    std::vector<int> adj_ptr(num_nodes + 1, 0);
+    for (const auto& edge : edges) {
+        adj_ptr[edge.first + 1]++;
+        adj_ptr[edge.second + 1]++;
+    }
+    for (int i = 0; i < num_nodes; i++)
+        adj_ptr[i + 1] += adj_ptr[i];
+    std::vector<int> adj(adj_ptr[num_nodes]);
+    std::vector<int> next(adj_ptr.begin(), adj_ptr.end() - 1);
+    for (const auto& edge : edges) {
+        adj[next[edge.first]++] = edge.second;
+        adj[next[edge.second]++] = edge.first;
+    }
+
+    // Candidate roots. A constraint node connected to a single variable node (e.g. a joint to ground) has a zero
+    // diagonal block, so it cannot be a leaf of the factorization: use it as the root of its tree.
+    std::vector<int> roots;
+    for (int i = num_var_nodes; i < num_nodes; i++) {
+        if (adj_ptr[i + 1] - adj_ptr[i] == 1)
+            roots.push_back(i);
+    }
+    for (int i = 0; i < num_nodes; i++)
+        roots.push_back(i);
+
+    // Breadth-first traversal of each tree; the factorization order is the reverse traversal order
+    std::vector<bool> visited(num_nodes, false);
+    m_order.clear();
+    for (auto root : roots) {
+        if (visited[root])
+            continue;
+        visited[root] = true;
+        size_t first = m_order.size();
+        m_order.push_back(root);
+        for (size_t k = first; k < m_order.size(); k++) {
+            int node = m_order[k];
+            for (int j = adj_ptr[node]; j < adj_ptr[node + 1]; j++) {
+                int child = adj[j];
+                if (!visited[child]) {
+                    visited[child] = true;
+                    m_nodes[child].parent = node;
+                    m_order.push_back(child);
+                }
+            }
+        }
+    }
+    std::reverse(m_order.begin(), m_order.end());
+
+    return true;
+}
+
+bool ChSolverTree::Factorize(ChSystemDescriptor& sysd) {
+    int n = m_nq + m_nc;
+
+    // Assemble the system matrix. The sparsity pattern is built (with exact storage reserved for all nonzeros) only
+    // after a new analysis; otherwise the values are loaded in place.
+    if (m_new_pattern) {
+        m_mat.resize(n, n);
+        m_mat.reserve(m_row_nnz);
+        sysd.ConvertToMatrixForm(&m_mat, nullptr);
+        m_mat.makeCompressed();
+        m_new_pattern = false;
+    } else {
+        m_mat.setZeroValues();
+        sysd.ConvertToMatrixForm(&m_mat, nullptr);
+    }
+
+    // Scatter the system matrix to the node blocks
+    for (auto& node : m_nodes) {
+        node.D.setZero(node.dim, node.dim);
+        if (node.parent >= 0) {
+            int dim_p = m_nodes[node.parent].dim;
+            node.Hip.setZero(node.dim, dim_p);
+            node.Hpi.setZero(dim_p, node.dim);
+        }
+    }
+
+    for (int row = 0; row < n; row++) {
+        int a = m_index_node[row];
+        Node& na = m_nodes[a];
+        for (ChSparseMatrix::InnerIterator it(m_mat, row); it; ++it) {
+            int col = (int)it.col();
+            int b = m_index_node[col];
+            Node& nb = m_nodes[b];
+            if (a == b)
+                na.D(row - na.start, col - nb.start) = it.value();
+            else if (na.parent == b)
+                na.Hip(row - na.start, col - nb.start) = it.value();
+            else if (nb.parent == a)
+                nb.Hpi(row - na.start, col - nb.start) = it.value();
+        }
+    }
+
+    // Block LU factorization, from the leaves to the roots (no fill-in):
+    //   D_i = H_ii - sum_c H_ic * D_c^(-1) * H_ci   over the children c of i
+    for (auto i : m_order) {
+        Node& node = m_nodes[i];
+        node.lu.compute(node.D);
+        if (!(node.lu.rcond() > m_threshold))
+            return false;
+        if (node.parent >= 0) {
+            node.K = node.lu.solve(node.Hip);
+            m_nodes[node.parent].D.noalias() -= node.Hpi * node.K;
+        }
+    }
+
+    return true;
+}
+
+bool ChSolverTree::Setup(ChSystemDescriptor& sysd) {
+    m_timer_setup.start();
+    if (UpdateTopology(sysd)) {
+        m_forest = Analyze(sysd);
+        m_new_pattern = true;
+        m_analyze_call++;
+    }
+    m_tree = m_forest && Factorize(sysd);
+    m_timer_setup.stop();
+
+    if (verbose) {
+        GetLog() << " Solver setup  n = " << m_nq + m_nc << "  tree = " << m_tree;
+        if (m_tree)
+            GetLog() << "  nodes = " << GetNumNodes() << "  trees = " << m_num_trees;
+        GetLog() << "\n";
+    }
+
+    if (!m_tree)
+        return m_solver->Setup(sysd);
+
+    return true;
+}
+
+double ChSolverTree::Solve(ChSystemDescriptor& sysd) {
+    if (!m_tree)
+        return m_solver->Solve(sysd);
+
+    m_timer_solve.start();
+
+    sysd.ConvertToMatrixForm(nullptr, &m_rhs);
+    m_sol = m_rhs;
+
+    // Forward pass (leaves to roots): z_i = D_i^(-1) * y_i, then y_p -= H_pi * z_i
+    for (auto i : m_order) {
+        const Node& node = m_nodes[i];
+        m_tmp = node.lu.solve(m_sol.segment(node.start, node.dim));
+        m_sol.segment(node.start, node.dim) = m_tmp;
+        if (node.parent >= 0) {
+            const Node& parent = m_nodes[node.parent];
+            m_sol.segment(parent.start, parent.dim) -= node.Hpi * m_tmp;
+        }
+    }
+
+    // Backward pass (roots to leaves): x_i = z_i - K_i * x_p
+    for (auto it = m_order.rbegin(); it != m_order.rend(); ++it) {
+        const Node& node = m_nodes[*it];
+        if (node.parent >= 0) {
+            const Node& parent = m_nodes[node.parent];
+            m_sol.segment(node.start, node.dim) -= node.K * m_sol.segment(parent.start, parent.dim);
+        }
+    }
+
+    sysd.FromVectorToUnknowns(m_sol);
+
+    m_timer_solve.stop();
+
+    if (verbose) {
+        double res_norm = (m_rhs - m_mat * m_sol).norm();
+        GetLog() << " Solver solve  |residual| = " << res_norm << "\n";
+    }
+
+    return true;
+}
+
+}  // end namespace chrono
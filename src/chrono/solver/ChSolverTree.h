@@ -0,0 +1,145 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Linear-time direct solver for tree-structured mechanisms.
+//
+// =============================================================================
+
+#ifndef CH_SOLVER_TREE_H
+#define CH_SOLVER_TREE_H
+
+#include <memory>
+#include <vector>
+
+#include "chrono/core/ChMatrix.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/solver/ChSolver.h"
+
+#include <Eigen/LU>
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Linear-time direct solver for mechanisms with a tree topology (chains, robot arms, vehicle suspensions, etc.).\n
+/// The KKT system assembled from the ChSystemDescriptor is seen as a block matrix over a graph with one node per
+/// variable object (body, shaft, node) and one node per group of consecutive constraints acting on the same variables
+/// (typically, a joint). Edges correspond to constraint Jacobians and to the coupling terms of ChKblock objects.
+/// If this graph is a forest, ordering the nodes from the leaves to the roots yields a block LU factorization without
+/// fill-in (Baraff's linear-time sparse factorization), so that cost and memory scale linearly with the number of
+/// bodies. The factorization is direct, so joint constraints are satisfied exactly regardless of the chain length.\n
+/// If the system contains contacts or other non-bilateral constraints, kinematic loops, constraints which do not
+/// report their variables, or if a block of the factorization is singular (e.g. redundant constraints), the problem
+/// is passed to the wrapped solver. Use a VI solver (e.g. ChSolverBB) for NSC systems with contacts, or a direct
+/// sparse solver (e.g. ChSolverSparseLU) for closed-loop mechanisms.\n
+/// The graph and its ordering are cached: as long as the topology of the problem (variables, constraints and the
+/// variables they act on, stiffness blocks) does not change, only the numerical factorization is performed, in place.
+/// The solver settings set through ChSystem (e.g. ChSystem::SetSolverMaxIterations) are forwarded to the wrapped
+/// solver, if iterative.
+class ChApi ChSolverTree : public ChSolver {
+  public:
+    ChSolverTree(std::shared_ptr<ChSolver> solver);
+
+    ~ChSolverTree() {}
+
+    /// Access the wrapped solver, used when the problem does not have a tree structure.
+    std::shared_ptr<ChSolver> GetSolver() const { return m_solver; }
+
+    /// Set the threshold on the reciprocal condition number below which a block is considered singular (default:
+    /// 1e-14). In this case, the problem is passed to the wrapped solver.
+    void SetSingularityThreshold(double threshold) { m_threshold = threshold; }
+
+    /// Return true if the last call to Setup used the tree factorization.
+    bool IsTree() const { return m_tree; }
+
+    /// Return the number of nodes (variable objects and constraint groups) at the last call to Setup.
+    int GetNumNodes() const { return (int)m_nodes.size(); }
+
+    /// Return the number of independent trees at the last call to Setup.
+    int GetNumTrees() const { return m_num_trees; }
+
+    /// Return the number of analyses of the problem graph (i.e., of topology changes).
+    int GetNumAnalyzeCalls() const { return m_analyze_call; }
+
+    /// Get cumulative time for the factorization (assembly included).
+    double GetTimeSetup() const { return m_timer_setup(); }
+
+    /// Get cumulative time for the solution phase.
+    double GetTimeSolve() const { return m_timer_solve(); }
+
+    /// Reset timers for Setup and Solve.
+    void ResetTimers();
+
+    virtual bool SolveRequiresMatrix() const override { return m_solver->SolveRequiresMatrix(); }
+
+    /// Perform the solver setup operations: analyze the structure of the problem and, if it is a forest, factorize
+    /// the system matrix. Otherwise, call the Setup function of the wrapped solver.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+    /// Solve the problem, using the tree factorization or the wrapped solver.
+    virtual double Solve(ChSystemDescriptor& sysd) override;
+
+  private:
+    /// Node of the tree: a variable object or a group of constraints.
+    struct Node {
+        int start;                                  ///< index of the first unknown of the node
+        int dim;                                    ///< number of unknowns of the node
+        int parent;                                 ///< parent node (-1 for a root)
+        ChMatrixDynamic<> D;                        ///< diagonal block (Schur complement after factorization)
+        ChMatrixDynamic<> Hip;                      ///< block coupling this node (rows) to its parent (columns)
+        ChMatrixDynamic<> Hpi;                      ///< block coupling the parent (rows) to this node (columns)
+        ChMatrixDynamic<> K;                        ///< D^(-1) * Hip
+        Eigen::PartialPivLU<ChMatrixDynamic<>> lu;  ///< factorization of D
+    };
+
+    /// Update the topology of the problem (active variables, constraints and the variables they act on, stiffness
+    /// blocks). Return true if it changed since the last call.
+    bool UpdateTopology(ChSystemDescriptor& sysd);
+
+    /// Build the graph of the problem and order its nodes. Return false if the problem is not a forest of bilateral
+    /// constraints and variables.
+    bool Analyze(ChSystemDescriptor& sysd);
+
+    /// Assemble the blocks of the system matrix and factorize. Return false if a block is singular.
+    bool Factorize(ChSystemDescriptor& sysd);
+
+    std::shared_ptr<ChSolver> m_solver;  ///< wrapped solver
+    double m_threshold;                  ///< singularity threshold
+    bool m_tree;                         ///< was the tree factorization used at the last setup?
+    bool m_forest;                       ///< is the graph of the current topology a forest?
+    bool m_new_pattern;                  ///< must the sparsity pattern of the system matrix be rebuilt?
+    int m_num_trees;                     ///< number of trees in the forest
+    int m_analyze_call;                  ///< number of analyses of the problem graph
+
+    int m_nq;                         ///< number of active variables
+    int m_nc;                         ///< number of active constraints
+    std::vector<Node> m_nodes;        ///< nodes (variable objects first, then constraint groups)
+    std::vector<int> m_order;         ///< factorization order (children before parents)
+    std::vector<int> m_index_node;    ///< node of each unknown
+    std::vector<int> m_topology;      ///< topology of the problem at the last analysis
+    std::vector<int> m_topology_new;  ///< workspace for the current topology
+    Eigen::VectorXi m_row_nnz;        ///< number of nonzeros in each row of the system matrix
+    ChSparseMatrix m_mat;             ///< system matrix
+    ChVectorDynamic<double> m_rhs;    ///< right-hand side vector
+    ChVectorDynamic<double> m_sol;    ///< solution vector
+    ChVectorDynamic<double> m_tmp;    ///< workspace
+
+    ChTimer<> m_timer_setup;  ///< timer for analysis and factorization
+    ChTimer<> m_timer_solve;  ///< timer for the solution
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
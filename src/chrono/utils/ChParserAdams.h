@@ -20,6 +20,7 @@
 #define CH_PARSER_ADAMS_H
 
 #include <functional>
+#include <iterator>
 #include <map>
 #include <sstream>
 
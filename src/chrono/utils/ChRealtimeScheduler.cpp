@@ -0,0 +1,210 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Fixed-rate, deadline-aware scheduler for real-time simulation loops.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32) || defined(_WIN64)
+#include "Windows.h"
+#endif
+
+#include "chrono/solver/ChIterativeSolver.h"
+#include "chrono/utils/ChRealtimeScheduler.h"
+
+namespace chrono {
+namespace utils {
+
+// Weight of the last frame in the predicted frame duration (exponential moving average)
+static const double PREDICTION_WEIGHT = 0.3;
+
+ChRealtimeScheduler::ChRealtimeScheduler(double period)
+    : m_period(period),
+      m_spin_time(1e-3),
+      m_system(nullptr),
+      m_started(false),
+      m_stepped(false),
+      m_predicted(0),
+      m_degrade(false),
+      m_degraded(false),
+      m_margin(0.1),
+      m_min_iterations(1),
+      m_nominal_iterations(0),
+      m_iterations(0) {
+    for (int i = 0; i < NUM_PHASES; i++) {
+        m_stats[i].budget = std::numeric_limits<double>::infinity();
+        m_phase_time[i] = 0;
+    }
+    m_stats[FRAME].budget = period;
+    ResetStats();
+}
+
+void ChRealtimeScheduler::ResetStats() {
+    for (int i = 0; i < NUM_PHASES; i++) {
+        m_stats[i].num_frames = 0;
+        m_stats[i].num_overruns = 0;
+        m_stats[i].last = 0;
+        m_stats[i].max = 0;
+        m_stats[i].mean = 0;
+    }
+}
+
+void ChRealtimeScheduler::EnableDegradation(int min_iterations, double margin) {
+    m_degrade = true;
+    m_min_iterations = std::max(min_iterations, 1);
+    m_margin = margin;
+}
+
+void ChRealtimeScheduler::DisableDegradation() {
+    m_degrade = false;
+    if (m_degraded) {
+        m_iterations = m_nominal_iterations;
+        Degrade();
+    }
+}
+
+bool ChRealtimeScheduler::PinCurrentThread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32) || defined(_WIN64)
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#else
+    return false;
+#endif
+}
+
+void ChRealtimeScheduler::Start() {
+    m_frame_start = Clock::now();
+    m_deadline = m_frame_start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_period));
+    for (int i = 0; i < NUM_PHASES; i++)
+        m_phase_time[i] = 0;
+    m_stepped = false;
+    m_started = true;
+}
+
+int ChRealtimeScheduler::DoStep(double step) {
+    if (!m_system)
+        throw ChException("ChRealtimeScheduler::DoStep: no associated system.");
+    int result = m_system->DoStepDynamics(step);
+    m_phase_time[COLLISION] += m_system->GetTimerCollision();
+    m_phase_time[SOLVER] += m_system->GetTimerSetup() + m_system->GetTimerSolver();
+    m_stepped = true;
+    return result;
+}
+
+void ChRealtimeScheduler::BeginPhase(Phase phase) {
+    m_phase_start[phase] = Clock::now();
+}
+
+void ChRealtimeScheduler::EndPhase(Phase phase) {
+    m_phase_time[phase] += std::chrono::duration<double>(Clock::now() - m_phase_start[phase]).count();
+}
+
+void ChRealtimeScheduler::UpdateStats(Phase phase, double duration) {
+    PhaseStats& stats = m_stats[phase];
+    stats.num_frames++;
+    if (duration > stats.budget)
+        stats.num_overruns++;
+    stats.last = duration;
+    stats.max = std::max(stats.max, duration);
+    stats.mean += (duration - stats.mean) / stats.num_frames;
+}
+
+bool ChRealtimeScheduler::WaitFrame() {
+    auto now = Clock::now();
+    if (!m_started) {
+        Start();
+        return true;
+    }
+
+    // Deadline statistics for the frame and its phases
+    double frame_time = std::chrono::duration<double>(now - m_frame_start).count();
+    if (m_system && !m_stepped) {
+        m_phase_time[COLLISION] = m_system->GetTimerCollision();
+        m_phase_time[SOLVER] = m_system->GetTimerSetup() + m_system->GetTimerSolver();
+    }
+    m_stepped = false;
+    UpdateStats(FRAME, frame_time);
+    for (int i = FRAME + 1; i < NUM_PHASES; i++) {
+        UpdateStats(Phase(i), m_phase_time[i]);
+        m_phase_time[i] = 0;
+    }
+
+    // Predict the duration of the next frame and adapt the solver
+    if (m_stats[FRAME].num_frames == 1)
+        m_predicted = frame_time;
+    else
+        m_predicted += PREDICTION_WEIGHT * (frame_time - m_predicted);
+    if (m_degrade)
+        Degrade();
+
+    // A missed deadline restarts the schedule from the current time
+    auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_period));
+    if (now > m_deadline) {
+        m_frame_start = now;
+        m_deadline = now + period;
+        return false;
+    }
+
+    // Sleep until shortly before the deadline, then spin
+    auto spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(m_spin_time));
+    if (m_deadline - now > spin)
+        std::this_thread::sleep_until(m_deadline - spin);
+    while (Clock::now() < m_deadline) {
+    }
+
+    m_frame_start = m_deadline;
+    m_deadline += period;
+    return true;
+}
+
+void ChRealtimeScheduler::Degrade() {
+    if (!m_system)
+        return;
+    auto iterative = m_system->GetIterativeSolver();
+    if (!iterative)
+        return;
+
+    double threshold = (1 - m_margin) * m_period;
+
+    if (!m_degraded) {
+        if (!m_degrade || m_predicted <= threshold)
+            return;
+        m_nominal_iterations = iterative->GetMaxIterations();
+        m_iterations = m_nominal_iterations;
+        m_degraded = true;
+    }
+
+    // Reduce the iterations if an overrun is predicted; restore them progressively if there is enough slack
+    if (m_degrade && m_predicted > threshold) {
+        m_iterations = std::max(m_min_iterations, (3 * m_iterations) / 4);
+    } else if (!m_degrade || m_predicted < 0.5 * threshold) {
+        m_iterations = std::min(m_nominal_iterations, m_iterations + std::max(1, m_nominal_iterations / 10));
+    }
+
+    iterative->SetMaxIterations(m_iterations);
+    if (m_iterations >= m_nominal_iterations)
+        m_degraded = false;
+}
+
+}  // end namespace utils
+}  // end namespace chrono
@@ -0,0 +1,160 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Fixed-rate, deadline-aware scheduler for real-time simulation loops.
+//
+// =============================================================================
+
+#ifndef CH_REALTIME_SCHEDULER_H
+#define CH_REALTIME_SCHEDULER_H
+
+#include <chrono>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Fixed-rate scheduler for real-time simulation loops (e.g. driver-in-the-loop or motion simulator runs).\n
+/// The simulation loop is divided in frames of fixed wall clock duration (typically, one integration step).
+/// Frame deadlines are set on an absolute schedule, so that timing errors do not accumulate. At the end of
+/// each frame, WaitFrame sleeps until shortly before the deadline and then spins until the deadline, which
+/// frees the processor for most of the slack while keeping the wake-up jitter low.\n
+/// The scheduler keeps deadline statistics for the whole frame and for its phases: collision detection and
+/// solver (read from the timers of the associated system) and output (measured explicitly with
+/// BeginPhase/EndPhase). If the system is advanced with DoStep, the collision and solver times of all the steps
+/// in a frame are accumulated; otherwise, the system timers only cover the last integration step. A phase overruns when it exceeds its budget; a frame
+/// overruns when its deadline is missed, in which case the schedule is restarted from the current time (late
+/// frames are not caught up).\n
+/// If degradation is enabled, the scheduler predicts the duration of the next frame (exponential moving
+/// average of the frame durations) and, when an overrun is predicted, reduces the maximum number of
+/// iterations of the system solver (iterative solvers only). The iterations are restored progressively when
+/// the frames complete well ahead of their deadline.
+class ChApi ChRealtimeScheduler {
+  public:
+    /// Phases of a frame with deadline statistics.
+    enum Phase {
+        FRAME,      ///< whole frame (excluding the wait for the deadline)
+        COLLISION,  ///< collision detection
+        SOLVER,     ///< solver setup and solve
+        OUTPUT,     ///< output (or any other user code)
+        NUM_PHASES
+    };
+
+    /// Deadline statistics of a phase (durations in seconds).
+    struct PhaseStats {
+        unsigned int num_frames;    ///< number of frames measured
+        unsigned int num_overruns;  ///< number of frames in which the phase exceeded its budget
+        double budget;              ///< phase budget
+        double last;                ///< duration in the last frame
+        double max;                 ///< maximum duration
+        double mean;                ///< mean duration
+    };
+
+    /// Create a scheduler with the specified frame period (in seconds).
+    ChRealtimeScheduler(double period);
+
+    ~ChRealtimeScheduler() {}
+
+    /// Set the system whose timers provide the collision and solver phase durations, and whose solver is
+    /// degraded when an overrun is predicted.
+    void SetSystem(ChSystem* system) { m_system = system; }
+
+    /// Set the time before a deadline at which WaitFrame stops sleeping and starts spinning (default: 1 ms).
+    /// This should be larger than the sleep granularity of the operating system.
+    void SetSpinTime(double spin_time) { m_spin_time = spin_time; }
+
+    /// Set the budget of a phase (default: the frame period for FRAME, unlimited for the other phases).
+    void SetPhaseBudget(Phase phase, double budget) { m_stats[phase].budget = budget; }
+
+    /// Enable degradation of the solver when an overrun is predicted.
+    /// An overrun is predicted when the predicted frame duration exceeds (1 - margin) times the frame period. The
+    /// maximum number of solver iterations is then reduced, down to 'min_iterations'.
+    void EnableDegradation(int min_iterations, double margin = 0.1);
+
+    /// Disable degradation of the solver and restore the nominal number of solver iterations.
+    void DisableDegradation();
+
+    /// Pin the calling thread to the specified processor (e.g. the simulation thread).
+    /// Return false if this is not supported on the current platform or if the call failed.
+    static bool PinCurrentThread(int cpu);
+
+    /// Start the schedule: the first frame starts now.
+    /// If not called explicitly, the schedule starts at the first call to WaitFrame.
+    void Start();
+
+    /// Advance the associated system by one integration step, accumulating its collision and solver times in the
+    /// current frame. Return the value returned by ChSystem::DoStepDynamics.
+    int DoStep(double step);
+
+    /// Mark the beginning of a phase in the current frame.
+    /// A phase can be measured in several parts within a frame; the durations are accumulated. The COLLISION and
+    /// SOLVER phases need not be measured explicitly if a system was specified (see SetSystem).
+    void BeginPhase(Phase phase);
+
+    /// Mark the end of a phase in the current frame.
+    void EndPhase(Phase phase);
+
+    /// End the current frame: update the statistics, adapt the solver if needed, and wait until the deadline.
+    /// Return false if the deadline was missed.
+    bool WaitFrame();
+
+    /// Get the deadline statistics for the specified phase.
+    const PhaseStats& GetStats(Phase phase) const { return m_stats[phase]; }
+
+    /// Get the predicted duration of the next frame.
+    double GetPredictedFrameTime() const { return m_predicted; }
+
+    /// Get the current maximum number of solver iterations (0 if the solver is not degraded).
+    int GetSolverIterations() const { return m_degraded ? m_iterations : 0; }
+
+    /// Reset the deadline statistics.
+    void ResetStats();
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    void UpdateStats(Phase phase, double duration);
+    void Degrade();
+
+    double m_period;
+    double m_spin_time;
+    ChSystem* m_system;
+
+    bool m_started;
+    Clock::time_point m_frame_start;
+    Clock::time_point m_deadline;
+    Clock::time_point m_phase_start[NUM_PHASES];
+    double m_phase_time[NUM_PHASES];
+    bool m_stepped;
+
+    PhaseStats m_stats[NUM_PHASES];
+    double m_predicted;
+
+    bool m_degrade;
+    bool m_degraded;
+    double m_margin;
+    int m_min_iterations;
+    int m_nominal_iterations;
+    int m_iterations;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
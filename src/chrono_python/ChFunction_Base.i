@@ -2,6 +2,7 @@
 
 /* Includes the header in the wrapper code */
 #include "chrono/motion_functions/ChFunction_Base.h"
+#include "chrono/motion_functions/ChFunction_Compiled.h"
 #include "chrono/motion_functions/ChFunction_Const.h"
 #include "chrono/motion_functions/ChFunction_ConstAcc.h"
 #include "chrono/motion_functions/ChFunction_Derive.h"
@@ -64,6 +65,8 @@ SWIGRUNTIME PyObject* DowncastChFunction(chrono::ChFunction* out)
 			return SWIG_NewPointerObj(SWIG_as_voidptr(out), SWIGTYPE_p_chrono__ChFunction_Sigma, 0 |  0 );
 		else if ( typeid(*out)==typeid(chrono::ChFunction_Sine) )
 			return SWIG_NewPointerObj(SWIG_as_voidptr(out), SWIGTYPE_p_chrono__ChFunction_Sine, 0 |  0 );
+		else if ( typeid(*out)==typeid(chrono::ChFunction_Compiled) )
+			return SWIG_NewPointerObj(SWIG_as_voidptr(out), SWIGTYPE_p_chrono__ChFunction_Compiled, 0 |  0 );
 		else
 			return SWIG_NewPointerObj(SWIG_as_voidptr(out), SWIGTYPE_p_chrono__ChFunction, 0 |  0 );
    } 
@@ -100,6 +103,7 @@ SWIGRUNTIME PyObject* DowncastChFunction(chrono::ChFunction* out)
 %include "../chrono/motion_functions/ChFunction_Sequence.h"
 %include "../chrono/motion_functions/ChFunction_Sigma.h"
 %include "../chrono/motion_functions/ChFunction_Sine.h"
+%include "../chrono/motion_functions/ChFunction_Compiled.h"
 
 // The following is clean but may cause code bloat...
 
@@ -159,6 +159,7 @@ using namespace chrono::fea;
 %shared_ptr(chrono::ChFunction_Sequence)
 %shared_ptr(chrono::ChFunction_Sigma)
 %shared_ptr(chrono::ChFunction_Sine)
+%shared_ptr(chrono::ChFunction_Compiled)
 
 
 %shared_ptr(chrono::collision::ChCollisionModel)
@@ -525,6 +526,7 @@ using namespace chrono::fea;
 %DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_Sequence)
 %DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_Sigma)
 %DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_Sine)
+%DefSharedPtrDynamicDowncast(chrono,ChFunction, ChFunction_Compiled)
 
 %DefSharedPtrDynamicDowncast(chrono,ChPhysicsItem, ChShaft)
 %DefSharedPtrDynamicDowncast(chrono,ChPhysicsItem, ChShaftsBody)
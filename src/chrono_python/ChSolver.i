@@ -8,6 +8,8 @@
 #include "chrono/solver/ChSolverVI.h"
 #include "chrono/solver/ChSolverLS.h"
 #include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChSolverSparseSchur.h"
+#include "chrono/solver/ChSolverTree.h"
 #include "chrono/solver/ChIterativeSolver.h"
 #include "chrono/solver/ChIterativeSolverLS.h"
 #include "chrono/solver/ChIterativeSolverVI.h"
@@ -15,6 +17,7 @@
 //#include "chrono/solver/ChSolverPMINRES.h"
 #include "chrono/solver/ChSolverBB.h"
 #include "chrono/solver/ChSolverAPGD.h"
+#include "chrono/solver/ChSolverADMM.h"
 #include "chrono/solver/ChSolverPSOR.h"
 #include "chrono/solver/ChSolverPJacobi.h"
 
@@ -39,15 +42,20 @@ using namespace chrono;
 %shared_ptr(chrono::ChSolverMINRES)
 %shared_ptr(chrono::ChSolverBB)
 %shared_ptr(chrono::ChSolverAPGD)
+%shared_ptr(chrono::ChSolverADMM)
 %shared_ptr(chrono::ChSolverPSOR)
 %shared_ptr(chrono::ChSolverPJacobi)
 %shared_ptr(chrono::ChSolverSparseLU)
 %shared_ptr(chrono::ChSolverSparseQR)
+%shared_ptr(chrono::ChSolverSparseSchur)
+%shared_ptr(chrono::ChSolverTree)
 
 %include "../chrono/solver/ChSolver.h"
 %include "../chrono/solver/ChSolverVI.h"
 %include "../chrono/solver/ChSolverLS.h"
 %include "../chrono/solver/ChDirectSolverLS.h"
+%include "../chrono/solver/ChSolverSparseSchur.h"
+%include "../chrono/solver/ChSolverTree.h"
 %include "../chrono/solver/ChIterativeSolver.h"
 %include "../chrono/solver/ChIterativeSolverLS.h"
 %include "../chrono/solver/ChIterativeSolverVI.h"
@@ -57,6 +65,7 @@ using namespace chrono;
 //%include "../chrono/solver/ChSolverPMINRES.h"
 %include "../chrono/solver/ChSolverBB.h"
 %include "../chrono/solver/ChSolverAPGD.h"
+%include "../chrono/solver/ChSolverADMM.h"
 %include "../chrono/solver/ChSolverPSOR.h"
 %include "../chrono/solver/ChSolverPJacobi.h"
 
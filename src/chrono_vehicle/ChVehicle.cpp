@@ -103,6 +103,11 @@ void ChVehicle::SetOutput(ChVehicleOutput::Type type,
         case ChVehicleOutput::HDF5:
 #ifdef CHRONO_HAS_HDF5
             m_output_db = new ChVehicleOutputHDF5(out_dir + "/" + out_name + ".h5");
+#endif
+            break;
+        case ChVehicleOutput::HDF5_APPEND:
+#ifdef CHRONO_HAS_HDF5
+            m_output_db = new ChVehicleOutputHDF5(out_dir + "/" + out_name + ".h5", ChVehicleOutputHDF5::Mode::APPEND);
 #endif
             break;
     }
@@ -16,8 +16,16 @@
 //
 // =============================================================================
 
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "chrono/core/ChGlobal.h"
+#include "chrono/core/ChTypes.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
 #include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
 
 namespace chrono {
 namespace vehicle {
@@ -41,5 +49,74 @@ std::string GetDataFile(const std::string& filename) {
     return chrono_vehicle_data_path + filename;
 }
 
+// -----------------------------------------------------------------------------
+// Cache of model data files
+// -----------------------------------------------------------------------------
+
+static std::atomic<bool> data_caching(false);
+
+// Loaded meshes. A mesh requested concurrently by several threads is loaded by the first one, the others waiting
+// for it.
+struct CachedMesh {
+    std::once_flag loaded;
+    std::shared_ptr<geometry::ChTriangleMeshConnected> trimesh;
+};
+typedef std::tuple<std::string, bool, bool> MeshKey;
+static std::map<MeshKey, std::shared_ptr<CachedMesh>> mesh_cache;
+static std::mutex mesh_cache_mutex;
+static std::atomic<int> mesh_cache_loads(0);
+
+void SetDataCaching(bool val) {
+    data_caching = val;
+}
+
+bool GetDataCaching() {
+    return data_caching;
+}
+
+void ClearDataCache() {
+    {
+        std::lock_guard<std::mutex> lock(mesh_cache_mutex);
+        mesh_cache.clear();
+        mesh_cache_loads = 0;
+    }
+    ClearCacheJSON();
+}
+
+int GetDataCacheLoads() {
+    return mesh_cache_loads + GetCacheLoadsJSON();
+}
+
+std::shared_ptr<geometry::ChTriangleMeshConnected> LoadMesh(const std::string& filename,
+                                                            bool load_normals,
+                                                            bool load_uv,
+                                                            bool shared) {
+    if (!data_caching) {
+        auto trimesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
+        trimesh->LoadWavefrontMesh(filename, load_normals, load_uv);
+        return trimesh;
+    }
+
+    // The mesh is loaded outside the cache lock, so that different meshes can be loaded concurrently
+    std::shared_ptr<CachedMesh> cached;
+    {
+        std::lock_guard<std::mutex> lock(mesh_cache_mutex);
+        auto& entry = mesh_cache[MeshKey(filename, load_normals, load_uv)];
+        if (!entry)
+            entry = chrono_types::make_shared<CachedMesh>();
+        cached = entry;
+    }
+    std::call_once(cached->loaded, [&]() {
+        mesh_cache_loads++;
+        auto trimesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
+        trimesh->LoadWavefrontMesh(filename, load_normals, load_uv);
+        cached->trimesh = trimesh;
+    });
+
+    if (shared)
+        return cached->trimesh;
+    return chrono_types::make_shared<geometry::ChTriangleMeshConnected>(*cached->trimesh);
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -19,11 +19,17 @@
 #ifndef CH_VEHICLE_MODELDATA_H
 #define CH_VEHICLE_MODELDATA_H
 
+#include <memory>
 #include <string>
 
 #include "chrono_vehicle/ChApiVehicle.h"
 
 namespace chrono {
+
+namespace geometry {
+class ChTriangleMeshConnected;
+}
+
 namespace vehicle {
 
 /// @addtogroup vehicle
@@ -40,6 +46,31 @@ CH_VEHICLE_API const std::string& GetDataPath();
 /// data directory.
 CH_VEHICLE_API std::string GetDataFile(const std::string& filename);
 
+/// Enable or disable caching of model data files (default: disabled).
+/// With caching enabled, JSON specification files (see ReadFileJSON) and Wavefront OBJ meshes (see LoadMesh)
+/// are read and parsed only once; subsequent requests for the same file are served from memory. This is
+/// meant for processes creating many instances of the same models (see ChEnsembleRunner). Cached data is
+/// not refreshed if the files change on disk (see ClearDataCache). Thread safe.
+CH_VEHICLE_API void SetDataCaching(bool val);
+
+/// Return true if caching of model data files is enabled (thread safe).
+CH_VEHICLE_API bool GetDataCaching();
+
+/// Release all cached model data (thread safe).
+CH_VEHICLE_API void ClearDataCache();
+
+/// Get the number of model data files loaded into the cache since it was last cleared (thread safe).
+/// Each file is loaded only once, even if requested concurrently by several threads.
+CH_VEHICLE_API int GetDataCacheLoads();
+
+/// Load a triangle mesh from the specified Wavefront OBJ file (thread safe).
+/// If 'shared' is true and data caching is enabled, the returned mesh is the cached instance, shared with
+/// all other callers: it must be treated as read-only. Otherwise, the caller gets its own copy of the mesh.
+CH_VEHICLE_API std::shared_ptr<geometry::ChTriangleMeshConnected> LoadMesh(const std::string& filename,
+                                                                           bool load_normals,
+                                                                           bool load_uv,
+                                                                           bool shared = false);
+
 /// @} vehicle
 
 }  // end namespace vehicle
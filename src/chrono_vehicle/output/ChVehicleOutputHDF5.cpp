@@ -16,11 +16,14 @@
 //
 // =============================================================================
 
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <fstream>
 
+#include "chrono/core/ChLog.h"
 #include "chrono/physics/ChLinkLock.h"
 #include "chrono/physics/ChLinkUniversal.h"
 
@@ -31,6 +34,10 @@ namespace vehicle {
 
 // -----------------------------------------------------------------------------
 
+struct time_info {
+    double time;  // frame time
+};
+
 struct body_info {
     int id;                 // body identifier
     double x, y, z;         // position
@@ -101,6 +108,7 @@ struct bodyload_info {
     double tx, ty, tz;  // joint reaction torque
 };
 
+H5::CompType* ChVehicleOutputHDF5::m_time_type = nullptr;
 H5::CompType* ChVehicleOutputHDF5::m_body_type = nullptr;
 H5::CompType* ChVehicleOutputHDF5::m_bodyaux_type = nullptr;
 H5::CompType* ChVehicleOutputHDF5::m_shaft_type = nullptr;
@@ -111,6 +119,19 @@ H5::CompType* ChVehicleOutputHDF5::m_linspring_type = nullptr;
 H5::CompType* ChVehicleOutputHDF5::m_rotspring_type = nullptr;
 H5::CompType* ChVehicleOutputHDF5::m_bodyload_type = nullptr;
 
+const H5::CompType& ChVehicleOutputHDF5::getTimeType() {
+    if (!m_time_type) {
+        struct Initializer {
+            Initializer() {
+                m_time_type = new H5::CompType(sizeof(time_info));
+                m_time_type->insertMember("time", HOFFSET(time_info, time), H5::PredType::NATIVE_DOUBLE);
+            }
+        };
+        static Initializer ListInitializationGuard;
+    }
+    return *m_time_type;
+}
+
 const H5::CompType& ChVehicleOutputHDF5::getBodyType() {
     if (!m_body_type) {
         struct Initializer {
@@ -280,13 +301,49 @@ const H5::CompType& ChVehicleOutputHDF5::getBodyLoadType() {
 
 // -----------------------------------------------------------------------------
 
-ChVehicleOutputHDF5::ChVehicleOutputHDF5(const std::string& filename)
-    : m_frame_group(nullptr), m_section_group(nullptr) {
-    m_fileHDF5 = new H5::H5File(filename, H5F_ACC_TRUNC);
-    H5::Group frames_group(m_fileHDF5->createGroup("/Frames"));
+// Size of the buffered records above which they are handed over to the writer thread (APPEND mode)
+static const size_t FLUSH_SIZE = 1 << 20;
+
+std::mutex& ChVehicleOutputHDF5::GetLibraryMutex() {
+    static std::mutex library_mutex;
+    return library_mutex;
+}
+
+ChVehicleOutputHDF5::ChVehicleOutputHDF5(const std::string& filename, Mode mode, int compression, int chunk_size)
+    : m_frame_group(nullptr),
+      m_section_group(nullptr),
+      m_mode(mode),
+      m_compression(compression),
+      m_chunk_size(chunk_size),
+      m_frame(0),
+      m_buffered_size(0),
+      m_stop(false) {
+    {
+        std::lock_guard<std::mutex> lock(GetLibraryMutex());
+        m_fileHDF5 = new H5::H5File(filename, H5F_ACC_TRUNC);
+        if (m_mode == Mode::FRAMES)
+            H5::Group frames_group(m_fileHDF5->createGroup("/Frames"));
+    }
+
+    if (m_mode == Mode::APPEND)
+        m_writer = std::thread(&ChVehicleOutputHDF5::WriterLoop, this);
 }
 
 ChVehicleOutputHDF5::~ChVehicleOutputHDF5() {
+    if (m_mode == Mode::APPEND) {
+        Flush();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_writer.join();
+        if (!m_error.empty())
+            GetLog() << "Warning: HDF5 vehicle output incomplete: " << m_error.c_str() << "\n";
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    m_datasets.clear();
     if (m_section_group)
         m_section_group->close();
     if (m_frame_group)
@@ -296,15 +353,125 @@ ChVehicleOutputHDF5::~ChVehicleOutputHDF5() {
     delete m_section_group;
     delete m_frame_group;
     delete m_fileHDF5;
-    
-    delete m_body_type;
-    delete m_bodyaux_type;
-    delete m_shaft_type;
-    delete m_marker_type;
-    delete m_joint_type;
-    delete m_couple_type;
-    delete m_linspring_type;
-    delete m_rotspring_type;
+
+    // Note: the record types are shared by all output databases, and are therefore not deleted here.
+}
+
+// -----------------------------------------------------------------------------
+// APPEND mode: buffering of records in the simulation thread
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void ChVehicleOutputHDF5::Append(const std::string& path, const H5::CompType& (*type)(), const std::vector<T>& info) {
+    // Buffered record: frame number followed by the component record
+    struct Record {
+        int frame;
+        T info;
+    };
+
+    Buffer& buffer = m_buffers[path];
+    buffer.type = type;
+    buffer.offset = offsetof(Record, info);
+    buffer.size = sizeof(Record);
+
+    size_t start = buffer.data.size();
+    buffer.data.resize(start + info.size() * sizeof(Record));
+    for (size_t i = 0; i < info.size(); i++) {
+        Record rec = {m_frame, info[i]};
+        std::memcpy(buffer.data.data() + start + i * sizeof(Record), &rec, sizeof(Record));
+    }
+    m_buffered_size += info.size() * sizeof(Record);
+}
+
+void ChVehicleOutputHDF5::Flush() {
+    if (m_buffers.empty())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(m_buffers));
+    }
+    m_cv.notify_one();
+    m_buffers.clear();
+    m_buffered_size = 0;
+}
+
+// -----------------------------------------------------------------------------
+// APPEND mode: writer thread (the only one accessing the file after construction)
+// -----------------------------------------------------------------------------
+
+void ChVehicleOutputHDF5::WriterLoop() {
+    while (true) {
+        BufferMap buffers;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty())
+                return;
+            buffers = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        WriteBuffersSafe(buffers);
+    }
+}
+
+void ChVehicleOutputHDF5::WriteBuffersSafe(BufferMap& buffers) {
+    try {
+        std::lock_guard<std::mutex> lock(GetLibraryMutex());
+        WriteBuffers(buffers);
+    } catch (H5::Exception& e) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_error.empty())
+            m_error = e.getDetailMsg();
+    }
+}
+
+void ChVehicleOutputHDF5::WriteBuffers(BufferMap& buffers) {
+    for (auto& entry : buffers) {
+        const std::string& path = entry.first;
+        const Buffer& buffer = entry.second;
+
+        auto dataset = m_datasets.find(path);
+        if (dataset == m_datasets.end()) {
+            // Record type: frame number followed by the members of the component record
+            H5::CompType type(buffer.size);
+            type.insertMember("frame", 0, H5::PredType::NATIVE_INT);
+            const H5::CompType& info_type = buffer.type();
+            for (int m = 0; m < info_type.getNmembers(); m++) {
+                type.insertMember(info_type.getMemberName(m), buffer.offset + info_type.getMemberOffset(m),
+                                  info_type.getMemberDataType(m));
+            }
+
+            // Create the section group, if needed
+            auto pos = path.rfind('/');
+            if (pos > 0 && m_groups.insert(path.substr(0, pos)).second)
+                m_fileHDF5->createGroup(path.substr(0, pos));
+
+            // Create an empty extendible, chunked dataset
+            hsize_t dim = 0;
+            hsize_t max_dim = H5S_UNLIMITED;
+            hsize_t chunk_dim = m_chunk_size;
+            H5::DataSpace dataspace(1, &dim, &max_dim);
+            H5::DSetCreatPropList plist;
+            plist.setChunk(1, &chunk_dim);
+            if (m_compression > 0)
+                plist.setDeflate(m_compression);
+
+            H5::DataSet set = m_fileHDF5->createDataSet(path, type, dataspace, plist);
+            dataset = m_datasets.insert(std::make_pair(path, Dataset{type, set, 0})).first;
+        }
+
+        // Extend the dataset and write the new records at its end
+        Dataset& ds = dataset->second;
+        hsize_t count = buffer.data.size() / buffer.size;
+        hsize_t size = ds.size + count;
+        ds.set.extend(&size);
+        H5::DataSpace filespace = ds.set.getSpace();
+        filespace.selectHyperslab(H5S_SELECT_SET, &count, &ds.size);
+        H5::DataSpace memspace(1, &count);
+        ds.set.write(buffer.data.data(), ds.type, memspace, filespace);
+        ds.size = size;
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -318,6 +485,17 @@ std::string format_number(int num, int precision) {
 // -----------------------------------------------------------------------------
 
 void ChVehicleOutputHDF5::WriteTime(int frame, double time) {
+    if (m_mode == Mode::APPEND) {
+        if (m_buffered_size >= FLUSH_SIZE)
+            Flush();
+        m_frame = frame;
+        m_section.clear();
+        Append("/Time", &getTimeType, std::vector<time_info>(1, {time}));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+
     // Close the currently open section group
     if (m_section_group) {
         m_section_group->close();
@@ -346,6 +524,13 @@ void ChVehicleOutputHDF5::WriteTime(int frame, double time) {
 }
 
 void ChVehicleOutputHDF5::WriteSection(const std::string& name) {
+    if (m_mode == Mode::APPEND) {
+        m_section = "/" + name;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+
     // Close the currently open section group
     if (m_section_group) {
         m_section_group->close();
@@ -362,8 +547,6 @@ void ChVehicleOutputHDF5::WriteBodies(const std::vector<std::shared_ptr<ChBody>>
         return;
 
     auto nbodies = bodies.size();
-    hsize_t dim[] = {nbodies};
-    H5::DataSpace dataspace(1, dim);
     std::vector<body_info> info(nbodies);
     for (auto i = 0; i < nbodies; i++) {
         const ChVector<>& p = bodies[i]->GetPos();
@@ -371,6 +554,14 @@ void ChVehicleOutputHDF5::WriteBodies(const std::vector<std::shared_ptr<ChBody>>
         info[i] = {bodies[i]->GetIdentifier(), p.x(), p.y(), p.z(), q.e0(), q.e1(), q.e2(), q.e3()};
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Bodies", &getBodyType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = {nbodies};
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Bodies", getBodyType(), dataspace);
     set.write(info.data(), getBodyType());
 }
@@ -380,8 +571,6 @@ void ChVehicleOutputHDF5::WriteAuxRefBodies(const std::vector<std::shared_ptr<Ch
         return;
 
     auto nbodies = bodies.size();
-    hsize_t dim[] = { nbodies };
-    H5::DataSpace dataspace(1, dim);
     std::vector<bodyaux_info> info(nbodies);
     for (auto i = 0; i < nbodies; i++) {
         const ChVector<>& p = bodies[i]->GetPos();
@@ -389,6 +578,14 @@ void ChVehicleOutputHDF5::WriteAuxRefBodies(const std::vector<std::shared_ptr<Ch
         info[i] = { bodies[i]->GetIdentifier(), p.x(), p.y(), p.z(), q.e0(), q.e1(), q.e2(), q.e3() };
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Bodies AuxRef", &getBodyAuxType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = { nbodies };
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Bodies AuxRef", getBodyAuxType(), dataspace);
     set.write(info.data(), getBodyAuxType());
 }
@@ -398,8 +595,6 @@ void ChVehicleOutputHDF5::WriteMarkers(const std::vector<std::shared_ptr<ChMarke
         return;
 
     auto nmarkers = markers.size();
-    hsize_t dim[] = {nmarkers};
-    H5::DataSpace dataspace(1, dim);
     std::vector<marker_info> info(nmarkers);
     for (auto i = 0; i < nmarkers; i++) {
         const ChVector<>& p = markers[i]->GetAbsCoord().pos;
@@ -408,6 +603,14 @@ void ChVehicleOutputHDF5::WriteMarkers(const std::vector<std::shared_ptr<ChMarke
         info[i] = {markers[i]->GetIdentifier(), p.x(), p.y(), p.z(), pd.x(), pd.y(), pd.z(), pdd.x(), pdd.y(), pdd.z()};
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Markers", &getMarkerType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = {nmarkers};
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Markers", getMarkerType(), dataspace);
     set.write(info.data(), getMarkerType());
 }
@@ -417,14 +620,20 @@ void ChVehicleOutputHDF5::WriteShafts(const std::vector<std::shared_ptr<ChShaft>
         return;
 
     auto nshafts = shafts.size();
-    hsize_t dim[] = {nshafts};
-    H5::DataSpace dataspace(1, dim);
     std::vector<shaft_info> info(nshafts);
     for (auto i = 0; i < nshafts; i++) {
         info[i] = {shafts[i]->GetIdentifier(), shafts[i]->GetPos(), shafts[i]->GetPos_dt(), shafts[i]->GetPos_dtdt(),
                    shafts[i]->GetAppliedTorque()};
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Shafts", &getShaftType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = {nshafts};
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Shafts", getShaftType(), dataspace);
     set.write(info.data(), getShaftType());
 }
@@ -434,8 +643,6 @@ void ChVehicleOutputHDF5::WriteJoints(const std::vector<std::shared_ptr<ChLink>>
         return;
 
     auto njoints = joints.size();
-    hsize_t dim[] = { njoints };
-    H5::DataSpace dataspace(1, dim);
     std::vector<joint_info> info(njoints);
     for (auto i = 0; i < njoints; i++) {
         const ChVector<>& f = joints[i]->Get_react_force();
@@ -443,6 +650,14 @@ void ChVehicleOutputHDF5::WriteJoints(const std::vector<std::shared_ptr<ChLink>>
         info[i] = { joints[i]->GetIdentifier(), f.x(), f.y(), f.z(), t.x(), t.y(), t.z() };
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Joints", &getJointType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = { njoints };
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Joints", getJointType(), dataspace);
     set.write(info.data(), getJointType());
 }
@@ -452,8 +667,6 @@ void ChVehicleOutputHDF5::WriteCouples(const std::vector<std::shared_ptr<ChShaft
         return;
 
     auto ncouples = couples.size();
-    hsize_t dim[] = {ncouples};
-    H5::DataSpace dataspace(1, dim);
     std::vector<couple_info> info(ncouples);
     for (auto i = 0; i < ncouples; i++) {
         info[i] = {couples[i]->GetIdentifier(),          couples[i]->GetRelativeRotation(),
@@ -461,6 +674,14 @@ void ChVehicleOutputHDF5::WriteCouples(const std::vector<std::shared_ptr<ChShaft
                    couples[i]->GetTorqueReactionOn1(),   couples[i]->GetTorqueReactionOn2()};
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Couples", &getCoupleType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = {ncouples};
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Couples", getCoupleType(), dataspace);
     set.write(info.data(), getCoupleType());
 }
@@ -470,14 +691,20 @@ void ChVehicleOutputHDF5::WriteLinSprings(const std::vector<std::shared_ptr<ChLi
         return;
 
     auto nsprings = springs.size();
-    hsize_t dim[] = {nsprings};
-    H5::DataSpace dataspace(1, dim);
     std::vector<linspring_info> info(nsprings);
     for (auto i = 0; i < nsprings; i++) {
         info[i] = {springs[i]->GetIdentifier(), springs[i]->GetLength(), springs[i]->GetVelocity(),
                    springs[i]->GetForce()};
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Lin Springs", &getLinSpringType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = {nsprings};
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Lin Springs", getLinSpringType(), dataspace);
     set.write(info.data(), getLinSpringType());
 }
@@ -487,14 +714,20 @@ void ChVehicleOutputHDF5::WriteRotSprings(const std::vector<std::shared_ptr<ChLi
         return;
 
     auto nsprings = springs.size();
-    hsize_t dim[] = {nsprings};
-    H5::DataSpace dataspace(1, dim);
     std::vector<rotspring_info> info(nsprings);
     for (auto i = 0; i < nsprings; i++) {
         info[i] = {springs[i]->GetIdentifier(), springs[i]->GetRotSpringAngle(), springs[i]->GetRotSpringSpeed(),
                    springs[i]->GetRotSpringTorque()};
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Rot Springs", &getRotSpringType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = {nsprings};
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Rot Springs", getRotSpringType(), dataspace);
     set.write(info.data(), getRotSpringType());
 }
@@ -504,8 +737,6 @@ void ChVehicleOutputHDF5::WriteBodyLoads(const std::vector<std::shared_ptr<ChLoa
         return;
 
     auto nloads = loads.size();
-    hsize_t dim[] = { nloads };
-    H5::DataSpace dataspace(1, dim);
     std::vector<bodyload_info> info(nloads);
     for (auto i = 0; i < nloads; i++) {
         ChVector<> f = loads[i]->GetForce();
@@ -513,6 +744,14 @@ void ChVehicleOutputHDF5::WriteBodyLoads(const std::vector<std::shared_ptr<ChLoa
         info[i] = { loads[i]->GetIdentifier(), f.x(), f.y(), f.z(), t.x(), t.y(), t.z() };
     }
 
+    if (m_mode == Mode::APPEND) {
+        Append(m_section + "/Body-body Loads", &getBodyLoadType, info);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(GetLibraryMutex());
+    hsize_t dim[] = { nloads };
+    H5::DataSpace dataspace(1, dim);
     H5::DataSet set = m_section_group->createDataSet("Body-body Loads", getBodyLoadType(), dataspace);
     set.write(info.data(), getBodyLoadType());
 }
@@ -19,8 +19,14 @@
 #ifndef CH_VEHICLE_OUTPUT_HDF5_H
 #define CH_VEHICLE_OUTPUT_HDF5_H
 
-#include <string>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
 
 #include "chrono_vehicle/ChVehicleOutput.h"
 
@@ -35,9 +41,30 @@ namespace vehicle {
 /// HDF5 vehicle output database.
 class CH_VEHICLE_API ChVehicleOutputHDF5 : public ChVehicleOutput {
   public:
-    ChVehicleOutputHDF5(const std::string& filename);
+    /// Layout of the output file.
+    enum class Mode {
+        FRAMES,  ///< one group per frame ("/Frames/Frame_000000/<section>/<component>")
+        APPEND   ///< one extendible dataset per component ("/<section>/<component>"), frames are appended
+    };
+
+    /// Create an HDF5 output database.
+    /// In APPEND mode, each record has an additional "frame" member and the frame times are stored in the "/Time"
+    /// dataset. Datasets are chunked (and optionally compressed). Records are buffered in memory and written by a
+    /// dedicated writer thread, so that output does not block the simulation; the file is complete only after the
+    /// database is destroyed.
+    ChVehicleOutputHDF5(const std::string& filename,  ///< [in] name of the output file
+                        Mode mode = Mode::FRAMES,     ///< [in] file layout
+                        int compression = 0,          ///< [in] deflate level (0: no compression) (APPEND only)
+                        int chunk_size = 1024         ///< [in] number of records per chunk (APPEND only)
+    );
+
     ~ChVehicleOutputHDF5();
 
+    /// Get the mutex serializing all calls into the HDF5 library made by vehicle output databases.
+    /// The HDF5 library is not necessarily built thread-safe, so any other code calling it while vehicle output is
+    /// written (e.g., from the writer thread of an APPEND database) must hold this mutex.
+    static std::mutex& GetLibraryMutex();
+
   private:
     virtual void WriteTime(int frame, double time) override;
     virtual void WriteSection(const std::string& name) override;
@@ -52,10 +79,55 @@ class CH_VEHICLE_API ChVehicleOutputHDF5 : public ChVehicleOutput {
     virtual void WriteRotSprings(const std::vector<std::shared_ptr<ChLinkRotSpringCB>>& springs) override;
     virtual void WriteBodyLoads(const std::vector<std::shared_ptr<ChLoadBodyBody>>& loads) override;
 
+    /// Records buffered for one dataset, in APPEND mode.
+    struct Buffer {
+        const H5::CompType& (*type)();  ///< type of the component records
+        size_t offset;                  ///< offset of the component record in the buffered records
+        size_t size;                    ///< size of the buffered records
+        std::vector<char> data;         ///< buffered records
+    };
+    typedef std::map<std::string, Buffer> BufferMap;
+
+    /// Dataset being appended to, in APPEND mode.
+    struct Dataset {
+        H5::CompType type;
+        H5::DataSet set;
+        hsize_t size;
+    };
+
+    template <typename T>
+    void Append(const std::string& path, const H5::CompType& (*type)(), const std::vector<T>& info);
+    void Flush();
+    void WriterLoop();
+    void WriteBuffers(BufferMap& buffers);
+    void WriteBuffersSafe(BufferMap& buffers);
+
     H5::H5File* m_fileHDF5;
     H5::Group* m_frame_group;
     H5::Group* m_section_group;
 
+    Mode m_mode;
+    int m_compression;
+    int m_chunk_size;
+
+    // APPEND mode: buffers filled by the simulation thread, handed over to the writer thread
+    int m_frame;
+    std::string m_section;
+    BufferMap m_buffers;
+    size_t m_buffered_size;
+
+    std::thread m_writer;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<BufferMap> m_queue;
+    bool m_stop;
+    std::string m_error;
+
+    // APPEND mode: datasets (only accessed by the writer thread)
+    std::map<std::string, Dataset> m_datasets;
+    std::set<std::string> m_groups;
+
+    static H5::CompType* m_time_type;
     static H5::CompType* m_body_type;
     static H5::CompType* m_bodyaux_type;
     static H5::CompType* m_shaft_type;
@@ -66,6 +138,7 @@ class CH_VEHICLE_API ChVehicleOutputHDF5 : public ChVehicleOutput {
     static H5::CompType* m_rotspring_type;
     static H5::CompType* m_bodyload_type;
 
+    static const H5::CompType& getTimeType();
     static const H5::CompType& getBodyType();
     static const H5::CompType& getBodyAuxType();
     static const H5::CompType& getShaftType();
@@ -103,7 +103,11 @@ void RigidTerrain::LoadPatch(const rapidjson::Value& d) {
         double sy = d["Geometry"]["Size"][1u].GetDouble();
         double hMin = d["Geometry"]["Height Range"][0u].GetDouble();
         double hMax = d["Geometry"]["Height Range"][1u].GetDouble();
-        patch = AddPatch(ChCoordsys<>(loc, rot), vehicle::GetDataFile(bmp_file), mesh_name, sx, sy, hMin, hMax);
+        if (d["Geometry"].HasMember("Height Field") && d["Geometry"]["Height Field"].GetBool())
+            patch = AddHeightFieldPatch(ChCoordsys<>(loc, rot), vehicle::GetDataFile(bmp_file), mesh_name, sx, sy,
+                                        hMin, hMax);
+        else
+            patch = AddPatch(ChCoordsys<>(loc, rot), vehicle::GetDataFile(bmp_file), mesh_name, sx, sy, hMin, hMax);
     }
 
     // Set contact material properties
@@ -272,83 +276,89 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
 
 // -----------------------------------------------------------------------------
 
-std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>& position,
-                                                            const std::string& heightmap_file,
-                                                            const std::string& mesh_name,
-                                                            double sizeX,
-                                                            double sizeY,
-                                                            double hMin,
-                                                            double hMax,
-                                                            double sweep_sphere_radius,
-                                                            bool visualization) {
-    auto patch = chrono_types::make_shared<MeshPatch>();
-    AddPatch(patch, position);
-
-    // Read the BMP file and extract number of pixels.
+// Read a BMP gray-scale height map into a grid of heights.
+// The gray level of a pixel is mapped to the height range, with black corresponding to hMin and white
+// corresponding to hMax. Note that pixels in a BMP start at the top-left corner, while the grid nodes are
+// ordered starting at the bottom-left corner, row after row.
+static void ReadHeightMap(const std::string& heightmap_file,
+                          double hMin,
+                          double hMax,
+                          std::vector<double>& heights,
+                          int& nv_x,
+                          int& nv_y) {
     BMP hmap;
     if (!hmap.ReadFromFile(heightmap_file.c_str())) {
         throw ChException("Cannot open height map BMP file");
     }
-    int nv_x = hmap.TellWidth();
-    int nv_y = hmap.TellHeight();
-
-    // Construct a triangular mesh of sizeX x sizeY.
-    // Each pixel in the BMP represents a vertex.
-    // The gray level of a pixel is mapped to the height range, with black corresponding
-    // to hMin and white corresponding to hMax.
-    // UV coordinates are mapped in [0,1] x [0,1].
-    // We use smoothed vertex normals.
+    nv_x = hmap.TellWidth();
+    nv_y = hmap.TellHeight();
+
+    double h_scale = (hMax - hMin) / 255;
+    heights.resize(nv_x * nv_y);
+    unsigned int iv = 0;
+    for (int iy = nv_y - 1; iy >= 0; --iy) {
+        for (int ix = 0; ix < nv_x; ++ix) {
+            // Calculate equivalent gray level (RGB -> YUV)
+            ebmpBYTE red = hmap(ix, iy)->Red;
+            ebmpBYTE green = hmap(ix, iy)->Green;
+            ebmpBYTE blue = hmap(ix, iy)->Blue;
+            double gray = 0.299 * red + 0.587 * green + 0.114 * blue;
+            // Map gray level to vertex height
+            heights[iv++] = hMin + gray * h_scale;
+        }
+    }
+}
+
+// Construct a triangular mesh of sizeX x sizeY from a grid of heights (ordered starting at the
+// bottom-left corner, row after row). Each grid node represents a vertex.
+// UV coordinates are mapped in [0,1] x [0,1].
+// We use smoothed vertex normals.
+static std::shared_ptr<geometry::ChTriangleMeshConnected> CreateGridMesh(const std::vector<double>& heights,
+                                                                         int nv_x,
+                                                                         int nv_y,
+                                                                         double sizeX,
+                                                                         double sizeY) {
     double dx = sizeX / (nv_x - 1);
     double dy = sizeY / (nv_y - 1);
-    double h_scale = (hMax - hMin) / 255;
     double x_scale = 1.0 / (nv_x - 1);
     double y_scale = 1.0 / (nv_y - 1);
     unsigned int n_verts = nv_x * nv_y;
     unsigned int n_faces = 2 * (nv_x - 1) * (nv_y - 1);
 
     // Resize mesh arrays.
-    patch->m_trimesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
-    patch->m_trimesh->getCoordsVertices().resize(n_verts);
-    patch->m_trimesh->getCoordsNormals().resize(n_verts);
-    patch->m_trimesh->getCoordsUV().resize(n_verts);
-    patch->m_trimesh->getCoordsColors().resize(n_verts);
+    auto trimesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
+    trimesh->getCoordsVertices().resize(n_verts);
+    trimesh->getCoordsNormals().resize(n_verts);
+    trimesh->getCoordsUV().resize(n_verts);
+    trimesh->getCoordsColors().resize(n_verts);
 
-    patch->m_trimesh->getIndicesVertexes().resize(n_faces);
-    patch->m_trimesh->getIndicesNormals().resize(n_faces);
+    trimesh->getIndicesVertexes().resize(n_faces);
+    trimesh->getIndicesNormals().resize(n_faces);
 
     // Initialize the array of accumulators (number of adjacent faces to a vertex)
     std::vector<int> accumulators(n_verts, 0);
 
     // Readability aliases
-    std::vector<ChVector<> >& vertices = patch->m_trimesh->getCoordsVertices();
-    std::vector<ChVector<> >& normals = patch->m_trimesh->getCoordsNormals();
-    std::vector<ChVector<int> >& idx_vertices = patch->m_trimesh->getIndicesVertexes();
-    std::vector<ChVector<int> >& idx_normals = patch->m_trimesh->getIndicesNormals();
+    std::vector<ChVector<> >& vertices = trimesh->getCoordsVertices();
+    std::vector<ChVector<> >& normals = trimesh->getCoordsNormals();
+    std::vector<ChVector<int> >& idx_vertices = trimesh->getIndicesVertexes();
+    std::vector<ChVector<int> >& idx_normals = trimesh->getIndicesNormals();
 
     // Load mesh vertices.
-    // Note that pixels in a BMP start at top-left corner.
-    // We order the vertices starting at the bottom-left corner, row after row.
     // The bottom-left corner corresponds to the point (-sizeX/2, -sizeY/2).
     unsigned int iv = 0;
     for (int iy = nv_y - 1; iy >= 0; --iy) {
         double y = 0.5 * sizeY - iy * dy;
         for (int ix = 0; ix < nv_x; ++ix) {
             double x = ix * dx - 0.5 * sizeX;
-            // Calculate equivalent gray level (RGB -> YUV)
-            ebmpBYTE red = hmap(ix, iy)->Red;
-            ebmpBYTE green = hmap(ix, iy)->Green;
-            ebmpBYTE blue = hmap(ix, iy)->Blue;
-            double gray = 0.299 * red + 0.587 * green + 0.114 * blue;
-            // Map gray level to vertex height
-            double z = hMin + gray * h_scale;
             // Set vertex location
-            vertices[iv] = ChVector<>(x, y, z);
+            vertices[iv] = ChVector<>(x, y, heights[iv]);
             // Initialize vertex normal to (0, 0, 0).
             normals[iv] = ChVector<>(0, 0, 0);
             // Assign color white to all vertices
-            patch->m_trimesh->getCoordsColors()[iv] = ChVector<float>(1, 1, 1);
+            trimesh->getCoordsColors()[iv] = ChVector<float>(1, 1, 1);
             // Set UV coordinates in [0,1] x [0,1]
-            patch->m_trimesh->getCoordsUV()[iv] = ChVector<>(ix * x_scale, iy * y_scale, 0.0);
+            trimesh->getCoordsUV()[iv] = ChVector<>(ix * x_scale, iy * y_scale, 0.0);
             ++iv;
         }
     }
@@ -390,6 +400,28 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
         normals[in] /= (double)accumulators[in];
     }
 
+    return trimesh;
+}
+
+std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>& position,
+                                                            const std::string& heightmap_file,
+                                                            const std::string& mesh_name,
+                                                            double sizeX,
+                                                            double sizeY,
+                                                            double hMin,
+                                                            double hMax,
+                                                            double sweep_sphere_radius,
+                                                            bool visualization) {
+    auto patch = chrono_types::make_shared<MeshPatch>();
+    AddPatch(patch, position);
+
+    // Read the BMP file and construct a triangular mesh of sizeX x sizeY.
+    std::vector<double> heights;
+    int nv_x;
+    int nv_y;
+    ReadHeightMap(heightmap_file, hMin, hMax, heights, nv_x, nv_y);
+    patch->m_trimesh = CreateGridMesh(heights, nv_x, nv_y, sizeX, sizeY);
+
     // Create contact geometry.
     patch->m_body->GetCollisionModel()->ClearModel();
     patch->m_body->GetCollisionModel()->AddTriangleMesh(patch->m_trimesh, true, false, VNULL, ChMatrix33<>(1),
@@ -411,6 +443,74 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(const ChCoordsys<>&
     return patch;
 }
 
+// -----------------------------------------------------------------------------
+
+std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddHeightFieldPatch(const ChCoordsys<>& position,
+                                                                       const std::string& heightmap_file,
+                                                                       const std::string& mesh_name,
+                                                                       double sizeX,
+                                                                       double sizeY,
+                                                                       double hMin,
+                                                                       double hMax,
+                                                                       bool visualization) {
+    auto heights = chrono_types::make_shared<std::vector<double>>();
+    int nv_x;
+    int nv_y;
+    ReadHeightMap(heightmap_file, hMin, hMax, *heights, nv_x, nv_y);
+
+    return AddHeightFieldPatch(position, heights, nv_x, nv_y, sizeX, sizeY, mesh_name, visualization);
+}
+
+std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddHeightFieldPatch(const ChCoordsys<>& position,
+                                                                       std::shared_ptr<std::vector<double>> heights,
+                                                                       int nx,
+                                                                       int ny,
+                                                                       double sizeX,
+                                                                       double sizeY,
+                                                                       const std::string& mesh_name,
+                                                                       bool visualization) {
+    if (nx < 2 || ny < 2 || (int)heights->size() < nx * ny) {
+        throw ChException("Invalid height field grid");
+    }
+
+    auto patch = chrono_types::make_shared<HeightFieldPatch>();
+    AddPatch(patch, position);
+
+    patch->m_heights = heights;
+    patch->m_nx = nx;
+    patch->m_ny = ny;
+    patch->m_sizeX = sizeX;
+    patch->m_sizeY = sizeY;
+    patch->m_dx = sizeX / (nx - 1);
+    patch->m_dy = sizeY / (ny - 1);
+
+    // Create contact geometry.
+    // Fall back to a triangular mesh if the collision system does not support height fields.
+    patch->m_body->GetCollisionModel()->ClearModel();
+    if (!patch->m_body->GetCollisionModel()->AddHeightField(heights, nx, ny, sizeX, sizeY)) {
+        patch->m_trimesh = CreateGridMesh(*heights, nx, ny, sizeX, sizeY);
+        patch->m_body->GetCollisionModel()->AddTriangleMesh(patch->m_trimesh, true, false);
+    }
+    patch->m_body->GetCollisionModel()->BuildModel();
+
+    // Create the visualization asset.
+    if (visualization) {
+        if (!patch->m_trimesh)
+            patch->m_trimesh = CreateGridMesh(*heights, nx, ny, sizeX, sizeY);
+        auto trimesh_shape = chrono_types::make_shared<ChTriangleMeshShape>();
+        trimesh_shape->SetMesh(patch->m_trimesh);
+        trimesh_shape->SetName(mesh_name);
+        patch->m_body->AddAsset(trimesh_shape);
+    }
+
+    auto range = std::minmax_element(heights->begin(), heights->begin() + nx * ny);
+    patch->m_radius = ChVector<>(sizeX, sizeY, *range.second - *range.first).Length() / 2;
+    patch->m_mesh_name = mesh_name;
+    patch->m_type = PatchType::HEIGHT_FIELD;
+
+    return patch;
+}
+
 // -----------------------------------------------------------------------------
 // Functions to modify properties of a patch
 // -----------------------------------------------------------------------------
@@ -550,7 +650,8 @@ void RigidTerrain::Initialize() {
 // -----------------------------------------------------------------------------
 // Functions for obtaining the terrain height, normal, and coefficient of
 // friction  at the specified location.
-// This is done by casting vertical rays into each patch collision model.
+// This is done by casting vertical rays into each mesh patch collision model, or
+// directly from the geometry of box and height-field patches.
 // -----------------------------------------------------------------------------
 double RigidTerrain::GetHeight(double x, double y) const {
     double height;
@@ -636,6 +737,63 @@ bool RigidTerrain::MeshPatch::FindPoint(double x, double y, double& height, ChVe
     return result.hit;
 }
 
+bool RigidTerrain::HeightFieldPatch::FindPoint(double x, double y, double& height, ChVector<>& normal) const {
+    // Intersect the vertical line through (x,y) with the height field, through lookups in the patch frame.
+    // If the patch Z axis is vertical, the first lookup is exact; otherwise, a few fixed-point iterations
+    // on the height of the query point are performed.
+    ChVector<> P(x, y, m_body->GetPos().z());
+    ChVector<> nrm_loc;
+    for (int iter = 0; iter < 10; iter++) {
+        ChVector<> P_loc = m_body->TransformPointParentToLocal(P);
+        double h_loc;
+        if (!FindPointLocal(P_loc.x(), P_loc.y(), h_loc, nrm_loc))
+            return false;
+        ChVector<> S = m_body->TransformPointLocalToParent(ChVector<>(P_loc.x(), P_loc.y(), h_loc));
+        P.z() = S.z();
+        if (std::abs(S.x() - x) + std::abs(S.y() - y) < 1e-10)
+            break;
+    }
+
+    height = P.z();
+    normal = m_body->TransformDirectionLocalToParent(nrm_loc);
+
+    return true;
+}
+
+bool RigidTerrain::HeightFieldPatch::FindPointLocal(double x, double y, double& height, ChVector<>& normal) const {
+    // Grid cell containing the point, and coordinates within the cell
+    double u = (x + 0.5 * m_sizeX) / m_dx;
+    double v = (y + 0.5 * m_sizeY) / m_dy;
+    if (u < 0 || v < 0 || u > m_nx - 1 || v > m_ny - 1)
+        return false;
+    int ix = std::min((int)u, m_nx - 2);
+    int iy = std::min((int)v, m_ny - 2);
+    u -= ix;
+    v -= iy;
+
+    const double* h = m_heights->data() + iy * m_nx + ix;
+    double h00 = h[0];
+    double h10 = h[1];
+    double h01 = h[m_nx];
+    double h11 = h[m_nx + 1];
+
+    // Interpolate on the triangle containing the point. Cells are split along the diagonal between
+    // nodes (ix,iy) and (ix+1,iy+1), as in the contact geometry.
+    double hu, hv;  // height increments along the cell sides
+    if (u >= v) {
+        hu = h10 - h00;
+        hv = h11 - h10;
+    } else {
+        hu = h11 - h01;
+        hv = h01 - h00;
+    }
+
+    height = h00 + u * hu + v * hv;
+    normal = ChVector<>(-hu / m_dx, -hv / m_dy, 1).GetNormalized();
+
+    return true;
+}
+
 // -----------------------------------------------------------------------------
 // Export all patch meshes as macros in PovRay include files.
 // -----------------------------------------------------------------------------
@@ -650,5 +808,11 @@ void RigidTerrain::MeshPatch::ExportMeshPovray(const std::string& out_dir, bool
                            ChQuaternion<>(1, 0, 0, 0), smoothed);
 }
 
+void RigidTerrain::HeightFieldPatch::ExportMeshPovray(const std::string& out_dir, bool smoothed) {
+    auto trimesh = m_trimesh ? m_trimesh : CreateGridMesh(*m_heights, m_nx, m_ny, m_sizeX, m_sizeY);
+    utils::WriteMeshPovray(*trimesh, m_mesh_name, out_dir, ChColor(1, 1, 1), ChVector<>(0, 0, 0),
+                           ChQuaternion<>(1, 0, 0, 0), smoothed);
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -48,9 +48,10 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
   public:
     /// Patch type.
     enum class PatchType {
-        BOX,        ///< rectangular box
-        MESH,       ///< triangular mesh (from a Wavefront OBJ file)
-        HEIGHT_MAP  ///< triangular mesh (generated from a gray-scale BMP height-map)
+        BOX,          ///< rectangular box
+        MESH,         ///< triangular mesh (from a Wavefront OBJ file)
+        HEIGHT_MAP,   ///< triangular mesh (generated from a gray-scale BMP height-map)
+        HEIGHT_FIELD  ///< regular grid of heights (from a gray-scale BMP height-map or user-provided)
     };
 
     /// Definition of a patch in a rigid terrain model.
@@ -155,6 +156,36 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
         bool visualization = true           ///< [in] enable/disable construction of visualization assets
     );
 
+    /// Add a terrain patch represented by a native height field.
+    /// The height map is specified through a BMP gray-scale image, as for the height-map patch above, but the
+    /// grid of heights is kept: terrain queries (height, normal) are answered by a direct lookup in the grid,
+    /// and contact uses a height-field collision shape (if supported by the collision system; otherwise, a
+    /// triangular mesh is generated). A triangular mesh is generated for visualization only if requested.
+    std::shared_ptr<Patch> AddHeightFieldPatch(
+        const ChCoordsys<>& position,       ///< [in] patch location and orientation
+        const std::string& heightmap_file,  ///< [in] filename for the height map (BMP)
+        const std::string& mesh_name,       ///< [in] name of the mesh asset
+        double sizeX,                       ///< [in] terrain dimension in the X direction
+        double sizeY,                       ///< [in] terrain dimension in the Y direction
+        double hMin,                        ///< [in] minimum height (black level)
+        double hMax,                        ///< [in] maximum height (white level)
+        bool visualization = true           ///< [in] enable/disable construction of visualization assets
+    );
+
+    /// Add a terrain patch represented by a native height field, from a grid of heights.
+    /// The height of grid node (i,j) is heights[j * nx + i], with i along X and j along Y, starting at the
+    /// (-sizeX/2, -sizeY/2) corner of the patch. The height data is shared, not copied.
+    std::shared_ptr<Patch> AddHeightFieldPatch(
+        const ChCoordsys<>& position,                   ///< [in] patch location and orientation
+        std::shared_ptr<std::vector<double>> heights,   ///< [in] grid heights (nx * ny values)
+        int nx,                                         ///< [in] number of grid nodes in the X direction
+        int ny,                                         ///< [in] number of grid nodes in the Y direction
+        double sizeX,                                   ///< [in] terrain dimension in the X direction
+        double sizeY,                                   ///< [in] terrain dimension in the Y direction
+        const std::string& mesh_name,                   ///< [in] name of the mesh asset
+        bool visualization = true                       ///< [in] enable/disable visualization assets
+    );
+
     /// Initialize all defined terrain patches.
     void Initialize();
 
@@ -190,7 +221,8 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     void ExportMeshPovray(const std::string& out_dir, bool smoothed = false);
 
     /// Evaluate terrain height, normal, and coefficient of friction at the specified (x,y) location.
-    /// The point on the terrain surface is obtained through ray casting into the terrain contact model.
+    /// The point on the terrain surface is obtained through ray casting into the terrain contact model
+    /// (for mesh patches) or directly from the patch geometry (for box and height-field patches).
     /// The return value is 'true' if the ray intersection succeeded and 'false' otherwise (in which case
     /// the output is set to heigh=0, normal=[0,0,1], and friction=0.8).
     bool FindPoint(double x, double y, double& height, ChVector<>& normal, float& friction) const;
@@ -211,6 +243,23 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
         virtual void ExportMeshPovray(const std::string& out_dir, bool smoothed = false) override;
     };
 
+    /// Patch represented as a height field.
+    struct CH_VEHICLE_API HeightFieldPatch : public Patch {
+        std::shared_ptr<std::vector<double>> m_heights;                ///< grid heights, row after row along X
+        int m_nx;                                                      ///< number of grid nodes in X direction
+        int m_ny;                                                      ///< number of grid nodes in Y direction
+        double m_sizeX;                                                ///< patch dimension in X direction
+        double m_sizeY;                                                ///< patch dimension in Y direction
+        double m_dx;                                                   ///< grid spacing in X direction
+        double m_dy;                                                   ///< grid spacing in Y direction
+        std::shared_ptr<geometry::ChTriangleMeshConnected> m_trimesh;  ///< visualization mesh (may be empty)
+        std::string m_mesh_name;                                       ///< name of associated mesh
+        virtual bool FindPoint(double x, double y, double& height, ChVector<>& normal) const override;
+        virtual void ExportMeshPovray(const std::string& out_dir, bool smoothed = false) override;
+        /// Height and normal at the specified (x,y) location, all expressed in the patch frame.
+        bool FindPointLocal(double x, double y, double& height, ChVector<>& normal) const;
+    };
+
     ChSystem* m_system;
     int m_num_patches;
     std::vector<std::shared_ptr<Patch>> m_patches;
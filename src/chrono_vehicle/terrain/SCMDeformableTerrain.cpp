@@ -590,14 +590,10 @@ void SCMDeformableSoil::ComputeInternalForces() {
     // Loop through all vertices.
     // - set default SCM quantities (in case no ray-hit)
     // - skip vertices outside moving patch (if option enabled)
-    // - cast ray and record result in a map (key: vertex index)
-    // - initialize patch id to -1 (not set)
-    struct HitRecord {
-        ChContactable* contactable;  // pointer to hit object
-        ChVector<> abs_point;        // hit point, expressed in global frame
-        int patch_id;                // index of associated patch id
-    };
-    std::unordered_map<int, HitRecord> hits;
+    // - collect the ray to be cast from the vertex
+    m_ray_vertices.clear();
+    m_ray_from.clear();
+    m_ray_to.clear();
 
     for (int i = 0; i < vertices.size(); ++i) {
         auto vertex_loc = plane.TransformParentToLocal(vertices[i]);
@@ -618,15 +614,35 @@ void SCMDeformableSoil::ComputeInternalForces() {
             }
         }
 
-        // Perform ray casting from current vertex
-        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
         ChVector<> to = vertices[i] + N * test_high_offset;
         ChVector<> from = to - N * test_low_offset;
-        this->GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
-        m_num_ray_casts++;
+        m_ray_vertices.push_back(i);
+        m_ray_from.push_back(from);
+        m_ray_to.push_back(to);
+    }
+
+    // Cast all rays in a single batch and record the results in a map (key: vertex index).
+    // Initialize patch id to -1 (not set).
+    struct HitRecord {
+        ChContactable* contactable;  // pointer to hit object
+        ChVector<> abs_point;        // hit point, expressed in global frame
+        int patch_id;                // index of associated patch id
+    };
+    std::unordered_map<int, HitRecord> hits;
+
+    int num_rays = (int)m_ray_vertices.size();
+    m_ray_results.resize(num_rays);
+    if (num_rays > 0) {
+        this->GetSystem()->GetCollisionSystem()->RayHitBatch(num_rays, m_ray_from.data(), m_ray_to.data(),
+                                                             m_ray_results.data());
+    }
+    m_num_ray_casts = num_rays;
+
+    for (int k = 0; k < num_rays; ++k) {
+        const auto& mrayhit_result = m_ray_results[k];
         if (mrayhit_result.hit) {
             HitRecord record = {mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1};
-            hits.insert(std::make_pair(i, record));
+            hits.insert(std::make_pair(m_ray_vertices[k], record));
         }
     }
 
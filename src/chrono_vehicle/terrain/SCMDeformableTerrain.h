@@ -361,6 +361,12 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
 
     SCMDeformableTerrain::SoilParametersCallback* m_soil_fun;
 
+    // Ray casting buffers (reused across steps)
+    std::vector<int> m_ray_vertices;                                          ///< vertex index of each ray
+    std::vector<ChVector<>> m_ray_from;                                       ///< ray start points
+    std::vector<ChVector<>> m_ray_to;                                         ///< ray end points
+    std::vector<collision::ChCollisionSystem::ChRayhitResult> m_ray_results;  ///< ray-hit results
+
     // Timers and counters
     ChTimer<double> m_timer_calc_areas;
     ChTimer<double> m_timer_ray_casting;
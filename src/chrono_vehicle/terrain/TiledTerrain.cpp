@@ -0,0 +1,552 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Rigid terrain streamed from a tiled on-disk representation
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "chrono/core/ChStream.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/physics/ChMaterialSurfaceNSC.h"
+#include "chrono/physics/ChMaterialSurfaceSMC.h"
+
+#include "chrono_vehicle/terrain/TiledTerrain.h"
+#include "chrono_vehicle/utils/ChUtilsJSON.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+using namespace rapidjson;
+
+namespace chrono {
+namespace vehicle {
+
+// Tile file layout (all values through ChStreamOutBinary, i.e. with portable byte ordering):
+//   magic, version, nx, ny, friction flag,
+//   heights (nx*ny doubles, row after row along X), friction coefficients (nx*ny floats, if present),
+//   magic (end marker, to detect truncated files).
+static const unsigned int TILE_MAGIC = 0x43485454;  // "CHTT"
+static const unsigned int TILE_VERSION = 1;
+
+static std::string GetTileFilename(const std::string& directory, int i, int j) {
+    return directory + "/tile_" + std::to_string(i) + "_" + std::to_string(j) + ".dat";
+}
+
+// -----------------------------------------------------------------------------
+// Construction from the tile index in the specified directory
+// -----------------------------------------------------------------------------
+TiledTerrain::TiledTerrain(ChSystem* system, const std::string& directory)
+    : m_system(system),
+      m_directory(directory),
+      m_friction(0.7f),
+      m_restitution(0.1f),
+      m_young_modulus(2e5f),
+      m_poisson_ratio(0.3f),
+      m_use_friction_map(false),
+      m_contact_callback(nullptr),
+      m_focus_point(VNULL),
+      m_num_sync_loads(0),
+      m_stop(false) {
+    Document d = ReadFileJSON(directory + "/tiles.json");
+    if (d.IsNull()) {
+        throw ChException("Cannot read tiled terrain index in " + directory);
+    }
+
+    assert(d.HasMember("Origin"));
+    assert(d.HasMember("Tile Size"));
+    assert(d.HasMember("Number of Tiles"));
+    assert(d.HasMember("Tile Grid"));
+
+    m_origin = ChVector2<>(d["Origin"][0u].GetDouble(), d["Origin"][1u].GetDouble());
+    m_sizeX = d["Tile Size"][0u].GetDouble();
+    m_sizeY = d["Tile Size"][1u].GetDouble();
+    m_ni = d["Number of Tiles"][0u].GetInt();
+    m_nj = d["Number of Tiles"][1u].GetInt();
+    m_nx = d["Tile Grid"][0u].GetInt();
+    m_ny = d["Tile Grid"][1u].GetInt();
+
+    double size = std::max(m_sizeX, m_sizeY);
+    SetDistances(size, 2 * size, 3 * size);
+}
+
+TiledTerrain::~TiledTerrain() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_loader.joinable())
+        m_loader.join();
+
+    delete m_contact_callback;
+}
+
+void TiledTerrain::SetDistances(double active, double prefetch, double evict) {
+    m_active_dist = active;
+    m_prefetch_dist = std::max(prefetch, active);
+    m_evict_dist = std::max(evict, m_prefetch_dist);
+}
+
+void TiledTerrain::SetContactMaterialProperties(float young_modulus, float poisson_ratio) {
+    m_young_modulus = young_modulus;
+    m_poisson_ratio = poisson_ratio;
+}
+
+// -----------------------------------------------------------------------------
+
+double TiledTerrain::GetDistance(int i, int j, const ChVector<>& point) const {
+    double x_min = m_origin.x() + i * m_sizeX;
+    double y_min = m_origin.y() + j * m_sizeY;
+    double dx = std::max(std::max(x_min - point.x(), point.x() - x_min - m_sizeX), 0.0);
+    double dy = std::max(std::max(y_min - point.y(), point.y() - y_min - m_sizeY), 0.0);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+ChVector<> TiledTerrain::GetFocusPoint() const {
+    return m_focus_body ? m_focus_body->GetPos() : m_focus_point;
+}
+
+// -----------------------------------------------------------------------------
+// Tile loading (called from both the main thread and the loader thread).
+// Return an empty pointer if the tile file does not exist or is not valid.
+// -----------------------------------------------------------------------------
+std::shared_ptr<TiledTerrain::TileData> TiledTerrain::LoadTile(TileKey key) const {
+    std::string filename = GetTileFilename(m_directory, (int)(key % m_ni), (int)(key / m_ni));
+    if (!filesystem::path(filename).exists())
+        return nullptr;
+
+    auto data = chrono_types::make_shared<TileData>();
+    try {
+        ChStreamInBinaryFile mstream(filename.c_str());
+
+        unsigned int magic;
+        unsigned int version;
+        int nx;
+        int ny;
+        int has_friction;
+        mstream >> magic >> version >> nx >> ny >> has_friction;
+        if (magic != TILE_MAGIC || version != TILE_VERSION || nx != m_nx || ny != m_ny)
+            return nullptr;
+
+        data->heights = chrono_types::make_shared<std::vector<double>>(nx * ny);
+        for (auto& h : *data->heights)
+            mstream >> h;
+        if (has_friction) {
+            data->friction.resize(nx * ny);
+            for (auto& f : data->friction)
+                mstream >> f;
+        }
+
+        mstream >> magic;
+        if (magic != TILE_MAGIC)
+            return nullptr;
+    } catch (ChException&) {
+        return nullptr;
+    }
+
+    return data;
+}
+
+void TiledTerrain::LoaderLoop() {
+    while (true) {
+        TileKey key;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_stop)
+                return;
+            key = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        auto data = LoadTile(key);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_loaded[key] = data;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Insertion of a tile in the system, as a fixed body with a height-field collision shape
+// -----------------------------------------------------------------------------
+void TiledTerrain::ActivateTile(TileKey key, std::shared_ptr<TileData> data) {
+    int i = (int)(key % m_ni);
+    int j = (int)(key / m_ni);
+
+    auto body = std::shared_ptr<ChBody>(m_system->NewBody());
+    body->SetNameString("tile_" + std::to_string(i) + "_" + std::to_string(j));
+    body->SetPos(ChVector<>(m_origin.x() + (i + 0.5) * m_sizeX, m_origin.y() + (j + 0.5) * m_sizeY, 0));
+    body->SetBodyFixed(true);
+    body->SetCollide(true);
+
+    switch (m_system->GetContactMethod()) {
+        case ChMaterialSurface::NSC:
+            body->GetMaterialSurfaceNSC()->SetFriction(m_friction);
+            body->GetMaterialSurfaceNSC()->SetRestitution(m_restitution);
+            break;
+        case ChMaterialSurface::SMC:
+            body->GetMaterialSurfaceSMC()->SetFriction(m_friction);
+            body->GetMaterialSurfaceSMC()->SetRestitution(m_restitution);
+            body->GetMaterialSurfaceSMC()->SetYoungModulus(m_young_modulus);
+            body->GetMaterialSurfaceSMC()->SetPoissonRatio(m_poisson_ratio);
+            break;
+    }
+
+    body->GetCollisionModel()->ClearModel();
+    if (!body->GetCollisionModel()->AddHeightField(data->heights, m_nx, m_ny, m_sizeX, m_sizeY)) {
+        // The collision system does not support height fields: use a triangular mesh
+        auto trimesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
+        double dx = m_sizeX / (m_nx - 1);
+        double dy = m_sizeY / (m_ny - 1);
+        for (int iy = 0; iy < m_ny; iy++) {
+            for (int ix = 0; ix < m_nx; ix++) {
+                trimesh->getCoordsVertices().push_back(ChVector<>(ix * dx - 0.5 * m_sizeX, iy * dy - 0.5 * m_sizeY,
+                                                                  (*data->heights)[iy * m_nx + ix]));
+            }
+        }
+        for (int iy = 0; iy < m_ny - 1; iy++) {
+            for (int ix = 0; ix < m_nx - 1; ix++) {
+                int v0 = ix + m_nx * iy;
+                trimesh->getIndicesVertexes().push_back(ChVector<int>(v0, v0 + m_nx + 1, v0 + m_nx));
+                trimesh->getIndicesVertexes().push_back(ChVector<int>(v0, v0 + 1, v0 + m_nx + 1));
+            }
+        }
+        body->GetCollisionModel()->AddTriangleMesh(trimesh, true, false);
+    }
+    body->GetCollisionModel()->BuildModel();
+
+    m_system->AddBody(body);
+
+    m_tiles[key] = {data, body};
+    m_models.insert(body->GetCollisionModel().get());
+}
+
+// -----------------------------------------------------------------------------
+// Custom callback for setting the location-dependent coefficient of friction
+// in the composite material of contacts with the tiles.
+// -----------------------------------------------------------------------------
+class TTContactCallback : public ChContactContainer::AddContactCallback {
+  public:
+    virtual void OnAddContact(const collision::ChCollisionInfo& contactinfo,
+                              ChMaterialComposite* const material) override {
+        // Check if this contact involves a tile, and find the other contactable.
+        ChBody* body_other = nullptr;
+        if (m_terrain->IsTileModel(contactinfo.modelA))
+            body_other = dynamic_cast<ChBody*>(contactinfo.modelB->GetContactable());
+        else if (m_terrain->IsTileModel(contactinfo.modelB))
+            body_other = dynamic_cast<ChBody*>(contactinfo.modelA->GetContactable());
+
+        // Do nothing if this contact does not involve a tile or if the other contactable is not a body.
+        if (!body_other)
+            return;
+
+        // Terrain coefficient of friction at the contact location (arbitrarily, the point on modelA).
+        auto friction_terrain = m_terrain->GetCoefficientFriction(contactinfo.vpA.x(), contactinfo.vpA.y());
+
+        // Set friction in composite material based on contact formulation.
+        auto& strategy = body_other->GetSystem()->GetMaterialCompositionStrategy();
+        switch (body_other->GetContactMethod()) {
+            case ChMaterialSurface::NSC: {
+                auto mat_other = std::static_pointer_cast<ChMaterialSurfaceNSC>(body_other->GetMaterialSurface());
+                auto friction = strategy.CombineFriction(friction_terrain, mat_other->sliding_friction);
+                auto mat = static_cast<ChMaterialCompositeNSC* const>(material);
+                mat->static_friction = friction;
+                mat->sliding_friction = friction;
+                break;
+            }
+            case ChMaterialSurface::SMC: {
+                auto mat_other = std::static_pointer_cast<ChMaterialSurfaceSMC>(body_other->GetMaterialSurface());
+                auto friction = strategy.CombineFriction(friction_terrain, mat_other->sliding_friction);
+                auto mat = static_cast<ChMaterialCompositeSMC* const>(material);
+                mat->mu_eff = friction;
+                break;
+            }
+        }
+    }
+
+    TiledTerrain* m_terrain;
+};
+
+bool TiledTerrain::IsTileModel(const collision::ChCollisionModel* model) const {
+    return m_models.count(model) > 0;
+}
+
+// -----------------------------------------------------------------------------
+// Update of the set of tiles around the focus point
+// -----------------------------------------------------------------------------
+void TiledTerrain::Initialize() {
+    UpdateTiles(true);
+
+    if (!m_loader.joinable())
+        m_loader = std::thread(&TiledTerrain::LoaderLoop, this);
+
+    if (m_use_friction_map && !m_contact_callback) {
+        auto callback = new TTContactCallback;
+        callback->m_terrain = this;
+        m_contact_callback = callback;
+        m_system->GetContactContainer()->RegisterAddContactCallback(m_contact_callback);
+    }
+}
+
+void TiledTerrain::Synchronize(double time) {
+    UpdateTiles(false);
+}
+
+void TiledTerrain::UpdateTiles(bool initial) {
+    ChVector<> point = GetFocusPoint();
+    auto distance = [this, &point](TileKey key) { return GetDistance((int)(key % m_ni), (int)(key / m_ni), point); };
+
+    // Collect the tiles loaded in the background, and drop the requests for tiles that are now far away
+    std::unordered_map<TileKey, std::shared_ptr<TileData>> loaded;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        loaded.swap(m_loaded);
+        for (auto it = m_queue.begin(); it != m_queue.end();) {
+            if (distance(*it) > m_evict_dist) {
+                m_requested.erase(*it);
+                it = m_queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& tile : loaded) {
+        m_requested.erase(tile.first);
+        if (!tile.second)
+            m_missing.insert(tile.first);
+        else if (m_tiles.find(tile.first) == m_tiles.end())
+            m_ready[tile.first] = tile.second;
+    }
+
+    // Evict far tiles
+    for (auto it = m_tiles.begin(); it != m_tiles.end();) {
+        if (distance(it->first) > m_evict_dist) {
+            m_models.erase(it->second.body->GetCollisionModel().get());
+            m_system->RemoveBody(it->second.body);
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = m_ready.begin(); it != m_ready.end();) {
+        if (distance(it->first) > m_evict_dist)
+            it = m_ready.erase(it);
+        else
+            ++it;
+    }
+
+    // Activate the tiles in the active region and request the tiles in the prefetch region
+    int i_min = std::max((int)std::floor((point.x() - m_prefetch_dist - m_origin.x()) / m_sizeX), 0);
+    int i_max = std::min((int)std::floor((point.x() + m_prefetch_dist - m_origin.x()) / m_sizeX), m_ni - 1);
+    int j_min = std::max((int)std::floor((point.y() - m_prefetch_dist - m_origin.y()) / m_sizeY), 0);
+    int j_max = std::min((int)std::floor((point.y() + m_prefetch_dist - m_origin.y()) / m_sizeY), m_nj - 1);
+
+    std::vector<TileKey> requests;
+    for (int j = j_min; j <= j_max; j++) {
+        for (int i = i_min; i <= i_max; i++) {
+            TileKey key = GetKey(i, j);
+            double dist = GetDistance(i, j, point);
+            if (dist > m_prefetch_dist || m_tiles.count(key) || m_missing.count(key))
+                continue;
+
+            auto ready = m_ready.find(key);
+            if (dist <= m_active_dist) {
+                if (ready != m_ready.end()) {
+                    ActivateTile(key, ready->second);
+                    m_ready.erase(ready);
+                    continue;
+                }
+                // Not loaded in time by the background thread: load now.
+                // A pending background request for this tile is discarded when it completes.
+                auto data = LoadTile(key);
+                if (!initial)
+                    m_num_sync_loads++;
+                if (data)
+                    ActivateTile(key, data);
+                else
+                    m_missing.insert(key);
+                continue;
+            }
+
+            if (ready == m_ready.end() && !m_requested.count(key)) {
+                m_requested.insert(key);
+                requests.push_back(key);
+            }
+        }
+    }
+
+    if (requests.empty())
+        return;
+
+    // Closest tiles first
+    std::sort(requests.begin(), requests.end(),
+              [&distance](TileKey a, TileKey b) { return distance(a) < distance(b); });
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.insert(m_queue.end(), requests.begin(), requests.end());
+    }
+    m_cv.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+// Functions for obtaining the terrain height, normal, and coefficient of
+// friction at the specified location, through a direct lookup in the tile grid.
+// -----------------------------------------------------------------------------
+const TiledTerrain::Tile* TiledTerrain::FindTile(double x, double y, double& u, double& v) const {
+    double xr = (x - m_origin.x()) / m_sizeX;
+    double yr = (y - m_origin.y()) / m_sizeY;
+    int i = (int)std::floor(xr);
+    int j = (int)std::floor(yr);
+    if (i < 0 || j < 0 || i >= m_ni || j >= m_nj)
+        return nullptr;
+
+    auto tile = m_tiles.find(GetKey(i, j));
+    if (tile == m_tiles.end())
+        return nullptr;
+
+    // Grid coordinates within the tile
+    u = (xr - i) * (m_nx - 1);
+    v = (yr - j) * (m_ny - 1);
+
+    return &tile->second;
+}
+
+bool TiledTerrain::FindPoint(double x, double y, double& height, ChVector<>& normal) const {
+    height = 0;
+    normal = ChVector<>(0, 0, 1);
+
+    double u, v;
+    const Tile* tile = FindTile(x, y, u, v);
+    if (!tile)
+        return false;
+
+    int ix = std::min((int)u, m_nx - 2);
+    int iy = std::min((int)v, m_ny - 2);
+    u -= ix;
+    v -= iy;
+
+    const double* h = tile->data->heights->data() + iy * m_nx + ix;
+    double h00 = h[0];
+    double h10 = h[1];
+    double h01 = h[m_nx];
+    double h11 = h[m_nx + 1];
+
+    // Interpolate on the triangle containing the point. Cells are split along the diagonal between
+    // nodes (ix,iy) and (ix+1,iy+1), as in the contact geometry.
+    double hu, hv;  // height increments along the cell sides
+    if (u >= v) {
+        hu = h10 - h00;
+        hv = h11 - h10;
+    } else {
+        hu = h11 - h01;
+        hv = h01 - h00;
+    }
+
+    height = h00 + u * hu + v * hv;
+    normal = ChVector<>(-hu * (m_nx - 1) / m_sizeX, -hv * (m_ny - 1) / m_sizeY, 1).GetNormalized();
+
+    return true;
+}
+
+double TiledTerrain::GetHeight(double x, double y) const {
+    double height;
+    ChVector<> normal;
+    FindPoint(x, y, height, normal);
+    return height;
+}
+
+ChVector<> TiledTerrain::GetNormal(double x, double y) const {
+    double height;
+    ChVector<> normal;
+    FindPoint(x, y, height, normal);
+    return normal;
+}
+
+float TiledTerrain::GetCoefficientFriction(double x, double y) const {
+    if (m_friction_fun)
+        return (*m_friction_fun)(x, y);
+
+    double u, v;
+    const Tile* tile = FindTile(x, y, u, v);
+    if (!tile || tile->data->friction.empty())
+        return m_friction;
+
+    // Bilinear interpolation of the friction map
+    int ix = std::min((int)u, m_nx - 2);
+    int iy = std::min((int)v, m_ny - 2);
+    u -= ix;
+    v -= iy;
+
+    const float* f = tile->data->friction.data() + iy * m_nx + ix;
+    return (float)((1 - v) * ((1 - u) * f[0] + u * f[1]) + v * ((1 - u) * f[m_nx] + u * f[m_nx + 1]));
+}
+
+// -----------------------------------------------------------------------------
+// Creation of a tiled terrain by sampling another terrain
+// -----------------------------------------------------------------------------
+void TiledTerrain::CreateTiles(const ChTerrain& terrain,
+                               const std::string& directory,
+                               const ChVector2<>& origin,
+                               double tile_sizeX,
+                               double tile_sizeY,
+                               int ni,
+                               int nj,
+                               int nx,
+                               int ny,
+                               bool friction) {
+    if (nx < 2 || ny < 2 || ni < 1 || nj < 1) {
+        throw ChException("Invalid tiled terrain grid");
+    }
+
+    filesystem::create_directory(filesystem::path(directory));
+
+    std::ofstream index(directory + "/tiles.json");
+    if (!index.is_open()) {
+        throw ChException("Cannot write tiled terrain index in " + directory);
+    }
+    index.precision(17);
+    index << "{\n";
+    index << "  \"Type\": \"Terrain\",\n";
+    index << "  \"Template\": \"TiledTerrain\",\n";
+    index << "  \"Origin\": [" << origin.x() << ", " << origin.y() << "],\n";
+    index << "  \"Tile Size\": [" << tile_sizeX << ", " << tile_sizeY << "],\n";
+    index << "  \"Number of Tiles\": [" << ni << ", " << nj << "],\n";
+    index << "  \"Tile Grid\": [" << nx << ", " << ny << "]\n";
+    index << "}\n";
+
+    double dx = tile_sizeX / (nx - 1);
+    double dy = tile_sizeY / (ny - 1);
+    for (int j = 0; j < nj; j++) {
+        for (int i = 0; i < ni; i++) {
+            std::string filename = GetTileFilename(directory, i, j);
+            ChStreamOutBinaryFile mstream(filename.c_str());
+            mstream << TILE_MAGIC << TILE_VERSION << nx << ny << (int)friction;
+            double x0 = origin.x() + i * tile_sizeX;
+            double y0 = origin.y() + j * tile_sizeY;
+            for (int iy = 0; iy < ny; iy++)
+                for (int ix = 0; ix < nx; ix++)
+                    mstream << terrain.GetHeight(x0 + ix * dx, y0 + iy * dy);
+            if (friction) {
+                for (int iy = 0; iy < ny; iy++)
+                    for (int ix = 0; ix < nx; ix++)
+                        mstream << terrain.GetCoefficientFriction(x0 + ix * dx, y0 + iy * dy);
+            }
+            mstream << TILE_MAGIC;
+        }
+    }
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
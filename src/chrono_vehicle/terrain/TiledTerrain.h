@@ -0,0 +1,225 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Rigid terrain streamed from a tiled on-disk representation
+//
+// =============================================================================
+
+#ifndef TILED_TERRAIN_H
+#define TILED_TERRAIN_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "chrono/core/ChVector2.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/ChTerrain.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_terrain
+/// @{
+
+/// Rigid terrain streamed from a tiled on-disk representation.
+/// The terrain is a regular grid of rectangular tiles, each stored in its own file as a height field (and,
+/// optionally, a map of friction coefficients). Only the tiles around a focus point (typically, the vehicle
+/// chassis) are kept in memory: tiles are read from disk by a background thread ahead of the focus point and
+/// evicted behind it, so that the working set stays bounded regardless of the map size.
+///
+/// Three distances from the focus point control the paging (see SetDistances):
+/// - tiles closer than the active distance have a fixed body with a height-field collision shape in the system;
+/// - tiles closer than the prefetch distance are requested from the background thread;
+/// - tiles farther than the eviction distance are removed from the system and freed.
+/// A tile needed in the active region and not yet loaded by the background thread is loaded synchronously (see
+/// GetNumSyncLoads); the prefetch distance should be large enough for this to never happen at run time.
+///
+/// A tiled terrain is created with CreateTiles, by sampling any other terrain (e.g. a RigidTerrain or a
+/// CRGTerrain) over a rectangular region, one tile at a time. Tiles have no visualization assets.
+///
+/// The friction map of the tiles (or a ChTerrain::FrictionFunctor) is returned by GetCoefficientFriction, which is
+/// used by the tire models that query the terrain. It is applied to the Chrono contacts with the tiles (e.g. rigid
+/// tires, tracked vehicles) only if enabled with UseLocationDependentFriction.
+class CH_VEHICLE_API TiledTerrain : public ChTerrain {
+  public:
+    /// Construct a tiled terrain from the specified directory (see CreateTiles).
+    TiledTerrain(ChSystem* system,            ///< [in] pointer to the containing multibody system
+                 const std::string& directory  ///< [in] directory with the tile index and tile files
+    );
+
+    ~TiledTerrain();
+
+    /// Set the body whose location is used as focus point (e.g. the vehicle chassis).
+    void SetFocusBody(std::shared_ptr<ChBody> body) { m_focus_body = body; }
+
+    /// Set the focus point explicitly (used if no focus body was specified).
+    void SetFocusPoint(const ChVector<>& point) { m_focus_point = point; }
+
+    /// Set the paging distances, measured in the horizontal plane from the focus point to the tiles.
+    /// The default values are 1, 2, and 3 times the largest tile dimension.
+    void SetDistances(double active,    ///< [in] tiles closer than this are in the system
+                      double prefetch,  ///< [in] tiles closer than this are loaded in the background
+                      double evict      ///< [in] tiles farther than this are freed
+    );
+
+    /// Set coefficient of friction of the tile contact material (default: 0.7).
+    /// This value is also returned by GetCoefficientFriction for tiles without a friction map.
+    void SetContactFrictionCoefficient(float friction_coefficient) { m_friction = friction_coefficient; }
+
+    /// Set coefficient of restitution of the tile contact material (default: 0.1).
+    void SetContactRestitutionCoefficient(float restitution_coefficient) { m_restitution = restitution_coefficient; }
+
+    /// Set contact material properties, used with the SMC contact method (default: Y = 2e5 and nu = 0.3).
+    void SetContactMaterialProperties(float young_modulus, float poisson_ratio);
+
+    /// Enable use of the location-dependent coefficient of friction (see GetCoefficientFriction) in the contacts
+    /// between the tiles and other bodies, resolved by the Chrono contact mechanism. As for RigidTerrain, this
+    /// requires a traversal of all contacts at each step. By default, this option is disabled and the tile contact
+    /// material uses the constant coefficient set with SetContactFrictionCoefficient.
+    /// This function must be called before Initialize.
+    void UseLocationDependentFriction(bool val) { m_use_friction_map = val; }
+
+    /// Load the tiles around the initial focus point and start the background loader.
+    void Initialize();
+
+    /// Update the set of tiles around the current focus point.
+    /// Tiles loaded in the background are added to the system, and far tiles are evicted.
+    virtual void Synchronize(double time) override;
+
+    /// Get the terrain height at the specified (x,y) location.
+    /// Return 0 if the location is not on a tile currently in the system.
+    virtual double GetHeight(double x, double y) const override;
+
+    /// Get the terrain normal at the specified (x,y) location.
+    virtual ChVector<> GetNormal(double x, double y) const override;
+
+    /// Get the terrain coefficient of friction at the specified (x,y) location.
+    /// This defers to the user-provided functor object of type ChTerrain::FrictionFunctor, if one was specified.
+    /// Otherwise, the friction map of the tile is interpolated (if the tile has one).
+    /// See UseLocationDependentFriction.
+    virtual float GetCoefficientFriction(double x, double y) const override;
+
+    /// Get the number of tiles currently in the system.
+    int GetNumActiveTiles() const { return (int)m_tiles.size(); }
+
+    /// Get the number of tiles that had to be loaded synchronously (i.e. not in time by the background thread).
+    int GetNumSyncLoads() const { return m_num_sync_loads; }
+
+    /// Create a tiled terrain in the specified directory, by sampling the given terrain.
+    /// The region starting at 'origin' (minimum x and y) is covered by ni x nj tiles of size tile_sizeX x
+    /// tile_sizeY, each sampled on a grid of nx x ny nodes (including the tile edges, shared by adjacent tiles).
+    /// If 'friction' is true, the coefficient of friction of the source terrain is also sampled.
+    static void CreateTiles(const ChTerrain& terrain,       ///< [in] source terrain
+                            const std::string& directory,  ///< [in] output directory (created if needed)
+                            const ChVector2<>& origin,     ///< [in] corner of the region (minimum x and y)
+                            double tile_sizeX,             ///< [in] tile dimension in the X direction
+                            double tile_sizeY,             ///< [in] tile dimension in the Y direction
+                            int ni,                        ///< [in] number of tiles in the X direction
+                            int nj,                        ///< [in] number of tiles in the Y direction
+                            int nx,                        ///< [in] number of grid nodes per tile in X direction
+                            int ny,                        ///< [in] number of grid nodes per tile in Y direction
+                            bool friction = false          ///< [in] also sample the coefficient of friction
+    );
+
+  private:
+    /// Data of a tile, as read from disk.
+    struct TileData {
+        std::shared_ptr<std::vector<double>> heights;  ///< grid heights, row after row along X
+        std::vector<float> friction;                   ///< grid friction coefficients (may be empty)
+    };
+
+    /// Tile currently in the system.
+    struct Tile {
+        std::shared_ptr<TileData> data;
+        std::shared_ptr<ChBody> body;
+    };
+
+    typedef int64_t TileKey;
+
+    TileKey GetKey(int i, int j) const { return (TileKey)j * m_ni + i; }
+    double GetDistance(int i, int j, const ChVector<>& point) const;
+    ChVector<> GetFocusPoint() const;
+
+    std::shared_ptr<TileData> LoadTile(TileKey key) const;
+    void ActivateTile(TileKey key, std::shared_ptr<TileData> data);
+    void UpdateTiles(bool initial);
+    void LoaderLoop();
+
+    /// Find the tile in the system containing the (x,y) location, and the grid coordinates of the location.
+    const Tile* FindTile(double x, double y, double& u, double& v) const;
+    bool FindPoint(double x, double y, double& height, ChVector<>& normal) const;
+
+    /// Check if the collision model belongs to a tile in the system.
+    bool IsTileModel(const collision::ChCollisionModel* model) const;
+
+    ChSystem* m_system;
+    std::string m_directory;
+
+    ChVector2<> m_origin;  ///< corner of the tiled region (minimum x and y)
+    double m_sizeX;        ///< tile dimension in X direction
+    double m_sizeY;        ///< tile dimension in Y direction
+    int m_ni;              ///< number of tiles in X direction
+    int m_nj;              ///< number of tiles in Y direction
+    int m_nx;              ///< number of grid nodes per tile in X direction
+    int m_ny;              ///< number of grid nodes per tile in Y direction
+
+    double m_active_dist;
+    double m_prefetch_dist;
+    double m_evict_dist;
+
+    float m_friction;
+    float m_restitution;
+    float m_young_modulus;
+    float m_poisson_ratio;
+
+    bool m_use_friction_map;
+    ChContactContainer::AddContactCallback* m_contact_callback;
+
+    std::shared_ptr<ChBody> m_focus_body;
+    ChVector<> m_focus_point;
+
+    std::unordered_map<TileKey, Tile> m_tiles;                      ///< tiles in the system
+    std::unordered_map<TileKey, std::shared_ptr<TileData>> m_ready;  ///< loaded tiles, not in the system
+    std::unordered_set<TileKey> m_requested;                        ///< tiles requested from the loader
+    std::unordered_set<TileKey> m_missing;                          ///< tiles without a file
+    int m_num_sync_loads;
+
+    std::unordered_set<const collision::ChCollisionModel*> m_models;  ///< collision models of the tiles in the system
+
+    // Background loader (members shared with the loader thread are protected by m_mutex)
+    std::thread m_loader;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<TileKey> m_queue;                                     ///< pending load requests
+    std::unordered_map<TileKey, std::shared_ptr<TileData>> m_loaded;  ///< loaded tiles (empty if no file)
+    bool m_stop;
+
+    friend class TTContactCallback;
+};
+
+/// @} vehicle_terrain
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -19,8 +19,6 @@
 #ifndef CH_TRACK_CONTACT_MANAGER
 #define CH_TRACK_CONTACT_MANAGER
 
-#include <list>
-
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/utils/ChUtilsInputOutput.h"
 
@@ -38,44 +36,38 @@ namespace vehicle {
 
 class ChTrackedVehicle;
 
-/// Contact information data structure.
-struct ChTrackContactInfo {
-    ChVector<> m_point;
-    ChMatrix33<> m_csys;
-    ChVector<> m_force;
-    ChVector<> m_torque;
-};
-
 /// Class for monitoring contacts of tracked vehicle subsystems.
-class ChTrackContactManager : public ChContactContainer::ReportContactCallback {
+/// Contacts on the monitored parts are extracted with a single bulk query of the system contact container and
+/// stored in contiguous arrays, grouped by part.
+class CH_VEHICLE_API ChTrackContactManager {
   public:
     ChTrackContactManager();
 
-    void MonitorContacts(int flags) { m_flags |= flags; }
+    void MonitorContacts(int flags);
     void SetContactCollection(bool val) { m_collect = val; }
     void WriteContacts(const std::string& filename);
 
-    void SetTrackShoeIndexLeft(size_t idx) { m_shoe_index_L = idx; }
-    void SetTrackShoeIndexRight(size_t idx) { m_shoe_index_R = idx; }
+    void SetTrackShoeIndexLeft(size_t idx);
+    void SetTrackShoeIndexRight(size_t idx);
 
     void Process(ChTrackedVehicle* vehicle);
 
     bool InContact(TrackedCollisionFlag::Enum part) const;
 
+    /// Get the contacts on the monitored parts, collected at the last call to Process.
+    /// The contacts on a given part are in the group returned by GetContactGroup.
+    const ChContactContainer::ContactData& GetContacts() const { return m_data; }
+
+    /// Return the group of the contacts on the specified part (-1 for a part that cannot be monitored).
+    static int GetContactGroup(TrackedCollisionFlag::Enum part);
+
   private:
+    /// Groups of monitored contacts, in the order in which they are written to the output file.
+    enum Group { CHASSIS, SPROCKET_L, SPROCKET_R, IDLER_L, IDLER_R, SHOE_L, SHOE_R, NUM_GROUPS };
+
     bool IsFlagSet(TrackedCollisionFlag::Enum val) { return (m_flags & static_cast<int>(val)) != 0; }
 
-    /// Callback, used to report contact points already added to the container.
-    /// If it returns false, the contact scanning will be stopped.
-    virtual bool OnReportContact(const ChVector<>& pA,
-                                 const ChVector<>& pB,
-                                 const ChMatrix33<>& plane_coord,
-                                 const double& distance,
-                                 const double& eff_radius,
-                                 const ChVector<>& react_forces,
-                                 const ChVector<>& react_torques,
-                                 ChContactable* modA,
-                                 ChContactable* modB) override;
+    void Initialize(ChTrackedVehicle* vehicle);
 
     bool m_initialized;  ///< true if the contact manager was initialized
     int m_flags;         ///< contact bit flags
@@ -91,16 +83,13 @@ class ChTrackContactManager : public ChContactContainer::ReportContactCallback {
     std::shared_ptr<ChTrackShoe> m_shoe_L;
     std::shared_ptr<ChTrackShoe> m_shoe_R;
 
-    size_t m_shoe_index_L;                                ///< index of monitored track shoe on left track
-    size_t m_shoe_index_R;                                ///< index of monitored track shoe on right track
+    size_t m_shoe_index_L;  ///< index of monitored track shoe on left track
+    size_t m_shoe_index_R;  ///< index of monitored track shoe on right track
+
+    std::shared_ptr<ChBody> m_bodies[NUM_GROUPS];  ///< monitored bodies
 
-    std::list<ChTrackContactInfo> m_chassis_contacts;     ///< list of contacts on chassis
-    std::list<ChTrackContactInfo> m_sprocket_L_contacts;  ///< list of contacts on left sprocket gear
-    std::list<ChTrackContactInfo> m_sprocket_R_contacts;  ///< list of contacts on right sprocket gear
-    std::list<ChTrackContactInfo> m_shoe_L_contacts;      ///< list of contacts on left track shoe
-    std::list<ChTrackContactInfo> m_shoe_R_contacts;      ///< list of contacts on right track shoe
-    std::list<ChTrackContactInfo> m_idler_L_contacts;     ///< list of contacts on left idler wheel
-    std::list<ChTrackContactInfo> m_idler_R_contacts;     ///< list of contacts on right idler wheel
+    ChContactContainer::ContactFilter m_filter;  ///< selection of monitored contacts
+    ChContactContainer::ContactData m_data;      ///< contacts on monitored bodies
 
     friend class ChTrackedVehicleIrrApp;
 };
@@ -90,8 +90,7 @@ void DoubleRoadWheel::Create(const rapidjson::Document& d) {
 // -----------------------------------------------------------------------------
 void DoubleRoadWheel::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::MESH && m_has_mesh) {
-        auto trimesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
-        trimesh->LoadWavefrontMesh(vehicle::GetDataFile(m_meshFile), false, false);
+        auto trimesh = vehicle::LoadMesh(vehicle::GetDataFile(m_meshFile), false, false, true);
         auto trimesh_shape = chrono_types::make_shared<ChTriangleMeshShape>();
         trimesh_shape->SetMesh(trimesh);
         trimesh_shape->SetName(m_meshName);
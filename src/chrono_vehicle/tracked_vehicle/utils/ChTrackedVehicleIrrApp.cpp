@@ -73,45 +73,53 @@ void ChTrackedVehicleIrrApp::renderOtherStats(int left, int top) {
 // Render contact normals for monitored subsystems
 // -----------------------------------------------------------------------------
 void ChTrackedVehicleIrrApp::renderOtherGraphics() {
+    const ChContactContainer::ContactData& contacts = m_tvehicle->m_contacts->GetContacts();
+    if (contacts.offsets.empty())
+        return;
+
     // Contact normals on left sprocket.
     // Note that we only render information for contacts on the outside gear profile
-    for (auto it = m_tvehicle->m_contacts->m_sprocket_L_contacts.begin();
-         it != m_tvehicle->m_contacts->m_sprocket_L_contacts.end(); ++it) {
-        ChVector<> v1 = it->m_point;
-        ChVector<> v2 = v1 + it->m_csys.Get_A_Xaxis();
+    int group = ChTrackContactManager::GetContactGroup(TrackedCollisionFlag::SPROCKET_LEFT);
+    double y_L = m_tvehicle->GetTrackAssembly(LEFT)->GetSprocket()->GetGearBody()->GetPos().y();
+    for (size_t i = contacts.offsets[group]; i < contacts.offsets[group + 1]; i++) {
+        ChVector<> v1 = contacts.points[i];
+        ChVector<> v2 = v1 + contacts.planes[i].Get_A_Xaxis();
 
-        if (v1.y() > m_tvehicle->GetTrackAssembly(LEFT)->GetSprocket()->GetGearBody()->GetPos().y())
+        if (v1.y() > y_L)
             irrlicht::ChIrrTools::drawSegment(GetVideoDriver(), v1, v2, video::SColor(255, 180, 0, 0), false);
     }
 
     // Contact normals on rear sprocket.
     // Note that we only render information for contacts on the outside gear profile
-    for (auto it = m_tvehicle->m_contacts->m_sprocket_R_contacts.begin();
-         it != m_tvehicle->m_contacts->m_sprocket_R_contacts.end(); ++it) {
-        ChVector<> v1 = it->m_point;
-        ChVector<> v2 = v1 + it->m_csys.Get_A_Xaxis();
+    group = ChTrackContactManager::GetContactGroup(TrackedCollisionFlag::SPROCKET_RIGHT);
+    double y_R = m_tvehicle->GetTrackAssembly(RIGHT)->GetSprocket()->GetGearBody()->GetPos().y();
+    for (size_t i = contacts.offsets[group]; i < contacts.offsets[group + 1]; i++) {
+        ChVector<> v1 = contacts.points[i];
+        ChVector<> v2 = v1 + contacts.planes[i].Get_A_Xaxis();
 
-        if (v1.y() < m_tvehicle->GetTrackAssembly(RIGHT)->GetSprocket()->GetGearBody()->GetPos().y())
+        if (v1.y() < y_R)
             irrlicht::ChIrrTools::drawSegment(GetVideoDriver(), v1, v2, video::SColor(255, 180, 0, 0), false);
     }
 
     // Contact normals on monitored track shoes.
-    renderContactNormals(m_tvehicle->m_contacts->m_shoe_L_contacts, video::SColor(255, 180, 180, 0));
-    renderContactNormals(m_tvehicle->m_contacts->m_shoe_R_contacts, video::SColor(255, 180, 180, 0));
+    renderContactNormals(TrackedCollisionFlag::SHOES_LEFT, video::SColor(255, 180, 180, 0));
+    renderContactNormals(TrackedCollisionFlag::SHOES_RIGHT, video::SColor(255, 180, 180, 0));
 
     // Contact normals on idler wheels.
-    renderContactNormals(m_tvehicle->m_contacts->m_idler_L_contacts, video::SColor(255, 0, 0, 180));
-    renderContactNormals(m_tvehicle->m_contacts->m_idler_R_contacts, video::SColor(255, 0, 0, 180));
+    renderContactNormals(TrackedCollisionFlag::IDLER_LEFT, video::SColor(255, 0, 0, 180));
+    renderContactNormals(TrackedCollisionFlag::IDLER_RIGHT, video::SColor(255, 0, 0, 180));
 
     // Contact normals on chassis.
-    renderContactNormals(m_tvehicle->m_contacts->m_chassis_contacts, video::SColor(255, 0, 180, 0));
+    renderContactNormals(TrackedCollisionFlag::CHASSIS, video::SColor(255, 0, 180, 0));
 }
 
-// Render normal for all contacts in the specified list, using the given color.
-void ChTrackedVehicleIrrApp::renderContactNormals(const std::list<ChTrackContactInfo>& lst, const video::SColor& col) {
-    for (auto it = lst.begin(); it != lst.end(); ++it) {
-        ChVector<> v1 = it->m_point;
-        ChVector<> v2 = v1 + it->m_csys.Get_A_Xaxis();
+// Render normal for all contacts on the specified part, using the given color.
+void ChTrackedVehicleIrrApp::renderContactNormals(TrackedCollisionFlag::Enum part, const video::SColor& col) {
+    const ChContactContainer::ContactData& contacts = m_tvehicle->m_contacts->GetContacts();
+    int group = ChTrackContactManager::GetContactGroup(part);
+    for (size_t i = contacts.offsets[group]; i < contacts.offsets[group + 1]; i++) {
+        ChVector<> v1 = contacts.points[i];
+        ChVector<> v2 = v1 + contacts.planes[i].Get_A_Xaxis();
 
         irrlicht::ChIrrTools::drawSegment(GetVideoDriver(), v1, v2, col, false);
     }
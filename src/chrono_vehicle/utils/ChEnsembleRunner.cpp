@@ -0,0 +1,105 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Utility class for running an ensemble of independent simulations in parallel.
+//
+// =============================================================================
+
+#include <exception>
+#include <iomanip>
+#include <sstream>
+
+#include "chrono/core/ChLog.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/utils/ChEnsembleRunner.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+namespace chrono {
+namespace vehicle {
+
+ChEnsembleRunner::ChEnsembleRunner(int num_runs)
+    : m_runs(num_runs), m_num_threads(0), m_caching(true), m_total_time(0) {}
+
+std::string ChEnsembleRunner::GetRunDirectory(int run) const {
+    if (m_out_dir.empty())
+        return "";
+    std::ostringstream dir;
+    dir << m_out_dir << "/run_" << std::setw(4) << std::setfill('0') << run;
+    return dir.str();
+}
+
+int ChEnsembleRunner::Run(RunFunction run_function) {
+    int num_runs = GetNumRuns();
+
+    // Create the output directories up front (not from the worker threads)
+    if (!m_out_dir.empty()) {
+        filesystem::create_directory(filesystem::path(m_out_dir));
+        for (int run = 0; run < num_runs; run++)
+            filesystem::create_directory(filesystem::path(GetRunDirectory(run)));
+    }
+
+    bool caching = vehicle::GetDataCaching();
+    if (m_caching)
+        vehicle::SetDataCaching(true);
+
+    ChTimer<double> timer;
+    timer.reset();
+    timer.start();
+
+    int nthreads = m_num_threads > 0 ? m_num_threads : CHOMPfunctions::GetMaxThreads();
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 1)
+    for (int run = 0; run < num_runs; run++) {
+        RunInfo& info = m_runs[run];
+        ChTimer<double> run_timer;
+        run_timer.reset();
+        run_timer.start();
+        try {
+            run_function(run, GetRunDirectory(run));
+            info.success = true;
+            info.error.clear();
+        } catch (const std::exception& e) {
+            info.success = false;
+            info.error = e.what();
+        } catch (...) {
+            info.success = false;
+            info.error = "unknown exception";
+        }
+        run_timer.stop();
+        info.time = run_timer();
+    }
+
+    timer.stop();
+    m_total_time = timer();
+
+    // Restore the caching state; release the cached data if caching was enabled only for this ensemble
+    if (m_caching && !caching) {
+        vehicle::SetDataCaching(false);
+        vehicle::ClearDataCache();
+    }
+
+    int num_failed = 0;
+    for (int run = 0; run < num_runs; run++) {
+        if (!m_runs[run].success) {
+            GetLog() << "ERROR: ensemble run " << run << " failed: " << m_runs[run].error.c_str() << "\n";
+            num_failed++;
+        }
+    }
+
+    return num_failed;
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,104 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Utility class for running an ensemble of independent simulations in parallel.
+//
+// =============================================================================
+
+#ifndef CH_ENSEMBLE_RUNNER_H
+#define CH_ENSEMBLE_RUNNER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "chrono_vehicle/ChApiVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_utils
+/// @{
+
+/// Runner for an ensemble of independent simulations, such as the runs of a parameter sweep or of a
+/// design-of-experiments study, executed concurrently within a single process.\n
+/// Each run is executed by a user-provided function which creates its own system and models (e.g. a
+/// WheeledVehicle built from JSON specification files), simulates, and writes its results in the output
+/// directory of the run. Runs are distributed over a pool of OpenMP threads. While the ensemble is running,
+/// caching of the model data is enabled (see SetDataCaching): JSON specification files and meshes are read
+/// and parsed only once, and the meshes used as read-only geometry are shared by all systems.\n
+/// The run function must not use global state that is not thread safe (e.g. SetDataPath or visualization).
+/// Each system should use a single thread (the default for a ChSystem), the parallelism being over runs.
+class CH_VEHICLE_API ChEnsembleRunner {
+  public:
+    /// Function executing one run of the ensemble.
+    /// 'run' is the index of the run (0 to number of runs - 1) and 'out_dir' its output directory (empty if
+    /// no output directory was specified). Errors are reported by throwing an exception.
+    typedef std::function<void(int run, const std::string& out_dir)> RunFunction;
+
+    /// Construct a runner for the specified number of runs.
+    ChEnsembleRunner(int num_runs);
+
+    ~ChEnsembleRunner() {}
+
+    /// Set the number of runs executed concurrently (default: 0, i.e. the OpenMP default).
+    void SetNumThreads(int num_threads) { m_num_threads = num_threads; }
+
+    /// Set the root output directory (default: none).
+    /// Each run is given its own subdirectory 'run_XXXX', created before the run starts.
+    void SetOutputDirectory(const std::string& dir) { m_out_dir = dir; }
+
+    /// Enable or disable caching of model data files during the runs (default: true).
+    void SetDataCaching(bool val) { m_caching = val; }
+
+    /// Execute all runs of the ensemble and return the number of failed runs.
+    /// A run fails if the run function throws an exception; other runs are not affected.
+    int Run(RunFunction run_function);
+
+    /// Get the number of runs in the ensemble.
+    int GetNumRuns() const { return (int)m_runs.size(); }
+
+    /// Get the output directory of the specified run (empty if no output directory was specified).
+    std::string GetRunDirectory(int run) const;
+
+    /// Return true if the specified run completed without error.
+    bool Succeeded(int run) const { return m_runs[run].success; }
+
+    /// Get the error message of the specified run (empty if the run succeeded).
+    const std::string& GetErrorMessage(int run) const { return m_runs[run].error; }
+
+    /// Get the wall clock time (in seconds) of the specified run.
+    double GetRunTime(int run) const { return m_runs[run].time; }
+
+    /// Get the wall clock time (in seconds) for executing the whole ensemble.
+    double GetTotalTime() const { return m_total_time; }
+
+  private:
+    struct RunInfo {
+        bool success;
+        std::string error;
+        double time;
+    };
+
+    std::vector<RunInfo> m_runs;
+    int m_num_threads;
+    std::string m_out_dir;
+    bool m_caching;
+    double m_total_time;
+};
+
+/// @} vehicle_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -16,8 +16,12 @@
 //
 // =============================================================================
 
+#include <atomic>
 #include <fstream>
+#include <mutex>
+#include <unordered_map>
 
+#include "chrono_vehicle/ChVehicleModelData.h"
 #include "chrono_vehicle/utils/ChUtilsJSON.h"
 //
 #include "chrono_vehicle/chassis/RigidChassis.h"
@@ -82,8 +86,7 @@ namespace vehicle {
 
 // -----------------------------------------------------------------------------
 
-Document ReadFileJSON(const std::string& filename) {
-    Document d;
+static void ParseFileJSON(const std::string& filename, Document& d) {
     std::ifstream ifs(filename);
     if (!ifs.good()) {
         GetLog() << "ERROR: Could not open JSON file: " << filename << "\n";
@@ -94,9 +97,64 @@ Document ReadFileJSON(const std::string& filename) {
             GetLog() << "ERROR: Invalid JSON file: " << filename << "\n";
         }
     }
+}
+
+// Parsed documents, never modified once in the cache (only copied from).
+// A file requested concurrently by several threads is parsed by the first one, the others waiting for it.
+struct CachedDocument {
+    std::once_flag parsed;
+    std::shared_ptr<const Document> doc;
+};
+static std::unordered_map<std::string, std::shared_ptr<CachedDocument>> json_cache;
+static std::mutex json_cache_mutex;
+static std::atomic<int> json_cache_loads(0);
+
+Document ReadFileJSON(const std::string& filename) {
+    Document d;
+    if (!GetDataCaching()) {
+        ParseFileJSON(filename, d);
+        return d;
+    }
+
+    std::shared_ptr<CachedDocument> cached;
+    {
+        std::lock_guard<std::mutex> lock(json_cache_mutex);
+        auto& entry = json_cache[filename];
+        if (!entry)
+            entry = chrono_types::make_shared<CachedDocument>();
+        cached = entry;
+    }
+    std::call_once(cached->parsed, [&filename, &cached]() {
+        json_cache_loads++;
+        auto parsed = chrono_types::make_shared<Document>();
+        ParseFileJSON(filename, *parsed);
+        if (!parsed->IsNull())
+            cached->doc = parsed;
+    });
+
+    // Files that could not be read are not cached (a later request tries again)
+    if (!cached->doc) {
+        std::lock_guard<std::mutex> lock(json_cache_mutex);
+        auto it = json_cache.find(filename);
+        if (it != json_cache.end() && it->second == cached)
+            json_cache.erase(it);
+        return d;
+    }
+
+    d.CopyFrom(*cached->doc, d.GetAllocator());
     return d;
 }
 
+void ClearCacheJSON() {
+    std::lock_guard<std::mutex> lock(json_cache_mutex);
+    json_cache.clear();
+    json_cache_loads = 0;
+}
+
+int GetCacheLoadsJSON() {
+    return json_cache_loads;
+}
+
 // -----------------------------------------------------------------------------
 
 ChVector<> ReadVectorJSON(const Value& a) {
@@ -45,8 +45,16 @@ namespace vehicle {
 
 /// Load and return a RapidJSON document from the specified file.
 /// A Null document is returned if the file cannot be opened.
+/// If data caching is enabled (see SetDataCaching), each file is parsed only once (also when requested
+/// concurrently by several threads) and the returned document is a copy of the cached one.
 CH_VEHICLE_API rapidjson::Document ReadFileJSON(const std::string& filename);
 
+/// Release all cached JSON documents (see ReadFileJSON).
+CH_VEHICLE_API void ClearCacheJSON();
+
+/// Get the number of JSON files parsed into the cache since it was last cleared (see ReadFileJSON).
+CH_VEHICLE_API int GetCacheLoadsJSON();
+
 // -----------------------------------------------------------------------------
 
 /// Load and return a ChVector from the specified JSON array
@@ -22,6 +22,7 @@
 #include <cmath>
 
 #include "chrono/physics/ChSystem.h"
+#include "chrono_vehicle/ChVehicleModelData.h"
 #include "chrono_vehicle/wheeled_vehicle/ChTire.h"
 #include "chrono_thirdparty/filesystem/path.h"
 
@@ -109,8 +110,7 @@ std::shared_ptr<ChTriangleMeshShape> ChTire::AddVisualizationMesh(const std::str
     ChQuaternion<> rot = left ? Q_from_AngZ(0) : Q_from_AngZ(CH_C_PI);
     auto meshFile = left ? mesh_file_left : mesh_file_right;
 
-    auto trimesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
-    trimesh->LoadWavefrontMesh(meshFile, false, false);
+    auto trimesh = vehicle::LoadMesh(meshFile, false, false);
     trimesh->Transform(ChVector<>(0, GetOffset(), 0), ChMatrix33<>(rot));
 
     auto trimesh_shape = chrono_types::make_shared<ChTriangleMeshShape>();
@@ -22,6 +22,7 @@
 #include "chrono/physics/ChSystem.h"
 #include "chrono/physics/ChContactContainer.h"
 
+#include "chrono_vehicle/ChVehicleModelData.h"
 #include "chrono_vehicle/wheeled_vehicle/tire/ChRigidTire.h"
 
 #include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
@@ -58,12 +59,12 @@ void ChRigidTire::Initialize(std::shared_ptr<ChWheel> wheel) {
 
     if (m_use_contact_mesh) {
         // Mesh contact
-        m_trimesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
-        m_trimesh->LoadWavefrontMesh(m_contact_meshFile, true, false);
+        // The cached mesh can be shared only if it does not need to be offset.
+        double offset = GetOffset();
+        m_trimesh = vehicle::LoadMesh(m_contact_meshFile, true, false, std::abs(offset) <= 1e-3);
 
         //// RADU
         // Hack to deal with current limitation: cannot set offset on a trimesh collision shape!
-        double offset = GetOffset();
         if (std::abs(offset) > 1e-3) {
             for (int i = 0; i < m_trimesh->m_vertices.size(); i++)
                 m_trimesh->m_vertices[i].y() += offset;
@@ -0,0 +1,123 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Demonstration of an ensemble of vehicle simulations run concurrently in a
+// single process: a sweep over the (constant) throttle input of a vehicle
+// specified through JSON files.
+//
+// Each run creates its own system; the JSON specification files and meshes
+// are parsed once and shared by all runs. Each run writes the time history of
+// the vehicle speed and position in its own output directory.
+//
+// =============================================================================
+
+#include <iostream>
+
+#include "chrono/utils/ChUtilsInputOutput.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/powertrain/SimplePowertrain.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/utils/ChEnsembleRunner.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/TMeasyTire.h"
+#include "chrono_vehicle/wheeled_vehicle/vehicle/WheeledVehicle.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// =============================================================================
+
+// JSON files for the vehicle, powertrain, tire, and terrain models
+std::string vehicle_file("hmmwv/vehicle/HMMWV_Vehicle.json");
+std::string powertrain_file("generic/powertrain/SimplePowertrain.json");
+std::string tire_file("hmmwv/tire/HMMWV_TMeasy_converted.json");
+std::string terrain_file("terrain/RigidPlane.json");
+
+// Number of runs in the ensemble (throttle values uniformly distributed in [0.2, 1])
+int num_runs = 16;
+
+// Simulation step size, simulation length, and output interval
+double step_size = 2e-3;
+double tend = 10.0;
+double out_step_size = 1.0 / 20;
+
+// Output directory
+const std::string out_dir = GetChronoOutputPath() + "ENSEMBLE";
+
+// =============================================================================
+
+double GetThrottle(int run) {
+    return 0.2 + 0.8 * run / std::max(num_runs - 1, 1);
+}
+
+void RunSimulation(int run, const std::string& run_dir) {
+    // Create the vehicle (and its system), powertrain, and tires
+    WheeledVehicle vehicle(vehicle::GetDataFile(vehicle_file), ChMaterialSurface::SMC);
+    vehicle.Initialize(ChCoordsys<>(ChVector<>(0, 0, 1.0), QUNIT));
+    vehicle.SetChassisVisualizationType(VisualizationType::MESH);
+    vehicle.SetWheelVisualizationType(VisualizationType::MESH);
+
+    auto powertrain = chrono_types::make_shared<SimplePowertrain>(vehicle::GetDataFile(powertrain_file));
+    vehicle.InitializePowertrain(powertrain);
+
+    for (auto& axle : vehicle.GetAxles()) {
+        for (auto& wheel : axle->GetWheels()) {
+            auto tire = chrono_types::make_shared<TMeasyTire>(vehicle::GetDataFile(tire_file));
+            vehicle.InitializeTire(tire, wheel, VisualizationType::NONE);
+        }
+    }
+
+    // Create the terrain
+    RigidTerrain terrain(vehicle.GetSystem(), vehicle::GetDataFile(terrain_file));
+
+    // Simulation loop, with constant driver inputs
+    ChDriver::Inputs driver_inputs = {0, GetThrottle(run), 0};
+    int out_steps = (int)std::ceil(out_step_size / step_size);
+    utils::CSV_writer csv(" ");
+
+    int step_number = 0;
+    double time = 0;
+    while (time < tend) {
+        if (step_number % out_steps == 0) {
+            csv << time << vehicle.GetVehicleSpeed() << vehicle.GetVehiclePos() << std::endl;
+        }
+
+        vehicle.Synchronize(time, driver_inputs, terrain);
+        terrain.Synchronize(time);
+
+        vehicle.Advance(step_size);
+        terrain.Advance(step_size);
+
+        time = vehicle.GetSystem()->GetChTime();
+        step_number++;
+    }
+
+    csv.write_to_file(run_dir + "/results.dat");
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    GetLog() << "Copyright (c) 2017 projectchrono.org\nChrono version: " << CHRONO_VERSION << "\n\n";
+
+    ChEnsembleRunner ensemble(num_runs);
+    ensemble.SetOutputDirectory(out_dir);
+    int num_failed = ensemble.Run(RunSimulation);
+
+    for (int run = 0; run < num_runs; run++) {
+        std::cout << "Run " << run << "  throttle: " << GetThrottle(run) << "  time: " << ensemble.GetRunTime(run)
+                  << " s  " << (ensemble.Succeeded(run) ? "OK" : ensemble.GetErrorMessage(run)) << std::endl;
+    }
+    std::cout << "Total time: " << ensemble.GetTotalTime() << " s" << std::endl;
+
+    return num_failed == 0 ? 0 : 1;
+}
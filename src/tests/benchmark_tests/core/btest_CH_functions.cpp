@@ -0,0 +1,126 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark test for the evaluation of ChFunction objects:
+// - lookup in recorded data (equally or non-equally spaced points, sequential or
+//   random access)
+// - evaluation of a tree of ChFunction_Operation objects, through virtual calls
+//   or compiled with ChFunction_Compiled
+//
+// =============================================================================
+
+#include <random>
+
+#include "benchmark/benchmark.h"
+
+#include "chrono/motion_functions/ChFunction_Compiled.h"
+#include "chrono/motion_functions/ChFunction_Const.h"
+#include "chrono/motion_functions/ChFunction_Operation.h"
+#include "chrono/motion_functions/ChFunction_Ramp.h"
+#include "chrono/motion_functions/ChFunction_Recorder.h"
+#include "chrono/motion_functions/ChFunction_Sine.h"
+
+using namespace chrono;
+
+const int num_points = 10000;
+const int num_evals = 1000;
+
+// -----------------------------------------------------------------------------
+
+ChFunction_Recorder CreateRecorder(bool uniform) {
+    ChFunction_Recorder fun;
+    double x = 0;
+    for (int i = 0; i < num_points; i++) {
+        fun.AddPoint(x, std::sin(x));
+        x += uniform ? 0.01 : 0.01 * (1 + 0.5 * std::sin(10.0 * i));
+    }
+    return fun;
+}
+
+static void Recorder(benchmark::State& state, bool uniform, bool sequential) {
+    auto fun = CreateRecorder(uniform);
+    double xmin, xmax;
+    fun.Estimate_x_range(xmin, xmax);
+
+    ChVectorDynamic<> x(num_evals);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(xmin, xmax);
+    for (int i = 0; i < num_evals; i++)
+        x(i) = sequential ? xmin + (xmax - xmin) * i / num_evals : dist(gen);
+
+    ChVectorDynamic<> y;
+    for (auto _ : state) {
+        fun.Get_y_batch(x, y);
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_evals);
+}
+
+BENCHMARK_CAPTURE(Recorder, uniform_sequential, true, true);
+BENCHMARK_CAPTURE(Recorder, uniform_random, true, false);
+BENCHMARK_CAPTURE(Recorder, nonuniform_sequential, false, true);
+BENCHMARK_CAPTURE(Recorder, nonuniform_random, false, false);
+
+// -----------------------------------------------------------------------------
+
+// y = (2 + sin(3x)) * (1 + 0.5x) - |sin(x)| / (1.5 + 0.2x)
+std::shared_ptr<ChFunction> CreateTree() {
+    auto add = chrono_types::make_shared<ChFunction_Operation>();
+    add->Set_optype(ChFunction_Operation::ChOP_ADD);
+    add->Set_fa(chrono_types::make_shared<ChFunction_Const>(2));
+    add->Set_fb(chrono_types::make_shared<ChFunction_Sine>(0, 3 / CH_C_2PI, 1));
+
+    auto mul = chrono_types::make_shared<ChFunction_Operation>();
+    mul->Set_optype(ChFunction_Operation::ChOP_MUL);
+    mul->Set_fa(add);
+    mul->Set_fb(chrono_types::make_shared<ChFunction_Ramp>(1, 0.5));
+
+    auto abs = chrono_types::make_shared<ChFunction_Operation>();
+    abs->Set_optype(ChFunction_Operation::ChOP_FABS);
+    abs->Set_fa(chrono_types::make_shared<ChFunction_Sine>(0, 1 / CH_C_2PI, 1));
+
+    auto div = chrono_types::make_shared<ChFunction_Operation>();
+    div->Set_optype(ChFunction_Operation::ChOP_DIV);
+    div->Set_fa(abs);
+    div->Set_fb(chrono_types::make_shared<ChFunction_Ramp>(1.5, 0.2));
+
+    auto sub = chrono_types::make_shared<ChFunction_Operation>();
+    sub->Set_optype(ChFunction_Operation::ChOP_SUB);
+    sub->Set_fa(mul);
+    sub->Set_fb(div);
+
+    return sub;
+}
+
+static void Tree(benchmark::State& state, bool compiled, int derivate) {
+    std::shared_ptr<ChFunction> fun = CreateTree();
+    if (compiled)
+        fun = chrono_types::make_shared<ChFunction_Compiled>(fun);
+
+    ChVectorDynamic<> x(num_evals);
+    for (int i = 0; i < num_evals; i++)
+        x(i) = 0.01 * i;
+
+    ChVectorDynamic<> y;
+    for (auto _ : state) {
+        fun->Get_y_batch(x, y, derivate);
+        benchmark::DoNotOptimize(y.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_evals);
+}
+
+BENCHMARK_CAPTURE(Tree, virtual_y, false, 0);
+BENCHMARK_CAPTURE(Tree, compiled_y, true, 0);
+BENCHMARK_CAPTURE(Tree, virtual_y_dx, false, 1);
+BENCHMARK_CAPTURE(Tree, compiled_y_dx, true, 1);
+BENCHMARK_CAPTURE(Tree, virtual_y_dxdx, false, 2);
+BENCHMARK_CAPTURE(Tree, compiled_y_dxdx, true, 2);
@@ -17,6 +17,8 @@
 // Note that the MKL Pardiso and Mumps solvers are set to lock the sparsity
 // pattern, but not to use the sparsity pattern learner.
 //
+// The ADMM test uses an NSC formulation of the same problem.
+//
 // =============================================================================
 
 #include "chrono/ChConfig.h"
@@ -24,8 +26,10 @@
 
 #include "chrono/assets/ChTexture.h"
 #include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
 #include "chrono/physics/ChSystemSMC.h"
 #include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/solver/ChSolverADMM.h"
 
 #include "chrono/fea/ChBuilderBeam.h"
 #include "chrono/fea/ChContactSurfaceMesh.h"
@@ -49,7 +53,7 @@
 using namespace chrono;
 using namespace chrono::fea;
 
-enum class SolverType { MINRES, MKL, MUMPS };
+enum class SolverType { MINRES, MKL, MUMPS, ADMM };
 
 class FEAcontactTest : public utils::ChBenchmarkTest {
   public:
@@ -64,11 +68,11 @@ class FEAcontactTest : public utils::ChBenchmarkTest {
     FEAcontactTest(SolverType solver_type);
 
   private:
-    void CreateFloor(std::shared_ptr<ChMaterialSurfaceSMC> cmat);
-    void CreateBeams(std::shared_ptr<ChMaterialSurfaceSMC> cmat);
-    void CreateCables(std::shared_ptr<ChMaterialSurfaceSMC> cmat);
+    void CreateFloor(std::shared_ptr<ChMaterialSurface> cmat);
+    void CreateBeams(std::shared_ptr<ChMaterialSurface> cmat);
+    void CreateCables(std::shared_ptr<ChMaterialSurface> cmat);
 
-    ChSystemSMC* m_system;
+    ChSystem* m_system;
 };
 
 class FEAcontactTest_MINRES : public FEAcontactTest {
@@ -86,8 +90,16 @@ class FEAcontactTest_MUMPS : public FEAcontactTest {
     FEAcontactTest_MUMPS() : FEAcontactTest(SolverType::MUMPS) {}
 };
 
+class FEAcontactTest_ADMM : public FEAcontactTest {
+  public:
+    FEAcontactTest_ADMM() : FEAcontactTest(SolverType::ADMM) {}
+};
+
 FEAcontactTest::FEAcontactTest(SolverType solver_type) {
-    m_system = new ChSystemSMC();
+    if (solver_type == SolverType::ADMM)
+        m_system = new ChSystemNSC();
+    else
+        m_system = new ChSystemSMC();
 
     // Set solver parameters
 #ifndef CHRONO_MKL
@@ -137,23 +149,44 @@ FEAcontactTest::FEAcontactTest(SolverType solver_type) {
 #endif
             break;
         }
+        case SolverType::ADMM: {
+            auto solver = chrono_types::make_shared<ChSolverADMM>();
+            solver->SetMaxIterations(100);
+            solver->SetTolerance(1e-8);
+            solver->EnableWarmStart(true);
+            solver->SetVerbose(false);
+            m_system->SetSolver(solver);
+
+            m_system->SetMaxPenetrationRecoverySpeed(1.0);
+            m_system->SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+            break;
+        }
     }
 
     collision::ChCollisionInfo::SetDefaultEffectiveCurvatureRadius(1);
     collision::ChCollisionModel::SetDefaultSuggestedMargin(0.006);
 
-    auto cmat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
-    cmat->SetYoungModulus(6e4);
-    cmat->SetFriction(0.3f);
-    cmat->SetRestitution(0.2f);
-    cmat->SetAdhesion(0);
+    std::shared_ptr<ChMaterialSurface> cmat;
+    if (solver_type == SolverType::ADMM) {
+        auto cmat_nsc = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+        cmat_nsc->SetFriction(0.3f);
+        cmat_nsc->SetRestitution(0.2f);
+        cmat = cmat_nsc;
+    } else {
+        auto cmat_smc = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+        cmat_smc->SetYoungModulus(6e4);
+        cmat_smc->SetFriction(0.3f);
+        cmat_smc->SetRestitution(0.2f);
+        cmat_smc->SetAdhesion(0);
+        cmat = cmat_smc;
+    }
 
     CreateFloor(cmat);
     CreateBeams(cmat);
     CreateCables(cmat);
 }
 
-void FEAcontactTest::CreateFloor(std::shared_ptr<ChMaterialSurfaceSMC> cmat) {
+void FEAcontactTest::CreateFloor(std::shared_ptr<ChMaterialSurface> cmat) {
     auto mfloor = chrono_types::make_shared<ChBodyEasyBox>(2, 0.1, 2, 2700, true);
     mfloor->SetBodyFixed(true);
     mfloor->SetMaterialSurface(cmat);
@@ -164,7 +197,7 @@ void FEAcontactTest::CreateFloor(std::shared_ptr<ChMaterialSurfaceSMC> cmat) {
     mfloor->AddAsset(masset_texture);
 }
 
-void FEAcontactTest::CreateBeams(std::shared_ptr<ChMaterialSurfaceSMC> cmat) {
+void FEAcontactTest::CreateBeams(std::shared_ptr<ChMaterialSurface> cmat) {
     auto mesh = chrono_types::make_shared<ChMesh>();
     m_system->Add(mesh);
 
@@ -198,7 +231,7 @@ void FEAcontactTest::CreateBeams(std::shared_ptr<ChMaterialSurfaceSMC> cmat) {
     mesh->AddAsset(vis_speed);
 }
 
-void FEAcontactTest::CreateCables(std::shared_ptr<ChMaterialSurfaceSMC> cmat) {
+void FEAcontactTest::CreateCables(std::shared_ptr<ChMaterialSurface> cmat) {
     auto mesh = chrono_types::make_shared<ChMesh>();
     m_system->Add(mesh);
 
@@ -259,6 +292,7 @@ void FEAcontactTest::SimulateVis() {
 #define NUM_SIM_STEPS 500  // number of simulation steps for each benchmark
 
 CH_BM_SIMULATION_ONCE(FEAcontact_MINRES, FEAcontactTest_MINRES, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_ONCE(FEAcontact_ADMM, FEAcontactTest_ADMM, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 
 #ifdef CHRONO_MKL
 CH_BM_SIMULATION_ONCE(FEAcontact_MKL, FEAcontactTest_MKL, NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
@@ -16,6 +16,10 @@
 // This provides a measure of the effect and performance of using the "sparsity
 // learner".
 //
+// Also reports the iteration counts and time-to-solution of the iterative
+// linear solvers with the various preconditioners. The sparsity pattern is
+// locked, so that the symbolic analysis of the preconditioners is reused.
+//
 // =============================================================================
 
 #include "chrono/ChConfig.h"
@@ -24,6 +28,7 @@
 #include "chrono/core/ChMatrix.h"
 #include "chrono/physics/ChSystemSMC.h"
 #include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
 #include "chrono/fea/ChElementShellANCF.h"
 #include "chrono/fea/ChMesh.h"
 
@@ -101,6 +106,16 @@ class SystemFixture : public ::benchmark::Fixture {
         st.counters["LS_Solve"] = m_system->GetTimerSolver() * 1e3 / num_it;
     }
 
+    void ReportIterative(benchmark::State& st, ChIterativeSolverLS* solver) {
+        Report(st);
+        auto num_it = st.iterations();
+        auto precond = solver->GetPreconditioner();
+        st.counters["ITERS"] = solver->GetIterations();
+        st.counters["PC_Update"] = solver->GetTimePreconditioner() * 1e3 / num_it;
+        st.counters["PC_Updates"] = solver->GetNumPreconditionerUpdates();
+        st.counters["PC_NNZ"] = precond ? (double)precond->GetNonZeros() : 0.0;
+    }
+
   protected:
     ChSystemSMC* m_system;
 };
@@ -150,6 +165,22 @@ class SystemFixture : public ::benchmark::Fixture {
     }                                                                                 \
     BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
 
+#define BM_SOLVER_ITERATIVE(TEST_NAME, N, SOLVER, PRECOND)                           \
+    BENCHMARK_TEMPLATE_DEFINE_F(SystemFixture, TEST_NAME, N)(benchmark::State & st) { \
+        auto solver = chrono_types::make_shared<SOLVER>();                            \
+        solver->SetPreconditioner(PRECOND);                                           \
+        solver->SetMaxIterations(20000);                                              \
+        solver->SetTolerance(1e-10);                                                  \
+        solver->LockSparsityPattern(true);                                            \
+        solver->SetVerbose(false);                                                    \
+        m_system->SetSolver(solver);                                                  \
+        while (st.KeepRunning()) {                                                    \
+            m_system->DoStaticLinear();                                               \
+        }                                                                             \
+        ReportIterative(st, solver.get());                                            \
+    }                                                                                 \
+    BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
+
 #ifdef CHRONO_MKL
 BM_SOLVER_MKL(MKL_learner_500, 500, true)
 BM_SOLVER_MKL(MKL_no_learner_500, 500, false)
@@ -186,3 +217,19 @@ BM_SOLVER_QR(QR_learner_4000, 4000, true)
 BM_SOLVER_QR(QR_no_learner_4000, 4000, false)
 BM_SOLVER_QR(QR_learner_8000, 8000, true)
 BM_SOLVER_QR(QR_no_learner_8000, 8000, false)
+
+BM_SOLVER_ITERATIVE(GMRES_diag_500, 500, ChSolverGMRES, nullptr)
+BM_SOLVER_ITERATIVE(GMRES_ILU0_500, 500, ChSolverGMRES, chrono_types::make_shared<ChPreconditionerILUK>(0))
+BM_SOLVER_ITERATIVE(GMRES_ILU2_500, 500, ChSolverGMRES, chrono_types::make_shared<ChPreconditionerILUK>(2))
+BM_SOLVER_ITERATIVE(GMRES_ILUT_500, 500, ChSolverGMRES, chrono_types::make_shared<ChPreconditionerILUT>())
+BM_SOLVER_ITERATIVE(MINRES_diag_500, 500, ChSolverMINRES, nullptr)
+BM_SOLVER_ITERATIVE(MINRES_IC_500, 500, ChSolverMINRES, chrono_types::make_shared<ChPreconditionerIC>())
+BM_SOLVER_ITERATIVE(MINRES_AMG_500, 500, ChSolverMINRES, chrono_types::make_shared<ChPreconditionerAMG>())
+
+BM_SOLVER_ITERATIVE(GMRES_diag_2000, 2000, ChSolverGMRES, nullptr)
+BM_SOLVER_ITERATIVE(GMRES_ILU0_2000, 2000, ChSolverGMRES, chrono_types::make_shared<ChPreconditionerILUK>(0))
+BM_SOLVER_ITERATIVE(GMRES_ILU2_2000, 2000, ChSolverGMRES, chrono_types::make_shared<ChPreconditionerILUK>(2))
+BM_SOLVER_ITERATIVE(GMRES_ILUT_2000, 2000, ChSolverGMRES, chrono_types::make_shared<ChPreconditionerILUT>())
+BM_SOLVER_ITERATIVE(MINRES_diag_2000, 2000, ChSolverMINRES, nullptr)
+BM_SOLVER_ITERATIVE(MINRES_IC_2000, 2000, ChSolverMINRES, chrono_types::make_shared<ChPreconditionerIC>())
+BM_SOLVER_ITERATIVE(MINRES_AMG_2000, 2000, ChSolverMINRES, chrono_types::make_shared<ChPreconditionerAMG>())
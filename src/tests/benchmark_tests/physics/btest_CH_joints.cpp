@@ -12,11 +12,14 @@
 // Authors: Radu Serban
 // =============================================================================
 //
-// Benchmark test for joint Update functions.
+// Benchmark test for joint Update functions and for the direct solution of a
+// chain of bodies connected through joints.
 //
 // =============================================================================
 
 #include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChSolverSparseSchur.h"
 #include "chrono/utils/ChBenchmark.h"
 
 using namespace chrono;
@@ -93,6 +96,60 @@ BM_LINK_OP_VOID(UpdateState_LinkLock, ChLinkLock, UpdateState)
 BM_LINK_OP_TIME(Update_LinkMarkers, ChLinkMarkers, Update)
 BM_LINK_OP_TIME(Update_LinkLock, ChLinkLock, Update)
 
+// Benchmark direct solvers on a pendulum chain (full KKT matrix vs. reduced system)
+
+template <ChSolver::Type SOLVER>
+class JointChainTest : public utils::ChBenchmarkTest {
+  public:
+    JointChainTest();
+    ~JointChainTest() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override { m_system->DoStepDynamics(1e-3); }
+
+  private:
+    ChSystemNSC* m_system;
+};
+
+template <ChSolver::Type SOLVER>
+JointChainTest<SOLVER>::JointChainTest() {
+    const int N = 1000;
+
+    m_system = new ChSystemNSC();
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    m_system->AddBody(ground);
+
+    auto prev = ground;
+    for (int i = 0; i < N; i++) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector<>(i + 1.0, 0, 0));
+        body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+        m_system->AddBody(body);
+
+        auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+        joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(i + 0.5, 0, 0), QUNIT));
+        m_system->AddLink(joint);
+        prev = body;
+    }
+
+    std::shared_ptr<ChDirectSolverLS> solver;
+    switch (SOLVER) {
+        case ChSolver::Type::SPARSE_SCHUR:
+            solver = chrono_types::make_shared<ChSolverSparseSchur>();
+            break;
+        default:
+            solver = chrono_types::make_shared<ChSolverSparseLU>();
+            break;
+    }
+    solver->LockSparsityPattern(true);
+    m_system->SetSolver(solver);
+}
+
+CH_BM_SIMULATION_LOOP(JointChain_SparseLU, JointChainTest<ChSolver::Type::SPARSE_LU>, 10, 50, 5);
+CH_BM_SIMULATION_LOOP(JointChain_SparseSchur, JointChainTest<ChSolver::Type::SPARSE_SCHUR>, 10, 50, 5);
+
 // Main function
 
 BENCHMARK_MAIN();
@@ -22,6 +22,8 @@
 #include "chrono/physics/ChSystemNSC.h"
 #include "chrono/physics/ChBodyEasy.h"
 #include "chrono/physics/ChLinkMotorRotationSpeed.h"
+#include "chrono/collision/ChCCollisionSystemPrimitive.h"
+#include "chrono/solver/ChIterativeSolverVI.h"
 
 #ifdef CHRONO_IRRLICHT
 #include "chrono_irrlicht/ChIrrApp.h"
@@ -31,7 +33,10 @@ using namespace chrono;
 
 // =============================================================================
 
-template <int N>
+// Template parameters: number of bodies of each type, whether or not to use the primitive
+// collision system (ChCollisionSystemPrimitive) instead of the default Bullet-based one, and
+// the floating-point precision of the (PSOR) solver.
+template <int N, bool PRIMITIVE = false, ChIterativeSolverVI::Precision PREC = ChIterativeSolverVI::Precision::DOUBLE>
 class MixerTestNSC : public utils::ChBenchmarkTest {
   public:
     MixerTestNSC();
@@ -43,53 +48,72 @@ class MixerTestNSC : public utils::ChBenchmarkTest {
     void SimulateVis();
 
   private:
+    std::shared_ptr<collision::ChCollisionModel> CreateModel() const {
+        if (PRIMITIVE)
+            return chrono_types::make_shared<collision::ChModelPrimitive>();
+        return chrono_types::make_shared<collision::ChModelBullet>();
+    }
+
     ChSystemNSC* m_system;
     double m_step;
 };
 
-template <int N>
-MixerTestNSC<N>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
+template <int N, bool PRIMITIVE, ChIterativeSolverVI::Precision PREC>
+MixerTestNSC<N, PRIMITIVE, PREC>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
+    if (PRIMITIVE)
+        m_system->SetCollisionSystem(chrono_types::make_shared<collision::ChCollisionSystemPrimitive>());
+    std::static_pointer_cast<ChIterativeSolverVI>(m_system->GetSolver())->SetPrecision(PREC);
+
     for (int bi = 0; bi < N; bi++) {
-        auto sphereBody = chrono_types::make_shared<ChBodyEasySphere>(1.1, 1000, true, true);
+        auto sphereBody = chrono_types::make_shared<ChBodyEasySphere>(1.1, 1000, true, true,
+                                                                      ChMaterialSurface::NSC, CreateModel());
         sphereBody->SetPos(ChVector<>(-5 + ChRandom() * 10, 4 + bi * 0.05, -5 + ChRandom() * 10));
         sphereBody->GetMaterialSurfaceNSC()->SetFriction(0.2f);
         m_system->Add(sphereBody);
 
-        auto boxBody = chrono_types::make_shared<ChBodyEasyBox>(1.5, 1.5, 1.5, 100, true, true);
+        auto boxBody = chrono_types::make_shared<ChBodyEasyBox>(1.5, 1.5, 1.5, 100, true, true,
+                                                                ChMaterialSurface::NSC, CreateModel());
         boxBody->SetPos(ChVector<>(-5 + ChRandom() * 10, 4 + bi * 0.05, -5 + ChRandom() * 10));
         m_system->Add(boxBody);
 
-        auto mcylBody = chrono_types::make_shared<ChBodyEasyCylinder>(0.75, 0.5, 100, true, true);
+        auto mcylBody = chrono_types::make_shared<ChBodyEasyCylinder>(0.75, 0.5, 100, true, true,
+                                                                      ChMaterialSurface::NSC, CreateModel());
         mcylBody->SetPos(ChVector<>(-5 + ChRandom() * 10, 4 + bi * 0.05, -5 + ChRandom() * 10));
         m_system->Add(mcylBody);
     }
 
-    auto floorBody = chrono_types::make_shared<ChBodyEasyBox>(20, 1, 20, 1000, true, true);
+    auto floorBody = chrono_types::make_shared<ChBodyEasyBox>(20, 1, 20, 1000, true, true,
+                                                              ChMaterialSurface::NSC, CreateModel());
     floorBody->SetPos(ChVector<>(0, -5, 0));
     floorBody->SetBodyFixed(true);
     m_system->Add(floorBody);
 
-    auto wallBody1 = chrono_types::make_shared<ChBodyEasyBox>(1, 10, 20.99, 1000, true, true);
+    auto wallBody1 = chrono_types::make_shared<ChBodyEasyBox>(1, 10, 20.99, 1000, true, true,
+                                                              ChMaterialSurface::NSC, CreateModel());
     wallBody1->SetPos(ChVector<>(-10, 0, 0));
     wallBody1->SetBodyFixed(true);
     m_system->Add(wallBody1);
 
-    auto wallBody2 = chrono_types::make_shared<ChBodyEasyBox>(1, 10, 20.99, 1000, true, true);
+    auto wallBody2 = chrono_types::make_shared<ChBodyEasyBox>(1, 10, 20.99, 1000, true, true,
+                                                              ChMaterialSurface::NSC, CreateModel());
     wallBody2->SetPos(ChVector<>(10, 0, 0));
     wallBody2->SetBodyFixed(true);
     m_system->Add(wallBody2);
 
-    auto wallBody3 = chrono_types::make_shared<ChBodyEasyBox>(20.99, 10, 1, 1000, true, true);
+    auto wallBody3 = chrono_types::make_shared<ChBodyEasyBox>(20.99, 10, 1, 1000, true, true,
+                                                              ChMaterialSurface::NSC, CreateModel());
     wallBody3->SetPos(ChVector<>(0, 0, -10));
     wallBody3->SetBodyFixed(true);
     m_system->Add(wallBody3);
 
-    auto wallBody4 = chrono_types::make_shared<ChBodyEasyBox>(20.99, 10, 1, 1000, true, true);
+    auto wallBody4 = chrono_types::make_shared<ChBodyEasyBox>(20.99, 10, 1, 1000, true, true,
+                                                              ChMaterialSurface::NSC, CreateModel());
     wallBody4->SetPos(ChVector<>(0, 0, 10));
     wallBody4->SetBodyFixed(true);
     m_system->Add(wallBody4);
 
-    auto rotatingBody = chrono_types::make_shared<ChBodyEasyBox>(10, 5, 1, 4000, true, true);
+    auto rotatingBody = chrono_types::make_shared<ChBodyEasyBox>(10, 5, 1, 4000, true, true,
+                                                                 ChMaterialSurface::NSC, CreateModel());
     rotatingBody->SetPos(ChVector<>(0, -1.6, 0));
     rotatingBody->GetMaterialSurfaceNSC()->SetFriction(0.4f);
     m_system->Add(rotatingBody);
@@ -101,8 +125,8 @@ MixerTestNSC<N>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
     m_system->AddLink(my_motor);
 }
 
-template <int N>
-void MixerTestNSC<N>::SimulateVis() {
+template <int N, bool PRIMITIVE, ChIterativeSolverVI::Precision PREC>
+void MixerTestNSC<N, PRIMITIVE, PREC>::SimulateVis() {
 #ifdef CHRONO_IRRLICHT
     irrlicht::ChIrrApp application(m_system, L"Rigid contacts", irr::core::dimension2d<irr::u32>(800, 600), false, true);
     application.AddTypicalLogo();
@@ -130,6 +154,16 @@ void MixerTestNSC<N>::SimulateVis() {
 CH_BM_SIMULATION_LOOP(MixerNSC032, MixerTestNSC<32>,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 CH_BM_SIMULATION_LOOP(MixerNSC064, MixerTestNSC<64>,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 
+using MixerTestNSC032_P = MixerTestNSC<32, true>;
+using MixerTestNSC064_P = MixerTestNSC<64, true>;
+CH_BM_SIMULATION_LOOP(MixerNSC032_Primitive, MixerTestNSC032_P,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MixerNSC064_Primitive, MixerTestNSC064_P,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
+using MixerTestNSC064_M = MixerTestNSC<64, false, ChIterativeSolverVI::Precision::MIXED>;
+using MixerTestNSC064_S = MixerTestNSC<64, false, ChIterativeSolverVI::Precision::SINGLE>;
+CH_BM_SIMULATION_LOOP(MixerNSC064_Mixed, MixerTestNSC064_M,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MixerNSC064_Single, MixerTestNSC064_S,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
 // =============================================================================
 
 int main(int argc, char* argv[]) {
@@ -19,6 +19,7 @@
 #include "chrono/ChConfig.h"
 #include "chrono/solver/ChSolverPSOR.h"
 #include "chrono/solver/ChSolverBB.h"
+#include "chrono/solver/ChSolverTree.h"
 #include "chrono/utils/ChBenchmark.h"
 
 #include "chrono/assets/ChColorAsset.h"
@@ -34,7 +35,7 @@ using namespace chrono;
 
 // =============================================================================
 
-template <int N>
+template <int N, bool TREE = false>
 class ChainTest : public utils::ChBenchmarkTest {
   public:
     ChainTest();
@@ -51,8 +52,8 @@ class ChainTest : public utils::ChBenchmarkTest {
     double m_step;
 };
 
-template <int N>
-ChainTest<N>::ChainTest() : m_length(0.25), m_step(1e-3) {
+template <int N, bool TREE>
+ChainTest<N, TREE>::ChainTest() : m_length(0.25), m_step(1e-3) {
     ChTimestepper::Type integrator_type = ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED;
     ChSolver::Type solver_type = ChSolver::Type::BARZILAIBORWEIN;
     ChMaterialSurface::ContactMethod contact_method = ChMaterialSurface::NSC;
@@ -90,6 +91,10 @@ ChainTest<N>::ChainTest() : m_length(0.25), m_step(1e-3) {
             break;
     }
 
+    // Optionally, use the linear-time tree solver (the VI solver is only used if the problem is not a tree)
+    if (TREE)
+        m_system->SetSolver(chrono_types::make_shared<ChSolverTree>(m_system->GetSolver()));
+
     // Set integrator parameters
     switch (integrator_type) {
         case ChTimestepper::Type::HHT: {
@@ -131,8 +136,8 @@ ChainTest<N>::ChainTest() : m_length(0.25), m_step(1e-3) {
     }
 }
 
-template <int N>
-void ChainTest<N>::SimulateVis() {
+template <int N, bool TREE>
+void ChainTest<N, TREE>::SimulateVis() {
 #ifdef CHRONO_IRRLICHT
     float offset = static_cast<float>(N * m_length);
 
@@ -165,6 +170,16 @@ CH_BM_SIMULATION_LOOP(Chain16, ChainTest<16>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 20)
 CH_BM_SIMULATION_LOOP(Chain32, ChainTest<32>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 20);
 CH_BM_SIMULATION_LOOP(Chain64, ChainTest<64>, NUM_SKIP_STEPS, NUM_SIM_STEPS, 20);
 
+typedef ChainTest<4, true> tree_test_04;
+typedef ChainTest<16, true> tree_test_16;
+typedef ChainTest<64, true> tree_test_64;
+typedef ChainTest<256, true> tree_test_256;
+
+CH_BM_SIMULATION_LOOP(ChainTree004, tree_test_04,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 20);
+CH_BM_SIMULATION_LOOP(ChainTree016, tree_test_16,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 20);
+CH_BM_SIMULATION_LOOP(ChainTree064, tree_test_64,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 20);
+CH_BM_SIMULATION_LOOP(ChainTree256, tree_test_256, NUM_SKIP_STEPS, NUM_SIM_STEPS, 20);
+
 // =============================================================================
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,162 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark test for the overhead of HDF5 vehicle output in the simulation loop.
+// Compares a HMMWV simulation without output, with the per-frame HDF5 layout,
+// and with the appended HDF5 layout (extendible datasets, asynchronous writer).
+// Besides the simulation timers, reports the time the simulation thread is
+// blocked by output (total and largest in one step).
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/core/ChGlobal.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/utils/ChBenchmark.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+#include "chrono_models/vehicle/hmmwv/HMMWV.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace chrono::vehicle::hmmwv;
+
+// =============================================================================
+
+// Output type (negative value: no output)
+template <int OUTPUT_TYPE>
+class HmmwvOutputTest : public utils::ChBenchmarkTest {
+  public:
+    HmmwvOutputTest();
+    ~HmmwvOutputTest();
+
+    ChSystem* GetSystem() override { return m_hmmwv->GetSystem(); }
+    void ExecuteStep() override;
+
+    void ResetOutputTimers();
+    double m_timer_output;      // time the simulation thread is blocked by output
+    double m_timer_output_max;  // largest time blocked by output in one step
+
+  private:
+    HMMWV_Full* m_hmmwv;
+    RigidTerrain* m_terrain;
+
+    double m_step;
+};
+
+template <int OUTPUT_TYPE>
+HmmwvOutputTest<OUTPUT_TYPE>::HmmwvOutputTest() : m_timer_output(0), m_timer_output_max(0), m_step(2e-3) {
+    // Create the HMMWV vehicle, set parameters, and initialize.
+    m_hmmwv = new HMMWV_Full();
+    m_hmmwv->SetContactMethod(ChMaterialSurface::SMC);
+    m_hmmwv->SetChassisFixed(false);
+    m_hmmwv->SetInitPosition(ChCoordsys<>(ChVector<>(-50, 0, 0.7), ChQuaternion<>(1, 0, 0, 0)));
+    m_hmmwv->SetPowertrainType(PowertrainModelType::SHAFTS);
+    m_hmmwv->SetDriveType(DrivelineType::AWD);
+    m_hmmwv->SetTireType(TireModelType::TMEASY);
+    m_hmmwv->SetTireStepSize(m_step);
+    m_hmmwv->Initialize();
+
+    // Create the terrain
+    m_terrain = new RigidTerrain(m_hmmwv->GetSystem());
+    auto patch = m_terrain->AddPatch(ChCoordsys<>(ChVector<>(0, 0, -5), QUNIT), ChVector<>(300, 20, 10));
+    patch->SetContactFrictionCoefficient(0.9f);
+    patch->SetContactRestitutionCoefficient(0.01f);
+    patch->SetContactMaterialProperties(2e7f, 0.3f);
+    m_terrain->Initialize();
+
+    // Enable output of all vehicle subsystems, at every step (to magnify the output overhead)
+    if (OUTPUT_TYPE >= 0) {
+        std::string out_dir = GetChronoOutputPath() + "BENCHMARK_HDF5_OUTPUT";
+        filesystem::create_directory(filesystem::path(GetChronoOutputPath()));
+        filesystem::create_directory(filesystem::path(out_dir));
+        m_hmmwv->GetVehicle().SetChassisOutput(true);
+        m_hmmwv->GetVehicle().SetSuspensionOutput(0, true);
+        m_hmmwv->GetVehicle().SetSuspensionOutput(1, true);
+        m_hmmwv->GetVehicle().SetSteeringOutput(0, true);
+        m_hmmwv->GetVehicle().SetOutput((ChVehicleOutput::Type)OUTPUT_TYPE, out_dir,
+                                        "output_" + std::to_string(OUTPUT_TYPE), m_step);
+    }
+}
+
+template <int OUTPUT_TYPE>
+HmmwvOutputTest<OUTPUT_TYPE>::~HmmwvOutputTest() {
+    delete m_hmmwv;
+    delete m_terrain;
+}
+
+template <int OUTPUT_TYPE>
+void HmmwvOutputTest<OUTPUT_TYPE>::ExecuteStep() {
+    double time = m_hmmwv->GetSystem()->GetChTime();
+
+    // Constant driver inputs
+    ChDriver::Inputs driver_inputs = {0, 0.5, 0};
+
+    // Update modules (process inputs from other modules)
+    m_terrain->Synchronize(time);
+    m_hmmwv->Synchronize(time, driver_inputs, *m_terrain);
+
+    // Advance simulation for one timestep for all modules
+    m_terrain->Advance(m_step);
+
+    // The vehicle output is written by the simulation thread before the integration step, so the time blocked by
+    // output is the time spent in Advance outside of the integration step
+    ChTimer<double> timer;
+    timer.reset();
+    timer.start();
+    m_hmmwv->Advance(m_step);
+    timer.stop();
+    double output_time = std::max(timer() - m_hmmwv->GetSystem()->GetTimerStep(), 0.0);
+    m_timer_output += output_time;
+    m_timer_output_max = std::max(m_timer_output_max, output_time);
+}
+
+template <int OUTPUT_TYPE>
+void HmmwvOutputTest<OUTPUT_TYPE>::ResetOutputTimers() {
+    m_timer_output = 0;
+    m_timer_output_max = 0;
+}
+
+// =============================================================================
+
+#define NUM_SKIP_STEPS 500   // number of steps for hot start (2e-3 * 500 = 1s)
+#define NUM_SIM_STEPS 2500   // number of simulation steps for each benchmark (2e-3 * 2500 = 5s)
+#define REPEATS 10
+
+typedef HmmwvOutputTest<-1> none_test_type;
+typedef HmmwvOutputTest<ChVehicleOutput::HDF5> frames_test_type;
+typedef HmmwvOutputTest<ChVehicleOutput::HDF5_APPEND> append_test_type;
+
+// Same as CH_BM_SIMULATION_LOOP, also reporting the time blocked by output (in the last batch of steps)
+#define CH_BM_OUTPUT_LOOP(TEST_NAME, TEST)                                                   \
+    using TEST_NAME = chrono::utils::ChBenchmarkFixture<TEST, NUM_SKIP_STEPS>;               \
+    BENCHMARK_DEFINE_F(TEST_NAME, SimulateLoop)(benchmark::State & st) {                     \
+        while (st.KeepRunning()) {                                                           \
+            m_test->ResetOutputTimers();                                                     \
+            m_test->Simulate(NUM_SIM_STEPS);                                                 \
+        }                                                                                    \
+        Report(st);                                                                          \
+        st.counters["Output_Blocked"] = m_test->m_timer_output * 1e3;                        \
+        st.counters["Output_Blocked_Max"] = m_test->m_timer_output_max * 1e3;                \
+    }                                                                                        \
+    BENCHMARK_REGISTER_F(TEST_NAME, SimulateLoop)->Unit(benchmark::kMillisecond)->Repetitions(REPEATS);
+
+CH_BM_OUTPUT_LOOP(HmmwvOutput_NONE, none_test_type);
+CH_BM_OUTPUT_LOOP(HmmwvOutput_HDF5_FRAMES, frames_test_type);
+CH_BM_OUTPUT_LOOP(HmmwvOutput_HDF5_APPEND, append_test_type);
+
+BENCHMARK_MAIN();
@@ -16,6 +16,8 @@
 //
 // =============================================================================
 
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChSolverSparseSchur.h"
 #include "chrono/utils/ChBenchmark.h"
 
 #include "chrono_vehicle/ChVehicleModelData.h"
@@ -35,7 +37,8 @@ using namespace chrono::vehicle::hmmwv;
 
 // =============================================================================
 
-template <typename EnumClass, EnumClass TIRE_MODEL>
+// The solver type is one of SPARSE_LU or SPARSE_SCHUR (any other value keeps the default vehicle solver).
+template <typename EnumClass, EnumClass TIRE_MODEL, ChSolver::Type SOLVER = ChSolver::Type::CUSTOM>
 class HmmwvDlcTest : public utils::ChBenchmarkTest {
   public:
     HmmwvDlcTest();
@@ -58,8 +61,8 @@ class HmmwvDlcTest : public utils::ChBenchmarkTest {
     double m_step_tire;
 };
 
-template <typename EnumClass, EnumClass TIRE_MODEL>
-HmmwvDlcTest<EnumClass, TIRE_MODEL>::HmmwvDlcTest() : m_step_veh(2e-3), m_step_tire(1e-3) {
+template <typename EnumClass, EnumClass TIRE_MODEL, ChSolver::Type SOLVER>
+HmmwvDlcTest<EnumClass, TIRE_MODEL, SOLVER>::HmmwvDlcTest() : m_step_veh(2e-3), m_step_tire(1e-3) {
     PowertrainModelType powertrain_model = PowertrainModelType::SHAFTS;
     TireModelType tire_model = TireModelType::RIGID_MESH;
     DrivelineType drive_type = DrivelineType::AWD;
@@ -76,6 +79,23 @@ HmmwvDlcTest<EnumClass, TIRE_MODEL>::HmmwvDlcTest() : m_step_veh(2e-3), m_step_t
     m_hmmwv->SetAerodynamicDrag(0.5, 5.0, 1.2);
     m_hmmwv->Initialize();
 
+    // Optionally, use a direct linear solver
+    std::shared_ptr<ChDirectSolverLS> solver;
+    switch (SOLVER) {
+        case ChSolver::Type::SPARSE_LU:
+            solver = chrono_types::make_shared<ChSolverSparseLU>();
+            break;
+        case ChSolver::Type::SPARSE_SCHUR:
+            solver = chrono_types::make_shared<ChSolverSparseSchur>();
+            break;
+        default:
+            break;
+    }
+    if (solver) {
+        solver->LockSparsityPattern(true);
+        m_hmmwv->GetSystem()->SetSolver(solver);
+    }
+
     m_hmmwv->SetChassisVisualizationType(VisualizationType::PRIMITIVES);
     m_hmmwv->SetSuspensionVisualizationType(VisualizationType::PRIMITIVES);
     m_hmmwv->SetSteeringVisualizationType(VisualizationType::PRIMITIVES);
@@ -101,15 +121,15 @@ HmmwvDlcTest<EnumClass, TIRE_MODEL>::HmmwvDlcTest() : m_step_veh(2e-3), m_step_t
     m_driver->Initialize();
 }
 
-template <typename EnumClass, EnumClass TIRE_MODEL>
-HmmwvDlcTest<EnumClass, TIRE_MODEL>::~HmmwvDlcTest() {
+template <typename EnumClass, EnumClass TIRE_MODEL, ChSolver::Type SOLVER>
+HmmwvDlcTest<EnumClass, TIRE_MODEL, SOLVER>::~HmmwvDlcTest() {
     delete m_hmmwv;
     delete m_terrain;
     delete m_driver;
 }
 
-template <typename EnumClass, EnumClass TIRE_MODEL>
-void HmmwvDlcTest<EnumClass, TIRE_MODEL>::ExecuteStep() {
+template <typename EnumClass, EnumClass TIRE_MODEL, ChSolver::Type SOLVER>
+void HmmwvDlcTest<EnumClass, TIRE_MODEL, SOLVER>::ExecuteStep() {
     double time = m_hmmwv->GetSystem()->GetChTime();
 
     // Driver inputs
@@ -126,8 +146,8 @@ void HmmwvDlcTest<EnumClass, TIRE_MODEL>::ExecuteStep() {
     m_hmmwv->Advance(m_step_veh);
 }
 
-template <typename EnumClass, EnumClass TIRE_MODEL>
-void HmmwvDlcTest<EnumClass, TIRE_MODEL>::SimulateVis() {
+template <typename EnumClass, EnumClass TIRE_MODEL, ChSolver::Type SOLVER>
+void HmmwvDlcTest<EnumClass, TIRE_MODEL, SOLVER>::SimulateVis() {
 #ifdef CHRONO_IRRLICHT
     ChWheeledVehicleIrrApp app(&m_hmmwv->GetVehicle(), L"HMMWV acceleration test");
     app.SetSkyBox();
@@ -174,11 +194,15 @@ typedef HmmwvDlcTest<TireModelType, TireModelType::TMEASY> tmeasy_test_type;
 typedef HmmwvDlcTest<TireModelType, TireModelType::FIALA> fiala_test_type;
 typedef HmmwvDlcTest<TireModelType, TireModelType::RIGID> rigid_test_type;
 typedef HmmwvDlcTest<TireModelType, TireModelType::RIGID_MESH> rigidmesh_test_type;
+typedef HmmwvDlcTest<TireModelType, TireModelType::TMEASY, ChSolver::Type::SPARSE_LU> tmeasy_lu_test_type;
+typedef HmmwvDlcTest<TireModelType, TireModelType::TMEASY, ChSolver::Type::SPARSE_SCHUR> tmeasy_schur_test_type;
 
 CH_BM_SIMULATION_ONCE(HmmwvDLC_TMEASY, tmeasy_test_type, NUM_SKIP_STEPS, NUM_SIM_STEPS, REPEATS);
 CH_BM_SIMULATION_ONCE(HmmwvDLC_FIALA, fiala_test_type, NUM_SKIP_STEPS, NUM_SIM_STEPS, REPEATS);
 CH_BM_SIMULATION_ONCE(HmmwvDLC_RIGID, rigid_test_type, NUM_SKIP_STEPS, NUM_SIM_STEPS, REPEATS);
 CH_BM_SIMULATION_ONCE(HmmwvDLC_RIGIDMESH, rigidmesh_test_type, NUM_SKIP_STEPS, NUM_SIM_STEPS, REPEATS);
+CH_BM_SIMULATION_ONCE(HmmwvDLC_TMEASY_SparseLU, tmeasy_lu_test_type, NUM_SKIP_STEPS, NUM_SIM_STEPS, REPEATS);
+CH_BM_SIMULATION_ONCE(HmmwvDLC_TMEASY_SparseSchur, tmeasy_schur_test_type, NUM_SKIP_STEPS, NUM_SIM_STEPS, REPEATS);
 
 // =============================================================================
 
@@ -0,0 +1,134 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChFunction_Compiled: the value and the first and second
+// derivatives of compiled function trees are compared with those of the
+// uncompiled trees (and, for a smooth tree, with finite differences).
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/motion_functions/ChFunction_Compiled.h"
+#include "chrono/motion_functions/ChFunction_Const.h"
+#include "chrono/motion_functions/ChFunction_Poly.h"
+#include "chrono/motion_functions/ChFunction_Ramp.h"
+#include "chrono/motion_functions/ChFunction_Sine.h"
+
+using namespace chrono;
+
+using Op = ChFunction_Operation;
+
+static std::shared_ptr<ChFunction> Make(Op::eChOperation op,
+                                        std::shared_ptr<ChFunction> fa,
+                                        std::shared_ptr<ChFunction> fb) {
+    auto fun = chrono_types::make_shared<ChFunction_Operation>();
+    fun->Set_optype(op);
+    fun->Set_fa(fa);
+    fun->Set_fb(fb);
+    return fun;
+}
+
+static std::shared_ptr<ChFunction> Sine(double phase, double freq, double amp) {
+    return chrono_types::make_shared<ChFunction_Sine>(phase, freq, amp);
+}
+
+static std::shared_ptr<ChFunction> Ramp(double y0, double ang) {
+    return chrono_types::make_shared<ChFunction_Ramp>(y0, ang);
+}
+
+static std::shared_ptr<ChFunction> Const(double c) {
+    return chrono_types::make_shared<ChFunction_Const>(c);
+}
+
+// Polynomial 1 - 0.5 x + 0.3 x^2 + 0.2 x^3, not inlined by the compiler.
+static std::shared_ptr<ChFunction> Poly() {
+    auto poly = chrono_types::make_shared<ChFunction_Poly>();
+    poly->Set_order(3);
+    poly->Set_coeff(1, 0);
+    poly->Set_coeff(-0.5, 1);
+    poly->Set_coeff(0.3, 2);
+    poly->Set_coeff(0.2, 3);
+    return poly;
+}
+
+// Smooth tree: (sin * ramp + poly) / (2 + sin^2) + (1.5 + sin)^ramp + sin(ramp(poly))
+static std::shared_ptr<ChFunction> SmoothTree() {
+    auto sin1 = Sine(0.3, 0.4, 1.2);
+    auto num = Make(Op::ChOP_ADD, Make(Op::ChOP_MUL, sin1, Ramp(0.5, -0.7)), Poly());
+    auto den = Make(Op::ChOP_ADD, Const(2), Make(Op::ChOP_MUL, sin1, sin1));
+    auto pow = Make(Op::ChOP_POW, Make(Op::ChOP_ADD, Const(1.5), Sine(0, 0.2, 1)), Ramp(1, 0.3));
+    auto comp = Make(Op::ChOP_FUNCT, Sine(0.1, 0.5, 1), Make(Op::ChOP_FUNCT, Ramp(0.2, 0.8), Poly()));
+    return Make(Op::ChOP_ADD, Make(Op::ChOP_DIV, num, den), Make(Op::ChOP_SUB, pow, comp));
+}
+
+// Tree with the non-smooth operations.
+static std::shared_ptr<ChFunction> NonSmoothTree() {
+    auto sin1 = Sine(0, 0.3, 2);
+    auto max = Make(Op::ChOP_MAX, sin1, Poly());
+    auto min = Make(Op::ChOP_MIN, Ramp(0, 0.4), Sine(1, 0.2, 1));
+    auto mod = Make(Op::ChOP_MODULO, Poly(), Const(1.7));
+    auto abs = Make(Op::ChOP_FABS, Make(Op::ChOP_SUB, sin1, Ramp(0.1, 0.2)), Const(0));
+    return Make(Op::ChOP_ADD, Make(Op::ChOP_ADD, max, min), Make(Op::ChOP_MUL, mod, abs));
+}
+
+static void Compare(std::shared_ptr<ChFunction> tree) {
+    ChFunction_Compiled compiled(tree);
+    ASSERT_GT(compiled.GetNumInstructions(), 1);
+
+    for (int i = 0; i <= 100; i++) {
+        double x = -2 + 0.0437 * i;
+        double y[3];
+        compiled.Evaluate(x, 2, y);
+        double tol = 1e-12 * (1 + std::abs(tree->Get_y(x)));
+
+        ASSERT_NEAR(compiled.Get_y(x), tree->Get_y(x), tol) << "x = " << x;
+        ASSERT_NEAR(compiled.Get_y_dx(x), tree->Get_y_dx(x), 1e-12 * (1 + std::abs(y[1]))) << "x = " << x;
+        ASSERT_NEAR(compiled.Get_y_dxdx(x), tree->Get_y_dxdx(x), 1e-12 * (1 + std::abs(y[2]))) << "x = " << x;
+
+        ASSERT_DOUBLE_EQ(y[0], compiled.Get_y(x));
+        ASSERT_DOUBLE_EQ(y[1], compiled.Get_y_dx(x));
+        ASSERT_DOUBLE_EQ(y[2], compiled.Get_y_dxdx(x));
+    }
+}
+
+TEST(ChFunctionCompiledTest, smooth) {
+    auto tree = SmoothTree();
+    Compare(tree);
+
+    // The analytic derivatives of the tree match the finite differences
+    const double h = 1e-4;
+    for (int i = 0; i <= 20; i++) {
+        double x = -2 + 0.2 * i;
+        double fd1 = (tree->Get_y(x + h) - tree->Get_y(x - h)) / (2 * h);
+        double fd2 = (tree->Get_y(x + h) - 2 * tree->Get_y(x) + tree->Get_y(x - h)) / (h * h);
+        ASSERT_NEAR(tree->Get_y_dx(x), fd1, 1e-6) << "x = " << x;
+        ASSERT_NEAR(tree->Get_y_dxdx(x), fd2, 1e-4) << "x = " << x;
+    }
+}
+
+TEST(ChFunctionCompiledTest, non_smooth) {
+    Compare(NonSmoothTree());
+}
+
+TEST(ChFunctionCompiledTest, recompile) {
+    auto ramp = chrono_types::make_shared<ChFunction_Ramp>(0, 1);
+    auto tree = Make(Op::ChOP_MUL, ramp, Sine(0, 0.5, 1));
+    ChFunction_Compiled compiled(tree);
+    Compare(tree);
+
+    // The parameters of inlined functions are copied: the program must be compiled again after changing them
+    ramp->Set_ang(3);
+    compiled.Compile();
+    ASSERT_NEAR(compiled.Get_y(0.7), tree->Get_y(0.7), 1e-14);
+    ASSERT_NEAR(compiled.Get_y_dx(0.7), tree->Get_y_dx(0.7), 1e-14);
+}
@@ -0,0 +1,130 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChFunction_Recorder: interpolation and derivatives with equally
+// spaced points, non-uniformly spaced points and points inserted out of order.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "chrono/motion_functions/ChFunction_Recorder.h"
+
+using namespace chrono;
+
+const double ABS_ERR = 1e-12;
+
+static double Data(double x) {
+    return std::sin(x) + 0.1 * x * x;
+}
+
+// Reference linear interpolation of Data over the (sorted) abscissas xp.
+// The slope is that of the interval [x_i, x_(i+1)) containing x, and 0 outside the range of the points.
+static double Interpolate(const std::vector<double>& xp, double x, double& slope) {
+    slope = 0;
+    if (x < xp.front())
+        return Data(xp.front());
+    if (x >= xp.back())
+        return Data(xp.back());
+    size_t i = 0;
+    while (x >= xp[i + 1])
+        i++;
+    slope = (Data(xp[i + 1]) - Data(xp[i])) / (xp[i + 1] - xp[i]);
+    return Data(xp[i]) + slope * (x - xp[i]);
+}
+
+// Evaluate the recorder at the given arguments and compare with the reference interpolation.
+static void Check(const ChFunction_Recorder& fun, const std::vector<double>& xp, const std::vector<double>& x) {
+    for (auto xi : x) {
+        double slope;
+        double y = Interpolate(xp, xi, slope);
+        ASSERT_NEAR(fun.Get_y(xi), y, ABS_ERR) << "x = " << xi;
+        ASSERT_NEAR(fun.Get_y_dx(xi), slope, ABS_ERR) << "x = " << xi;
+        ASSERT_EQ(fun.Get_y_dxdx(xi), 0.0) << "x = " << xi;
+    }
+}
+
+// Evaluation arguments: sweep forward and backward (including the points and the outside of the range), then random.
+static std::vector<double> Arguments(double xmin, double xmax) {
+    std::vector<double> x;
+    for (int i = -10; i <= 210; i++)
+        x.push_back(xmin + (xmax - xmin) * i / 200.0);
+    for (int i = 210; i >= -10; i--)
+        x.push_back(xmin + (xmax - xmin) * i / 200.0 + 1e-3);
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(xmin - 1, xmax + 1);
+    for (int i = 0; i < 200; i++)
+        x.push_back(dist(gen));
+    return x;
+}
+
+TEST(ChFunctionRecorderTest, uniform) {
+    std::vector<double> xp;
+    ChFunction_Recorder fun;
+    for (int i = 0; i <= 40; i++) {
+        xp.push_back(-2 + 0.25 * i);
+        fun.AddPoint(xp.back(), Data(xp.back()));
+    }
+    ASSERT_TRUE(fun.IsUniform());
+    ASSERT_EQ(fun.GetPoints().size(), xp.size());
+
+    Check(fun, xp, Arguments(xp.front(), xp.back()));
+}
+
+TEST(ChFunctionRecorderTest, non_uniform) {
+    std::vector<double> xp;
+    ChFunction_Recorder fun;
+    for (int i = 0; i <= 40; i++) {
+        xp.push_back(0.01 * i * i);
+        fun.AddPoint(xp.back(), Data(xp.back()));
+    }
+    ASSERT_FALSE(fun.IsUniform());
+
+    Check(fun, xp, Arguments(xp.front(), xp.back()));
+}
+
+TEST(ChFunctionRecorderTest, out_of_order) {
+    std::vector<double> xp;
+    for (int i = 0; i <= 40; i++)
+        xp.push_back(-1 + 0.125 * i);
+
+    // Insert the points in random order
+    std::vector<double> xs = xp;
+    std::shuffle(xs.begin(), xs.end(), std::mt19937(1));
+    ChFunction_Recorder fun;
+    for (auto x : xs)
+        fun.AddPoint(x, Data(x));
+
+    // The points are sorted, and detected as equally spaced
+    const auto& points = fun.GetPoints();
+    ASSERT_EQ(points.size(), xp.size());
+    for (size_t i = 0; i < xp.size(); i++)
+        ASSERT_EQ(points[i].x, xp[i]);
+    ASSERT_TRUE(fun.IsUniform());
+    Check(fun, xp, Arguments(xp.front(), xp.back()));
+
+    // Overwrite an existing point
+    fun.AddPoint(xp[10], 100);
+    ASSERT_EQ(points.size(), xp.size());
+    ASSERT_EQ(fun.Get_y(xp[10]), 100);
+
+    // Insert a point in the middle of an interval: the points are no longer equally spaced
+    fun.AddPoint(xp[10], Data(xp[10]));
+    double xm = 0.5 * (xp[20] + xp[21]);
+    fun.AddPoint(xm, Data(xm));
+    xp.insert(xp.begin() + 21, xm);
+    ASSERT_FALSE(fun.IsUniform());
+    Check(fun, xp, Arguments(xp.front(), xp.back()));
+}
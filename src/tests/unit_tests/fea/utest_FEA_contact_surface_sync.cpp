@@ -0,0 +1,171 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the parallel synchronization of the collision models of FEA
+// contact surfaces. The broadphase AABBs set by the node cloud are compared
+// with AABBs computed serially from the collision shapes, with and without
+// an AABB update tolerance, and after nodes are replaced in place.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCModelBullet.h"
+#include "chrono/collision/bullet/BulletCollision/BroadphaseCollision/btBroadphaseProxy.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionDispatch/btCollisionObject.h"
+#include "chrono/fea/ChContactSurfaceNodeCloud.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/fea/ChNodeFEAxyz.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+using namespace chrono::collision;
+
+static const int num_nodes = 200;
+
+class ContactSurfaceSyncTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        CHOMPfunctions::SetNumThreads(4);
+
+        mesh = chrono_types::make_shared<ChMesh>();
+        for (int i = 0; i < num_nodes; i++) {
+            auto node = chrono_types::make_shared<ChNodeFEAxyz>(ChVector<>(0.1 * (i % 20), 0.1 * (i / 20), 0));
+            mesh->AddNode(node);
+            nodes.push_back(node);
+        }
+
+        cloud = chrono_types::make_shared<ChContactSurfaceNodeCloud>();
+        cloud->SetMaterialSurface(chrono_types::make_shared<ChMaterialSurfaceNSC>());
+        mesh->AddContactSurface(cloud);
+        cloud->AddAllNodes(0.01);
+
+        sys.Add(mesh);
+    }
+
+    btCollisionObject* Object(int i) {
+        return static_cast<ChModelBullet*>(cloud->GetNode(i)->GetCollisionModel())->GetBulletModel();
+    }
+
+    // AABB stored in the broadphase for the i-th node.
+    void BroadphaseAabb(int i, btVector3& min, btVector3& max) {
+        min = Object(i)->getBroadphaseHandle()->m_aabbMin;
+        max = Object(i)->getBroadphaseHandle()->m_aabbMax;
+    }
+
+    // AABB computed serially from the collision shape at its current transform.
+    void SerialAabb(int i, btVector3& min, btVector3& max) {
+        btCollisionObject* obj = Object(i);
+        obj->getCollisionShape()->getAabb(obj->getWorldTransform(), min, max);
+    }
+
+    // Displacement of the i-th node, alternating between 'small' and 'large'.
+    ChVector<> Displacement(int i, double small, double large) {
+        double d = (i % 2) ? large : small;
+        return ChVector<>(d * std::cos(0.1 * i), d * std::sin(0.1 * i), 0);
+    }
+
+    ChSystemNSC sys;
+    std::shared_ptr<ChMesh> mesh;
+    std::shared_ptr<ChContactSurfaceNodeCloud> cloud;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+};
+
+TEST_F(ContactSurfaceSyncTest, no_tolerance) {
+    ASSERT_EQ(cloud->GetNnodes(), (unsigned int)num_nodes);
+
+    for (int step = 0; step < 3; step++) {
+        for (int i = 0; i < num_nodes; i++)
+            nodes[i]->SetPos(nodes[i]->GetPos() + Displacement(i + step, 1e-4, 0.05));
+        cloud->SurfaceSyncCollisionModels();
+
+        for (int i = 0; i < num_nodes; i++) {
+            btVector3 bp_min, bp_max, ref_min, ref_max;
+            BroadphaseAabb(i, bp_min, bp_max);
+            SerialAabb(i, ref_min, ref_max);
+            ASSERT_TRUE(bp_min == ref_min && bp_max == ref_max) << "node " << i << " at step " << step;
+        }
+    }
+}
+
+TEST_F(ContactSurfaceSyncTest, tolerance) {
+    // The update threshold is tolerance * envelope
+    double envelope = cloud->GetNode(0)->GetCollisionModel()->GetEnvelope();
+    cloud->SetAabbUpdateTolerance(1.0);
+    cloud->SurfaceSyncCollisionModels();
+
+    std::vector<btVector3> old_min(num_nodes), old_max(num_nodes);
+    for (int i = 0; i < num_nodes; i++)
+        BroadphaseAabb(i, old_min[i], old_max[i]);
+
+    // Even nodes move below the threshold, odd nodes above it
+    for (int i = 0; i < num_nodes; i++)
+        nodes[i]->SetPos(nodes[i]->GetPos() + Displacement(i, 0.5 * envelope, 2 * envelope));
+    cloud->SurfaceSyncCollisionModels();
+
+    for (int i = 0; i < num_nodes; i++) {
+        btVector3 bp_min, bp_max, ref_min, ref_max;
+        BroadphaseAabb(i, bp_min, bp_max);
+        SerialAabb(i, ref_min, ref_max);
+        if (i % 2) {
+            ASSERT_TRUE(bp_min == ref_min && bp_max == ref_max) << "node " << i;
+        } else {
+            ASSERT_TRUE(bp_min == old_min[i] && bp_max == old_max[i]) << "node " << i;
+        }
+    }
+
+    // Displacements accumulate from the last AABB update: a second small move of the even nodes crosses the
+    // threshold, while the odd nodes (updated at the previous synchronization) stay below it.
+    for (int i = 0; i < num_nodes; i++) {
+        BroadphaseAabb(i, old_min[i], old_max[i]);
+        nodes[i]->SetPos(nodes[i]->GetPos() + Displacement(i, 0.6 * envelope, 0.5 * envelope));
+    }
+    cloud->SurfaceSyncCollisionModels();
+
+    for (int i = 0; i < num_nodes; i++) {
+        btVector3 bp_min, bp_max, ref_min, ref_max;
+        BroadphaseAabb(i, bp_min, bp_max);
+        SerialAabb(i, ref_min, ref_max);
+        if (i % 2) {
+            ASSERT_TRUE(bp_min == old_min[i] && bp_max == old_max[i]) << "node " << i;
+        } else {
+            ASSERT_TRUE(bp_min == ref_min && bp_max == ref_max) << "node " << i;
+        }
+    }
+}
+
+TEST_F(ContactSurfaceSyncTest, node_replaced_in_place) {
+    cloud->SetAabbUpdateTolerance(0.5);
+    cloud->SurfaceSyncCollisionModels();
+
+    // Point the first contact node to a different FEA node, far away. The node counts do not change.
+    auto other = chrono_types::make_shared<ChNodeFEAxyz>(ChVector<>(10, 10, 10));
+    mesh->AddNode(other);
+    cloud->GetNode(0)->SetNode(other.get());
+    cloud->SurfaceSyncCollisionModels();
+
+    btVector3 bp_min, bp_max, ref_min, ref_max;
+    BroadphaseAabb(0, bp_min, bp_max);
+    SerialAabb(0, ref_min, ref_max);
+    ASSERT_TRUE(bp_min == ref_min && bp_max == ref_max);
+    ASSERT_GT(bp_max.x(), 9.9);
+
+    // Later moves of the new node are tracked as well
+    other->SetPos(ChVector<>(20, 10, 10));
+    cloud->SurfaceSyncCollisionModels();
+    BroadphaseAabb(0, bp_min, bp_max);
+    ASSERT_GT(bp_max.x(), 19.9);
+}
@@ -0,0 +1,184 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the Abaqus .inp and TetGen loaders of ChMeshFileLoader
+//
+// =============================================================================
+
+#include <clocale>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChGlobal.h"
+#include "chrono/fea/ChContinuumMaterial.h"
+#include "chrono/fea/ChElementTetra_4.h"
+#include "chrono/fea/ChMeshFileLoader.h"
+#include "chrono/fea/ChNodeFEAxyz.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+typedef std::map<std::string, std::vector<std::shared_ptr<ChNodeFEAbase>>> NodeSets;
+
+static const std::string inp_file = "testing/fea/UT_AbaqusLoader.inp";
+
+static void CheckMesh(std::shared_ptr<ChMesh> mesh, NodeSets& node_sets) {
+    // Node 6 is not used by elements or node sets, so it is discarded
+    ASSERT_EQ(mesh->GetNnodes(), 5);
+    ASSERT_EQ(mesh->GetNelements(), 2);
+
+    // Nodes are inserted sorted by ID, with the translation applied
+    for (unsigned int i = 0; i < 5; i++) {
+        auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(i));
+        ASSERT_TRUE(node);
+        ASSERT_DOUBLE_EQ(node->GetPos().z(), (i == 3 || i == 4) ? 3.0 : 2.0);
+    }
+
+    auto tet = std::dynamic_pointer_cast<ChElementTetra_4>(mesh->GetElement(1));
+    ASSERT_TRUE(tet);
+    ASSERT_EQ(tet->GetNodeN(0), mesh->GetNode(4));
+
+    ASSERT_EQ(node_sets.size(), 2);
+    ASSERT_EQ(node_sets["BASE"].size(), 3);
+    ASSERT_EQ(node_sets["BASE"][2], mesh->GetNode(2));
+    ASSERT_EQ(node_sets["TOP"].size(), 1);
+    ASSERT_EQ(node_sets["TOP"][0], mesh->GetNode(4));
+}
+
+TEST(ChMeshFileLoaderTest, abaqus) {
+    auto material = chrono_types::make_shared<ChContinuumElastic>();
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    NodeSets node_sets;
+    ChMeshFileLoader::FromAbaqusFile(mesh, GetChronoDataFile(inp_file).c_str(), material, node_sets,
+                                     ChVector<>(0, 0, 2));
+    CheckMesh(mesh, node_sets);
+}
+
+TEST(ChMeshFileLoaderTest, abaqus_cache) {
+    // Work on a copy, so that the cache file is not created in the data directory
+    std::string copy_file = "UT_AbaqusLoader_copy.inp";
+    {
+        std::ifstream src(GetChronoDataFile(inp_file), std::ios::binary);
+        std::ofstream dst(copy_file, std::ios::binary);
+        dst << src.rdbuf();
+    }
+    std::remove((copy_file + ".chcache").c_str());
+
+    auto material = chrono_types::make_shared<ChContinuumElastic>();
+    for (int pass = 0; pass < 2; pass++) {
+        auto mesh = chrono_types::make_shared<ChMesh>();
+        NodeSets node_sets;
+        ChMeshFileLoader::FromAbaqusFile(mesh, copy_file.c_str(), material, node_sets, ChVector<>(0, 0, 2),
+                                         ChMatrix33<>(1), true, true);
+        CheckMesh(mesh, node_sets);
+        ASSERT_TRUE(std::ifstream(copy_file + ".chcache").good());
+    }
+
+    std::remove((copy_file + ".chcache").c_str());
+    std::remove(copy_file.c_str());
+}
+
+TEST(ChMeshFileLoaderTest, abaqus_invalid_nset) {
+    std::string bad_file = "UT_AbaqusLoader_bad.inp";
+    {
+        std::ofstream out(bad_file);
+        out << "*NODE\n1, 0, 0, 0\n2, 1, 0, 0\n3, 0, 1, 0\n4, 0, 0, 1\n";
+        out << "*ELEMENT, TYPE=C3D4\n1, 1, 2, 3, 4\n";
+        out << "*NSET, NSET=BAD\n1, 0\n";
+    }
+
+    auto material = chrono_types::make_shared<ChContinuumElastic>();
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    NodeSets node_sets;
+    ASSERT_THROW(ChMeshFileLoader::FromAbaqusFile(mesh, bad_file.c_str(), material, node_sets), ChException);
+
+    std::remove(bad_file.c_str());
+}
+
+TEST(ChMeshFileLoaderTest, abaqus_numeric_locale) {
+    // Under a locale with comma as decimal separator, "0.5" must still be read as 0.5
+    std::string old_locale = std::setlocale(LC_NUMERIC, nullptr);
+    const char* locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "fr_FR.utf8", "German", "French"};
+    for (auto loc : locales) {
+        if (std::setlocale(LC_NUMERIC, loc))
+            break;
+    }
+
+    std::string file = "UT_AbaqusLoader_locale.inp";
+    {
+        std::ofstream out(file);
+        out << "*NODE\n1, 0.5, 0, 0\n2, 1.5, 0, 0\n3, 0, 1.25, 0\n4, 0, 0, 1.75e0\n";
+        out << "*ELEMENT, TYPE=C3D4\n1, 1, 2, 3, 4\n";
+    }
+
+    auto material = chrono_types::make_shared<ChContinuumElastic>();
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    NodeSets node_sets;
+    ChMeshFileLoader::FromAbaqusFile(mesh, file.c_str(), material, node_sets);
+    std::setlocale(LC_NUMERIC, old_locale.c_str());
+    std::remove(file.c_str());
+
+    ASSERT_EQ(mesh->GetNnodes(), 4);
+    ASSERT_DOUBLE_EQ(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(0))->GetPos().x(), 0.5);
+    ASSERT_DOUBLE_EQ(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(1))->GetPos().x(), 1.5);
+    ASSERT_DOUBLE_EQ(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(2))->GetPos().y(), 1.25);
+    ASSERT_DOUBLE_EQ(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(3))->GetPos().z(), 1.75);
+}
+
+TEST(ChMeshFileLoaderTest, tetgen_corrupted_cache) {
+    std::string node_file = "UT_TetGenLoader.node";
+    std::string ele_file = "UT_TetGenLoader.ele";
+    std::string cache_file = ele_file + ".chcache";
+    {
+        std::ofstream out(node_file);
+        out << "4 3 0 0\n1 0 0 0\n2 1 0 0\n3 0 1 0\n4 0 0 1\n";
+    }
+    {
+        std::ofstream out(ele_file);
+        out << "1 4 0\n1 1 2 3 4\n";
+    }
+    std::remove(cache_file.c_str());
+
+    auto material = chrono_types::make_shared<ChContinuumElastic>();
+    {
+        auto mesh = chrono_types::make_shared<ChMesh>();
+        ChMeshFileLoader::FromTetGenFile(mesh, node_file.c_str(), ele_file.c_str(), material, VNULL,
+                                         ChMatrix33<>(1), true);
+        ASSERT_EQ(mesh->GetNelements(), 1);
+    }
+
+    // Overwrite the last node ID in the cache with an out-of-range value. The cache header still matches the
+    // source files, so only the range check prevents using the bad index.
+    {
+        std::fstream cache(cache_file, std::ios::in | std::ios::out | std::ios::binary);
+        ASSERT_TRUE(cache.good());
+        cache.seekp(-static_cast<std::streamoff>(sizeof(int)), std::ios::end);
+        int bad_id = 1000;
+        cache.write(reinterpret_cast<const char*>(&bad_id), sizeof(bad_id));
+    }
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    ChMeshFileLoader::FromTetGenFile(mesh, node_file.c_str(), ele_file.c_str(), material, VNULL, ChMatrix33<>(1),
+                                     true);
+    ASSERT_EQ(mesh->GetNnodes(), 4);
+    ASSERT_EQ(mesh->GetNelements(), 1);
+    auto tet = std::dynamic_pointer_cast<ChElementTetra_4>(mesh->GetElement(0));
+    ASSERT_TRUE(tet);
+    ASSERT_EQ(tet->GetNodeN(3), mesh->GetNode(3));
+
+    std::remove(cache_file.c_str());
+    std::remove(node_file.c_str());
+    std::remove(ele_file.c_str());
+}
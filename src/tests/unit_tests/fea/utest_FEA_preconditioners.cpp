@@ -0,0 +1,138 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the preconditioners of the iterative linear solvers: an ANCF
+// cable falling under gravity is simulated with GMRES and MINRES using the
+// ILU(k) and AMG preconditioners, and the results are compared with those
+// obtained with the SparseLU direct solver. The cable is either fixed at one end
+// (symmetric positive definite problem) or pinned to the ground through a
+// constraint (KKT problem).
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChLinkPointFrame.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/solver/ChPreconditioner.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static const int num_elements = 40;
+static const int num_steps = 10;
+
+// Simulate the cable with the given solver and return the final positions of the nodes.
+static std::vector<ChVector<>> Simulate(std::shared_ptr<ChSolver> solver, bool constrained) {
+    ChSystemSMC sys;
+    sys.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto section = chrono_types::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.02);
+    section->SetYoungModulus(1e7);
+    section->SetDensity(2000);
+    section->SetBeamRaleyghDamping(0.01);
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    ChBuilderBeamANCF builder;
+    builder.BuildBeam(mesh, section, num_elements, ChVector<>(0, 0, 0), ChVector<>(1, 0, 0));
+    sys.Add(mesh);
+
+    auto first = builder.GetLastBeamNodes().front();
+    if (constrained) {
+        auto ground = chrono_types::make_shared<ChBody>();
+        ground->SetBodyFixed(true);
+        sys.AddBody(ground);
+        auto pin = chrono_types::make_shared<ChLinkPointFrame>();
+        pin->Initialize(first, ground);
+        sys.Add(pin);
+    } else {
+        first->SetFixed(true);
+    }
+
+    sys.SetSolver(solver);
+    for (int i = 0; i < num_steps; i++)
+        sys.DoStepDynamics(1e-3);
+
+    std::vector<ChVector<>> pos;
+    for (const auto& node : builder.GetLastBeamNodes())
+        pos.push_back(node->GetPos());
+    return pos;
+}
+
+static void Compare(const std::vector<ChVector<>>& pos, const std::vector<ChVector<>>& pos_ref) {
+    ASSERT_EQ(pos.size(), pos_ref.size());
+    for (size_t i = 0; i < pos.size(); i++)
+        ASSERT_NEAR((pos[i] - pos_ref[i]).Length(), 0, 1e-9) << "node " << i;
+}
+
+template <class Solver>
+static std::shared_ptr<Solver> CreateSolver(std::shared_ptr<ChPreconditioner> precond) {
+    auto solver = chrono_types::make_shared<Solver>();
+    solver->SetPreconditioner(precond);
+    solver->SetMaxIterations(2000);
+    solver->SetTolerance(1e-13);
+    solver->LockSparsityPattern(true);
+    return solver;
+}
+
+static std::shared_ptr<ChPreconditionerAMG> CreateAMG() {
+    // Small coarse problem, so that the multigrid hierarchy has several levels
+    auto amg = chrono_types::make_shared<ChPreconditionerAMG>();
+    amg->SetCoarseSize(20);
+    return amg;
+}
+
+TEST(ChPreconditioner, cable_spd) {
+    auto pos_ref = Simulate(chrono_types::make_shared<ChSolverSparseLU>(), false);
+    ASSERT_LT(pos_ref.back().y(), -1e-5);
+
+    auto gmres_iluk = CreateSolver<ChSolverGMRES>(chrono_types::make_shared<ChPreconditionerILUK>(1));
+    Compare(Simulate(gmres_iluk, false), pos_ref);
+    ASSERT_EQ(gmres_iluk->GetNumPreconditionerUpdates(), num_steps);
+
+    auto amg = CreateAMG();
+    auto gmres_amg = CreateSolver<ChSolverGMRES>(amg);
+    Compare(Simulate(gmres_amg, false), pos_ref);
+    ASSERT_GT(amg->GetNumLevels(), 1);
+    ASSERT_EQ(gmres_amg->GetPreconditioner(), amg);
+
+    auto minres_amg = CreateSolver<ChSolverMINRES>(CreateAMG());
+    Compare(Simulate(minres_amg, false), pos_ref);
+    ASSERT_TRUE(minres_amg->GetPreconditioner() != nullptr);
+}
+
+TEST(ChPreconditioner, cable_kkt) {
+    auto pos_ref = Simulate(chrono_types::make_shared<ChSolverSparseLU>(), true);
+    ASSERT_LT(pos_ref.back().y(), -1e-5);
+
+    auto gmres_iluk = CreateSolver<ChSolverGMRES>(chrono_types::make_shared<ChPreconditionerILUK>(1));
+    Compare(Simulate(gmres_iluk, true), pos_ref);
+
+    // AMG cannot be built for the zero diagonal of the constraint rows: diagonal preconditioning is used instead
+    auto gmres_amg = CreateSolver<ChSolverGMRES>(CreateAMG());
+    Compare(Simulate(gmres_amg, true), pos_ref);
+}
+
+TEST(ChPreconditioner, minres_requires_spd) {
+    // ILU preconditioners are not symmetric and are rejected by MINRES
+    auto minres = chrono_types::make_shared<ChSolverMINRES>();
+    minres->SetPreconditioner(chrono_types::make_shared<ChPreconditionerILUK>(0));
+    ASSERT_TRUE(minres->GetPreconditioner() == nullptr);
+    minres->SetPreconditioner(chrono_types::make_shared<ChPreconditionerILUT>());
+    ASSERT_TRUE(minres->GetPreconditioner() == nullptr);
+    minres->SetPreconditioner(chrono_types::make_shared<ChPreconditionerIC>());
+    ASSERT_TRUE(minres->GetPreconditioner() != nullptr);
+}
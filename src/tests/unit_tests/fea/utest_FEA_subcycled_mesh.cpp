@@ -0,0 +1,124 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChSubcycledMesh: a pendulum carrying an ANCF cable, with the
+// cable integrated in a subcycled subsystem, is compared against the same model
+// integrated in a single system with the small step.
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChLinkPointFrame.h"
+#include "chrono/fea/ChSubcycledMesh.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static const double step_small = 1e-4;
+static const double step_large = 1e-3;
+static const double t_end = 0.3;
+
+// Create the pendulum body in the given system (hinged to ground about the z axis).
+static std::shared_ptr<ChBody> CreatePendulum(ChSystem& sys) {
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    auto body = chrono_types::make_shared<ChBody>();
+    body->SetMass(5);
+    body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+    body->SetPos(ChVector<>(1, 0, 0));
+    sys.AddBody(body);
+
+    auto revolute = chrono_types::make_shared<ChLinkLockRevolute>();
+    revolute->Initialize(ground, body, ChCoordsys<>(VNULL, QUNIT));
+    sys.AddLink(revolute);
+
+    return body;
+}
+
+// Create the cable in the given system, with its first node attached to the given body.
+static std::shared_ptr<ChNodeFEAxyzD> CreateCable(ChSystem& sys, std::shared_ptr<ChBody> body) {
+    auto section = chrono_types::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.02);
+    section->SetYoungModulus(1e9);
+    section->SetDensity(2000);
+    section->SetBeamRaleyghDamping(0.01);
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    ChBuilderBeamANCF builder;
+    builder.BuildBeam(mesh, section, 5, ChVector<>(1, 0, 0), ChVector<>(1.5, 0, 0));
+    sys.Add(mesh);
+
+    auto pin = chrono_types::make_shared<ChLinkPointFrame>();
+    pin->Initialize(builder.GetLastBeamNodes().front(), body);
+    sys.Add(pin);
+
+    return builder.GetLastBeamNodes().back();
+}
+
+static void SetSolver(ChSystem& sys) {
+    auto solver = chrono_types::make_shared<ChSolverSparseLU>();
+    solver->LockSparsityPattern(true);
+    sys.SetSolver(solver);
+}
+
+TEST(ChSubcycledMeshTest, pendulum_cable) {
+    // Reference: all in one system, integrated with the small step
+    ChSystemSMC sys_ref;
+    SetSolver(sys_ref);
+    auto body_ref = CreatePendulum(sys_ref);
+    auto tip_ref = CreateCable(sys_ref, body_ref);
+
+    // Subcycled: the cable is in a subsystem, advanced with the small step while the main system takes large steps
+    ChSystemSMC sys;
+    SetSolver(sys);
+    auto body = CreatePendulum(sys);
+
+    auto subsys = chrono_types::make_shared<ChSystemSMC>();
+    SetSolver(*subsys);
+    auto subcycled = chrono_types::make_shared<ChSubcycledMesh>(subsys);
+    subcycled->SetSubstep(step_small);
+    sys.Add(subcycled);
+    auto proxy = subcycled->AddInterfaceBody(body);
+    auto tip = CreateCable(*subsys, proxy);
+
+    ASSERT_TRUE(proxy->GetBodyFixed());
+
+    double max_body_err = 0;
+    double max_tip_err = 0;
+    while (sys.GetChTime() < t_end - 1e-9) {
+        sys.DoStepDynamics(step_large);
+        subcycled->Advance(step_large);
+        ASSERT_EQ(subcycled->GetNumSubstepsLast(), 10);
+
+        while (sys_ref.GetChTime() < sys.GetChTime() - 1e-9)
+            sys_ref.DoStepDynamics(step_small);
+
+        max_body_err = std::max(max_body_err, (body->GetPos() - body_ref->GetPos()).Length());
+        max_tip_err = std::max(max_tip_err, (tip->GetPos() - tip_ref->GetPos()).Length());
+    }
+
+    std::cout << "max body position error: " << max_body_err << std::endl;
+    std::cout << "max cable tip position error: " << max_tip_err << std::endl;
+    std::cout << "body position: " << body->GetPos() << "  reference: " << body_ref->GetPos() << std::endl;
+
+    // The pendulum must have swung (the cable load is transferred to the main body) and match the reference
+    ASSERT_GT((body->GetPos() - ChVector<>(1, 0, 0)).Length(), 0.1);
+    ASSERT_LT(max_body_err, 3e-3);
+    ASSERT_LT(max_tip_err, 3e-3);
+}
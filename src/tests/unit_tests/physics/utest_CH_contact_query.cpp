@@ -0,0 +1,243 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the filtered bulk contact queries (CollectContacts): on a pile
+// of bodies, the contacts extracted by the NSC and SMC containers (and by the
+// default implementation) must be the same as those obtained by filtering the
+// output of ReportAllContacts with a callback, including the group assignment
+// of the monitored objects and the excluded pairs.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+
+using namespace chrono;
+
+typedef ChContactContainer::ContactFilter ContactFilter;
+typedef ChContactContainer::ContactData ContactData;
+
+// Filter specification, applied by the reference callback below.
+struct FilterSpec {
+    std::map<ChContactable*, int> groups;
+    std::set<std::pair<ChContactable*, ChContactable*>> excluded;
+    bool active_only;
+};
+
+// Reference implementation of the bulk query: filter the contacts reported by ReportAllContacts.
+class ReferenceCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    ReferenceCollector(const FilterSpec& spec) : m_spec(spec) {}
+
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* objA,
+                                 ChContactable* objB) override {
+        pairs.push_back(std::make_pair(objA, objB));
+        if (m_spec.active_only && (distance > 0 || react_forces.IsNull()))
+            return true;
+        auto groupA = m_spec.groups.find(objA);
+        if (groupA != m_spec.groups.end() && m_spec.excluded.count(std::make_pair(objA, objB)) == 0)
+            data.Add(groupA->second, objA, objB, pA, plane_coord, distance, react_forces, react_torques);
+        auto groupB = m_spec.groups.find(objB);
+        if (groupB != m_spec.groups.end() && m_spec.excluded.count(std::make_pair(objB, objA)) == 0)
+            data.Add(groupB->second, objB, objA, pB, plane_coord, distance, react_forces, react_torques);
+        return true;
+    }
+
+    ContactData data;                                              // selected contacts, in reporting order
+    std::vector<std::pair<ChContactable*, ChContactable*>> pairs;  // objects of all reported contacts
+
+  private:
+    const FilterSpec& m_spec;
+};
+
+// Create a pile of spheres (collision family 2) and boxes on a fixed box. Some bodies have rolling friction (NSC).
+static std::vector<std::shared_ptr<ChBody>> CreatePile(ChSystem& sys, ChMaterialSurface::ContactMethod method) {
+    std::vector<std::shared_ptr<ChBody>> bodies;
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false, method);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+    bodies.push_back(ground);
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            for (int k = 0; k < 2; k++) {
+                std::shared_ptr<ChBody> body;
+                if ((i + j + k) % 2) {
+                    body = chrono_types::make_shared<ChBodyEasySphere>(0.2, 1000, true, false, method);
+                    body->GetCollisionModel()->SetFamily(2);
+                } else {
+                    body = chrono_types::make_shared<ChBodyEasyBox>(0.35, 0.3, 0.35, 1000, true, false, method);
+                }
+                if (method == ChMaterialSurface::NSC && i == 0)
+                    body->GetMaterialSurfaceNSC()->SetRollingFriction(0.01f);
+                body->SetPos(ChVector<>(0.38 * i + 0.03 * k, 0.25 + 0.36 * k, 0.38 * j - 0.02 * k));
+                sys.AddBody(body);
+                bodies.push_back(body);
+            }
+        }
+    }
+
+    return bodies;
+}
+
+static void CompareData(const ContactData& data, const ContactData& ref, int num_groups) {
+    ASSERT_EQ(data.GetNumContacts(), ref.GetNumContacts());
+    for (size_t i = 0; i < ref.GetNumContacts(); i++) {
+        ASSERT_EQ(data.groups[i], ref.groups[i]) << "contact " << i;
+        ASSERT_EQ(data.objects[i], ref.objects[i]) << "contact " << i;
+        ASSERT_EQ(data.others[i], ref.others[i]) << "contact " << i;
+        ASSERT_TRUE(data.points[i] == ref.points[i]) << "contact " << i;
+        ASSERT_TRUE(data.planes[i].Get_A_Xaxis() == ref.planes[i].Get_A_Xaxis()) << "contact " << i;
+        ASSERT_TRUE(data.planes[i].Get_A_Yaxis() == ref.planes[i].Get_A_Yaxis()) << "contact " << i;
+        ASSERT_EQ(data.distances[i], ref.distances[i]) << "contact " << i;
+        ASSERT_TRUE(data.forces[i] == ref.forces[i]) << "contact " << i;
+        ASSERT_TRUE(data.torques[i] == ref.torques[i]) << "contact " << i;
+    }
+
+    // Group offsets
+    ASSERT_EQ((int)data.offsets.size(), num_groups + 1);
+    ASSERT_EQ(data.offsets.front(), 0u);
+    ASSERT_EQ(data.offsets.back(), data.GetNumContacts());
+    for (int g = 0; g < num_groups; g++) {
+        for (size_t i = data.offsets[g]; i < data.offsets[g + 1]; i++)
+            ASSERT_EQ(data.groups[i], g) << "contact " << i;
+    }
+}
+
+// Query the contacts of the pile with several filters and compare with the reference.
+static void TestQueries(ChSystem& sys, std::vector<std::shared_ptr<ChBody>>& bodies) {
+    auto container = sys.GetContactContainer();
+    ChContactable* ground = bodies[0].get();
+
+    // Two bodies in contact with the ground
+    FilterSpec all_spec;
+    all_spec.active_only = false;
+    ReferenceCollector all(all_spec);
+    container->ReportAllContacts(&all);
+    std::vector<ChContactable*> on_ground;
+    for (auto& c : all.pairs) {
+        ChContactable* other = (c.first == ground) ? c.second : (c.second == ground) ? c.first : nullptr;
+        if (other && std::find(on_ground.begin(), on_ground.end(), other) == on_ground.end())
+            on_ground.push_back(other);
+    }
+    ASSERT_GE(on_ground.size(), 2u);
+
+    // Filter: ground in group 0, two boxes in group 1 (one of them first added to group 3), spheres (family 2) in
+    // group 2, and the two bodies on the ground (in group 1, unless already monitored). The contacts of the ground
+    // with the first body on the ground, and of the second body on the ground with the ground, are excluded.
+    ContactFilter filter;
+    FilterSpec spec;
+    filter.AddObject(ground, 0);
+    spec.groups[ground] = 0;
+    filter.AddObject(bodies[4].get(), 3);
+    filter.AddObject(bodies[4].get(), 1);
+    spec.groups[bodies[4].get()] = 1;
+    filter.AddObject(bodies[1].get(), 1);
+    spec.groups[bodies[1].get()] = 1;
+    filter.AddFamily(sys.Get_bodylist(), 2, 2);
+    for (auto& body : bodies) {
+        if (body->GetCollisionModel()->GetFamily() == 2)
+            spec.groups[body.get()] = 2;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (spec.groups.count(on_ground[i]) == 0) {
+            filter.AddObject(on_ground[i], 1);
+            spec.groups[on_ground[i]] = 1;
+        }
+    }
+    filter.Exclude(ground, on_ground[0]);
+    spec.excluded.insert(std::make_pair(ground, on_ground[0]));
+    filter.Exclude(on_ground[1], ground);
+    spec.excluded.insert(std::make_pair(on_ground[1], ground));
+
+    ASSERT_EQ(filter.GetNumGroups(), 4);
+    int num_unmonitored = 0;
+    for (auto& body : bodies) {
+        auto group = spec.groups.find(body.get());
+        ASSERT_EQ(filter.GetGroup(body.get()), group == spec.groups.end() ? -1 : group->second);
+        num_unmonitored += (group == spec.groups.end());
+    }
+    ASSERT_GT(num_unmonitored, 0);
+    ASSERT_FALSE(filter.IsExcluded(on_ground[0], ground));
+    ASSERT_TRUE(filter.IsExcluded(on_ground[1], ground));
+
+    for (bool active_only : {true, false}) {
+        filter.SetActiveOnly(active_only);
+        spec.active_only = active_only;
+
+        ReferenceCollector ref(spec);
+        container->ReportAllContacts(&ref);
+        ref.data.SortByGroup(filter.GetNumGroups());
+
+        // Direct traversal of the contact lists
+        ContactData data;
+        container->CollectContacts(filter, data);
+        CompareData(data, ref.data, filter.GetNumGroups());
+
+        // Default implementation, through ReportAllContacts
+        ContactData data_default;
+        container->ChContactContainer::CollectContacts(filter, data_default);
+        CompareData(data_default, ref.data, filter.GetNumGroups());
+
+        // The excluded pairs are reported on the other side only; groups 0 to 2 have contacts (group 3 is empty)
+        bool ground_side = false;
+        bool body_side = false;
+        for (size_t i = 0; i < data.GetNumContacts(); i++) {
+            ASSERT_FALSE(data.objects[i] == ground && data.others[i] == on_ground[0]);
+            ASSERT_FALSE(data.objects[i] == on_ground[1] && data.others[i] == ground);
+            body_side = body_side || (data.objects[i] == on_ground[0] && data.others[i] == ground);
+            ground_side = ground_side || (data.objects[i] == ground && data.others[i] == on_ground[1]);
+        }
+        ASSERT_TRUE(body_side);
+        ASSERT_TRUE(ground_side);
+        for (int g = 0; g < 3; g++)
+            ASSERT_GT(data.GetNumContacts(g), 0u) << "group " << g;
+        ASSERT_EQ(data.GetNumContacts(3), 0u);
+    }
+
+    // An empty filter selects no contacts
+    ContactData data;
+    container->CollectContacts(ContactFilter(), data);
+    ASSERT_EQ(data.GetNumContacts(), 0u);
+}
+
+TEST(ChContactContainer, bulk_query_NSC) {
+    ChSystemNSC sys;
+    auto bodies = CreatePile(sys, ChMaterialSurface::NSC);
+    for (int i = 0; i < 150; i++)
+        sys.DoStepDynamics(2e-3);
+    TestQueries(sys, bodies);
+}
+
+TEST(ChContactContainer, bulk_query_SMC) {
+    ChSystemSMC sys;
+    auto bodies = CreatePile(sys, ChMaterialSurface::SMC);
+    for (int i = 0; i < 2000; i++)
+        sys.DoStepDynamics(1e-4);
+    TestQueries(sys, bodies);
+}
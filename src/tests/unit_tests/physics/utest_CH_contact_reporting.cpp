@@ -0,0 +1,197 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the batched contact reporting from the Bullet collision system:
+// a pile of bodies simulated with the batched (parallel) insertion into the NSC
+// and SMC contact containers must give the same contacts and the same motion as
+// with insertion of one contact at a time.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <tuple>
+
+#include "gtest/gtest.h"
+
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChContactContainerSMC.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+
+using namespace chrono;
+
+// Contact containers that bypass the batched insertion, adding one contact at a time.
+class ContactContainerNSC_single : public ChContactContainerNSC {
+  public:
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts) override {
+        ChContactContainer::AddContacts(mcontacts);
+    }
+};
+
+class ContactContainerSMC_single : public ChContactContainerSMC {
+  public:
+    virtual void AddContacts(const std::vector<collision::ChCollisionInfo>& mcontacts) override {
+        ChContactContainer::AddContacts(mcontacts);
+    }
+};
+
+// Material composition strategy that is not thread safe (counts its invocations).
+class CountingStrategy : public ChMaterialCompositionStrategy<float> {
+  public:
+    CountingStrategy(int& counter) : m_counter(counter) {}
+    virtual float CombineFriction(float a1, float a2) const override {
+        m_counter++;
+        return std::min<float>(a1, a2);
+    }
+
+  private:
+    int& m_counter;
+};
+
+// A contact, as reported by the container: the two objects, the contact points and the reaction force.
+typedef std::tuple<ChContactable*, ChContactable*, ChVector<>, ChVector<>, double, ChVector<>> ContactRecord;
+
+class ContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        contacts.push_back(ContactRecord(contactobjA, contactobjB, pA, pB, distance, react_forces));
+        return true;
+    }
+
+    std::vector<ContactRecord> contacts;
+};
+
+// Create a pile of spheres and boxes on a fixed box.
+static std::vector<std::shared_ptr<ChBody>> CreatePile(ChSystem& sys, ChMaterialSurface::ContactMethod method) {
+    std::vector<std::shared_ptr<ChBody>> bodies;
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false, method);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+    bodies.push_back(ground);
+
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 5; j++) {
+            for (int k = 0; k < 3; k++) {
+                std::shared_ptr<ChBody> body;
+                if ((i + j + k) % 2)
+                    body = chrono_types::make_shared<ChBodyEasySphere>(0.2, 1000, true, false, method);
+                else
+                    body = chrono_types::make_shared<ChBodyEasyBox>(0.35, 0.3, 0.35, 1000, true, false, method);
+                body->SetPos(ChVector<>(0.38 * i + 0.03 * k, 0.25 + 0.36 * k, 0.38 * j - 0.02 * k));
+                sys.AddBody(body);
+                bodies.push_back(body);
+            }
+        }
+    }
+
+    return bodies;
+}
+
+// Simulate the two systems and compare the contacts and the body states at each step.
+static void Compare(ChSystem& sys_batch,
+                    ChSystem& sys_single,
+                    std::vector<std::shared_ptr<ChBody>>& bodies_batch,
+                    std::vector<std::shared_ptr<ChBody>>& bodies_single,
+                    double step,
+                    int num_steps) {
+    CHOMPfunctions::SetNumThreads(4);
+
+    int max_contacts = 0;
+    for (int istep = 0; istep < num_steps; istep++) {
+        sys_batch.DoStepDynamics(step);
+        sys_single.DoStepDynamics(step);
+
+        ContactCollector batch;
+        ContactCollector single;
+        sys_batch.GetContactContainer()->ReportAllContacts(&batch);
+        sys_single.GetContactContainer()->ReportAllContacts(&single);
+
+        // Map the contactables of the second system to those of the first one
+        ASSERT_EQ(batch.contacts.size(), single.contacts.size()) << "step " << istep;
+        for (size_t k = 0; k < batch.contacts.size(); k++) {
+            auto& c1 = batch.contacts[k];
+            auto& c2 = single.contacts[k];
+            for (size_t ib = 0; ib < bodies_single.size(); ib++) {
+                if (std::get<0>(c2) == bodies_single[ib].get())
+                    std::get<0>(c2) = bodies_batch[ib].get();
+                if (std::get<1>(c2) == bodies_single[ib].get())
+                    std::get<1>(c2) = bodies_batch[ib].get();
+            }
+            ASSERT_TRUE(c1 == c2) << "step " << istep << " contact " << k;
+        }
+        max_contacts = std::max(max_contacts, (int)batch.contacts.size());
+
+        for (size_t ib = 0; ib < bodies_batch.size(); ib++) {
+            ASSERT_TRUE(bodies_batch[ib]->GetPos() == bodies_single[ib]->GetPos()) << "step " << istep;
+            ASSERT_TRUE(bodies_batch[ib]->GetRot() == bodies_single[ib]->GetRot()) << "step " << istep;
+        }
+    }
+
+    CHOMPfunctions::SetNumThreads(1);
+
+    // The pile must have settled in contact with the ground and between bodies
+    ASSERT_GT(max_contacts, (int)bodies_batch.size());
+}
+
+TEST(ChContactContainer, batched_reporting_NSC) {
+    ChSystemNSC sys_batch;
+    ChSystemNSC sys_single;
+    sys_single.SetContactContainer(chrono_types::make_shared<ContactContainerNSC_single>());
+    auto bodies_batch = CreatePile(sys_batch, ChMaterialSurface::NSC);
+    auto bodies_single = CreatePile(sys_single, ChMaterialSurface::NSC);
+
+    Compare(sys_batch, sys_single, bodies_batch, bodies_single, 2e-3, 200);
+}
+
+TEST(ChContactContainer, batched_reporting_SMC) {
+    ChSystemSMC sys_batch;
+    ChSystemSMC sys_single;
+    sys_single.SetContactContainer(chrono_types::make_shared<ContactContainerSMC_single>());
+    auto bodies_batch = CreatePile(sys_batch, ChMaterialSurface::SMC);
+    auto bodies_single = CreatePile(sys_single, ChMaterialSurface::SMC);
+
+    Compare(sys_batch, sys_single, bodies_batch, bodies_single, 1e-4, 3000);
+}
+
+TEST(ChContactContainer, batched_reporting_custom_strategy) {
+    // With a custom composition strategy, the contacts are reinitialized serially: the (non thread safe) strategy
+    // must be invoked exactly as many times as with the insertion of one contact at a time.
+    int count_batch = 0;
+    int count_single = 0;
+
+    ChSystemNSC sys_batch;
+    ChSystemNSC sys_single;
+    sys_batch.SetMaterialCompositionStrategy(
+        std::unique_ptr<ChMaterialCompositionStrategy<float>>(new CountingStrategy(count_batch)));
+    sys_single.SetMaterialCompositionStrategy(
+        std::unique_ptr<ChMaterialCompositionStrategy<float>>(new CountingStrategy(count_single)));
+    sys_single.SetContactContainer(chrono_types::make_shared<ContactContainerNSC_single>());
+    auto bodies_batch = CreatePile(sys_batch, ChMaterialSurface::NSC);
+    auto bodies_single = CreatePile(sys_single, ChMaterialSurface::NSC);
+
+    Compare(sys_batch, sys_single, bodies_batch, bodies_single, 2e-3, 200);
+
+    ASSERT_GT(count_single, 0);
+    ASSERT_EQ(count_batch, count_single);
+}
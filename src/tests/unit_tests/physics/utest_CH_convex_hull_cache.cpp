@@ -0,0 +1,258 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the on-disk convex hull cache: round trip of cache entries,
+// rejection of missing, truncated and empty entries, and cache hits, misses and
+// invalidation in the convex hull and JR convex decomposition computations.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCCollisionUtils.h"
+#include "chrono/collision/ChCConvexDecomposition.h"
+#include "chrono/collision/ChCConvexHullCache.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::geometry;
+
+static const std::string cache_dir = "convex_hull_cache_test";
+
+// Vertices of a box with given center and half-dimensions.
+static std::vector<ChVector<>> BoxPoints(const ChVector<>& center, const ChVector<>& hdim) {
+    std::vector<ChVector<>> points;
+    for (int i = 0; i < 8; i++)
+        points.push_back(center + ChVector<>((i & 1) ? hdim.x() : -hdim.x(), (i & 2) ? hdim.y() : -hdim.y(),
+                                             (i & 4) ? hdim.z() : -hdim.z()));
+    return points;
+}
+
+// Triangles of a box with given center and half-dimensions, outward oriented.
+static std::vector<ChVector<>> BoxTriangles(const ChVector<>& center, const ChVector<>& hdim) {
+    auto p = BoxPoints(center, hdim);
+    static const int faces[6][4] = {{0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+    std::vector<ChVector<>> triangles;
+    for (auto& f : faces) {
+        triangles.insert(triangles.end(), {p[f[0]], p[f[1]], p[f[2]]});
+        triangles.insert(triangles.end(), {p[f[0]], p[f[2]], p[f[3]]});
+    }
+    return triangles;
+}
+
+// Key of the cache entry of a convex hull (same as in ChConvexHullLibraryWrapper).
+static uint64_t HullKey(const std::vector<ChVector<>>& points) {
+    ChConvexHullCache::Hasher hasher;
+    hasher.Add(std::string("HULL"));
+    for (const auto& p : points)
+        hasher.Add(p);
+    return hasher.GetHash();
+}
+
+// Key of the cache entry of a JR convex decomposition with the parameters used in this test (same as in
+// ChConvexDecompositionJR).
+static uint64_t DecompositionKeyJR(const std::vector<ChVector<>>& triangles, unsigned int max_vertices) {
+    ChConvexHullCache::Hasher hasher;
+    for (const auto& v : triangles)
+        hasher.Add(v);
+    hasher.Add(std::string("JR"));
+    hasher.Add(0.0f);
+    hasher.Add(8u);
+    hasher.Add(max_vertices);
+    hasher.Add(0.1f);
+    hasher.Add(30.0f);
+    hasher.Add(0.1f);
+    hasher.Add(true);
+    hasher.Add(false);
+    return hasher.GetHash();
+}
+
+static int ComputeDecompositionJR(ChConvexDecompositionJR& decomposition, const std::vector<ChVector<>>& triangles) {
+    decomposition.Reset();
+    for (size_t i = 0; i < triangles.size(); i += 3)
+        decomposition.AddTriangle(triangles[i], triangles[i + 1], triangles[i + 2]);
+    return decomposition.ComputeConvexDecomposition();
+}
+
+class ConvexHullCacheTest : public ::testing::Test {
+  protected:
+    void SetUp() override { cache = chrono_types::make_shared<ChConvexHullCache>(cache_dir); }
+
+    void TearDown() override {
+        for (auto key : keys)
+            std::remove(cache->GetFilename(key).c_str());
+    }
+
+    // Register a key whose cache entry is removed before and after the test.
+    uint64_t Fresh(uint64_t key) {
+        std::remove(cache->GetFilename(key).c_str());
+        keys.push_back(key);
+        return key;
+    }
+
+    std::shared_ptr<ChConvexHullCache> cache;
+    std::vector<uint64_t> keys;
+};
+
+TEST_F(ConvexHullCacheTest, round_trip) {
+    uint64_t key = Fresh(0x0123456789abcdefULL);
+
+    std::vector<ChConvexHullCache::Hull> hulls(2);
+    hulls[0].points = BoxPoints(ChVector<>(1, 2, 3), ChVector<>(0.1, 0.2, 0.3));
+    hulls[0].triangles = {ChVector<int>(0, 1, 2), ChVector<int>(2, 1, 3)};
+    hulls[1].points = {ChVector<>(1.0 / 3, -1e-20, 1e20)};
+
+    std::vector<ChConvexHullCache::Hull> loaded;
+    ASSERT_FALSE(cache->Load(key, loaded));
+    ASSERT_TRUE(cache->Store(key, hulls));
+    ASSERT_TRUE(cache->Load(key, loaded));
+
+    ASSERT_EQ(loaded.size(), hulls.size());
+    for (size_t i = 0; i < hulls.size(); i++) {
+        ASSERT_EQ(loaded[i].points, hulls[i].points);
+        ASSERT_EQ(loaded[i].triangles, hulls[i].triangles);
+    }
+
+    // A different key misses, even if its file holds this entry
+    uint64_t other = Fresh(key + 1);
+    std::rename(cache->GetFilename(key).c_str(), cache->GetFilename(other).c_str());
+    ASSERT_FALSE(cache->Load(other, loaded));
+    ASSERT_FALSE(cache->Load(key, loaded));
+}
+
+TEST_F(ConvexHullCacheTest, invalid_entries) {
+    uint64_t key = Fresh(0xfedcba9876543210ULL);
+
+    std::vector<ChConvexHullCache::Hull> hulls(1);
+    hulls[0].points = BoxPoints(ChVector<>(0, 0, 0), ChVector<>(1, 1, 1));
+    ASSERT_TRUE(cache->Store(key, hulls));
+
+    // Truncated file
+    std::string filename = cache->GetFilename(key);
+    std::string content;
+    {
+        std::ifstream in(filename, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+        out.write(content.data(), content.size() - 8);
+    }
+    std::vector<ChConvexHullCache::Hull> loaded;
+    ASSERT_FALSE(cache->Load(key, loaded));
+    ASSERT_TRUE(loaded.empty());
+
+    // Entry with an empty hull (e.g. written by an older version after a failed computation)
+    hulls.resize(2);
+    ASSERT_TRUE(cache->Store(key, hulls));
+    ASSERT_FALSE(cache->Load(key, loaded));
+}
+
+TEST_F(ConvexHullCacheTest, convex_hull) {
+    auto points = BoxPoints(ChVector<>(0.5, 0, 0), ChVector<>(1, 0.5, 0.25));
+    points.push_back(ChVector<>(0.5, 0, 0));  // interior point
+    uint64_t key = Fresh(HullKey(points));
+
+    ChConvexHullLibraryWrapper lh;
+    lh.SetCache(cache);
+
+    // Miss: the hull is computed and stored
+    ChTriangleMeshConnected hull;
+    lh.ComputeHull(points, hull);
+    ASSERT_EQ(hull.getCoordsVertices().size(), 8u);
+    ASSERT_EQ(hull.getIndicesVertexes().size(), 12u);
+    std::vector<ChConvexHullCache::Hull> stored;
+    ASSERT_TRUE(cache->Load(key, stored));
+    ASSERT_EQ(stored.size(), 1u);
+    ASSERT_EQ(stored[0].points, hull.getCoordsVertices());
+    ASSERT_EQ(stored[0].triangles, hull.getIndicesVertexes());
+
+    // Hit: replace the entry with a marker hull, which must be returned as is
+    std::vector<ChConvexHullCache::Hull> marker(1);
+    marker[0].points = {ChVector<>(42, 0, 0), ChVector<>(0, 42, 0), ChVector<>(0, 0, 42)};
+    marker[0].triangles = {ChVector<int>(0, 1, 2)};
+    ASSERT_TRUE(cache->Store(key, marker));
+    ChTriangleMeshConnected cached;
+    lh.ComputeHull(points, cached);
+    ASSERT_EQ(cached.getCoordsVertices(), marker[0].points);
+    ASSERT_EQ(cached.getIndicesVertexes(), marker[0].triangles);
+
+    // Invalidation: moving one input point misses the entry
+    points.back() = ChVector<>(0.5, 0, 0.1);
+    Fresh(HullKey(points));
+    ChTriangleMeshConnected moved;
+    lh.ComputeHull(points, moved);
+    ASSERT_EQ(moved.getCoordsVertices().size(), 8u);
+}
+
+TEST_F(ConvexHullCacheTest, decomposition_JR) {
+    // Two separate boxes
+    auto triangles = BoxTriangles(ChVector<>(0, 0, 0), ChVector<>(1, 0.2, 0.2));
+    auto second = BoxTriangles(ChVector<>(0, 1, 0), ChVector<>(0.2, 0.5, 0.2));
+    triangles.insert(triangles.end(), second.begin(), second.end());
+    uint64_t key = Fresh(DecompositionKeyJR(triangles, 64));
+
+    ChConvexDecompositionJR decomposition;
+    decomposition.SetCache(cache);
+    decomposition.SetParameters(0.0f, 8, 64, 0.1f, 30.0f, 0.1f, true, false);
+
+    // Miss: the decomposition is computed and stored
+    int nhulls = ComputeDecompositionJR(decomposition, triangles);
+    ASSERT_GT(nhulls, 0);
+    ASSERT_FALSE(decomposition.IsFromCache());
+    std::vector<std::vector<ChVector<double>>> computed(nhulls);
+    for (int i = 0; i < nhulls; i++)
+        ASSERT_TRUE(decomposition.GetConvexHullResult(i, computed[i]));
+
+    std::vector<ChConvexHullCache::Hull> stored;
+    ASSERT_TRUE(cache->Load(key, stored));
+    ASSERT_EQ((int)stored.size(), nhulls);
+    for (auto& hull : stored)
+        ASSERT_GT(hull.points.size(), 0u);
+
+    // Hit: same input, from a new decomposition object
+    ChConvexDecompositionJR decomposition2;
+    decomposition2.SetCache(cache);
+    decomposition2.SetParameters(0.0f, 8, 64, 0.1f, 30.0f, 0.1f, true, false);
+    ASSERT_EQ(ComputeDecompositionJR(decomposition2, triangles), nhulls);
+    ASSERT_TRUE(decomposition2.IsFromCache());
+    ASSERT_EQ(decomposition2.GetHullCount(), (unsigned int)nhulls);
+    for (int i = 0; i < nhulls; i++) {
+        std::vector<ChVector<double>> points;
+        ASSERT_TRUE(decomposition2.GetConvexHullResult(i, points));
+        ASSERT_EQ(points, computed[i]);
+    }
+
+    // Invalidation: different parameters
+    Fresh(DecompositionKeyJR(triangles, 32));
+    decomposition2.SetParameters(0.0f, 8, 32, 0.1f, 30.0f, 0.1f, true, false);
+    ComputeDecompositionJR(decomposition2, triangles);
+    ASSERT_FALSE(decomposition2.IsFromCache());
+
+    // Invalidation: one moved vertex
+    decomposition2.SetParameters(0.0f, 8, 64, 0.1f, 30.0f, 0.1f, true, false);
+    auto moved = triangles;
+    moved[0] += ChVector<>(0, 0, 1e-6);
+    Fresh(DecompositionKeyJR(moved, 64));
+    ComputeDecompositionJR(decomposition2, moved);
+    ASSERT_FALSE(decomposition2.IsFromCache());
+
+    // An entry with an empty hull is not a hit
+    stored.emplace_back();
+    ASSERT_TRUE(cache->Store(key, stored));
+    ComputeDecompositionJR(decomposition2, triangles);
+    ASSERT_FALSE(decomposition2.IsFromCache());
+}
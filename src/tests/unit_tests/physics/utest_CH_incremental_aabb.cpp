@@ -0,0 +1,209 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the incremental AABB update of ChCollisionSystemBullet: on a
+// scene with fixed, sleeping, moved and rebuilt (edited in place) collision
+// models, the contacts found with incremental updates must be the same as with
+// full updates of all AABBs.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// A contact, identified by the two body identifiers and the contact points.
+typedef std::tuple<int, int, ChVector<>, ChVector<>> ContactRecord;
+
+class ContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        int idA = static_cast<ChBody*>(contactobjA)->GetIdentifier();
+        int idB = static_cast<ChBody*>(contactobjB)->GetIdentifier();
+        contacts.push_back(ContactRecord(idA, idB, pA, pB));
+        return true;
+    }
+
+    std::vector<ContactRecord> contacts;
+};
+
+static bool CompareContacts(const ContactRecord& a, const ContactRecord& b) {
+    if (std::get<0>(a) != std::get<0>(b))
+        return std::get<0>(a) < std::get<0>(b);
+    if (std::get<1>(a) != std::get<1>(b))
+        return std::get<1>(a) < std::get<1>(b);
+    for (int k = 0; k < 3; k++) {
+        if (std::get<2>(a)[k] != std::get<2>(b)[k])
+            return std::get<2>(a)[k] < std::get<2>(b)[k];
+    }
+    return false;
+}
+
+// Create the test scene: a fixed ground, a row of boxes resting on it (the first half sleeping) and a sphere that is
+// moved over the boxes. The pairs of inactive (fixed or sleeping) bodies are skipped by the narrowphase, so the
+// sleeping boxes are only in contact with the sphere.
+static std::vector<std::shared_ptr<ChBody>> CreateScene(ChSystemNSC& sys) {
+    std::vector<std::shared_ptr<ChBody>> bodies;
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(20, 1, 4, 1000, true);
+    ground->SetIdentifier(0);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+    bodies.push_back(ground);
+
+    for (int i = 0; i < 8; i++) {
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(0.8, 0.5, 0.8, 1000, true);
+        box->SetIdentifier(i + 1);
+        box->SetPos(ChVector<>(-8 + 2 * i, 0.24, 0));
+        box->SetRot(Q_from_AngY(0.1 * i));
+        box->SetSleeping(i < 4);
+        sys.AddBody(box);
+        bodies.push_back(box);
+    }
+
+    auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.4, 1000, true);
+    ball->SetIdentifier(100);
+    ball->SetPos(ChVector<>(-8, 0.6, 0));
+    sys.AddBody(ball);
+    bodies.push_back(ball);
+
+    return bodies;
+}
+
+// Run the collision detection and collect the contacts, sorted.
+static std::vector<ContactRecord> CollectContacts(ChSystemNSC& sys) {
+    sys.ComputeCollisions();
+    ContactCollector collector;
+    sys.GetContactContainer()->ReportAllContacts(&collector);
+    std::sort(collector.contacts.begin(), collector.contacts.end(), CompareContacts);
+    return collector.contacts;
+}
+
+TEST(ChCollisionSystemBullet, incremental_aabb) {
+    ChSystemNSC sys_full;
+    ChSystemNSC sys_incr;
+    auto bodies_full = CreateScene(sys_full);
+    auto bodies_incr = CreateScene(sys_incr);
+
+    auto cs_full = std::static_pointer_cast<ChCollisionSystemBullet>(sys_full.GetCollisionSystem());
+    auto cs_incr = std::static_pointer_cast<ChCollisionSystemBullet>(sys_incr.GetCollisionSystem());
+    ASSERT_FALSE(cs_full->GetIncrementalAabbUpdate());
+    cs_incr->SetIncrementalAabbUpdate(true);
+
+    for (auto sys : {&sys_full, &sys_incr}) {
+        sys->Setup();
+        sys->Update();
+    }
+
+    int num_ball_contacts[4] = {0, 0, 0, 0};
+    double max_dist_rebuilt = 0;
+    for (int pass = 0; pass < 40; pass++) {
+        for (auto bodies : {&bodies_full, &bodies_incr}) {
+            // The ball moves over the boxes (sleeping ones first)
+            bodies->back()->SetPos(ChVector<>(-8 + 0.4 * pass, 0.6, 0.2 * std::sin(0.5 * pass)));
+
+            // A sleeping box is edited in place before the ball reaches it: its collision model is rebuilt, larger,
+            // without moving the body
+            if (pass == 2) {
+                auto model = (*bodies)[2]->GetCollisionModel();
+                model->ClearModel();
+                model->AddBox(0.6, 0.26, 0.6);
+                model->BuildModel();
+            }
+
+            // An awake box is edited in place in the same way
+            if (pass == 10) {
+                auto model = (*bodies)[7]->GetCollisionModel();
+                model->ClearModel();
+                model->AddBox(0.6, 0.26, 0.6);
+                model->BuildModel();
+            }
+
+            // An awake box is moved
+            if (pass == 20)
+                (*bodies)[6]->SetPos((*bodies)[6]->GetPos() + ChVector<>(0.3, -0.02, 0));
+        }
+        sys_full.Update();
+        sys_incr.Update();
+
+        auto full = CollectContacts(sys_full);
+        auto incr = CollectContacts(sys_incr);
+
+        ASSERT_EQ(incr.size(), full.size()) << "pass " << pass;
+        for (size_t k = 0; k < full.size(); k++) {
+            ASSERT_EQ(std::get<0>(incr[k]), std::get<0>(full[k])) << "pass " << pass << " contact " << k;
+            ASSERT_EQ(std::get<1>(incr[k]), std::get<1>(full[k])) << "pass " << pass << " contact " << k;
+            ASSERT_NEAR((std::get<2>(incr[k]) - std::get<2>(full[k])).Length(), 0, 1e-6)
+                << "pass " << pass << " contact " << k;
+            ASSERT_NEAR((std::get<3>(incr[k]) - std::get<3>(full[k])).Length(), 0, 1e-6)
+                << "pass " << pass << " contact " << k;
+        }
+
+        // The awake boxes rest on the ground; the rebuilt box is larger, so it sinks into the ground
+        for (int i = 5; i <= 8; i++) {
+            ASSERT_TRUE(std::any_of(full.begin(), full.end(), [i](const ContactRecord& c) {
+                return (std::get<0>(c) == i && std::get<1>(c) == 0) || (std::get<0>(c) == 0 && std::get<1>(c) == i);
+            })) << "pass " << pass << " box " << i;
+        }
+        if (pass >= 10) {
+            double min_y = 1;
+            for (auto& c : full) {
+                if (std::get<0>(c) == 7 && std::get<1>(c) == 0)
+                    min_y = std::min(min_y, std::get<2>(c).y());
+                if (std::get<0>(c) == 0 && std::get<1>(c) == 7)
+                    min_y = std::min(min_y, std::get<3>(c).y());
+            }
+            ASSERT_LT(min_y, -0.01) << "pass " << pass;
+        }
+
+        // The sleeping boxes (whose AABBs are not updated incrementally) are only in contact with the ball; the
+        // contacts of the rebuilt one extend beyond its original size (half length 0.4)
+        for (auto& c : full) {
+            int idA = std::get<0>(c);
+            int idB = std::get<1>(c);
+            for (int i = 1; i <= 4; i++) {
+                if (idA != i && idB != i)
+                    continue;
+                int other = (idA == i) ? idB : idA;
+                ASSERT_EQ(other, 100) << "pass " << pass << " box " << i;
+                num_ball_contacts[i - 1]++;
+                if (i == 2) {
+                    ChVector<> p = (idA == i) ? std::get<2>(c) : std::get<3>(c);
+                    ChVector<> p_loc = bodies_full[2]->TransformPointParentToLocal(p);
+                    max_dist_rebuilt = std::max({max_dist_rebuilt, std::abs(p_loc.x()), std::abs(p_loc.z())});
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < 4; i++)
+        ASSERT_GT(num_ball_contacts[i], 0) << "box " << i + 1;
+    ASSERT_GT(max_dist_rebuilt, 0.45);
+}
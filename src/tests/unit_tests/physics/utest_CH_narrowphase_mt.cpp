@@ -0,0 +1,171 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multithreaded narrowphase of ChCollisionSystemBullet: on a
+// scene with compound shapes, GImpact meshes wrapped in compounds and a static
+// triangle mesh, the threaded dispatch must produce the same contact set as the
+// serial dispatch.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/collision/ChCModelBullet.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/geometry/ChTriangleMeshSoup.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::geometry;
+
+// Bumpy square patch of size 'size' in the XZ plane, as a list of triangles.
+template <class MESH>
+static std::shared_ptr<MESH> CreatePatch(double size, int n) {
+    auto mesh = chrono_types::make_shared<MESH>();
+    auto vertex = [size, n](int i, int j) {
+        double x = size * (double(i) / n - 0.5);
+        double z = size * (double(j) / n - 0.5);
+        return ChVector<>(x, 0.1 * std::sin(3 * x) * std::cos(2 * z), z);
+    };
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            mesh->addTriangle(vertex(i, j), vertex(i, j + 1), vertex(i + 1, j + 1));
+            mesh->addTriangle(vertex(i, j), vertex(i + 1, j + 1), vertex(i + 1, j));
+        }
+    }
+    return mesh;
+}
+
+// A contact, identified by the two body identifiers and the contact points.
+typedef std::tuple<int, int, double, double, double, double, double, double, double> ContactRecord;
+
+class ContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        int idA = static_cast<ChBody*>(contactobjA)->GetIdentifier();
+        int idB = static_cast<ChBody*>(contactobjB)->GetIdentifier();
+        contacts.push_back(ContactRecord(idA, idB, pA.x(), pA.y(), pA.z(), pB.x(), pB.y(), pB.z(), distance));
+        return true;
+    }
+
+    std::vector<ContactRecord> contacts;
+};
+
+// Create the test scene: a static BVH mesh ground, bodies with compounds of convex shapes, and bodies with GImpact
+// meshes placed off-center (hence wrapped in compound shapes), all in contact. Return the identifiers of the bodies
+// with GImpact meshes.
+static std::vector<int> CreateScene(ChSystemNSC& sys) {
+    ChCollisionModel::SetDefaultSuggestedEnvelope(0.02);
+    ChCollisionModel::SetDefaultSuggestedMargin(0.01);
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetIdentifier(0);
+    ground->SetBodyFixed(true);
+    ground->GetCollisionModel()->ClearModel();
+    ground->GetCollisionModel()->AddTriangleMesh(CreatePatch<ChTriangleMeshSoup>(8, 16), true, false);
+    ground->GetCollisionModel()->BuildModel();
+    ground->SetCollide(true);
+    sys.AddBody(ground);
+
+    std::vector<int> gimpact_ids;
+    int id = 1;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            auto body = chrono_types::make_shared<ChBody>();
+            body->SetIdentifier(id++);
+            body->SetPos(ChVector<>(-3 + 1.6 * i, 0.12, -3 + 1.6 * j));
+            body->SetRot(Q_from_AngY(0.3 * (i + j)));
+            body->GetCollisionModel()->ClearModel();
+            if ((i + j) % 2 == 0) {
+                // Compound of convex shapes
+                body->GetCollisionModel()->AddBox(0.4, 0.1, 0.3, ChVector<>(0, 0, 0));
+                body->GetCollisionModel()->AddSphere(0.2, ChVector<>(0.5, 0.05, 0));
+                body->GetCollisionModel()->AddCylinder(0.15, 0.15, 0.2, ChVector<>(-0.5, 0.05, 0.2));
+            } else {
+                // GImpact mesh, off-center, and a sphere reaching over the neighbor body
+                std::static_pointer_cast<ChModelBullet>(body->GetCollisionModel())
+                    ->AddTriangleMeshConcave(CreatePatch<ChTriangleMeshConnected>(1.2, 6), ChVector<>(0.1, -0.1, 0),
+                                             ChMatrix33<>(1));
+                body->GetCollisionModel()->AddSphere(0.35, ChVector<>(0.8, 0.2, 0));
+                gimpact_ids.push_back(body->GetIdentifier());
+            }
+            body->GetCollisionModel()->BuildModel();
+            body->SetCollide(true);
+            sys.AddBody(body);
+        }
+    }
+
+    return gimpact_ids;
+}
+
+// Run the collision detection and collect the contacts, sorted.
+static std::vector<ContactRecord> CollectContacts(ChSystemNSC& sys) {
+    sys.ComputeCollisions();
+    ContactCollector collector;
+    sys.GetContactContainer()->ReportAllContacts(&collector);
+    std::sort(collector.contacts.begin(), collector.contacts.end());
+    return collector.contacts;
+}
+
+TEST(ChCollisionSystemBullet, narrowphase_mt_compound) {
+    ChSystemNSC sys_serial;
+    ChSystemNSC sys_mt;
+    auto gimpact_ids = CreateScene(sys_serial);
+    CreateScene(sys_mt);
+    std::static_pointer_cast<ChCollisionSystemBullet>(sys_mt.GetCollisionSystem())->SetNumThreadsNarrowphase(4);
+    sys_serial.Setup();
+    sys_serial.Update();
+    sys_mt.Setup();
+    sys_mt.Update();
+
+    // Repeat the collision detection on a few configurations, so that persistent manifolds are also compared
+    for (int pass = 0; pass < 3; pass++) {
+        auto serial = CollectContacts(sys_serial);
+        auto mt = CollectContacts(sys_mt);
+
+        ASSERT_EQ(mt.size(), serial.size()) << "pass " << pass;
+        for (size_t k = 0; k < serial.size(); k++)
+            ASSERT_TRUE(mt[k] == serial[k]) << "pass " << pass << " contact " << k;
+
+        // The GImpact compounds must be in contact with the ground
+        int num_gimpact = 0;
+        for (auto& c : serial) {
+            int other = std::get<0>(c) == 0 ? std::get<1>(c) : (std::get<1>(c) == 0 ? std::get<0>(c) : -1);
+            if (std::find(gimpact_ids.begin(), gimpact_ids.end(), other) != gimpact_ids.end())
+                num_gimpact++;
+        }
+        ASSERT_GT(num_gimpact, 0) << "pass " << pass;
+
+        // Move all bodies down, to change the contacts
+        for (auto sys : {&sys_serial, &sys_mt}) {
+            for (auto body : sys->Get_bodylist()) {
+                if (!body->GetBodyFixed())
+                    body->SetPos(body->GetPos() - ChVector<>(0, 0.02, 0));
+            }
+            sys->Update();
+        }
+    }
+}
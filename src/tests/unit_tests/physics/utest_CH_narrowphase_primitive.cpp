@@ -0,0 +1,407 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the narrowphase of the primitive collision system
+// (ChNarrowphasePrimitive): contact normal, depth and points for each supported
+// shape pair, handling of empty collision models in ChCollisionSystemPrimitive,
+// and speculative contacts (no tunneling at large steps, no impulse from
+// contacts that do not close within the step).
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCCollisionSystemPrimitive.h"
+#include "chrono/collision/ChCNarrowphasePrimitive.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+typedef ChNarrowphasePrimitive::Contact Contact;
+
+static const double tol = 1e-9;
+static const double tol_mpr = 1e-3;
+
+static ChPrimitiveShape MakeShape(ChPrimitiveShape::Type type,
+                                  const ChVector<>& dims,
+                                  const ChVector<>& pos,
+                                  const ChQuaternion<>& rot = QUNIT) {
+    ChPrimitiveShape s;
+    s.type = type;
+    s.dims = dims;
+    s.pos = pos;
+    s.rot = ChMatrix33<>(rot);
+    return s;
+}
+
+static void CheckVector(const ChVector<>& v, const ChVector<>& expected, double eps) {
+    ASSERT_NEAR(v.x(), expected.x(), eps);
+    ASSERT_NEAR(v.y(), expected.y(), eps);
+    ASSERT_NEAR(v.z(), expected.z(), eps);
+}
+
+// Check the normal and depth of a contact, and the consistency of its points with them.
+static void CheckContact(const Contact& c, const ChVector<>& normal, double distance, double eps) {
+    CheckVector(c.normal, normal, eps);
+    ASSERT_NEAR(c.distance, distance, eps);
+    ASSERT_NEAR(c.normal.Dot(c.pB - c.pA), c.distance, eps);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(ChNarrowphasePrimitive, sphere_sphere) {
+    auto A = MakeShape(ChPrimitiveShape::SPHERE, ChVector<>(1, 0, 0), ChVector<>(0, 0, 0));
+    auto B = MakeShape(ChPrimitiveShape::SPHERE, ChVector<>(0.5, 0, 0), ChVector<>(1.4, 0, 0));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(1, 0, 0), -0.1, tol);
+    CheckVector(ct[0].pA, ChVector<>(1, 0, 0), tol);
+    CheckVector(ct[0].pB, ChVector<>(0.9, 0, 0), tol);
+
+    // Separated pair: reported only within the separation distance
+    B.pos = ChVector<>(1.55, 0, 0);
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0.01, ct), 0);
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0.1, ct), 1);
+    CheckContact(ct[0], ChVector<>(1, 0, 0), 0.05, tol);
+}
+
+TEST(ChNarrowphasePrimitive, sphere_box) {
+    auto S = MakeShape(ChPrimitiveShape::SPHERE, ChVector<>(0.5, 0, 0), ChVector<>(0.2, 0.9, 0.3));
+    auto B = MakeShape(ChPrimitiveShape::BOX, ChVector<>(1, 0.5, 1), ChVector<>(0, 0, 0));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(S, B, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, -1, 0), -0.1, tol);
+    CheckVector(ct[0].pA, ChVector<>(0.2, 0.4, 0.3), tol);
+    CheckVector(ct[0].pB, ChVector<>(0.2, 0.5, 0.3), tol);
+
+    // Swapped order: normal reversed, points swapped
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(B, S, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, 1, 0), -0.1, tol);
+    CheckVector(ct[0].pA, ChVector<>(0.2, 0.5, 0.3), tol);
+    CheckVector(ct[0].pB, ChVector<>(0.2, 0.4, 0.3), tol);
+}
+
+TEST(ChNarrowphasePrimitive, sphere_capsule) {
+    auto S = MakeShape(ChPrimitiveShape::SPHERE, ChVector<>(0.5, 0, 0), ChVector<>(0.7, 0.5, 0));
+    auto C = MakeShape(ChPrimitiveShape::CAPSULE, ChVector<>(0.3, 1, 0), ChVector<>(0, 0, 0));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    // Against the capsule side
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(S, C, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(-1, 0, 0), -0.1, tol);
+    CheckVector(ct[0].pA, ChVector<>(0.2, 0.5, 0), tol);
+    CheckVector(ct[0].pB, ChVector<>(0.3, 0.5, 0), tol);
+
+    // Against the capsule end
+    S.pos = ChVector<>(0, 1.7, 0);
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(S, C, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, -1, 0), -0.1, tol);
+    CheckVector(ct[0].pB, ChVector<>(0, 1.3, 0), tol);
+}
+
+TEST(ChNarrowphasePrimitive, sphere_cylinder) {
+    auto S = MakeShape(ChPrimitiveShape::SPHERE, ChVector<>(0.3, 0, 0), ChVector<>(0.1, 0.7, 0));
+    auto C = MakeShape(ChPrimitiveShape::CYLINDER, ChVector<>(0.5, 0.5, 0), ChVector<>(0, 0, 0));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    // Against the cap
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(S, C, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, -1, 0), -0.1, tol);
+    CheckVector(ct[0].pA, ChVector<>(0.1, 0.4, 0), tol);
+    CheckVector(ct[0].pB, ChVector<>(0.1, 0.5, 0), tol);
+
+    // Against the side
+    S.pos = ChVector<>(0, 0.2, 0.7);
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(S, C, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, 0, -1), -0.1, tol);
+    CheckVector(ct[0].pB, ChVector<>(0, 0.2, 0.5), tol);
+}
+
+TEST(ChNarrowphasePrimitive, capsule_capsule) {
+    // Crossed capsules (B along X)
+    auto A = MakeShape(ChPrimitiveShape::CAPSULE, ChVector<>(0.2, 1, 0), ChVector<>(0, 0, 0));
+    auto B = MakeShape(ChPrimitiveShape::CAPSULE, ChVector<>(0.2, 1, 0), ChVector<>(0, 0.3, 0.35),
+                       Q_from_AngZ(CH_C_PI_2));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, 0, 1), -0.05, tol);
+    CheckVector(ct[0].pA, ChVector<>(0, 0.3, 0.2), tol);
+    CheckVector(ct[0].pB, ChVector<>(0, 0.3, 0.15), tol);
+
+    // Parallel capsules, overlapping on y in [-0.5, 1]: two contacts at the ends of the overlap
+    B = MakeShape(ChPrimitiveShape::CAPSULE, ChVector<>(0.2, 0.75, 0), ChVector<>(0.35, 0.25, 0));
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0, ct), 2);
+    for (int i = 0; i < 2; i++)
+        CheckContact(ct[i], ChVector<>(1, 0, 0), -0.05, tol);
+    ASSERT_NEAR(std::min(ct[0].pA.y(), ct[1].pA.y()), -0.5, tol);
+    ASSERT_NEAR(std::max(ct[0].pA.y(), ct[1].pA.y()), 1, tol);
+}
+
+TEST(ChNarrowphasePrimitive, capsule_box) {
+    // Capsule along X lying on the top face of the box: one contact per end sphere
+    auto C = MakeShape(ChPrimitiveShape::CAPSULE, ChVector<>(0.2, 0.5, 0), ChVector<>(0, 0.65, 0),
+                       Q_from_AngZ(CH_C_PI_2));
+    auto B = MakeShape(ChPrimitiveShape::BOX, ChVector<>(1, 0.5, 1), ChVector<>(0, 0, 0));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(C, B, 0, ct), 2);
+    for (int i = 0; i < 2; i++) {
+        CheckContact(ct[i], ChVector<>(0, -1, 0), -0.05, tol);
+        ASSERT_NEAR(std::abs(ct[i].pA.x()), 0.5, tol);
+        ASSERT_NEAR(ct[i].pA.y(), 0.45, tol);
+        ASSERT_NEAR(ct[i].pB.y(), 0.5, tol);
+    }
+
+    // Capsule crossing over the box edge along Z, with both end spheres clear of the box:
+    // the only contact is at the segment point closest to the edge
+    ChVector<> n45(std::sqrt(0.5), std::sqrt(0.5), 0);
+    C = MakeShape(ChPrimitiveShape::CAPSULE, ChVector<>(0.2, 0.5, 0), ChVector<>(1, 0.5, 0) + n45 * 0.15,
+                  Q_from_AngZ(CH_C_PI_4));
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(B, C, 0, ct), 1);
+    CheckContact(ct[0], n45, -0.05, 1e-6);
+    CheckVector(ct[0].pA, ChVector<>(1, 0.5, 0), 1e-6);
+    CheckVector(ct[0].pB, ChVector<>(1, 0.5, 0) - n45 * 0.05, 1e-6);
+}
+
+TEST(ChNarrowphasePrimitive, capsule_cylinder) {
+    // Vertical capsule standing on the cylinder cap
+    auto C = MakeShape(ChPrimitiveShape::CAPSULE, ChVector<>(0.2, 0.5, 0), ChVector<>(0.1, 1.15, 0));
+    auto Y = MakeShape(ChPrimitiveShape::CYLINDER, ChVector<>(0.5, 0.5, 0), ChVector<>(0, 0, 0));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(C, Y, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, -1, 0), -0.05, tol);
+    CheckVector(ct[0].pA, ChVector<>(0.1, 0.45, 0), tol);
+    CheckVector(ct[0].pB, ChVector<>(0.1, 0.5, 0), tol);
+
+    // Capsule parallel to the cylinder, against its side: one contact per end sphere
+    C = MakeShape(ChPrimitiveShape::CAPSULE, ChVector<>(0.2, 0.3, 0), ChVector<>(0.65, 0, 0));
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(C, Y, 0, ct), 2);
+    for (int i = 0; i < 2; i++) {
+        CheckContact(ct[i], ChVector<>(-1, 0, 0), -0.05, tol);
+        ASSERT_NEAR(std::abs(ct[i].pB.y()), 0.3, tol);
+    }
+}
+
+TEST(ChNarrowphasePrimitive, box_box_face_face) {
+    // Cube resting on a larger box, rotated about the vertical: four contacts at the cube corners
+    auto A = MakeShape(ChPrimitiveShape::BOX, ChVector<>(1, 0.5, 1), ChVector<>(0, 0, 0));
+    auto B = MakeShape(ChPrimitiveShape::BOX, ChVector<>(0.5, 0.5, 0.5), ChVector<>(0.1, 0.95, -0.2),
+                       Q_from_AngY(0.3));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0, ct), 4);
+    ChMatrix33<> R(Q_from_AngY(0.3));
+    for (int i = 0; i < 4; i++) {
+        CheckContact(ct[i], ChVector<>(0, 1, 0), -0.05, tol);
+        ASSERT_NEAR(ct[i].pA.y(), 0.5, tol);
+        ASSERT_NEAR(ct[i].pB.y(), 0.45, tol);
+        // Contact points at the corners of the cube bottom face
+        ChVector<> loc = R.transpose() * (ct[i].pB - B.pos);
+        ASSERT_NEAR(std::abs(loc.x()), 0.5, tol);
+        ASSERT_NEAR(std::abs(loc.z()), 0.5, tol);
+    }
+
+    // Cube partly off the box edge: the face intersection is clipped to the box face
+    B = MakeShape(ChPrimitiveShape::BOX, ChVector<>(0.5, 0.5, 0.5), ChVector<>(1.2, 0.95, 0));
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0, ct), 4);
+    for (int i = 0; i < 4; i++) {
+        CheckContact(ct[i], ChVector<>(0, 1, 0), -0.05, tol);
+        ASSERT_GE(ct[i].pA.x(), 0.7 - tol);
+        ASSERT_LE(ct[i].pA.x(), 1 + tol);
+        ASSERT_NEAR(std::abs(ct[i].pA.z()), 0.5, tol);
+    }
+}
+
+TEST(ChNarrowphasePrimitive, box_box_edge_edge) {
+    // Two cubes rotated by 45 degrees about orthogonal axes, touching along crossed edges:
+    // the top edge of A is along Z at y = sqrt(2), the bottom edge of B is along X.
+    double s2 = std::sqrt(2.0);
+    auto A = MakeShape(ChPrimitiveShape::BOX, ChVector<>(1, 1, 1), ChVector<>(0, 0, 0), Q_from_AngZ(CH_C_PI_4));
+    auto B = MakeShape(ChPrimitiveShape::BOX, ChVector<>(1, 1, 1), ChVector<>(0.1, 2 * s2 - 0.1, 0.2),
+                       Q_from_AngX(CH_C_PI_4));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, 1, 0), -0.1, tol);
+    CheckVector(ct[0].pA, ChVector<>(0, s2, 0.2), tol);
+    CheckVector(ct[0].pB, ChVector<>(0, s2 - 0.1, 0.2), tol);
+}
+
+TEST(ChNarrowphasePrimitive, box_cylinder) {
+    auto B = MakeShape(ChPrimitiveShape::BOX, ChVector<>(1, 0.5, 1), ChVector<>(0, 0, 0));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    // Upright cylinder with its cap on the top face: contacts on the cap rim
+    auto Y = MakeShape(ChPrimitiveShape::CYLINDER, ChVector<>(0.3, 0.2, 0), ChVector<>(0.1, 0.65, 0));
+    int n = ChNarrowphasePrimitive::Collide(B, Y, 0, ct);
+    ASSERT_GE(n, 3);
+    for (int i = 0; i < n; i++) {
+        CheckContact(ct[i], ChVector<>(0, 1, 0), -0.05, tol_mpr);
+        ASSERT_NEAR(ct[i].pA.y(), 0.5, tol_mpr);
+        ASSERT_NEAR(ct[i].pB.y(), 0.45, tol_mpr);
+        ASSERT_NEAR((ct[i].pB - Y.pos).x() * (ct[i].pB - Y.pos).x() + (ct[i].pB - Y.pos).z() * (ct[i].pB - Y.pos).z(),
+                    0.09, tol_mpr);
+    }
+
+    // Cylinder along X with its side on the top face: contacts at the two ends of the generator line
+    Y = MakeShape(ChPrimitiveShape::CYLINDER, ChVector<>(0.3, 0.4, 0), ChVector<>(0, 0.75, 0.2),
+                  Q_from_AngZ(CH_C_PI_2));
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(B, Y, 0, ct), 2);
+    for (int i = 0; i < 2; i++) {
+        CheckContact(ct[i], ChVector<>(0, 1, 0), -0.05, tol_mpr);
+        ASSERT_NEAR(std::abs(ct[i].pB.x()), 0.4, tol_mpr);
+        ASSERT_NEAR(ct[i].pB.z(), 0.2, tol_mpr);
+    }
+
+    // Swapped order: single-shape dispatch must flip the contacts
+    n = ChNarrowphasePrimitive::Collide(Y, B, 0, ct);
+    ASSERT_EQ(n, 2);
+    for (int i = 0; i < 2; i++)
+        CheckContact(ct[i], ChVector<>(0, -1, 0), -0.05, tol_mpr);
+}
+
+TEST(ChNarrowphasePrimitive, cylinder_cylinder) {
+    // Coaxial cylinders, cap on cap
+    auto A = MakeShape(ChPrimitiveShape::CYLINDER, ChVector<>(0.5, 0.5, 0), ChVector<>(0, 0, 0));
+    auto B = MakeShape(ChPrimitiveShape::CYLINDER, ChVector<>(0.3, 0.5, 0), ChVector<>(0.1, 0.95, 0));
+    Contact ct[ChNarrowphasePrimitive::MAX_CONTACTS];
+
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(0, 1, 0), -0.05, tol_mpr);
+    ASSERT_NEAR(ct[0].pA.y(), 0.5, tol_mpr);
+    ASSERT_NEAR(ct[0].pB.y(), 0.45, tol_mpr);
+
+    // Parallel cylinders side by side
+    B.pos = ChVector<>(0.75, 0, 0);
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0, ct), 1);
+    CheckContact(ct[0], ChVector<>(1, 0, 0), -0.05, tol_mpr);
+    ASSERT_NEAR(ct[0].pA.x(), 0.5, tol_mpr);
+    ASSERT_NEAR(ct[0].pB.x(), 0.45, tol_mpr);
+
+    // Separated cylinders
+    B.pos = ChVector<>(0.9, 0, 0);
+    ASSERT_EQ(ChNarrowphasePrimitive::Collide(A, B, 0.01, ct), 0);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(ChCollisionSystemPrimitive, empty_model) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystem(chrono_types::make_shared<ChCollisionSystemPrimitive>());
+    sys.GetCollisionSystem()->SetSpeculativeContacts(true);
+
+    // Moving body with collision enabled but no shapes
+    auto empty = chrono_types::make_shared<ChBody>(chrono_types::make_shared<ChModelPrimitive>());
+    empty->SetPos(ChVector<>(0, 1, 0));
+    empty->SetPos_dt(ChVector<>(1, 0, 0));
+    empty->SetWvel_par(ChVector<>(0, 0, 5));
+    empty->GetCollisionModel()->ClearModel();
+    empty->GetCollisionModel()->BuildModel();
+    empty->SetCollide(true);
+    sys.AddBody(empty);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false, ChMaterialSurface::NSC,
+                                                           chrono_types::make_shared<ChModelPrimitive>());
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.5, 1000, true, false, ChMaterialSurface::NSC,
+                                                            chrono_types::make_shared<ChModelPrimitive>());
+    ball->SetPos(ChVector<>(0, 0.95, 0));
+    sys.AddBody(ball);
+
+    for (int i = 0; i < 10; i++)
+        sys.DoStepDynamics(1e-2);
+
+    ChVector<> bbmin;
+    ChVector<> bbmax;
+    empty->GetCollisionModel()->GetAABB(bbmin, bbmax);
+    ASSERT_TRUE(std::isfinite(bbmin.Length()) && std::isfinite(bbmax.Length()));
+    ASSERT_EQ(bbmin, bbmax);
+
+    // Only the ball-ground contact is generated
+    auto cs = std::static_pointer_cast<ChCollisionSystemPrimitive>(sys.GetCollisionSystem());
+    ASSERT_EQ(cs->GetNumBroadphasePairs(), 1);
+    ASSERT_EQ(sys.GetNcontacts(), 1);
+    ASSERT_TRUE(std::isfinite(ball->GetPos().Length()));
+}
+
+// Drop a fast small ball on a thin fixed plate, with a large step, and return the final ball height.
+static double DropOnThinPlate(bool speculative) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystem(chrono_types::make_shared<ChCollisionSystemPrimitive>());
+    sys.GetCollisionSystem()->SetSpeculativeContacts(speculative);
+
+    auto plate = chrono_types::make_shared<ChBodyEasyBox>(2, 0.02, 2, 1000, true, false, ChMaterialSurface::NSC,
+                                                          chrono_types::make_shared<ChModelPrimitive>());
+    plate->SetBodyFixed(true);
+    sys.AddBody(plate);
+
+    auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.05, 1000, true, false, ChMaterialSurface::NSC,
+                                                            chrono_types::make_shared<ChModelPrimitive>());
+    ball->SetPos(ChVector<>(0, 0.5, 0));
+    ball->SetPos_dt(ChVector<>(0, -100, 0));
+    sys.AddBody(ball);
+
+    // The ball travels 1 m per step, much more than the plate thickness and the collision envelopes
+    for (int i = 0; i < 10; i++)
+        sys.DoStepDynamics(1e-2);
+
+    return ball->GetPos().y();
+}
+
+TEST(ChCollisionSystemPrimitive, speculative_no_tunneling) {
+    ASSERT_LT(DropOnThinPlate(false), -0.5);
+
+    double y = DropOnThinPlate(true);
+    ASSERT_GT(y, 0.01);
+    ASSERT_LT(y, 0.07);
+}
+
+TEST(ChCollisionSystemPrimitive, speculative_no_impulse) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, 0, 0));
+    sys.SetCollisionSystem(chrono_types::make_shared<ChCollisionSystemPrimitive>());
+    sys.GetCollisionSystem()->SetSpeculativeContacts(true);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false, ChMaterialSurface::NSC,
+                                                           chrono_types::make_shared<ChModelPrimitive>());
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    // Ball spinning above the ground: the points of its bounding box sweep past the gap over a step, but the ball
+    // surface never approaches the ground
+    auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.5, 1000, true, false, ChMaterialSurface::NSC,
+                                                            chrono_types::make_shared<ChModelPrimitive>());
+    ball->SetPos(ChVector<>(0, 0.6, 0));
+    ball->SetPos_dt(ChVector<>(0.5, 0, 0));
+    ball->SetWvel_par(ChVector<>(0, 0, 20));
+    sys.AddBody(ball);
+
+    for (int i = 0; i < 10; i++) {
+        sys.DoStepDynamics(0.1);
+        ASSERT_EQ(sys.GetNcontacts(), 1) << "step " << i;
+        ASSERT_NEAR(ball->GetContactForce().Length(), 0, 1e-12) << "step " << i;
+        CheckVector(ball->GetPos_dt(), ChVector<>(0.5, 0, 0), 1e-12);
+        CheckVector(ball->GetWvel_par(), ChVector<>(0, 0, 20), 1e-12);
+        ASSERT_NEAR(ball->GetPos().y(), 0.6, 1e-12);
+    }
+}
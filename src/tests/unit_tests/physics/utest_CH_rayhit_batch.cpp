@@ -0,0 +1,123 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChCollisionSystemBullet::RayHitBatch: a batch of rays cast with
+// several threads on a scene with GImpact meshes and convex shapes must give the
+// same results as sequential RayHit queries.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCModelBullet.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::geometry;
+
+// Bumpy square patch of size 'size', as a triangle mesh in the XZ plane.
+static std::shared_ptr<ChTriangleMeshConnected> CreatePatch(double size, int n) {
+    auto mesh = chrono_types::make_shared<ChTriangleMeshConnected>();
+    auto& vertices = mesh->getCoordsVertices();
+    auto& faces = mesh->getIndicesVertexes();
+    for (int i = 0; i <= n; i++) {
+        for (int j = 0; j <= n; j++) {
+            double x = size * (double(i) / n - 0.5);
+            double z = size * (double(j) / n - 0.5);
+            vertices.push_back(ChVector<>(x, 0.2 * std::sin(3 * x) * std::cos(2 * z), z));
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int v = i * (n + 1) + j;
+            faces.push_back(ChVector<int>(v, v + 1, v + n + 2));
+            faces.push_back(ChVector<int>(v, v + n + 2, v + n + 1));
+        }
+    }
+    return mesh;
+}
+
+TEST(ChCollisionSystemBullet, rayhit_batch_gimpact) {
+    ChSystemNSC sys;
+
+    // GImpact meshes, overlapping in the XZ plane at different heights
+    for (int k = 0; k < 3; k++) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector<>(-1 + k, 0.3 * k, 0.5 * k));
+        body->SetRot(Q_from_AngY(0.4 * k));
+        body->SetBodyFixed(true);
+        body->GetCollisionModel()->ClearModel();
+        std::static_pointer_cast<ChModelBullet>(body->GetCollisionModel())
+            ->AddTriangleMeshConcave(CreatePatch(3, 12), VNULL, ChMatrix33<>(1));
+        body->GetCollisionModel()->BuildModel();
+        body->SetCollide(true);
+        sys.AddBody(body);
+    }
+
+    // Convex shapes
+    auto box = chrono_types::make_shared<ChBodyEasyBox>(1, 0.5, 1, 1000, true, false);
+    box->SetPos(ChVector<>(0.5, 1.5, 0.5));
+    box->SetBodyFixed(true);
+    sys.AddBody(box);
+
+    auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.6, 1000, true, false);
+    sphere->SetPos(ChVector<>(-1, 1, -0.5));
+    sphere->SetBodyFixed(true);
+    sys.AddBody(sphere);
+
+    sys.DoStepDynamics(1e-3);
+
+    // Grid of vertical rays, plus slanted rays
+    std::vector<ChVector<>> from;
+    std::vector<ChVector<>> to;
+    int n = 40;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double x = 6 * (double(i) / (n - 1) - 0.5);
+            double z = 6 * (double(j) / (n - 1) - 0.5);
+            from.push_back(ChVector<>(x, 5, z));
+            to.push_back(ChVector<>(x, -5, z));
+            from.push_back(ChVector<>(x, 5, z));
+            to.push_back(ChVector<>(-x, -5, 0.5 * z));
+        }
+    }
+    int num_rays = (int)from.size();
+
+    std::vector<ChCollisionSystem::ChRayhitResult> results(num_rays);
+    CHOMPfunctions::SetNumThreads(4);
+    sys.GetCollisionSystem()->RayHitBatch(num_rays, from.data(), to.data(), results.data());
+    CHOMPfunctions::SetNumThreads(1);
+
+    int num_mesh_hits = 0;
+    for (int i = 0; i < num_rays; i++) {
+        ChCollisionSystem::ChRayhitResult expected;
+        sys.GetCollisionSystem()->RayHit(from[i], to[i], expected);
+        ASSERT_EQ(results[i].hit, expected.hit) << "ray " << i;
+        if (!expected.hit)
+            continue;
+        ASSERT_EQ(results[i].hitModel, expected.hitModel) << "ray " << i;
+        ASSERT_NEAR(results[i].dist_factor, expected.dist_factor, 1e-6) << "ray " << i;
+        ASSERT_NEAR((results[i].abs_hitPoint - expected.abs_hitPoint).Length(), 0, 1e-5) << "ray " << i;
+        if (expected.hitModel != box->GetCollisionModel().get() &&
+            expected.hitModel != sphere->GetCollisionModel().get())
+            num_mesh_hits++;
+    }
+
+    // Most rays must reach one of the meshes
+    ASSERT_GT(num_mesh_hits, num_rays / 2);
+}
@@ -0,0 +1,148 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChRealtimeScheduler: frame deadlines, accumulation of the system
+// timers over several steps per frame, missed deadlines and solver degradation
+// (also of iterative solvers wrapped in a ChSolverTree or ChSolverIslands).
+//
+// =============================================================================
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverIslands.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/solver/ChSolverTree.h"
+#include "chrono/utils/ChRealtimeScheduler.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+// Create a box falling on a fixed ground.
+static void CreateScene(ChSystemNSC& sys) {
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    auto box = chrono_types::make_shared<ChBodyEasyBox>(1, 1, 1, 1000, true, false);
+    box->SetPos(ChVector<>(0, 0.55, 0));
+    sys.AddBody(box);
+}
+
+static double Elapsed(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+TEST(ChRealtimeScheduler, frames) {
+    ChSystemNSC sys;
+    CreateScene(sys);
+
+    const double period = 0.02;
+    const int num_frames = 10;
+    const int num_steps = 4;
+
+    ChRealtimeScheduler scheduler(period);
+    scheduler.SetSystem(&sys);
+
+    auto start = std::chrono::steady_clock::now();
+    scheduler.Start();
+    for (int frame = 0; frame < num_frames; frame++) {
+        // Several steps per frame: the collision and solver times of all steps are accumulated
+        double collision = 0;
+        double solver = 0;
+        for (int step = 0; step < num_steps; step++) {
+            scheduler.DoStep(1e-3);
+            collision += sys.GetTimerCollision();
+            solver += sys.GetTimerSetup() + sys.GetTimerSolver();
+        }
+        scheduler.WaitFrame();
+
+        ASSERT_DOUBLE_EQ(scheduler.GetStats(ChRealtimeScheduler::COLLISION).last, collision);
+        ASSERT_DOUBLE_EQ(scheduler.GetStats(ChRealtimeScheduler::SOLVER).last, solver);
+    }
+    double elapsed = Elapsed(start);
+
+    ASSERT_NEAR(sys.GetChTime(), num_frames * num_steps * 1e-3, 1e-12);
+    ASSERT_EQ(scheduler.GetStats(ChRealtimeScheduler::FRAME).num_frames, num_frames);
+    ASSERT_EQ(scheduler.GetStats(ChRealtimeScheduler::COLLISION).num_frames, num_frames);
+
+    // Frames follow the schedule (deadlines are not earlier than the nominal ones)
+    ASSERT_GE(elapsed, num_frames * period);
+    ASSERT_LT(scheduler.GetStats(ChRealtimeScheduler::FRAME).max, period);
+}
+
+TEST(ChRealtimeScheduler, missed_deadline) {
+    const double period = 0.01;
+    ChRealtimeScheduler scheduler(period);
+
+    scheduler.Start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    ASSERT_FALSE(scheduler.WaitFrame());
+    ASSERT_EQ(scheduler.GetStats(ChRealtimeScheduler::FRAME).num_overruns, 1);
+    ASSERT_GE(scheduler.GetStats(ChRealtimeScheduler::FRAME).last, 0.025);
+
+    // The schedule restarts from the missed deadline: the next frame is on time
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(scheduler.WaitFrame());
+    ASSERT_GE(Elapsed(start), period * 0.9);
+    ASSERT_EQ(scheduler.GetStats(ChRealtimeScheduler::FRAME).num_overruns, 1);
+    ASSERT_EQ(scheduler.GetStats(ChRealtimeScheduler::FRAME).num_frames, 2);
+}
+
+// Check the degradation of the iterations of 'solver', attached to the system directly or through a wrapper.
+static void TestDegradation(std::shared_ptr<ChSolverPSOR> solver, std::shared_ptr<ChSolver> attached) {
+    ChSystemNSC sys;
+    CreateScene(sys);
+    solver->SetMaxIterations(100);
+    sys.SetSolver(attached);
+
+    const double period = 0.002;
+    ChRealtimeScheduler scheduler(period);
+    scheduler.SetSystem(&sys);
+    scheduler.EnableDegradation(10);
+
+    // Frames longer than the period: the solver iterations are reduced, down to the minimum
+    scheduler.Start();
+    for (int frame = 0; frame < 20; frame++) {
+        scheduler.DoStep(1e-3);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        scheduler.WaitFrame();
+    }
+    ASSERT_GT(scheduler.GetPredictedFrameTime(), period);
+    ASSERT_EQ(solver->GetMaxIterations(), 10);
+    ASSERT_EQ(scheduler.GetSolverIterations(), 10);
+
+    // Disabling the degradation restores the nominal iterations
+    scheduler.DisableDegradation();
+    ASSERT_EQ(solver->GetMaxIterations(), 100);
+    ASSERT_EQ(scheduler.GetSolverIterations(), 0);
+}
+
+TEST(ChRealtimeScheduler, degradation) {
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    TestDegradation(solver, solver);
+}
+
+TEST(ChRealtimeScheduler, degradation_tree) {
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    TestDegradation(solver, chrono_types::make_shared<ChSolverTree>(solver));
+}
+
+TEST(ChRealtimeScheduler, degradation_islands) {
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    TestDegradation(solver, chrono_types::make_shared<ChSolverIslands>(solver));
+}
@@ -0,0 +1,220 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChSolverADMM: a simple frictional contact scene (a stack of two
+// boxes and a sliding box on a fixed ground) is simulated with the ADMM, APGD,
+// and PSOR solvers, run to convergence, and the results are compared. An ANCF
+// cable resting on a fixed box (NSC contacts of the cable nodes, with the cable
+// stiffness in the problem) is held by friction under an inclined gravity: the
+// contact forces must balance its weight within the friction cones.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverADMM.h"
+#include "chrono/solver/ChSolverAPGD.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChContactSurfaceNodeCloud.h"
+#include "chrono/fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+static const int num_steps = 50;
+
+// Simulate the scene with the given solver and return the final body states.
+static std::vector<ChVector<>> Simulate(std::shared_ptr<ChSolver> solver) {
+    ChSystemNSC sys;
+    sys.SetSolver(solver);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int i = 0; i < 2; i++) {
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(1, 0.5, 1, 1000, true, false);
+        box->SetPos(ChVector<>(-2, 0.25 + 0.5 * i, 0));
+        boxes.push_back(box);
+    }
+    auto slider = chrono_types::make_shared<ChBodyEasyBox>(0.5, 0.5, 0.5, 1000, true, false);
+    slider->SetPos(ChVector<>(1, 0.25, 0));
+    slider->SetPos_dt(ChVector<>(1, 0, 0.5));
+    boxes.push_back(slider);
+
+    for (auto& box : boxes) {
+        box->GetMaterialSurfaceNSC()->SetFriction(0.3f);
+        sys.AddBody(box);
+    }
+
+    for (int i = 0; i < num_steps; i++)
+        sys.DoStepDynamics(2e-3);
+
+    std::vector<ChVector<>> states;
+    for (auto& box : boxes) {
+        states.push_back(box->GetPos());
+        states.push_back(box->GetPos_dt());
+    }
+    return states;
+}
+
+static void Compare(const std::vector<ChVector<>>& states, const std::vector<ChVector<>>& states_ref, double tol) {
+    ASSERT_EQ(states.size(), states_ref.size());
+    for (size_t i = 0; i < states.size(); i++)
+        ASSERT_NEAR((states[i] - states_ref[i]).Length(), 0, tol) << "state " << i;
+}
+
+TEST(ChSolverADMM, contact_scene) {
+    auto admm = chrono_types::make_shared<ChSolverADMM>();
+    admm->SetMaxIterations(1000);
+    admm->SetTolerance(1e-10);
+    auto states = Simulate(admm);
+
+    auto apgd = chrono_types::make_shared<ChSolverAPGD>();
+    apgd->SetMaxIterations(1000);
+    apgd->SetTolerance(1e-10);
+    auto states_apgd = Simulate(apgd);
+
+    auto psor = chrono_types::make_shared<ChSolverPSOR>();
+    psor->SetMaxIterations(1000);
+    psor->SetTolerance(0);
+    auto states_psor = Simulate(psor);
+
+    // The sliding box is decelerated by friction
+    double v0 = ChVector<>(1, 0, 0.5).Length();
+    double v = states.back().Length();
+    ASSERT_NEAR(v, v0 - 0.3 * 9.81 * num_steps * 2e-3, 5e-3);
+
+    // Same solution as PSOR (up to its slow convergence on the stack). APGD returns the iterate with the smallest
+    // projected gradient residual, which is a less accurate solution here.
+    Compare(states, states_psor, 1e-4);
+    Compare(states, states_apgd, 1e-2);
+}
+
+// Contact reactions on the cable nodes: contact normal (out of the ground), normal and tangential force.
+struct CableContact {
+    ChVector<> normal;
+    double fn;
+    ChVector<> ft;
+};
+
+class CableContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    CableContactCollector(ChContactable* ground) : m_ground(ground) {}
+
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        // The reaction force, given in the contact frame, acts on object B
+        ChVector<> force = plane_coord * react_forces;
+        ChVector<> normal = plane_coord.Get_A_Xaxis();
+        if (contactobjB == m_ground) {
+            force = -force;
+            normal = -normal;
+        }
+        CableContact c;
+        c.normal = normal;
+        c.fn = force ^ normal;
+        c.ft = force - c.fn * normal;
+        contacts.push_back(c);
+        return true;
+    }
+
+    std::vector<CableContact> contacts;
+
+  private:
+    ChContactable* m_ground;
+};
+
+TEST(ChSolverADMM, cable_contact) {
+    // Gravity inclined by an angle below the friction angle, so that the cable is held by friction
+    double friction = 0.3;
+    double theta = std::atan(0.2);
+    ChVector<> gravity = 9.81 * ChVector<>(0.8 * std::sin(theta), -std::cos(theta), 0.6 * std::sin(theta));
+
+    auto admm = chrono_types::make_shared<ChSolverADMM>();
+    admm->SetMaxIterations(2000);
+    admm->SetTolerance(1e-12);
+
+    ChSystemNSC sys;
+    sys.SetSolver(admm);
+    sys.Set_G_acc(gravity);
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction((float)friction);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(2, 0.2, 1, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    ground->SetMaterialSurface(material);
+    sys.AddBody(ground);
+
+    // ANCF cable resting on the box, with contacts on its nodes
+    auto section = chrono_types::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.02);
+    section->SetYoungModulus(1e7);
+    section->SetDensity(1000);
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    ChBuilderBeamANCF builder;
+    builder.BuildBeam(mesh, section, 8, ChVector<>(-0.4, 0.01, 0), ChVector<>(0.4, 0.01, 0));
+
+    auto cloud = chrono_types::make_shared<ChContactSurfaceNodeCloud>();
+    mesh->AddContactSurface(cloud);
+    cloud->AddAllNodes(0.01);
+    cloud->SetMaterialSurface(material);
+    sys.Add(mesh);
+
+    for (int i = 0; i < 20; i++) {
+        sys.DoStepDynamics(1e-3);
+
+        // The stiffness blocks of the cable are part of the factorized matrix; the penalty stays positive also
+        // when a residual vanishes
+        ASSERT_GE(admm->GetNumFactorizations(), 1) << "step " << i;
+        ASSERT_LT(admm->GetError(), 1e-9) << "step " << i;
+        ASSERT_GT(admm->GetRho(), 0) << "step " << i;
+    }
+
+    // The cable rests on the box
+    for (auto& node : builder.GetLastBeamNodes()) {
+        ASSERT_NEAR(node->GetPos().y(), 0.01, 1e-5);
+        ASSERT_NEAR(node->GetPos_dt().Length(), 0, 1e-4);
+    }
+
+    // All nodes are in contact, within the friction cone, and the contact forces balance the weight of the cable
+    CableContactCollector collector(ground.get());
+    sys.GetContactContainer()->ReportAllContacts(&collector);
+    ASSERT_EQ(collector.contacts.size(), 9u);
+
+    ChVector<> total(0, 0, 0);
+    for (auto& c : collector.contacts) {
+        ASSERT_GT(c.fn, 0);
+        ASSERT_LE(c.ft.Length(), friction * c.fn * (1 + 1e-6));
+        total += c.fn * c.normal + c.ft;
+    }
+    double mass = CH_C_PI * 0.01 * 0.01 * 0.8 * 1000;
+    ASSERT_NEAR((total + mass * gravity).Length(), 0, 1e-3 * mass * gravity.Length());
+}
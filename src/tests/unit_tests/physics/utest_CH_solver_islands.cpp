@@ -0,0 +1,177 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChSolverIslands: two separate stacks of boxes on a fixed ground
+// are simulated with PSOR, solving the whole problem at once or island by
+// island, and the results are compared. Also tests the island-level sleeping
+// and waking of bodies in ChSystem.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverIslands.h"
+#include "chrono/solver/ChSolverPSOR.h"
+
+using namespace chrono;
+
+static const int num_iterations = 50;
+
+// Create the ground and two stacks of boxes, returning the boxes.
+static std::vector<std::shared_ptr<ChBody>> CreateScene(ChSystemNSC& sys) {
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(20, 1, 20, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int stack = 0; stack < 2; stack++) {
+        for (int i = 0; i < 3; i++) {
+            auto box = chrono_types::make_shared<ChBodyEasyBox>(1, 1, 1, 1000, true, false);
+            box->SetPos(ChVector<>(-3 + 6 * stack + 0.1 * i, 0.5 + i, 0.05 * stack));
+            box->GetMaterialSurfaceNSC()->SetFriction(0.4f);
+            sys.AddBody(box);
+            boxes.push_back(box);
+        }
+    }
+    return boxes;
+}
+
+static std::shared_ptr<ChSolverPSOR> CreatePSOR() {
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(num_iterations);
+    solver->SetTolerance(0);
+    return solver;
+}
+
+TEST(ChSolverIslands, stacks) {
+    ChSystemNSC sys_ref;
+    sys_ref.SetSolver(CreatePSOR());
+    auto boxes_ref = CreateScene(sys_ref);
+
+    ChSystemNSC sys;
+    auto psor = CreatePSOR();
+    auto islands = chrono_types::make_shared<ChSolverIslands>(psor);
+    islands->SetMinIslandSize(1);
+    sys.SetSolver(islands);
+    auto boxes = CreateScene(sys);
+
+    double step = 2e-3;
+    for (int k = 0; k < 200; k++) {
+        sys_ref.DoStepDynamics(step);
+        sys.DoStepDynamics(step);
+    }
+
+    // One island per stack, solved separately
+    ASSERT_EQ(islands->GetNumIslands(), 2);
+    ASSERT_EQ(islands->GetNumWorkUnits(), 2);
+    ASSERT_GT(sys.GetNcontacts(), 0);
+
+    for (size_t i = 0; i < boxes.size(); i++) {
+        ASSERT_NEAR((boxes[i]->GetPos() - boxes_ref[i]->GetPos()).Length(), 0, 1e-9);
+        ASSERT_NEAR((boxes[i]->GetPos_dt() - boxes_ref[i]->GetPos_dt()).Length(), 0, 1e-9);
+    }
+
+    // Statistics of the worst island reported on the wrapped solver
+    ASSERT_EQ(psor->GetIterations(), num_iterations);
+    ASSERT_TRUE(std::isfinite(psor->GetError()));
+    ASSERT_GE(psor->GetError(), 0);
+
+    // Settings changed on the wrapped solver are used by the island solves
+    psor->SetMaxIterations(20);
+    sys.DoStepDynamics(step);
+    ASSERT_EQ(islands->GetNumWorkUnits(), 2);
+    ASSERT_EQ(psor->GetIterations(), 20);
+}
+
+TEST(ChSolverIslands, inactive_constraint) {
+    ChSystemNSC sys;
+    auto psor = CreatePSOR();
+    auto islands = chrono_types::make_shared<ChSolverIslands>(psor);
+    islands->SetMinIslandSize(1);
+    sys.SetSolver(islands);
+    auto boxes = CreateScene(sys);
+
+    // Sleeping body jointed to the fixed ground: the joint constraints have no active variables
+    auto ground = sys.Get_bodylist()[0];
+    auto sleeper = chrono_types::make_shared<ChBodyEasyBox>(0.5, 0.5, 0.5, 1000, false, false);
+    sleeper->SetPos(ChVector<>(0, 3, 0));
+    sleeper->SetSleeping(true);
+    sys.AddBody(sleeper);
+    auto joint = chrono_types::make_shared<ChLinkLockSpherical>();
+    joint->Initialize(ground, sleeper, ChCoordsys<>(ChVector<>(0, 2.5, 0)));
+    sys.AddLink(joint);
+
+    for (int k = 0; k < 10; k++) {
+        sys.DoStepDynamics(2e-3);
+        ASSERT_EQ(islands->GetNumWorkUnits(), 2);
+        ASSERT_EQ(joint->Get_react_force().Length(), 0);
+        ASSERT_TRUE(sleeper->GetPos() == ChVector<>(0, 3, 0));
+    }
+}
+
+// Tell if all bodies in the list are sleeping (1), all awake (0), or mixed (-1).
+static int SleepState(const std::vector<std::shared_ptr<ChBody>>& bodies) {
+    int num_sleeping = 0;
+    for (auto& body : bodies)
+        num_sleeping += body->GetSleeping() ? 1 : 0;
+    return num_sleeping == 0 ? 0 : (num_sleeping == (int)bodies.size() ? 1 : -1);
+}
+
+TEST(ChSystem, island_sleeping) {
+    ChSystemNSC sys;
+    sys.SetSolver(CreatePSOR());
+    sys.SetUseSleeping(true);
+    auto boxes = CreateScene(sys);
+    std::vector<std::shared_ptr<ChBody>> stack0(boxes.begin(), boxes.begin() + 3);
+    std::vector<std::shared_ptr<ChBody>> stack1(boxes.begin() + 3, boxes.end());
+    for (auto& box : boxes)
+        box->SetSleepTime(0.1f);
+
+    // Each stack goes to sleep as a unit
+    double step = 2e-3;
+    for (int k = 0; k < 1000 && (SleepState(stack0) != 1 || SleepState(stack1) != 1); k++) {
+        sys.DoStepDynamics(step);
+        ASSERT_GE(SleepState(stack0), 0) << "step " << k;
+        ASSERT_GE(SleepState(stack1), 0) << "step " << k;
+    }
+    ASSERT_EQ(SleepState(stack0), 1);
+    ASSERT_EQ(SleepState(stack1), 1);
+
+    // Removing a sleeping body does not disturb the other sleeping bodies
+    sys.RemoveBody(stack1.back());
+    stack1.pop_back();
+    sys.DoStepDynamics(step);
+    ASSERT_EQ(SleepState(stack0), 1);
+    ASSERT_EQ(SleepState(stack1), 1);
+
+    // A ball dropped on the first stack wakes it up as a unit, the second stack keeps sleeping
+    auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.3, 1000, true, false);
+    ball->SetPos(ChVector<>(-2.8, 3.4, 0));
+    ball->SetPos_dt(ChVector<>(0, -2, 0));
+    sys.AddBody(ball);
+
+    bool woken = false;
+    for (int k = 0; k < 200 && !woken; k++) {
+        sys.DoStepDynamics(step);
+        ASSERT_GE(SleepState(stack0), 0) << "step " << k;
+        ASSERT_EQ(SleepState(stack1), 1) << "step " << k;
+        woken = SleepState(stack0) == 0;
+    }
+    ASSERT_TRUE(woken);
+    ASSERT_FALSE(ball->GetSleeping());
+}
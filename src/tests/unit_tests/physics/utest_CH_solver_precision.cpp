@@ -0,0 +1,190 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the reduced-precision modes of the iterative VI solvers: a stack
+// of boxes resting on a fixed ground is simulated with the PSOR and BB solvers
+// in single and mixed precision, and the results are compared with those
+// obtained in double precision. Stiffness blocks are rejected in reduced
+// precision. The precision is serialized, and archives written before it was
+// added can still be read.
+//
+// =============================================================================
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "chrono/core/ChStream.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/serialization/ChArchiveJSON.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSolverBB.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/solver/ChVariablesGeneric.h"
+
+using namespace chrono;
+
+static const int num_boxes = 5;
+static const int num_steps = 100;
+
+using Precision = ChIterativeSolverVI::Precision;
+
+// Simulate the stack with the given solver and return the final positions and velocities of the boxes.
+static std::vector<ChVector<>> Simulate(std::shared_ptr<ChIterativeSolverVI> solver, Precision precision) {
+    ChSystemNSC sys;
+    solver->SetMaxIterations(200);
+    solver->SetTolerance(0);
+    solver->SetPrecision(precision);
+    sys.SetSolver(solver);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int i = 0; i < num_boxes; i++) {
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(1, 0.5, 1, 1000, true, false);
+        box->SetPos(ChVector<>(0.05 * i, 0.25 + 0.5 * i, 0));
+        box->GetMaterialSurfaceNSC()->SetFriction(0.5f);
+        sys.AddBody(box);
+        boxes.push_back(box);
+    }
+
+    for (int i = 0; i < num_steps; i++)
+        sys.DoStepDynamics(2e-3);
+
+    std::vector<ChVector<>> states;
+    for (auto& box : boxes) {
+        states.push_back(box->GetPos());
+        states.push_back(box->GetPos_dt());
+    }
+    return states;
+}
+
+static void Compare(const std::vector<ChVector<>>& states, const std::vector<ChVector<>>& states_ref, double tol) {
+    ASSERT_EQ(states.size(), states_ref.size());
+    for (size_t i = 0; i < states.size(); i++)
+        ASSERT_NEAR((states[i] - states_ref[i]).Length(), 0, tol) << "state " << i;
+}
+
+template <class Solver>
+static void TestPrecision(double tol_mixed, double tol_single) {
+    auto states_ref = Simulate(chrono_types::make_shared<Solver>(), Precision::DOUBLE);
+
+    // The stack is at rest on the ground
+    ASSERT_NEAR(states_ref.back().Length(), 0, 1e-2);
+    ASSERT_NEAR(states_ref[2 * num_boxes - 2].y(), 0.25 + 0.5 * (num_boxes - 1), 1e-2);
+
+    auto states_mixed = Simulate(chrono_types::make_shared<Solver>(), Precision::MIXED);
+    Compare(states_mixed, states_ref, tol_mixed);
+
+    auto states_single = Simulate(chrono_types::make_shared<Solver>(), Precision::SINGLE);
+    Compare(states_single, states_ref, tol_single);
+}
+
+TEST(ChIterativeSolverVI, precision_psor) {
+    // In mixed precision, the PSOR velocities and multipliers are iterated in double precision: only the round-off of
+    // the Jacobians and of the inverse mass terms affects the results
+    TestPrecision<ChSolverPSOR>(1e-8, 1e-3);
+}
+
+TEST(ChIterativeSolverVI, precision_bb) {
+    // The BB step sizes depend on the round-off of the products, so that the (partially converged) results differ
+    // from those in double precision also in mixed precision
+    TestPrecision<ChSolverBB>(1e-3, 1e-3);
+}
+
+TEST(ChIterativeSolverVI, precision_stiffness) {
+    ChSystemDescriptor descriptor;
+    ChVariablesGeneric variables(6);
+    ChKblockGeneric kblock;
+    kblock.SetVariables({&variables});
+    kblock.Get_K() = ChMatrixDynamic<>::Identity(6, 6);
+    descriptor.BeginInsertion();
+    descriptor.InsertVariables(&variables);
+    descriptor.InsertKblock(&kblock);
+    descriptor.EndInsertion();
+
+    // The compact Schur complement only accounts for the mass matrices: stiffness blocks are rejected
+    ChSolverPSOR solver;
+    solver.SetPrecision(Precision::MIXED);
+    ASSERT_THROW(solver.Solve(descriptor), ChException);
+    solver.SetPrecision(Precision::SINGLE);
+    ASSERT_THROW(solver.Solve(descriptor), ChException);
+}
+
+static void WriteText(const std::string& filename, const std::string& text) {
+    std::ofstream out(filename);
+    out << text;
+}
+
+static std::string ReadText(const std::string& filename) {
+    std::ifstream in(filename);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+TEST(ChIterativeSolverVI, archive_precision) {
+    std::string filename = "solver_precision_archive.json";
+
+    ChSolverPSOR solver;
+    solver.SetPrecision(Precision::MIXED);
+    solver.SetMaxIterations(123);
+    {
+        ChStreamOutAsciiFile file(filename.c_str());
+        ChArchiveOutJSON archive(file);
+        static_cast<ChSolver&>(solver).ArchiveOUT(archive);
+    }
+    std::string text = ReadText(filename);
+
+    // Current archive: the precision is restored
+    {
+        ChSolverPSOR loaded;
+        ChStreamInAsciiFile file(filename.c_str());
+        ChArchiveInJSON archive(file);
+        static_cast<ChSolver&>(loaded).ArchiveIN(archive);
+        ASSERT_EQ(loaded.GetPrecision(), Precision::MIXED);
+        ASSERT_EQ(loaded.GetMaxIterations(), 123);
+    }
+
+    // Archive written before version 1: no precision entry (the default, double precision, is used)
+    size_t key = text.find("ChIterativeSolverVI");
+    ASSERT_NE(key, std::string::npos);
+    size_t value = text.find_first_of("0123456789", text.find(':', key));
+    ASSERT_EQ(text[value], '1');
+    text[value] = '0';
+
+    key = text.find("\"precision\"");
+    ASSERT_NE(key, std::string::npos);
+    size_t start = text.rfind(',', key);
+    size_t end = text.find_first_of(",}\n", text.find(':', key) + 1);
+    text.erase(start, end - start);
+    ASSERT_EQ(text.find("precision"), std::string::npos);
+    WriteText(filename, text);
+
+    {
+        ChSolverPSOR loaded;
+        loaded.SetPrecision(Precision::SINGLE);
+        ChStreamInAsciiFile file(filename.c_str());
+        ChArchiveInJSON archive(file);
+        static_cast<ChSolver&>(loaded).ArchiveIN(archive);
+        ASSERT_EQ(loaded.GetPrecision(), Precision::DOUBLE);
+        ASSERT_EQ(loaded.GetMaxIterations(), 123);
+    }
+
+    std::remove(filename.c_str());
+}
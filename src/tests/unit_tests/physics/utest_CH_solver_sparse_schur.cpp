@@ -0,0 +1,120 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChSolverSparseSchur: a small KKT system (rigid body variables,
+// a stiffness block coupling two bodies, and bilateral constraints, some of them
+// with compliance) is solved with the Schur-complement solver and compared with
+// the solution obtained with the SparseLU solver.
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/solver/ChConstraintTwoBodies.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSolverSparseSchur.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+#include "chrono/solver/ChVariablesBodyOwnMass.h"
+
+using namespace chrono;
+
+static const int num_bodies = 5;
+
+// KKT problem: bodies connected in a chain by pairs of constraints.
+class KKTProblem {
+  public:
+    KKTProblem() {
+        std::srand(1);
+        descriptor.BeginInsertion();
+
+        for (int i = 0; i < num_bodies; i++) {
+            auto var = new ChVariablesBodyOwnMass();
+            var->SetBodyMass(1.0 + i);
+            var->SetBodyInertia(ChMatrix33<>(ChVector<>(0.1, 0.2, 0.3) * (1.0 + i)));
+            var->Get_fb() = ChVectorN<double, 6>::Random();
+            variables.emplace_back(var);
+            descriptor.InsertVariables(var);
+        }
+
+        for (int i = 0; i + 1 < num_bodies; i++) {
+            for (int k = 0; k < 2; k++) {
+                auto constr = new ChConstraintTwoBodies(variables[i].get(), variables[i + 1].get());
+                constr->Get_Cq_a() = ChRowVectorN<double, 6>::Random();
+                constr->Get_Cq_b() = ChRowVectorN<double, 6>::Random();
+                constr->Set_b_i(0.1 * (i - k));
+                constr->Set_cfm_i(k == 0 ? 1e-3 : 0);
+                constraints.emplace_back(constr);
+                descriptor.InsertConstraint(constr);
+            }
+        }
+
+        // Symmetric positive semi-definite stiffness block coupling the last two bodies
+        kblock.SetVariables({variables[num_bodies - 2].get(), variables[num_bodies - 1].get()});
+        ChMatrixDynamic<> A = ChMatrixDynamic<>::Random(12, 12);
+        kblock.Get_K() = 0.5 * A * A.transpose();
+        descriptor.InsertKblock(&kblock);
+
+        descriptor.EndInsertion();
+    }
+
+    ChVectorDynamic<> Solve(ChSolver& solver) {
+        EXPECT_TRUE(solver.Setup(descriptor));
+        solver.Solve(descriptor);
+        ChVectorDynamic<> x(descriptor.CountActiveVariables() + descriptor.CountActiveConstraints());
+        descriptor.FromUnknownsToVector(x);
+        return x;
+    }
+
+    ChSystemDescriptor descriptor;
+    std::vector<std::unique_ptr<ChVariablesBodyOwnMass>> variables;
+    std::vector<std::unique_ptr<ChConstraintTwoBodies>> constraints;
+    ChKblockGeneric kblock;
+};
+
+TEST(ChSolverSparseSchur, kkt_compliance) {
+    KKTProblem problem;
+
+    ChSolverSparseLU lu;
+    ChVectorDynamic<> x_ref = problem.Solve(lu);
+
+    ChSolverSparseSchur schur;
+    ChVectorDynamic<> x = problem.Solve(schur);
+
+    // The stiffness block merges the last two bodies in a single 12x12 block
+    ASSERT_TRUE(schur.IsReduced());
+    ASSERT_EQ(schur.GetLargestBlockSize(), 12);
+
+    ASSERT_EQ(x.size(), 6 * num_bodies + 2 * (num_bodies - 1));
+    ASSERT_LT((x - x_ref).lpNorm<Eigen::Infinity>(), 1e-10 * x_ref.lpNorm<Eigen::Infinity>());
+
+    // The compliance terms must have been accounted for: the compliant constraints have nonzero residuals
+    double max_res = 0;
+    for (const auto& constr : problem.constraints) {
+        constr->Update_auxiliary();
+        double c = constr->Compute_Cq_q() + constr->Get_b_i();
+        if (constr->Get_cfm_i() > 0)
+            max_res = std::max(max_res, std::abs(c));
+    }
+    ASSERT_GT(max_res, 1e-8);
+}
+
+TEST(ChSolverSparseSchur, singular_block) {
+    KKTProblem problem;
+
+    // A massless body makes H singular (relative to the other masses)
+    problem.variables[0]->SetBodyMass(1e-20);
+    problem.variables[0]->SetBodyInertia(ChMatrix33<>(1e-20));
+
+    ChSolverSparseSchur schur;
+    ASSERT_FALSE(schur.Setup(problem.descriptor));
+}
@@ -0,0 +1,161 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for ChSolverTree: a pendulum chain and a branched mechanism are
+// simulated with the tree solver and compared with the SparseLU solver. Also
+// checks that the graph is analyzed only once and that the solver settings are
+// forwarded to the wrapped solver.
+//
+// =============================================================================
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/solver/ChSolverTree.h"
+
+using namespace chrono;
+
+static const double step = 1e-3;
+static const int num_steps = 200;
+
+// Add a body at the given position, connected to 'parent' through a joint at 'joint_pos'.
+static std::shared_ptr<ChBody> AddBody(ChSystem& sys,
+                                       std::shared_ptr<ChBody> parent,
+                                       const ChVector<>& pos,
+                                       const ChVector<>& joint_pos,
+                                       bool spherical) {
+    auto body = chrono_types::make_shared<ChBody>();
+    body->SetMass(1);
+    body->SetInertiaXX(ChVector<>(0.02, 0.02, 0.02));
+    body->SetPos(pos);
+    sys.AddBody(body);
+
+    std::shared_ptr<ChLinkLock> joint;
+    if (spherical)
+        joint = chrono_types::make_shared<ChLinkLockSpherical>();
+    else
+        joint = chrono_types::make_shared<ChLinkLockRevolute>();
+    joint->Initialize(body, parent, ChCoordsys<>(joint_pos, QUNIT));
+    sys.AddLink(joint);
+
+    return body;
+}
+
+// Chain of revolute joints, hanging from the ground.
+static std::vector<std::shared_ptr<ChBody>> CreateChain(ChSystem& sys) {
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    auto parent = ground;
+    for (int i = 0; i < 10; i++) {
+        parent = AddBody(sys, parent, ChVector<>(0.5 + i, 0, 0), ChVector<>(i, 0, 0), false);
+        bodies.push_back(parent);
+    }
+    return bodies;
+}
+
+// Branched mechanism: a body attached to the ground, carrying three chains of spherical joints.
+static std::vector<std::shared_ptr<ChBody>> CreateBranched(ChSystem& sys) {
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    auto root = AddBody(sys, ground, ChVector<>(0, -0.5, 0), ChVector<>(0, 0, 0), true);
+    root->SetPos_dt(ChVector<>(0.5, 0, 0));
+    bodies.push_back(root);
+    for (int b = 0; b < 3; b++) {
+        ChVector<> dir(std::cos(2 * b), 0, std::sin(2 * b));
+        auto parent = root;
+        for (int i = 0; i < 3; i++) {
+            ChVector<> joint_pos = ChVector<>(0, -0.5, 0) + 0.6 * i * dir;
+            parent = AddBody(sys, parent, joint_pos + 0.3 * dir, joint_pos, true);
+            bodies.push_back(parent);
+        }
+    }
+    return bodies;
+}
+
+static void Compare(std::vector<std::shared_ptr<ChBody>> (*create)(ChSystem&)) {
+    ChSystemNSC sys_ref;
+    sys_ref.SetSolver(chrono_types::make_shared<ChSolverSparseLU>());
+    auto bodies_ref = create(sys_ref);
+
+    ChSystemNSC sys;
+    auto tree = chrono_types::make_shared<ChSolverTree>(chrono_types::make_shared<ChSolverSparseLU>());
+    sys.SetSolver(tree);
+    auto bodies = create(sys);
+
+    for (int k = 0; k < num_steps; k++) {
+        sys_ref.DoStepDynamics(step);
+        sys.DoStepDynamics(step);
+        ASSERT_TRUE(tree->IsTree());
+    }
+
+    // The topology does not change: the graph is analyzed only once
+    ASSERT_EQ(tree->GetNumAnalyzeCalls(), 1);
+    ASSERT_EQ(tree->GetNumTrees(), 1);
+
+    for (size_t i = 0; i < bodies.size(); i++) {
+        ASSERT_NEAR((bodies[i]->GetPos() - bodies_ref[i]->GetPos()).Length(), 0, 1e-8) << "body " << i;
+        ASSERT_NEAR((bodies[i]->GetPos_dt() - bodies_ref[i]->GetPos_dt()).Length(), 0, 1e-8) << "body " << i;
+    }
+
+    // The mechanism moved
+    ASSERT_GT((bodies.back()->GetPos_dt()).Length(), 0.1);
+}
+
+TEST(ChSolverTree, chain) {
+    Compare(CreateChain);
+}
+
+TEST(ChSolverTree, branched) {
+    Compare(CreateBranched);
+}
+
+TEST(ChSolverTree, topology_change) {
+    ChSystemNSC sys;
+    auto tree = chrono_types::make_shared<ChSolverTree>(chrono_types::make_shared<ChSolverSparseLU>());
+    sys.SetSolver(tree);
+    auto bodies = CreateChain(sys);
+
+    sys.DoStepDynamics(step);
+    ASSERT_EQ(tree->GetNumAnalyzeCalls(), 1);
+
+    // Disabling a joint changes the topology: the chain is split in two trees
+    sys.Get_linklist()[4]->SetDisabled(true);
+    sys.DoStepDynamics(step);
+    ASSERT_TRUE(tree->IsTree());
+    ASSERT_EQ(tree->GetNumAnalyzeCalls(), 2);
+    ASSERT_EQ(tree->GetNumTrees(), 2);
+
+    sys.DoStepDynamics(step);
+    ASSERT_EQ(tree->GetNumAnalyzeCalls(), 2);
+}
+
+TEST(ChSolverTree, settings) {
+    ChSystemNSC sys;
+    auto psor = chrono_types::make_shared<ChSolverPSOR>();
+    sys.SetSolver(chrono_types::make_shared<ChSolverTree>(psor));
+
+    sys.SetSolverMaxIterations(37);
+    sys.SetSolverTolerance(1e-7);
+    ASSERT_EQ(psor->GetMaxIterations(), 37);
+    ASSERT_DOUBLE_EQ(psor->GetTolerance(), 1e-7);
+    ASSERT_EQ(sys.GetSolverMaxIterations(), 37);
+    ASSERT_DOUBLE_EQ(sys.GetSolverTolerance(), 1e-7);
+}
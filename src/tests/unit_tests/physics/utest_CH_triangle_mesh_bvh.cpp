@@ -0,0 +1,221 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the refittable BVH of deformable triangle meshes: after the mesh
+// is deformed, box queries on the refitted tree and on the deformable Bullet
+// shape must return the same triangles as a tree rebuilt from scratch and as a
+// brute-force search.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCTriangleMeshBVH.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionShapes/btCEdeformableMeshShape.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionShapes/btTriangleCallback.h"
+#include "chrono/geometry/ChTriangleMeshSoup.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::geometry;
+
+static const int grid = 40;
+
+// Vertices of a grid of triangles in the XZ plane, displaced vertically by a wave of given amplitude and phase.
+static std::vector<ChVector<>> GridVertices(double amplitude, double phase) {
+    auto vertex = [=](int i, int j) {
+        double x = 0.1 * i;
+        double z = 0.1 * j;
+        return ChVector<>(x + 0.2 * amplitude * std::sin(2 * z + phase),
+                          amplitude * std::sin(1.5 * x + phase) * std::cos(z - phase), z);
+    };
+    std::vector<ChVector<>> vertices;
+    for (int i = 0; i < grid; i++) {
+        for (int j = 0; j < grid; j++) {
+            vertices.push_back(vertex(i, j));
+            vertices.push_back(vertex(i + 1, j));
+            vertices.push_back(vertex(i + 1, j + 1));
+            vertices.push_back(vertex(i, j));
+            vertices.push_back(vertex(i + 1, j + 1));
+            vertices.push_back(vertex(i, j + 1));
+        }
+    }
+    return vertices;
+}
+
+// Move the triangles of the given list to scattered locations (same shape), which breaks the spatial coherence of
+// a tree built before the move.
+static std::vector<ChVector<>> Scatter(const std::vector<ChVector<>>& vertices) {
+    std::vector<ChVector<>> result(vertices.size());
+    int ntri = (int)vertices.size() / 3;
+    for (int t = 0; t < ntri; t++) {
+        int s = (t * 7919) % ntri;
+        ChVector<> offset = vertices[3 * s] - vertices[3 * t];
+        for (int k = 0; k < 3; k++)
+            result[3 * t + k] = vertices[3 * t + k] + offset;
+    }
+    return result;
+}
+
+// Query boxes of various sizes covering the mesh.
+static void QueryBoxes(std::vector<ChVector<>>& bbmin, std::vector<ChVector<>>& bbmax) {
+    for (int k = 0; k < 200; k++) {
+        double half = 0.02 + 0.5 * std::abs(std::sin(0.37 * k));
+        ChVector<> center(4 * std::abs(std::sin(0.11 * k)), 1.5 * std::sin(0.23 * k), 4 * std::abs(std::cos(0.07 * k)));
+        bbmin.push_back(center - ChVector<>(half, 0.3 * half, half));
+        bbmax.push_back(center + ChVector<>(half, 0.3 * half, half));
+    }
+}
+
+static std::vector<int> Query(const ChTriangleMeshBVH& bvh, const ChVector<>& bbmin, const ChVector<>& bbmax) {
+    std::vector<int> result;
+    bvh.QueryAABB(bbmin, bbmax, [&result](int t) { result.push_back(t); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+static std::vector<int> BruteForce(const std::vector<ChVector<>>& vertices,
+                                   const ChVector<>& bbmin,
+                                   const ChVector<>& bbmax) {
+    std::vector<int> result;
+    for (int t = 0; t < (int)vertices.size() / 3; t++) {
+        bool overlap = true;
+        for (int j = 0; j < 3; j++) {
+            double tmin = std::min(vertices[3 * t][j], std::min(vertices[3 * t + 1][j], vertices[3 * t + 2][j]));
+            double tmax = std::max(vertices[3 * t][j], std::max(vertices[3 * t + 1][j], vertices[3 * t + 2][j]));
+            overlap = overlap && tmin <= bbmax[j] && tmax >= bbmin[j];
+        }
+        if (overlap)
+            result.push_back(t);
+    }
+    return result;
+}
+
+// Collect the indices of the triangles passed to a Bullet triangle callback.
+class TriangleCollector : public btTriangleCallback {
+  public:
+    virtual void processTriangle(btVector3* triangle, int partId, int triangleIndex) override {
+        indices.push_back(triangleIndex);
+    }
+    std::vector<int> indices;
+};
+
+TEST(ChTriangleMeshBVH, refit_vs_rebuild) {
+    CHOMPfunctions::SetNumThreads(4);
+
+    ChTriangleMeshBVH refitted;
+    refitted.Build(GridVertices(0, 0));
+
+    std::vector<ChVector<>> bbmin, bbmax;
+    QueryBoxes(bbmin, bbmax);
+
+    for (int step = 1; step <= 5; step++) {
+        auto vertices = GridVertices(0.3 * step, 0.4 * step);
+        refitted.Refit(vertices);
+
+        ChTriangleMeshBVH rebuilt;
+        rebuilt.Build(vertices);
+
+        ChVector<> rmin, rmax, bmin, bmax;
+        refitted.GetAABB(rmin, rmax);
+        rebuilt.GetAABB(bmin, bmax);
+        ASSERT_TRUE(rmin == bmin && rmax == bmax) << "step " << step;
+
+        int num_hits = 0;
+        for (size_t k = 0; k < bbmin.size(); k++) {
+            auto expected = BruteForce(vertices, bbmin[k], bbmax[k]);
+            ASSERT_EQ(Query(refitted, bbmin[k], bbmax[k]), expected) << "step " << step << " box " << k;
+            ASSERT_EQ(Query(rebuilt, bbmin[k], bbmax[k]), expected) << "step " << step << " box " << k;
+            num_hits += (int)expected.size();
+        }
+        ASSERT_GT(num_hits, 0);
+    }
+
+    ASSERT_EQ(refitted.GetNumBuilds(), 1u);
+    ASSERT_EQ(refitted.GetNumRefits(), 5u);
+
+    CHOMPfunctions::SetNumThreads(1);
+}
+
+TEST(ChTriangleMeshBVH, update_threshold) {
+    auto flat = GridVertices(0.5, 0);
+    auto deformed = Scatter(flat);
+
+    // With a large threshold, the tree is only refitted
+    ChTriangleMeshBVH lazy;
+    lazy.SetRebuildThreshold(1e10);
+    ASSERT_TRUE(lazy.Update(flat));
+    ASSERT_FALSE(lazy.Update(deformed));
+    ASSERT_EQ(lazy.GetNumBuilds(), 1u);
+
+    // With the default threshold, the scattered triangles trigger a rebuild
+    ChTriangleMeshBVH eager;
+    ASSERT_TRUE(eager.Update(flat));
+    ASSERT_TRUE(eager.Update(deformed));
+    ASSERT_EQ(eager.GetNumBuilds(), 2u);
+    ASSERT_DOUBLE_EQ(eager.GetSAHCost(), eager.GetSAHCostAtBuild());
+
+    // Both trees answer queries as the brute-force search
+    std::vector<ChVector<>> bbmin, bbmax;
+    QueryBoxes(bbmin, bbmax);
+    for (size_t k = 0; k < bbmin.size(); k++) {
+        auto expected = BruteForce(deformed, bbmin[k], bbmax[k]);
+        ASSERT_EQ(Query(lazy, bbmin[k], bbmax[k]), expected) << "box " << k;
+        ASSERT_EQ(Query(eager, bbmin[k], bbmax[k]), expected) << "box " << k;
+    }
+}
+
+TEST(ChTriangleMeshBVH, deformable_shape) {
+    // Deformable Bullet shape on a mesh that is deformed in place, then updated (refit), compared with a shape
+    // created on the deformed mesh (fresh build)
+    auto mesh = chrono_types::make_shared<ChTriangleMeshSoup>();
+    auto flat = GridVertices(0, 0);
+    for (size_t i = 0; i < flat.size(); i += 3)
+        mesh->addTriangle(flat[i], flat[i + 1], flat[i + 2]);
+
+    btCEdeformableMeshShape shape(mesh);
+    shape.getBVH().SetRebuildThreshold(1e10);
+    shape.setMargin(0.01f);
+
+    auto deformed = GridVertices(0.8, 0.5);
+    for (int t = 0; t < mesh->getNumTriangles(); t++)
+        mesh->Triangle(t) = ChTriangle(deformed[3 * t], deformed[3 * t + 1], deformed[3 * t + 2]);
+    ASSERT_FALSE(shape.updateMesh());
+
+    btCEdeformableMeshShape fresh(mesh);
+    fresh.setMargin(0.01f);
+
+    btTransform identity;
+    identity.setIdentity();
+    btVector3 smin, smax, fmin, fmax;
+    shape.getAabb(identity, smin, smax);
+    fresh.getAabb(identity, fmin, fmax);
+    ASSERT_TRUE(smin == fmin && smax == fmax);
+
+    std::vector<ChVector<>> bbmin, bbmax;
+    QueryBoxes(bbmin, bbmax);
+    for (size_t k = 0; k < bbmin.size(); k++) {
+        btVector3 qmin((btScalar)bbmin[k].x(), (btScalar)bbmin[k].y(), (btScalar)bbmin[k].z());
+        btVector3 qmax((btScalar)bbmax[k].x(), (btScalar)bbmax[k].y(), (btScalar)bbmax[k].z());
+        TriangleCollector refit_hits;
+        TriangleCollector fresh_hits;
+        shape.processAllTriangles(&refit_hits, qmin, qmax);
+        fresh.processAllTriangles(&fresh_hits, qmin, qmax);
+        std::sort(refit_hits.indices.begin(), refit_hits.indices.end());
+        std::sort(fresh_hits.indices.begin(), fresh_hits.indices.end());
+        ASSERT_EQ(refit_hits.indices, fresh_hits.indices) << "box " << k;
+    }
+}
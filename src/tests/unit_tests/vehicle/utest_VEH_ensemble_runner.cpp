@@ -0,0 +1,114 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the ensemble runner: concurrent runs of a JSON-specified vehicle
+// must give the same results as the same runs executed one after the other
+// (without data caching), and the shared data cache must load each model file
+// (JSON specification files and meshes) only once.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/powertrain/SimplePowertrain.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/utils/ChEnsembleRunner.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/TMeasyTire.h"
+#include "chrono_vehicle/wheeled_vehicle/vehicle/WheeledVehicle.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+static const int num_runs = 4;
+
+// Results of one run: final vehicle position and speed.
+struct RunResult {
+    ChVector<> pos;
+    double speed;
+};
+
+// Simulate a HMMWV (with mesh visualization, so that meshes are loaded) with a throttle depending on the run.
+static RunResult RunSimulation(int run) {
+    WheeledVehicle vehicle(vehicle::GetDataFile("hmmwv/vehicle/HMMWV_Vehicle.json"), ChMaterialSurface::SMC);
+    vehicle.Initialize(ChCoordsys<>(ChVector<>(0, 0, 1.0), QUNIT));
+    vehicle.SetChassisVisualizationType(VisualizationType::MESH);
+    vehicle.SetWheelVisualizationType(VisualizationType::MESH);
+
+    auto powertrain = chrono_types::make_shared<SimplePowertrain>(
+        vehicle::GetDataFile("generic/powertrain/SimplePowertrain.json"));
+    vehicle.InitializePowertrain(powertrain);
+
+    for (auto& axle : vehicle.GetAxles()) {
+        for (auto& wheel : axle->GetWheels()) {
+            auto tire =
+                chrono_types::make_shared<TMeasyTire>(vehicle::GetDataFile("hmmwv/tire/HMMWV_TMeasy_converted.json"));
+            vehicle.InitializeTire(tire, wheel, VisualizationType::MESH);
+        }
+    }
+
+    RigidTerrain terrain(vehicle.GetSystem(), vehicle::GetDataFile("terrain/RigidPlane.json"));
+
+    double step_size = 2e-3;
+    ChDriver::Inputs driver_inputs = {0, 0.2 + 0.8 * run / (num_runs - 1), 0};
+    for (int i = 0; i < 250; i++) {
+        double time = vehicle.GetSystem()->GetChTime();
+        vehicle.Synchronize(time, driver_inputs, terrain);
+        terrain.Synchronize(time);
+        vehicle.Advance(step_size);
+        terrain.Advance(step_size);
+    }
+
+    return {vehicle.GetVehiclePos(), vehicle.GetVehicleSpeed()};
+}
+
+TEST(ChEnsembleRunner, concurrent_vs_sequential) {
+    // Reference: sequential runs, without data caching
+    ASSERT_FALSE(GetDataCaching());
+    std::vector<RunResult> sequential;
+    for (int run = 0; run < num_runs; run++)
+        sequential.push_back(RunSimulation(run));
+
+    // Number of distinct model data files of one run (the cache loads each file requested by a run once)
+    SetDataCaching(true);
+    ClearDataCache();
+    RunSimulation(0);
+    int num_files = GetDataCacheLoads();
+    ASSERT_GT(num_files, 4);
+
+    // Concurrent runs, with an empty shared cache
+    ClearDataCache();
+    std::vector<RunResult> concurrent(num_runs);
+    ChEnsembleRunner ensemble(num_runs);
+    ensemble.SetNumThreads(num_runs);
+    int num_failed = ensemble.Run([&concurrent](int run, const std::string& out_dir) {
+        concurrent[run] = RunSimulation(run);
+    });
+    ASSERT_EQ(num_failed, 0);
+    ASSERT_EQ(GetDataCacheLoads(), num_files);
+
+    // Caching was already enabled, so the runner leaves it (and the cached data) in place
+    ASSERT_TRUE(GetDataCaching());
+    SetDataCaching(false);
+    ClearDataCache();
+
+    for (int run = 0; run < num_runs; run++) {
+        ASSERT_TRUE(ensemble.Succeeded(run));
+        ASSERT_NEAR((concurrent[run].pos - sequential[run].pos).Length(), 0, 1e-12) << "run " << run;
+        ASSERT_NEAR(concurrent[run].speed, sequential[run].speed, 1e-12) << "run " << run;
+    }
+
+    // The runs with different throttles are distinct
+    ASSERT_GT(sequential[num_runs - 1].speed, sequential[0].speed);
+}
@@ -0,0 +1,229 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the height-field patch of RigidTerrain: the heights and normals
+// returned by the direct grid lookup must agree with ray casts and contacts on
+// the Bullet height-field shape (whose grid cells are split along the same
+// diagonal), at points inside both triangles of the grid cells.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+static const int nx = 21;
+static const int ny = 16;
+static const double sizeX = 10;
+static const double sizeY = 6;
+static const double tol = 1e-9;
+
+// Tolerance on the Bullet results, depending on the precision Bullet was configured with (see USE_BULLET_DOUBLE)
+static const double tol_bullet = collision::ChCollisionSystemBullet::GetScalarSize() == sizeof(double) ? 1e-9 : 1e-5;
+
+// Grid heights, not planar over the grid cells (so that the two cell diagonals give different surfaces).
+static std::shared_ptr<std::vector<double>> CreateHeights() {
+    auto heights = chrono_types::make_shared<std::vector<double>>(nx * ny);
+    for (int j = 0; j < ny; j++) {
+        for (int i = 0; i < nx; i++)
+            (*heights)[j * nx + i] = 0.3 * std::sin(0.9 * i) * std::cos(0.7 * j) + 0.02 * i + 0.1 * ((i * j) % 3);
+    }
+    return heights;
+}
+
+// Query points in the patch frame: in each of a set of grid cells, the centroids of the two triangles.
+static std::vector<ChVector<>> QueryPoints() {
+    std::vector<ChVector<>> points;
+    double dx = sizeX / (nx - 1);
+    double dy = sizeY / (ny - 1);
+    for (int k = 0; k < 40; k++) {
+        int ix = (7 * k) % (nx - 1);
+        int iy = (5 * k + 1) % (ny - 1);
+        points.push_back(ChVector<>(-sizeX / 2 + (ix + 2.0 / 3) * dx, -sizeY / 2 + (iy + 1.0 / 3) * dy, 0));
+        points.push_back(ChVector<>(-sizeX / 2 + (ix + 1.0 / 3) * dx, -sizeY / 2 + (iy + 2.0 / 3) * dy, 0));
+    }
+    return points;
+}
+
+class ContactCollector : public ChContactContainer::ReportContactCallback {
+  public:
+    ContactCollector(ChContactable* terrain) : m_terrain(terrain) {}
+
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        // Contact point on the terrain and contact normal pointing out of the terrain
+        ChVector<> normal = plane_coord.Get_A_Xaxis();
+        if (contactobjA == m_terrain) {
+            points.push_back(pA);
+            normals.push_back(normal);
+            distances.push_back(distance);
+        } else if (contactobjB == m_terrain) {
+            points.push_back(pB);
+            normals.push_back(-normal);
+            distances.push_back(distance);
+        }
+        return true;
+    }
+
+    std::vector<ChVector<>> points;
+    std::vector<ChVector<>> normals;
+    std::vector<double> distances;
+
+  private:
+    ChContactable* m_terrain;
+};
+
+class HeightFieldTerrainTest : public ::testing::TestWithParam<double> {
+  protected:
+    void SetUp() override {
+        // Small envelope, so that the probes below only touch the triangle under them, and large margin (see the
+        // box contact test)
+        collision::ChCollisionModel::SetDefaultSuggestedEnvelope(0.005);
+        collision::ChCollisionModel::SetDefaultSuggestedMargin(0.015);
+
+        sys.Set_G_acc(ChVector<>(0, 0, -9.81));
+        terrain = std::unique_ptr<RigidTerrain>(new RigidTerrain(&sys));
+        frame = ChFrame<>(ChVector<>(1, -2, 0.5), Q_from_AngZ(GetParam()));
+        patch = terrain->AddHeightFieldPatch(frame.GetCoord(), CreateHeights(), nx, ny, sizeX, sizeY, "heightfield",
+                                             false);
+        terrain->Initialize();
+        sys.Setup();
+        sys.Update();
+    }
+
+    ChSystemNSC sys;
+    std::unique_ptr<RigidTerrain> terrain;
+    std::shared_ptr<RigidTerrain::Patch> patch;
+    ChFrame<> frame;
+};
+
+TEST_P(HeightFieldTerrainTest, ray_cast) {
+    double envelope = patch->GetGroundBody()->GetCollisionModel()->GetEnvelope();
+
+    int num_distinct = 0;
+    for (auto& p_loc : QueryPoints()) {
+        ChVector<> p = frame.TransformPointLocalToParent(p_loc);
+        double height = terrain->GetHeight(p.x(), p.y());
+        ChVector<> normal = terrain->GetNormal(p.x(), p.y());
+
+        // Vertical ray cast on the Bullet shape (RayHit reports the hit point moved inside by the envelope)
+        collision::ChCollisionSystem::ChRayhitResult result;
+        sys.GetCollisionSystem()->RayHit(ChVector<>(p.x(), p.y(), 10), ChVector<>(p.x(), p.y(), -10), result);
+        ASSERT_TRUE(result.hit);
+        ChVector<> hit = result.abs_hitPoint + result.abs_hitNormal * envelope;
+
+        ASSERT_NEAR(hit.x(), p.x(), tol_bullet);
+        ASSERT_NEAR(hit.y(), p.y(), tol_bullet);
+        ASSERT_NEAR(hit.z(), height, tol_bullet);
+        ASSERT_NEAR((result.abs_hitNormal - normal).Length(), 0, tol_bullet);
+
+        // The height differs from the interpolation on the other cell diagonal
+        double u = p_loc.x() / (sizeX / (nx - 1)) + 0.5 * (nx - 1);
+        double v = p_loc.y() / (sizeY / (ny - 1)) + 0.5 * (ny - 1);
+        auto heights = CreateHeights();
+        int ix = (int)u;
+        int iy = (int)v;
+        u -= ix;
+        v -= iy;
+        const double* h = heights->data() + iy * nx + ix;
+        double h_flip = (u + v <= 1) ? h[0] + u * (h[1] - h[0]) + v * (h[nx] - h[0])
+                                     : h[nx + 1] + (1 - u) * (h[nx] - h[nx + 1]) + (1 - v) * (h[1] - h[nx + 1]);
+        if (std::abs(frame.GetPos().z() + h_flip - height) > 1e-3)
+            num_distinct++;
+    }
+    ASSERT_GT(num_distinct, 40);
+}
+
+TEST_P(HeightFieldTerrainTest, contact_sphere) {
+    // Small spheres penetrating the terrain at the query points by a tenth of their radius. Spheres are collided
+    // with the grid triangles by the sphere-triangle detector, which must inflate the triangles by the shape margin
+    // (the envelope) like GJK does, so that the reported contacts are on the terrain surface.
+    double radius = 0.02;
+    auto points = QueryPoints();
+    for (auto& p_loc : points) {
+        ChVector<> p = frame.TransformPointLocalToParent(p_loc);
+        double height = terrain->GetHeight(p.x(), p.y());
+        ChVector<> normal = terrain->GetNormal(p.x(), p.y());
+        auto ball = chrono_types::make_shared<ChBodyEasySphere>(radius, 1000, true, false);
+        ball->SetPos(ChVector<>(p.x(), p.y(), height) + 0.9 * radius * normal);
+        sys.AddBody(ball);
+    }
+    sys.Setup();
+    sys.Update();
+    sys.ComputeCollisions();
+
+    ContactCollector collector(patch->GetGroundBody().get());
+    sys.GetContactContainer()->ReportAllContacts(&collector);
+    ASSERT_EQ(collector.points.size(), points.size());
+
+    for (size_t k = 0; k < collector.points.size(); k++) {
+        const ChVector<>& pt = collector.points[k];
+        ASSERT_NEAR(pt.z(), terrain->GetHeight(pt.x(), pt.y()), tol_bullet) << "contact " << k;
+        // The triangle normal is computed from edges that are short relative to the vertex coordinates
+        ASSERT_NEAR((collector.normals[k] - terrain->GetNormal(pt.x(), pt.y())).Length(), 0, 10 * tol_bullet)
+            << "contact " << k;
+        ASSERT_NEAR(collector.distances[k], -0.1 * radius, tol_bullet) << "contact " << k;
+    }
+}
+
+TEST_P(HeightFieldTerrainTest, contact_box) {
+    // Small cubes slightly penetrating the terrain at the query points, with a face parallel to the terrain surface.
+    // Boxes are collided with the grid triangles by GJK, which inflates the triangles by the shape margin. The
+    // margin of the boxes keeps the shrunk shapes apart by more than the GJK degeneracy threshold (0.01), below
+    // which the penetration solver is used and the triangle margin is lost.
+    double hsize = 0.02;
+    auto points = QueryPoints();
+    for (auto& p_loc : points) {
+        ChVector<> p = frame.TransformPointLocalToParent(p_loc);
+        double height = terrain->GetHeight(p.x(), p.y());
+        ChVector<> normal = terrain->GetNormal(p.x(), p.y());
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(2 * hsize, 2 * hsize, 2 * hsize, 1000, true, false);
+        box->SetPos(ChVector<>(p.x(), p.y(), height) + (hsize - 0.001) * normal);
+        ChMatrix33<> rot;
+        rot.Set_A_Xdir(normal);  // the box is a cube, so any face can be the base
+        box->SetRot(rot);
+        sys.AddBody(box);
+    }
+    sys.Setup();
+    sys.Update();
+    sys.ComputeCollisions();
+
+    ContactCollector collector(patch->GetGroundBody().get());
+    sys.GetContactContainer()->ReportAllContacts(&collector);
+    ASSERT_EQ(collector.points.size(), points.size());
+
+    for (size_t k = 0; k < collector.points.size(); k++) {
+        const ChVector<>& pt = collector.points[k];
+        ASSERT_NEAR(pt.z(), terrain->GetHeight(pt.x(), pt.y()), tol_bullet) << "contact " << k;
+        ASSERT_NEAR(collector.distances[k], -0.001, tol_bullet) << "contact " << k;
+        // GJK only converges the contact normal to a relative tolerance
+        ASSERT_NEAR((collector.normals[k] - terrain->GetNormal(pt.x(), pt.y())).Length(), 0, 1e-4) << "contact " << k;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(RigidTerrain, HeightFieldTerrainTest, ::testing::Values(0.0, 0.4));
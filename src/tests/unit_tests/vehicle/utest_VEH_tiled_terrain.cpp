@@ -0,0 +1,94 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for TiledTerrain: a flat terrain with a friction map (low friction
+// for x < 0, high friction for x > 0) is sampled into tiles, and boxes sliding on
+// the two halves must be decelerated according to the mapped friction.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/TiledTerrain.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+static const float mu_low = 0.1f;
+static const float mu_high = 0.6f;
+
+// Flat source terrain with a friction map.
+class FrictionMapTerrain : public ChTerrain {
+  public:
+    virtual double GetHeight(double x, double y) const override { return 0; }
+    virtual ChVector<> GetNormal(double x, double y) const override { return ChVector<>(0, 0, 1); }
+    virtual float GetCoefficientFriction(double x, double y) const override { return x < 0 ? mu_low : mu_high; }
+};
+
+// Simulate a box sliding along X with the given initial speed, and return the distance traveled.
+static double SlidingDistance(bool use_map, double x0) {
+    ChSystemNSC sys;
+    sys.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    TiledTerrain terrain(&sys, "tiled_terrain_test");
+    terrain.SetFocusPoint(ChVector<>(x0, 1, 0));
+    terrain.UseLocationDependentFriction(use_map);
+    terrain.Initialize();
+    EXPECT_EQ(terrain.GetNumActiveTiles(), 4);
+
+    auto box = chrono_types::make_shared<ChBodyEasyBox>(0.4, 0.4, 0.2, 1000, true, false);
+    box->SetPos(ChVector<>(x0, 1, 0.1));
+    box->SetPos_dt(ChVector<>(1, 0, 0));
+    box->GetMaterialSurfaceNSC()->SetFriction(1.0f);
+    sys.AddBody(box);
+
+    while (sys.GetChTime() < 1.5) {
+        terrain.Synchronize(sys.GetChTime());
+        sys.DoStepDynamics(1e-3);
+    }
+
+    return box->GetPos().x() - x0;
+}
+
+TEST(TiledTerrain, friction_map) {
+    FrictionMapTerrain source;
+    filesystem::create_directory(filesystem::path("tiled_terrain_test"));
+    TiledTerrain::CreateTiles(source, "tiled_terrain_test", ChVector2<>(-4, -2), 4, 2, 2, 2, 9, 5, true);
+
+    // Friction map, as seen by tire models
+    {
+        ChSystemNSC sys;
+        TiledTerrain terrain(&sys, "tiled_terrain_test");
+        terrain.Initialize();
+        ASSERT_NEAR(terrain.GetCoefficientFriction(-2, 0.5), mu_low, 1e-6);
+        ASSERT_NEAR(terrain.GetCoefficientFriction(2, -0.5), mu_high, 1e-6);
+        ASSERT_NEAR(terrain.GetHeight(1, 1), 0, 1e-12);
+    }
+
+    // Contacts with the tiles: sliding distance v^2 / (2 mu g)
+    double d_low = SlidingDistance(true, -3);
+    double d_high = SlidingDistance(true, 0.5);
+    std::cout << "sliding distance, low friction: " << d_low << "  high friction: " << d_high << std::endl;
+    ASSERT_NEAR(d_low, 1 / (2 * mu_low * 9.81), 0.02);
+    ASSERT_NEAR(d_high, 1 / (2 * mu_high * 9.81), 0.02);
+
+    // Without the location-dependent friction, the constant tile friction (0.7) is used everywhere
+    double d_const = SlidingDistance(false, -3);
+    ASSERT_NEAR(d_const, 1 / (2 * 0.7 * 9.81), 0.02);
+}